@@ -48,6 +48,9 @@ int main (int argc, char *argv[]) {
     std::string destIp = "172.17.0.2";
     std::string broker_address;
     std::string queue_name;
+    std::string area;
+    int area_level = 18;
+    int quadkey_level = 18;
 
     // Parse the command line options with the TCLAP library
     try {
@@ -64,6 +67,14 @@ int main (int argc, char *argv[]) {
         TCLAP::ValueArg<std::string> queueArg("Q","queue","Broker queue or topic",false,"topic://MWCdemo","string");
         cmd.add(queueArg);
 
+        TCLAP::ValueArg<std::string> areaArg("A","area","Receive only the messages sent from inside an area, specified as \"lat,lon;lat,lon\" (opposite corners of a rectangle) or \"lat,lon;lat,lon;lat,lon;...\" (polygon), in degrees",false,"","string");
+        cmd.add(areaArg);
+
+        TCLAP::ValueArg<int> areaLevelArg("L","area-level","Level of detail of the quadkeys covering the border of the --area (at most --quadkey-level)",false,18,"int");
+        cmd.add(areaLevelArg);
+
+        TCLAP::ValueArg<int> quadkeyLevelArg("K","quadkey-level","Level of detail of the \"quadkeys\" property added to the messages by the relayer (i.e. its --quadkey-level)",false,18,"int");
+        cmd.add(quadkeyLevelArg);
 
         cmd.parse(argc, argv);
 
@@ -71,6 +82,9 @@ int main (int argc, char *argv[]) {
         destIp = destIpArg.getValue();
         broker_address = urlArg.getValue();
         queue_name = queueArg.getValue();
+        area = areaArg.getValue();
+        area_level = areaLevelArg.getValue();
+        quadkey_level = quadkeyLevelArg.getValue();
 
     } catch (TCLAP::ArgException &tclape) {
         std::cerr << "TCLAP error: " << tclape.error() << " for argument " << tclape.argId() << std::endl;
@@ -80,6 +94,11 @@ int main (int argc, char *argv[]) {
     AMQP_client amqp_client(broker_address,
                             queue_name);
 
+    if(!area.empty() && !amqp_client.set_area(area, area_level, quadkey_level)) {
+        std::cerr << "Error: invalid --area: " << area << std::endl;
+        return 1;
+    }
+
     proton::container container(amqp_client);
     try{
         container.run();
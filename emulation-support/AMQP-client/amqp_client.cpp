@@ -9,6 +9,7 @@
 #include <iostream>
 #include "amqp_client.h"
 #include "C-ITS/ETSImessageHandler.h"
+#include "gn_metadata.h"
 #include <string>
 #include <thread>
 #include <netinet/in.h>
@@ -16,7 +17,7 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 
-void AMQP_client::set_no_local_filter(proton::source_options &opts) {
+void AMQP_client::set_filters(proton::source_options &opts) {
     proton::source::filter_map map;
     proton::symbol filter_key("no-local");
     proton::value filter_value;
@@ -28,11 +29,54 @@ void AMQP_client::set_no_local_filter(proton::source_options &opts) {
         << proton::codec::start::list() << proton::codec::finish()
         << proton::codec::finish();
 
-    // In our case, the map has this one element
     map.put(filter_key, filter_value);
+
+    // Selector on the "quadkeys" property added by the relayers, reduced (if needed) to the maximum size accepted by the broker
+    // The broker may thus deliver also some messages from just outside the area, which are discarded by on_message()
+    if(!m_area_index.empty()) {
+        std::vector<std::string> quadKeys = m_area_index.getQuadKeys();
+        QuadKeys::QuadKeyTS().checkdim(quadKeys);
+
+        QuadKeys::QuadKeyIndex selector_index;
+        for(const std::string &quadKey : quadKeys) {
+            selector_index.insert(quadKey);
+        }
+
+        proton::value selector_value;
+        proton::codec::encoder sel_enc(selector_value);
+        sel_enc << proton::codec::start::described()
+                << proton::symbol("apache.org:selector-filter:string")
+                << selector_index.getSelector("quadkeys")
+                << proton::codec::finish();
+
+        map.put(proton::symbol("selector"), selector_value);
+
+        std::cout << "[AMQP client] Area filter: " << m_area_index.size() << " quadkeys, " << quadKeys.size() << " in the broker selector" << std::endl;
+    }
+
     opts.filters(map);
 }
 
+bool AMQP_client::set_area(const std::string &area, int levelOfDetail, int quadkeyLevel) {
+    m_area_index.clear();
+
+    if(levelOfDetail < 1 || levelOfDetail > QuadKeys::maxLevelOfDetail || quadkeyLevel < 1 || quadkeyLevel > QuadKeys::maxLevelOfDetail) {
+        return false;
+    }
+
+    // A border tile deeper than the "quadkeys" property would never match it, and the messages sent from there would be
+    // dropped by the broker even when sent from inside the area
+    if(levelOfDetail > quadkeyLevel) {
+        std::cerr << "[AMQP client] Warning: the area level (" << levelOfDetail << ") is deeper than the level of the quadkeys set by the relayer ("
+                  << quadkeyLevel << "): using " << quadkeyLevel << " instead." << std::endl;
+        levelOfDetail = quadkeyLevel;
+    }
+
+    m_area_level = levelOfDetail;
+
+    return m_area_index.insertArea(area, levelOfDetail);
+}
+
 void AMQP_client::on_container_start(proton::container &c) {
     proton::connection_options co;
     co.idle_timeout(proton::duration(10000));
@@ -43,7 +87,7 @@ void AMQP_client::on_container_start(proton::container &c) {
 
 void AMQP_client::on_connection_open(proton::connection &c) {
     proton::source_options so;
-    set_no_local_filter(so);
+    set_filters(so);
     c.open_receiver(m_topic, proton::receiver_options().source(so));
     c.open_sender(m_topic);
 
@@ -77,6 +121,34 @@ void AMQP_client::on_message(proton::delivery &dlvr, proton::message &msg) {
         message_bin_buf=message_bin.data ();
     } else {
             std::cout << "[AMQP client] Error: received a message in a non-binary AMQP type." << std::endl;
+            return;
+    }
+
+    // Discard the messages sent from outside the area of interest: the position is taken from the "quadkeys" property or, for
+    // messages without it, from the GN header (messages without both, e.g. Facilities layer only, are always accepted)
+    if(!m_area_index.empty()) {
+        proton::scalar quadkey_prop = msg.properties().get("quadkeys");
+        GNmetadata_t gn_metadata;
+        bool inside = true;
+
+        // A quadkey coarser than the area (relayer level lower than the one given to set_area()) cannot be checked
+        // against the border tiles: the position in the GN header, if any, is used instead
+        bool coarse = quadkey_prop.type() == proton::STRING && (int) proton::get<std::string>(quadkey_prop).size() < m_area_level;
+        if(coarse && m_area_coarse++ == 0) {
+            std::cerr << "[AMQP client] Warning: received a \"quadkeys\" property coarser than the area level (" << m_area_level
+                      << "): set --quadkey-level to the one of the relayer, or the broker may drop messages sent from inside the area." << std::endl;
+        }
+
+        if(quadkey_prop.type() == proton::STRING && !coarse) {
+            inside = m_area_index.contains(proton::get<std::string>(quadkey_prop));
+        } else if(parse_gn_metadata(message_bin_buf, message_bin.size(), gn_metadata)) {
+            inside = m_area_index.contains(gn_metadata.lat / 1e7, gn_metadata.lon / 1e7);
+        }
+
+        if(!inside) {
+            m_area_filtered++;
+            return;
+        }
     }
 
     // Extract the stationID from the AMQP message
@@ -110,6 +182,9 @@ AMQP_client::AMQP_client(const std::string &url,
         {
     m_url = url;
     m_topic = topic;
+    m_area_level = QuadKeys::maxLevelOfDetail;
+    m_area_filtered = 0;
+    m_area_coarse = 0;
 }
 
 void AMQP_client::on_transport_error(proton::transport &transport) {
@@ -124,6 +199,9 @@ void AMQP_client::on_transport_close(proton::transport &transport) {
 
 void AMQP_client::on_connection_close(proton::connection &connection) {
     std::cout << "[AMQP client] CONNECTION CLOSE" << std::endl;
+    if(!m_area_index.empty()) {
+        std::cout << "[AMQP client] Messages discarded because sent from outside the area: " << m_area_filtered << std::endl;
+    }
     messaging_handler::on_connection_close(connection);
 }
 
@@ -137,6 +215,9 @@ AMQP_client::AMQP_client() {
 
     m_url = "127.0.0.1:5672";
     m_topic = "topic://test";
+    m_area_level = QuadKeys::maxLevelOfDetail;
+    m_area_filtered = 0;
+    m_area_coarse = 0;
 }
 
 
@@ -10,6 +10,7 @@
 #include <proton/work_queue.hpp>
 #include <atomic>
 #include <mutex>
+#include "sample_quad_final.h"
 
 class AMQP_client : public proton::messaging_handler {
     std::string m_url;                           // URL of the AMQP broker
@@ -24,6 +25,11 @@ class AMQP_client : public proton::messaging_handler {
     std::string ca_file;    // Path to CA certificate file
     bool verify_peer;       // Whether to verify the peer's certificate
 
+    // Area of interest: if not empty, only the messages sent from inside it are received
+    QuadKeys::QuadKeyIndex m_area_index;
+    int m_area_level;          // Deepest level of the quadkeys of m_area_index
+    uint64_t m_area_filtered;  // Messages received from the broker, but sent from outside the area
+    uint64_t m_area_coarse;    // Messages with a "quadkeys" property coarser than m_area_level
 
 
     // Qpid Proton event callbacks
@@ -44,9 +50,16 @@ public:
     AMQP_client(const std::string &url,
                 const std::string &topic);
 
+    // Receive only the messages sent from inside "area" (see QuadKeys::QuadKeyIndex::insertArea()), by asking the broker
+    // to filter them by their "quadkeys" property, and checking their position when received
+    // The selector can only match quadkeys at least as deep as its own: "levelOfDetail" is thus clamped to the level of
+    // the "quadkeys" property set by the relayer, "quadkeyLevel"
+    // Must be called before starting the container; returns false if "area" or the levels are not valid
+    bool set_area(const std::string &area, int levelOfDetail, int quadkeyLevel);
+
 
 private:
-    void set_no_local_filter(proton::source_options &opts);
+    void set_filters(proton::source_options &opts);
 };
 
 
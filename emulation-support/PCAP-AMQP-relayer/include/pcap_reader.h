@@ -0,0 +1,76 @@
+#ifndef PCAP_READER_H
+#define PCAP_READER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+// A packet read from a capture file
+typedef struct _pcapRecord {
+	uint64_t ts_ns;      // Capture timestamp, in ns since the epoch
+	const uint8_t *data; // Captured bytes (they point inside the mapped file: no copy is made)
+	uint32_t caplen;     // Number of captured bytes
+	uint32_t len;        // Original length of the packet
+	uint16_t linktype;   // LINKTYPE_* value of the interface the packet was captured on (1 = Ethernet)
+} pcapRecord_t;
+
+// Reader of pcap and pcapng capture files, which maps the whole file in memory and returns the packets without copying
+// them (the records are thus valid until close() is called, and they can be read from any thread)
+// Both the classic pcap format (with microseconds or nanoseconds timestamps, in any byte order) and the pcapng format
+// (Enhanced, Simple and obsolete Packet Blocks, with any timestamp resolution and in any byte order, even with several
+// sections and interfaces) are supported
+class PcapMmapReader {
+	private:
+		typedef struct _pcapngInterface {
+			uint16_t linktype;
+			uint64_t ts_per_sec; // Timestamp units per second (if_tsresol option)
+		} pcapngInterface_t;
+
+		const uint8_t *m_map;
+		size_t m_size;
+		size_t m_pos;
+
+		bool m_pcapng;
+		bool m_swapped;          // true if the current file (pcap) or section (pcapng) is in the opposite byte order
+
+		// Classic pcap
+		uint16_t m_linktype;
+		uint64_t m_ts_per_sec;   // 1000000 (microseconds) or 1000000000 (nanoseconds)
+
+		// pcapng
+		std::vector<pcapngInterface_t> m_interfaces; // Interfaces of the current section
+		uint64_t m_last_ts_ns;   // Timestamp of the last packet (used for the Simple Packet Blocks, which have none)
+
+		std::string m_error;     // Why next() stopped before the end of the file (empty if not known)
+
+		uint16_t rd16(const uint8_t *p) const;
+		uint32_t rd32(const uint8_t *p) const;
+		static uint64_t to_ns(uint64_t ts, uint64_t ts_per_sec);
+
+		bool next_pcap(pcapRecord_t &rec);
+		bool next_pcapng(pcapRecord_t &rec);
+		bool read_section_header(const uint8_t *block);
+		// Returns false, setting m_error, if the block has an invalid option
+		bool read_interface_description(const uint8_t *block, uint32_t block_len);
+
+	public:
+		PcapMmapReader();
+		~PcapMmapReader();
+
+		// Returns false, with a description of the error in "error", if the file cannot be opened or mapped, or if it is not
+		// a pcap/pcapng file
+		bool open(const std::string &path, std::string &error);
+		void close(void);
+
+		// Get the next packet; returns false at the end of the file (or at the first truncated or malformed record)
+		bool next(pcapRecord_t &rec);
+		// Parse error which stopped next() before the end of the file (empty at the end of the file)
+		const std::string &get_error(void) const {return m_error;}
+
+		// Progress of the reading, in bytes
+		size_t get_offset(void) const {return m_pos;}
+		size_t get_size(void) const {return m_size;}
+};
+
+#endif // PCAP_READER_H
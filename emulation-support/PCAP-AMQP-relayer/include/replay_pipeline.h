@@ -0,0 +1,82 @@
+#ifndef REPLAY_PIPELINE_H
+#define REPLAY_PIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pcap_reader.h"
+#include "gn_metadata.h"
+
+// A captured packet, after being decoded
+typedef struct _replayMsg {
+	pcapRecord_t rec;
+	bool relay;        // false if the packet must not be relayed (e.g. not a GeoNetworking packet, or a GN Beacon)
+	uint32_t offset;   // Offset of the message to be relayed inside rec.data
+	uint32_t len;      // Length of the message to be relayed
+	bool located;      // true if "meta" and "quadkey" have been extracted from the GN header
+	GNmetadata_t meta;
+	uint64_t quadkey;  // Integer quadkey (see sample_quad_final.h) of the sender position, at the deepest level of detail
+} replayMsg_t;
+
+// Block of consecutive packets, read and decoded together
+typedef struct _replayChunk {
+	std::vector<replayMsg_t> msgs;
+	size_t count;      // Number of valid entries of "msgs"
+	bool decoded;
+} replayChunk_t;
+
+// Three-stage pipeline replaying a capture file:
+// - a reader thread splits the (memory-mapped) capture into chunks of consecutive packets;
+// - a pool of worker threads decodes the chunks in parallel, with the decoder passed to the constructor;
+// - the output stage (the thread calling next_chunk()) gets the decoded chunks in the same order as in the capture.
+// A fixed number of chunks is allocated at the beginning and recycled: when the output stage is slower than the other
+// stages (e.g. because the packets are paced with their original timing), the reader waits for a chunk to be released
+class ReplayPipeline {
+	public:
+		// Decode msg.rec, filling in all the other fields of "msg"; it is called by several worker threads at the same time
+		typedef std::function<void(replayMsg_t &msg)> decoder_t;
+
+	private:
+		PcapMmapReader &m_reader;
+		decoder_t m_decoder;
+
+		std::vector<replayChunk_t> m_chunks;
+		std::vector<replayChunk_t *> m_free;      // Chunks which can be filled by the reader
+		std::deque<replayChunk_t *> m_to_decode;  // Chunks waiting for a worker
+		std::deque<replayChunk_t *> m_ordered;    // Chunks read and not yet passed to the output stage, in capture order
+		bool m_eof;
+		bool m_stopped;
+
+		std::mutex m_mtx;
+		std::condition_variable m_free_cv;
+		std::condition_variable m_work_cv;
+		std::condition_variable m_out_cv;
+
+		std::thread m_read_thread;
+		std::vector<std::thread> m_workers;
+
+		void read_loop(void);
+		void worker_loop(void);
+
+	public:
+		// "workers" decoding threads, "chunk_size" packets per chunk, "chunks_per_worker" chunks allocated for each worker
+		ReplayPipeline(PcapMmapReader &reader, decoder_t decoder, int workers, size_t chunk_size = 256, size_t chunks_per_worker = 4);
+		~ReplayPipeline();
+
+		void start(void);
+
+		// Output stage: next decoded chunk (blocking), or NULL when all the packets have been passed to the output stage (or
+		// after stop()). Each chunk must be given back with release_chunk() when its packets are no more needed
+		replayChunk_t *next_chunk(void);
+		void release_chunk(replayChunk_t *chunk);
+
+		// Stop the reader and the workers, and wait for them to terminate (called also by the destructor)
+		void stop(void);
+};
+
+#endif // REPLAY_PIPELINE_H
@@ -0,0 +1,291 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "pcap_reader.h"
+
+#define PCAP_MAGIC_US 0xa1b2c3d4
+#define PCAP_MAGIC_NS 0xa1b23c4d
+#define PCAP_FILE_HEADER_LEN 24
+#define PCAP_RECORD_HEADER_LEN 16
+
+#define PCAPNG_SHB 0x0A0D0D0A
+#define PCAPNG_IDB 0x00000001
+#define PCAPNG_OPB 0x00000002
+#define PCAPNG_SPB 0x00000003
+#define PCAPNG_EPB 0x00000006
+#define PCAPNG_BYTE_ORDER_MAGIC 0x1A2B3C4D
+#define PCAPNG_OPT_IF_TSRESOL 9
+
+PcapMmapReader::PcapMmapReader() :
+	m_map(NULL), m_size(0), m_pos(0), m_pcapng(false), m_swapped(false), m_linktype(0), m_ts_per_sec(1000000), m_last_ts_ns(0) {}
+
+PcapMmapReader::~PcapMmapReader() {
+	close();
+}
+
+uint16_t PcapMmapReader::rd16(const uint8_t *p) const {
+	uint16_t v;
+
+	memcpy(&v,p,sizeof(v));
+	return m_swapped ? __builtin_bswap16(v) : v;
+}
+
+uint32_t PcapMmapReader::rd32(const uint8_t *p) const {
+	uint32_t v;
+
+	memcpy(&v,p,sizeof(v));
+	return m_swapped ? __builtin_bswap32(v) : v;
+}
+
+uint64_t PcapMmapReader::to_ns(uint64_t ts, uint64_t ts_per_sec) {
+	if(ts_per_sec==1000000000ULL) {
+		return ts;
+	}
+
+	return (ts/ts_per_sec)*1000000000ULL+(uint64_t) (((unsigned __int128) (ts%ts_per_sec)*1000000000ULL)/ts_per_sec);
+}
+
+bool PcapMmapReader::open(const std::string &path, std::string &error) {
+	struct stat st;
+	int fd;
+
+	close();
+
+	fd=::open(path.c_str(),O_RDONLY);
+	if(fd<0) {
+		error="cannot open "+path+": "+strerror(errno);
+		return false;
+	}
+
+	if(fstat(fd,&st)<0 || st.st_size<PCAP_FILE_HEADER_LEN) {
+		error=path+" is not a pcap or pcapng file (too short)";
+		::close(fd);
+		return false;
+	}
+
+	void *map=mmap(NULL,st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+	// The mapping stays valid after closing the file descriptor
+	::close(fd);
+
+	if(map==MAP_FAILED) {
+		error="cannot map "+path+" in memory: "+strerror(errno);
+		return false;
+	}
+
+	// The file is read once, from the beginning to the end
+	madvise(map,st.st_size,MADV_SEQUENTIAL);
+
+	m_map=static_cast<const uint8_t *>(map);
+	m_size=st.st_size;
+	m_pos=0;
+
+	uint32_t magic;
+	memcpy(&magic,m_map,sizeof(magic));
+
+	if(magic==PCAPNG_SHB) {
+		m_pcapng=true;
+		m_last_ts_ns=0;
+		// The Section Header Block is read by next_pcapng(), as any other block
+		return true;
+	}
+
+	m_pcapng=false;
+	if(magic==PCAP_MAGIC_US || magic==__builtin_bswap32(PCAP_MAGIC_US)) {
+		m_ts_per_sec=1000000ULL;
+	} else if(magic==PCAP_MAGIC_NS || magic==__builtin_bswap32(PCAP_MAGIC_NS)) {
+		m_ts_per_sec=1000000000ULL;
+	} else {
+		error=path+" is not a pcap or pcapng file (unknown magic number)";
+		close();
+		return false;
+	}
+
+	m_swapped=(magic!=PCAP_MAGIC_US && magic!=PCAP_MAGIC_NS);
+	// The upper bits of the link-layer header type field may contain the FCS length
+	m_linktype=rd32(m_map+20)&0xFFFF;
+	m_pos=PCAP_FILE_HEADER_LEN;
+
+	return true;
+}
+
+void PcapMmapReader::close(void) {
+	if(m_map!=NULL) {
+		munmap((void *) m_map,m_size);
+	}
+
+	m_map=NULL;
+	m_size=0;
+	m_pos=0;
+	m_interfaces.clear();
+	m_error.clear();
+}
+
+bool PcapMmapReader::next(pcapRecord_t &rec) {
+	if(m_map==NULL) {
+		return false;
+	}
+
+	return m_pcapng ? next_pcapng(rec) : next_pcap(rec);
+}
+
+bool PcapMmapReader::next_pcap(pcapRecord_t &rec) {
+	if(m_pos+PCAP_RECORD_HEADER_LEN>m_size) {
+		return false;
+	}
+
+	const uint8_t *hdr=m_map+m_pos;
+	uint32_t caplen=rd32(hdr+8);
+
+	if(m_pos+PCAP_RECORD_HEADER_LEN+caplen>m_size) {
+		return false;
+	}
+
+	rec.ts_ns=(uint64_t) rd32(hdr)*1000000000ULL+(uint64_t) rd32(hdr+4)*(1000000000ULL/m_ts_per_sec);
+	rec.data=hdr+PCAP_RECORD_HEADER_LEN;
+	rec.caplen=caplen;
+	rec.len=rd32(hdr+12);
+	rec.linktype=m_linktype;
+
+	m_pos+=PCAP_RECORD_HEADER_LEN+caplen;
+
+	return true;
+}
+
+bool PcapMmapReader::read_section_header(const uint8_t *block) {
+	uint32_t bom;
+
+	memcpy(&bom,block+8,sizeof(bom));
+	if(bom==PCAPNG_BYTE_ORDER_MAGIC) {
+		m_swapped=false;
+	} else if(bom==__builtin_bswap32(PCAPNG_BYTE_ORDER_MAGIC)) {
+		m_swapped=true;
+	} else {
+		return false;
+	}
+
+	// The interface IDs are local to each section
+	m_interfaces.clear();
+
+	return true;
+}
+
+bool PcapMmapReader::read_interface_description(const uint8_t *block, uint32_t block_len) {
+	pcapngInterface_t iface;
+	size_t opt=16;
+
+	iface.linktype=rd16(block+8);
+	iface.ts_per_sec=1000000ULL;
+
+	// Options: code (2 bytes), length (2 bytes), value (padded to 32 bits); the block ends with its length (4 bytes)
+	while(opt+4<=block_len-4) {
+		uint16_t code=rd16(block+opt);
+		uint16_t len=rd16(block+opt+2);
+
+		if(code==0 || opt+4+len>block_len-4) {
+			break;
+		}
+
+		if(code==PCAPNG_OPT_IF_TSRESOL && len>=1) {
+			uint8_t tsresol=block[opt+4];
+
+			// Most significant bit set: negative power of 2, otherwise negative power of 10
+			// The resolutions finer than 2^-63 s or 10^-19 s do not fit in 64 bits (and they make no sense anyway)
+			if((tsresol&0x80 && (tsresol&0x7F)>63) || (!(tsresol&0x80) && tsresol>19)) {
+				m_error="invalid if_tsresol option ("+std::to_string(tsresol)+") in the interface description block at offset "+std::to_string(m_pos-block_len);
+				return false;
+			}
+
+			if(tsresol&0x80) {
+				iface.ts_per_sec=1ULL<<(tsresol&0x7F);
+			} else {
+				iface.ts_per_sec=1;
+				for(int i=0;i<tsresol;i++) {
+					iface.ts_per_sec*=10;
+				}
+			}
+		}
+
+		opt+=4+((len+3)&~3);
+	}
+
+	m_interfaces.push_back(iface);
+
+	return true;
+}
+
+bool PcapMmapReader::next_pcapng(pcapRecord_t &rec) {
+	while(m_pos+12<=m_size) {
+		const uint8_t *block=m_map+m_pos;
+		uint32_t type;
+
+		memcpy(&type,block,sizeof(type));
+
+		// The byte order of a section is known only after reading the byte-order magic of its header
+		if(type==PCAPNG_SHB && (m_pos+16>m_size || !read_section_header(block))) {
+			return false;
+		}
+
+		type=rd32(block);
+		uint32_t block_len=rd32(block+4);
+
+		if(block_len<12 || (block_len&3)!=0 || m_pos+block_len>m_size) {
+			return false;
+		}
+
+		m_pos+=block_len;
+
+		if(type==PCAPNG_IDB && block_len>=20) {
+			if(!read_interface_description(block,block_len)) {
+				return false;
+			}
+			continue;
+		}
+
+		uint32_t iface_id, caplen, len;
+		const uint8_t *data;
+
+		if((type==PCAPNG_EPB || type==PCAPNG_OPB) && block_len>=32) {
+			// The obsolete Packet Block has a 16-bit interface ID, followed by a 16-bit drop counter
+			iface_id=(type==PCAPNG_EPB) ? rd32(block+8) : rd16(block+8);
+
+			if(iface_id<m_interfaces.size()) {
+				m_last_ts_ns=to_ns(((uint64_t) rd32(block+12)<<32) | rd32(block+16),m_interfaces[iface_id].ts_per_sec);
+			}
+			caplen=rd32(block+20);
+			len=rd32(block+24);
+			data=block+28;
+
+			if(28+(uint64_t) caplen>block_len-4) {
+				return false;
+			}
+		} else if(type==PCAPNG_SPB && block_len>=16) {
+			// Simple Packet Block: no timestamp (the one of the previous packet is used) and the captured length is implied
+			// by the block length
+			iface_id=0;
+			len=rd32(block+8);
+			caplen=len<block_len-16 ? len : block_len-16;
+			data=block+12;
+		} else {
+			// Any other block (statistics, name resolution, custom...) is skipped
+			continue;
+		}
+
+		if(iface_id>=m_interfaces.size()) {
+			continue;
+		}
+
+		rec.ts_ns=m_last_ts_ns;
+		rec.data=data;
+		rec.caplen=caplen;
+		rec.len=len;
+		rec.linktype=m_interfaces[iface_id].linktype;
+
+		return true;
+	}
+
+	return false;
+}
@@ -13,6 +13,7 @@
 #include <thread>
 #include <arpa/inet.h>
 #include <cstring>
+#include <signal.h>
 
 #include <proton/connection.hpp>
 #include <proton/delivery.hpp>
@@ -42,10 +43,150 @@ extern "C" {
 
 #include "camrelayeramqp.h"
 #include "sample_quad_final.h"
+#include "pcap_reader.h"
+#include "replay_pipeline.h"
+
+#define LINKTYPE_ETHERNET 1
+#define ETHERTYPE_GEONET 0x8947
+#define ETHERTYPE_IPV4 0x0800
+#define ETHERTYPE_VLAN 0x8100
+#define ETHERTYPE_QINQ 0x88A8
+
+// Messages relayed more than this time after their scheduled time are counted as late
+#define REPLAY_LATE_THRESHOLD_NS 1000000ULL
 
 // Global atomic flag to terminate the whole program in case of errors
 std::atomic<bool> terminatorFlag;
 
+// Counters of the replay
+typedef struct _replayStats {
+	uint64_t read;       // Packets read from the capture
+	uint64_t skipped;    // Packets not relayed (not GeoNetworking, GN Beacons, or too long)
+	uint64_t relayed;    // Messages passed to the AMQP sender
+	uint64_t injected;   // Packets injected on the --interface
+	uint64_t ring_waits; // Number of times the replay has waited for the AMQP sender, because the ring was full
+	uint64_t late;       // Messages relayed more than REPLAY_LATE_THRESHOLD_NS after their scheduled time
+	uint64_t max_lag_ns; // Maximum delay of a message with respect to its scheduled time
+	uint64_t trace_ns;   // Capture time elapsed between the first and the last relayed message
+} replayStats_t;
+
+static void terminator_handler(int signum) {
+	terminatorFlag = true;
+}
+
+static uint64_t monotonic_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+
+	return ts.tv_sec*1000000000ULL+ts.tv_nsec;
+}
+
+static void print_stats(replayStats_t &st, relayerSenderStats_t tx, replayStats_t &prev_st, double interval, SPSCRing &ring) {
+	double wall = interval > 0 ? interval : 1e-9;
+
+	std::cout << "[stats] read: " << st.read << " (" << (st.read-prev_st.read)/wall << " pkt/s)"
+		<< " | relayed: " << st.relayed << " (" << (st.relayed-prev_st.relayed)/wall << " msg/s)"
+		<< " | sent: " << tx.sent
+		<< " | skipped: " << st.skipped
+		<< " | injected: " << st.injected
+		<< " | trace time: " << st.trace_ns/1e9 << " s (x" << (st.trace_ns-prev_st.trace_ns)/1e9/wall << ")"
+		<< " | late: " << st.late << " (max lag " << st.max_lag_ns/1e6 << " ms)"
+		<< " | ring: " << ring.available() << "/" << ring.capacity() << " (" << st.ring_waits << " waits)"
+		<< " | credit: " << tx.credit << " (" << tx.credit_stalls << " stalls)" << std::endl;
+
+	prev_st=st;
+}
+
+static uint16_t read_be16(const uint8_t *p) {
+	return ((uint16_t) p[0] << 8) | p[1];
+}
+
+// Offset of the GeoNetworking Basic Header inside a captured packet
+static bool find_gn_header(const pcapRecord_t &rec, uint32_t &gn_offset) {
+	if(rec.linktype == LINKTYPE_ETHERNET) {
+		uint32_t off = 12;
+
+		if(rec.caplen < off+2) {
+			return false;
+		}
+
+		uint16_t ethertype = read_be16(rec.data+off);
+		while((ethertype == ETHERTYPE_VLAN || ethertype == ETHERTYPE_QINQ) && rec.caplen >= off+6) {
+			off += 4;
+			ethertype = read_be16(rec.data+off);
+		}
+		off += 2;
+
+		if(ethertype == ETHERTYPE_GEONET) {
+			gn_offset = off;
+			return true;
+		}
+
+		// ms-van3t in UDP mode: GN + BTP + Facilities layer message inside an IPv4/UDP packet
+		if(ethertype == ETHERTYPE_IPV4 && rec.caplen >= off+20 && (rec.data[off] >> 4) == 4 && rec.data[off+9] == IPPROTO_UDP) {
+			gn_offset = off + (rec.data[off] & 0x0F)*4 + 8;
+			return gn_offset < rec.caplen;
+		}
+
+		return false;
+	}
+
+	// Other link-layer header types (e.g. 802.11 captures): look for the GeoNetworking EtherType
+	for(uint32_t i = 0; i+1 < rec.caplen; i++) {
+		if(rec.data[i] == 0x89 && rec.data[i+1] == 0x47) {
+			gn_offset = i+2;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Called in parallel by the workers of the replay pipeline
+static void decode_its_message(replayMsg_t &msg, bool skipGN) {
+	uint32_t gn_offset;
+
+	msg.relay = false;
+	msg.located = false;
+
+	if(!find_gn_header(msg.rec,gn_offset)) {
+		return;
+	}
+
+	const uint8_t *gn_buf = msg.rec.data+gn_offset;
+	size_t gn_len = msg.rec.caplen-gn_offset;
+
+	// Basic Header: version 0 or 1, Next Header 1 (Common Header) or 2 (Secured Packet)
+	if(gn_len < GN_BASIC_HEADER_LEN+GN_COMMON_HEADER_LEN || (gn_buf[0] >> 4) > 1 || ((gn_buf[0] & 0x0F) != 1 && (gn_buf[0] & 0x0F) != 2)) {
+		return;
+	}
+
+	// GN Beacons (Header Type 1) do not carry any Facilities layer message
+	if((gn_buf[0] & 0x0F) == 1 && (gn_buf[GN_BASIC_HEADER_LEN+1] >> 4) == 1) {
+		return;
+	}
+
+	msg.located = parse_gn_metadata(gn_buf,gn_len,msg.meta);
+	if(msg.located) {
+		msg.quadkey = QuadKeys::QuadKeyTS::LatLonToCode(msg.meta.lat/1e7,msg.meta.lon/1e7,QuadKeys::maxLevelOfDetail);
+	}
+
+	if(skipGN == true) {
+		size_t facilities_offset = gn_facilities_offset(gn_buf,gn_len);
+
+		// The Facilities layer message cannot be located in secured packets
+		if(facilities_offset == 0) {
+			return;
+		}
+		msg.offset = gn_offset+facilities_offset;
+	} else {
+		msg.offset = gn_offset;
+	}
+
+	msg.len = msg.rec.caplen-msg.offset;
+	msg.relay = (msg.len > 0 && msg.len <= RELAYER_MAX_MSG_SIZE);
+}
+
 // Thread callback function
 void *CAMrelayer_callback(void *arg) {
 	CAMrelayerAMQP *cr_AMQP_class_ptr=static_cast<CAMrelayerAMQP *>(arg);
@@ -55,13 +196,14 @@ void *CAMrelayer_callback(void *arg) {
 		try {
 			// Create a new Qpid Proton container and run it to start the AMQP 1.0 event loop
 			proton::container(*cr_AMQP_class_ptr).run();
-
-			pthread_exit(NULL);
 		} catch (const std::exception& e) {
 			std::cerr << "Qpid Proton library error while running CAMrelayerAMQP. Please find more details below." << std::endl;
 			std::cerr << e.what() << std::endl;
-			terminatorFlag = true;
 		}
+
+		// The container stops only when the connection to the broker is closed or fails
+		cr_AMQP_class_ptr->set_stopped();
+		terminatorFlag = true;
 	} else {
 		std::cerr << "Error. NULL CAMrelayerAMQP object. Cannot start the AMQP client." << std::endl;
 		terminatorFlag = true;
@@ -75,14 +217,18 @@ void *CAMrelayer_callback(void *arg) {
 int main(int argc, char *argv[]) {
 	// Create thread structure to pass the needed arguments to the thread callback
 	pthread_camrelayer_args_t cam_args;
-	int comm_port = 20000;
 	bool skipGN = false;
-    //Pcap file
-    std::string file,interface;
+	//Pcap file
+	std::string file,interface;
+	double speed = 1.0;
+	int workers = std::thread::hardware_concurrency() > 2 ? std::thread::hardware_concurrency()-2 : 1;
+	int chunk_size = 256;
+	int ring_size = 8192;
+	int stats_interval = 5;
 
 	// Parse the command line options with the TCLAP library
 	try {
-		TCLAP::CmdLine cmd("S-LDM Testing Facilities - UDP->AMQP 1.0 relayer", ' ', "1.0");
+		TCLAP::CmdLine cmd("S-LDM Testing Facilities - PCAP->AMQP 1.0 relayer", ' ', "1.0");
 
 		// Arguments: short option, long option, description, is it mandatory?, default value, type indication (just a string to help the user)
 		TCLAP::ValueArg<std::string> urlArg("U","url","Broker URL (with port)",false,"127.0.0.1:5672","string");
@@ -94,147 +240,271 @@ int main(int argc, char *argv[]) {
 		TCLAP::ValueArg<std::string> gntstpropArg("T","gn-tst-prop","Name of the amqp gn-timestamp property",false,"gn_ts","string");
 		cmd.add(gntstpropArg);
 
-		TCLAP::ValueArg<int> portArg("P","comm-port","Port for the UDP communication with ms-van3t",false,20000,"int");
-		cmd.add(portArg);
-
 		TCLAP::SwitchArg skipGNArg("S","skip-gn","Specify this option to send only Facilities Layer messages, instead of full ITS messages (Facilities layer + GeoNetworking + BTP). Warning! Experimental feature (it will work when only CAMs are sent)!");
 		cmd.add(skipGNArg);
 
-        TCLAP::ValueArg<std::string> inArg("I","in","Input .pcap file",false,"/home/cnituser/PCAP-AMQP-relayer/ms-van3t-30v-3600.pcap","string");
-        cmd.add(inArg);
+		TCLAP::ValueArg<std::string> inArg("I","in","Input .pcap or .pcapng file",false,"/home/cnituser/PCAP-AMQP-relayer/ms-van3t-30v-3600.pcap","string");
+		cmd.add(inArg);
 
-		TCLAP::ValueArg<std::string> intArg("N","interface","Interface on which to inject the packets",false,"eno1","string");
+		TCLAP::ValueArg<std::string> intArg("N","interface","Interface on which to inject the packets, besides relaying them to the broker (if not specified, the packets are only relayed)",false,"","string");
 		cmd.add(intArg);
 
-		cmd.parse(argc,argv);
+		TCLAP::ValueArg<double> speedArg("","speed","Replay speed: 1 to relay the messages with their original timing, N to replay the capture N times faster, 0 to relay the messages as fast as possible",false,1.0,"double");
+		cmd.add(speedArg);
 
-		cam_args.m_broker_address=urlArg.getValue();
-		cam_args.m_queue_name=queueArg.getValue();
-		cam_args.m_gn_tst_prop_name=gntstpropArg.getValue();
-		comm_port=portArg.getValue();
-		skipGN=skipGNArg.getValue();
-        file = inArg;
-		interface = intArg;
+		TCLAP::ValueArg<int> workersArg("","workers","Number of threads decoding the captured packets",false,workers,"int");
+		cmd.add(workersArg);
 
-		std::cout << "The relayer will connect to " + cam_args.m_broker_address + "/" + cam_args.m_queue_name << std::endl;
-	} catch (TCLAP::ArgException &tclape) { 
-		std::cerr << "TCLAP error: " << tclape.error() << " for argument " << tclape.argId() << std::endl;
-	}
+		TCLAP::ValueArg<int> chunkSizeArg("","chunk-size","Number of consecutive packets decoded together by a thread",false,256,"int");
+		cmd.add(chunkSizeArg);
 
+		TCLAP::ValueArg<int> ringSizeArg("","ring-size","Number of messages which can be queued towards the AMQP sender (rounded up to a power of 2)",false,8192,"int");
+		cmd.add(ringSizeArg);
 
+		TCLAP::ValueArg<int> batchSizeArg("","batch-size","Number of queued messages which immediately wakes up the AMQP sender",false,32,"int");
+		cmd.add(batchSizeArg);
 
-    // CAM relayer object
-    CAMrelayerAMQP CAM_relayer_obj;
+		TCLAP::ValueArg<int> lingerArg("","linger-ms","Maximum time a message waits for the batch to be completed, before being sent (0: send the messages as soon as they are due)",false,0,"int");
+		cmd.add(lingerArg);
 
-    // Creation of the thread
-    // CAM Relayer Thread attributes
-    pthread_attr_t tattr;
-    // CAM Relayer Thread ID
-    pthread_t curr_tid;
+		TCLAP::ValueArg<int> quadkeyLevelArg("","quadkey-level","Level of detail of the \"quadkeys\" property, containing the quadkey of the sender position, added to the relayed messages (0: do not add it)",false,18,"int");
+		cmd.add(quadkeyLevelArg);
 
-//     Set the terminator flag to false
-    terminatorFlag = false;
+		TCLAP::ValueArg<int> statsArg("","stats-interval","Interval between two prints of the throughput counters, in seconds (0: print them only at the end of the replay)",false,5,"int");
+		cmd.add(statsArg);
 
-//     Set the arguments/parameters of the CAMrelayerAMQP object
-    CAM_relayer_obj.set_args(cam_args);
+		cmd.parse(argc,argv);
 
-//     pthread_attr_init()/pthread_attr_setdetachstate()/pthread_attr_destroy() may probably be removed in the future
-//     If removed, the second argument of pthread_create() should be NULL instead of &tattr
-    pthread_attr_init(&tattr);
-    pthread_attr_setdetachstate(&tattr,PTHREAD_CREATE_DETACHED);
+		cam_args.m_broker_address=urlArg.getValue();
+		cam_args.m_queue_name=queueArg.getValue();
+		cam_args.m_gn_tst_prop_name=gntstpropArg.getValue();
+		cam_args.m_quadkey_level=quadkeyLevelArg.getValue();
+		cam_args.m_batch_size=batchSizeArg.getValue()>0 ? batchSizeArg.getValue() : 1;
+		cam_args.m_linger=lingerArg.getValue()>0 ? proton::duration(lingerArg.getValue()) : proton::duration::IMMEDIATE;
+		skipGN=skipGNArg.getValue();
+		file = inArg.getValue();
+		interface = intArg.getValue();
+		speed=speedArg.getValue();
+		workers=workersArg.getValue();
+		chunk_size=chunkSizeArg.getValue();
+		ring_size=ringSizeArg.getValue();
+		stats_interval=statsArg.getValue();
+
+		if(speed<0 || workers<1 || chunk_size<1 || ring_size<1) {
+			std::cerr << "Error: --speed must not be negative, and --workers, --chunk-size and --ring-size must be at least 1." << std::endl;
+			exit(EXIT_FAILURE);
+		}
 
-    // Passing as argument, to the thread, a pointer to the CAM_relayer_obj CAMrelayerAMQP object
-    // pthread_create() actually creates a new (parallel) thread, running the content of the function "CAMrelayer_callback" (which must be a void *(void *) function)
-    pthread_create(&curr_tid,&tattr,CAMrelayer_callback,(void *) &(CAM_relayer_obj));
-    pthread_attr_destroy(&tattr);
+		if(cam_args.m_quadkey_level<0 || cam_args.m_quadkey_level>QuadKeys::maxLevelOfDetail) {
+			std::cerr << "Error: --quadkey-level must be between 0 and " << QuadKeys::maxLevelOfDetail << "." << std::endl;
+			exit(EXIT_FAILURE);
+		}
+
+		std::cout << "The relayer will connect to " + cam_args.m_broker_address + "/" + cam_args.m_queue_name << std::endl;
+	} catch (TCLAP::ArgException &tclape) {
+		std::cerr << "TCLAP error: " << tclape.error() << " for argument " << tclape.argId() << std::endl;
+	}
 
-    // Wait for the sender to be open before moving on (as required and as described inside camrelayeramqp.h)
-    bool sender_ready_status;
+	// Open the capture before connecting to the broker, in order to fail early
+	PcapMmapReader reader;
+	std::string reader_error;
 
-    std::cout << "Waiting for the AMQP sender to be ready..." << std::endl;
+	if(!reader.open(file,reader_error)) {
+		std::cerr << "Error: " << reader_error << std::endl;
+		return 1;
+	}
 
-    sender_ready_status=CAM_relayer_obj.wait_sender_ready();
+	char errbuff[PCAP_ERRBUF_SIZE];
+	pcap_t *ppcap = NULL;
 
-    std::cout << "Sender should be ready. Status (0 = error, 1 = ok): " << sender_ready_status << std::endl;
+	//Open interface for packet injection
+	if(!interface.empty()) {
+		ppcap = pcap_open_live(interface.c_str(), 800, 1, 20, errbuff);
 
+		if (ppcap == NULL) {
+			printf("Could not open interface for packet injection: %s", errbuff);
+			return 2;
+		}
+	}
 
+	// CAM relayer object
+	CAMrelayerAMQP CAM_relayer_obj;
 
-    GNmetadata_t gnmetadata;
+	// Ring between the replay (producer) and the AMQP sender (consumer, running in the Qpid Proton container thread)
+	SPSCRing ring(ring_size);
 
-    char errbuff[PCAP_ERRBUF_SIZE];
-    //Open pcap file
-    pcap_t * pcap = pcap_open_offline(file.c_str(), errbuff);
+	// Creation of the thread
+	// CAM Relayer Thread attributes
+	pthread_attr_t tattr;
+	// CAM Relayer Thread ID
+	pthread_t curr_tid;
 
-    struct pcap_pkthdr *header;
-    const u_char *data;
-    long pcount = 0;
+	// Set the terminator flag to false
+	terminatorFlag = false;
 
-	//Open interface for packet injection
-    pcap_t * ppcap = pcap_open_live(interface.c_str(), 800, 1, 20, errbuff);
+	// Set the arguments/parameters of the CAMrelayerAMQP object
+	CAM_relayer_obj.set_args(cam_args);
+	CAM_relayer_obj.set_ring(&ring);
 
-    if (ppcap == NULL) {
-        printf("Could not open interface for packet injection: %s", errbuff);
-        return 2;
-    }
+	// pthread_attr_init()/pthread_attr_setdetachstate()/pthread_attr_destroy() may probably be removed in the future
+	// If removed, the second argument of pthread_create() should be NULL instead of &tattr
+	pthread_attr_init(&tattr);
+	pthread_attr_setdetachstate(&tattr,PTHREAD_CREATE_DETACHED);
 
-    unsigned long previous_s,previous_us;
-    previous_s = 0;
-    previous_us = 0;
+	// Passing as argument, to the thread, a pointer to the CAM_relayer_obj CAMrelayerAMQP object
+	// pthread_create() actually creates a new (parallel) thread, running the content of the function "CAMrelayer_callback" (which must be a void *(void *) function)
+	pthread_create(&curr_tid,&tattr,CAMrelayer_callback,(void *) &(CAM_relayer_obj));
+	pthread_attr_destroy(&tattr);
 
+	// Wait for the sender to be open before moving on (as required and as described inside camrelayeramqp.h)
+	bool sender_ready_status;
 
-    int returnValue;
-    while((returnValue = pcap_next_ex(pcap, &header, &data)) > 0) {
+	std::cout << "Waiting for the AMQP sender to be ready..." << std::endl;
 
-        unsigned long current_s,current_us;
-		struct timespec time, rem;
+	sender_ready_status=CAM_relayer_obj.wait_sender_ready();
 
-        if (returnValue == PCAP_ERROR || returnValue == PCAP_ERROR_BREAK) {
-            std::cerr << "End of pcap file or an error occurred." << std::endl;
-        }
+	std::cout << "Sender should be ready. Status (0 = error, 1 = ok): " << sender_ready_status << std::endl;
 
-        pcount++;
+	if(sender_ready_status==false) {
+		std::cerr << "Error: the AMQP sender could not be opened. Terminating." << std::endl;
+		exit(EXIT_FAILURE);
+	}
 
-        // This "if" has been added to avoid making the program crash if a message shorter than 60 B is received from ms-van3t (it should never happen, but we added this "if" just to be on the safe side)
-        if(skipGN == true && header->len <= 68) {
-                continue;
-        }
+	// Terminate gracefully (printing the final counters) on SIGINT/SIGTERM
+	struct sigaction sa;
+	memset(&sa,0,sizeof(sa));
+	sa.sa_handler=terminator_handler;
+	sigaction(SIGINT,&sa,NULL);
+	sigaction(SIGTERM,&sa,NULL);
 
-        // Skip until we find 0x8947
-        int offset = -1;
-        for (unsigned int i = 0; i < header->len - 1; i++) {
-            if (data[i] == 0x89 && data[i + 1] == 0x47) {
-                offset = i;
-                break;
-              }
-          }
+	std::cout << "Replaying " << file << " (" << reader.get_size() << " bytes) with " << workers << " decoding threads, ";
+	if(speed > 0) {
+		std::cout << "at x" << speed << " speed" << std::endl;
+	} else {
+		std::cout << "as fast as possible" << std::endl;
+	}
 
-        if (offset == -1) {
-            std::cerr << "Could not find 0x8947 in the packet. Skipping packet." << std::endl;
-            continue;
-          }
-        offset += 2; // Skip 0x8947
+	// Read and decode the packets in parallel; the decoded packets are relayed, in capture order, by this thread
+	ReplayPipeline pipeline(reader,[skipGN](replayMsg_t &msg) {decode_its_message(msg,skipGN);},workers,chunk_size);
+	pipeline.start();
+
+	replayStats_t stats;
+	memset(&stats,0,sizeof(stats));
+	replayStats_t prev_stats = stats;
+
+	uint64_t first_ts_ns = 0;
+	uint64_t start_ns = 0;
+	bool first = true;
+	uint64_t last_stats_ns = monotonic_ns();
+	uint64_t replay_start_ns = last_stats_ns;
+	replayChunk_t *chunk;
+
+	while(terminatorFlag==false && (chunk=pipeline.next_chunk())!=NULL) {
+		for(size_t i=0;i<chunk->count && terminatorFlag==false;i++) {
+			replayMsg_t &msg=chunk->msgs[i];
+			uint64_t now_ns = monotonic_ns();
+
+			stats.read++;
+
+			if(stats_interval > 0 && now_ns-last_stats_ns >= stats_interval*1000000000ULL) {
+				print_stats(stats,CAM_relayer_obj.get_stats(),prev_stats,(now_ns-last_stats_ns)/1e9,ring);
+				last_stats_ns = now_ns;
+			}
+
+			if(!msg.relay) {
+				stats.skipped++;
+				continue;
+			}
+
+			if(first) {
+				first_ts_ns = msg.rec.ts_ns;
+				start_ns = now_ns;
+				first = false;
+			}
+
+			// Capture timestamps going backwards (e.g. in merged captures) are relayed immediately
+			uint64_t trace_ns = msg.rec.ts_ns > first_ts_ns ? msg.rec.ts_ns-first_ts_ns : 0;
+			stats.trace_ns = std::max<uint64_t>(stats.trace_ns,trace_ns);
+
+			if(speed > 0) {
+				// Each message is scheduled with respect to the first one, so that the pacing errors do not accumulate
+				uint64_t due_ns = start_ns + (uint64_t) (trace_ns/speed);
+
+				// Sleep in steps of at most 200 ms, to keep on printing the counters and checking terminatorFlag during long
+				// silences in the capture
+				while(now_ns < due_ns && terminatorFlag==false) {
+					uint64_t wake_ns = std::min<uint64_t>(due_ns,now_ns+200000000ULL);
+					struct timespec wake = {(time_t) (wake_ns/1000000000ULL), (long) (wake_ns%1000000000ULL)};
+
+					clock_nanosleep(CLOCK_MONOTONIC,TIMER_ABSTIME,&wake,NULL);
+					now_ns = monotonic_ns();
+
+					if(stats_interval > 0 && now_ns-last_stats_ns >= stats_interval*1000000000ULL) {
+						print_stats(stats,CAM_relayer_obj.get_stats(),prev_stats,(now_ns-last_stats_ns)/1e9,ring);
+						last_stats_ns = now_ns;
+					}
+				}
+
+				if(now_ns > due_ns) {
+					stats.max_lag_ns = std::max<uint64_t>(stats.max_lag_ns,now_ns-due_ns);
+					if(now_ns-due_ns > REPLAY_LATE_THRESHOLD_NS) {
+						stats.late++;
+					}
+				}
+			}
+
+			if(ppcap != NULL && pcap_inject(ppcap,msg.rec.data,msg.rec.caplen) >= 0) {
+				stats.injected++;
+			}
+
+			// The messages are never dropped: when the broker is slower than the replay, wait for the ring to have room
+			relayerSlot_t *slot = NULL;
+			while(ring.reserve(&slot,1) == 0 && terminatorFlag==false) {
+				stats.ring_waits++;
+				CAM_relayer_obj.notify_ring();
+				usleep(100);
+			}
+
+			if(terminatorFlag==true) {
+				break;
+			}
+
+			memcpy(slot->data,msg.rec.data+msg.offset,msg.len);
+			slot->offset=0;
+			slot->len=msg.len;
+			slot->located=msg.located;
+			slot->meta=msg.meta;
+			slot->quadkey=msg.quadkey;
+
+			ring.commit(1);
+			CAM_relayer_obj.notify_ring();
+			stats.relayed++;
+		}
 
-        //Take current packet capture timestamp
-        current_s = header->ts.tv_sec;
-        current_us= header->ts.tv_usec + (current_s*1000000);
+		pipeline.release_chunk(chunk);
+	}
 
-        //Compute timestamp difference from previous
-        time.tv_sec = 0;
-        time.tv_nsec = (current_us-previous_us)*1000;
+	pipeline.stop();
 
-        nanosleep(&time , &rem);
+	if(!reader.get_error().empty()) {
+		std::cerr << "Error: the replay stopped before the end of " << file << ": " << reader.get_error() << std::endl;
+	}
 
-        //Update previous timestamp
-        previous_s=current_s;
-        previous_us=current_us;
+	// Give the AMQP sender some time to send the messages still in the ring
+	uint64_t drain_start_ns = monotonic_ns();
+	while(ring.available() > 0 && terminatorFlag==false && monotonic_ns()-drain_start_ns < 10000000000ULL) {
+		CAM_relayer_obj.notify_ring();
+		usleep(1000);
+	}
 
+	// Final counters, with the average rates over the whole replay
+	replayStats_t zero_stats;
+	memset(&zero_stats,0,sizeof(zero_stats));
+	std::cout << "Replay terminated. Total counters:" << std::endl;
+	print_stats(stats,CAM_relayer_obj.get_stats(),zero_stats,(monotonic_ns()-replay_start_ns)/1e9,ring);
 
-        //Send packet
-        if(skipGN == false) {
-			CAM_relayer_obj.sendCAM_AMQP((uint8_t*)data+offset,header->len);
-		} else {
-			CAM_relayer_obj.sendCAM_AMQP(((uint8_t*)data)+68,((int)header->len)-68);
-		}
+	if(ppcap != NULL) {
+		pcap_close(ppcap);
 	}
 
 	return 0;
@@ -0,0 +1,155 @@
+#include "replay_pipeline.h"
+
+ReplayPipeline::ReplayPipeline(PcapMmapReader &reader, decoder_t decoder, int workers, size_t chunk_size, size_t chunks_per_worker) :
+	m_reader(reader), m_decoder(decoder), m_eof(false), m_stopped(false) {
+	if(workers<1) {
+		workers=1;
+	}
+
+	// At least one more chunk than the workers, so that the reader can go on while all the workers are busy
+	m_chunks.resize(workers*chunks_per_worker+1);
+	for(replayChunk_t &chunk : m_chunks) {
+		chunk.msgs.resize(chunk_size>0 ? chunk_size : 1);
+		chunk.count=0;
+		chunk.decoded=false;
+		m_free.push_back(&chunk);
+	}
+
+	m_workers.resize(workers);
+}
+
+ReplayPipeline::~ReplayPipeline() {
+	stop();
+}
+
+void ReplayPipeline::start(void) {
+	m_read_thread=std::thread(&ReplayPipeline::read_loop,this);
+
+	for(std::thread &worker : m_workers) {
+		worker=std::thread(&ReplayPipeline::worker_loop,this);
+	}
+}
+
+void ReplayPipeline::read_loop(void) {
+	bool eof=false;
+
+	while(!eof) {
+		replayChunk_t *chunk;
+
+		{
+			std::unique_lock<std::mutex> lk(m_mtx);
+			m_free_cv.wait(lk,[this]{return !m_free.empty() || m_stopped;});
+
+			if(m_stopped) {
+				return;
+			}
+
+			chunk=m_free.back();
+			m_free.pop_back();
+		}
+
+		// The reader is used only by this thread
+		chunk->count=0;
+		chunk->decoded=false;
+		while(chunk->count<chunk->msgs.size() && m_reader.next(chunk->msgs[chunk->count].rec)) {
+			chunk->count++;
+		}
+		eof=(chunk->count<chunk->msgs.size());
+
+		{
+			std::lock_guard<std::mutex> lk(m_mtx);
+
+			if(chunk->count>0) {
+				m_ordered.push_back(chunk);
+				m_to_decode.push_back(chunk);
+			} else {
+				m_free.push_back(chunk);
+			}
+
+			m_eof=eof;
+		}
+
+		if(eof) {
+			m_work_cv.notify_all();
+			m_out_cv.notify_all();
+		} else {
+			m_work_cv.notify_one();
+		}
+	}
+}
+
+void ReplayPipeline::worker_loop(void) {
+	while(true) {
+		replayChunk_t *chunk;
+
+		{
+			std::unique_lock<std::mutex> lk(m_mtx);
+			m_work_cv.wait(lk,[this]{return !m_to_decode.empty() || m_eof || m_stopped;});
+
+			// After the end of the file, the workers terminate as soon as there is nothing left to decode
+			if(m_stopped || m_to_decode.empty()) {
+				return;
+			}
+
+			chunk=m_to_decode.front();
+			m_to_decode.pop_front();
+		}
+
+		for(size_t i=0;i<chunk->count;i++) {
+			m_decoder(chunk->msgs[i]);
+		}
+
+		{
+			std::lock_guard<std::mutex> lk(m_mtx);
+			chunk->decoded=true;
+		}
+
+		// Only the first chunk of m_ordered can wake up the output stage, but it may not be this one
+		m_out_cv.notify_all();
+	}
+}
+
+replayChunk_t *ReplayPipeline::next_chunk(void) {
+	std::unique_lock<std::mutex> lk(m_mtx);
+
+	m_out_cv.wait(lk,[this]{return m_stopped || (!m_ordered.empty() && m_ordered.front()->decoded) || (m_eof && m_ordered.empty());});
+
+	if(m_stopped || m_ordered.empty()) {
+		return NULL;
+	}
+
+	replayChunk_t *chunk=m_ordered.front();
+	m_ordered.pop_front();
+
+	return chunk;
+}
+
+void ReplayPipeline::release_chunk(replayChunk_t *chunk) {
+	{
+		std::lock_guard<std::mutex> lk(m_mtx);
+		m_free.push_back(chunk);
+	}
+
+	m_free_cv.notify_one();
+}
+
+void ReplayPipeline::stop(void) {
+	{
+		std::lock_guard<std::mutex> lk(m_mtx);
+		m_stopped=true;
+	}
+
+	m_free_cv.notify_all();
+	m_work_cv.notify_all();
+	m_out_cv.notify_all();
+
+	if(m_read_thread.joinable()) {
+		m_read_thread.join();
+	}
+
+	for(std::thread &worker : m_workers) {
+		if(worker.joinable()) {
+			worker.join();
+		}
+	}
+}
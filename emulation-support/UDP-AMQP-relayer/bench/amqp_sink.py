@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+"""
+Minimal stand-in of an AMQP 1.0 broker, to benchmark the UDP->AMQP relayer without a real broker.
+
+It accepts the connection of the relayer, keeps granting credit to its sender and counts the received messages,
+printing the throughput every second. Start it with:
+
+    python3 amqp_sink.py --url 127.0.0.1:5672
+
+and then launch the relayer with "--url 127.0.0.1:5672". A smaller --credit can be used to test the behaviour of the
+relayer when the broker is slower than the incoming traffic.
+"""
+
+import argparse
+import time
+
+from proton.handlers import MessagingHandler
+from proton.reactor import Container
+
+
+class AMQPSink(MessagingHandler):
+
+    def __init__(self, args):
+        # The credit window of the receiving links is refilled automatically by the MessagingHandler
+        super(AMQPSink, self).__init__(prefetch=args.credit)
+        self.url = args.url
+        self.count = 0
+        self.bytes = 0
+        self.last_count = 0
+        self.last_time = time.monotonic()
+        self.start_time = None
+
+    def on_start(self, event):
+        self.acceptor = event.container.listen(self.url)
+        event.container.schedule(1.0, self)
+        print('Listening on %s' % self.url, flush=True)
+
+    def on_timer_task(self, event):
+        now = time.monotonic()
+        if self.count > self.last_count:
+            print('%d messages (%.0f msg/s, %d bytes in total)' %
+                  (self.count, (self.count - self.last_count) / (now - self.last_time), self.bytes), flush=True)
+        self.last_count = self.count
+        self.last_time = now
+        event.container.schedule(1.0, self)
+
+    def on_message(self, event):
+        if self.start_time is None:
+            self.start_time = time.monotonic()
+        self.count += 1
+        self.bytes += len(event.message.body)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='AMQP 1.0 broker stand-in, counting the received messages')
+    parser.add_argument('--url', default='127.0.0.1:5672', help='Address to listen on')
+    parser.add_argument('--credit', type=int, default=1000, help='Credit window granted to each sender')
+    args = parser.parse_args()
+
+    sink = AMQPSink(args)
+    try:
+        Container(sink).run()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if sink.start_time is not None:
+            elapsed = time.monotonic() - sink.start_time
+            print('Total: %d messages in %.1f s (%.0f msg/s)' %
+                  (sink.count, elapsed, sink.count / elapsed if elapsed > 0 else 0.0))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+"""
+UDP traffic generator emulating the messages sent by ms-van3t in UDP mode, to benchmark the UDP->AMQP relayer.
+
+Each of the --vehicles emulated vehicles sends one --size bytes datagram every 1/--rate seconds. By default, the
+transmissions of the vehicles are spread uniformly over the period; with --burst, all the vehicles send at the same
+time, at the beginning of each period (worst case for the relayer). For instance, to emulate 500 vehicles at 10 Hz:
+
+    python3 udp_load_generator.py --dest 127.0.0.1:20000 --vehicles 500 --rate 10 --duration 60
+
+Each datagram starts with a GeoNetworking SHB header and a BTP header, with the position of the vehicle (randomly placed
+within --spread degrees from --center), followed by the ITS PDU header with the station ID of the vehicle, so that the
+area filtering and the quadkey properties of the relayer are exercised as with ms-van3t.
+"""
+
+import argparse
+import os
+import random
+import socket
+import struct
+import time
+
+
+def its_message(station_id, lat, lon, size):
+    # Basic Header (version 1, next header: Common Header), Common Header (next header: BTP-B, header type: TSB/SHB)
+    basic_header = struct.pack('!BBBB', 0x11, 0, 0x1a, 1)
+    common_header = struct.pack('!BBBBHBB', 0x20, 0x50, 0x02, 0, size - 40, 1, 0)
+    # SHB: Source Position Vector (GN address, timestamp, latitude, longitude, speed, heading) and reserved field
+    gn_address = struct.pack('!HxxI', 0x8000, station_id)
+    shb_header = gn_address + struct.pack('!IiiHHI', int(time.monotonic() * 1000) & 0xffffffff,
+                                          int(lat * 1e7), int(lon * 1e7), 0, 0, 0)
+    btp_header = struct.pack('!HH', 2001, 0)
+    # ITS PDU header (protocol version, message ID: CAM, station ID), followed by a random payload
+    its_pdu_header = struct.pack('!BBI', 2, 2, station_id)
+    headers = basic_header + common_header + shb_header + btp_header + its_pdu_header
+    return headers + os.urandom(max(0, size - len(headers)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='UDP traffic generator for the UDP->AMQP relayer')
+    parser.add_argument('--dest', default='10.10.7.254:20000', help='Address of the relayer (<IP>:<port>)')
+    parser.add_argument('--vehicles', type=int, default=500, help='Number of emulated vehicles')
+    parser.add_argument('--rate', type=float, default=10.0, help='Messages per second sent by each vehicle')
+    parser.add_argument('--size', type=int, default=200, help='Size of each datagram (bytes, at least 50)')
+    parser.add_argument('--center', default='45.0703,7.6869', help='Center of the area of the vehicles (<lat>,<lon>)')
+    parser.add_argument('--spread', type=float, default=0.05, help='Maximum distance of the vehicles from --center (degrees)')
+    parser.add_argument('--duration', type=float, default=30.0, help='Duration of the test (s)')
+    parser.add_argument('--burst', action='store_true', help='All the vehicles send at the beginning of each period')
+    args = parser.parse_args()
+
+    ip, port = args.dest.rsplit(':', 1)
+    dest = (ip, int(port))
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+
+    center_lat, center_lon = (float(c) for c in args.center.split(','))
+    rng = random.Random(1)
+    payloads = [its_message(v + 1, center_lat + rng.uniform(-args.spread, args.spread),
+                            center_lon + rng.uniform(-args.spread, args.spread), max(args.size, 50))
+                for v in range(args.vehicles)]
+    period = 1.0 / args.rate
+    slot = 0.0 if args.burst else period / args.vehicles
+
+    sent = 0
+    errors = 0
+    start = time.monotonic()
+    next_period = start
+    while time.monotonic() - start < args.duration:
+        for v in range(args.vehicles):
+            delay = next_period + v * slot - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+            try:
+                sock.sendto(payloads[v], dest)
+                sent += 1
+            except OSError:
+                errors += 1
+        next_period += period
+
+    elapsed = time.monotonic() - start
+    print('Sent %d datagrams in %.1f s (%.0f msg/s, target %.0f msg/s), %d errors' %
+          (sent, elapsed, sent / elapsed, args.vehicles * args.rate, errors))
+
+
+if __name__ == '__main__':
+    main()
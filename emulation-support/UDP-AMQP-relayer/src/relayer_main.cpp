@@ -11,6 +11,10 @@
 #include <netinet/in.h>
 #include <pthread.h>
 #include <arpa/inet.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
 
 #include <proton/connection.hpp>
 #include <proton/delivery.hpp>
@@ -39,6 +43,41 @@ extern "C" {
 // Global atomic flag to terminate the whole program in case of errors
 std::atomic<bool> terminatorFlag;
 
+// Counters of the UDP receiving side of the relayer
+typedef struct _relayerRxStats {
+	uint64_t received;     // Datagrams received from ms-van3t
+	uint64_t rx_batches;   // recvmmsg() calls returning at least one datagram
+	uint64_t discarded;    // Datagrams not relayed on purpose (GN Beacons, too short or truncated messages)
+	uint64_t filtered;     // Datagrams not relayed because they were sent from outside the area selected with --area
+	uint64_t ring_drops;   // Datagrams dropped because the ring towards the AMQP sender was full
+	uint64_t socket_drops; // Datagrams dropped by the kernel because the socket buffer was full (SO_RXQ_OVFL)
+} relayerRxStats_t;
+
+static void terminator_handler(int signum) {
+	terminatorFlag = true;
+}
+
+static double monotonic_seconds(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+
+	return ts.tv_sec+ts.tv_nsec/1e9;
+}
+
+static void print_stats(relayerRxStats_t &rx, relayerSenderStats_t tx, relayerRxStats_t &prev_rx, uint64_t &prev_sent, double interval, SPSCRing &ring) {
+	std::cout << "[stats] rx: " << rx.received << " (" << (rx.received-prev_rx.received)/interval << " msg/s, avg batch "
+		<< (rx.rx_batches>prev_rx.rx_batches ? (double) (rx.received-prev_rx.received)/(rx.rx_batches-prev_rx.rx_batches) : 0.0) << ")"
+		<< " | discarded: " << rx.discarded
+		<< " | filtered: " << rx.filtered
+		<< " | dropped: " << rx.ring_drops << " (ring full), " << rx.socket_drops << " (socket buffer)"
+		<< " | relayed: " << tx.sent << " (" << (tx.sent-prev_sent)/interval << " msg/s, " << tx.send_batches << " batches)"
+		<< " | ring: " << ring.available() << "/" << ring.capacity()
+		<< " | credit: " << tx.credit << " (" << tx.credit_stalls << " stalls)" << std::endl;
+
+	prev_rx=rx;
+	prev_sent=tx.sent;
+}
+
 // Thread callback function
 void *CAMrelayer_callback(void *arg) {
 	CAMrelayerAMQP *cr_AMQP_class_ptr=static_cast<CAMrelayerAMQP *>(arg);
@@ -48,13 +87,14 @@ void *CAMrelayer_callback(void *arg) {
 		try {
 			// Create a new Qpid Proton container and run it to start the AMQP 1.0 event loop
 			proton::container(*cr_AMQP_class_ptr).run();
-
-			pthread_exit(NULL);
 		} catch (const std::exception& e) {
 			std::cerr << "Qpid Proton library error while running CAMrelayerAMQP. Please find more details below." << std::endl;
 			std::cerr << e.what() << std::endl;
-			terminatorFlag = true;
 		}
+
+		// The container stops only when the connection to the broker is closed or fails
+		cr_AMQP_class_ptr->set_stopped();
+		terminatorFlag = true;
 	} else {
 		std::cerr << "Error. NULL CAMrelayerAMQP object. Cannot start the AMQP client." << std::endl;
 		terminatorFlag = true;
@@ -70,6 +110,13 @@ int main(int argc, char *argv[]) {
 	pthread_camrelayer_args_t cam_args;
 	int comm_port = 20000;
 	bool skipGN = false;
+	std::string bind_ip = "10.10.7.254";
+	int rx_batch = 64;
+	int ring_size = 8192;
+	int rcvbuf = 4*1024*1024;
+	int stats_interval = 5;
+	std::string area;
+	int area_level = 18;
 
 	// Parse the command line options with the TCLAP library
 	try {
@@ -88,6 +135,36 @@ int main(int argc, char *argv[]) {
 		TCLAP::ValueArg<int> portArg("P","comm-port","Port for the UDP communication with ms-van3t",false,20000,"int");
 		cmd.add(portArg);
 
+		TCLAP::ValueArg<std::string> bindArg("B","bind-ip","IP address to bind the UDP socket to",false,"10.10.7.254","string");
+		cmd.add(bindArg);
+
+		TCLAP::ValueArg<int> rxBatchArg("","rx-batch","Maximum number of UDP datagrams received with a single system call",false,64,"int");
+		cmd.add(rxBatchArg);
+
+		TCLAP::ValueArg<int> ringSizeArg("","ring-size","Number of messages which can be queued between the UDP socket and the AMQP sender (rounded up to a power of 2)",false,8192,"int");
+		cmd.add(ringSizeArg);
+
+		TCLAP::ValueArg<int> batchSizeArg("","batch-size","Number of queued messages which immediately wakes up the AMQP sender",false,32,"int");
+		cmd.add(batchSizeArg);
+
+		TCLAP::ValueArg<int> lingerArg("","linger-ms","Maximum time a message waits for the batch to be completed, before being sent (0: send the messages as soon as they are received)",false,2,"int");
+		cmd.add(lingerArg);
+
+		TCLAP::ValueArg<int> rcvbufArg("","rcvbuf","Receive buffer size of the UDP socket, in bytes (0: system default)",false,4*1024*1024,"int");
+		cmd.add(rcvbufArg);
+
+		TCLAP::ValueArg<int> statsArg("","stats-interval","Interval between two prints of the throughput and drop counters, in seconds (0: print them only when terminating)",false,5,"int");
+		cmd.add(statsArg);
+
+		TCLAP::ValueArg<int> quadkeyLevelArg("","quadkey-level","Level of detail of the \"quadkeys\" property, containing the quadkey of the sender position, added to the relayed messages (0: do not add it)",false,18,"int");
+		cmd.add(quadkeyLevelArg);
+
+		TCLAP::ValueArg<std::string> areaArg("","area","Relay only the messages sent from inside an area, specified as \"lat,lon;lat,lon\" (opposite corners of a rectangle) or \"lat,lon;lat,lon;lat,lon;...\" (polygon), in degrees",false,"","string");
+		cmd.add(areaArg);
+
+		TCLAP::ValueArg<int> areaLevelArg("","area-level","Level of detail of the quadkeys covering the border of the --area",false,18,"int");
+		cmd.add(areaLevelArg);
+
 		TCLAP::SwitchArg skipGNArg("S","skip-gn","Specify this option to send only Facilities Layer messages, instead of full ITS messages (Facilities layer + GeoNetworking + BTP). Warning! Experimental feature (it will work when only CAMs are sent)!");
 		cmd.add(skipGNArg);
 
@@ -98,15 +175,51 @@ int main(int argc, char *argv[]) {
 		cam_args.m_gn_tst_prop_name=gntstpropArg.getValue();
 		comm_port=portArg.getValue();
 		skipGN=skipGNArg.getValue();
+		bind_ip=bindArg.getValue();
+		rx_batch=rxBatchArg.getValue();
+		ring_size=ringSizeArg.getValue();
+		rcvbuf=rcvbufArg.getValue();
+		stats_interval=statsArg.getValue();
+		area=areaArg.getValue();
+		area_level=areaLevelArg.getValue();
+		cam_args.m_quadkey_level=quadkeyLevelArg.getValue();
+
+		cam_args.m_batch_size=batchSizeArg.getValue()>0 ? batchSizeArg.getValue() : 1;
+		cam_args.m_linger=lingerArg.getValue()>0 ? proton::duration(lingerArg.getValue()) : proton::duration::IMMEDIATE;
+
+		if(rx_batch<1 || ring_size<rx_batch) {
+			std::cerr << "Error: --rx-batch must be at least 1, and --ring-size at least equal to --rx-batch." << std::endl;
+			exit(EXIT_FAILURE);
+		}
+
+		if(cam_args.m_quadkey_level<0 || cam_args.m_quadkey_level>QuadKeys::maxLevelOfDetail || area_level<1 || area_level>QuadKeys::maxLevelOfDetail) {
+			std::cerr << "Error: --quadkey-level must be between 0 and " << QuadKeys::maxLevelOfDetail << ", and --area-level between 1 and " << QuadKeys::maxLevelOfDetail << "." << std::endl;
+			exit(EXIT_FAILURE);
+		}
 
 		std::cout << "The relayer will connect to " + cam_args.m_broker_address + "/" + cam_args.m_queue_name << std::endl;
 	} catch (TCLAP::ArgException &tclape) { 
 		std::cerr << "TCLAP error: " << tclape.error() << " for argument " << tclape.argId() << std::endl;
 	}
 
+	// Quadkeys covering the area from which the messages are relayed (empty: all the messages are relayed)
+	QuadKeys::QuadKeyIndex area_index;
+
+	if(!area.empty()) {
+		if(!area_index.insertArea(area,area_level)) {
+			std::cerr << "Error: invalid --area: " << area << std::endl;
+			exit(EXIT_FAILURE);
+		}
+
+		std::cout << "Relaying only the messages sent from inside " << area << " (" << area_index.size() << " quadkeys)" << std::endl;
+	}
+
 	// CAM relayer object
 	CAMrelayerAMQP CAM_relayer_obj;
 
+	// Ring between the UDP receiving loop (producer) and the AMQP sender (consumer, running in the Qpid Proton container thread)
+	SPSCRing ring(ring_size);
+
 	// Creation of the thread
 	// CAM Relayer Thread attributes
 	pthread_attr_t tattr;
@@ -118,6 +231,7 @@ int main(int argc, char *argv[]) {
 
 	// Set the arguments/parameters of the CAMrelayerAMQP object
 	CAM_relayer_obj.set_args(cam_args);
+	CAM_relayer_obj.set_ring(&ring);
 
 	// pthread_attr_init()/pthread_attr_setdetachstate()/pthread_attr_destroy() may probably be removed in the future
 	// If removed, the second argument of pthread_create() should be NULL instead of &tattr
@@ -138,19 +252,29 @@ int main(int argc, char *argv[]) {
 
 	std::cout << "Sender should be ready. Status (0 = error, 1 = ok): " << sender_ready_status << std::endl;
 
+	if(sender_ready_status==false) {
+		std::cerr << "Error: the AMQP sender could not be opened. Terminating." << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	// Terminate gracefully (printing the final counters) on SIGINT/SIGTERM
+	// SA_RESTART is not set, so that a blocking recvmmsg() returns immediately
+	struct sigaction sa;
+	memset(&sa,0,sizeof(sa));
+	sa.sa_handler=terminator_handler;
+	sigaction(SIGINT,&sa,NULL);
+	sigaction(SIGTERM,&sa,NULL);
+
 	struct sockaddr_in address;
 	address.sin_family = AF_INET;
 	//address.sin_addr.s_addr = INADDR_ANY;
-	if(inet_pton(AF_INET,"10.10.7.254",&address.sin_addr)<1) {
+	if(inet_pton(AF_INET,bind_ip.c_str(),&address.sin_addr)<1) {
 		std::cerr << "Error: cannot set an IP address to bind to." << std::endl;
 		exit(EXIT_FAILURE);
 	}
 	address.sin_port = htons(comm_port);
 	socklen_t addrlen = sizeof(struct sockaddr_in);
 
-	uint8_t buffer[1024];
-	int buf_length = sizeof(buffer);
-
 	int soc = socket(AF_INET,SOCK_DGRAM,0);
 	std::cout << "Bind IP address: " << inet_ntoa(address.sin_addr) << std::endl;
 
@@ -158,40 +282,129 @@ int main(int argc, char *argv[]) {
 		std::cerr << "Error: cannot bind()." << std::endl;
 		exit(EXIT_FAILURE);
 	}
-	int recv_bytes;
-	GNmetadata_t gnmetadata;
 
+	// A larger receive buffer absorbs the bursts of messages generated by many vehicles at the same time
+	if(rcvbuf>0 && setsockopt(soc,SOL_SOCKET,SO_RCVBUF,&rcvbuf,sizeof(rcvbuf))<0) {
+		std::cerr << "Warning: cannot set the socket receive buffer size: " << strerror(errno) << std::endl;
+	}
+
+	// Ask the kernel for the number of datagrams dropped because the receive buffer was full
+	int enable_ovfl = 1;
+	setsockopt(soc,SOL_SOCKET,SO_RXQ_OVFL,&enable_ovfl,sizeof(enable_ovfl));
+
+	// Wake up periodically, even if no message is received, to print the counters and check terminatorFlag
+	struct timeval rcvtimeo = {0, 200000};
+	setsockopt(soc,SOL_SOCKET,SO_RCVTIMEO,&rcvtimeo,sizeof(rcvtimeo));
+
+	// The datagrams are received directly inside the ring slots; when the ring is full, they are received inside
+	// "scratch_slots" and dropped
+	std::vector<relayerSlot_t *> slots(rx_batch);
+	std::vector<relayerSlot_t> scratch_slots(rx_batch);
+	std::vector<struct mmsghdr> msgs(rx_batch);
+	std::vector<struct iovec> iovecs(rx_batch);
+	size_t cmsg_space = CMSG_SPACE(sizeof(uint32_t));
+	std::vector<uint8_t> cmsg_buffers(rx_batch*cmsg_space);
+
+	relayerRxStats_t rx_stats = {0,0,0,0,0,0};
+	relayerRxStats_t prev_rx_stats = rx_stats;
+	uint64_t prev_sent = 0;
+	double last_stats_time = monotonic_seconds();
+	double start_time = last_stats_time;
 
-	//int listen(int soc,int backlog);
 	while(terminatorFlag==false) {
-		//int listen(int soc,int backlog);
-		recv_bytes = recvfrom(soc, buffer, buf_length, 0, NULL, NULL);
+		size_t n = ring.reserve(slots.data(),rx_batch);
+		bool ring_full = (n == 0);
+
+		if(ring_full) {
+			for(int i=0;i<rx_batch;i++) {
+				slots[i]=&scratch_slots[i];
+			}
+			n=rx_batch;
+		}
 
-		// At least 40 bytes are expected to relay the message. This is a "quick and dirty" solution to discard the shorter GN Beacon messages.
-		if(recv_bytes < 40) {
-			continue;
+		for(size_t i=0;i<n;i++) {
+			iovecs[i].iov_base=slots[i]->data;
+			iovecs[i].iov_len=RELAYER_MAX_MSG_SIZE;
+			memset(&msgs[i],0,sizeof(struct mmsghdr));
+			msgs[i].msg_hdr.msg_iov=&iovecs[i];
+			msgs[i].msg_hdr.msg_iovlen=1;
+			msgs[i].msg_hdr.msg_control=&cmsg_buffers[i*cmsg_space];
+			msgs[i].msg_hdr.msg_controllen=cmsg_space;
 		}
 
-		// This "if" has been added to avoid making the program crash if a message shorter than 60 B is received from ms-van3t (it should never happen, but we added this "if" just to be on the safe side)
-		if(skipGN == true && recv_bytes <= 68) {
-			continue;
+		// Block until at least one datagram is available, then get all the ones already queued (up to n)
+		int received = recvmmsg(soc,msgs.data(),n,MSG_WAITFORONE,NULL);
+
+		if(received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+			std::cerr << "Error: recvmmsg() failed: " << strerror(errno) << std::endl;
+			break;
 		}
 
-//		std::cout<<"recv_bytes: " << recv_bytes << std::endl;
-//
-//		for(int i=(skipGN == true ? 68 : 0);i<recv_bytes;i++) {
-//			printf("%02X",buffer[i]);
-//		}
-		// Just to add a newline at the end...
-//		std::cout << std::endl;
-
-		if(skipGN == false) {
-			CAM_relayer_obj.sendCAM_AMQP(buffer,recv_bytes);
-		} else {
-			CAM_relayer_obj.sendCAM_AMQP(((uint8_t*)buffer)+68,((int)recv_bytes)-68);
+		if(received > 0) {
+			rx_stats.received+=received;
+			rx_stats.rx_batches++;
+
+			for(int i=0;i<received;i++) {
+				int recv_bytes = msgs[i].msg_len;
+
+				// The kernel reports the total number of datagrams dropped on this socket
+				for(struct cmsghdr *cmsg=CMSG_FIRSTHDR(&msgs[i].msg_hdr);cmsg!=NULL;cmsg=CMSG_NXTHDR(&msgs[i].msg_hdr,cmsg)) {
+					if(cmsg->cmsg_level==SOL_SOCKET && cmsg->cmsg_type==SO_RXQ_OVFL) {
+						uint32_t dropped;
+						memcpy(&dropped,CMSG_DATA(cmsg),sizeof(dropped));
+						rx_stats.socket_drops=dropped;
+					}
+				}
+
+				// At least 40 bytes are expected to relay the message. This is a "quick and dirty" solution to discard the shorter GN Beacon messages.
+				// Messages shorter than 68 B cannot be relayed without GN and BTP (it should never happen, but we check it just to be on the safe side)
+				if(recv_bytes < 40 || (skipGN == true && recv_bytes <= 68) || (msgs[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+					slots[i]->len=0;
+					rx_stats.discarded++;
+					continue;
+				}
+
+				// The position of the sender is taken from the GN header, which is received even when only the Facilities layer is relayed
+				slots[i]->located=parse_gn_metadata(slots[i]->data,recv_bytes,slots[i]->meta);
+				if(slots[i]->located) {
+					slots[i]->quadkey=QuadKeys::QuadKeyTS::LatLonToCode(slots[i]->meta.lat/1e7,slots[i]->meta.lon/1e7,QuadKeys::maxLevelOfDetail);
+				}
+
+				// Messages without a position (e.g. secured ones) cannot be filtered, and they are always relayed
+				if(!area_index.empty() && slots[i]->located && !area_index.contains(slots[i]->quadkey,QuadKeys::maxLevelOfDetail)) {
+					slots[i]->len=0;
+					rx_stats.filtered++;
+					continue;
+				}
+
+				if(ring_full) {
+					rx_stats.ring_drops++;
+					continue;
+				}
+
+				slots[i]->offset=(skipGN == true ? 68 : 0);
+				slots[i]->len=recv_bytes-slots[i]->offset;
+			}
+
+			if(!ring_full) {
+				ring.commit(received);
+				CAM_relayer_obj.notify_ring();
+			}
+		}
+
+		double now = monotonic_seconds();
+		if(stats_interval > 0 && now-last_stats_time >= stats_interval) {
+			print_stats(rx_stats,CAM_relayer_obj.get_stats(),prev_rx_stats,prev_sent,now-last_stats_time,ring);
+			last_stats_time = now;
 		}
 	}
 
+	// Final counters, with the average rates over the whole run
+	relayerRxStats_t zero_rx_stats = {0,0,0,0,0,0};
+	uint64_t zero_sent = 0;
+	std::cout << "Relayer terminated. Total counters:" << std::endl;
+	print_stats(rx_stats,CAM_relayer_obj.get_stats(),zero_rx_stats,zero_sent,monotonic_seconds()-start_time,ring);
+
 	return 0;
 
 }
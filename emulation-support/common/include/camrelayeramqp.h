@@ -0,0 +1,110 @@
+#ifndef CAMRELAYERAMQP_H
+#define CAMRELAYERAMQP_H
+
+#include <proton/messaging_handler.hpp>
+#include <proton/connection_options.hpp>
+#include <proton/container.hpp>
+#include <proton/work_queue.hpp>
+#include <proton/duration.hpp>
+#include <proton/message.hpp>
+#include <proton/sender.hpp>
+#include <atomic> // For std::atomic<bool>
+#include <mutex>
+#include <condition_variable>
+
+#include "spsc_ring.h"
+#include "gn_metadata.h"
+
+typedef struct _pthread_camrelayer_args
+{
+	std::string m_broker_address;
+	std::string m_queue_name;
+	std::string m_gn_tst_prop_name;
+	size_t m_batch_size = 1;                               // Number of queued messages which immediately wakes up the sender (1 = no batching)
+	proton::duration m_linger = proton::duration::IMMEDIATE; // Maximum time a message waits in the ring for the batch to be completed
+	int m_quadkey_level = 0;                                 // Level of the "quadkeys" property added to the relayed messages (0 = no property)
+} pthread_camrelayer_args_t;
+
+// Counters of the AMQP sender (they can be read from any thread)
+typedef struct _relayerSenderStats {
+	uint64_t sent;          // Messages passed to the AMQP sender
+	uint64_t send_batches;  // Number of times the sender has drained the ring
+	uint64_t credit_stalls; // Number of times the sender has stopped because the broker did not give enough credit
+	int credit;             // Last credit of the AMQP sender
+} relayerSenderStats_t;
+
+class CAMrelayerAMQP : public proton::messaging_handler {
+	// For an example of usage of work_queue() to "inject" extra work (i.e. send CAMs) from external thread, see also:
+	// http://qpid.apache.org/releases/qpid-proton-0.32.0/proton/cpp/examples/multithreaded_client.cpp.html
+	pthread_camrelayer_args_t cr_arg_cl;         // AMQP and application parameters
+	proton::work_queue *m_work_queue_ptr;        // Pointer to a work queue for "injecting" CAMs from an external thread
+	proton::sender m_sender;                     // Sender to the CAM queue/topic
+	std::atomic<bool> m_sender_ready;            // = true when the sender is ready (i.e. we can send CAMs), = false otherwise
+	std::atomic<bool> m_sender_failed;           // = true when the AMQP client has stopped before the sender could be opened
+	std::mutex m_ready_mtx;
+	std::condition_variable m_ready_cv;
+
+	// Batched sending from a ring filled by another thread (see set_ring())
+	SPSCRing *m_ring;
+	std::atomic<bool> m_drain_scheduled;         // = true when a drain of the ring has been added to the work queue
+	std::atomic<bool> m_linger_scheduled;        // = true when a delayed drain (after the linger time) has been scheduled
+	std::atomic<uint64_t> m_sent;
+	std::atomic<uint64_t> m_send_batches;
+	std::atomic<uint64_t> m_credit_stalls;
+	std::atomic<int> m_credit;
+	proton::message m_drain_msg;                 // Reused for all the messages sent from the ring
+
+	void drain_ring(void);
+	void set_properties(proton::message &msg, const relayerSlot_t &slot);
+	void linger_expired(void);
+	void notify_ready(bool ready);
+
+	// Qpid Proton event callbacks
+	void on_container_start(proton::container& c) override;
+	void on_connection_open(proton::connection& c) override;
+	void on_sender_open(proton::sender& protonsender) override;
+	void on_sendable (proton::sender& sndr) override;
+	void on_message(proton::delivery &dlvr, proton::message &msg) override;
+	void on_transport_error(proton::transport &t) override;
+
+	public:
+		// Empty constructor
+		// You must call set_args just after the usage of an empty constructor, otherwise the behaviour may be undefined
+		CAMrelayerAMQP();
+
+		CAMrelayerAMQP(proton::container& cont, const std::string& url, const std::string& address);
+
+		// Full constructor (no need to call set_args() after using this constructor)
+		CAMrelayerAMQP(const pthread_camrelayer_args_t camrelay_args);
+
+		void set_args(const pthread_camrelayer_args_t camrelay_args);
+
+		// Public function to be called from any external thread to trigger the transmission of a CAM
+		// uint8_t *buffer should contain the CAM (encoded in any way, for instance with ASN.1 UPER)
+		// int bufsize should contain the size, in bytes, of "buffer"
+		void sendCAM_AMQP(uint8_t *buffer, int bufsize);
+
+		// Public function to wait for the sender to be ready, before calling sendCAM_AMQP()
+		// The application, after starting the container with run(), should call wait_sender_ready()
+		// before attempting any call to sendCAM_AMQP(), otherwise CAMs may not be sent
+		bool wait_sender_ready(void);
+
+		// To be called by the thread running the container, when the container stops (e.g. because of an error): it unblocks
+		// wait_sender_ready() if the sender has never been opened
+		void set_stopped(void);
+
+		// Set the ring from which the messages are relayed: after this call, the producer thread should commit the received
+		// messages in the ring and then call notify_ring(), instead of calling sendCAM_AMQP() for each message
+		// The messages are sent, in order, as long as the broker gives credit to the sender; when there is no credit left,
+		// they are kept in the ring, until the producer finds it full (and has to drop the new messages)
+		void set_ring(SPSCRing *ring);
+
+		// Called by the producer thread after committing new messages in the ring
+		// If at least "m_batch_size" messages are waiting, or if the linger time is zero, the sender is woken up
+		// immediately; otherwise, it is woken up when the linger time expires
+		void notify_ring(void);
+
+		relayerSenderStats_t get_stats(void);
+};
+
+#endif // CAMRELAYERAMQP_H
@@ -0,0 +1,83 @@
+#ifndef GN_METADATA_H
+#define GN_METADATA_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//define a structure for metadatas
+typedef struct _GNmetadata {
+uint64_t stationID;
+int32_t lat;           // Latitude of the sender, in 1/10 micro degrees (from the GN Source Position Vector)
+int32_t lon;           // Longitude of the sender, in 1/10 micro degrees
+uint32_t gn_timestamp; // GN timestamp of the Source Position Vector, in ms
+} GNmetadata_t;
+
+// Sizes of the GeoNetworking headers (ETSI EN 302 636-4-1)
+#define GN_BASIC_HEADER_LEN 4
+#define GN_COMMON_HEADER_LEN 8
+#define GN_SHB_HEADER_LEN 28
+#define GN_GBC_HEADER_LEN 44
+#define BTP_HEADER_LEN 4
+
+static inline uint32_t gn_read_u32(const uint8_t *buf) {
+	return ((uint32_t) buf[0] << 24) | ((uint32_t) buf[1] << 16) | ((uint32_t) buf[2] << 8) | (uint32_t) buf[3];
+}
+
+// Offset of the Facilities layer message (i.e. the size of the GN and BTP headers) inside a full ITS message (GN + BTP +
+// Facilities), or 0 if the GN packet is not a SHB or GBC one (e.g. a beacon or a secured packet)
+static inline size_t gn_facilities_offset(const uint8_t *buf, size_t len) {
+	if(len < GN_BASIC_HEADER_LEN + GN_COMMON_HEADER_LEN) {
+		return 0;
+	}
+
+	// Basic Header: version (4 bits), Next Header (4 bits); Next Header = 1 -> Common Header (2 -> Secured Packet)
+	if((buf[0] & 0x0F) != 1) {
+		return 0;
+	}
+
+	// Common Header: Next Header (4 bits), reserved (4 bits), Header Type (4 bits), Header Sub-Type (4 bits)
+	uint8_t header_type = buf[GN_BASIC_HEADER_LEN + 1] >> 4;
+	uint8_t header_subtype = buf[GN_BASIC_HEADER_LEN + 1] & 0x0F;
+	size_t ext_header_len;
+
+	if(header_type == 5 && header_subtype == 0) {
+		ext_header_len = GN_SHB_HEADER_LEN;
+	} else if(header_type == 4) {
+		ext_header_len = GN_GBC_HEADER_LEN;
+	} else {
+		return 0;
+	}
+
+	size_t facilities_offset = GN_BASIC_HEADER_LEN + GN_COMMON_HEADER_LEN + ext_header_len + BTP_HEADER_LEN;
+
+	return len > facilities_offset ? facilities_offset : 0;
+}
+
+// Extract the position and timestamp of the sender (from the Source Position Vector of a SHB or GBC packet) and the
+// station ID (from the ITS PDU header of the Facilities layer message) out of a full ITS message (GN + BTP + Facilities)
+// Returns false for any other GN packet (e.g. beacons or secured packets), leaving "meta" unchanged
+static inline bool parse_gn_metadata(const uint8_t *buf, size_t len, GNmetadata_t &meta) {
+	size_t facilities_offset = gn_facilities_offset(buf, len);
+
+	// The ITS PDU header (protocolVersion, messageID, stationID) is 6 bytes long, in UPER as well
+	if(facilities_offset == 0 || len < facilities_offset + 6) {
+		return false;
+	}
+
+	// The Source Position Vector is at the beginning of the SHB extended header, while in the GBC one it comes after the
+	// Sequence Number (2 bytes) and a reserved field (2 bytes)
+	const uint8_t *source_pv = buf + GN_BASIC_HEADER_LEN + GN_COMMON_HEADER_LEN;
+	if((buf[GN_BASIC_HEADER_LEN + 1] >> 4) == 4) {
+		source_pv += 4;
+	}
+
+	// Source Position Vector: GN address (8 bytes), timestamp, latitude, longitude
+	meta.gn_timestamp = gn_read_u32(source_pv + 8);
+	meta.lat = (int32_t) gn_read_u32(source_pv + 12);
+	meta.lon = (int32_t) gn_read_u32(source_pv + 16);
+	meta.stationID = gn_read_u32(buf + facilities_offset + 2);
+
+	return true;
+}
+
+#endif // GN_METADATA_H
@@ -0,0 +1,112 @@
+#ifndef QUADKEYTILESYSTEM_H
+#define QUADKEYTILESYSTEM_H
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+#include <array>
+
+namespace QuadKeys
+{
+	// Deepest level of detail supported by the integer quadkeys (2 bits per level, i.e. 46 bits), corresponding to tiles of
+	// about 5 m at the equator
+	const int maxLevelOfDetail = 23;
+
+	// A quadkey of level "l" is stored as an integer "code" made of its "l" digits (2 bits each, the most significant one
+	// being the first digit of the string), i.e. as the Morton code of the tile X and Y coordinates, as defined by the
+	// Bing Maps Tile System
+	typedef std::pair<double,double> latLon_t;
+
+	class QuadKeyTS
+	{
+		private:
+			int m_levelOfDetail; //used to set the levelOfDetail indipendently
+
+		public:
+			QuadKeyTS();
+			unsigned int MapSize(int levelOfDetail);
+			void setLevelOfDetail(int levelOfDetail = 16);
+			int getLevelOfDetail(void) {return m_levelOfDetail;}
+			std::string LatLonToQuadKey(double latitude, double longitude);
+			// All the quadkeys of level "m_levelOfDetail" overlapping the given area (without duplicates)
+			std::vector<std::string> LatLonToQuadKeyRange(double min_latitude, double max_latitude, double min_longitude, double max_longitude);
+			// This method should be called on the output of LatLonToQuadKeyRange(), in order to consolidate together quadkeys, when possible,
+			// and reduce the size of the filter
+			// The input vector is passed by reference and it is thus modified by unifyQuadkeys()
+			void unifyQuadkeys(std::vector<std::string> &quadKeys);
+			// Replace the deepest quadkeys with their parents until the selector built from "quadKeys" fits in the maximum
+			// size accepted by the broker
+			void checkdim(std::vector<std::string> &quadKeys);
+
+			// Integer tile math (no string is built)
+			static void LatLonToTileXY(double latitude, double longitude, int levelOfDetail, uint32_t &tileX, uint32_t &tileY);
+			static uint64_t TileXYToCode(uint32_t tileX, uint32_t tileY);
+			static void CodeToTileXY(uint64_t code, uint32_t &tileX, uint32_t &tileY);
+			static uint64_t LatLonToCode(double latitude, double longitude, int levelOfDetail);
+			static std::string CodeToQuadKey(uint64_t code, int levelOfDetail);
+			// Returns false if "quadKey" is not a valid quadkey of at most "maxLevelOfDetail" digits
+			static bool QuadKeyToCode(const std::string &quadKey, uint64_t &code, int &levelOfDetail);
+			// Edges of a tile, consistent with LatLonToTileXY() (i.e. a point on the minimum edges belongs to the tile)
+			static void TileBounds(uint32_t tileX, uint32_t tileY, int levelOfDetail, double &min_latitude, double &max_latitude, double &min_longitude, double &max_longitude);
+	};
+
+	// Set of quadkeys, stored as a prefix trie (i.e. a quadtree) with the tiles covering the whole area of a node pruned
+	// When a tile is added, its sub-tiles are removed and, when the four sub-tiles of the same tile are all present, they
+	// are replaced by their parent: the set is thus always the minimal one covering its area
+	// Lookups (point or quadkey) take at most one step per level of detail, independently of the size of the set
+	class QuadKeyIndex
+	{
+		private:
+			typedef struct _node {
+				std::array<int32_t,4> child; // -1 if the sub-tile is not (even partially) in the set
+				bool full;                   // true if the whole tile is in the set
+			} node_t;
+
+			std::vector<node_t> m_nodes; // m_nodes[0] is the root (level 0, i.e. the whole map)
+
+			int32_t newNode(void);
+			void collect(int32_t n, uint64_t code, int level, std::vector<std::pair<uint64_t,int>> &tiles) const;
+			void coverPolygon(const std::vector<latLon_t> &polygon, double min_lat, double max_lat, double min_lon, double max_lon,
+				uint32_t tileX, uint32_t tileY, int level, int max_level);
+
+		public:
+			QuadKeyIndex();
+
+			void clear(void);
+			bool empty(void) const;
+
+			// Add the tile "code" of level "levelOfDetail"
+			void insert(uint64_t code, int levelOfDetail);
+			// Returns false (and does not modify the set) if "quadKey" is not a valid quadkey
+			bool insert(const std::string &quadKey);
+
+			// Add all the tiles of level at most "levelOfDetail" overlapping a polygon (vertices as latitude, longitude pairs, in
+			// any order and without repeating the first one) or a rectangle
+			// The tiles fully inside the area are added at the lowest possible level, while the ones on its border at "levelOfDetail"
+			void insertPolygon(const std::vector<latLon_t> &polygon, int levelOfDetail);
+			void insertRect(double min_latitude, double max_latitude, double min_longitude, double max_longitude, int levelOfDetail);
+			// Add an area specified as "lat,lon;lat,lon;..." (in degrees): two vertices are the opposite corners of a rectangle,
+			// three or more a polygon. Returns false (and does not modify the set) if "area" is not valid
+			bool insertArea(const std::string &area, int levelOfDetail);
+
+			// Replace the deepest tile with its parent (and the parent siblings, if any), returning false if the set is empty or
+			// contains only the whole map
+			bool coarsen(void);
+
+			// true if the tile "code" of level "levelOfDetail" is inside the area of the set
+			bool contains(uint64_t code, int levelOfDetail) const;
+			bool contains(const std::string &quadKey) const;
+			bool contains(double latitude, double longitude) const;
+
+			// Minimal set of quadkeys, sorted in lexicographic order
+			std::vector<std::string> getQuadKeys(void) const;
+			size_t size(void) const;
+
+			// AMQP selector (JMS SQL syntax) matching the messages with the string property "property" set to a quadkey inside
+			// the area of the set, e.g. "quadkeys LIKE '120%' OR quadkeys LIKE '1212%'"
+			std::string getSelector(const std::string &property = "quadkeys") const;
+	};
+}
+
+#endif // QUADKEYTILESYSTEM_H
@@ -0,0 +1,86 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gn_metadata.h"
+
+// Maximum size of a message stored in the ring (the messages received from ms-van3t are always smaller than an Ethernet MTU)
+#define RELAYER_MAX_MSG_SIZE 2048
+
+typedef struct _relayerSlot {
+	uint16_t len;     // Length of the message to be relayed (0 = nothing to relay, e.g. discarded GN Beacon)
+	uint16_t offset;  // Offset of the message inside "data" (e.g. 68 when only the Facilities layer is relayed)
+	bool located;     // true if "meta" and "quadkey" have been extracted from the GN header of the message
+	GNmetadata_t meta;
+	uint64_t quadkey; // Integer quadkey (see sample_quad_final.h) of the sender position, at the deepest level of detail
+	uint8_t data[RELAYER_MAX_MSG_SIZE];
+} relayerSlot_t;
+
+// Lock-free single-producer single-consumer ring of fixed-size message slots
+// The producer (the thread of the relayer receiving or replaying the messages) reserves free slots, writes the messages
+// directly inside them and then commits them; the consumer (the AMQP sender, running in the Qpid Proton container thread)
+// reads the committed slots and releases them
+// "m_head" is written only by the producer and "m_tail" only by the consumer: they are kept on different cache lines
+class SPSCRing {
+	private:
+		std::vector<relayerSlot_t> m_slots;
+		size_t m_mask;
+
+		alignas(64) std::atomic<size_t> m_head; // Next slot to be committed by the producer
+		alignas(64) std::atomic<size_t> m_tail; // Next slot to be read by the consumer
+
+	public:
+		// The capacity is rounded up to a power of 2
+		SPSCRing(size_t capacity) : m_head(0), m_tail(0) {
+			size_t size=1;
+
+			while(size<capacity) {
+				size<<=1;
+			}
+
+			m_slots.resize(size);
+			m_mask=size-1;
+		}
+
+		size_t capacity(void) const {return m_slots.size();}
+
+		// Producer: get up to "max" free slots, starting from the first one after the committed ones
+		// Returns the number of free slots written in "slots"
+		size_t reserve(relayerSlot_t **slots, size_t max) {
+			size_t head=m_head.load(std::memory_order_relaxed);
+			size_t free_slots=m_slots.size()-(head-m_tail.load(std::memory_order_acquire));
+			size_t n=free_slots<max ? free_slots : max;
+
+			for(size_t i=0;i<n;i++) {
+				slots[i]=&m_slots[(head+i)&m_mask];
+			}
+
+			return n;
+		}
+
+		// Producer: make the first "n" reserved slots visible to the consumer
+		void commit(size_t n) {
+			m_head.store(m_head.load(std::memory_order_relaxed)+n,std::memory_order_release);
+		}
+
+		// Consumer: number of committed slots not yet released
+		size_t available(void) const {
+			return m_head.load(std::memory_order_acquire)-m_tail.load(std::memory_order_relaxed);
+		}
+
+		// Consumer: i-th committed slot (i < available())
+		relayerSlot_t &peek(size_t i) {
+			return m_slots[(m_tail.load(std::memory_order_relaxed)+i)&m_mask];
+		}
+
+		// Consumer: give the first "n" committed slots back to the producer
+		void release(size_t n) {
+			m_tail.store(m_tail.load(std::memory_order_relaxed)+n,std::memory_order_release);
+		}
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,217 @@
+#include <proton/connection.hpp>
+#include <proton/delivery.hpp>
+#include <proton/message.hpp>
+#include <proton/tracker.hpp>
+#include <proton/connection_options.hpp>
+#include <proton/transport.hpp>
+#include <proton/error_condition.hpp>
+
+#include "camrelayeramqp.h"
+#include "sample_quad_final.h"
+
+#include <iostream>
+#include <unistd.h>
+
+bool CAMrelayerAMQP::wait_sender_ready(void) {
+	// Waiting for the sender to become ready, i.e. waiting for m_sender_ready to become "true" (or for the AMQP client to fail)
+	std::unique_lock<std::mutex> lk(m_ready_mtx);
+	m_ready_cv.wait(lk,[this]{return m_sender_ready || m_sender_failed;});
+
+	return m_sender_ready;
+}
+
+void CAMrelayerAMQP::notify_ready(bool ready) {
+	{
+		std::lock_guard<std::mutex> lk(m_ready_mtx);
+		if(ready) {
+			m_sender_ready=true;
+		} else {
+			m_sender_failed=true;
+		}
+	}
+	m_ready_cv.notify_all();
+}
+
+void CAMrelayerAMQP::set_stopped(void) {
+	notify_ready(false);
+}
+
+void CAMrelayerAMQP::set_ring(SPSCRing *ring) {
+	m_ring=ring;
+}
+
+void CAMrelayerAMQP::notify_ring(void) {
+	if(m_work_queue_ptr==NULL || m_ring==NULL) {
+		return;
+	}
+
+	// A drain already in the work queue will also send the messages just committed, as it reads the ring head only when it runs
+	if(m_drain_scheduled) {
+		return;
+	}
+
+	if(m_ring->available()>=cr_arg_cl.m_batch_size || cr_arg_cl.m_linger==proton::duration::IMMEDIATE) {
+		if(!m_drain_scheduled.exchange(true)) {
+			m_work_queue_ptr->add([this]() {drain_ring();});
+		}
+	} else if(!m_linger_scheduled.exchange(true)) {
+		m_work_queue_ptr->schedule(cr_arg_cl.m_linger,[this]() {linger_expired();});
+	}
+}
+
+void CAMrelayerAMQP::linger_expired(void) {
+	m_linger_scheduled=false;
+	drain_ring();
+}
+
+// Always called in the container thread
+void CAMrelayerAMQP::drain_ring(void) {
+	// Reset the flag before reading the ring: a message committed from now on triggers a new drain
+	m_drain_scheduled=false;
+
+	if(m_ring==NULL || !m_sender_ready) {
+		return;
+	}
+
+	size_t available=m_ring->available();
+	size_t consumed=0;
+	int credit=m_sender.credit();
+
+	while(consumed<available && credit>0) {
+		relayerSlot_t &slot=m_ring->peek(consumed);
+
+		// Zero-length slots contain discarded messages
+		if(slot.len>0) {
+			m_drain_msg.body(proton::binary(slot.data+slot.offset,slot.data+slot.offset+slot.len));
+			set_properties(m_drain_msg,slot);
+			m_sender.send(m_drain_msg);
+			credit--;
+			m_sent++;
+		}
+
+		consumed++;
+	}
+
+	// Discarded messages are released even when there is no credit left
+	while(consumed<available && m_ring->peek(consumed).len==0) {
+		consumed++;
+	}
+
+	m_ring->release(consumed);
+	m_send_batches++;
+	m_credit=m_sender.credit();
+
+	// The rest of the messages will be sent by on_sendable(), when the broker gives more credit to the sender
+	if(consumed<available) {
+		m_credit_stalls++;
+	}
+}
+
+// Application properties used by the consumers to select the messages (e.g. with a "quadkeys LIKE '...%'" selector) without decoding them
+void CAMrelayerAMQP::set_properties(proton::message &msg, const relayerSlot_t &slot) {
+	proton::message::property_map &props=msg.properties();
+
+	props.clear();
+
+	if(!slot.located) {
+		return;
+	}
+
+	props.put("stationID",(int) slot.meta.stationID);
+	props.put("lat",slot.meta.lat/1e7);
+	props.put("lon",slot.meta.lon/1e7);
+	props.put(cr_arg_cl.m_gn_tst_prop_name,(int64_t) slot.meta.gn_timestamp);
+
+	if(cr_arg_cl.m_quadkey_level>0) {
+		// slot.quadkey is always computed at the deepest level
+		props.put("quadkeys",QuadKeys::QuadKeyTS::CodeToQuadKey(slot.quadkey>>(2*(QuadKeys::maxLevelOfDetail-cr_arg_cl.m_quadkey_level)),cr_arg_cl.m_quadkey_level));
+	}
+}
+
+relayerSenderStats_t CAMrelayerAMQP::get_stats(void) {
+	relayerSenderStats_t stats;
+
+	stats.sent=m_sent;
+	stats.send_batches=m_send_batches;
+	stats.credit_stalls=m_credit_stalls;
+	stats.credit=m_credit;
+
+	return stats;
+}
+
+void CAMrelayerAMQP::sendCAM_AMQP(uint8_t *buffer, int bufsize) {
+
+
+	proton::message CAM_msg;
+
+	// "Inject" the work of sending a new CAM with the current sender (m_sender)
+	// Checking m_work_queue_ptr!=NULL just for additional safety
+	if(m_work_queue_ptr!=NULL) {
+		// Create the AMQP message from the buffer
+		CAM_msg.body(proton::binary(buffer,buffer+bufsize));
+
+		// Add the work of sending the CAM via m_sender
+		m_work_queue_ptr->add([=]() {m_sender.send(CAM_msg);});
+	}
+}
+
+CAMrelayerAMQP::CAMrelayerAMQP(const pthread_camrelayer_args_t camrelay_args) :
+	cr_arg_cl(camrelay_args), m_work_queue_ptr(NULL), m_sender_ready(false), m_sender_failed(false), m_ring(NULL),
+	m_drain_scheduled(false), m_linger_scheduled(false), m_sent(0), m_send_batches(0), m_credit_stalls(0), m_credit(0) {}
+
+CAMrelayerAMQP::CAMrelayerAMQP() :
+	m_work_queue_ptr(NULL), m_sender_ready(false), m_sender_failed(false), m_ring(NULL),
+	m_drain_scheduled(false), m_linger_scheduled(false), m_sent(0), m_send_batches(0), m_credit_stalls(0), m_credit(0) {}
+
+CAMrelayerAMQP::CAMrelayerAMQP(proton::container& cont, const std::string& url, const std::string& address) :
+	m_work_queue_ptr(NULL), m_sender_ready(false), m_sender_failed(false), m_ring(NULL),
+	m_drain_scheduled(false), m_linger_scheduled(false), m_sent(0), m_send_batches(0), m_credit_stalls(0), m_credit(0) {
+	cont.open_sender(url+"/"+address, proton::connection_options().handler(*this));
+	std::cout<<"Open sender "<< std::endl;
+}
+
+void CAMrelayerAMQP::set_args(const pthread_camrelayer_args_t camrelay_args) {
+	cr_arg_cl=camrelay_args;
+}
+
+void CAMrelayerAMQP::on_container_start(proton::container& c) {
+	proton::connection_options co;
+	//c.connect(cr_arg_cl.m_broker_address,co.idle_timeout(proton::duration::FOREVER));
+	c.connect(cr_arg_cl.m_broker_address,co.idle_timeout(proton::duration(1000)));
+}
+
+void CAMrelayerAMQP::on_connection_open(proton::connection& c) {
+	c.open_sender(cr_arg_cl.m_queue_name);
+}
+
+void CAMrelayerAMQP::on_sender_open(proton::sender& protonsender) {
+	m_sender=protonsender;
+
+	// Get the work queue pointer out of the sender
+	m_work_queue_ptr=&m_sender.work_queue();
+
+	// Set "m_sender_ready" to true -> now the sender is ready and the application can safely call sendCAM_AMQP()
+	notify_ready(true);
+}
+
+// Called when the broker gives new credit to the sender: send the messages which were left in the ring for lack of credit
+void CAMrelayerAMQP::on_sendable(proton::sender &s) {
+	//std::cout<<"Credit left: "<<s.credit()<<std::endl;
+
+	if(m_ring!=NULL && m_ring->available()>0) {
+		drain_ring();
+	}
+}
+
+void CAMrelayerAMQP::on_transport_error(proton::transport &t) {
+	std::cerr << "AMQP transport error: " << t.error().what() << std::endl;
+
+	if(!m_sender_ready) {
+		notify_ready(false);
+	}
+}
+
+// This function basically does nothing other than printing "on_message" -> you can enable the "on_message" printing for debug purposes by decommenting the content of the function
+void CAMrelayerAMQP::on_message(proton::delivery &dlvr, proton::message &msg) {
+	//std::cout<<"on_message: "<<std::endl;
+}
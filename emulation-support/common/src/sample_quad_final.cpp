@@ -0,0 +1,518 @@
+#include <string>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+#include "sample_quad_final.h"
+
+namespace QuadKeys
+{
+	// Maximum length, in bytes, of the selector which can be transferred to the broker
+	static const size_t max_selector_length = 2200;
+	// Offset between the length of the selector and the size of the frame which carries it (as reported by the broker errors)
+	static const size_t selector_frame_offset = 180;
+
+	static double Clip(double n, double minValue, double maxValue) {
+		return std::min(std::max(n, minValue), maxValue);
+	}
+
+	// Interleave the bits of "v" with zeros (bit i -> bit 2i)
+	static uint64_t spreadBits(uint32_t v) {
+		uint64_t x = v;
+
+		x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+		x = (x | (x << 8)) & 0x00FF00FF00FF00FFULL;
+		x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		x = (x | (x << 2)) & 0x3333333333333333ULL;
+		x = (x | (x << 1)) & 0x5555555555555555ULL;
+
+		return x;
+	}
+
+	// Inverse of spreadBits() (bit 2i -> bit i)
+	static uint32_t compactBits(uint64_t x) {
+		x &= 0x5555555555555555ULL;
+		x = (x | (x >> 1)) & 0x3333333333333333ULL;
+		x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+		x = (x | (x >> 4)) & 0x00FF00FF00FF00FFULL;
+		x = (x | (x >> 8)) & 0x0000FFFF0000FFFFULL;
+		x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+
+		return (uint32_t) x;
+	}
+
+	QuadKeyTS::QuadKeyTS() {
+		// Set the default level of detail
+		m_levelOfDetail = 16;
+	}
+
+	unsigned int
+	QuadKeyTS::MapSize(int levelOfDetail) {
+		return (unsigned int) 256 << levelOfDetail;
+	}
+
+	void
+	QuadKeyTS::setLevelOfDetail(int levelOfDetail) {
+		m_levelOfDetail = levelOfDetail;
+
+		if(levelOfDetail < 1){
+			m_levelOfDetail = 1;
+		}
+		if(levelOfDetail > maxLevelOfDetail){
+			m_levelOfDetail = maxLevelOfDetail;
+		}
+	}
+
+	void
+	QuadKeyTS::LatLonToTileXY(double latitude, double longitude, int levelOfDetail, uint32_t &tileX, uint32_t &tileY) {
+		double x = (longitude + 180) / 360;
+		double sinLatitude = sin(latitude * M_PI / 180);
+		double y = 0.5 - log((1 + sinLatitude) / (1 - sinLatitude)) / (4 * M_PI);
+
+		// Same pixel rounding as the Bing Maps Tile System, with 256x256 pixels tiles
+		double mapSize = (double) (256ULL << levelOfDetail);
+		uint64_t pixelX = (uint64_t) Clip(x * mapSize + 0.5, 0, mapSize - 1);
+		uint64_t pixelY = (uint64_t) Clip(y * mapSize + 0.5, 0, mapSize - 1);
+
+		tileX = (uint32_t) (pixelX >> 8);
+		tileY = (uint32_t) (pixelY >> 8);
+	}
+
+	uint64_t
+	QuadKeyTS::TileXYToCode(uint32_t tileX, uint32_t tileY) {
+		// Each digit of the quadkey is (X bit) + 2 * (Y bit)
+		return spreadBits(tileX) | (spreadBits(tileY) << 1);
+	}
+
+	void
+	QuadKeyTS::CodeToTileXY(uint64_t code, uint32_t &tileX, uint32_t &tileY) {
+		tileX = compactBits(code);
+		tileY = compactBits(code >> 1);
+	}
+
+	uint64_t
+	QuadKeyTS::LatLonToCode(double latitude, double longitude, int levelOfDetail) {
+		uint32_t tileX, tileY;
+
+		LatLonToTileXY(latitude, longitude, levelOfDetail, tileX, tileY);
+
+		return TileXYToCode(tileX, tileY);
+	}
+
+	std::string
+	QuadKeyTS::CodeToQuadKey(uint64_t code, int levelOfDetail) {
+		std::string quadKey(levelOfDetail, '0');
+
+		for (int i = 0; i < levelOfDetail; i++) {
+			quadKey[i] = '0' + ((code >> (2 * (levelOfDetail - 1 - i))) & 3);
+		}
+
+		return quadKey;
+	}
+
+	bool
+	QuadKeyTS::QuadKeyToCode(const std::string &quadKey, uint64_t &code, int &levelOfDetail) {
+		if(quadKey.size() > (size_t) maxLevelOfDetail) {
+			return false;
+		}
+
+		code = 0;
+		for (char digit : quadKey) {
+			if(digit < '0' || digit > '3') {
+				return false;
+			}
+			code = (code << 2) | (digit - '0');
+		}
+		levelOfDetail = quadKey.size();
+
+		return true;
+	}
+
+	void
+	QuadKeyTS::TileBounds(uint32_t tileX, uint32_t tileY, int levelOfDetail, double &min_latitude, double &max_latitude, double &min_longitude, double &max_longitude) {
+		double mapSize = (double) (256ULL << levelOfDetail);
+		uint64_t numTiles = 1ULL << levelOfDetail;
+
+		// Because of the +0.5 pixel rounding in LatLonToTileXY(), tile "t" starts half a pixel before 256*t
+		double min_x = tileX == 0 ? 0.0 : (256.0 * tileX - 0.5) / mapSize;
+		double max_x = tileX + 1 == numTiles ? 1.0 : (256.0 * (tileX + 1) - 0.5) / mapSize;
+		double min_y = tileY == 0 ? 0.0 : (256.0 * tileY - 0.5) / mapSize;
+		double max_y = tileY + 1 == numTiles ? 1.0 : (256.0 * (tileY + 1) - 0.5) / mapSize;
+
+		min_longitude = min_x * 360 - 180;
+		max_longitude = max_x * 360 - 180;
+		// The Y axis points to the south
+		max_latitude = tileY == 0 ? 90.0 : 90 - 360 * atan(exp(-(0.5 - min_y) * 2 * M_PI)) / M_PI;
+		min_latitude = tileY + 1 == numTiles ? -90.0 : 90 - 360 * atan(exp(-(0.5 - max_y) * 2 * M_PI)) / M_PI;
+	}
+
+	std::string
+	QuadKeyTS::LatLonToQuadKey(double latitude, double longitude) {
+		return CodeToQuadKey(LatLonToCode(latitude, longitude, m_levelOfDetail), m_levelOfDetail);
+	}
+
+	std::vector<std::string>
+	QuadKeyTS::LatLonToQuadKeyRange(double min_latitude, double max_latitude, double min_longitude, double max_longitude) {
+		std::vector<std::string> v = {};
+		uint32_t minTileX, minTileY, maxTileX, maxTileY;
+
+		// The tile Y coordinate grows towards the south
+		LatLonToTileXY(max_latitude, min_longitude, m_levelOfDetail, minTileX, minTileY);
+		LatLonToTileXY(min_latitude, max_longitude, m_levelOfDetail, maxTileX, maxTileY);
+
+		for(uint64_t tileY = minTileY; tileY <= maxTileY; tileY++) {
+			for(uint64_t tileX = minTileX; tileX <= maxTileX; tileX++) {
+				v.push_back(CodeToQuadKey(TileXYToCode(tileX, tileY), m_levelOfDetail));
+			}
+		}
+
+		return v;
+	}
+
+	void
+	QuadKeyTS::unifyQuadkeys(std::vector<std::string> &quadKeys) {
+		QuadKeyIndex index;
+
+		for(const std::string &quadKey : quadKeys) {
+			index.insert(quadKey);
+		}
+
+		quadKeys = index.getQuadKeys();
+	}
+
+	void
+	QuadKeyTS::checkdim(std::vector<std::string> &quadKeys) {
+		QuadKeyIndex index;
+
+		for(const std::string &quadKey : quadKeys) {
+			index.insert(quadKey);
+		}
+
+		while(index.getSelector().size() + selector_frame_offset > max_selector_length && index.coarsen());
+
+		quadKeys = index.getQuadKeys();
+	}
+
+	QuadKeyIndex::QuadKeyIndex() {
+		clear();
+	}
+
+	void
+	QuadKeyIndex::clear(void) {
+		m_nodes.clear();
+		newNode();
+	}
+
+	bool
+	QuadKeyIndex::empty(void) const {
+		const node_t &root = m_nodes[0];
+
+		return !root.full && std::all_of(root.child.begin(), root.child.end(), [](int32_t c) {return c < 0;});
+	}
+
+	int32_t
+	QuadKeyIndex::newNode(void) {
+		node_t n;
+
+		n.child.fill(-1);
+		n.full = false;
+		m_nodes.push_back(n);
+
+		return m_nodes.size() - 1;
+	}
+
+	void
+	QuadKeyIndex::insert(uint64_t code, int levelOfDetail) {
+		// Nodes visited from the root, to merge the complete sibling sets after the insertion
+		std::array<int32_t,maxLevelOfDetail> path;
+		int32_t n = 0;
+
+		if(levelOfDetail < 0 || levelOfDetail > maxLevelOfDetail) {
+			return;
+		}
+
+		for(int i = 0; i < levelOfDetail; i++) {
+			if(m_nodes[n].full) {
+				// Already inside the set
+				return;
+			}
+
+			int digit = (code >> (2 * (levelOfDetail - 1 - i))) & 3;
+			path[i] = n;
+
+			if(m_nodes[n].child[digit] < 0) {
+				// newNode() may reallocate m_nodes: no reference to a node is kept across this call
+				int32_t c = newNode();
+				m_nodes[n].child[digit] = c;
+			}
+			n = m_nodes[n].child[digit];
+		}
+
+		// The sub-tiles become unreachable (the trie is built once per area, so their nodes are not recycled)
+		m_nodes[n].full = true;
+		m_nodes[n].child.fill(-1);
+
+		for(int i = levelOfDetail - 1; i >= 0; i--) {
+			node_t &parent = m_nodes[path[i]];
+
+			for(int32_t c : parent.child) {
+				if(c < 0 || !m_nodes[c].full) {
+					return;
+				}
+			}
+
+			parent.full = true;
+			parent.child.fill(-1);
+		}
+	}
+
+	bool
+	QuadKeyIndex::insert(const std::string &quadKey) {
+		uint64_t code;
+		int levelOfDetail;
+
+		if(!QuadKeyTS::QuadKeyToCode(quadKey, code, levelOfDetail)) {
+			return false;
+		}
+
+		insert(code, levelOfDetail);
+		return true;
+	}
+
+	// Ray casting, with the latitude as Y and the longitude as X
+	static bool pointInPolygon(const std::vector<latLon_t> &polygon, double lat, double lon) {
+		bool inside = false;
+
+		for(size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+			const latLon_t &a = polygon[i];
+			const latLon_t &b = polygon[j];
+
+			if((a.first > lat) != (b.first > lat) &&
+				lon < (b.second - a.second) * (lat - a.first) / (b.first - a.first) + a.second) {
+				inside = !inside;
+			}
+		}
+
+		return inside;
+	}
+
+	// Liang-Barsky clipping of the segment a-b against the rectangle (borders included)
+	static bool segmentIntersectsRect(const latLon_t &a, const latLon_t &b, double min_lat, double max_lat, double min_lon, double max_lon) {
+		double d_lon = b.second - a.second;
+		double d_lat = b.first - a.first;
+		double p[4] = {-d_lon, d_lon, -d_lat, d_lat};
+		double q[4] = {a.second - min_lon, max_lon - a.second, a.first - min_lat, max_lat - a.first};
+		double t0 = 0.0, t1 = 1.0;
+
+		for(int i = 0; i < 4; i++) {
+			if(p[i] == 0) {
+				if(q[i] < 0) {
+					return false;
+				}
+			} else {
+				double r = q[i] / p[i];
+
+				if(p[i] < 0) {
+					if(r > t1) {
+						return false;
+					}
+					t0 = std::max(t0, r);
+				} else {
+					if(r < t0) {
+						return false;
+					}
+					t1 = std::min(t1, r);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	void
+	QuadKeyIndex::coverPolygon(const std::vector<latLon_t> &polygon, double min_lat, double max_lat, double min_lon, double max_lon,
+		uint32_t tileX, uint32_t tileY, int level, int max_level) {
+		double tile_min_lat, tile_max_lat, tile_min_lon, tile_max_lon;
+
+		QuadKeyTS::TileBounds(tileX, tileY, level, tile_min_lat, tile_max_lat, tile_min_lon, tile_max_lon);
+
+		// Outside the bounding box of the polygon
+		if(tile_min_lat > max_lat || tile_max_lat < min_lat || tile_min_lon > max_lon || tile_max_lon < min_lon) {
+			return;
+		}
+
+		bool border = false;
+		for(size_t i = 0, j = polygon.size() - 1; i < polygon.size() && !border; j = i++) {
+			border = segmentIntersectsRect(polygon[j], polygon[i], tile_min_lat, tile_max_lat, tile_min_lon, tile_max_lon);
+		}
+
+		if(!border) {
+			// No edge crosses the tile: the tile is either fully inside or fully outside the polygon
+			if(pointInPolygon(polygon, (tile_min_lat + tile_max_lat) / 2, (tile_min_lon + tile_max_lon) / 2)) {
+				insert(QuadKeyTS::TileXYToCode(tileX, tileY), level);
+			}
+			return;
+		}
+
+		if(level == max_level) {
+			insert(QuadKeyTS::TileXYToCode(tileX, tileY), level);
+			return;
+		}
+
+		for(uint32_t sub = 0; sub < 4; sub++) {
+			coverPolygon(polygon, min_lat, max_lat, min_lon, max_lon, 2 * tileX + (sub & 1), 2 * tileY + (sub >> 1), level + 1, max_level);
+		}
+	}
+
+	void
+	QuadKeyIndex::insertPolygon(const std::vector<latLon_t> &polygon, int levelOfDetail) {
+		// Polygons crossing the antimeridian are not supported
+		if(polygon.size() < 3 || levelOfDetail < 0 || levelOfDetail > maxLevelOfDetail) {
+			return;
+		}
+
+		double min_lat = polygon[0].first, max_lat = polygon[0].first;
+		double min_lon = polygon[0].second, max_lon = polygon[0].second;
+		for(const latLon_t &vertex : polygon) {
+			min_lat = std::min(min_lat, vertex.first);
+			max_lat = std::max(max_lat, vertex.first);
+			min_lon = std::min(min_lon, vertex.second);
+			max_lon = std::max(max_lon, vertex.second);
+		}
+
+		coverPolygon(polygon, min_lat, max_lat, min_lon, max_lon, 0, 0, 0, levelOfDetail);
+	}
+
+	void
+	QuadKeyIndex::insertRect(double min_latitude, double max_latitude, double min_longitude, double max_longitude, int levelOfDetail) {
+		insertPolygon({{min_latitude, min_longitude}, {min_latitude, max_longitude}, {max_latitude, max_longitude}, {max_latitude, min_longitude}}, levelOfDetail);
+	}
+
+	bool
+	QuadKeyIndex::insertArea(const std::string &area, int levelOfDetail) {
+		std::vector<latLon_t> vertices;
+		std::stringstream area_stream(area);
+		std::string vertex;
+
+		while(std::getline(area_stream, vertex, ';')) {
+			double lat, lon;
+			char sep;
+			std::stringstream vertex_stream(vertex);
+
+			if(!(vertex_stream >> lat >> sep >> lon) || sep != ',' || lat < -90 || lat > 90 || lon < -180 || lon > 180) {
+				return false;
+			}
+			vertices.push_back({lat, lon});
+		}
+
+		if(vertices.size() == 2) {
+			insertRect(std::min(vertices[0].first, vertices[1].first), std::max(vertices[0].first, vertices[1].first),
+				std::min(vertices[0].second, vertices[1].second), std::max(vertices[0].second, vertices[1].second), levelOfDetail);
+		} else if(vertices.size() >= 3) {
+			insertPolygon(vertices, levelOfDetail);
+		} else {
+			return false;
+		}
+
+		return true;
+	}
+
+	bool
+	QuadKeyIndex::coarsen(void) {
+		std::vector<std::pair<uint64_t,int>> tiles;
+
+		collect(0, 0, 0, tiles);
+
+		auto deepest = std::max_element(tiles.begin(), tiles.end(),
+			[](const std::pair<uint64_t,int> &a, const std::pair<uint64_t,int> &b) {return a.second < b.second;});
+
+		if(deepest == tiles.end() || deepest->second == 0) {
+			return false;
+		}
+
+		insert(deepest->first >> 2, deepest->second - 1);
+		return true;
+	}
+
+	bool
+	QuadKeyIndex::contains(uint64_t code, int levelOfDetail) const {
+		int32_t n = 0;
+
+		for(int i = 0; i < levelOfDetail; i++) {
+			if(m_nodes[n].full) {
+				return true;
+			}
+
+			n = m_nodes[n].child[(code >> (2 * (levelOfDetail - 1 - i))) & 3];
+			if(n < 0) {
+				return false;
+			}
+		}
+
+		return m_nodes[n].full;
+	}
+
+	bool
+	QuadKeyIndex::contains(const std::string &quadKey) const {
+		uint64_t code;
+		int levelOfDetail;
+
+		return QuadKeyTS::QuadKeyToCode(quadKey, code, levelOfDetail) && contains(code, levelOfDetail);
+	}
+
+	bool
+	QuadKeyIndex::contains(double latitude, double longitude) const {
+		return contains(QuadKeyTS::LatLonToCode(latitude, longitude, maxLevelOfDetail), maxLevelOfDetail);
+	}
+
+	void
+	QuadKeyIndex::collect(int32_t n, uint64_t code, int level, std::vector<std::pair<uint64_t,int>> &tiles) const {
+		if(m_nodes[n].full) {
+			tiles.push_back({code, level});
+			return;
+		}
+
+		for(int digit = 0; digit < 4; digit++) {
+			if(m_nodes[n].child[digit] >= 0) {
+				collect(m_nodes[n].child[digit], (code << 2) | digit, level + 1, tiles);
+			}
+		}
+	}
+
+	std::vector<std::string>
+	QuadKeyIndex::getQuadKeys(void) const {
+		std::vector<std::pair<uint64_t,int>> tiles;
+		std::vector<std::string> quadKeys;
+
+		collect(0, 0, 0, tiles);
+
+		quadKeys.reserve(tiles.size());
+		for(const std::pair<uint64_t,int> &tile : tiles) {
+			quadKeys.push_back(QuadKeyTS::CodeToQuadKey(tile.first, tile.second));
+		}
+
+		return quadKeys;
+	}
+
+	size_t
+	QuadKeyIndex::size(void) const {
+		std::vector<std::pair<uint64_t,int>> tiles;
+
+		collect(0, 0, 0, tiles);
+
+		return tiles.size();
+	}
+
+	std::string
+	QuadKeyIndex::getSelector(const std::string &property) const {
+		std::string selector;
+
+		for(const std::string &quadKey : getQuadKeys()) {
+			if(!selector.empty()) {
+				selector += " OR ";
+			}
+			selector += property + " LIKE '" + quadKey + "%'";
+		}
+
+		return selector;
+	}
+}
@@ -0,0 +1,123 @@
+#!/bin/bash
+#
+# Validation of the batched I/O of v2x-emulator (--batched-io) on a veth pair.
+#
+# The emulator is run twice inside a dedicated network namespace, with the plain FdNetDevice and with the
+# BatchedFdNetDevice, while the GeoNetworking frames (EtherType 0x8947) reaching the root end of the pair are captured.
+# The script checks that:
+# - both runs put frames on the wire, and the batched run sends about as many frames as the plain one;
+# - every frame counted as sent by the batched devices is captured exactly once, and none is dropped;
+# - the frames are actually batched (fewer sendmmsg() batches than frames);
+# - the lag monitor wrote its "sched" and "wire" histograms.
+#
+# It must be launched from the ns-3 folder (the one containing the "ns3" script), with sudo, e.g.:
+#   sudo ../emulation-support/validate-batched-io.sh [emulation time, s (default: 30)] [output folder]
+
+SIM_TIME=${1:-30}
+OUT_DIR=${2:-batched-io-validation}
+NS=nsbio
+VETH_ROOT=vbioroot
+VETH_NS=vbions
+# Tolerance on the number of frames of the batched run with respect to the plain one [%]
+TOLERANCE=10
+
+function cleanup {
+    set +e
+
+    ip link del $VETH_ROOT 2>/dev/null
+    ip netns del $NS 2>/dev/null
+}
+trap cleanup EXIT
+
+set -e
+
+if [ "$EUID" -ne 0 ]; then
+    echo "This script must be run as root."
+    exit 1
+fi
+
+if [ ! -x ./ns3 ]; then
+    echo "This script must be run from the ns-3 folder."
+    exit 1
+fi
+
+mkdir -p "$OUT_DIR"
+
+ip netns add $NS
+ip link add $VETH_ROOT type veth peer name $VETH_NS
+ip link set $VETH_NS netns $NS
+ip netns exec $NS ip link set dev $VETH_NS up
+ip netns exec $NS ip link set $VETH_NS promisc on
+ip netns exec $NS ip link set dev lo up
+ip link set dev $VETH_ROOT up
+
+./ns3 build v2x-emulator
+
+# run_emulator <name> <batched I/O: true/false>
+function run_emulator {
+    local name=$1
+
+    tcpdump -i $VETH_ROOT -w "$OUT_DIR/$name.pcap" "ether proto 0x8947" 2>/dev/null &
+    local tcpdump_pid=$!
+    sleep 1
+
+    ip netns exec $NS ./ns3 run --no-build "v2x-emulator --interface=$VETH_NS --sumo-netns=$NS --sumo-gui=false \
+        --sim-time=$SIM_TIME --batched-io=$2 --lag-monitor=true --lag-report-file=$OUT_DIR/lag-$name.csv" \
+        > "$OUT_DIR/$name.log" 2>&1
+
+    sleep 1
+    kill -INT $tcpdump_pid
+    wait $tcpdump_pid || true
+
+    tcpdump -r "$OUT_DIR/$name.pcap" 2>/dev/null | wc -l
+}
+
+set +e
+ERRORS=0
+
+function check {
+    if eval "$1"; then
+        echo "OK:   $2"
+    else
+        echo "FAIL: $2"
+        ERRORS=$((ERRORS+1))
+    fi
+}
+
+echo "Running v2x-emulator with the plain FdNetDevice for $SIM_TIME s..."
+PLAIN_CAPTURED=$(run_emulator plain false)
+echo "Running v2x-emulator with the BatchedFdNetDevice for $SIM_TIME s..."
+BATCHED_CAPTURED=$(run_emulator batched true)
+
+# "Batched I/O: <frames> frames sent in <batches> batches (<shared/per-vehicle> socket), <drops> dropped."
+SUMMARY=$(grep "^Batched I/O:" "$OUT_DIR/batched.log")
+BATCHED_SENT=$(echo "$SUMMARY" | awk '{print $3}')
+BATCHED_BATCHES=$(echo "$SUMMARY" | awk '{print $7}')
+BATCHED_DROPS=$(echo "$SUMMARY" | awk '{print $(NF-1)}')
+
+echo "Plain run:   $PLAIN_CAPTURED frames captured"
+echo "Batched run: $BATCHED_CAPTURED frames captured; $SUMMARY"
+
+check "[ -n \"$SUMMARY\" ]" "the batched run printed its counters"
+check "[ $PLAIN_CAPTURED -gt 0 ] && [ $BATCHED_CAPTURED -gt 0 ]" "both runs sent frames on the wire"
+check "[ $(( (BATCHED_CAPTURED-PLAIN_CAPTURED)*(BATCHED_CAPTURED-PLAIN_CAPTURED)*10000 )) -le $(( TOLERANCE*TOLERANCE*PLAIN_CAPTURED*PLAIN_CAPTURED ))" \
+      "the batched run sent as many frames as the plain one (+/- $TOLERANCE%)"
+check "[ \"$BATCHED_SENT\" == \"$BATCHED_CAPTURED\" ]" "every frame sent by the batched devices was captured once"
+check "[ \"$BATCHED_DROPS\" == \"0\" ]" "no frame was dropped by the batched devices"
+check "[ -n \"$BATCHED_BATCHES\" ] && [ $BATCHED_BATCHES -lt $BATCHED_SENT ]" "the frames were sent in batches"
+check "grep -q ',sched,' \"$OUT_DIR/lag-batched.csv\"" "the lag monitor reported the scheduler lateness"
+check "grep -q ',wire,' \"$OUT_DIR/lag-batched.csv\"" "the lag monitor reported the host-to-wire latency"
+
+# Worst scheduler lateness of the two runs (p99 and max, column 7 and 8)
+for name in plain batched; do
+    awk -F, -v name=$name '$2 == "sched" {if ($7 > p99) p99 = $7; if ($8 > max) max = $8}
+        END {printf "%s run: worst p99 scheduler lateness %.1f us, max %.1f us\n", name, p99, max}' "$OUT_DIR/lag-$name.csv"
+done
+grep -h "lagging behind" "$OUT_DIR/plain.log" "$OUT_DIR/batched.log"
+
+if [ $ERRORS -ne 0 ]; then
+    echo "$ERRORS checks failed (logs, captures and lag reports in $OUT_DIR)."
+    exit 1
+fi
+
+echo "All the checks passed (logs, captures and lag reports in $OUT_DIR)."
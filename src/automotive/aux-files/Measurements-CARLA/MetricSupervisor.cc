@@ -68,16 +68,17 @@ MetricSupervisor::~MetricSupervisor ()
 std::string
 MetricSupervisor::bufToString(uint8_t *buf, uint32_t bufsize)
 {
-  std::stringstream bufss;
-
-  bufss << std::hex << std::setfill('0');
+  static const char hexdigits[] = "0123456789abcdef";
+  std::string bufstr(bufsize*2,'0');
 
+  // This function is called for every sent and received packet: avoid going through a stringstream
   for(size_t i=0;i<bufsize;++i)
     {
-      bufss << std::setw(2) << static_cast<unsigned>(buf[i]);
+      bufstr[2*i] = hexdigits[buf[i] >> 4];
+      bufstr[2*i+1] = hexdigits[buf[i] & 0x0F];
     }
 
-  return bufss.str();
+  return bufstr;
 }
 
 void
@@ -95,31 +96,23 @@ MetricSupervisor::signalSentPacket(std::string buf, double lat, double lon, uint
           return;
         }
 
-      //std::vector<std::string> ids = m_traci_ptr->TraCIAPI::vehicle.getIDList ();
-      std::map<std::string, std::pair<StationType_t, Ptr<Node>>> node_map =
-          m_traci_ptr->get_NodeMap ();
-
-      for (std::map<std::string, std::pair<StationType_t, Ptr<Node>>>::iterator it =
-               node_map.begin ();
-           it != node_map.end (); ++it)
+      // Iterate directly over the TraCI client node registry (no copies, station IDs already parsed)
+      for (const TraciClient::NodeEntry_t &entry : m_traci_ptr->GetNodeEntries ())
         {
-          StationType_t station_type = it->second.first;
+          StationType_t station_type = entry.stationType;
           uint64_t stationID;
           if (station_type == StationType_roadSideUnit)
-            {
-              uint64_t id = std::stoi (it->first.substr (it->first.find ("_") + 1));
-              stationID = m_stationId_baseline + id;
-            }
+            stationID = m_stationId_baseline + entry.stationId;
           else
-            stationID = std::stol (it->first.substr (3));
+            stationID = entry.stationId;
 
           libsumo::TraCIPosition pos;
           if (station_type == StationType_pedestrian)
-            pos = m_traci_ptr->TraCIAPI::person.getPosition (it->first);
+            pos = m_traci_ptr->TraCIAPI::person.getPosition (entry.sumoId);
           else if (station_type == StationType_roadSideUnit)
-            pos = m_traci_ptr->TraCIAPI::poi.getPosition (it->first);
+            pos = m_traci_ptr->TraCIAPI::poi.getPosition (entry.sumoId);
           else
-            pos = m_traci_ptr->TraCIAPI::vehicle.getPosition (it->first);
+            pos = m_traci_ptr->TraCIAPI::vehicle.getPosition (entry.sumoId);
           pos = m_traci_ptr->TraCIAPI::simulation.convertXYtoLonLat (pos.x, pos.y);
 
           if (stationID == nodeID)
@@ -492,15 +485,11 @@ MetricSupervisor::checkCBR ()
   std::unordered_map<std::string, Time> nextTimeToAddNr;
   if(m_traci_ptr != nullptr)
     {
-      std::map<std::basic_string<char>, std::pair<StationType_t, Ptr<Node>>> nodes =
-          m_traci_ptr->get_NodeMap ();
-
-
-      for (auto it = nodes.begin (); it != nodes.end (); ++it)
+      for (const TraciClient::NodeEntry_t &entry : m_traci_ptr->GetNodeEntries ())
         {
-          std::string item = it->first;
+          const std::string &item = entry.sumoId;
 
-          std::basic_string<char> node_id = std::to_string (it->second.second->GetId ());
+          std::basic_string<char> node_id = std::to_string (entry.node->GetId ());
 
           if (currentBusyCBR.find (node_id) == currentBusyCBR.end ())
             {
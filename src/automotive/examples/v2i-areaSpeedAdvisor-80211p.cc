@@ -84,6 +84,8 @@ main (int argc, char *argv[])
   bool m_metric_sup = true;
 
   double simTime = 100;
+  double penetrationRate = 1.0; // Rate of vehicles equipped with wireless communication devices
+  int sumoSeed = 10; // Random seed for SUMO
 
   int numberOfNodes;
   uint32_t nodeCounter = 0;
@@ -117,6 +119,8 @@ main (int argc, char *argv[])
   cmd.AddValue ("datarate", "802.11p channel data rate [Mbit/s]", datarate);
 
   cmd.AddValue ("sim-time", "Total duration of the simulation [s]", simTime);
+  cmd.AddValue ("penetration-rate", "Rate of vehicles equipped with wireless communication devices", penetrationRate);
+  cmd.AddValue ("sumo-seed", "Random seed for SUMO", sumoSeed);
 
   cmd.Parse (argc, argv);
 
@@ -233,10 +237,10 @@ main (int argc, char *argv[])
   sumoClient->SetAttribute ("StartTime", TimeValue (Seconds (0.0)));
   sumoClient->SetAttribute ("SumoGUI", (BooleanValue) sumo_gui);
   sumoClient->SetAttribute ("SumoPort", UintegerValue (3400));
-  sumoClient->SetAttribute ("PenetrationRate", DoubleValue (1.0));
+  sumoClient->SetAttribute ("PenetrationRate", DoubleValue (penetrationRate));
   sumoClient->SetAttribute ("SumoLogFile", BooleanValue (false));
   sumoClient->SetAttribute ("SumoStepLog", BooleanValue (false));
-  sumoClient->SetAttribute ("SumoSeed", IntegerValue (10));
+  sumoClient->SetAttribute ("SumoSeed", IntegerValue (sumoSeed));
 
   std::string sumo_additional_options = "--verbose true";
 
@@ -88,6 +88,8 @@ main (int argc, char *argv[])
   bool m_metric_sup = true;
 
   double simTime = 100;
+  double penetrationRate = 1.0; // Rate of vehicles equipped with wireless communication devices
+  int sumoSeed = 10; // Random seed for SUMO
 
   int numberOfENodeBs;
   uint32_t eNodeBCounter = 0;
@@ -115,6 +117,8 @@ main (int argc, char *argv[])
   cmd.AddValue("useCa", "Whether to use carrier aggregation", useCa);
 
   cmd.AddValue("sim-time", "Total duration of the simulation [s]", simTime);
+  cmd.AddValue("penetration-rate", "Rate of vehicles equipped with wireless communication devices", penetrationRate);
+  cmd.AddValue("sumo-seed", "Random seed for SUMO", sumoSeed);
 
   cmd.Parse (argc, argv);
 
@@ -259,10 +263,10 @@ main (int argc, char *argv[])
   sumoClient->SetAttribute ("StartTime", TimeValue (Seconds (0.0)));
   sumoClient->SetAttribute ("SumoGUI", (BooleanValue) sumo_gui);
   sumoClient->SetAttribute ("SumoPort", UintegerValue (3400));
-  sumoClient->SetAttribute ("PenetrationRate", DoubleValue (1.0));
+  sumoClient->SetAttribute ("PenetrationRate", DoubleValue (penetrationRate));
   sumoClient->SetAttribute ("SumoLogFile", BooleanValue (false));
   sumoClient->SetAttribute ("SumoStepLog", BooleanValue (false));
-  sumoClient->SetAttribute ("SumoSeed", IntegerValue (10));
+  sumoClient->SetAttribute ("SumoSeed", IntegerValue (sumoSeed));
   std::string sumo_additional_options = "--verbose true";
 
   if(sumo_netstate_file_name!="")
@@ -90,6 +90,7 @@ main (int argc, char *argv[])
   double simTime = 5000;
 
   uint32_t nodeCounter = 0;
+  std::string trigger_trace = "";
 
   CommandLine cmd;
 
@@ -98,6 +99,7 @@ main (int argc, char *argv[])
   cmd.AddValue ("trace-folder","Position of GPS trace files",trace_file_path);
   cmd.AddValue ("gps-trace", "Name of the GPS trace file", gps_trace);
   cmd.AddValue ("vehicle-visualizer", "Activate the web-based vehicle visualizer for ms-van3t", vehicle_vis);
+  cmd.AddValue ("trigger-trace", "Write the CAM/VAM triggering conditions to this binary trace file, instead of the text logs (decode it with trigger_trace_decoder.py)", trigger_trace);
 
   /* Cmd Line option for 802.11p */
   cmd.AddValue ("tx-power", "OBUs transmission power [dBm]", txPower);
@@ -223,6 +225,17 @@ main (int argc, char *argv[])
   simpleVAMSenderHelper SimpleVAMSenderHelper;
   SimpleVAMSenderHelper.SetAttribute ("RealTime", BooleanValue(realtime));
 
+  // Binary trace of the triggering conditions, shared by all the applications
+  std::shared_ptr<TriggerTrace> triggerTrace = nullptr;
+  if (!trigger_trace.empty ())
+    {
+      triggerTrace = std::make_shared<TriggerTrace> (trigger_trace);
+      if (!triggerTrace->isOpen ())
+        {
+          NS_FATAL_ERROR ("Cannot open the trigger trace file " << trigger_trace);
+        }
+    }
+
   // Create vector with the GPS Trace Client map values
   std::vector<GPSTraceClient*> v_gps_tc;
   GPS_TC_MAP_ITERATOR(GPSTCMap,GPSTCit) {
@@ -257,11 +270,19 @@ main (int argc, char *argv[])
         {
           SimpleCAMSenderHelper.SetAttribute ("GPSClient", PointerValue(v_gps_tc[nodeCounter]));
           setupAppSimpleSender = SimpleCAMSenderHelper.Install (includedNode);
+          if (triggerTrace != nullptr)
+            {
+              setupAppSimpleSender.Get (0)->GetObject<simpleCAMSender> ()->setTriggerTrace (triggerTrace);
+            }
         }
       else if (gps_tc->getType() == "vru")
         {
           SimpleVAMSenderHelper.SetAttribute ("GPSClient", PointerValue(v_gps_tc[nodeCounter]));
           setupAppSimpleSender = SimpleVAMSenderHelper.Install (includedNode);
+          if (triggerTrace != nullptr)
+            {
+              setupAppSimpleSender.Get (0)->GetObject<simpleVAMSender> ()->setTriggerTrace (triggerTrace);
+            }
         }
       setupAppSimpleSender.Start (Seconds (0.0));
       setupAppSimpleSender.Stop (simulationTime - Simulator::Now () - Seconds (0.1));
@@ -341,5 +362,10 @@ main (int argc, char *argv[])
   Simulator::Run ();
   Simulator::Destroy ();
 
+  if (triggerTrace != nullptr)
+    {
+      triggerTrace->flush ();
+    }
+
   return 0;
 }
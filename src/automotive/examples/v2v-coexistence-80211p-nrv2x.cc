@@ -372,6 +372,9 @@ int main (int argc, char *argv[])
   double sinr_threshold = 10; // Default value
   xmlDocPtr rou_xml_file;
   double simTime = 50.0; // Total simulation time (default: 200 seconds)
+  double penetrationRate = 1.0; // Rate of vehicles equipped with wireless communication devices
+  int sumoSeed = 10; // Random seed for SUMO
+  std::string output_file = "output.txt"; // File where the Metric Supervisor statistics are written (relative to the working directory)
 
   // NR parameters. We will take the input from the command line, and then we
   // will pass them inside the NR module.
@@ -433,6 +436,9 @@ int main (int argc, char *argv[])
   cmd.AddValue ("sionna-server-ip", "SIONNA server IP address", server_ip);
   cmd.AddValue ("sionna-local-machine", "SIONNA will be executed on local machine", local_machine);
   cmd.AddValue ("sionna-verbose", "SIONNA server IP address", verb);
+  cmd.AddValue ("penetration-rate", "Rate of vehicles equipped with wireless communication devices", penetrationRate);
+  cmd.AddValue ("sumo-seed", "Random seed for SUMO", sumoSeed);
+  cmd.AddValue ("output-file", "Name of the file where the Metric Supervisor statistics are written", output_file);
   cmd.Parse (argc, argv);
 
   std::cout << "Start running v2v-simple-cam-exchange-80211p-nrv2x simulation" << std::endl;
@@ -825,10 +831,10 @@ int main (int argc, char *argv[])
   sumoClient->SetAttribute ("StartTime", TimeValue (Seconds (0.0)));
   sumoClient->SetAttribute ("SumoGUI", BooleanValue (false));
   sumoClient->SetAttribute ("SumoPort", UintegerValue (3400));
-  sumoClient->SetAttribute ("PenetrationRate", DoubleValue (1.0));
+  sumoClient->SetAttribute ("PenetrationRate", DoubleValue (penetrationRate));
   sumoClient->SetAttribute ("SumoLogFile", BooleanValue (false));
   sumoClient->SetAttribute ("SumoStepLog", BooleanValue (false));
-  sumoClient->SetAttribute ("SumoSeed", IntegerValue (10));
+  sumoClient->SetAttribute ("SumoSeed", IntegerValue (sumoSeed));
   sumoClient->SetAttribute ("SumoWaitForSocket", TimeValue (Seconds (1.0)));
 
   if (interference)
@@ -1017,7 +1023,7 @@ int main (int argc, char *argv[])
   // When the simulation is terminated, gather the most relevant metrics from the PRRsupervisor
   std::cout << "Run terminated..." << std::endl;
 
-  std::ofstream outputFile("src/output.txt");
+  std::ofstream outputFile(output_file);
   if (!outputFile.is_open())
     {
       std::cerr << "Unable to open file";
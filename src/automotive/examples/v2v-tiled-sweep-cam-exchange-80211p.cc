@@ -0,0 +1,281 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * This is an example of a V2V CAM exchange scenario (IEEE 802.11p) which is split into several independent runs, to
+ * simulate large SUMO maps with many vehicles. The SUMO network is divided into a grid of --tiles-x by --tiles-y
+ * tiles (see TraciPartition), and each run simulates a single tile plus a ghost ring around it:
+ * - every run starts its own SUMO instance, with the same configuration and seed, so that the mobility of all the
+ *   runs is identical;
+ * - each run creates the ns-3 nodes only for the vehicles inside its tile and ghost ring: the vehicles are included
+ *   and excluded when they cross the borders of the ghost ring, and the excluded nodes are parked outside every tile;
+ * - the metrics of each packet are collected only by the run owning the sender, so that the metrics of the different
+ *   runs can be summed up without counting the same packet twice.
+ *
+ * This is an embarrassingly-parallel sweep over the tiles, not a distributed simulation: no packet or event is ever
+ * exchanged between the runs, and the ghost ring replaces the transmissions of the neighbouring tiles, so that the
+ * results are exact only if the ghost margin covers the whole interference range (see
+ * TraciPartition::ComputeGhostMargin()).
+ *
+ * When ns-3 is built with MPI support (--enable-mpi), the runs can be launched together with, e.g.:
+ *   mpirun -np 4 ./ns3 run "v2v-tiled-sweep-cam-exchange-80211p --tiles-x=2 --tiles-y=2"
+ * where the process with rank N simulates tile N; MPI is used only to launch the runs and to combine their metrics,
+ * which are printed by rank 0. Without MPI, the tile can be selected with --tile, and the runs can be launched as
+ * separate processes (one per tile), e.g. with sweep_runner.py.
+ */
+#include "ns3/carla-module.h"
+#include "ns3/vector.h"
+#include "ns3/string.h"
+#include "ns3/socket.h"
+#include "ns3/double.h"
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/command-line.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/mobility-helper.h"
+#include <iostream>
+#include <unordered_map>
+#include "ns3/MetricSupervisor.h"
+#include "ns3/BSMap.h"
+#include "ns3/caBasicService.h"
+#include "ns3/btp.h"
+#include "ns3/ocb-wifi-mac.h"
+#include "ns3/wifi-80211p-helper.h"
+#include "ns3/wave-mac-helper.h"
+#include "ns3/gn-utils.h"
+#include "ns3/traci-partition.h"
+
+#ifdef NS3_MPI
+#include <mpi.h>
+#include "ns3/mpi-interface.h"
+#endif
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("V2VTiledSweepCAMExchange80211p");
+
+// ******* DEFINE HERE ANY LOCAL GLOBAL VARIABLE, ACCESSIBLE FROM ANY FUNCTION IN THIS FILE *******
+// Variables defined here should always be "static"
+static uint64_t cam_packet_count=0;
+BSMap basicServices; // Container for all ETSI Basic Services, installed on all vehicles
+// ************************************************************************************************
+
+void receiveCAM(asn1cpp::Seq<CAM> cam, Address from, StationID_t my_stationID, StationType_t my_StationType, SignalInfo phy_info)
+{
+  cam_packet_count++;
+}
+
+int main (int argc, char *argv[])
+{
+  std::string phyMode ("OfdmRate6MbpsBW10MHz"); // Default IEEE 802.11p data rate
+  double m_baseline_prr = 150.0; // PRR baseline value (default: 150 m)
+  double interferenceRange = 500.0; // Maximum distance at which a transmission is still sensed [m]
+  double maxSpeed = 40.0; // Maximum speed of the vehicles in the scenario [m/s]
+  int txPower = 23.0; // IEEE 802.11p transmission power in dBm (default: 23 dBm)
+  double simTime = 100.0; // Total simulation time (default: 100 seconds)
+  double penetrationRate = 1.0; // Rate of vehicles equipped with wireless communication devices
+  int sumoSeed = 10; // Random seed for SUMO (it must be the same for all the processes)
+  uint32_t tilesX = 1;
+  uint32_t tilesY = 1;
+  uint32_t tile = 0;
+
+  // Set here the path to the SUMO configuration file
+  std::string sumo_config ="src/automotive/examples/sumo_files_v2v_map/map.sumo.cfg";
+
+#ifdef NS3_MPI
+  MpiInterface::Enable (&argc, &argv);
+  tile = MpiInterface::GetSystemId ();
+#endif
+
+  // Read the command line options
+  CommandLine cmd (__FILE__);
+
+  cmd.AddValue ("phyMode", "Wifi Phy mode", phyMode);
+  cmd.AddValue ("baseline", "Baseline for PRR calculation", m_baseline_prr);
+  cmd.AddValue ("interference-range", "Maximum distance at which a transmission is still sensed [m]", interferenceRange);
+  cmd.AddValue ("max-speed", "Maximum speed of the vehicles in the scenario [m/s]", maxSpeed);
+  cmd.AddValue ("tx-power", "OBUs transmission power [dBm]", txPower);
+  cmd.AddValue ("sim-time", "Total duration of the simulation [s]", simTime);
+  cmd.AddValue ("penetration-rate", "Rate of vehicles equipped with wireless communication devices", penetrationRate);
+  cmd.AddValue ("sumo-config", "Path to the SUMO configuration file", sumo_config);
+  cmd.AddValue ("sumo-seed", "Random seed for SUMO (it must be the same for all the tiles)", sumoSeed);
+  cmd.AddValue ("tiles-x", "Number of tiles along the x axis of the map", tilesX);
+  cmd.AddValue ("tiles-y", "Number of tiles along the y axis of the map", tilesY);
+  cmd.AddValue ("tile", "Tile simulated by this process (ignored with MPI, where the tile is the rank)", tile);
+  cmd.Parse (argc, argv);
+
+#ifdef NS3_MPI
+  if (MpiInterface::GetSize () != tilesX * tilesY)
+    {
+      NS_FATAL_ERROR("Fatal error: " << tilesX * tilesY << " tiles require " << tilesX * tilesY << " MPI processes, but "
+                     << MpiInterface::GetSize () << " processes are running.");
+    }
+#endif
+
+  // Set up the spatial partition of the map: the ghost ring must contain all the receivers of an owned transmission,
+  // together with all their interferers
+  Time synchInterval = Seconds (0.1);
+  Ptr<TraciPartition> partition = CreateObject<TraciPartition> ();
+  partition->SetAttribute ("NumTilesX", UintegerValue (tilesX));
+  partition->SetAttribute ("NumTilesY", UintegerValue (tilesY));
+  partition->SetAttribute ("Tile", UintegerValue (tile));
+  partition->SetAttribute ("GhostMargin", DoubleValue (TraciPartition::ComputeGhostMargin (m_baseline_prr, interferenceRange, maxSpeed, synchInterval)));
+
+  // Set up the IEEE 802.11p model and PHY layer
+  // The channel has a hard maximum range, so that no transmission can be sensed outside the ghost ring
+  YansWifiPhyHelper wifiPhy;
+  wifiPhy.Set ("TxPowerStart", DoubleValue (txPower));
+  wifiPhy.Set ("TxPowerEnd", DoubleValue (txPower));
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  wifiChannel.AddPropagationLoss ("ns3::RangePropagationLossModel", "MaxRange", DoubleValue (interferenceRange));
+  Ptr<YansWifiChannel> channel = wifiChannel.Create ();
+  wifiPhy.SetChannel (channel);
+
+  QosWaveMacHelper wifi80211pMac = QosWaveMacHelper::Default ();
+  Wifi80211pHelper wifi80211p = Wifi80211pHelper::Default ();
+  wifi80211p.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                      "DataMode",StringValue (phyMode),
+                                      "ControlMode",StringValue (phyMode),
+                                      "NonUnicastMode",StringValue (phyMode));
+
+  MobilityHelper mobility;
+
+  // Set up the TraCI interface and start SUMO; each process uses a different port, selected automatically
+  Ptr<TraciClient> sumoClient = CreateObject<TraciClient> ();
+  sumoClient->SetAttribute ("SumoConfigPath", StringValue (sumo_config));
+  sumoClient->SetAttribute ("SumoBinaryPath", StringValue (""));    // use system installation of sumo
+  sumoClient->SetAttribute ("SynchInterval", TimeValue (synchInterval));
+  sumoClient->SetAttribute ("StartTime", TimeValue (Seconds (0.0)));
+  sumoClient->SetAttribute ("SumoGUI", BooleanValue (false));
+  sumoClient->SetAttribute ("SumoPort", UintegerValue (3400));
+  sumoClient->SetAttribute ("PenetrationRate", DoubleValue (penetrationRate));
+  sumoClient->SetAttribute ("SumoLogFile", BooleanValue (false));
+  sumoClient->SetAttribute ("SumoStepLog", BooleanValue (false));
+  sumoClient->SetAttribute ("SumoSeed", IntegerValue (sumoSeed));
+  sumoClient->SetAttribute ("SumoWaitForSocket", TimeValue (Seconds (1.0)));
+  sumoClient->SetAttribute ("Partition", PointerValue (partition));
+
+  // Set up a Metricsupervisor, which, in partitioned mode, measures only the packets sent by the owned vehicles
+  Ptr<MetricSupervisor> metSup = NULL;
+  MetricSupervisor metSupObj(m_baseline_prr);
+  metSup = &metSupObj;
+  metSup->setTraCIClient(sumoClient);
+
+  // The ns-3 nodes are created only when a vehicle enters the ghost ring for the first time, so that each process
+  // attaches to the channel only the vehicles of its own region of the map; when a vehicle migrates back to this
+  // process, its node is reused
+  std::unordered_map<std::string, Ptr<Node>> vehicleNodes;
+
+  STARTUP_FCN setupNewWifiNode = [&] (std::string vehicleID,TraciClient::StationTypeTraCI_t stationType) -> Ptr<Node>
+    {
+      Ptr<Node> node;
+      auto nodeIt = vehicleNodes.find (vehicleID);
+
+      if (nodeIt == vehicleNodes.end ())
+        {
+          node = CreateObject<Node> ();
+          wifi80211p.Install (wifiPhy, wifi80211pMac, NodeContainer (node));
+          mobility.Install (node);
+          vehicleNodes[vehicleID] = node;
+        }
+      else
+        {
+          node = nodeIt->second;
+        }
+
+      // Create a new ETSI GeoNetworking socket and a new Basic Service Container for the vehicle
+      Ptr<Socket> sock = GeoNet::createGNPacketSocket(node);
+      Ptr<BSContainer> bs_container = CreateObject<BSContainer>(std::stol(vehicleID.substr(3)),StationType_passengerCar,sumoClient,false,sock);
+      bs_container->linkMetricSupervisor(metSup);
+      bs_container->disablePRRSupervisorForGNBeacons ();
+      bs_container->addCAMRxCallback (std::bind(&receiveCAM,std::placeholders::_1,std::placeholders::_2,std::placeholders::_3,std::placeholders::_4,std::placeholders::_5));
+      bs_container->setupContainer(true,false,false,false);
+      basicServices.add(bs_container);
+
+      // The CAM dissemination start instant depends only on the vehicle ID, so that a vehicle behaves in the same way
+      // in all the processes simulating it (as owned or as ghost node)
+      std::srand(std::stol(vehicleID.substr(3))*2);
+      double desync = ((double)std::rand()/RAND_MAX);
+      bs_container->getCABasicService ()->startCamDissemination (desync);
+
+      return node;
+    };
+
+  SHUTDOWN_FCN shutdownWifiNode = [partition] (Ptr<Node> exNode, std::string vehicleID)
+    {
+      /* Park the node outside every tile, so that it is never counted as owned by any run */
+      Ptr<ConstantPositionMobilityModel> mob = exNode->GetObject<ConstantPositionMobilityModel>();
+      mob->SetPosition(partition->GetParkingPosition ());
+
+      unsigned long intVehicleID = std::stol(vehicleID.substr (3));
+
+      Ptr<BSContainer> bsc = basicServices.get(intVehicleID);
+      bsc->cleanup();
+    };
+
+  std::cout << "Simulating tile " << tile << " of a " << tilesX << "x" << tilesY << " tiled sweep (ghost margin: "
+            << partition->GetGhostMargin () << " m)" << std::endl;
+
+  // Link ns-3 and SUMO
+  sumoClient->SumoSetup (setupNewWifiNode, shutdownWifiNode);
+
+  Simulator::Stop (Seconds(simTime));
+  Simulator::Run ();
+
+  // Metrics of the packets sent by the vehicles owned by this process
+  uint64_t ntx = metSup->getNumberTx_overall ();
+  uint64_t nrx = metSup->getNumberRx_overall ();
+  double prrSum = metSup->getAveragePRR_overall () * metSup->getNumberPRRSamples_overall ();
+  double prrSamples = metSup->getNumberPRRSamples_overall ();
+  double latencySum = metSup->getAverageLatency_overall () * metSup->getNumberLatencySamples_overall ();
+  double latencySamples = metSup->getNumberLatencySamples_overall ();
+
+  std::cout << "Tile " << tile << " terminated: " << vehicleNodes.size () << " nodes created, " << ntx << " packets sent, "
+            << nrx << " packets received, " << cam_packet_count << " CAMs received." << std::endl;
+
+#ifdef NS3_MPI
+  // Combine the metrics of all the tiles: the averages are weighted by their number of samples
+  uint64_t counters[2] = {ntx, nrx};
+  uint64_t totalCounters[2] = {0, 0};
+  double sums[4] = {prrSum, prrSamples, latencySum, latencySamples};
+  double totalSums[4] = {0.0, 0.0, 0.0, 0.0};
+
+  MPI_Reduce (counters, totalCounters, 2, MPI_UINT64_T, MPI_SUM, 0, MpiInterface::GetCommunicator ());
+  MPI_Reduce (sums, totalSums, 4, MPI_DOUBLE, MPI_SUM, 0, MpiInterface::GetCommunicator ());
+
+  ntx = totalCounters[0];
+  nrx = totalCounters[1];
+  prrSum = totalSums[0];
+  prrSamples = totalSums[1];
+  latencySum = totalSums[2];
+  latencySamples = totalSums[3];
+
+  if (MpiInterface::GetSystemId () == 0)
+#endif
+    {
+      std::cout << "Run terminated..." << std::endl;
+      std::cout << "Average PRR: " << (prrSamples > 0 ? prrSum / prrSamples : 0.0) << std::endl;
+      std::cout << "Average latency (ms): " << (latencySamples > 0 ? latencySum / latencySamples : 0.0) << std::endl;
+      std::cout << "RX packet count (from PRR Supervisor): " << nrx << std::endl;
+      std::cout << "TX packet count (from PRR Supervisor): " << ntx << std::endl;
+    }
+
+  Simulator::Destroy ();
+
+#ifdef NS3_MPI
+  MpiInterface::Disable ();
+#endif
+
+  return 0;
+}
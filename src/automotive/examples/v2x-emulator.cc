@@ -32,6 +32,8 @@
 #include "ns3/emu-fd-net-device-helper.h"
 #include "ns3/v2xEmulator.h"
 #include "ns3/packet-socket-helper.h"
+#include "ns3/batchedFdNetDevice.h"
+#include "ns3/realtimeLagMonitor.h"
 
 using namespace ns3;
 
@@ -54,6 +56,13 @@ main (int argc, char *argv[])
    *
    * To start this application, you need to set the interface where the V2X messages are relayed into promiscuous mode!
    * command -> sudo ip link set <interface name> promisc on
+   *
+   * With many emulated vehicles, you can specify:
+   * --batched-io = true
+   * to send the frames of all the vehicles in batches, with sendmmsg() on a socket shared by them, and to receive the
+   * frames of each vehicle in batches, with recvmmsg() (see BatchedFdNetDevice), and
+   * --lag-monitor = true
+   * to report, every second, how much the emulation is lagging behind the wall-clock time (see RealtimeLagMonitor).
    */
 
   // Physical interface parameters
@@ -85,6 +94,14 @@ main (int argc, char *argv[])
 
   double emuTime = 100;
 
+  // Batched I/O and real-time lag monitor parameters
+  bool batchedIo = false;
+  uint32_t txBatch = 32;
+  uint32_t rxBatch = 32;
+  double txFlushDelay_us = 0;
+  bool lagMonitorEnabled = false;
+  std::string lagReportFile = "";
+
   int numberOfNodes = 0;
   uint32_t nodeCounter = 0;
 
@@ -109,6 +126,12 @@ main (int argc, char *argv[])
   cmd.AddValue ("gateway", "[UDP mode] To specify the gateway at which the UDP/IP packets will be sent", gwstr);
   cmd.AddValue ("subnet", "[UDP mode] To specify the subnet which will be used to assign the IP addresses of emulated nodes (the .1 address is automatically excluded)", subnet);
   cmd.AddValue ("netmask", "[UDP mode] To specify the netmask of the network", netmask);
+  cmd.AddValue ("batched-io", "To send the frames of all the emulated vehicles in batches on a shared socket (sendmmsg), and receive the frames of each vehicle in batches (recvmmsg)", batchedIo);
+  cmd.AddValue ("tx-batch", "[Batched I/O] Maximum number of frames sent with a single system call", txBatch);
+  cmd.AddValue ("rx-batch", "[Batched I/O] Maximum number of frames received with a single system call", rxBatch);
+  cmd.AddValue ("tx-flush-delay", "[Batched I/O] Maximum time a frame waits to be sent with the following ones [us] (0: only the frames generated at the same time are batched)", txFlushDelay_us);
+  cmd.AddValue ("lag-monitor", "To periodically report the lag of the emulation with respect to the wall-clock time", lagMonitorEnabled);
+  cmd.AddValue ("lag-report-file", "[Lag monitor] CSV file where the lag histograms are written (default: print them on stdout)", lagReportFile);
 
   cmd.Parse (argc, argv);
 
@@ -228,8 +251,24 @@ main (int argc, char *argv[])
   /* Create the FdNetDevice to send packets over a physical interface */
   EmuFdNetDeviceHelper emuDev;
   emuDev.SetDeviceName (deviceName);
+  if (batchedIo)
+    {
+      emuDev.SetTypeId ("ns3::BatchedFdNetDevice");
+      emuDev.SetAttribute ("TxBatchSize", UintegerValue (txBatch));
+      emuDev.SetAttribute ("RxBatchSize", UintegerValue (rxBatch));
+      emuDev.SetAttribute ("TxFlushDelay", TimeValue (MicroSeconds (txFlushDelay_us)));
+    }
   emuDev.SetAttribute ("EncapsulationMode", StringValue (encapMode));
 
+  /* Create the real-time lag monitor, which reports the scheduler lateness and (with --batched-io) the host-to-wire latency */
+  Ptr<RealtimeLagMonitor> lagMonitor = nullptr;
+  if (lagMonitorEnabled)
+    {
+      lagMonitor = CreateObject<RealtimeLagMonitor> ();
+      lagMonitor->SetAttribute ("OutputFile", StringValue (lagReportFile));
+      Simulator::Schedule (Seconds (0.0), &RealtimeLagMonitor::Start, lagMonitor);
+    }
+
   /* Give packet socket powers to nodes (otherwise, if the app tries to create a PacketSocket, CreateSocket will end up with a segmentation fault */
   if (udpIp=="")
   {
@@ -261,6 +300,11 @@ main (int argc, char *argv[])
       Ptr<FdNetDevice> dev = fdnetContainer.Get (0)->GetObject<FdNetDevice> ();
       dev->SetAddress (Mac48Address (veh_mac.str().c_str ()));
 
+      if (batchedIo && lagMonitor != nullptr)
+        {
+          lagMonitor->MonitorDevice (DynamicCast<BatchedFdNetDevice> (dev));
+        }
+
       std::cout<<"MAC of node "<<nodeCounter-1<<": "<<veh_mac.str()<<std::endl;
 
       /* When in UDP mode, configure the IP stack of the nodes/vehicles */
@@ -311,5 +355,36 @@ main (int argc, char *argv[])
   Simulator::Stop (simulationTime);
 
   Simulator::Run ();
+
+  if (lagMonitor != nullptr)
+    {
+      lagMonitor->Stop ();
+    }
+
+  if (batchedIo)
+    {
+      uint64_t txFrames = 0, txDrops = 0;
+      bool sharedSocket = false;
+      for (uint32_t i = 0; i < nodeCounter; i++)
+        {
+          // In UDP mode, the first device is the loopback one
+          for (uint32_t j = 0; j < obuNodes.Get (i)->GetNDevices (); j++)
+            {
+              Ptr<BatchedFdNetDevice> dev = DynamicCast<BatchedFdNetDevice> (obuNodes.Get (i)->GetDevice (j));
+              if (dev != nullptr)
+                {
+                  // The frames written at the stop time are still in the batch
+                  dev->FlushTxBatch ();
+                  txFrames += dev->GetTxFrames ();
+                  txDrops += dev->GetTxDrops ();
+                  sharedSocket |= dev->IsTxSocketShared ();
+                }
+            }
+        }
+      // With the shared socket, a batch contains the frames of several vehicles: the batches are counted once
+      std::cout << "Batched I/O: " << txFrames << " frames sent in " << BatchedFdNetDeviceTxQueue::GetTotalBatches ()
+                << " batches (" << (sharedSocket ? "shared" : "per-vehicle") << " socket), " << txDrops << " dropped." << std::endl;
+    }
+
   Simulator::Destroy ();
 }
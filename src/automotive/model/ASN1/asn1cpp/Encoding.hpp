@@ -85,12 +85,52 @@ namespace asn1cpp {
             return er.encoded < 0 ? std::string() : retval;
         }
 
+        /**
+         * @ingroup API
+         * @brief Encodes an asn1cpp wrapper into a caller-provided std::string.
+         *
+         * The buffer is cleared, but its capacity is kept: when the same
+         * buffer is reused for every encoding, no allocation is performed
+         * once it has grown to the size of the largest encoded message.
+         *
+         * @return The number of encoded bytes, or -1 if the encoding failed.
+         */
+        template <typename T, typename = typename std::enable_if<is_asn1_wrapper<T>::value>::type>
+        ssize_t encode(const T & m, std::string & buffer) {
+            buffer.clear();
+            if (!m) return -1;
+            const auto er = uper_encode(m.getTypeDescriptor(), nullptr, (void*)(&*m), Impl::fill, &buffer);
+            if (er.encoded < 0) {
+                buffer.clear();
+                return -1;
+            }
+            return buffer.size();
+        }
+
+        /**
+         * @ingroup API
+         * @brief Encodes an asn1cpp wrapper into a fixed-size caller-provided buffer.
+         *
+         * @return The number of encoded bytes, or -1 if the encoding failed
+         * or the buffer is too small.
+         */
+        template <typename T, typename = typename std::enable_if<is_asn1_wrapper<T>::value>::type>
+        ssize_t encode(const T & m, void * buffer, size_t size) {
+            if (!m) return -1;
+            const auto er = uper_encode_to_buffer(m.getTypeDescriptor(), nullptr, (void*)(&*m), buffer, size);
+            return er.encoded < 0 ? -1 : (er.encoded + 7) / 8;
+        }
+
+        /**
+         * @ingroup API
+         * @brief Decodes a UPER buffer directly from memory, without copying it.
+         */
         template <typename T>
-        Seq<T> decode(asn_TYPE_descriptor_t * def, const std::string & buffer) {
-            if (buffer.size() == 0) return Seq<T>();
+        Seq<T> decode(asn_TYPE_descriptor_t * def, const void * buffer, size_t size) {
+            if (size == 0) return Seq<T>();
 
             T * m = nullptr;
-            const auto dr = uper_decode_complete(0, def, (void**)&m, buffer.data(), buffer.size());
+            const auto dr = uper_decode_complete(0, def, (void**)&m, buffer, size);
 
             if (dr.code != RC_OK) {
                 def->op->free_struct(def, m, ASFM_FREE_EVERYTHING);
@@ -99,6 +139,11 @@ namespace asn1cpp {
 
             return Seq<T>(def, m);
         }
+
+        template <typename T>
+        Seq<T> decode(asn_TYPE_descriptor_t * def, const std::string & buffer) {
+            return decode<T>(def, buffer.data(), buffer.size());
+        }
     }
 }
 
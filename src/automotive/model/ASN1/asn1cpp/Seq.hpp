@@ -83,6 +83,16 @@ namespace asn1cpp {
              */
             Seq(const Seq & other);
 
+            /**
+             * @brief Move constructor.
+             *
+             * This constructor takes ownership of the structure owned by the
+             * input Seq, which is left empty. No copy is performed.
+             *
+             * @param other The Seq to move from.
+             */
+            Seq(Seq && other) noexcept;
+
             /**
              * @brief Copy constructor from other classes.
              *
@@ -155,6 +165,17 @@ namespace asn1cpp {
              */
             asn_TYPE_descriptor_t * getTypeDescriptor() const;
 
+            /**
+             * @brief Releases the ownership of the underlying asn1c structure.
+             *
+             * After this call this instance is empty, and the caller is
+             * responsible of freeing the returned structure (usually by
+             * storing it inside another structure owned by a Seq).
+             *
+             * @return The previously owned asn1c structure, can be nullptr.
+             */
+            T * release();
+
             /**
              * @brief Swaps two instances of Seq.
              *
@@ -240,6 +261,13 @@ namespace asn1cpp {
         deepCopy(other);
     }
 
+    template <typename T>
+    Seq<T>::Seq(Seq && other) noexcept :
+            seq_(other.seq_), def_(other.def_)
+    {
+        other.seq_ = nullptr;
+    }
+
     template <typename T>
     template <template <typename> class S, typename Y, typename>
     Seq<T>::Seq(const S<Y> & other) {
@@ -257,6 +285,13 @@ namespace asn1cpp {
         return def_;
     }
 
+    template <typename T>
+    T * Seq<T>::release() {
+        T * p = seq_;
+        seq_ = nullptr;
+        return p;
+    }
+
     template <typename T>
     Seq<T>::operator bool() const {
         return seq_;
@@ -300,10 +335,20 @@ namespace asn1cpp {
         // during the assignment won't cause a Seq<T> to try to delete an
         // uninitialized pointer.
         seq_ = nullptr;
-        if (other && other.getTypeDescriptor()) {
-            *this = ber::decode<T>(other.getTypeDescriptor(), ber::encode(other));
-        } else {
-            def_ = other.getTypeDescriptor();
+        def_ = other.getTypeDescriptor();
+        if (other && def_) {
+            // Structural copy through the asn1c runtime, which is much
+            // cheaper than encoding and decoding again the whole structure.
+            T * p = nullptr;
+            if (asn_copy(def_, (void**)&p, static_cast<const void *>(&*other)) == 0) {
+                seq_ = p;
+                return;
+            }
+            if (p)
+                def_->op->free_struct(def_, p, ASFM_FREE_EVERYTHING);
+
+            // Fall back to a BER encoding/decoding round trip.
+            *this = ber::decode<T>(def_, ber::encode(other));
         }
     }
 
@@ -40,6 +40,11 @@ namespace asn1cpp {
             return setof::adderElement(field, value);
         }
 
+        template <typename T>
+        bool adderElement(T & field, Seq<typename setof::Impl::ArrayType<T>::type> && value) {
+            return setof::adderElement(field, std::move(value));
+        }
+
         template <typename T>
         bool removerElement(T & field, int id, asn_TYPE_descriptor_t * def) {
             if (id < 0 || id >= getSize(field))
@@ -161,6 +161,22 @@ namespace asn1cpp {
             return adderElement(*field, value);
         }
 
+        template <typename T>
+        bool adderElement(T & field, Seq<typename Impl::ArrayType<T>::type> && value) {
+            if (!value) return false;
+            auto def = value.getTypeDescriptor();
+            auto ptr = value.release();
+            if (asn_set_add(&field, ptr) == 0) return true;
+            def->op->free_struct(def, ptr, ASFM_FREE_EVERYTHING);
+            return false;
+        }
+
+        template <typename T>
+        bool adderElement(T *& field, Seq<typename Impl::ArrayType<T*>::type> && value) {
+            if (!field) field = static_cast<T*>(calloc(1, sizeof(T)));
+            return adderElement(*field, std::move(value));
+        }
+
         template <typename T>
         bool removerElement(T & field, int id, asn_TYPE_descriptor_t * def) {
             if (id < 0 || id >= getSize(field))
@@ -2,6 +2,7 @@
 #define ASN1CPP_SETTER_HEADER_FILE
 
 #include <type_traits>
+#include <utility>
 
 #include "BOOLEAN.h"
 #include "INTEGER.h"
@@ -86,6 +87,26 @@ namespace asn1cpp {
         return Impl::Setter<F>()(field, value);
     }
 
+    // Setting a field from a temporary Seq moves the structure instead of
+    // copying it, so that nested structures built with makeSeq are not
+    // allocated twice.
+    template <typename F>
+    bool setterField(F & field, Seq<F> && value) {
+        if (!value) return false;
+        std::swap(field, *value);
+        return true;
+    }
+
+    template <typename F>
+    bool setterField(F *& field, Seq<F> && value) {
+        if (!value) return false;
+        if (!field) {
+            field = value.release();
+            return true;
+        }
+        return setterField(*field, std::move(value));
+    }
+
     template <typename F>
     bool clearerField(F *& field, asn_TYPE_descriptor_t * def) {
         if (field) {
@@ -345,7 +345,8 @@ CHOICE_copy(const asn_TYPE_descriptor_t *td, void **aptr, const void *bptr) {
     present = _fetch_present_idx(bptr,
                                  specs->pres_offset, specs->pres_size);
 
-    if(present <= 0 && (unsigned)present > td->elements_count) return -1;
+    if(present == 0) return 0;  /* Nothing selected: the copy is empty too */
+    if(present < 0 || (unsigned)present > td->elements_count) return -1;
     --present;
 
     elm = &td->elements[present];
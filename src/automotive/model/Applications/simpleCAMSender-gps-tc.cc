@@ -139,7 +139,14 @@ namespace ns3
     m_caService.setVDP(gpstc_vdp);
     m_denService.setVDP(gpstc_vdp);
 
-    m_caService.SetLogTriggering(true, "cam-log.txt");
+    if(m_triggerTrace != nullptr)
+      {
+        m_caService.SetTriggerTrace (m_triggerTrace);
+      }
+    else
+      {
+        m_caService.SetLogTriggering(true, "cam-log.txt");
+      }
 
     /* Schedule CAM dissemination */
     std::srand(Simulator::Now().GetNanoSeconds ());
@@ -34,6 +34,11 @@ public:
 
   void StopApplicationNow ();
 
+  /**
+   * @brief Write the CAM triggering conditions to a binary trace (shared by all the applications of a run), instead of the text log
+   */
+  void setTriggerTrace (std::shared_ptr<TriggerTrace> trace) {m_triggerTrace = trace;}
+
 protected:
   virtual void DoDispose (void);
 
@@ -51,6 +56,8 @@ private:
 
   Ptr<GPSTraceClient> m_gps_tc_client; //!< GPS trace client
 
+  std::shared_ptr<TriggerTrace> m_triggerTrace; //!< Binary trace of the CAM triggering conditions (if set)
+
   std::string m_id; //!< vehicle id
   bool m_real_time; //!< To decide wheter to use realtime scheduler
 
@@ -126,7 +126,14 @@ namespace ns3
     VRUdp* gpstc_vdp = new VRUDPGPSTraceClient(m_gps_tc_client, m_id);
     m_vruService.setVRUdp(gpstc_vdp);
 
-    m_vruService.SetLogTriggering(true, "vam-log.txt");
+    if(m_triggerTrace != nullptr)
+      {
+        m_vruService.SetTriggerTrace (m_triggerTrace);
+      }
+    else
+      {
+        m_vruService.SetLogTriggering(true, "vam-log.txt");
+      }
 
     /* Schedule VAM dissemination */
     std::srand(Simulator::Now().GetNanoSeconds ());
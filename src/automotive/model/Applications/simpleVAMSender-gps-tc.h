@@ -31,6 +31,11 @@ public:
 
   void StopApplicationNow ();
 
+  /**
+   * @brief Write the VAM triggering conditions to a binary trace (shared by all the applications of a run), instead of the text log
+   */
+  void setTriggerTrace (std::shared_ptr<TriggerTrace> trace) {m_triggerTrace = trace;}
+
 protected:
   virtual void DoDispose (void);
 
@@ -47,6 +52,8 @@ private:
 
   Ptr<GPSTraceClient> m_gps_tc_client; //!< GPS trace client
 
+  std::shared_ptr<TriggerTrace> m_triggerTrace; //!< Binary trace of the VAM triggering conditions (if set)
+
   std::string m_id; //!< vehicle id
   bool m_real_time; //!< To decide wheter to use realtime scheduler
 
@@ -105,6 +105,7 @@ namespace ns3
     NS_LOG_FUNCTION(this);
     TypeId tid;
     m_id = m_client->GetVehicleId (this->GetNode ());
+    m_stationId = m_client->GetStationNumericId (this->GetNode ());
 
     /* Create the socket for TX and RX (must be a P */
     if(!m_udpmode_enabled)
@@ -179,21 +180,21 @@ namespace ns3
     /* Set sockets, callback and station properties in DENBasicService */
     m_denService.setSocketRx (m_socket);
     m_denService.setSocketTx (m_socket);
-    m_denService.setStationProperties (std::stol(m_id.substr (3)), StationType_passengerCar);
+    m_denService.setStationProperties (m_stationId, StationType_passengerCar);
     m_denService.addDENRxCallback (std::bind(&v2xEmulator::receiveDENM,this,std::placeholders::_1,std::placeholders::_2));
     m_denService.setRealTime (true);
 
     /* Set sockets, callback, station properties and TraCI VDP in CABasicService */
     m_caService.setSocketRx (m_socket);
     m_caService.setSocketTx (m_socket);
-    m_caService.setStationProperties (std::stol(m_id.substr (3)), StationType_passengerCar);
+    m_caService.setStationProperties (m_stationId, StationType_passengerCar);
     m_caService.addCARxCallback (std::bind(&v2xEmulator::receiveCAM,this,std::placeholders::_1,std::placeholders::_2));
     m_caService.setRealTime (true);
 
     /* Set sockets, callback, station properties and TraCI VDP in CPBasicService */
     m_cpService.setSocketTx (m_socket);
     m_cpService.setSocketRx (m_socket);
-    m_cpService.setStationProperties (std::stol(m_id.substr (3)), StationType_passengerCar);
+    m_cpService.setStationProperties (m_stationId, StationType_passengerCar);
     m_cpService.addCPRxCallback (std::bind(&v2xEmulator::receiveCPM,this,std::placeholders::_1,std::placeholders::_2));
     m_cpService.setRealTime (true);
     m_cpService.setTraCIclient (m_client);
@@ -322,7 +323,7 @@ namespace ns3
 
    // Ignore messages coming from itself
    // This is needed as broadcasted packets over a promiscuous inteface are also received back on the same socket
-   if(asn1cpp::getField(cam->header.stationId,StationID_t)==std::stoul(m_id.substr (3)))
+   if(asn1cpp::getField(cam->header.stationId,StationID_t)==m_stationId)
        return;
 
     /* Implement CAM strategy here */
@@ -334,7 +335,7 @@ namespace ns3
   {
         // Ignore messages coming from itself
         // This is needed as broadcasted packets over a promiscuous inteface are also received back on the same socket
-        if(asn1cpp::getField(cpm->header.stationId,StationID_t)==std::stoul(m_id.substr (3)))
+        if(asn1cpp::getField(cpm->header.stationId,StationID_t)==m_stationId)
                 return;
 
         /* Implement CPM strategy here */
@@ -346,7 +347,7 @@ namespace ns3
   {
     // Ignore messages coming from itself
     // This is needed as broadcasted packets over a promiscuous inteface are also received back on the same socket
-    if(denm.getDenmHeaderStationID()==std::stol(m_id.substr (3)))
+    if((uint64_t) denm.getDenmHeaderStationID()==m_stationId)
     {
         return;
     }
@@ -65,6 +65,7 @@ private:
 
   Ptr<TraciClient> m_client; //!< TraCI client
   std::string m_id; //!< vehicle id
+  uint64_t m_stationId; //!< numeric station id, as parsed by the TraCI client
   bool m_send_cam; //!< To decide if CAM dissemination is active or not
   bool m_send_denm; //!< To decide if DENM dissemination is active or not
   bool m_send_cpm;  //!< To decide if CPM dissemination is active or not
@@ -17,6 +17,7 @@
  * (carlosrisma@gmail.com)
 */
 #include "btp.h"
+#include "ns3/rx-allocation-counter.h"
 
 
 namespace ns3
@@ -127,6 +128,7 @@ namespace ns3
     btpDataIndication.GNPositionV = dataIndication.SourcePV;
     btpDataIndication.data = dataIndication.data;
     btpDataIndication.lenght = dataIndication.data->GetSize ();
+    btpDataIndication.payload = dataIndication.payload != NULL ? dataIndication.payload + header.GetSerializedSize () : NULL;
 
     if(btpDataIndication.destPort == CA_PORT) {
       if(m_cam_ReceiveCallback!=nullptr) {
@@ -154,4 +156,23 @@ namespace ns3
     }
   }
 
+  const uint8_t *
+  btp::getPayloadView(const BTPDataIndication_t &dataIndication, std::vector<uint8_t> &buffer)
+  {
+    if(dataIndication.payload != NULL)
+    {
+      return dataIndication.payload;
+    }
+
+    uint32_t size = dataIndication.data->GetSize ();
+    if(buffer.size () < size)
+    {
+      buffer.resize (size);
+      RxAllocationCounter::Notify ();
+    }
+    dataIndication.data->CopyData (buffer.data (), size);
+
+    return buffer.data ();
+  }
+
 }
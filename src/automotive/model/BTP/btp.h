@@ -120,6 +120,19 @@ namespace ns3
     void receiveBTP(GNDataIndication_t, Address address);
     void cleanup();
 
+    /**
+     * @brief Get a contiguous view of the payload of a received BTP message.
+     *
+     * The view on the GeoNetworking receive buffer is returned directly, when available (i.e., when GeoNet already had
+     * to copy the whole PDU for a MetricSupervisor). Otherwise, only the payload is copied into "buffer", which should
+     * be kept and reused by the caller for every reception, so that it is allocated only once.
+     *
+     * @param dataIndication The received BTP message.
+     * @param buffer Fallback buffer, used only if no view is available.
+     * @return A pointer to the dataIndication.data->GetSize () bytes of the payload.
+     */
+    static const uint8_t *getPayloadView(const BTPDataIndication_t &dataIndication, std::vector<uint8_t> &buffer);
+
   private:
 
     Ptr<GeoNet> m_geonet; //! Pointer to the GeoNet object.
@@ -94,6 +94,7 @@ namespace ns3 {
 
     uint32_t lenght;
     Ptr<Packet> data;
+    const uint8_t *payload; // Contiguous view of the payload, owned by GeoNetworking and valid only during the reception callbacks (NULL if not available)
   } BTPDataIndication_t;
 
   typedef struct _gndataRequest {
@@ -146,6 +147,7 @@ namespace ns3 {
 
     uint32_t lenght; // Payload size
     Ptr<Packet> data; // Payload
+    const uint8_t *payload; // Contiguous view of the payload, owned by GeoNetworking and valid only during the reception callbacks (NULL if not available)
   } GNDataIndication_t;
 }
 
@@ -98,9 +98,11 @@ void DCC::reactiveDCC()
         }
 
       // Get the NetDevice
-      int nodeID_int = m_traci_client->get_NodeMap()[id].second->GetId();
+      Ptr<Node> node = m_traci_client->GetNode (id);
+      NS_ASSERT_MSG (node != nullptr, "Node " << id << " not found in the TraCI client node map");
+      int nodeID_int = node->GetId();
       std::string nodeID_str = std::to_string (nodeID_int);
-      Ptr<NetDevice> netDevice = m_traci_client->get_NodeMap()[id].second->GetDevice (0);
+      Ptr<NetDevice> netDevice = node->GetDevice (0);
       Ptr<WifiNetDevice> wifiDevice;
 
       Ptr<WifiPhy> phy80211p = nullptr;
@@ -160,7 +162,9 @@ void DCC::adaptiveDCC()
   for (auto it = cbrs.begin (); it != cbrs.end (); ++it)
     {
       std::string id = it->first;
-      int nodeID_int = m_traci_client->get_NodeMap ()[id].second->GetId ();
+      Ptr<Node> node = m_traci_client->GetNode (id);
+      NS_ASSERT_MSG (node != nullptr, "Node " << id << " not found in the TraCI client node map");
+      int nodeID_int = node->GetId ();
       std::string nodeID_str = std::to_string (nodeID_int);
       double current_cbr = it->second.back ();
       double previous_cbr;
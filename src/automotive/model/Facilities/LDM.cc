@@ -94,15 +94,19 @@ namespace ns3 {
 
     if (it == m_LDM.end()) {
         newVehicleData.age_us = Simulator::Now().GetMicroSeconds ();
-        m_LDM[newVehicleData.stationID].vehData = newVehicleData;
-        m_LDM[newVehicleData.stationID].phData = PHpoints();
-        m_LDM[newVehicleData.stationID].phData.insert (newVehicleData,m_stationID);
+        returnedVehicleData_t &entry = m_LDM[newVehicleData.stationID];
+        entry.vehData = newVehicleData;
+        entry.phData = PHpoints();
+        entry.phData.insert (newVehicleData,m_stationID);
+        updateOwnPOs (entry.vehData,OptionalDataItem<long>(false));
         m_card++;
         retval = LDM_OK;
     } else {
+        OptionalDataItem<long> prevPerceivedBy = it->second.vehData.perceivedBy;
         newVehicleData.age_us = it->second.vehData.age_us;
         it->second.vehData = newVehicleData;
         it->second.phData.insert (newVehicleData,m_stationID);
+        updateOwnPOs (it->second.vehData,prevPerceivedBy);
         retval = LDM_UPDATED;
     }
     return retval;
@@ -118,6 +122,7 @@ namespace ns3 {
         return LDM_ITEM_NOT_FOUND;
       }
     else{
+        removeOwnPO (it->second.vehData.stationID,it->second.vehData.perceivedBy);
         m_LDM.erase (it);
         m_card--;
       }
@@ -150,10 +155,115 @@ namespace ns3 {
     else{
         it->second.vehData.lastCPMincluded = timestamp;
         it->second.phData.setCPMincluded ();
+
+        // Store the state of the object at this inclusion, as a reference for the next inclusion conditions
+        vehicleData_t &data = it->second.vehData;
+        if(data.perceivedBy.isAvailable ())
+          {
+            auto station = m_ownPOs.find (data.perceivedBy.getData ());
+            if(station != m_ownPOs.end ())
+              {
+                auto po = station->second.find (stationID);
+                if(po != station->second.end ())
+                  {
+                    po->second.included = true;
+                    po->second.due = false;
+                    po->second.lastIncluded = timestamp;
+                    po->second.lat = data.lat;
+                    po->second.lon = data.lon;
+                    po->second.speed_ms = data.speed_ms;
+                    po->second.heading = data.heading;
+                  }
+              }
+          }
       }
     return LDM_OK;
   }
 
+  void
+  LDM::updateOwnPOs(vehicleData_t &data, OptionalDataItem<long> prevPerceivedBy)
+  {
+    // The object may have been perceived by another station before this update
+    if(prevPerceivedBy.isAvailable () &&
+       (!data.detected || !data.perceivedBy.isAvailable () || prevPerceivedBy.getData () != data.perceivedBy.getData ()))
+      {
+        removeOwnPO (data.stationID,prevPerceivedBy);
+      }
+
+    if(!data.detected || !data.perceivedBy.isAvailable ())
+      {
+        return;
+      }
+
+    auto res = m_ownPOs[data.perceivedBy.getData ()].emplace (data.stationID,ownPOState_t());
+    ownPOState_t &po = res.first->second;
+    po.data = &data;
+
+    if(res.second)
+      {
+        // 1.a The object has been detected for the first time
+        po.included = false;
+        po.due = true;
+        po.lastIncluded = 0;
+        return;
+      }
+
+    if(po.due || !po.included)
+      {
+        return;
+      }
+
+    double head_diff = data.heading - po.heading;
+    head_diff += (head_diff > 180.0) ? -360.0 : (head_diff < -180.0) ? 360.0 : 0.0;
+
+    // 1.b, 1.c and 1.d Position, speed and heading thresholds, with respect to the last inclusion in a CPM
+    if(haversineDist (po.lat,po.lon,data.lat,data.lon) > 4.0 ||
+       std::abs (data.speed_ms - po.speed_ms) > 0.5 ||
+       std::abs (head_diff) > 4.0)
+      {
+        po.due = true;
+      }
+  }
+
+  void
+  LDM::removeOwnPO(uint64_t objectID, OptionalDataItem<long> perceivedBy)
+  {
+    if(!perceivedBy.isAvailable ())
+      {
+        return;
+      }
+
+    auto station = m_ownPOs.find (perceivedBy.getData ());
+    if(station != m_ownPOs.end ())
+      {
+        station->second.erase (objectID);
+      }
+  }
+
+  bool
+  LDM::getOwnPOsForCPM(long perceivedBy, uint64_t now, uint64_t T_GenCpmMax_ms, bool all, std::vector<vehicleData_t *> &selectedPOs)
+  {
+    bool retval = false;
+
+    auto station = m_ownPOs.find (perceivedBy);
+    if(station == m_ownPOs.end ())
+      {
+        return false;
+      }
+
+    for(auto &po : station->second)
+      {
+        // 1.e The time elapsed since the last time the object was included in a CPM exceeds T_GenCpmMax
+        if(all || po.second.due || po.second.lastIncluded + T_GenCpmMax_ms < now)
+          {
+            selectedPOs.push_back (po.second.data);
+            retval = true;
+          }
+      }
+
+    return retval;
+  }
+
   LDM::LDM_error_t
   LDM::rangeSelect(double range_m, double lat, double lon, std::vector<returnedVehicleData_t> &selectedVehicles)
   {
@@ -261,6 +371,7 @@ namespace ns3 {
                   }
               }
 
+              removeOwnPO (it->second.vehData.stationID,it->second.vehData.perceivedBy);
               it = m_LDM.erase(it);
               m_card--;
             } else {
@@ -307,6 +418,7 @@ namespace ns3 {
                   }
               }
               oper_fcn(it->second.vehData.stationID,additional_args);
+              removeOwnPO (it->second.vehData.stationID,it->second.vehData.perceivedBy);
               it = m_LDM.erase(it);
               m_card--;
             } else {
@@ -319,6 +431,7 @@ namespace ns3 {
   LDM::clear() {
 
     m_LDM.clear();
+    m_ownPOs.clear();
     // Set the cardinality of the map to 0 again
     m_card = 0;
   }
@@ -463,7 +576,7 @@ namespace ns3 {
     boost::geometry::transform(Spoints.back_right, Spoints.back_right, rotateS);
 
     //Translate to actual front bumper position
-    SPos = m_client->TraCIAPI::simulation.convertLonLattoXY (data.lon,data.lat);
+    SPos = m_client->ConvertLonLattoXY (data.lon,data.lat);
     translate_transformer<double, 2, 2> translateS(SPos.x,SPos.y);
     boost::geometry::transform(Spoints.center, Spoints.center, translateS);
     boost::geometry::transform(Spoints.front_left, Spoints.front_left, translateS);
@@ -131,6 +131,26 @@ public:
      * */
     LDM_error_t updateCPMincluded(uint64_t stationID,uint64_t timestamp);
 
+    /**
+     * @brief This function returns the Perceived Objects (POs) detected by a given station which are due for inclusion in its next CPM
+     *
+     * The LDM keeps, for each perceiving station, an index of its own POs, together with the state of each object when it was
+     * lastly included in a CPM (see updateCPMincluded()). When a PO is inserted or updated, the object is marked as due for inclusion
+     * if it is new, or if, since its last inclusion, it moved by more than 4 m, its speed changed by more than 0.5 m/s or its heading
+     * changed by more than 4 degrees (ETSI TS 103 324, Section 6.1.2.3). The time condition is instead checked here, as an object is
+     * also due when more than T_GenCpmMax_ms have elapsed since its last inclusion.
+     * Only the POs of the given station are visited, and the returned pointers refer to the data stored in the database, without copying
+     * the Path History: they are valid only until the next insertion or removal.
+     *
+     * @param perceivedBy the station ID of the perceiving station
+     * @param now the current timestamp (ms), with the same time base of the timestamps passed to updateCPMincluded()
+     * @param T_GenCpmMax_ms the maximum time between two inclusions of the same object
+     * @param all if true, all the POs of the station are returned, regardless of the inclusion conditions
+     * @param selectedPOs the vector in which the selected POs will be returned (it is not cleared by this function)
+     * @return true if at least one PO has been returned
+     */
+    bool getOwnPOsForCPM(long perceivedBy, uint64_t now, uint64_t T_GenCpmMax_ms, bool all, std::vector<vehicleData_t *> &selectedPOs);
+
     /**
      * @brief This function returns all Perceived Objects (POs) that are currently in the LDM, false if there are not POs in LDM
      *
@@ -233,8 +253,25 @@ public:
 
 private:
 
+        // Inclusion state of a PO in the CPMs of the station which perceived it
+        typedef struct _ownPOState {
+          vehicleData_t *data; // Data stored in m_LDM (the address of the elements of an unordered_map is stable)
+          bool included; // true if the object has already been included in a CPM
+          bool due; // true if one of the ETSI kinematic inclusion thresholds has been crossed since the last inclusion
+          uint64_t lastIncluded; // Timestamp of the last inclusion (ms)
+          double lat; // Position, speed and heading of the object when lastly included in a CPM
+          double lon;
+          double speed_ms;
+          double heading;
+        } ownPOState_t;
+
+        void updateOwnPOs(vehicleData_t &data, OptionalDataItem<long> prevPerceivedBy);
+        void removeOwnPO(uint64_t objectID, OptionalDataItem<long> perceivedBy);
+
 	// Main database structure
 	std::unordered_map<uint64_t,returnedVehicleData_t> m_LDM;
+	// Index of the POs of each perceiving station (perceivedBy -> object ID -> inclusion state)
+	std::unordered_map<long,std::unordered_map<uint64_t,ownPOState_t>> m_ownPOs;
 	// Database cardinality (number of entries stored in the database)
 	uint64_t m_card;
 	long m_count;
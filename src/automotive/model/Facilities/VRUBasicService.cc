@@ -12,6 +12,7 @@
 #include "ns3/SequenceOf.hpp"
 #include "ns3/BitString.hpp"
 #include "ns3/asn_utils.h"
+#include "ns3/decodedMessageCache.h"
 #include <cmath>
 
 namespace ns3
@@ -20,6 +21,7 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("VRUBasicService");
 
 VRUBasicService::~VRUBasicService(){
+    removeFromScheduler ();
     //NS_LOG_INFO("VRUBasicService object destroyed.");
 }
 
@@ -125,7 +127,7 @@ VRUBasicService::VRUBasicService(unsigned long fixed_stationid,long fixed_statio
   m_VRUdp = VRUdp;
 }
 
-void VRUBasicService::write_log_triggering(bool condition_verified, bool vamredmit_verified, float head_diff, float pos_diff, float speed_diff, long time_difference, std::string data_head, std::string data_pos, std::string data_speed, std::string data_safed, std::string data_time, std::string data_vamredmit)
+void VRUBasicService::write_log_triggering(const VAMTriggerRecord_t &record)
 {
   if (m_log_triggering && m_log_filename != "")
     {
@@ -133,88 +135,33 @@ void VRUBasicService::write_log_triggering(bool condition_verified, bool vamredm
       std::string sent="false";
 
       std::string motivation;
-      std::string joint;
-      int numConditions=0;
       std::string num_VAMs_sent="";
 
-      long time = Simulator::Now().GetMilliSeconds();
-
       // Check the motivation of the VAM sent
-      if (!condition_verified && !vamredmit_verified) {
+      if (!record.sent && !record.redundancyMitigation) {
           motivation="none";
           num_VAMs_sent="unavailable";
-        } else if(vamredmit_verified){
+        } else if(record.redundancyMitigation){
           motivation="VAM Redundancy Mitigation";
           num_VAMs_sent="unavailable";
         } else {
           data="[VAM] VAM sent\n";
           sent="true";
-
-          if(head_diff > 10.0 || head_diff < -10.0)
-          // if(head_diff > 4.0 || head_diff < -4.0)
-            {
-              motivation="heading";
-              joint=joint+"H";
-              num_VAMs_sent=std::to_string(m_head_sent);
-              numConditions++;
-            }
-
-          if((pos_diff > 4.0 || pos_diff < -4.0)) {
-              motivation="position";
-              joint=joint+"P";
-              num_VAMs_sent=std::to_string(m_pos_sent);
-              numConditions++;
-            }
-
-          if(speed_diff > 0.5 || speed_diff < -0.5) {
-              motivation="speed";
-              joint=joint+"S";
-              num_VAMs_sent=std::to_string(m_speed_sent);
-              numConditions++;
-            }
-
-          if (m_min_dist.size() != 0)
-            {
-              if((m_min_dist[1].longitudinal < m_long_safe_d && m_min_dist[1].lateral < m_lat_safe_d && m_min_dist[1].vertical < m_vert_safe_d) || (m_min_dist[0].longitudinal < m_long_safe_d && m_min_dist[0].lateral < m_lat_safe_d && m_min_dist[0].vertical < m_vert_safe_d)){
-                  motivation="safe_distances";
-                  joint=joint+"D";
-                  num_VAMs_sent=std::to_string(m_safedist_sent);
-                  numConditions++;
-                }
-            }
-
-          if(abs(time_difference - m_T_GenVam_ms) <= 10 || (m_T_GenVam_ms - time_difference) <= 0 ) {
-              motivation="time";
-              joint=joint+"T";
-              num_VAMs_sent=std::to_string(m_time_sent);
-              numConditions++;
-            }
-
-          // When joint with a single other motivation, the joint motivation should not be considered
-          if(numConditions>1) {
-              motivation="joint("+joint+")";
-              if(joint=="HT") {
-                  motivation="heading";
-                }
-              if(joint=="PT") {
-                  motivation="position";
-                }
-              if(joint=="ST") {
-                  motivation="speed";
-                }
-              if(joint=="DT") {
-                  motivation="safe_distances";
-                }
-            }
-
-          if(condition_verified && strlen(motivation.c_str())==0) {
-              motivation="numPkt";
+          motivation=TriggerTrace::motivationString (record.motivation);
+          if(record.numSent>=0) {
+              num_VAMs_sent=std::to_string(record.numSent);
             }
         }
 
       // Create the data for the log print
-      data+="[LOG] Timestamp="+std::to_string(time)+" VAMSent="+sent+" Motivation="+motivation+" NUMVAMsSent="+num_VAMs_sent+" HeadDiff="+std::to_string(head_diff)+" PosDiff="+std::to_string(pos_diff)+" SpeedDiff="+std::to_string(speed_diff)+" TimeDiff="+std::to_string(time_difference)+"\n";
-      data=data+data_head+data_pos+data_speed+data_safed+data_time+data_vamredmit+"\n";
+      data+="[LOG] Timestamp="+std::to_string(record.simTime)+" VAMSent="+sent+" Motivation="+motivation+" NUMVAMsSent="+num_VAMs_sent+" HeadDiff="+std::to_string((float)record.headDiff)+" PosDiff="+std::to_string((float)record.posDiff)+" SpeedDiff="+std::to_string((float)record.speedDiff)+" TimeDiff="+std::to_string(record.timeDiff)+"\n";
+      data+="[HEADING] HeadingUnavailable="+std::to_string((float)HeadingValue_unavailable/10)+" PrevHead="+std::to_string(record.prevHeading)+" CurrHead="+std::to_string(record.currHeading)+" HeadDiff="+std::to_string(record.headDiff)+"\n";
+      data+="[DISTANCE] PrevLat="+std::to_string(record.prevLat)+" PrevLon="+std::to_string(record.prevLon)+" CurrLat="+std::to_string(record.currLat)+" CurrLon="+std::to_string(record.currLon)+" PosDiff="+std::to_string(record.posDiff)+"\n";
+      data+="[SPEED] SpeedUnavailable="+std::to_string((float)SpeedValue_unavailable)+" PrevSpeed="+std::to_string(record.prevSpeed)+" CurrSpeed="+std::to_string(record.currSpeed)+" SpeedDiff="+std::to_string(record.speedDiff)+"\n";
+      data+="[SAFE DISTANCES] LongSafeDist="+std::to_string(record.safeDist[0])+" LatSafeDist="+std::to_string(record.safeDist[1])+" VertSafeDist="+std::to_string(record.safeDist[2])+" MinLongDistVeh="+printMinDist(record.minDistVeh[0])+" MinLatDistVeh="+printMinDist(record.minDistVeh[1])+" MinVertDistVeh="+printMinDist(record.minDistVeh[2])+" MinLongDistPed="+printMinDist(record.minDistPed[0])+" MinLatDistPed="+printMinDist(record.minDistPed[1])+" MinVertDistPed="+printMinDist(record.minDistPed[2])+"\n";
+      data+="[TIME] Timestamp="+std::to_string(record.timestamp)+" LastVAMSent="+std::to_string(record.lastVamGen)+" TimeThreshold="+std::to_string(record.T_GenVam_ms)+" TimeDiff="+std::to_string(record.timeDiff)+" TimeNextVAM="+std::to_string(record.T_GenVam_ms - record.timeDiff)+"\n";
+      data+="[REDUNDANCY MITIGATION] numSkipVAMsForRedMitMax="+std::to_string(record.N_GenVam_max_red)+" numSkipVAMsForRedMit="+std::to_string(record.N_GenVam_red)+" TimestampLastVAMGen="+std::to_string(record.lastVamGenEnd)+" TimeIntervalSinceLastVAMGen="+std::to_string(record.timeDiff)+"\n";
+      data+="\n";
 
       std::ofstream file (m_log_filename, std::ios::app);
       file << data;
@@ -279,32 +226,28 @@ void VRUBasicService::startAccelerationComputation(long computationT_acc){
 
 void VRUBasicService::receiveVam(BTPDataIndication_t dataIndication, Address from){
   Ptr<Packet> packet;
-  asn1cpp::Seq<VAM> decoded_vam;
-  uint8_t *buffer;
 
   if(m_VRU_role != VRU_ROLE_OFF){
-      buffer=(uint8_t *)malloc((dataIndication.data->GetSize ())*sizeof(uint8_t));
-      dataIndication.data->CopyData (buffer, dataIndication.data->GetSize ());
-      std::string packetContent((char *)buffer,(int) dataIndication.data->GetSize ());
+      const uint8_t *buffer = btp::getPayloadView (dataIndication, m_rxBuffer);
+      uint32_t bufferSize = dataIndication.data->GetSize ();
 
       /* Try to check if the received packet is really a VAM */
       if (buffer[1]!=FIX_VAMID)
         {
           NS_LOG_ERROR("Warning: received a message which has messageID '"<<buffer[1]<<"' but '16' was expected.");
-          free(buffer);
           return;
         }
 
-      free(buffer);
-
       /** Decoding **/
-      decoded_vam = asn1cpp::uper::decodeASN(packetContent, VAM);
+      DecodedMessageCache<VAM>::DecodedPtr_t decoded_vam_ptr = DecodedMessageCache<VAM>::Get ().Decode (buffer, bufferSize, &asn_DEF_VAM);
 
-      if(bool(decoded_vam)==false) {
+      if(decoded_vam_ptr==nullptr) {
           NS_LOG_ERROR("Warning: unable to decode a received VAM.");
           return;
         }
 
+      const asn1cpp::Seq<VAM> &decoded_vam = *decoded_vam_ptr;
+
       if(m_LDM != NULL){
         //Update LDM
         vLDM_handler(decoded_vam);
@@ -318,7 +261,7 @@ void VRUBasicService::receiveVam(BTPDataIndication_t dataIndication, Address fro
     }
 }
 
-void VRUBasicService::vLDM_handler(asn1cpp::Seq<VAM> decodedVAM){
+void VRUBasicService::vLDM_handler(const asn1cpp::Seq<VAM> &decodedVAM){
   vehicleData_t vehdata;
   LDM::LDM_error_t db_retval;
   bool lowFreq_ok;
@@ -345,21 +288,64 @@ void VRUBasicService::initDissemination(){
   VRUBasicService_error_t vam_error = generateAndEncodeVam();
 
   if((m_VRU_clust_state==VRU_ACTIVE_STANDALONE || m_VRU_clust_state==VRU_ACTIVE_CLUSTER_LEADER) && m_VRU_role==VRU_ROLE_ON)
+    scheduleNextCheck ();
+}
+
+void VRUBasicService::scheduleNextCheck(){
+  Time next_check = Simulator::Now () + MilliSeconds(m_T_CheckVamGen_ms);
+
+  if(m_schedulerSlot!=UINT32_MAX)
+    TriggerConditionScheduler<VRUBasicService>::Get ().SetNextCheck (m_schedulerSlot,next_check);
+  else if(m_centralConditionCheck && !m_real_time)
+    m_schedulerSlot = TriggerConditionScheduler<VRUBasicService>::Get ().AddStation (this,next_check);
+  else
     m_event_vamCheckConditions = Simulator::Schedule (MilliSeconds(m_T_CheckVamGen_ms), &VRUBasicService::checkVamConditions, this);
 }
 
+void VRUBasicService::removeFromScheduler(){
+  if(m_schedulerSlot!=UINT32_MAX)
+    {
+      TriggerConditionScheduler<VRUBasicService>::Get ().RemoveStation (m_schedulerSlot,this);
+      m_schedulerSlot = UINT32_MAX;
+    }
+}
+
+void VRUBasicService::scheduleConditionCheck(Time delay){
+  m_event_vamCheckConditions = Simulator::Schedule (delay, &VRUBasicService::checkVamConditions, this);
+}
+
+void VRUBasicService::fillConditionSnapshot(TriggerConditionSnapshot_t &snapshot, size_t i){
+  libsumo::TraCIPosition new_pos = m_VRUdp->getPedPositionValue();
+
+  snapshot.heading[i] = m_VRUdp->getPedHeadingValue ();
+  snapshot.prevHeading[i] = m_prev_heading;
+  snapshot.headingThreshold[i] = 10.0;
+  snapshot.posDiff[i] = sqrt((new_pos.x-m_prev_position.x)*(new_pos.x-m_prev_position.x)+(new_pos.y-m_prev_position.y)*(new_pos.y-m_prev_position.y));
+  snapshot.speed[i] = m_VRUdp->getPedSpeedValue ();
+  snapshot.prevSpeed[i] = m_prev_speed;
+  snapshot.lastGen[i] = lastVamGen;
+  snapshot.T_Gen[i] = m_T_GenVam_ms;
+  snapshot.checkPeriod[i] = MilliSeconds(m_T_CheckVamGen_ms).GetNanoSeconds ();
+  // The safe distances and the redundancy mitigation depend on the other road users in the LDM, and every traced check
+  // must be performed by the service
+  snapshot.force[i] = (m_LDM != nullptr && m_LDM->getCardinality () > 0) ||
+                      FACILITIES_TRACE_ENABLED(m_triggerTrace != nullptr || m_log_triggering);
+}
+
 void VRUBasicService::checkVamConditions(){
   int64_t now = computeTimestampUInt64 ()/NANO_TO_MILLI;
   VRUBasicService_error_t vam_error;
   bool condition_verified = false;
   bool vamredmit_verified = false;
   bool redundancy_mitigation = false;
-  std::string data_head="";
-  std::string data_pos="";
-  std::string data_speed="";
-  std::string data_safed="";
-  std::string data_vamredmit="";
-  std::string data_time="";
+
+  // The trace record is filled only when someone is going to read it
+  bool trace_enabled = FACILITIES_TRACE_ENABLED(m_triggerTrace != nullptr || m_log_triggering);
+  VAMTriggerRecord_t trace_record;
+  if(trace_enabled)
+    {
+      memset(&trace_record,0,sizeof(trace_record));
+    }
 
   // If no initial VAM has been triggered before checkCamConditions() has been called, throw an error
   if(m_prev_heading==-1 || m_prev_speed==-1 || (m_prev_position.x==-1 && m_prev_position.y==-1))
@@ -386,7 +372,11 @@ void VRUBasicService::checkVamConditions(){
 
   double head_diff = m_VRUdp->getPedHeadingValue () - m_prev_heading;
   head_diff += (head_diff>180.0) ? -360.0 : (head_diff<-180.0) ? 360.0 : 0.0;
-  data_head="[HEADING] HeadingUnavailable="+std::to_string((float)HeadingValue_unavailable/10)+" PrevHead="+std::to_string(m_prev_heading)+" CurrHead="+std::to_string(m_VRUdp->getPedHeadingValue ())+" HeadDiff="+std::to_string(head_diff)+"\n";
+  if(trace_enabled)
+    {
+      trace_record.prevHeading = m_prev_heading;
+      trace_record.currHeading = m_VRUdp->getPedHeadingValue ();
+    }
   if (head_diff > 10.0 || head_diff < -10.0)
   //if (head_diff > 4.0 || head_diff < -4.0)
     {
@@ -418,7 +408,13 @@ void VRUBasicService::checkVamConditions(){
   double ped_lon = m_VRUdp->getPedPosition().lon;
   libsumo::TraCIPosition new_pos = m_VRUdp->getPedPositionValue();
   double pos_diff = sqrt((new_pos.x-m_prev_position.x)*(new_pos.x-m_prev_position.x)+(new_pos.y-m_prev_position.y)*(new_pos.y-m_prev_position.y));
-  data_pos="[DISTANCE] PrevLat="+std::to_string(m_prev_lat)+" PrevLon="+std::to_string(m_prev_lon)+" CurrLat="+std::to_string(ped_lat)+" CurrLon="+std::to_string(ped_lon)+" PosDiff="+std::to_string(pos_diff)+"\n";
+  if(trace_enabled)
+    {
+      trace_record.prevLat = m_prev_lat;
+      trace_record.prevLon = m_prev_lon;
+      trace_record.currLat = ped_lat;
+      trace_record.currLon = ped_lon;
+    }
   if (!condition_verified && (pos_diff > 4.0 || pos_diff < -4.0))
     {
       if(!redundancy_mitigation && (m_N_GenVam_red==0 || m_N_GenVam_red==m_N_GenVam_max_red)){
@@ -446,7 +442,11 @@ void VRUBasicService::checkVamConditions(){
    * ITS-S exceeds 0,5 m/s.
   */
   double speed_diff = m_VRUdp->getPedSpeedValue () - m_prev_speed;
-  data_speed="[SPEED] SpeedUnavailable="+std::to_string((float)SpeedValue_unavailable)+" PrevSpeed="+std::to_string(m_prev_speed)+" CurrSpeed="+std::to_string(m_VRUdp->getPedSpeedValue ())+" SpeedDiff="+std::to_string(speed_diff)+"\n";
+  if(trace_enabled)
+    {
+      trace_record.prevSpeed = m_prev_speed;
+      trace_record.currSpeed = m_VRUdp->getPedSpeedValue ();
+    }
   if (!condition_verified && (speed_diff > 0.5 || speed_diff < -0.5))
     {
       if(!redundancy_mitigation && (m_N_GenVam_red==0 || m_N_GenVam_red==m_N_GenVam_max_red)){
@@ -481,13 +481,21 @@ void VRUBasicService::checkVamConditions(){
    * distance smaller than 2 m and the vertical distance smaller than 5 m, a VAM must be transmitted
   */
 
-  if (m_min_dist.size() != 0)
+  if(trace_enabled)
     {
-      data_safed = "[SAFE DISTANCES] LongSafeDist="+std::to_string(m_long_safe_d)+" LatSafeDist="+std::to_string(m_lat_safe_d)+" VertSafeDist="+std::to_string(m_vert_safe_d)+" MinLongDistVeh="+printMinDist(m_min_dist[1].longitudinal)+" MinLatDistVeh="+printMinDist(m_min_dist[1].lateral)+" MinVertDistVeh="+printMinDist(m_min_dist[1].vertical)+" MinLongDistPed="+printMinDist(m_min_dist[0].longitudinal)+" MinLatDistPed="+printMinDist(m_min_dist[0].lateral)+" MinVertDistPed="+printMinDist(m_min_dist[0].vertical)+"\n";
-    }
-  else
-    {
-      data_safed = "[SAFE DISTANCES] LongSafeDist="+std::to_string(m_long_safe_d)+" LatSafeDist="+std::to_string(m_lat_safe_d)+" VertSafeDist="+std::to_string(m_vert_safe_d)+" MinLongDistVeh="+printMinDist(0.0)+" MinLatDistVeh="+printMinDist(0.0)+" MinVertDistVeh="+printMinDist(0.0)+" MinLongDistPed="+printMinDist(0.0)+" MinLatDistPed="+printMinDist(0.0)+" MinVertDistPed="+printMinDist(0.0)+"\n";
+      trace_record.safeDist[0] = m_long_safe_d;
+      trace_record.safeDist[1] = m_lat_safe_d;
+      trace_record.safeDist[2] = m_vert_safe_d;
+      if (m_min_dist.size() != 0)
+        {
+          trace_record.minDistAvailable = 1;
+          trace_record.minDistVeh[0] = m_min_dist[1].longitudinal;
+          trace_record.minDistVeh[1] = m_min_dist[1].lateral;
+          trace_record.minDistVeh[2] = m_min_dist[1].vertical;
+          trace_record.minDistPed[0] = m_min_dist[0].longitudinal;
+          trace_record.minDistPed[1] = m_min_dist[0].lateral;
+          trace_record.minDistPed[2] = m_min_dist[0].vertical;
+        }
     }
   if (!m_min_dist.empty() && !condition_verified && m_min_dist[1].longitudinal < m_long_safe_d && m_min_dist[1].lateral < m_lat_safe_d && m_min_dist[1].vertical < m_vert_safe_d)
     {
@@ -530,7 +538,13 @@ void VRUBasicService::checkVamConditions(){
    * The time elapsed since the last VAM generation is equal to or greater than T_GenVam
   */
   long time_difference = now - lastVamGen;
-  data_time="[TIME] Timestamp="+std::to_string(now)+" LastVAMSent="+std::to_string(lastVamGen)+" TimeThreshold="+std::to_string(m_T_GenVam_ms)+" TimeDiff="+std::to_string(time_difference)+" TimeNextVAM="+std::to_string(m_T_GenVam_ms - time_difference)+"\n";
+  if(trace_enabled)
+    {
+      trace_record.timestamp = now;
+      trace_record.lastVamGen = lastVamGen;
+      trace_record.T_GenVam_ms = m_T_GenVam_ms;
+      trace_record.timeDiff = time_difference;
+    }
   if(!condition_verified && (now-lastVamGen>=m_T_GenVam_ms))
     {
       if(!redundancy_mitigation && (m_N_GenVam_red==0 || m_N_GenVam_red==m_N_GenVam_max_red)){
@@ -552,13 +566,63 @@ void VRUBasicService::checkVamConditions(){
         }
     }
 
-  data_vamredmit = "[REDUNDANCY MITIGATION] numSkipVAMsForRedMitMax="+std::to_string(m_N_GenVam_max_red)+" numSkipVAMsForRedMit="+std::to_string(m_N_GenVam_red)+" TimestampLastVAMGen="+std::to_string(lastVamGen)+" TimeIntervalSinceLastVAMGen="+std::to_string(time_difference)+"\n";
+  if(trace_enabled)
+    {
+      trace_record.simTime = Simulator::Now().GetMilliSeconds();
+      trace_record.stationID = m_station_id;
+      trace_record.sent = condition_verified;
+      trace_record.redundancyMitigation = vamredmit_verified;
+      trace_record.headDiff = head_diff;
+      trace_record.posDiff = pos_diff;
+      trace_record.speedDiff = speed_diff;
+      trace_record.lastVamGenEnd = lastVamGen;
+      trace_record.N_GenVam_red = m_N_GenVam_red;
+      trace_record.N_GenVam_max_red = m_N_GenVam_max_red;
+
+      // Number of VAMs sent for the last verified condition (heading, position, speed, safe distances, time)
+      trace_record.numSent = -1;
+      if(condition_verified && !vamredmit_verified)
+        {
+          if(head_diff > 10.0 || head_diff < -10.0)
+            {
+              trace_record.motivation |= TRIGGER_MOTIVATION_HEADING;
+              trace_record.numSent = m_head_sent;
+            }
+          if(pos_diff > 4.0 || pos_diff < -4.0)
+            {
+              trace_record.motivation |= TRIGGER_MOTIVATION_POSITION;
+              trace_record.numSent = m_pos_sent;
+            }
+          if(speed_diff > 0.5 || speed_diff < -0.5)
+            {
+              trace_record.motivation |= TRIGGER_MOTIVATION_SPEED;
+              trace_record.numSent = m_speed_sent;
+            }
+          if(m_min_dist.size() != 0 &&
+             ((m_min_dist[1].longitudinal < m_long_safe_d && m_min_dist[1].lateral < m_lat_safe_d && m_min_dist[1].vertical < m_vert_safe_d) ||
+              (m_min_dist[0].longitudinal < m_long_safe_d && m_min_dist[0].lateral < m_lat_safe_d && m_min_dist[0].vertical < m_vert_safe_d)))
+            {
+              trace_record.motivation |= TRIGGER_MOTIVATION_SAFE_DISTANCES;
+              trace_record.numSent = m_safedist_sent;
+            }
+          if(abs(time_difference - m_T_GenVam_ms) <= 10 || (m_T_GenVam_ms - time_difference) <= 0)
+            {
+              trace_record.motivation |= TRIGGER_MOTIVATION_TIME;
+              trace_record.numSent = m_time_sent;
+            }
+        }
 
-  int n=0;
-  write_log_triggering (condition_verified, vamredmit_verified, head_diff, pos_diff, speed_diff, time_difference, data_head, data_pos, data_speed, data_safed, data_time, data_vamredmit);
+      if(m_triggerTrace != nullptr)
+        {
+          m_triggerTrace->write (TRIGGER_TRACE_VAM,trace_record);
+        }
+      write_log_triggering (trace_record);
+    }
 
   if((m_VRU_clust_state==VRU_IDLE || m_VRU_clust_state==VRU_ACTIVE_STANDALONE || m_VRU_clust_state==VRU_ACTIVE_CLUSTER_LEADER) && m_VRU_role==VRU_ROLE_ON)
-    m_event_vamCheckConditions = Simulator::Schedule (MilliSeconds(m_T_CheckVamGen_ms), &VRUBasicService::checkVamConditions, this);
+    scheduleNextCheck ();
+  else
+    removeFromScheduler ();
 }
 
 void VRUBasicService::computeLongAcceleration(){
@@ -671,7 +735,8 @@ VRUBasicService_error_t VRUBasicService::generateAndEncodeVam(){
   m_prev_heading = m_VRUdp->getPedHeadingValue ();
 
   /* VAM encoding */
-  std::string encode_result = asn1cpp::uper::encode(vam);
+  std::string &encode_result = m_encodeBuffer;
+  asn1cpp::uper::encode(vam, encode_result);
 
   if(encode_result.size()<1)
   {
@@ -744,6 +809,7 @@ VRUBasicService_error_t VRUBasicService::generateAndEncodeVam(){
 uint64_t VRUBasicService::terminateDissemination(){
   Simulator::Remove(m_event_vamCheckConditions);
   Simulator::Remove(m_event_vamDisseminationStart);
+  removeFromScheduler ();
   Simulator::Remove(m_event_computeLongAcceleration);
 
   return m_vam_sent;
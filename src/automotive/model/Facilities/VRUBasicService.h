@@ -14,6 +14,9 @@
 #include "ns3/Seq.hpp"
 #include "ns3/Getter.hpp"
 #include "ns3/LDM.h"
+#include "triggerTrace.h"
+#include "triggerConditionScheduler.h"
+#include <memory>
 
 extern "C" {
   #include "ns3/VAM.h"
@@ -93,6 +96,20 @@ public:
      */
     void setCheckVamGenMs(long nextVAM) {m_T_CheckVamGen_ms = nextVAM;};
 
+    /**
+     * @brief Delegate the periodic checks of the VAM triggering conditions to the simulation-wide TriggerConditionScheduler
+     *
+     * This must be called before starting the VAM dissemination. It has no effect in real time mode. The checks are
+     * anyway performed by the service itself whenever the LDM contains other road users (for the safe distances
+     * and the redundancy mitigation).
+     * @param enable  If true, the conditions are checked by the TriggerConditionScheduler
+     */
+    void setCentralConditionCheck(bool enable) {m_centralConditionCheck = enable;}
+
+    /* Used by the TriggerConditionScheduler */
+    void fillConditionSnapshot(TriggerConditionSnapshot_t &snapshot, size_t i);
+    void scheduleConditionCheck(Time delay);
+
     /**
      * @brief Used for DCC Adaptive approach to set the future time to check VAM condition after an update of delta value
      * @param delta new delta value calculated through DCC adaptive approach
@@ -106,8 +123,12 @@ public:
     void toffUpdateAfterTransmission();
 
     void SetLogTriggering(bool log, std::string log_filename) {m_log_triggering = log; m_log_filename = log_filename;};
+    /**
+     * @brief Set the binary trace of the VAM triggering conditions (the same trace can be shared by all the Basic Services of a simulation)
+     */
+    void SetTriggerTrace(std::shared_ptr<TriggerTrace> trace) {m_triggerTrace = trace;}
 
-    void write_log_triggering(bool condition_verified, bool vamredmit_verified, float head_diff, float pos_diff, float speed_diff, long time_difference, std::string data_head, std::string data_pos, std::string data_speed, std::string data_safed, std::string data_time, std::string data_vamredmit);
+    void write_log_triggering(const VAMTriggerRecord_t &record);
 
     std::string printMinDist(double minDist) {
       return ((minDist>-DBL_MAX && minDist<MAXFLOAT) ? std::to_string(minDist) : "unavailable");
@@ -120,7 +141,7 @@ private:
     VRUBasicService_error_t generateAndEncodeVam();
     void computeLongAcceleration();
     int64_t computeTimestampUInt64();
-    void vLDM_handler(asn1cpp::Seq<VAM> decodedVAM);
+    void vLDM_handler(const asn1cpp::Seq<VAM> &decodedVAM);
 
     std::function<void(asn1cpp::Seq<VAM>, Address)> m_VAMReceiveCallback;
     std::function<void(asn1cpp::Seq<VAM>, Address, StationID_t, StationType_t)> m_VAMReceiveCallbackExtended;
@@ -139,6 +160,8 @@ private:
     int16_t m_N_GenVam_max_red;
     
     StationID_t m_station_id;
+    std::string m_encodeBuffer; //! Buffer reused to encode every VAM, to avoid allocating a new one each time
+    std::vector<uint8_t> m_rxBuffer; //! Buffer reused to receive a VAM, when no view on the GeoNetworking receive buffer is available (see btp::getPayloadView())
     StationType_t m_stationtype;
 
     bool m_real_time;
@@ -196,6 +219,12 @@ private:
 
     bool m_log_triggering = false;
     std::string m_log_filename;
+    std::shared_ptr<TriggerTrace> m_triggerTrace;
+
+    bool m_centralConditionCheck = false; //! Checks of the VAM conditions delegated to the TriggerConditionScheduler
+    uint32_t m_schedulerSlot = UINT32_MAX; //! Slot in the TriggerConditionScheduler, if registered
+    void scheduleNextCheck();
+    void removeFromScheduler();
 
     // Statistics: number of VAMs sent per triggering conditions
     uint64_t m_pos_sent = 0;
@@ -52,7 +52,7 @@ namespace ns3
     double gen_interval = ((double) (now - m_prev_gen_time))/(NANO_TO_CENTI*CENTI);
 
     /* Speed [0.01 m/s] */
-    VAMdata.speed = VRUdpValueConfidence<>(m_traci_client->TraCIAPI::person.getSpeed (m_id)*CENTI,
+    VAMdata.speed = VRUdpValueConfidence<>(getPedSpeedValue ()*CENTI,
                                        SpeedConfidence_unavailable);
 
     /* Longitudinal acceleration [0.1 m/s^2] */
@@ -71,8 +71,8 @@ namespace ns3
       VAMdata.longAcceleration = VRUdpValueConfidence<>(LongitudinalAccelerationValue_unavailable,AccelerationConfidence_unavailable);
 
     /* Position */
-    libsumo::TraCIPosition pos=m_traci_client->TraCIAPI::person.getPosition(m_id);
-    pos=m_traci_client->TraCIAPI::simulation.convertXYtoLonLat (pos.x,pos.y);
+    libsumo::TraCIPosition pos=getPedPositionValue ();
+    pos=m_traci_client->ConvertXYtoLonLat (pos.x,pos.y);
 
     // longitude WGS84 [0,1 microdegree]
     VAMdata.longitude=(Longitude_t)(pos.x*DOT_ONE_MICRO);
@@ -89,7 +89,7 @@ namespace ns3
     VAMdata.posConfidenceEllipse.semiMajorOrientation=HeadingValue_unavailable;
 
     /* Heading WGS84 north [0.1 degree] */
-    VAMdata.heading = VRUdpValueConfidence<>(m_traci_client->TraCIAPI::person.getAngle (m_id) * DECI,
+    VAMdata.heading = VRUdpValueConfidence<>(getPedHeadingValue () * DECI,
                                          HeadingConfidence_unavailable);
 
     return VAMdata;
@@ -98,8 +98,8 @@ namespace ns3
   VRUdp_position_latlon_t VRUdp::getPedPosition(){
     VRUdp_position_latlon_t vrudppos;
 
-    libsumo::TraCIPosition pos=m_traci_client->TraCIAPI::person.getPosition(m_id);
-    pos=m_traci_client->TraCIAPI::simulation.convertXYtoLonLat (pos.x,pos.y);
+    libsumo::TraCIPosition pos=getPedPositionValue ();
+    pos=m_traci_client->ConvertXYtoLonLat (pos.x,pos.y);
 
     vrudppos.lat=pos.y;
     vrudppos.lon=pos.x;
@@ -112,7 +112,7 @@ namespace ns3
     VRUdpValueConfidence <> longAcceleration;
 
     int64_t now = computeTimestampUInt64 ();
-    double speed = m_traci_client->TraCIAPI::person.getSpeed (m_id)*CENTI;
+    double speed = getPedSpeedValue ()*CENTI;
 
     m_compute_acceleration = false;
 
@@ -137,8 +137,8 @@ namespace ns3
     std::vector<LDM::returnedVehicleData_t> selectedStations;
 
     // Get position and heading of the current pedestrian
-    libsumo::TraCIPosition pos_ped = m_traci_client->TraCIAPI::person.getPosition(m_id);
-    double ped_heading = m_traci_client->TraCIAPI::person.getAngle(m_id);
+    libsumo::TraCIPosition pos_ped = getPedPositionValue ();
+    double ped_heading = getPedHeadingValue ();
     ped_heading += (ped_heading>180.0) ? -360.0 : (ped_heading<-180.0) ? 360.0 : 0.0;
 
     // Extract all stations from the LDM
@@ -153,7 +153,7 @@ namespace ns3
 
         pos_node.x = it->vehData.lon;
         pos_node.y = it->vehData.lat;
-        pos_node = m_traci_client->TraCIAPI::simulation.convertLonLattoXY (pos_node.x,pos_node.y);
+        pos_node = m_traci_client->ConvertLonLattoXY (pos_node.x,pos_node.y);
         pos_node.z = it->vehData.elevation;
 
         // Computation of the distances
@@ -198,7 +198,7 @@ namespace ns3
     VRUDP_position_cartesian_t vdppos;
 
     libsumo::TraCIPosition pos;
-    pos=m_traci_client->TraCIAPI::simulation.convertLonLattoXY (lon,lat);
+    pos=m_traci_client->ConvertLonLattoXY (lon,lat);
 
     vdppos.x=pos.x;
     vdppos.y=pos.y;
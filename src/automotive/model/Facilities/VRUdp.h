@@ -76,9 +76,11 @@ namespace ns3
     virtual VAM_mandatory_data_t getVAMMandatoryData();
 
     virtual VRUdp_position_latlon_t getPedPosition();
-    virtual double getPedSpeedValue() {return m_traci_client->TraCIAPI::person.getSpeed (m_id);}
-    virtual double getPedHeadingValue() {return m_traci_client->TraCIAPI::person.getAngle (m_id);}
-    virtual libsumo::TraCIPosition getPedPositionValue() {return m_traci_client->TraCIAPI::person.getPosition (m_id);}
+    // The kinematic values are taken from the variable subscription results received by the TraCI client with each
+    // SUMO simulation step (see TraciClient::GetStationKinematics()), and requested to SUMO only when not available
+    virtual double getPedSpeedValue() {const TraciClient::StationKinematics_t *k = m_traci_client->GetStationKinematics (m_id); return k != nullptr ? k->speed : m_traci_client->TraCIAPI::person.getSpeed (m_id);}
+    virtual double getPedHeadingValue() {const TraciClient::StationKinematics_t *k = m_traci_client->GetStationKinematics (m_id); return k != nullptr ? k->angle : m_traci_client->TraCIAPI::person.getAngle (m_id);}
+    virtual libsumo::TraCIPosition getPedPositionValue() {const TraciClient::StationKinematics_t *k = m_traci_client->GetStationKinematics (m_id); return k != nullptr ? k->position : m_traci_client->TraCIAPI::person.getPosition (m_id);}
 
     VRUdpValueConfidence<> getLongAcceleration();
 
@@ -0,0 +1,177 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef ACTIONIDTABLE_H
+#define ACTIONIDTABLE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <utility>
+#include "ns3/asn_utils.h"
+
+namespace ns3
+{
+  /**
+   * \ingroup automotive
+   * \brief Hash table of DENM entries, keyed by ActionID
+   *
+   * The ActionID (32-bit originating Station ID and 16-bit sequence number) is packed into a single 64-bit key.
+   * The entries are stored contiguously, in a dense vector (an erased entry is replaced by the last one), and they
+   * are indexed by an open-addressing hash table with linear probing and backward-shift deletion, so that no memory
+   * is allocated per entry and the whole table can be walked without chasing pointers.
+   *
+   * Warning: inserting or erasing an entry may move the other entries, so pointers returned by find() and
+   * references returned by operator[] are valid only until the next insertion or erasure.
+   */
+  template <typename T>
+  class ActionIDTable
+  {
+  public:
+    typedef std::pair<uint64_t,T> value_type;
+    typedef typename std::vector<value_type>::iterator iterator;
+
+    static uint64_t packActionID(const DEN_ActionID_t &actionID)
+    {
+      return ((uint64_t) (actionID.originatingStationID & 0xFFFFFFFF) << 16) | (actionID.sequenceNumber & 0xFFFF);
+    }
+
+    static DEN_ActionID_t unpackActionID(uint64_t key)
+    {
+      DEN_ActionID_t actionID;
+      actionID.originatingStationID = (unsigned long) (key >> 16);
+      actionID.sequenceNumber = (long) (key & 0xFFFF);
+      return actionID;
+    }
+
+    T *find(uint64_t key)
+    {
+      if(m_entries.empty ())
+        {
+          return nullptr;
+        }
+      const Slot &slot = m_slots[findSlot (key)];
+      return slot.index == EMPTY ? nullptr : &m_entries[slot.index].second;
+    }
+
+    /**
+     * @brief Get the entry with the given key, inserting a default-constructed one if it does not exist.
+     */
+    T &operator[](uint64_t key)
+    {
+      if((m_entries.size () + 1) * 2 > m_slots.size ())
+        {
+          rehash (m_slots.empty () ? 16 : m_slots.size () * 2);
+        }
+
+      Slot &slot = m_slots[findSlot (key)];
+      if(slot.index == EMPTY)
+        {
+          slot.key = key;
+          slot.index = m_entries.size ();
+          m_entries.emplace_back (key,T());
+        }
+      return m_entries[slot.index].second;
+    }
+
+    bool erase(uint64_t key)
+    {
+      if(m_entries.empty ())
+        {
+          return false;
+        }
+
+      size_t i = findSlot (key);
+      if(m_slots[i].index == EMPTY)
+        {
+          return false;
+        }
+
+      // Fill the hole in the dense vector with the last entry
+      uint32_t index = m_slots[i].index;
+      if(index != m_entries.size () - 1)
+        {
+          m_entries[index] = std::move (m_entries.back ());
+          m_slots[findSlot (m_entries[index].first)].index = index;
+        }
+      m_entries.pop_back ();
+
+      // Backward-shift deletion: move back the following entries of the probe sequence, so that no tombstone is needed
+      size_t mask = m_slots.size () - 1;
+      m_slots[i].index = EMPTY;
+      for(size_t j = (i + 1) & mask; m_slots[j].index != EMPTY; j = (j + 1) & mask)
+        {
+          size_t home = hash (m_slots[j].key);
+          if(((j - home) & mask) >= ((j - i) & mask))
+            {
+              m_slots[i] = m_slots[j];
+              m_slots[j].index = EMPTY;
+              i = j;
+            }
+        }
+      return true;
+    }
+
+    void clear() {m_slots.clear (); m_entries.clear ();}
+    size_t size() const {return m_entries.size ();}
+    bool empty() const {return m_entries.empty ();}
+
+    iterator begin() {return m_entries.begin ();}
+    iterator end() {return m_entries.end ();}
+
+  private:
+    static const uint32_t EMPTY = UINT32_MAX;
+
+    typedef struct _slot {
+      uint64_t key;
+      uint32_t index; //! Position of the entry in m_entries, or EMPTY
+    } Slot;
+
+    size_t hash(uint64_t key) const
+    {
+      // Fibonacci hashing: the consecutive sequence numbers of the same station are spread over the whole table
+      return (size_t) ((key * UINT64_C(0x9E3779B97F4A7C15)) >> 32) & (m_slots.size () - 1);
+    }
+
+    // Return the slot containing the key, or the first empty slot of its probe sequence (the table is never full)
+    size_t findSlot(uint64_t key) const
+    {
+      size_t mask = m_slots.size () - 1;
+      size_t i = hash (key);
+      while(m_slots[i].index != EMPTY && m_slots[i].key != key)
+        {
+          i = (i + 1) & mask;
+        }
+      return i;
+    }
+
+    void rehash(size_t capacity)
+    {
+      m_slots.assign (capacity,Slot {0,EMPTY});
+      for(uint32_t index = 0; index < m_entries.size (); index++)
+        {
+          Slot &slot = m_slots[findSlot (m_entries[index].first)];
+          slot.key = m_entries[index].first;
+          slot.index = index;
+        }
+    }
+
+    std::vector<Slot> m_slots; //! Open-addressing index, with a power of two size and a load factor of at most 1/2
+    std::vector<value_type> m_entries; //! Dense storage of the entries
+  };
+}
+
+#endif // ACTIONIDTABLE_H
@@ -36,12 +36,17 @@
 #include "ns3/timestamp-tag.h"
 #include "ns3/rsrp-tag.h"
 #include "ns3/size-tag.h"
+#include "ns3/decodedMessageCache.h"
 
 namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE("CABasicService");
 
   CABasicService::~CABasicService() {
+    if(m_schedulerSlot!=UINT32_MAX)
+      {
+        TriggerConditionScheduler<CABasicService>::Get ().RemoveStation (m_schedulerSlot,this);
+      }
     NS_LOG_INFO("CABasicService object destroyed.");
   }
 
@@ -132,89 +137,32 @@ namespace ns3
     m_vehicle=is_vehicle;
   }
 
-  void CABasicService::write_log_triggering(bool condition_verified, float head_diff, float pos_diff, float speed_diff, long time_difference, std::string data_head, std::string data_pos, std::string data_speed, std::string data_time)
+  void CABasicService::write_log_triggering(const CAMTriggerRecord_t &record)
   {
     if (m_log_triggering && m_log_filename != "")
       {
         std::string data = "";
         std::string sent = "false";
-        std::string motivation;
-        std::string joint = "";
-        int numConditions = 0;
-        motivation = "";
-
-        long time = Simulator::Now().GetMilliSeconds();
+        std::string motivation = "none";
 
         // Check the motivation of the CAM sent
-        if (!condition_verified)
-          {
-            motivation = "none";
-          }
-        else
+        if (record.sent)
           {
             data = "[CAM] CAM sent\n";
             sent = "true";
-
-            if (head_diff > 4.0 || head_diff < -4.0)
-              {
-                motivation = "heading";
-                joint = joint + "H";
-                numConditions++;
-              }
-
-            if ((pos_diff > 4.0 || pos_diff < -4.0))
-              {
-                motivation = "position";
-                joint = joint + "P";
-                numConditions++;
-              }
-
-            if (speed_diff > 0.5 || speed_diff < -0.5)
-              {
-                motivation = "speed";
-                joint = joint + "S";
-                numConditions++;
-              }
-
-            if (abs (time_difference - m_T_GenCam_ms) <= 10 ||
-                (m_T_GenCam_ms - time_difference) <= 0)
-              {
-                motivation = "time";
-                joint = joint + "T";
-                numConditions++;
-              }
-
-            // When joint with a single other motivation, the joint motivation should not be considered
-            if (numConditions > 1)
-              {
-                motivation = "joint(" + joint + ")";
-                if (joint == "HT")
-                  {
-                    motivation = "heading";
-                  }
-                if (joint == "PT")
-                  {
-                    motivation = "position";
-                  }
-                if (joint == "ST")
-                  {
-                    motivation = "speed";
-                  }
-              }
-
-            if (condition_verified && motivation.empty ())
-              {
-                motivation = "numPkt";
-              }
+            motivation = TriggerTrace::motivationString (record.motivation);
           }
 
         // Create the data for the log print
-        data += "[LOG] Timestamp=" + std::to_string (time) + " CAMSend=" + sent +
-                " Motivation=" + motivation + " HeadDiff=" + std::to_string (head_diff) +
-                " PosDiff=" + std::to_string (pos_diff) +
-                " SpeedDiff=" + std::to_string (speed_diff) +
-                " TimeDiff=" + std::to_string (time_difference) + "\n";
-        data = data + data_head + data_pos + data_speed + data_time;
+        data += "[LOG] Timestamp=" + std::to_string (record.simTime) + " CAMSend=" + sent +
+                " Motivation=" + motivation + " HeadDiff=" + std::to_string ((float) record.headDiff) +
+                " PosDiff=" + std::to_string ((float) record.posDiff) +
+                " SpeedDiff=" + std::to_string ((float) record.speedDiff) +
+                " TimeDiff=" + std::to_string (record.timeDiff) + "\n";
+        data += "[HEADING] HeadingUnavailable="+std::to_string((float)HeadingValue_unavailable/10)+" PrevHead="+std::to_string(record.prevHeading/10)+" CurrHead="+std::to_string(record.currHeading)+" HeadDiff="+std::to_string(record.headDiff)+"\n";
+        data += "[DISTANCE] PrevLat="+std::to_string(record.prevLat)+" PrevLon="+std::to_string(record.prevLon)+" CurrLat="+std::to_string(record.currLat)+" CurrLon="+std::to_string(record.currLon)+" PosDiff="+std::to_string(record.posDiff)+"\n";
+        data += "[SPEED] SpeedUnavailable="+std::to_string((float)SpeedValue_unavailable)+" PrevSpeed="+std::to_string(record.prevSpeed)+" CurrSpeed="+std::to_string(record.currSpeed)+" SpeedDiff="+std::to_string(record.speedDiff)+"\n";
+        data += "[TIME] Timestamp="+std::to_string(record.timestamp)+" LastCAMSend="+std::to_string(record.lastCamGen)+" NumThreshold="+std::to_string(record.N_GenCamMax)+" NumCAM="+std::to_string(record.N_GenCam)+" TimeThreshold="+std::to_string(record.T_GenCam_ms)+" TimeDiff="+std::to_string(record.timeDiff)+" TimeNextCAM="+std::to_string(record.T_GenCam_ms - record.timeDiff)+"\n";
 
         data = data + "\n";
 
@@ -250,7 +198,7 @@ namespace ns3
     asn1cpp::setField(protectedComm->protectedZoneType,ProtectedZoneType_permanentCenDsrcTolling);
     asn1cpp::setField(protectedComm->protectedZoneLatitude,Latitude_unavailable);
     asn1cpp::setField(protectedComm->protectedZoneLongitude,Longitude_unavailable);
-    asn1cpp::sequenceof::pushList(m_protectedCommunicationsZonesRSU->protectedCommunicationZonesRSU,protectedComm);
+    asn1cpp::sequenceof::pushList(m_protectedCommunicationsZonesRSU->protectedCommunicationZonesRSU,std::move(protectedComm));
     m_btp->setFixedPositionRSU(latitude_deg,longitude_deg);
   }
 
@@ -305,12 +253,9 @@ namespace ns3
   CABasicService::receiveCam (BTPDataIndication_t dataIndication, Address from)
   {
     Ptr<Packet> packet;
-    asn1cpp::Seq<CAM> decoded_cam;
 
-    uint8_t *buffer; //= new uint8_t[packet->GetSize ()];
-    buffer=(uint8_t *)malloc((dataIndication.data->GetSize ())*sizeof(uint8_t));
-    dataIndication.data->CopyData (buffer, dataIndication.data->GetSize ());
-    std::string packetContent((char *)buffer,(int) dataIndication.data->GetSize ());
+    const uint8_t *buffer = btp::getPayloadView (dataIndication, m_rxBuffer);
+    uint32_t bufferSize = dataIndication.data->GetSize ();
 
     RssiTag rssi;
     bool rssi_result = dataIndication.data->PeekPacketTag(rssi);
@@ -357,20 +302,33 @@ namespace ns3
     if (buffer[1]!=FIX_CAMID)
       {
         NS_LOG_ERROR("Warning: received a message which has messageID '"<<buffer[1]<<"' but '2' was expected.");
-        free(buffer);
         return;
       }
 
-    free(buffer);
+    /* If the CAM is only needed to update the LDM, just decode the LDM fields, when it has the common vehicle layout */
+    if(m_fastCamCodec && m_CAReceiveCallback==nullptr && m_CAReceiveCallbackExtended==nullptr)
+      {
+        CAMFastCodec::LDMFields_t fields;
+
+        if(CAMFastCodec::decodeLDMFields (buffer, bufferSize, fields))
+          {
+            if(m_LDM != NULL){
+              vLDM_handler(fields);
+            }
+            return;
+          }
+      }
 
     /** Decoding **/
-    decoded_cam = asn1cpp::uper::decodeASN(packetContent, CAM);
+    DecodedMessageCache<CAM>::DecodedPtr_t decoded_cam_ptr = DecodedMessageCache<CAM>::Get ().Decode (buffer, bufferSize, &asn_DEF_CAM);
 
-    if(bool(decoded_cam)==false) {
+    if(decoded_cam_ptr==nullptr) {
         NS_LOG_ERROR("Warning: unable to decode a received CAM.");
         return;
       }
 
+    const asn1cpp::Seq<CAM> &decoded_cam = *decoded_cam_ptr;
+
     if(m_LDM != NULL){
       //Update LDM
       vLDM_handler(decoded_cam);
@@ -385,10 +343,9 @@ namespace ns3
   }
 
   void
-  CABasicService::vLDM_handler(asn1cpp::Seq<CAM> decodedCAM)
+  CABasicService::vLDM_handler(const asn1cpp::Seq<CAM> &decodedCAM)
   {
       vehicleData_t vehdata;
-      LDM::LDM_error_t db_retval;
       bool lowFreq_ok;
       vehdata.detected = false;
       vehdata.stationType = asn1cpp::getField(decodedCAM->cam.camParameters.basicContainer.stationType,long);
@@ -410,7 +367,42 @@ namespace ns3
       {
           vehdata.exteriorLights = OptionalDataItem<uint8_t>(asn1cpp::bitstring::getterByteMask(lowFreqContainer->choice.basicVehicleContainerLowFrequency.exteriorLights,0));
       }
-      else
+
+      vLDM_insert(vehdata,lowFreq_ok);
+  }
+
+  void
+  CABasicService::vLDM_handler(const CAMFastCodec::LDMFields_t &fields)
+  {
+      vehicleData_t vehdata;
+      vehdata.detected = false;
+      vehdata.stationType = fields.stationType;
+      vehdata.stationID = fields.stationId;
+      vehdata.lat = (double)fields.latitude/(double)DOT_ONE_MICRO;
+      vehdata.lon = (double)fields.longitude/(double)DOT_ONE_MICRO;
+      vehdata.elevation = (double)fields.altitudeValue/(double)CENTI;
+      vehdata.heading = (double)fields.headingValue/(double)DECI;
+      vehdata.speed_ms = (double)fields.speedValue/(double)CENTI;
+      vehdata.camTimestamp = fields.generationDeltaTime;
+      vehdata.timestamp_us = Simulator::Now ().GetMicroSeconds ();
+
+      vehdata.vehicleWidth = OptionalDataItem<long>(fields.vehicleWidth);
+      vehdata.vehicleLength = OptionalDataItem<long>(fields.vehicleLengthValue);
+
+      if(fields.lowFrequencyContainerPresent)
+      {
+          vehdata.exteriorLights = OptionalDataItem<uint8_t>(fields.exteriorLights);
+      }
+
+      vLDM_insert(vehdata,fields.lowFrequencyContainerPresent);
+  }
+
+  void
+  CABasicService::vLDM_insert(vehicleData_t &vehdata, bool lowFreq_ok)
+  {
+      LDM::LDM_error_t db_retval;
+
+      if(!lowFreq_ok)
       {
           LDM::returnedVehicleData_t retveh;
 
@@ -424,7 +416,7 @@ namespace ns3
 
       db_retval=m_LDM->insert(vehdata);
       if(db_retval!=LDM::LDM_OK && db_retval!=LDM::LDM_UPDATED) {
-          std::cerr << "Warning! Insert on the database for vehicle " << asn1cpp::getField(decodedCAM->header.stationId,int) << "failed!" << std::endl;
+          std::cerr << "Warning! Insert on the database for vehicle " << (int) vehdata.stationID << "failed!" << std::endl;
       }
   }
 
@@ -432,7 +424,48 @@ namespace ns3
   CABasicService::initDissemination()
   {
     generateAndEncodeCam();
-    m_event_camCheckConditions = Simulator::Schedule (MilliSeconds(m_T_CheckCamGen_ms), &CABasicService::checkCamConditions, this);
+    scheduleNextCheck ();
+  }
+
+  void
+  CABasicService::scheduleNextCheck()
+  {
+    Time next_check = Simulator::Now () + MilliSeconds(m_T_CheckCamGen_ms);
+
+    if(m_schedulerSlot!=UINT32_MAX)
+      {
+        TriggerConditionScheduler<CABasicService>::Get ().SetNextCheck (m_schedulerSlot,next_check);
+      }
+    else if(m_centralConditionCheck && !m_real_time)
+      {
+        m_schedulerSlot = TriggerConditionScheduler<CABasicService>::Get ().AddStation (this,next_check);
+      }
+    else
+      {
+        m_event_camCheckConditions = Simulator::Schedule (MilliSeconds(m_T_CheckCamGen_ms), &CABasicService::checkCamConditions, this);
+      }
+  }
+
+  void
+  CABasicService::scheduleConditionCheck(Time delay)
+  {
+    m_event_camCheckConditions = Simulator::Schedule (delay, &CABasicService::checkCamConditions, this);
+  }
+
+  void
+  CABasicService::fillConditionSnapshot(TriggerConditionSnapshot_t &snapshot, size_t i)
+  {
+    snapshot.heading[i] = m_vdp->getHeadingValue ();
+    snapshot.prevHeading[i] = m_prev_heading;
+    snapshot.headingThreshold[i] = 4.0;
+    snapshot.posDiff[i] = m_vdp->getTravelledDistance () - m_prev_distance;
+    snapshot.speed[i] = m_vdp->getSpeedValue ();
+    snapshot.prevSpeed[i] = m_prev_speed;
+    snapshot.lastGen[i] = lastCamGen;
+    snapshot.T_Gen[i] = m_T_GenCam_ms;
+    snapshot.checkPeriod[i] = MilliSeconds(m_T_CheckCamGen_ms).GetNanoSeconds ();
+    // When the checks are traced, every check must be performed (and traced) by the service
+    snapshot.force[i] = FACILITIES_TRACE_ENABLED(m_triggerTrace != nullptr || m_log_triggering);
   }
 
   void
@@ -450,10 +483,13 @@ namespace ns3
     bool condition_verified=false;
     static bool dyn_cond_verified=false;
 
-    std::string data_head;
-    std::string data_pos;
-    std::string data_speed;
-    std::string data_time;
+    // The trace record is filled only when someone is going to read it
+    bool trace_enabled = FACILITIES_TRACE_ENABLED(m_triggerTrace != nullptr || m_log_triggering);
+    CAMTriggerRecord_t trace_record;
+    if(trace_enabled)
+      {
+        memset(&trace_record,0,sizeof(trace_record));
+      }
 
     // If no initial CAM has been triggered before checkCamConditions() has been called, throw an error
     if(m_prev_heading==-1 || m_prev_speed==-1 || m_prev_distance==-1)
@@ -472,7 +508,11 @@ namespace ns3
     */
     double head_diff = m_vdp->getHeadingValue () - m_prev_heading;
     head_diff += (head_diff>180.0) ? -360.0 : (head_diff<-180.0) ? 360.0 : 0.0;
-    data_head="[HEADING] HeadingUnavailable="+std::to_string((float)HeadingValue_unavailable/10)+" PrevHead="+std::to_string(m_prev_heading/10)+" CurrHead="+std::to_string(m_vdp->getHeadingValue ())+" HeadDiff="+std::to_string(head_diff)+"\n";
+    if(trace_enabled)
+      {
+        trace_record.prevHeading = m_prev_heading;
+        trace_record.currHeading = m_vdp->getHeadingValue ();
+      }
     if (head_diff > 4.0 || head_diff < -4.0)
       {
         cam_error=generateAndEncodeCam ();
@@ -492,7 +532,14 @@ namespace ns3
      * ITS-S exceeds 4 m;
     */
     double pos_diff = m_vdp->getTravelledDistance () - m_prev_distance;
-    data_pos="[DISTANCE] PrevLat="+std::to_string(m_prev_position.lat)+" PrevLon="+std::to_string(m_prev_position.lon)+" CurrLat="+std::to_string(m_vdp->getPosition().lat)+" CurrLon="+std::to_string(m_vdp->getPosition().lon)+" PosDiff="+std::to_string(pos_diff)+"\n";
+    if(trace_enabled)
+      {
+        VDP::VDP_position_latlon_t curr_position = m_vdp->getPosition();
+        trace_record.prevLat = m_prev_position.lat;
+        trace_record.prevLon = m_prev_position.lon;
+        trace_record.currLat = curr_position.lat;
+        trace_record.currLon = curr_position.lon;
+      }
     if (!condition_verified && (pos_diff > 4.0 || pos_diff < -4.0))
       {
         cam_error=generateAndEncodeCam ();
@@ -512,7 +559,11 @@ namespace ns3
      * ITS-S exceeds 0,5 m/s.
     */
     double speed_diff = m_vdp->getSpeedValue () - m_prev_speed;
-    data_speed="[SPEED] SpeedUnavailable="+std::to_string((float)SpeedValue_unavailable)+" PrevSpeed="+std::to_string(m_prev_speed)+" CurrSpeed="+std::to_string(m_vdp->getSpeedValue ())+" SpeedDiff="+std::to_string(speed_diff)+"\n";
+    if(trace_enabled)
+      {
+        trace_record.prevSpeed = m_prev_speed;
+        trace_record.currSpeed = m_vdp->getSpeedValue ();
+      }
     if (!condition_verified && (speed_diff > 0.5 || speed_diff < -0.5))
       {
         cam_error=generateAndEncodeCam ();
@@ -530,7 +581,15 @@ namespace ns3
      * The time elapsed since the last CAM generation is equal to or greater than T_GenCam
     */
     long time_difference = now - lastCamGen;
-    data_time="[TIME] Timestamp="+std::to_string(now)+" LastCAMSend="+std::to_string(lastCamGen)+" NumThreshold="+std::to_string(m_N_GenCamMax)+" NumCAM="+std::to_string(m_N_GenCam)+" TimeThreshold="+std::to_string(m_T_GenCam_ms)+" TimeDiff="+std::to_string(time_difference)+" TimeNextCAM="+std::to_string(m_T_GenCam_ms - time_difference)+"\n";
+    if(trace_enabled)
+      {
+        trace_record.timestamp = now;
+        trace_record.lastCamGen = lastCamGen;
+        trace_record.N_GenCamMax = m_N_GenCamMax;
+        trace_record.N_GenCam = m_N_GenCam;
+        trace_record.T_GenCam_ms = m_T_GenCam_ms;
+        trace_record.timeDiff = time_difference;
+      }
     if(!condition_verified && (now-lastCamGen>=m_T_GenCam_ms))
       {
          cam_error=generateAndEncodeCam ();
@@ -552,9 +611,36 @@ namespace ns3
            }
       }
 
-    write_log_triggering (condition_verified, head_diff, pos_diff, speed_diff, time_difference, data_head, data_pos, data_speed, data_time);
+    if(trace_enabled)
+      {
+        trace_record.simTime = Simulator::Now().GetMilliSeconds();
+        trace_record.stationID = m_station_id;
+        trace_record.sent = condition_verified;
+        trace_record.headDiff = head_diff;
+        trace_record.posDiff = pos_diff;
+        trace_record.speedDiff = speed_diff;
+
+        trace_record.motivation = 0;
+        if(condition_verified)
+          {
+            if (head_diff > 4.0 || head_diff < -4.0)
+              trace_record.motivation |= TRIGGER_MOTIVATION_HEADING;
+            if (pos_diff > 4.0 || pos_diff < -4.0)
+              trace_record.motivation |= TRIGGER_MOTIVATION_POSITION;
+            if (speed_diff > 0.5 || speed_diff < -0.5)
+              trace_record.motivation |= TRIGGER_MOTIVATION_SPEED;
+            if (abs (time_difference - m_T_GenCam_ms) <= 10 || (m_T_GenCam_ms - time_difference) <= 0)
+              trace_record.motivation |= TRIGGER_MOTIVATION_TIME;
+          }
+
+        if(m_triggerTrace != nullptr)
+          {
+            m_triggerTrace->write (TRIGGER_TRACE_CAM,trace_record);
+          }
+        write_log_triggering (trace_record);
+      }
 
-    m_event_camCheckConditions = Simulator::Schedule (MilliSeconds(m_T_CheckCamGen_ms), &CABasicService::checkCamConditions, this);
+    scheduleNextCheck ();
   }
 
   CABasicService_error_t
@@ -630,6 +716,8 @@ namespace ns3
         auto accControl = m_vdp->getAccelerationControl ();
         if(accControl.isAvailable ()) {
             asn1cpp::bitstring::setBit(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.accelerationControl,setByteMask(accControl.getData ()),0);
+            // AccelerationControl is a BIT STRING (SIZE(7)): without this, the CAM could never use the fast codec
+            cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.accelerationControl->bits_unused = 1;
         }
 
         auto lanePosition = m_vdp->getLanePosition ();
@@ -642,7 +730,7 @@ namespace ns3
             auto swa_seq = asn1cpp::makeSeq(SteeringWheelAngle);
             asn1cpp::setField(swa_seq->steeringWheelAngleValue,swa.getData ().getValue ());
             asn1cpp::setField(swa_seq->steeringWheelAngleConfidence,swa.getData ().getConfidence ());
-            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.steeringWheelAngle,swa_seq);
+            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.steeringWheelAngle,std::move(swa_seq));
         }
 
         auto latacc = m_vdp->getLateralAcceleration();
@@ -650,7 +738,7 @@ namespace ns3
             auto latacc_seq = asn1cpp::makeSeq(AccelerationComponent);
             asn1cpp::setField(latacc_seq->value,latacc.getData ().getValue ());
             asn1cpp::setField(latacc_seq->confidence,latacc.getData ().getConfidence ());
-            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.lateralAcceleration,latacc_seq);
+            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.lateralAcceleration,std::move(latacc_seq));
         }
 
 
@@ -659,7 +747,7 @@ namespace ns3
             auto vertacc_seq = asn1cpp::makeSeq(AccelerationComponent);
             asn1cpp::setField(vertacc_seq->value,vertacc.getData ().getValue ());
             asn1cpp::setField(vertacc_seq->confidence,vertacc.getData ().getConfidence ());
-            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.verticalAcceleration,vertacc_seq);
+            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.verticalAcceleration,std::move(vertacc_seq));
         }
 
         auto perfClass = m_vdp->getPerformanceClass();
@@ -673,7 +761,7 @@ namespace ns3
             asn1cpp::setField(tollZone_seq->cenDsrcTollingZoneId,tollZone.getData ().cenDsrcTollingZoneID);
             asn1cpp::setField(tollZone_seq->protectedZoneLatitude,tollZone.getData ().latitude);
             asn1cpp::setField(tollZone_seq->protectedZoneLongitude,tollZone.getData ().longitude);
-            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.cenDsrcTollingZone,tollZone_seq);
+            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.cenDsrcTollingZone,std::move(tollZone_seq));
         }
 
         // Store all the "previous" values used in checkCamConditions()
@@ -709,7 +797,7 @@ namespace ns3
         asn1cpp::setField(protectedComm->protectedZoneLatitude,Latitude_unavailable);
         asn1cpp::setField(protectedComm->protectedZoneLongitude,Longitude_unavailable);
 
-        asn1cpp::sequenceof::pushList(cam->cam.camParameters.highFrequencyContainer.choice.rsuContainerHighFrequency.protectedCommunicationZonesRSU,protectedComm);
+        asn1cpp::sequenceof::pushList(cam->cam.camParameters.highFrequencyContainer.choice.rsuContainerHighFrequency.protectedCommunicationZonesRSU,std::move(protectedComm));
 
       }
 
@@ -748,7 +836,7 @@ namespace ns3
           asn1cpp::setField(curr_ph->pathPosition.deltaLatitude,cam->cam.camParameters.basicContainer.referencePosition.latitude - m_refPositions[0].first.latitude);
           asn1cpp::setField(curr_ph->pathPosition.deltaLongitude,cam->cam.camParameters.basicContainer.referencePosition.longitude - m_refPositions[0].first.longitude);
           asn1cpp::setField(curr_ph->pathDeltaTime,m_refPositions[0].second.deltaTime);
-          asn1cpp::sequenceof::pushList(lowFreqContainer->choice.basicVehicleContainerLowFrequency.pathHistory,curr_ph);
+          asn1cpp::sequenceof::pushList(lowFreqContainer->choice.basicVehicleContainerLowFrequency.pathHistory,std::move(curr_ph));
 
           pathCoverage += m_refPositions[0].second.deltaCoverage;
 
@@ -761,7 +849,7 @@ namespace ns3
               asn1cpp::setField(curr_ph->pathPosition.deltaLongitude,m_refPositions[i].first.longitude - m_refPositions[i-1].first.longitude);
               asn1cpp::setField(curr_ph->pathDeltaTime,m_refPositions[i].second.deltaTime);
 
-              asn1cpp::sequenceof::pushList(lowFreqContainer->choice.basicVehicleContainerLowFrequency.pathHistory,curr_ph);
+              asn1cpp::sequenceof::pushList(lowFreqContainer->choice.basicVehicleContainerLowFrequency.pathHistory,std::move(curr_ph));
 
               if((pathCoverage + m_refPositions[i].second.deltaCoverage) >= 500)
                 break; // If path history exceeds 500m of range, stop adding pathpoints
@@ -772,7 +860,7 @@ namespace ns3
           }
 
         if(vehicleRole.isAvailable () || exteriorLights.isAvailable () || m_refPositions.size()>0) {
-          asn1cpp::setField(cam->cam.camParameters.lowFrequencyContainer,lowFreqContainer);
+          asn1cpp::setField(cam->cam.camParameters.lowFrequencyContainer,std::move(lowFreqContainer));
       }
 
         lastCamGenLowFrequency=computeTimestampUInt64 ();
@@ -799,7 +887,7 @@ namespace ns3
                     auto ptactivation_seq = asn1cpp::makeSeq(PtActivation);
                     asn1cpp::setField(ptactivation_seq->ptActivationType,publicTransportContainerData.getData ().ptActivationType.getData ());
                     asn1cpp::setField(ptactivation_seq->ptActivationData,publicTransportContainerData.getData ().ptActivationData.getData ());
-                    asn1cpp::setField(specialVehicleCont->choice.publicTransportContainer.ptActivation,ptactivation_seq);
+                    asn1cpp::setField(specialVehicleCont->choice.publicTransportContainer.ptActivation,std::move(ptactivation_seq));
                   }
               }
             break;
@@ -862,7 +950,7 @@ namespace ns3
                     if(roadWorksContainerBasicData.getData ().outerhardShoulderStatus.isAvailable ())
                         //asn1cpp::setField(closeLanes_seq->outerhardShoulderStatus,roadWorksContainerBasicData.getData ().outerhardShoulderStatus.getData ());
 
-                    asn1cpp::setField(specialVehicleCont->choice.roadWorksContainerBasic.closedLanes,closeLanes_seq);
+                    asn1cpp::setField(specialVehicleCont->choice.roadWorksContainerBasic.closedLanes,std::move(closeLanes_seq));
                   }
 
               }
@@ -941,10 +1029,15 @@ namespace ns3
           NS_FATAL_ERROR("CA Basic Service error. The user specified an invalid Special Vehicle Container type.");
       }
 
-        asn1cpp::setField(cam->cam.camParameters.specialVehicleContainer,specialVehicleCont);
+        asn1cpp::setField(cam->cam.camParameters.specialVehicleContainer,std::move(specialVehicleCont));
     }
 
-    std::string encode_result = asn1cpp::uper::encode(cam);
+    std::string &encode_result = m_encodeBuffer;
+    if(m_fastCamCodec==false || CAMFastCodec::encode(*cam, encode_result)<0)
+      {
+        // generic asn1c encoder, also used for any CAM not supported by CAMFastCodec
+        asn1cpp::uper::encode(cam, encode_result);
+      }
 
     if(encode_result.size()<1)
     {
@@ -1037,6 +1130,11 @@ namespace ns3
   {
     Simulator::Remove(m_event_camCheckConditions);
     Simulator::Remove(m_event_camDisseminationStart);
+    if(m_schedulerSlot!=UINT32_MAX)
+      {
+        TriggerConditionScheduler<CABasicService>::Get ().RemoveStation (m_schedulerSlot,this);
+        m_schedulerSlot=UINT32_MAX;
+      }
     Simulator::Remove(m_event_camRsuDissemination);
     return m_cam_sent;
   }
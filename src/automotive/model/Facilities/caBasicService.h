@@ -11,7 +11,11 @@
 #include "ns3/Seq.hpp"
 #include "ns3/Getter.hpp"
 #include "ns3/LDM.h"
+#include "ns3/camFastCodec.h"
 #include "signalInfoUtils.h"
+#include "triggerTrace.h"
+#include "triggerConditionScheduler.h"
+#include <memory>
 
 extern "C" {
   #include "ns3/CAM.h"
@@ -173,6 +177,17 @@ namespace ns3
 
     void setLowFrequencyContainer(bool enable) {m_lowFreqContainerEnabled = enable;}
     void setSpecialVehicleContainer(bool enabled) {m_specialVehContainerEnabled = enabled;}
+    /**
+     * @brief Enable or disable the specialized codec for the CAMs with the common vehicle layout
+     *
+     * When enabled, the CAMs with a BasicVehicleContainerHighFrequency (and, optionally, a BasicVehicleContainerLowFrequency)
+     * are encoded with CAMFastCodec instead of the generic asn1c encoder (the result is bit-exact); the received CAMs are
+     * decoded with CAMFastCodec as well, when they are only used to update the LDM (i.e., no reception callback is set).
+     * Any other CAM is still encoded and decoded with the generic asn1c codec.
+     *
+     * @param enable  true to enable the specialized codec, false (default) to always use the generic one
+     */
+    void setFastCamCodec(bool enable) {m_fastCamCodec = enable;}
 
     /**
      * @brief Start the CAM dissemination
@@ -198,6 +213,18 @@ namespace ns3
      */
     void setCheckCamGenMs(long nextCAM) {m_T_CheckCamGen_ms = nextCAM;};
 
+    /**
+     * @brief Delegate the periodic checks of the CAM triggering conditions to the simulation-wide TriggerConditionScheduler
+     *
+     * This must be called before starting the CAM dissemination. It has no effect in real time mode.
+     * @param enable  If true, the conditions are checked by the TriggerConditionScheduler
+     */
+    void setCentralConditionCheck(bool enable) {m_centralConditionCheck = enable;}
+
+    /* Used by the TriggerConditionScheduler */
+    void fillConditionSnapshot(TriggerConditionSnapshot_t &snapshot, size_t i);
+    void scheduleConditionCheck(Time delay);
+
     /**
      * @brief Used for DCC Adaptive approach to set the future time to check CAM condition after an update of delta value
      * @param delta new delta value calculated through DCC adaptive approach
@@ -221,8 +248,12 @@ namespace ns3
     long T_GenCamMax_ms = 1000;
 
     void SetLogTriggering(bool log, std::string log_filename) {m_log_triggering = log; m_log_filename = log_filename;};
+    /**
+     * @brief Set the binary trace of the CAM triggering conditions (the same trace can be shared by all the Basic Services of a simulation)
+     */
+    void SetTriggerTrace(std::shared_ptr<TriggerTrace> trace) {m_triggerTrace = trace;}
 
-    void write_log_triggering(bool condition_verified, float head_diff, float pos_diff, float speed_diff, long time_difference, std::string data_head, std::string data_pos, std::string data_speed, std::string data_time);
+    void write_log_triggering(const CAMTriggerRecord_t &record);
 
 
   private:
@@ -249,7 +280,18 @@ namespace ns3
      * @brief Update the LDM with the received CAM message information
      * @param decodedCAM
      */
-    void vLDM_handler(asn1cpp::Seq<CAM> decodedCAM);
+    void vLDM_handler(const asn1cpp::Seq<CAM> &decodedCAM);
+    /**
+     * @brief Update the LDM with the fields of a received CAM decoded with CAMFastCodec
+     * @param fields
+     */
+    void vLDM_handler(const CAMFastCodec::LDMFields_t &fields);
+    /**
+     * @brief Insert the vehicle data of a received CAM into the LDM
+     *
+     * If the CAM has no low frequency container, the exterior lights of the last CAM received from the same vehicle are kept.
+     */
+    void vLDM_insert(vehicleData_t &vehdata, bool lowFreq_ok);
 
     // std::function<void(CAM_t *, Address)> m_CAReceiveCallback;
     std::function<void(asn1cpp::Seq<CAM>, Address)> m_CAReceiveCallback;
@@ -286,6 +328,8 @@ namespace ns3
     Ptr<LDM> m_LDM; //!< LDM object
 
     StationId_t m_station_id; //! Station ID
+    std::string m_encodeBuffer; //! Buffer reused to encode every CAM, to avoid allocating a new one each time
+    std::vector<uint8_t> m_rxBuffer; //! Buffer reused to receive a CAM, when no view on the GeoNetworking receive buffer is available (see btp::getPayloadView())
 
     StationType_t m_stationtype; //! Station type
 
@@ -321,12 +365,19 @@ namespace ns3
     bool m_lowFreqContainerEnabled;
     bool m_specialVehContainerEnabled;
 
+    bool m_fastCamCodec = false; //! If true, CAMFastCodec is used to encode and decode the CAMs with the common vehicle layout
+
     double m_last_transmission = 0;
     double m_Ton_pp = 0;
     double m_last_delta = 0;
 
     bool m_log_triggering = false;
     std::string m_log_filename;
+    std::shared_ptr<TriggerTrace> m_triggerTrace;
+
+    bool m_centralConditionCheck = false; //! Checks of the CAM conditions delegated to the TriggerConditionScheduler
+    uint32_t m_schedulerSlot = UINT32_MAX; //! Slot in the TriggerConditionScheduler, if registered
+    void scheduleNextCheck();
 
     // Statistics: number of CAMs sent per triggering conditions
     uint64_t m_pos_sent = 0;
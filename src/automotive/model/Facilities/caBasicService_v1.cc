@@ -36,6 +36,7 @@
 #include "ns3/timestamp-tag.h"
 #include "ns3/rsrp-tag.h"
 #include "ns3/size-tag.h"
+#include "ns3/decodedMessageCache.h"
 
 namespace ns3
 {
@@ -158,7 +159,7 @@ namespace ns3
     asn1cpp::setField(protectedComm->protectedZoneType,ProtectedZoneType_permanentCenDsrcTolling);
     asn1cpp::setField(protectedComm->protectedZoneLatitude,Latitude_unavailable);
     asn1cpp::setField(protectedComm->protectedZoneLongitude,Longitude_unavailable);
-    asn1cpp::sequenceof::pushList(m_protectedCommunicationsZonesRSU->protectedCommunicationZonesRSU,protectedComm);
+    asn1cpp::sequenceof::pushList(m_protectedCommunicationsZonesRSU->protectedCommunicationZonesRSU,std::move(protectedComm));
     m_btp->setFixedPositionRSU(latitude_deg,longitude_deg);
   }
 
@@ -213,12 +214,9 @@ namespace ns3
   CABasicServiceV1::receiveCam (BTPDataIndication_t dataIndication, Address from)
   {
     Ptr<Packet> packet;
-    asn1cpp::Seq<CAMV1> decoded_cam;
 
-    uint8_t *buffer; //= new uint8_t[packet->GetSize ()];
-    buffer=(uint8_t *)malloc((dataIndication.data->GetSize ())*sizeof(uint8_t));
-    dataIndication.data->CopyData (buffer, dataIndication.data->GetSize ());
-    std::string packetContent((char *)buffer,(int) dataIndication.data->GetSize ());
+    const uint8_t *buffer = btp::getPayloadView (dataIndication, m_rxBuffer);
+    uint32_t bufferSize = dataIndication.data->GetSize ();
 
     RssiTag rssi;
     bool rssi_result = dataIndication.data->PeekPacketTag(rssi);
@@ -265,20 +263,19 @@ namespace ns3
     if (buffer[1]!=FIX_CAMID)
       {
         NS_LOG_ERROR("Warning: received a message which has messageID '"<<buffer[1]<<"' but '2' was expected.");
-        free(buffer);
         return;
       }
 
-    free(buffer);
-
     /** Decoding **/
-    decoded_cam = asn1cpp::uper::decodeASN(packetContent, CAMV1);
+    DecodedMessageCache<CAMV1>::DecodedPtr_t decoded_cam_ptr = DecodedMessageCache<CAMV1>::Get ().Decode (buffer, bufferSize, &asn_DEF_CAMV1);
 
-    if(bool(decoded_cam)==false) {
+    if(decoded_cam_ptr==nullptr) {
         NS_LOG_ERROR("Warning: unable to decode a received CAM.");
         return;
       }
 
+    const asn1cpp::Seq<CAMV1> &decoded_cam = *decoded_cam_ptr;
+
     if(m_LDM != NULL){
       //Update LDM
       vLDM_handler(decoded_cam);
@@ -292,7 +289,7 @@ namespace ns3
   }
 
   void
-  CABasicServiceV1::vLDM_handler(asn1cpp::Seq<CAMV1> decodedCAM)
+  CABasicServiceV1::vLDM_handler(const asn1cpp::Seq<CAMV1> &decodedCAM)
   {
       vehicleData_t vehdata;
       LDM::LDM_error_t db_retval;
@@ -537,7 +534,7 @@ namespace ns3
             auto swa_seq = asn1cpp::makeSeq(SteeringWheelAngleV1);
             asn1cpp::setField(swa_seq->steeringWheelAngleValue,swa.getData ().getValue ());
             asn1cpp::setField(swa_seq->steeringWheelAngleConfidence,swa.getData ().getConfidence ());
-            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.steeringWheelAngle,swa_seq);
+            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.steeringWheelAngle,std::move(swa_seq));
         }
 
         auto latacc = m_vdp->getLateralAcceleration();
@@ -545,7 +542,7 @@ namespace ns3
             auto latacc_seq = asn1cpp::makeSeq(LateralAccelerationV1);
             asn1cpp::setField(latacc_seq->lateralAccelerationValue,latacc.getData ().getValue ());
             asn1cpp::setField(latacc_seq->lateralAccelerationConfidence,latacc.getData ().getConfidence ());
-            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.lateralAcceleration,latacc_seq);
+            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.lateralAcceleration,std::move(latacc_seq));
         }
 
 
@@ -554,7 +551,7 @@ namespace ns3
             auto vertacc_seq = asn1cpp::makeSeq(VerticalAccelerationV1);
             asn1cpp::setField(vertacc_seq->verticalAccelerationValue,vertacc.getData ().getValue ());
             asn1cpp::setField(vertacc_seq->verticalAccelerationConfidence,vertacc.getData ().getConfidence ());
-            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.verticalAcceleration,vertacc_seq);
+            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.verticalAcceleration,std::move(vertacc_seq));
         }
 
         auto perfClass = m_vdp->getPerformanceClass();
@@ -568,7 +565,7 @@ namespace ns3
             asn1cpp::setField(tollZone_seq->cenDsrcTollingZoneID,tollZone.getData ().cenDsrcTollingZoneID);
             asn1cpp::setField(tollZone_seq->protectedZoneLatitude,tollZone.getData ().latitude);
             asn1cpp::setField(tollZone_seq->protectedZoneLongitude,tollZone.getData ().longitude);
-            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.cenDsrcTollingZone,tollZone_seq);
+            asn1cpp::setField(cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency.cenDsrcTollingZone,std::move(tollZone_seq));
         }
 
         // Store all the "previous" values used in checkCamConditions()
@@ -603,7 +600,7 @@ namespace ns3
         asn1cpp::setField(protectedComm->protectedZoneLatitude,Latitude_unavailable);
         asn1cpp::setField(protectedComm->protectedZoneLongitude,Longitude_unavailable);
 
-        asn1cpp::sequenceof::pushList(cam->cam.camParameters.highFrequencyContainer.choice.rsuContainerHighFrequency.protectedCommunicationZonesRSU,protectedComm);
+        asn1cpp::sequenceof::pushList(cam->cam.camParameters.highFrequencyContainer.choice.rsuContainerHighFrequency.protectedCommunicationZonesRSU,std::move(protectedComm));
 
       }
 
@@ -642,7 +639,7 @@ namespace ns3
           asn1cpp::setField(curr_ph->pathPosition.deltaLatitude,cam->cam.camParameters.basicContainer.referencePosition.latitude - m_refPositions[0].first.latitude);
           asn1cpp::setField(curr_ph->pathPosition.deltaLongitude,cam->cam.camParameters.basicContainer.referencePosition.longitude - m_refPositions[0].first.longitude);
           asn1cpp::setField(curr_ph->pathDeltaTime,m_refPositions[0].second.deltaTime);
-          asn1cpp::sequenceof::pushList(lowFreqContainer->choice.basicVehicleContainerLowFrequency.pathHistory,curr_ph);
+          asn1cpp::sequenceof::pushList(lowFreqContainer->choice.basicVehicleContainerLowFrequency.pathHistory,std::move(curr_ph));
 
           pathCoverage += m_refPositions[0].second.deltaCoverage;
 
@@ -655,7 +652,7 @@ namespace ns3
               asn1cpp::setField(curr_ph->pathPosition.deltaLongitude,m_refPositions[i].first.longitude - m_refPositions[i-1].first.longitude);
               asn1cpp::setField(curr_ph->pathDeltaTime,m_refPositions[i].second.deltaTime);
 
-              asn1cpp::sequenceof::pushList(lowFreqContainer->choice.basicVehicleContainerLowFrequency.pathHistory,curr_ph);
+              asn1cpp::sequenceof::pushList(lowFreqContainer->choice.basicVehicleContainerLowFrequency.pathHistory,std::move(curr_ph));
 
               if((pathCoverage + m_refPositions[i].second.deltaCoverage) >= 500)
                 break; // If path history exceeds 500m of range, stop adding pathpoints
@@ -666,7 +663,7 @@ namespace ns3
           }
 
         if(vehicleRole.isAvailable () || exteriorLights.isAvailable () || m_refPositions.size()>0) {
-          asn1cpp::setField(cam->cam.camParameters.lowFrequencyContainer,lowFreqContainer);
+          asn1cpp::setField(cam->cam.camParameters.lowFrequencyContainer,std::move(lowFreqContainer));
       }
 
         lastCamGenLowFrequency=computeTimestampUInt64 ();
@@ -693,7 +690,7 @@ namespace ns3
                     auto ptactivation_seq = asn1cpp::makeSeq(PtActivationV1);
                     asn1cpp::setField(ptactivation_seq->ptActivationType,publicTransportContainerData.getData ().ptActivationType.getData ());
                     asn1cpp::setField(ptactivation_seq->ptActivationData,publicTransportContainerData.getData ().ptActivationData.getData ());
-                    asn1cpp::setField(specialVehicleCont->choice.publicTransportContainer.ptActivation,ptactivation_seq);
+                    asn1cpp::setField(specialVehicleCont->choice.publicTransportContainer.ptActivation,std::move(ptactivation_seq));
                   }
               }
             break;
@@ -750,7 +747,7 @@ namespace ns3
                         asn1cpp::bitstring::setBit(closeLanes_seq->drivingLaneStatus,setByteMask(roadWorksContainerBasicData.getData ().drivingLaneStatus.getData (),1),1);
                       }
 
-                    asn1cpp::setField(specialVehicleCont->choice.roadWorksContainerBasic.closedLanes,closeLanes_seq);
+                    asn1cpp::setField(specialVehicleCont->choice.roadWorksContainerBasic.closedLanes,std::move(closeLanes_seq));
                   }
 
               }
@@ -785,7 +782,7 @@ namespace ns3
                   auto cause_seq = asn1cpp::makeSeq(CauseCodeV1);
                   asn1cpp::setField(cause_seq->causeCode,emergencyContainerData.getData ().causeCode.getData ());
                   asn1cpp::setField(cause_seq->subCauseCode,emergencyContainerData.getData ().subCauseCode.getData ());
-                  asn1cpp::setField(specialVehicleCont->choice.emergencyContainer.incidentIndication,cause_seq);
+                  asn1cpp::setField(specialVehicleCont->choice.emergencyContainer.incidentIndication,std::move(cause_seq));
                 }
 
               if(emergencyContainerData.getData ().emergencyPriority.isAvailable ())
@@ -819,7 +816,7 @@ namespace ns3
                     auto causeCode_seq = asn1cpp::makeSeq(CauseCodeV1);
                     asn1cpp::setField(causeCode_seq->causeCode,safetyCarContainerData.getData ().incidentIndicationCauseCode.getData ());
                     asn1cpp::setField(causeCode_seq->subCauseCode,safetyCarContainerData.getData ().incidentIndicationSubCauseCode.getData ());
-                    asn1cpp::setField(specialVehicleCont->choice.safetyCarContainer.incidentIndication,causeCode_seq);
+                    asn1cpp::setField(specialVehicleCont->choice.safetyCarContainer.incidentIndication,std::move(causeCode_seq));
                   }
 
               }
@@ -829,10 +826,11 @@ namespace ns3
           NS_FATAL_ERROR("CA Basic Service error. The user specified an invalid Special Vehicle Container type.");
       }
 
-        asn1cpp::setField(cam->cam.camParameters.specialVehicleContainer,specialVehicleCont);
+        asn1cpp::setField(cam->cam.camParameters.specialVehicleContainer,std::move(specialVehicleCont));
     }
 
-    std::string encode_result = asn1cpp::uper::encode(cam);
+    std::string &encode_result = m_encodeBuffer;
+    asn1cpp::uper::encode(cam, encode_result);
 
     if(encode_result.size()<1)
     {
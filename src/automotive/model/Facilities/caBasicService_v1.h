@@ -96,7 +96,7 @@ namespace ns3
     void checkCamConditions();
     CABasicServiceV1_error_t generateAndEncodeCam();
     int64_t computeTimestampUInt64();
-    void vLDM_handler(asn1cpp::Seq<CAMV1> decodedCAM);
+    void vLDM_handler(const asn1cpp::Seq<CAMV1> &decodedCAM);
 
     // std::function<void(CAM_t *, Address)> m_CAReceiveCallback;
     std::function<void(asn1cpp::Seq<CAMV1>, Address)> m_CAReceiveCallback;
@@ -125,6 +125,8 @@ namespace ns3
      Ptr<LDM> m_LDM;
 
     StationID_t m_station_id;
+    std::string m_encodeBuffer; //! Buffer reused to encode every CAM, to avoid allocating a new one each time
+    std::vector<uint8_t> m_rxBuffer; //! Buffer reused to receive a CAM, when no view on the GeoNetworking receive buffer is available (see btp::getPayloadView())
     StationType_t m_stationtype;
 
     // Previous CAM relevant values
@@ -0,0 +1,441 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include <algorithm>
+
+#include "camFastCodec.h"
+#include "ns3/asn_utils.h"
+
+namespace ns3
+{
+  namespace
+  {
+    // number of bits used by UPER to encode a constrained whole number with the given range (ub-lb)
+    constexpr unsigned int rangeBits(uint64_t range)
+    {
+      return range == 0 ? 0 : 1 + rangeBits (range >> 1);
+    }
+
+    class BitWriter
+    {
+    public:
+      BitWriter(uint8_t *buffer, size_t size) : m_buffer(buffer), m_size(size) {}
+
+      // append the "bits" least significant bits of "value" (at most 32 bits)
+      void put(uint64_t value, unsigned int bits)
+      {
+        m_acc = (m_acc << bits) | (value & ((UINT64_C(1) << bits) - 1));
+        m_accBits += bits;
+
+        while(m_accBits >= 8)
+          {
+            m_accBits -= 8;
+            if(m_pos < m_size)
+              {
+                m_buffer[m_pos] = (uint8_t) (m_acc >> m_accBits);
+              }
+            m_pos++;
+          }
+      }
+
+      // constrained whole number (lb..ub), without extension marker
+      template <int64_t LB, int64_t UB>
+      bool putConstrained(int64_t value)
+      {
+        static_assert (UB >= LB, "Invalid constraint");
+
+        if(value < LB || value > UB)
+          {
+            return false;
+          }
+
+        put ((uint64_t) (value - LB), rangeBits ((uint64_t) (UB - LB)));
+        return true;
+      }
+
+      // constrained whole number (lb..ub,...): only the values in the root range are supported
+      template <int64_t LB, int64_t UB>
+      bool putExtensible(int64_t value)
+      {
+        put (0, 1);
+        return putConstrained<LB,UB> (value);
+      }
+
+      // fixed size BIT STRING (SIZE(N)), N <= 8
+      template <unsigned int N>
+      bool putFixedBitString(const BIT_STRING_t &bitstring)
+      {
+        static_assert (N > 0 && N <= 8, "Unsupported BIT STRING size");
+
+        if(bitstring.buf == NULL || bitstring.size != 1 || bitstring.bits_unused != (int) (8 - N))
+          {
+            return false;
+          }
+
+        put (bitstring.buf[0] >> (8 - N), N);
+        return true;
+      }
+
+      // pad the last octet with zeros and return the total size in bytes, or -1 if the buffer was too small
+      ssize_t finish()
+      {
+        if(m_accBits > 0)
+          {
+            put (0, 8 - m_accBits);
+          }
+
+        return m_pos <= m_size ? (ssize_t) m_pos : -1;
+      }
+
+    private:
+      uint8_t *m_buffer;
+      size_t m_size;
+      size_t m_pos = 0;
+      uint64_t m_acc = 0;
+      unsigned int m_accBits = 0;
+    };
+
+    class BitReader
+    {
+    public:
+      BitReader(const uint8_t *buffer, size_t size) : m_buffer(buffer), m_sizeBits(size * 8) {}
+
+      // read "bits" bits (at most 32 bits)
+      uint64_t get(unsigned int bits)
+      {
+        uint64_t value = 0;
+
+        if(m_posBits + bits > m_sizeBits)
+          {
+            m_error = true;
+            m_posBits = m_sizeBits;
+            return 0;
+          }
+
+        for(unsigned int i = 0; i < bits;)
+          {
+            unsigned int bit_offset = m_posBits & 7;
+            unsigned int chunk = std::min (8 - bit_offset, bits - i);
+            uint8_t byte = m_buffer[m_posBits >> 3];
+
+            value = (value << chunk) | ((byte >> (8 - bit_offset - chunk)) & ((1U << chunk) - 1));
+            m_posBits += chunk;
+            i += chunk;
+          }
+
+        return value;
+      }
+
+      template <int64_t LB, int64_t UB>
+      int64_t getConstrained()
+      {
+        int64_t value = LB + (int64_t) get (rangeBits ((uint64_t) (UB - LB)));
+
+        if(value > UB)
+          {
+            m_error = true;
+          }
+
+        return value;
+      }
+
+      template <int64_t LB, int64_t UB>
+      int64_t getExtensible()
+      {
+        // values in the extension range are left to the generic decoder
+        if(get (1) != 0)
+          {
+            m_error = true;
+          }
+
+        return getConstrained<LB,UB> ();
+      }
+
+      void skip(size_t bits)
+      {
+        if(m_posBits + bits > m_sizeBits)
+          {
+            m_error = true;
+            m_posBits = m_sizeBits;
+            return;
+          }
+        m_posBits += bits;
+      }
+
+      bool error() const {return m_error;}
+
+    private:
+      const uint8_t *m_buffer;
+      size_t m_sizeBits;
+      size_t m_posBits = 0;
+      bool m_error = false;
+    };
+
+    bool
+    putAcceleration(BitWriter &writer, const AccelerationComponent_t &acceleration)
+    {
+      return writer.putConstrained<-160,161> (acceleration.value) &&
+             writer.putConstrained<0,102> (acceleration.confidence);
+    }
+  }
+
+  ssize_t
+  CAMFastCodec::encode(const CAM_t &cam, std::string &buffer)
+  {
+    const CamParameters_t &camParameters = cam.cam.camParameters;
+    const BasicContainer_t &basicContainer = camParameters.basicContainer;
+    const ReferencePositionWithConfidence_t &refPos = basicContainer.referencePosition;
+
+    if(camParameters.specialVehicleContainer != NULL ||
+       camParameters.highFrequencyContainer.present != HighFrequencyContainer_PR_basicVehicleContainerHighFrequency ||
+       (camParameters.lowFrequencyContainer != NULL &&
+        camParameters.lowFrequencyContainer->present != LowFrequencyContainer_PR_basicVehicleContainerLowFrequency))
+      {
+        return -1;
+      }
+
+    const BasicVehicleContainerHighFrequency_t &hf = camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency;
+
+    if(hf.cenDsrcTollingZone != NULL)
+      {
+        return -1;
+      }
+
+    // the buffer is resized (without reallocating it, if it is reused) and then shrunk to the actual size
+    buffer.resize (maxEncodedSize);
+    BitWriter writer((uint8_t *) &buffer[0], buffer.size ());
+    bool ok = true;
+
+    // ItsPduHeader
+    ok = ok && writer.putConstrained<0,255> (cam.header.protocolVersion);
+    ok = ok && writer.putConstrained<0,255> (cam.header.messageId);
+    ok = ok && writer.putConstrained<0,4294967295> (cam.header.stationId);
+
+    // CamPayload
+    ok = ok && writer.putConstrained<0,65535> (cam.cam.generationDeltaTime);
+
+    // CamParameters (extensible, two optional containers)
+    writer.put (0, 1);
+    writer.put (camParameters.lowFrequencyContainer != NULL, 1);
+    writer.put (0, 1);
+
+    // BasicContainer (extensible)
+    writer.put (0, 1);
+    ok = ok && writer.putConstrained<0,255> (basicContainer.stationType);
+    ok = ok && writer.putConstrained<-900000000,900000001> (refPos.latitude);
+    ok = ok && writer.putConstrained<-1800000000,1800000001> (refPos.longitude);
+    ok = ok && writer.putConstrained<0,4095> (refPos.positionConfidenceEllipse.semiMajorAxisLength);
+    ok = ok && writer.putConstrained<0,4095> (refPos.positionConfidenceEllipse.semiMinorAxisLength);
+    ok = ok && writer.putConstrained<0,3601> (refPos.positionConfidenceEllipse.semiMajorAxisOrientation);
+    ok = ok && writer.putConstrained<-100000,800001> (refPos.altitude.altitudeValue);
+    ok = ok && writer.putConstrained<0,15> (refPos.altitude.altitudeConfidence);
+
+    // HighFrequencyContainer (extensible CHOICE, alternative 0)
+    writer.put (0, 1);
+    writer.put (0, 1);
+
+    // BasicVehicleContainerHighFrequency (seven optional fields)
+    writer.put (hf.accelerationControl != NULL, 1);
+    writer.put (hf.lanePosition != NULL, 1);
+    writer.put (hf.steeringWheelAngle != NULL, 1);
+    writer.put (hf.lateralAcceleration != NULL, 1);
+    writer.put (hf.verticalAcceleration != NULL, 1);
+    writer.put (hf.performanceClass != NULL, 1);
+    writer.put (0, 1);
+
+    ok = ok && writer.putConstrained<0,3601> (hf.heading.headingValue);
+    ok = ok && writer.putConstrained<1,127> (hf.heading.headingConfidence);
+    ok = ok && writer.putConstrained<0,16383> (hf.speed.speedValue);
+    ok = ok && writer.putConstrained<1,127> (hf.speed.speedConfidence);
+    ok = ok && writer.putConstrained<0,2> (hf.driveDirection);
+    ok = ok && writer.putConstrained<1,1023> (hf.vehicleLength.vehicleLengthValue);
+    ok = ok && writer.putConstrained<0,4> (hf.vehicleLength.vehicleLengthConfidenceIndication);
+    ok = ok && writer.putConstrained<1,62> (hf.vehicleWidth);
+    ok = ok && putAcceleration (writer, hf.longitudinalAcceleration);
+    ok = ok && writer.putConstrained<-1023,1023> (hf.curvature.curvatureValue);
+    ok = ok && writer.putConstrained<0,7> (hf.curvature.curvatureConfidence);
+    ok = ok && writer.putExtensible<0,2> (hf.curvatureCalculationMode);
+    ok = ok && writer.putConstrained<-32766,32767> (hf.yawRate.yawRateValue);
+    ok = ok && writer.putConstrained<0,8> (hf.yawRate.yawRateConfidence);
+
+    if(hf.accelerationControl != NULL)
+      {
+        ok = ok && writer.putFixedBitString<7> (*hf.accelerationControl);
+      }
+    if(hf.lanePosition != NULL)
+      {
+        ok = ok && writer.putConstrained<-1,14> (*hf.lanePosition);
+      }
+    if(hf.steeringWheelAngle != NULL)
+      {
+        ok = ok && writer.putConstrained<-511,512> (hf.steeringWheelAngle->steeringWheelAngleValue);
+        ok = ok && writer.putConstrained<1,127> (hf.steeringWheelAngle->steeringWheelAngleConfidence);
+      }
+    if(hf.lateralAcceleration != NULL)
+      {
+        ok = ok && putAcceleration (writer, *hf.lateralAcceleration);
+      }
+    if(hf.verticalAcceleration != NULL)
+      {
+        ok = ok && putAcceleration (writer, *hf.verticalAcceleration);
+      }
+    if(hf.performanceClass != NULL)
+      {
+        ok = ok && writer.putConstrained<0,7> (*hf.performanceClass);
+      }
+
+    if(camParameters.lowFrequencyContainer != NULL)
+      {
+        const BasicVehicleContainerLowFrequency_t &lf = camParameters.lowFrequencyContainer->choice.basicVehicleContainerLowFrequency;
+
+        // LowFrequencyContainer (extensible CHOICE with a single root alternative: no index bits)
+        writer.put (0, 1);
+
+        ok = ok && writer.putConstrained<0,15> (lf.vehicleRole);
+        ok = ok && writer.putFixedBitString<8> (lf.exteriorLights);
+
+        // PathHistory: SEQUENCE (SIZE(0..40)) OF PathPoint
+        ok = ok && writer.putConstrained<0,40> (lf.pathHistory.list.count);
+        for(int i = 0; ok && i < lf.pathHistory.list.count; i++)
+          {
+            const PathPoint_t *point = lf.pathHistory.list.array[i];
+
+            if(point == NULL)
+              {
+                return -1;
+              }
+
+            writer.put (point->pathDeltaTime != NULL, 1);
+            ok = ok && writer.putConstrained<-131071,131072> (point->pathPosition.deltaLatitude);
+            ok = ok && writer.putConstrained<-131071,131072> (point->pathPosition.deltaLongitude);
+            ok = ok && writer.putConstrained<-12700,12800> (point->pathPosition.deltaAltitude);
+            if(point->pathDeltaTime != NULL)
+              {
+                ok = ok && writer.putExtensible<1,65535> (*point->pathDeltaTime);
+              }
+          }
+      }
+
+    ssize_t size = writer.finish ();
+
+    if(!ok || size < 0)
+      {
+        buffer.clear ();
+        return -1;
+      }
+
+    buffer.resize (size);
+    return size;
+  }
+
+  bool
+  CAMFastCodec::decodeLDMFields(const uint8_t *buffer, size_t size, LDMFields_t &fields)
+  {
+    BitReader reader(buffer, size);
+
+    // ItsPduHeader
+    reader.skip (8);
+    if(reader.getConstrained<0,255> () != FIX_CAMID)
+      {
+        return false;
+      }
+    fields.stationId = (StationId_t) reader.getConstrained<0,4294967295> ();
+
+    fields.generationDeltaTime = (long) reader.getConstrained<0,65535> ();
+
+    // CamParameters: extensions and special vehicle containers are left to the generic decoder
+    if(reader.get (1) != 0)
+      {
+        return false;
+      }
+    fields.lowFrequencyContainerPresent = reader.get (1) != 0;
+    if(reader.get (1) != 0)
+      {
+        return false;
+      }
+
+    // BasicContainer
+    if(reader.get (1) != 0)
+      {
+        return false;
+      }
+    fields.stationType = (long) reader.getConstrained<0,255> ();
+    fields.latitude = (long) reader.getConstrained<-900000000,900000001> ();
+    fields.longitude = (long) reader.getConstrained<-1800000000,1800000001> ();
+    reader.skip (12 + 12 + 12);
+    fields.altitudeValue = (long) reader.getConstrained<-100000,800001> ();
+    reader.skip (4);
+
+    // HighFrequencyContainer: only the basicVehicleContainerHighFrequency alternative is supported
+    if(reader.get (1) != 0 || reader.get (1) != 0)
+      {
+        return false;
+      }
+
+    bool accelerationControl = reader.get (1) != 0;
+    bool lanePosition = reader.get (1) != 0;
+    bool steeringWheelAngle = reader.get (1) != 0;
+    bool lateralAcceleration = reader.get (1) != 0;
+    bool verticalAcceleration = reader.get (1) != 0;
+    bool performanceClass = reader.get (1) != 0;
+    if(reader.get (1) != 0)
+      {
+        return false;
+      }
+
+    fields.headingValue = (long) reader.getConstrained<0,3601> ();
+    reader.skip (7);
+    fields.speedValue = (long) reader.getConstrained<0,16383> ();
+    reader.skip (7 + 2);
+    fields.vehicleLengthValue = (long) reader.getConstrained<1,1023> ();
+    reader.skip (3);
+    fields.vehicleWidth = (long) reader.getConstrained<1,62> ();
+
+    // the rest of the CAM is not used by the LDM, but it is still read up to the end, so that truncated CAMs are
+    // rejected, and the CAMs with values in the extension range are left to the generic decoder
+    reader.skip (9 + 7 + 11 + 3);
+    reader.getExtensible<0,2> ();
+    reader.skip (16 + 4);
+    reader.skip ((accelerationControl ? 7 : 0) + (lanePosition ? 4 : 0) + (steeringWheelAngle ? 10 + 7 : 0) +
+                 (lateralAcceleration ? 9 + 7 : 0) + (verticalAcceleration ? 9 + 7 : 0) + (performanceClass ? 3 : 0));
+
+    if(!fields.lowFrequencyContainerPresent)
+      {
+        return !reader.error ();
+      }
+
+    if(reader.get (1) != 0)
+      {
+        return false;
+      }
+    reader.skip (4);
+    fields.exteriorLights = (uint8_t) reader.get (8);
+
+    // PathHistory
+    int64_t pathPoints = reader.getConstrained<0,40> ();
+    for(int64_t i = 0; i < pathPoints && !reader.error (); i++)
+      {
+        bool pathDeltaTime = reader.get (1) != 0;
+        reader.skip (18 + 18 + 15);
+        if(pathDeltaTime)
+          {
+            reader.getExtensible<1,65535> ();
+          }
+      }
+
+    return !reader.error ();
+  }
+}
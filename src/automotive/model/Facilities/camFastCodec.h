@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef CAMFASTCODEC_H
+#define CAMFASTCODEC_H
+
+#include <string>
+#include <cstdint>
+#include <sys/types.h>
+
+extern "C" {
+  #include "ns3/CAM.h"
+}
+
+namespace ns3
+{
+  /**
+   * \ingroup automotive
+   * \brief Specialized UPER codec for the CAMs with the most common (vehicle) layout
+   *
+   * The generic asn1c encoder and decoder walk the type descriptors of every field at run time. Most of the CAMs
+   * sent by the vehicles, however, always have the same structure: ITS PDU header, BasicContainer,
+   * BasicVehicleContainerHighFrequency (with any of its optional fields, except the CEN DSRC tolling zone) and,
+   * optionally, a BasicVehicleContainerLowFrequency with its path history.
+   * For this layout, the position and width of each field in the UPER bit stream only depend on the ASN.1
+   * constraints of the CAM definition, which are hardcoded here as template parameters, so that each field is
+   * written or read with a single shift.
+   *
+   * The output is bit-exact with respect to asn1cpp::uper::encode(). Whenever a CAM does not match the supported
+   * layout (RSU high frequency container, special vehicle container, tolling zone, values in the extension range
+   * or outside the constraints, ...), encode() and decodeLDMFields() fail, and the caller must use the generic
+   * asn1c codec instead.
+   */
+  class CAMFastCodec
+  {
+  public:
+    /**
+     * \brief CAM fields used to update the LDM of the receiver (see CABasicService::vLDM_handler())
+     */
+    typedef struct LDMFields {
+      StationId_t stationId;
+      long stationType;
+      long latitude;
+      long longitude;
+      long altitudeValue;
+      long headingValue;
+      long speedValue;
+      long generationDeltaTime;
+      long vehicleLengthValue;
+      long vehicleWidth;
+      bool lowFrequencyContainerPresent;
+      uint8_t exteriorLights;
+    } LDMFields_t;
+
+    /**
+     * \brief Encode a CAM with the fixed layout
+     *
+     * @param cam     The CAM to be encoded
+     * @param buffer  The buffer where the encoded CAM is stored (its previous content is replaced)
+     * @return The size of the encoded CAM, in bytes, or -1 if the CAM does not have the supported layout
+     */
+    static ssize_t encode(const CAM_t &cam, std::string &buffer);
+
+    /**
+     * \brief Decode the LDM fields of a UPER encoded CAM with the fixed layout
+     *
+     * @param buffer  The encoded CAM
+     * @param size    The size of the encoded CAM, in bytes
+     * @param fields  The decoded fields
+     * @return true if the CAM has been decoded, false if it does not have the supported layout or it is malformed
+     */
+    static bool decodeLDMFields(const uint8_t *buffer, size_t size, LDMFields_t &fields);
+
+    /**
+     * \brief Maximum size of a CAM with the fixed layout (with a full path history), in bytes
+     */
+    static const size_t maxEncodedSize = 512;
+  };
+}
+
+#endif // CAMFASTCODEC_H
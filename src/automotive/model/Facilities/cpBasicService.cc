@@ -24,6 +24,7 @@
 #include "ns3/timestamp-tag.h"
 #include "ns3/rsrp-tag.h"
 #include "ns3/size-tag.h"
+#include "ns3/decodedMessageCache.h"
 
 namespace ns3 {
 
@@ -107,47 +108,53 @@ namespace ns3 {
     pos2 = m_client->TraCIAPI::simulation.convertLonLattoXY(lon2,lat2);
     return sqrt((pow((pos1.x-pos2.x),2)+pow((pos1.y-pos2.y),2)));
   }
-  bool
-  CPBasicService::checkCPMconditions(std::vector<LDM::returnedVehicleData_t>::iterator PO_data)
+  PerceivedObject_t *
+  CPBasicService::getPooledPO(size_t i)
   {
-    /*Perceived Object Container Inclusion Management as mandated by TS 103 324 Section 6.1.2.3*/
-    std::map<uint64_t, PHData_t> phPoints = PO_data->phData.getPHpoints ();
-    PHData_t previousCPM;
-    /* 1.a The object has first been detected by the perception system after the last CPM generation event.*/
-    if((PO_data->phData.getSize ()==1) && (PO_data->phData.getPHpoints ().begin ()->first > lastCpmGen))
-      return true;
-
-    /* Get the last position of the reference point of this object lastly included in a CPM from the object pathHistory*/
-    std::map<uint64_t, PHData_t>::reverse_iterator it = phPoints.rbegin ();
-    it ++;
-    for(auto fromPrev = it; fromPrev!=phPoints.rend(); fromPrev++)
+    while (m_POPool.size () <= i)
       {
-        if (fromPrev->second.CPMincluded == true)
-          {
-            previousCPM = fromPrev->second;
-          }
-      }
-    /* 1.b The Euclidian absolute distance between the current estimated position of the reference point of the
-     * object and the estimated position of the reference point of this object lastly included in a CPM exceeds
-     * 4 m. */
-    if(m_vdp->getCartesianDist (previousCPM.lon,previousCPM.lat,PO_data->vehData.lon,PO_data->vehData.lat) > 4.0)
-      return true;
-    /* 1.c The difference between the current estimated absolute speed of the reference point of the object and the
-     * estimated absolute speed of the reference point of this object lastly included in a CPM exceeds 0,5 m/s. */
-    if(abs(previousCPM.speed_ms - PO_data->vehData.speed_ms) > 0.5)
-      return true;
-    /* 1.d The difference between the orientation of the vector of the current estimated absolute velocity of the
-     * reference point of the object and the estimated orientation of the vector of the absolute velocity of the
-     * reference point of this object lastly included in a CPM exceeds 4 degrees. */
-    if(abs(previousCPM.heading - PO_data->vehData.heading) > 4)
-      return true;
-    /* 1.e The time elapsed since the last time the object was included in a CPM exceeds T_GenCpmMax. */
-    if(PO_data->vehData.lastCPMincluded.isAvailable ())
-      {
-        if(PO_data->vehData.lastCPMincluded.getData() < ((computeTimestampUInt64 ()/NANO_TO_MILLI)-m_N_GenCpmMax))
-          return true;
+        auto PO = asn1cpp::makeSeq (PerceivedObject);
+        if (bool (PO) == false)
+          return nullptr;
+
+        asn1cpp::setField (PO->objectId, 0);
+
+        auto velocity = asn1cpp::makeSeq (Velocity3dWithConfidence);
+        asn1cpp::setField (velocity->present, Velocity3dWithConfidence_PR_cartesianVelocity);
+        asn1cpp::setField (velocity->choice.cartesianVelocity.xVelocity.confidence,
+                           SpeedConfidence_unavailable);
+        asn1cpp::setField (velocity->choice.cartesianVelocity.yVelocity.confidence,
+                           SpeedConfidence_unavailable);
+        asn1cpp::setField (PO->velocity, std::move(velocity));
+
+        auto acceleration = asn1cpp::makeSeq (Acceleration3dWithConfidence);
+        asn1cpp::setField (acceleration->present,
+                           Acceleration3dWithConfidence_PR_cartesianAcceleration);
+        asn1cpp::setField (acceleration->choice.cartesianAcceleration.xAcceleration.confidence,
+                           AccelerationConfidence_unavailable);
+        asn1cpp::setField (acceleration->choice.cartesianAcceleration.yAcceleration.confidence,
+                           AccelerationConfidence_unavailable);
+        asn1cpp::setField (PO->acceleration, std::move(acceleration));
+
+        //Only z angle
+        auto angle = asn1cpp::makeSeq (EulerAnglesWithConfidence);
+        asn1cpp::setField (angle->zAngle.confidence, AngleConfidence_unavailable);
+        asn1cpp::setField (PO->angles, std::move(angle));
+
+        auto OD1 = asn1cpp::makeSeq (ObjectDimension);
+        asn1cpp::setField (OD1->confidence, ObjectDimensionConfidence_unavailable);
+        asn1cpp::setField (PO->objectDimensionX, std::move(OD1));
+        auto OD2 = asn1cpp::makeSeq (ObjectDimension);
+        asn1cpp::setField (OD2->confidence, ObjectDimensionConfidence_unavailable);
+        asn1cpp::setField (PO->objectDimensionY, std::move(OD2));
+
+        asn1cpp::setField (PO->position.xCoordinate.confidence, CoordinateConfidence_unavailable);
+        asn1cpp::setField (PO->position.yCoordinate.confidence, CoordinateConfidence_unavailable);
+
+        m_POPool.push_back (std::move(PO));
       }
-    return false;
+
+    return &*m_POPool[i];
   }
 
   void
@@ -160,10 +167,11 @@ namespace ns3 {
 
     int64_t now = computeTimestampUInt64 () / NANO_TO_MILLI;
 
-    std::string encode_result;
+    std::string &encode_result = m_encodeBuffer;
 
     long numberOfPOs = 0;
     long container_counter = 1;
+    PerceivedObjects_t *pooledPOs = nullptr;
 
     /* Collect data for mandatory containers */
     auto cpm = asn1cpp::makeSeq (CollectivePerceptionMessage);
@@ -185,108 +193,69 @@ namespace ns3 {
 
     if (m_LDM != NULL)
       {
-        std::vector<LDM::returnedVehicleData_t> LDM_POs;
-        if (m_LDM->getAllPOs (LDM_POs)) // If there are any POs in the LDM
+        /* Get only the POs perceived by this station which are due for inclusion, as detailed in ETSI TS 103 324, Section 6.1.2.3
+         * (the inclusion conditions are tracked by the LDM when the objects are inserted) */
+        m_CPM_POs.clear ();
+        if (m_LDM->getOwnPOsForCPM ((long) m_station_id, now, m_N_GenCpmMax, !m_redundancy_mitigation, m_CPM_POs))
           {
             /* Fill Perceived Object Container as detailed in ETSI TS 103 324, Section 7.1.8 */
-            std::vector<LDM::returnedVehicleData_t>::iterator it;
-            for (it = LDM_POs.begin (); it != LDM_POs.end (); it++)
+            for (vehicleData_t *PO_data : m_CPM_POs)
               {
+                // The PerceivedObject structures are taken from the pool, and all their fields are overwritten here
+                PerceivedObject_t *PO = getPooledPO (numberOfPOs);
+                if (PO == nullptr)
+                  break;
+
+                *PO->objectId = PO_data->stationID;
+                long timeOfMeasurement =
+                    (Simulator::Now ().GetMicroSeconds () - PO_data->timestamp_us) /
+                    1000; // time of measuremente in ms
+                if (timeOfMeasurement > 1500)
+                  timeOfMeasurement = 1500;
+                asn1cpp::setField (PO->measurementDeltaTime, timeOfMeasurement);
+                asn1cpp::setField (PO->position.xCoordinate.value, PO_data->xDistAbs.getData ());
+                asn1cpp::setField (PO->position.yCoordinate.value, PO_data->yDistAbs.getData ());
+
+                asn1cpp::setField (PO->velocity->choice.cartesianVelocity.xVelocity.value,
+                                   PO_data->xSpeedAbs.getData ());
+                asn1cpp::setField (PO->velocity->choice.cartesianVelocity.yVelocity.value,
+                                   PO_data->ySpeedAbs.getData ());
+
+                asn1cpp::setField (PO->acceleration->choice.cartesianAcceleration.xAcceleration.value,
+                                   PO_data->xAccAbs.getData ());
+                asn1cpp::setField (PO->acceleration->choice.cartesianAcceleration.yAcceleration.value,
+                                   PO_data->yAccAbs.getData ());
+
+                if ((PO_data->heading*DECI) < CartesianAngleValue_unavailable &&
+                    (PO_data->heading*DECI) > 0)
+                  asn1cpp::setField (PO->angles->zAngle.value, (PO_data->heading*DECI));
+                else
+                  asn1cpp::setField (PO->angles->zAngle.value, CartesianAngleValue_unavailable);
 
-                if (it->vehData.perceivedBy.getData () != (long) m_station_id)
-                  continue;
-                if (!checkCPMconditions (it) && m_redundancy_mitigation)
-                  continue;
+                if (PO_data->vehicleLength.getData () < 1023 &&
+                    PO_data->vehicleLength.getData () > 0)
+                  asn1cpp::setField (PO->objectDimensionX->value, PO_data->vehicleLength.getData ());
                 else
-                  {
-                    auto PO = asn1cpp::makeSeq (PerceivedObject);
-                    asn1cpp::setField (PO->objectId, it->vehData.stationID);
-                    long timeOfMeasurement =
-                        (Simulator::Now ().GetMicroSeconds () - it->vehData.timestamp_us) /
-                        1000; // time of measuremente in ms
-                    if (timeOfMeasurement > 1500)
-                      timeOfMeasurement = 1500;
-                    asn1cpp::setField (PO->measurementDeltaTime, timeOfMeasurement);
-                    asn1cpp::setField (PO->position.xCoordinate.value,
-                                       it->vehData.xDistAbs.getData ());
-                    asn1cpp::setField (PO->position.xCoordinate.confidence,
-                                       CoordinateConfidence_unavailable);
-                    asn1cpp::setField (PO->position.yCoordinate.value,
-                                       it->vehData.yDistAbs.getData ());
-                    asn1cpp::setField (PO->position.yCoordinate.confidence,
-                                       CoordinateConfidence_unavailable);
-
-                    auto velocity = asn1cpp::makeSeq (Velocity3dWithConfidence);
-                    asn1cpp::setField (velocity->present,
-                                       Velocity3dWithConfidence_PR_cartesianVelocity);
-                    auto cartesianVelocity = asn1cpp::makeSeq (VelocityCartesian);
-                    asn1cpp::setField (cartesianVelocity->xVelocity.value,
-                                       it->vehData.xSpeedAbs.getData ());
-                    asn1cpp::setField (cartesianVelocity->xVelocity.confidence,
-                                       SpeedConfidence_unavailable);
-                    asn1cpp::setField (cartesianVelocity->yVelocity.value,
-                                       it->vehData.ySpeedAbs.getData ());
-                    asn1cpp::setField (cartesianVelocity->yVelocity.confidence,
-                                       SpeedConfidence_unavailable);
-                    asn1cpp::setField (velocity->choice.cartesianVelocity, cartesianVelocity);
-                    asn1cpp::setField (PO->velocity, velocity);
-
-                    auto acceleration = asn1cpp::makeSeq (Acceleration3dWithConfidence);
-                    asn1cpp::setField (acceleration->present,
-                                       Acceleration3dWithConfidence_PR_cartesianAcceleration);
-                    auto cartesianAcceleration = asn1cpp::makeSeq (AccelerationCartesian);
-                    asn1cpp::setField (cartesianAcceleration->xAcceleration.value,
-                                       it->vehData.xAccAbs.getData ());
-                    asn1cpp::setField (cartesianAcceleration->xAcceleration.confidence,
-                                       AccelerationConfidence_unavailable);
-                    asn1cpp::setField (cartesianAcceleration->yAcceleration.value,
-                                       it->vehData.yAccAbs.getData ());
-                    asn1cpp::setField (cartesianAcceleration->yAcceleration.confidence,
-                                       AccelerationConfidence_unavailable);
-                    asn1cpp::setField (acceleration->choice.cartesianAcceleration,
-                                       cartesianAcceleration);
-                    asn1cpp::setField (PO->acceleration, acceleration);
-
-                    //Only z angle
-                    auto angle = asn1cpp::makeSeq (EulerAnglesWithConfidence);
-                    if ((it->vehData.heading*DECI) < CartesianAngleValue_unavailable &&
-                        (it->vehData.heading*DECI) > 0)
-                      asn1cpp::setField (angle->zAngle.value, (it->vehData.heading*DECI));
-                    else
-                      asn1cpp::setField (angle->zAngle.value, CartesianAngleValue_unavailable);
-                    asn1cpp::setField (angle->zAngle.confidence, AngleConfidence_unavailable);
-                    asn1cpp::setField (PO->angles, angle);
-                    auto OD1 = asn1cpp::makeSeq (ObjectDimension);
-                    if (it->vehData.vehicleLength.getData () < 1023 &&
-                        it->vehData.vehicleLength.getData () > 0)
-                      asn1cpp::setField (OD1->value, it->vehData.vehicleLength.getData ());
-                    else
-                      asn1cpp::setField (OD1->value, 50); //usual value for SUMO vehicles
-                    asn1cpp::setField (OD1->confidence, ObjectDimensionConfidence_unavailable);
-                    asn1cpp::setField (PO->objectDimensionX, OD1);
-                    auto OD2 = asn1cpp::makeSeq (ObjectDimension);
-                    if (it->vehData.vehicleWidth.getData () < 1023 &&
-                        it->vehData.vehicleWidth.getData () > 0)
-                      asn1cpp::setField (OD2->value, it->vehData.vehicleWidth.getData ());
-                    else
-                      asn1cpp::setField (OD2->value, 18); //usual value for SUMO vehicles
-                    asn1cpp::setField (OD2->confidence, ObjectDimensionConfidence_unavailable);
-                    asn1cpp::setField (PO->objectDimensionY, OD2);
-
-                    /*Rest of optional fields handling left as future work*/
-
-                    //Push Perceived Object to the container
-                    asn1cpp::sequenceof::pushList (*CPM_POs, PO);
-                    //Update the timestamp of the last time this PO was included in a CPM
-                    m_LDM->updateCPMincluded (it->vehData.stationID,
-                                              computeTimestampUInt64 () / NANO_TO_MILLI);
-                    //Increase number of POs for the numberOfPerceivedObjects field in cpmParameters container
-                    numberOfPOs++;
-                  }
+                  asn1cpp::setField (PO->objectDimensionX->value, 50); //usual value for SUMO vehicles
+                if (PO_data->vehicleWidth.getData () < 1023 &&
+                    PO_data->vehicleWidth.getData () > 0)
+                  asn1cpp::setField (PO->objectDimensionY->value, PO_data->vehicleWidth.getData ());
+                else
+                  asn1cpp::setField (PO->objectDimensionY->value, 18); //usual value for SUMO vehicles
+
+                /*Rest of optional fields handling left as future work*/
+
+                //Push Perceived Object to the container (the pooled structure is detached from the CPM after encoding)
+                if (ASN_SEQUENCE_ADD (&CPM_POs->list, PO) != 0)
+                  break;
+                //Update the timestamp of the last time this PO was included in a CPM
+                m_LDM->updateCPMincluded (PO_data->stationID, now);
+                //Increase number of POs for the numberOfPerceivedObjects field in cpmParameters container
+                numberOfPOs++;
               }
             if (numberOfPOs != 0)
               {
-                asn1cpp::setField (POsContainer->perceivedObjects, CPM_POs);
+                asn1cpp::setField (POsContainer->perceivedObjects, std::move(CPM_POs));
                 asn1cpp::setField (POsContainer->numberOfPerceivedObjects, numberOfPOs);
               }
           }
@@ -341,8 +310,8 @@ namespace ns3 {
     asn1cpp::setField (wrappedCpmContainer->containerData.present,
                        WrappedCpmContainer__containerData_PR_OriginatingVehicleContainer);
     asn1cpp::setField (wrappedCpmContainer->containerData.choice.OriginatingVehicleContainer,
-                       originatingVehicleContainer);
-    asn1cpp::sequenceof::pushList (cpm->payload.cpmContainers, wrappedCpmContainer);
+                       std::move(originatingVehicleContainer));
+    asn1cpp::sequenceof::pushList (cpm->payload.cpmContainers, std::move(wrappedCpmContainer));
 
     /* Generate Sensor Information Container as detailed in ETSI TS 103 324, Section 6.1.2.2 */
     if (now - m_T_LastSensorInfoContainer >= m_T_AddSensorInformation)
@@ -364,18 +333,18 @@ namespace ns3 {
         auto refPos = asn1cpp::makeSeq (CartesianPosition3d);
         asn1cpp::setField (refPos->xCoordinate, egoPos.x);
         asn1cpp::setField (refPos->yCoordinate, egoPos.y);
-        asn1cpp::setField (circularArea->shapeReferencePoint, refPos);
+        asn1cpp::setField (circularArea->shapeReferencePoint, std::move(refPos));
         asn1cpp::setField (circularArea->radius, 50);
-        asn1cpp::setField (detectionArea->choice.circular, circularArea);
-        asn1cpp::setField (sensorInfo->perceptionRegionShape, detectionArea);
+        asn1cpp::setField (detectionArea->choice.circular, std::move(circularArea));
+        asn1cpp::setField (sensorInfo->perceptionRegionShape, std::move(detectionArea));
 
-        asn1cpp::sequenceof::pushList (*sensorInfoContainer, sensorInfo);
+        asn1cpp::sequenceof::pushList (*sensorInfoContainer, std::move(sensorInfo));
 
         asn1cpp::setField (CPMcontainer->containerData.present,
                            WrappedCpmContainer__containerData_PR_SensorInformationContainer);
         asn1cpp::setField (CPMcontainer->containerData.choice.SensorInformationContainer,
-                           sensorInfoContainer);
-        asn1cpp::sequenceof::pushList (cpm->payload.cpmContainers, CPMcontainer);
+                           std::move(sensorInfoContainer));
+        asn1cpp::sequenceof::pushList (cpm->payload.cpmContainers, std::move(CPMcontainer));
         m_T_LastSensorInfoContainer = now;
       }
     else
@@ -392,13 +361,19 @@ namespace ns3 {
         asn1cpp::setField (CPMcontainer->containerData.present,
                            WrappedCpmContainer__containerData_PR_PerceivedObjectContainer);
         asn1cpp::setField (CPMcontainer->containerData.choice.PerceivedObjectContainer,
-                           POsContainer);
-        asn1cpp::sequenceof::pushList(cpm->payload.cpmContainers,CPMcontainer);
+                           std::move(POsContainer));
+        asn1cpp::sequenceof::pushList(cpm->payload.cpmContainers,std::move(CPMcontainer));
+        pooledPOs = &cpm->payload.cpmContainers.list.array[cpm->payload.cpmContainers.list.count-1]
+                         ->containerData.choice.PerceivedObjectContainer.perceivedObjects;
       }
 
     // TODO: Support for Perception Region information from LDM (to be implemented in both SUMOensor and CARLAsensor)
 
-    encode_result = asn1cpp::uper::encode(cpm);
+    asn1cpp::uper::encode(cpm, encode_result);
+
+    // Give the pooled PerceivedObjects back to the pool, so that they are not freed together with the CPM
+    if (pooledPOs != nullptr)
+      pooledPOs->list.count = 0;
     if(encode_result.size()<1)
     {
         NS_LOG_ERROR("Warning: unable to encode CPM.");
@@ -465,12 +440,9 @@ namespace ns3 {
   CPBasicService::receiveCpm (BTPDataIndication_t dataIndication, Address from)
   {
     Ptr<Packet> packet;
-    asn1cpp::Seq<CollectivePerceptionMessage> decoded_cpm,cpm_test;
 
-    uint8_t *buffer; //= new uint8_t[packet->GetSize ()];
-    buffer=(uint8_t *)malloc((dataIndication.data->GetSize ())*sizeof(uint8_t));
-    dataIndication.data->CopyData (buffer, dataIndication.data->GetSize ());
-    std::string packetContent((char *)buffer,(int) dataIndication.data->GetSize ());
+    const uint8_t *buffer = btp::getPayloadView (dataIndication, m_rxBuffer);
+    uint32_t bufferSize = dataIndication.data->GetSize ();
 
     RssiTag rssi;
     bool rssi_result = dataIndication.data->PeekPacketTag(rssi);
@@ -515,13 +487,15 @@ namespace ns3 {
 
 
     /** Decoding **/
-    decoded_cpm = asn1cpp::uper::decodeASN(packetContent, CollectivePerceptionMessage);
+    DecodedMessageCache<CollectivePerceptionMessage>::DecodedPtr_t decoded_cpm_ptr = DecodedMessageCache<CollectivePerceptionMessage>::Get ().Decode (buffer, bufferSize, &asn_DEF_CollectivePerceptionMessage);
 
-    if(bool(decoded_cpm)==false) {
+    if(decoded_cpm_ptr==nullptr) {
         NS_LOG_ERROR("Warning: unable to decode a received CPM.");
         return;
       }
 
+    const asn1cpp::Seq<CollectivePerceptionMessage> &decoded_cpm = *decoded_cpm_ptr;
+
     if(m_CPReceiveCallback!=nullptr) {
         m_CPReceiveCallback(decoded_cpm,from);
       }
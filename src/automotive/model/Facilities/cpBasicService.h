@@ -152,11 +152,9 @@ private:
   void generateAndEncodeCPM();
   int64_t computeTimestampUInt64();
   /**
-   * @brief Evaluate the conditions for the generation of a CPM as defined in ETSI TS 103 324 V2.1.1 (2023-06) Section 6.1.2.3
-   * @param it  The iterator of the vehicle data to be checked.
-   * @return
+   * @brief Get the i-th PerceivedObject of the pool, allocating it (with all the optional fields filled by generateAndEncodeCPM()) if needed.
    */
-  bool checkCPMconditions(std::vector<LDM::returnedVehicleData_t>::iterator it);
+  PerceivedObject_t *getPooledPO(size_t i);
   double cartesian_dist(double lon1, double lat1, double lon2, double lat2);
 
   std::function<void(asn1cpp::Seq<CollectivePerceptionMessage>, Address)> m_CPReceiveCallback;  //! Callback function for received CPMs
@@ -187,6 +185,8 @@ private:
   Ptr<LDM> m_LDM; //! LDM object
 
   StationID_t m_station_id; //! Station ID of the ITS-S
+  std::string m_encodeBuffer; //! Buffer reused to encode every CPM, to avoid allocating a new one each time
+  std::vector<uint8_t> m_rxBuffer; //! Buffer reused to receive a CPM, when no view on the GeoNetworking receive buffer is available (see btp::getPayloadView())
   StationType_t m_stationtype; //! Station type of the ITS-S
 
   // Previous Cpm relevant values
@@ -195,6 +195,9 @@ private:
   double m_prev_speed;
   std::vector<long> m_lastCPM_POs; // Last Perceived Objects included in the previous CPM
 
+  std::vector<vehicleData_t *> m_CPM_POs; //! POs to be included in the current CPM (the vector is reused at each generation)
+  std::vector<asn1cpp::Seq<PerceivedObject>> m_POPool; //! PerceivedObject structures reused at each generation, to avoid allocating them for each object
+
 
   // The CP Basic Service can count up to 18446744073709551615 (UINT64_MAX) Cpms
   uint64_t m_cpm_sent; //! Statistic: number of CPMs successfully sent since the CP Basic Service has been started
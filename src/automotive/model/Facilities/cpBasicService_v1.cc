@@ -24,6 +24,7 @@
 #include "ns3/timestamp-tag.h"
 #include "ns3/rsrp-tag.h"
 #include "ns3/size-tag.h"
+#include "ns3/decodedMessageCache.h"
 
 namespace ns3 {
 
@@ -220,27 +221,27 @@ CPBasicServiceV1::generateAndEncodeCPM()
                   else
                     asn1cpp::setField(angle->value,CartesianAngleValue_unavailable);
                   asn1cpp::setField(angle->confidence,AngleConfidenceV1_unavailable);
-                  asn1cpp::setField(PO->yawAngle,angle);
+                  asn1cpp::setField(PO->yawAngle,std::move(angle));
                   auto OD1 = asn1cpp::makeSeq(ObjectDimensionV1);
                   if(it->vehData.vehicleLength.getData() < 1023 && it->vehData.vehicleLength.getData() > 0)
                     asn1cpp::setField(OD1->value,it->vehData.vehicleLength.getData());
                   else
                     asn1cpp::setField(OD1->value,50);//usual value for SUMO vehicles
                   asn1cpp::setField(OD1->confidence,ObjectDimensionConfidenceV1_unavailable);
-                  asn1cpp::setField(PO->planarObjectDimension1,OD1);
+                  asn1cpp::setField(PO->planarObjectDimension1,std::move(OD1));
                   auto OD2 = asn1cpp::makeSeq(ObjectDimensionV1);
                   if(it->vehData.vehicleWidth.getData() < 1023 && it->vehData.vehicleWidth.getData() > 0)
                     asn1cpp::setField(OD2->value,it->vehData.vehicleWidth.getData());
                   else
                     asn1cpp::setField(OD2->value,18);//usual value for SUMO vehicles
                   asn1cpp::setField(OD2->confidence,ObjectDimensionConfidenceV1_unavailable);
-                  asn1cpp::setField(PO->planarObjectDimension2,OD2);
+                  asn1cpp::setField(PO->planarObjectDimension2,std::move(OD2));
                   asn1cpp::setField(PO->objectRefPoint,ObjectRefPointV1_topMid);
 
                   /*Rest of optional fields handling left as future work*/
 
                   //Push Perceived Object to the container
-                  asn1cpp::sequenceof::pushList(*POsContainer,PO);
+                  asn1cpp::sequenceof::pushList(*POsContainer,std::move(PO));
                   //Update the timestamp of the last time this PO was included in a CPM
                   m_LDM->updateCPMincluded (it->vehData.stationID,computeTimestampUInt64 ()/NANO_TO_MILLI);
                   //Increase number of POs for the numberOfPerceivedObjects field in cpmParameters container
@@ -248,7 +249,7 @@ CPBasicServiceV1::generateAndEncodeCPM()
                 }
             }
           if(numberOfPOs != 0)
-            asn1cpp::setField(cpm->cpm.cpmParameters.perceivedObjectContainer,POsContainer);
+            asn1cpp::setField(cpm->cpm.cpmParameters.perceivedObjectContainer,std::move(POsContainer));
         }
     }
 
@@ -273,11 +274,11 @@ CPBasicServiceV1::generateAndEncodeCPM()
       asn1cpp::setField(property->range,50);
       asn1cpp::setField(property->horizontalOpeningAngleStart,0);
       asn1cpp::setField(property->horizontalOpeningAngleEnd,3600);//360 degrees
-      asn1cpp::sequenceof::pushList(detectionArea->choice.vehicleSensor.vehicleSensorPropertyList,property);
-      asn1cpp::setField(sensorInfo->detectionArea,detectionArea);
+      asn1cpp::sequenceof::pushList(detectionArea->choice.vehicleSensor.vehicleSensorPropertyList,std::move(property));
+      asn1cpp::setField(sensorInfo->detectionArea,std::move(detectionArea));
       //We ommit free space confidence
-      asn1cpp::sequenceof::pushList(*sensorInfoContainer,sensorInfo);
-      asn1cpp::setField(cpm->cpm.cpmParameters.sensorInformationContainer,sensorInfoContainer);
+      asn1cpp::sequenceof::pushList(*sensorInfoContainer,std::move(sensorInfo));
+      asn1cpp::setField(cpm->cpm.cpmParameters.sensorInformationContainer,std::move(sensorInfoContainer));
 
       m_T_LastSensorInfoContainer = now;
     }
@@ -330,24 +331,25 @@ CPBasicServiceV1::generateAndEncodeCPM()
   auto vehicleLength = asn1cpp::makeSeq(VehicleLength);
   asn1cpp::setField(vehicleLength->vehicleLengthValue, cpm_mandatory_data.VehicleLength.getValue());
   asn1cpp::setField(vehicleLength->vehicleLengthConfidenceIndication, cpm_mandatory_data.VehicleLength.getConfidence());
-  asn1cpp::setField(stationDataContainer->choice.originatingVehicleContainer.vehicleLength,vehicleLength);
+  asn1cpp::setField(stationDataContainer->choice.originatingVehicleContainer.vehicleLength,std::move(vehicleLength));
 
   asn1cpp::setField(stationDataContainer->choice.originatingVehicleContainer.vehicleWidth, cpm_mandatory_data.VehicleWidth);
 
   auto longAcc = asn1cpp::makeSeq(LongitudinalAcceleration);
   asn1cpp::setField(longAcc->longitudinalAccelerationValue, cpm_mandatory_data.longAcceleration.getValue ());
   asn1cpp::setField(longAcc->longitudinalAccelerationConfidence, cpm_mandatory_data.longAcceleration.getConfidence ());
-  asn1cpp::setField(stationDataContainer->choice.originatingVehicleContainer.longitudinalAcceleration,longAcc);
+  asn1cpp::setField(stationDataContainer->choice.originatingVehicleContainer.longitudinalAcceleration,std::move(longAcc));
 
   auto yawRate = asn1cpp::makeSeq(YawRate);
   asn1cpp::setField(yawRate->yawRateValue, cpm_mandatory_data.yawRate.getValue ());
   asn1cpp::setField(yawRate->yawRateConfidence, cpm_mandatory_data.yawRate.getConfidence ());
-  asn1cpp::setField(stationDataContainer->choice.originatingVehicleContainer.yawRate,yawRate);
+  asn1cpp::setField(stationDataContainer->choice.originatingVehicleContainer.yawRate,std::move(yawRate));
 
-  asn1cpp::setField(cpm->cpm.cpmParameters.stationDataContainer, stationDataContainer);
+  asn1cpp::setField(cpm->cpm.cpmParameters.stationDataContainer, std::move(stationDataContainer));
 
 
-  std::string encode_result = asn1cpp::uper::encode(cpm);
+  std::string &encode_result = m_encodeBuffer;
+  asn1cpp::uper::encode(cpm, encode_result);
 
   if(encode_result.size()<1)
     {
@@ -414,12 +416,9 @@ void
 CPBasicServiceV1::receiveCpm (BTPDataIndication_t dataIndication, Address from)
 {
   Ptr<Packet> packet;
-  asn1cpp::Seq<CPMV1> decoded_cpm,cpm_test;
 
-  uint8_t *buffer; //= new uint8_t[packet->GetSize ()];
-  buffer=(uint8_t *)malloc((dataIndication.data->GetSize ())*sizeof(uint8_t));
-  dataIndication.data->CopyData (buffer, dataIndication.data->GetSize ());
-  std::string packetContent((char *)buffer,(int) dataIndication.data->GetSize ());
+  const uint8_t *buffer = btp::getPayloadView (dataIndication, m_rxBuffer);
+  uint32_t bufferSize = dataIndication.data->GetSize ();
 
   RssiTag rssi;
   bool rssi_result = dataIndication.data->PeekPacketTag(rssi);
@@ -464,13 +463,15 @@ CPBasicServiceV1::receiveCpm (BTPDataIndication_t dataIndication, Address from)
 
 
   /** Decoding **/
-  decoded_cpm = asn1cpp::uper::decodeASN(packetContent, CPMV1);
+  DecodedMessageCache<CPMV1>::DecodedPtr_t decoded_cpm_ptr = DecodedMessageCache<CPMV1>::Get ().Decode (buffer, bufferSize, &asn_DEF_CPMV1);
 
-  if(bool(decoded_cpm)==false) {
+  if(decoded_cpm_ptr==nullptr) {
       NS_LOG_ERROR("Warning: unable to decode a received CPM.");
       return;
     }
 
+  const asn1cpp::Seq<CPMV1> &decoded_cpm = *decoded_cpm_ptr;
+
   m_CPReceiveCallback(decoded_cpm,from);
 }
 int64_t
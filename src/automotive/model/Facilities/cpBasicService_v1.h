@@ -107,6 +107,8 @@ private:
   Ptr<LDM> m_LDM;
 
   StationID_t m_station_id;
+  std::string m_encodeBuffer; //! Buffer reused to encode every CPM, to avoid allocating a new one each time
+  std::vector<uint8_t> m_rxBuffer; //! Buffer reused to receive a CPM, when no view on the GeoNetworking receive buffer is available (see btp::getPayloadView())
   StationType_t m_stationtype;
 
   // Previous Cpm relevant values
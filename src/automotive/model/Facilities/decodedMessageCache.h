@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef DECODEDMESSAGECACHE_H
+#define DECODEDMESSAGECACHE_H
+
+#include <string>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/Seq.hpp"
+#include "ns3/Encoding.hpp"
+#include "ns3/rx-allocation-counter.h"
+
+namespace ns3
+{
+  /**
+   * \brief Simulation-wide cache of decoded facilities messages (CAM, CPM, VAM, DENM, ...).
+   *
+   * When a message is broadcast, every receiver gets exactly the same bytes at (almost) the same simulated time.
+   * Instead of decoding the same UPER buffer once per receiver, the first receiver decodes it and stores the
+   * result here; the other receivers get a reference-counted pointer to the same immutable asn1cpp::Seq.
+   *
+   * Entries are keyed by the whole message content (not by a hash of it, nor by the packet UID, which is not
+   * preserved across GeoNetworking/BTP and the emulation interfaces), so two different messages are never mixed up.
+   * As a receiver has no way to know how many other receivers are still waiting for the same message, the entries
+   * are evicted after a short time to live (all the receptions of a broadcast are completed within a few
+   * microseconds to milliseconds), or when the cache grows beyond a maximum number of entries. A receiver still
+   * holding an evicted entry keeps it alive until it releases its pointer.
+   */
+  template <typename T>
+  class DecodedMessageCache
+  {
+  public:
+    typedef std::shared_ptr<const asn1cpp::Seq<T>> DecodedPtr_t;
+
+    /**
+     * \brief Get the cache of messages of type T (one cache per message type, shared by the whole simulation).
+     */
+    static DecodedMessageCache<T> &Get (void)
+    {
+      static DecodedMessageCache<T> cache;
+      return cache;
+    }
+
+    /**
+     * \brief Decode a UPER-encoded message, or return the already decoded copy of the same content.
+     *
+     * The message is decoded directly from "content" (usually a view on the GeoNetworking receive buffer, see
+     * btp::getPayloadView()), which is not retained after the call.
+     *
+     * \return A pointer to the decoded message, or an empty pointer if the message cannot be decoded
+     * (failed decodings are never cached).
+     */
+    DecodedPtr_t Decode (const uint8_t *content, size_t size, asn_TYPE_descriptor_t *def)
+    {
+      if (!m_enabled)
+        {
+          return decodeContent (content, size, def);
+        }
+
+      Time now = Simulator::Now ();
+      evictExpired (now);
+
+      // the lookup key is copied into a buffer reused for every lookup, which is allocated only once
+      size_t capacity = m_lookupKey.capacity ();
+      m_lookupKey.assign ((const char *) content, size);
+      if (m_lookupKey.capacity () != capacity)
+        {
+          RxAllocationCounter::Notify ();
+        }
+
+      auto it = m_entries.find (m_lookupKey);
+      if (it != m_entries.end ())
+        {
+          m_hits++;
+          return it->second;
+        }
+
+      m_misses++;
+      DecodedPtr_t decoded = decodeContent (content, size, def);
+      if (decoded == nullptr)
+        {
+          return decoded;
+        }
+
+      if (m_entries.size () >= m_maxEntries && !m_expiry.empty ())
+        {
+          evictOldest ();
+        }
+
+      // the keys of an unordered_map are never moved, even when it is rehashed
+      auto inserted = m_entries.emplace (m_lookupKey, decoded);
+      m_expiry.emplace_back (now + m_timeToLive, &inserted.first->first);
+
+      return decoded;
+    }
+
+    void SetEnabled (bool enabled) {m_enabled = enabled; if (!enabled) Clear ();}
+    bool IsEnabled (void) const {return m_enabled;}
+    void SetTimeToLive (Time ttl) {m_timeToLive = ttl;}
+    void SetMaxEntries (size_t max_entries) {m_maxEntries = max_entries > 0 ? max_entries : 1;}
+
+    void Clear (void) {m_expiry.clear (); m_entries.clear ();}
+
+    size_t GetSize (void) const {return m_entries.size ();}
+    uint64_t GetHits (void) const {return m_hits;}
+    uint64_t GetMisses (void) const {return m_misses;}
+
+  private:
+    DecodedMessageCache () = default;
+    DecodedMessageCache (const DecodedMessageCache &) = delete;
+    DecodedMessageCache &operator= (const DecodedMessageCache &) = delete;
+
+    static DecodedPtr_t decodeContent (const uint8_t *content, size_t size, asn_TYPE_descriptor_t *def)
+    {
+      asn1cpp::Seq<T> decoded = asn1cpp::uper::decode<T> (def, content, size);
+
+      if (bool (decoded) == false)
+        {
+          return DecodedPtr_t ();
+        }
+
+      // a new message has been decoded (the structure allocated by asn1c is moved, not copied, into the shared pointer)
+      RxAllocationCounter::Notify ();
+
+      return std::make_shared<const asn1cpp::Seq<T>> (std::move (decoded));
+    }
+
+    void evictExpired (Time now)
+    {
+      // the entries are inserted with a constant time to live, so the queue is ordered by expiration time;
+      // if the simulator is restarted, the old entries are still valid, as they are keyed by content
+      while (!m_expiry.empty () && m_expiry.front ().first <= now)
+        {
+          evictOldest ();
+        }
+    }
+
+    void evictOldest (void)
+    {
+      // erase by iterator, as the key pointed by the queue belongs to the erased element itself
+      auto it = m_entries.find (*m_expiry.front ().second);
+      m_expiry.pop_front ();
+      if (it != m_entries.end ())
+        {
+          m_entries.erase (it);
+        }
+    }
+
+    std::unordered_map<std::string, DecodedPtr_t> m_entries;
+    std::deque<std::pair<Time, const std::string *>> m_expiry;
+    std::string m_lookupKey;
+
+    bool m_enabled = true;
+    Time m_timeToLive = MilliSeconds (10);
+    size_t m_maxEntries = 65536;
+
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+  };
+}
+
+#endif // DECODEDMESSAGECACHE_H
@@ -33,6 +33,7 @@
 #include "ns3/sinr-tag.h"
 #include "ns3/timestamp-tag.h"
 #include "ns3/size-tag.h"
+#include "ns3/decodedMessageCache.h"
 
 namespace ns3 {
 
@@ -49,6 +50,8 @@ namespace ns3 {
 
     m_DENReceiveCallback = nullptr;
     m_DENReceiveCallbackExtended = nullptr;
+
+    m_timerQueue.setExpireCallback (std::bind(&DENBasicService::DENTimerExpired,this,std::placeholders::_1,std::placeholders::_2));
   }
 
   bool
@@ -57,19 +60,56 @@ namespace ns3 {
     return m_station_id!=ULONG_MAX && m_stationtype!=LONG_MAX;
   }
 
-    template<typename MEM_PTR> void
-     DENBasicService::setDENTimer(Timer &timer,Time delay,MEM_PTR callback_fcn,DEN_ActionID_t actionID) {
-      if(timer.IsRunning ())
-        {
-           timer.Cancel();
-        }
+  void
+  DENBasicService::setDENTimer(uint64_t key,uint8_t timer,Time delay)
+  {
+    DENMTableEntry_t *entry = m_DENMTable.find (key);
+    if(entry==nullptr)
+      {
+        return;
+      }
 
-      timer.SetFunction(callback_fcn,this);
-      timer.SetArguments(actionID);
-      timer.SetDelay (delay);
+    // Restarting a timer supersedes its previous deadline, which is skipped by the queue
+    m_timerQueue.schedule ((key << 2) | timer,Simulator::Now () + delay);
+  }
 
-      timer.Schedule ();
-    }
+  void
+  DENBasicService::stopOriginatingTimers(uint64_t key)
+  {
+    m_timerQueue.cancel ((key << 2) | V_O_VALIDITY_INDEX);
+    m_timerQueue.cancel ((key << 2) | T_REPETITION_INDEX);
+    m_timerQueue.cancel ((key << 2) | T_REPETITION_DURATION_INDEX);
+  }
+
+  void
+  DENBasicService::DENTimerExpired(uint64_t handle,Time)
+  {
+    uint64_t key = handle >> 2;
+    uint8_t timer = handle & 0x03;
+
+    // The timers which have been stopped or restarted are already skipped by the queue
+    if(m_DENMTable.find (key)==nullptr)
+      {
+        return;
+      }
+
+    DEN_ActionID_t actionid = ActionIDTable<DENMTableEntry_t>::unpackActionID (key);
+    switch(timer)
+      {
+        case V_O_VALIDITY_INDEX:
+          T_O_ValidityStop (actionid);
+          break;
+        case T_REPETITION_INDEX:
+          T_RepetitionStop (actionid);
+          break;
+        case T_REPETITION_DURATION_INDEX:
+          T_RepetitionDurationStop (actionid);
+          break;
+        default:
+          T_R_ValidityStop (actionid);
+          break;
+      }
+  }
 
   DENBasicService_error_t
   DENBasicService::fillDENM(asn1cpp::Seq<DENM> &denm, denData &data, const DEN_ActionID_t actionID,long referenceTimeLong)
@@ -135,7 +175,7 @@ namespace ns3 {
              asn1cpp::setField(causeCode->causeCode,situation_data.getData ().linkedCauseCode.getData ());
              asn1cpp::setField(causeCode->subCauseCode,situation_data.getData ().linkedSubCauseCode.getData ());
 
-             asn1cpp::setField(situation_seq->linkedCause,causeCode);
+             asn1cpp::setField(situation_seq->linkedCause,std::move(causeCode));
            }
 
          if(situation_data.getData ().eventHistory.isAvailable ())
@@ -154,10 +194,10 @@ namespace ns3 {
                  if(eventPoint_data.eventDeltaTime.isAvailable ())
                    asn1cpp::setField(eventPoint_seq->eventDeltaTime,eventPoint_data.eventDeltaTime.getData ());
 
-                 asn1cpp::sequenceof::pushList(situation_seq->eventHistory, eventPoint_seq);
+                 asn1cpp::sequenceof::pushList(situation_seq->eventHistory, std::move(eventPoint_seq));
                }
            }
-         asn1cpp::setField(denm->denm.situation,situation_seq);
+         asn1cpp::setField(denm->denm.situation,std::move(situation_seq));
       }
 
     /* Location container */
@@ -182,9 +222,9 @@ namespace ns3 {
                 if(location_data.getData ().traces[i][j].pathDeltaTime.isAvailable ())
                   asn1cpp::setField(pathPoint->pathDeltaTime,location_data.getData ().traces[i][j].pathDeltaTime.getData ());
 
-                asn1cpp::sequenceof::pushList(*pathHistory,pathPoint);
+                asn1cpp::sequenceof::pushList(*pathHistory,std::move(pathPoint));
               }
-            asn1cpp::sequenceof::pushList(location_seq->traces,pathHistory);
+            asn1cpp::sequenceof::pushList(location_seq->traces,std::move(pathHistory));
           }
 
 
@@ -194,7 +234,7 @@ namespace ns3 {
             asn1cpp::setField(eventSpeed->speedValue,location_data.getData ().eventSpeed.getData ().getValue ());
             asn1cpp::setField(eventSpeed->speedConfidence,location_data.getData ().eventSpeed.getData ().getConfidence ());
 
-            asn1cpp::setField(location_seq->eventSpeed,eventSpeed);
+            asn1cpp::setField(location_seq->eventSpeed,std::move(eventSpeed));
           }
 
         if(location_data.getData ().eventPositionHeading.isAvailable ())
@@ -203,13 +243,13 @@ namespace ns3 {
             asn1cpp::setField(eventHeading->headingValue,location_data.getData ().eventPositionHeading.getData ().getValue ());
             asn1cpp::setField(eventHeading->headingConfidence,location_data.getData ().eventPositionHeading.getData ().getConfidence ());
 
-            asn1cpp::setField(location_seq->eventPositionHeading,eventHeading);
+            asn1cpp::setField(location_seq->eventPositionHeading,std::move(eventHeading));
           }
 
         if(location_data.getData ().roadType.isAvailable ())
             asn1cpp::setField(location_seq->roadType,location_data.getData ().roadType.getData ());
 
-        asn1cpp::setField(denm->denm.location,location_seq);
+        asn1cpp::setField(denm->denm.location,std::move(location_seq));
       }
 
     /* A la carte container */
@@ -247,7 +287,7 @@ namespace ns3 {
             asn1cpp::setField(impactReduction->vehicleMass,alacarte_data.getData ().impactReduction.getData ().vehicleMass);
             asn1cpp::setField(impactReduction->requestResponseIndication, alacarte_data.getData ().impactReduction.getData ().requestResponseIndication);
 
-            asn1cpp::setField(alacarte_seq->impactReduction,impactReduction);
+            asn1cpp::setField(alacarte_seq->impactReduction,std::move(impactReduction));
           }
 
 
@@ -280,7 +320,7 @@ namespace ns3 {
                     asn1cpp::bitstring::setBit(closedLanes->drivingLaneStatus,setByteMask(roadworks_data.drivingLaneStatus.getData (),1),1);
                   }
 
-                asn1cpp::setField(roadworks->closedLanes,closedLanes);
+                asn1cpp::setField(roadworks->closedLanes,std::move(closedLanes));
               }
 
             if(roadworks_data.restriction.isAvailable ())
@@ -298,7 +338,7 @@ namespace ns3 {
                 asn1cpp::setField(incidentInd_seq->causeCode,roadworks_data.causeCode.getData ());
                 asn1cpp::setField(incidentInd_seq->subCauseCode,roadworks_data.subCauseCode.getData ());
 
-                asn1cpp::setField(roadworks->incidentIndication,incidentInd_seq);
+                asn1cpp::setField(roadworks->incidentIndication,std::move(incidentInd_seq));
               }
 
             if(roadworks_data.recommendedPath.isAvailable ())
@@ -316,7 +356,7 @@ namespace ns3 {
                     asn1cpp::setField(refPos_seq->altitude.altitudeValue,refPos_data.altitude.getValue ());
                     asn1cpp::setField(refPos_seq->altitude.altitudeConfidence,refPos_data.altitude.getConfidence ());
 
-                    asn1cpp::sequenceof::pushList(roadworks->recommendedPath,refPos_seq);
+                    asn1cpp::sequenceof::pushList(roadworks->recommendedPath,std::move(refPos_seq));
                   }
               }
 
@@ -327,7 +367,7 @@ namespace ns3 {
                 asn1cpp::setField(startPointSLimit_seq->deltaLongitude,roadworks_data.startingPointSpeedLimit.getData ().deltaLongitude);
                 asn1cpp::setField(startPointSLimit_seq->deltaAltitude,roadworks_data.startingPointSpeedLimit.getData ().deltaAltitude);
 
-                asn1cpp::setField(roadworks->startingPointSpeedLimit,startPointSLimit_seq);
+                asn1cpp::setField(roadworks->startingPointSpeedLimit,std::move(startPointSLimit_seq));
               }
 
             if(roadworks_data.trafficFlowRule.isAvailable ())
@@ -341,11 +381,11 @@ namespace ns3 {
                     asn1cpp::setField(actionId_seq->originatingStationId,roadworks_data.referenceDenms.getData ()[i].originatingStationID);
                     asn1cpp::setField(actionId_seq->sequenceNumber,roadworks_data.referenceDenms.getData ()[i].sequenceNumber);
 
-                    asn1cpp::sequenceof::pushList(roadworks->referenceDenms,actionId_seq);
+                    asn1cpp::sequenceof::pushList(roadworks->referenceDenms,std::move(actionId_seq));
                   }
               }
 
-            asn1cpp::setField(alacarte_seq->roadWorks,roadworks);
+            asn1cpp::setField(alacarte_seq->roadWorks,std::move(roadworks));
           }
 
         if(alacarte_data.getData ().positioningSolution.isAvailable ())
@@ -365,7 +405,7 @@ namespace ns3 {
                 asn1cpp::setField(stationaryCause_seq->causeCode,stationary_veh_data.causeCode.getData ());
                 asn1cpp::setField(stationaryCause_seq->subCauseCode,stationary_veh_data.subCauseCode.getData ());
 
-                asn1cpp::setField(stationary_veh_seq->stationaryCause,stationaryCause_seq);
+                asn1cpp::setField(stationary_veh_seq->stationaryCause,std::move(stationaryCause_seq));
               }
 
             if(stationary_veh_data.carryingDangerousGoods.isAvailable ())
@@ -389,7 +429,7 @@ namespace ns3 {
                 if(dangerous_data.companyName.isAvailable ())
                   asn1cpp::setField(dangerous_seq->companyName,dangerous_data.companyName.getData ());
 
-                asn1cpp::setField(stationary_veh_seq->carryingDangerousGoods,dangerous_seq);
+                asn1cpp::setField(stationary_veh_seq->carryingDangerousGoods,std::move(dangerous_seq));
               }
 
             if(stationary_veh_data.numberOfOccupants.isAvailable ())
@@ -405,7 +445,7 @@ namespace ns3 {
                 if(stationary_veh_data.vehicleIdentification.getData ().vDS.isAvailable ())
                   asn1cpp::setField(vehicleId_seq->vDS,stationary_veh_data.vehicleIdentification.getData ().vDS.getData ());
 
-                asn1cpp::setField(stationary_veh_seq->vehicleIdentification,vehicleId_seq);
+                asn1cpp::setField(stationary_veh_seq->vehicleIdentification,std::move(vehicleId_seq));
               }
 
             if(stationary_veh_data.energyStorageType.isAvailable ())
@@ -413,11 +453,11 @@ namespace ns3 {
 
 
             //Add stationaryVehicle container to the Alacarte Container
-            asn1cpp::setField(alacarte_seq->stationaryVehicle,stationary_veh_seq);
+            asn1cpp::setField(alacarte_seq->stationaryVehicle,std::move(stationary_veh_seq));
           }
 
         //Add the Alacarte container to the DENM
-        asn1cpp::setField(denm->denm.alacarte,alacarte_seq);
+        asn1cpp::setField(denm->denm.alacarte,std::move(alacarte_seq));
 
       }
 
@@ -451,6 +491,8 @@ namespace ns3 {
     m_socket_tx = socket_tx;
     m_real_time = false;
     m_btp = NULL;
+
+    m_timerQueue.setExpireCallback (std::bind(&DENBasicService::DENTimerExpired,this,std::placeholders::_1,std::placeholders::_2));
   }
 
   void
@@ -530,7 +572,7 @@ namespace ns3 {
     actionid.originatingStationID = m_station_id;
     actionid.sequenceNumber = m_seq_number;
 
-    std::pair <unsigned long, long> map_index = std::make_pair((unsigned long)m_station_id,(long)m_seq_number);
+    uint64_t key = ActionIDTable<DENMTableEntry_t>::packActionID (actionid);
 
     m_seq_number++;
 
@@ -545,7 +587,8 @@ namespace ns3 {
 
     /* 6. 7. Construct DENM and pass it to the lower layers (now UDP, in the future BTP and GeoNetworking, then UDP) */
     /** Encoding **/
-    std::string encode_result = asn1cpp::uper::encode(denm);
+    std::string &encode_result = m_encodeBuffer;
+    asn1cpp::uper::encode(denm, encode_result);
 
     if(encode_result.size()<1)
     {
@@ -566,33 +609,29 @@ namespace ns3 {
     dataRequest.GNRepInt =0;
     dataRequest.GNMaxRepInt=0;
     dataRequest.GNMaxLife = 60;
-    dataRequest.GNMaxHL = 1;
+    dataRequest.GNMaxHL = m_maxHopLimit;
     dataRequest.GNTraClass = 0x01; // Store carry foward: no - Channel offload: no - Traffic Class ID: 1
     dataRequest.lenght = packet->GetSize ();
     dataRequest.data = packet;
 
-    /* 8. 9. Create an entry in the originating ITS-S message table and set the state to ACTIVE and start the T_O_Validity timer. */
-    /* As all the timers are stored, in this case, for each entry in the table, we have to set them before saving the new entry to a map, which is done as last operation. */
-    /* We are basically adding the current entry, containing the already UPER encoded DENM packet, to a map of <ActionID,ITSSOriginatingTableEntry> */
-    ITSSOriginatingTableEntry entry(*packet, ITSSOriginatingTableEntry::STATE_ACTIVE,actionid);
-
     m_btp->sendBTP(dataRequest);
 
-    m_originatingTimerTable.emplace(map_index,std::tuple<Timer,Timer,Timer>());
+    /* 8. 9. Create an entry in the originating ITS-S message table and set the state to ACTIVE and start the T_O_Validity timer. */
+    /* The entry contains the already UPER encoded DENM packet */
+    DENMTableEntry_t &table_entry = m_DENMTable[key];
+    table_entry.originating = true;
+    table_entry.originatingEntry = ITSSOriginatingTableEntry(*packet, ITSSOriginatingTableEntry::STATE_ACTIVE,actionid);
 
-    DENBasicService::setDENTimer(std::get<V_O_VALIDITY_INDEX>(m_originatingTimerTable[map_index]),Seconds(data.getDenmMgmtValidityDuration ()),&DENBasicService::T_O_ValidityStop,actionid);
+    setDENTimer(key,V_O_VALIDITY_INDEX,Seconds(data.getDenmMgmtValidityDuration ()));
 
     /* 10. Calculate and start timers T_RepetitionDuration and T_Repetition when both parameters in denData are > 0 */
     if(data.getDenmRepetitionDuration ()>0 && data.getDenmRepetitionInterval ()>0)
       {
-        DENBasicService::setDENTimer(std::get<T_REPETITION_INDEX>(m_originatingTimerTable[map_index]),MilliSeconds(data.getDenmRepetitionInterval()),&DENBasicService::T_RepetitionStop,actionid);
-        DENBasicService::setDENTimer(std::get<T_REPETITION_DURATION_INDEX>(m_originatingTimerTable[map_index]),MilliSeconds(data.getDenmRepetitionDuration ()),&DENBasicService::T_RepetitionDurationStop,actionid);
+        table_entry.repetitionInterval = MilliSeconds(data.getDenmRepetitionInterval());
+        setDENTimer(key,T_REPETITION_INDEX,table_entry.repetitionInterval);
+        setDENTimer(key,T_REPETITION_DURATION_INDEX,MilliSeconds(data.getDenmRepetitionDuration ()));
       }
 
-    /* 11. Finally create the entry after starting all the timers (it refers to the step '8' of appDENM_trigger in ETSI EN302 637-3 V1.3.1 */
-
-    m_originatingITSSTable[map_index]=entry;
-
     /* 12. Send actionID to the requesting ITS-S application. This is requested by the standard, but we are already reporting the actionID using &actionID */
 
     return DENM_NO_ERROR;
@@ -602,7 +641,7 @@ namespace ns3 {
   DENBasicService::appDENM_update(denData data, const DEN_ActionID_t actionid)
   {
     DENBasicService_error_t fillDENM_rval=DENM_NO_ERROR;
-    std::pair <unsigned long, long> map_index = std::make_pair((unsigned long)actionid.originatingStationID,(long)actionid.sequenceNumber);
+    uint64_t key = ActionIDTable<DENMTableEntry_t>::packActionID (actionid);
 
     if(!CheckMainAttributes ())
       {
@@ -625,21 +664,19 @@ namespace ns3 {
     if (compute_timestampIts (m_real_time) > data.getDenmMgmtDetectionTime () + (data.getDenmMgmtValidityDuration ()*MILLI))
         return DENM_T_O_VALIDITY_EXPIRED;
 
-    /* 2. Compare actionID in the application request with entries in the originating ITS-S message table (i.e. m_originatingITSSTable, implemented as a map) */
+    /* 2. Compare actionID in the application request with entries in the originating ITS-S message table (i.e. the originating part of m_DENMTable) */
     /* Gather also the proper entry in the table, if available. */
 
     T_Repetition_Mutex.lock();
-    std::map<std::pair<unsigned long,long>, ITSSOriginatingTableEntry>::iterator entry_map_it = m_originatingITSSTable.find(map_index);
-    if (entry_map_it == m_originatingITSSTable.end())
+    DENMTableEntry_t *table_entry = m_DENMTable.find (key);
+    if (table_entry == nullptr || !table_entry->originating)
       {
         T_Repetition_Mutex.unlock();
         return DENM_UNKNOWN_ACTIONID;
       }
 
-    /* 3. Stop T_O_Validity, T_RepetitionDuration and T_Repetition (if they were started - this check is already performed by the setTimer* methods) */
-    std::get<V_O_VALIDITY_INDEX>(m_originatingTimerTable[map_index]).Cancel();
-    std::get<T_REPETITION_INDEX>(m_originatingTimerTable[map_index]).Cancel();
-    std::get<T_REPETITION_DURATION_INDEX>(m_originatingTimerTable[map_index]).Cancel();
+    /* 3. Stop T_O_Validity, T_RepetitionDuration and T_Repetition (if they were started) */
+    stopOriginatingTimers (key);
 
     /* 4. 5. 6. Manage transmission interval, reference time and fill DENM */
     fillDENM_rval=fillDENM(denm,data,actionid,compute_timestampIts (m_real_time));
@@ -652,10 +689,12 @@ namespace ns3 {
 
     /* 7. 8. Construct DENM and pass it to the lower layers (now UDP, in the future BTP and GeoNetworking, then UDP) */
     /** Encoding **/
-    std::string encode_result = asn1cpp::uper::encode(denm);
+    std::string &encode_result = m_encodeBuffer;
+    asn1cpp::uper::encode(denm, encode_result);
 
     if(encode_result.size()<1)
     {
+      T_Repetition_Mutex.unlock();
       return DENM_ASN1_UPER_ENC_ERROR;
     }
 
@@ -672,7 +711,7 @@ namespace ns3 {
     dataRequest.GNRepInt =0;
     dataRequest.GNMaxRepInt=0;
     dataRequest.GNMaxLife = 60; // 60 seconds
-    dataRequest.GNMaxHL = 1;
+    dataRequest.GNMaxHL = m_maxHopLimit;
     dataRequest.GNTraClass = 0x01; // Store carry foward: no - Channel offload: no - Traffic Class ID: 1
     dataRequest.lenght = packet->GetSize ();
     dataRequest.data = packet;
@@ -680,16 +719,17 @@ namespace ns3 {
     m_btp->sendBTP(dataRequest);
 
     /* 9. Update the entry in the originating ITS-S message table. */
-    entry_map_it->second.setDENMPacket(*packet);
+    table_entry->originatingEntry.setDENMPacket(*packet);
 
     /* 10. Start timer T_O_Validity. */
-    DENBasicService::setDENTimer(std::get<V_O_VALIDITY_INDEX>(m_originatingTimerTable[map_index]),Seconds(data.getDenmMgmtValidityDuration ()),&DENBasicService::T_O_ValidityStop,actionid);
+    setDENTimer(key,V_O_VALIDITY_INDEX,Seconds(data.getDenmMgmtValidityDuration ()));
 
     /* 11. Calculate and start timers T_RepetitionDuration and T_Repetition when both parameters in denData are > 0 */
     if(data.getDenmRepetitionDuration ()>0 && data.getDenmRepetitionInterval ()>0)
       {
-        DENBasicService::setDENTimer(std::get<T_REPETITION_INDEX>(m_originatingTimerTable[map_index]),MilliSeconds(data.getDenmRepetitionInterval()),&DENBasicService::T_RepetitionStop,actionid);
-        DENBasicService::setDENTimer(std::get<T_REPETITION_DURATION_INDEX>(m_originatingTimerTable[map_index]),MilliSeconds(data.getDenmRepetitionDuration ()),&DENBasicService::T_RepetitionDurationStop,actionid);
+        table_entry->repetitionInterval = MilliSeconds(data.getDenmRepetitionInterval());
+        setDENTimer(key,T_REPETITION_INDEX,table_entry->repetitionInterval);
+        setDENTimer(key,T_REPETITION_DURATION_INDEX,MilliSeconds(data.getDenmRepetitionDuration ()));
       }
 
     T_Repetition_Mutex.unlock();
@@ -722,7 +762,7 @@ namespace ns3 {
         return DENM_ALLOC_ERROR;
       }
 
-    std::pair <unsigned long, long> map_index = std::make_pair((unsigned long)actionid.originatingStationID,(long)actionid.sequenceNumber);
+    uint64_t key = ActionIDTable<DENMTableEntry_t>::packActionID (actionid);
 
     /* 1. If validity is expired return DENM_T_O_VALIDITY_EXPIRED */
     if (compute_timestampIts (m_real_time) > data.getDenmMgmtDetectionTime () + (data.getDenmMgmtValidityDuration ()*MILLI))
@@ -731,61 +771,47 @@ namespace ns3 {
     /* 2. Compare actionID in the application request with entries in the originating ITS-S message table and the receiving ITS-S message table */
     T_Repetition_Mutex.lock();
 
-    std::map<std::pair<unsigned long,long>, ITSSOriginatingTableEntry>::iterator entry_originating_table = m_originatingITSSTable.find(map_index);
-    /* 2a. If actionID exists in the originating ITS-S message table and the entry state is ACTIVE, then set termination to isCancellation.*/
-    if (entry_originating_table != m_originatingITSSTable.end())
+    DENMTableEntry_t *table_entry = m_DENMTable.find (key);
+    if (table_entry == nullptr || (!table_entry->originating && !table_entry->receiving))
       {
         T_Repetition_Mutex.unlock();
-        return DENM_UNKNOWN_ACTIONID_ORIGINATING;
+        return DENM_UNKNOWN_ACTIONID;
       }
-    else if(entry_originating_table->second.getStatus()==ITSSOriginatingTableEntry::STATE_ACTIVE)
+
+    /* 2a. If actionID exists in the originating ITS-S message table and the entry state is ACTIVE, then set termination to isCancellation.*/
+    if (table_entry->originating)
       {
-        asn_termination=Termination_isCancellation;
-        if(!asn1cpp::setField(denm->denm.management.termination,asn_termination))
+        if(table_entry->originatingEntry.getStatus()!=ITSSOriginatingTableEntry::STATE_ACTIVE)
           {
             T_Repetition_Mutex.unlock();
-            return DENM_ALLOC_ERROR;
-          }
-        else
-          {
-            termination=0;
+            return DENM_NON_ACTIVE_ACTIONID_ORIGINATING;
           }
-      }
-    else
-      {
-        T_Repetition_Mutex.unlock();
-        return DENM_NON_ACTIVE_ACTIONID_ORIGINATING;
-      }
 
-    /* 2b. If actionID exists in the receiving ITS-S message table and the entry state is ACTIVE, then set termination to isNegation.*/
-    std::map<std::pair<unsigned long,long>, ITSSReceivingTableEntry>::iterator entry_receiving_table = m_receivingITSSTable.find(map_index);
-    if (entry_receiving_table != m_receivingITSSTable.end())
-      {
-        T_Repetition_Mutex.unlock();
-        return DENM_UNKNOWN_ACTIONID_RECEIVING;
+        asn_termination=Termination_isCancellation;
+        termination=0;
       }
-    else if(entry_receiving_table->second.getStatus()==ITSSReceivingTableEntry::STATE_ACTIVE)
+    /* 2b. If actionID exists in the receiving ITS-S message table and the entry state is ACTIVE, then set termination to isNegation.*/
+    else
       {
-        asn_termination=Termination_isNegation;
-        if(!asn1cpp::setField(denm->denm.management.termination,asn_termination))
+        if(table_entry->receivingEntry.getStatus()!=ITSSReceivingTableEntry::STATE_ACTIVE)
           {
             T_Repetition_Mutex.unlock();
-            return DENM_ALLOC_ERROR;
-          }
-        else
-          {
-            termination=1;
+            return DENM_NON_ACTIVE_ACTIONID_RECEIVING;
           }
+
+        asn_termination=Termination_isNegation;
+        termination=1;
       }
-    else
+
+    if(!asn1cpp::setField(denm->denm.management.termination,asn_termination))
       {
         T_Repetition_Mutex.unlock();
-        return DENM_NON_ACTIVE_ACTIONID_RECEIVING;
+        return DENM_ALLOC_ERROR;
       }
 
     if(termination==1)
       {
-        referenceTime=entry_receiving_table->second.getReferenceTime();
+        referenceTime=table_entry->receivingEntry.getReferenceTime();
 
         if(referenceTime==-1)
           {
@@ -807,20 +833,17 @@ namespace ns3 {
         return fillDENM_rval;
       }
 
-    /* 4a. Gather the proper timers from the timers table */
-    std::map<std::pair<unsigned long,long>, std::tuple<Timer,Timer,Timer>>::iterator entry_timers_table = m_originatingTimerTable.find(map_index);
-
-    /* 4b. Stop T_O_Validity, T_RepetitionDuration and T_Repetition (if they were started - this check is already performed by the setTimer* methods) */
-    std::get<V_O_VALIDITY_INDEX>(entry_timers_table->second).Cancel();
-    std::get<T_REPETITION_INDEX>(entry_timers_table->second).Cancel();
-    std::get<T_REPETITION_DURATION_INDEX>(entry_timers_table->second).Cancel();
+    /* 4. Stop T_O_Validity, T_RepetitionDuration and T_Repetition (if they were started) */
+    stopOriginatingTimers (key);
 
     /* 5. Construct DENM and pass it to the lower layers (now UDP, in the future BTP and GeoNetworking, then UDP) */
     /** Encoding **/
-    std::string encode_result = asn1cpp::uper::encode(denm);
+    std::string &encode_result = m_encodeBuffer;
+    asn1cpp::uper::encode(denm, encode_result);
 
     if(encode_result.size()<1)
     {
+      T_Repetition_Mutex.unlock();
       return DENM_ASN1_UPER_ENC_ERROR;
     }
 
@@ -838,7 +861,7 @@ namespace ns3 {
     dataRequest.GNRepInt =0;
     dataRequest.GNMaxRepInt=0;
     dataRequest.GNMaxLife = 60;
-    dataRequest.GNMaxHL = 1;
+    dataRequest.GNMaxHL = m_maxHopLimit;
     dataRequest.GNTraClass = 0x01; // Store carry foward: no - Channel offload: no - Traffic Class ID: 1
     dataRequest.lenght = packet->GetSize ();
     dataRequest.data = packet;
@@ -847,24 +870,25 @@ namespace ns3 {
     /* 6a. If termination is set to 1, create an entry in the originating ITS-S message table and set the state to NEGATED. */
     if(termination==1)
       {
-        ITSSOriginatingTableEntry entry(*packet, ITSSOriginatingTableEntry::STATE_NEGATED,actionid);
-        m_originatingITSSTable[map_index]=entry;
+        table_entry->originating = true;
+        table_entry->originatingEntry = ITSSOriginatingTableEntry(*packet, ITSSOriginatingTableEntry::STATE_NEGATED,actionid);
       }
     /* 6b. If termination is set to 0, update the entry in the originating ITS-S message table and set the state to CANCELLED. */
     else
       {
-        entry_originating_table->second.setDENMPacket(*packet);
-        entry_originating_table->second.setStatus(ITSSOriginatingTableEntry::STATE_CANCELLED);
+        table_entry->originatingEntry.setDENMPacket(*packet);
+        table_entry->originatingEntry.setStatus(ITSSOriginatingTableEntry::STATE_CANCELLED);
       }
 
     /* 7. Start timer T_O_Validity. */
-    DENBasicService::setDENTimer(std::get<V_O_VALIDITY_INDEX>(entry_timers_table->second),Seconds(data.getDenmMgmtValidityDuration ()),&DENBasicService::T_O_ValidityStop,actionid);
+    setDENTimer(key,V_O_VALIDITY_INDEX,Seconds(data.getDenmMgmtValidityDuration ()));
 
     /* 8. Calculate and start timers T_RepetitionDuration and T_Repetition when both parameters in denData are > 0 */
     if(data.getDenmRepetitionDuration ()>0 && data.getDenmRepetitionInterval ()>0)
       {
-        DENBasicService::setDENTimer(std::get<T_REPETITION_INDEX>(entry_timers_table->second),MilliSeconds(data.getDenmRepetitionInterval()),&DENBasicService::T_RepetitionStop,actionid);
-        DENBasicService::setDENTimer(std::get<T_REPETITION_DURATION_INDEX>(entry_timers_table->second),MilliSeconds(data.getDenmRepetitionDuration ()),&DENBasicService::T_RepetitionDurationStop,actionid);
+        table_entry->repetitionInterval = MilliSeconds(data.getDenmRepetitionInterval());
+        setDENTimer(key,T_REPETITION_INDEX,table_entry->repetitionInterval);
+        setDENTimer(key,T_REPETITION_DURATION_INDEX,MilliSeconds(data.getDenmRepetitionDuration ()));
       }
 
     T_Repetition_Mutex.unlock();
@@ -877,7 +901,6 @@ namespace ns3 {
   DENBasicService::receiveDENM(BTPDataIndication_t dataIndication,Address from)
   {
     Ptr<Packet> packet;
-    asn1cpp::Seq<DENM> decoded_denm;
     denData den_data;
     long validityDuration,termination;
     bool validity_ok,termination_ok;
@@ -885,14 +908,12 @@ namespace ns3 {
 
     long detectionTime_long;
     long referenceTime_long;
-    std::pair <unsigned long, long> map_index;
+    uint64_t key;
 
     packet = dataIndication.data;
 
-    uint8_t *buffer; //= new uint8_t[packet->GetSize ()];
-    buffer=(uint8_t *)malloc((packet->GetSize ())*sizeof(uint8_t));
-    packet->CopyData (buffer, packet->GetSize ());
-    std::string packetContent((char *)buffer,(int) dataIndication.data->GetSize ());
+    const uint8_t *buffer = btp::getPayloadView (dataIndication, m_rxBuffer);
+    uint32_t bufferSize = dataIndication.data->GetSize ();
 
     RssiTag rssi;
     bool rssi_result = dataIndication.data->PeekPacketTag(rssi);
@@ -938,7 +959,6 @@ namespace ns3 {
     if(!CheckMainAttributes ())
       {
         NS_LOG_ERROR("DENBasicService has unset parameters. Cannot receive any data.");
-        free(buffer);
         return;
       }
 
@@ -946,19 +966,19 @@ namespace ns3 {
     if (buffer[1]!=FIX_DENMID)
       {
         NS_LOG_ERROR("Warning: received a message which has messageID '"<<buffer[1]<<"' but '1' was expected.");
-        free(buffer);
         return;
       }
 
     /** Decoding **/
-    free(buffer);
-    decoded_denm = asn1cpp::uper::decodeASN(packetContent, DENM);
+    DecodedMessageCache<DENM>::DecodedPtr_t decoded_denm_ptr = DecodedMessageCache<DENM>::Get ().Decode (buffer, bufferSize, &asn_DEF_DENM);
 
-    if(bool(decoded_denm)==false) {
+    if(decoded_denm_ptr==nullptr) {
         NS_LOG_ERROR("Warning: unable to decode a received DENM.");
         return;
       }
 
+    const asn1cpp::Seq<DENM> &decoded_denm = *decoded_denm_ptr;
+
     /* Compute T_R_Validity expiration time */
     validityDuration = asn1cpp::getField(decoded_denm->denm.management.validityDuration,long,&validity_ok);
     if(!validity_ok)
@@ -978,13 +998,13 @@ namespace ns3 {
     /* Lookup entries in the receiving ITS-S message table with the received actionID */
     actionID.originatingStationID = asn1cpp::getField(decoded_denm->denm.management.actionID.originatingStationId,unsigned long);
     actionID.sequenceNumber = asn1cpp::getField(decoded_denm->denm.management.actionID.sequenceNumber,long);
-    map_index = std::make_pair((unsigned long)actionID.originatingStationID ,(long)actionID.sequenceNumber);
+    key = ActionIDTable<DENMTableEntry_t>::packActionID (actionID);
 
-    std::map<std::pair<unsigned long,long>, ITSSReceivingTableEntry>::iterator entry_rx_map_it = m_receivingITSSTable.find(map_index);
+    DENMTableEntry_t *table_entry = m_DENMTable.find (key);
 
     termination = asn1cpp::getField(decoded_denm->denm.management.termination,long,&termination_ok);
 
-    if (entry_rx_map_it == m_receivingITSSTable.end ())
+    if (table_entry == nullptr || !table_entry->receiving)
       {
         /* a. If entry does not exist in the receiving ITS-S message table, check if termination data exists in the
             received DENM. */
@@ -998,16 +1018,17 @@ namespace ns3 {
         else
           {
             /* if not, create an entry in the receiving ITS-S message table with the received DENM and set the state to ACTIVE (SSP is not yet implemented) */
-            ITSSReceivingTableEntry entry(*packet,ITSSReceivingTableEntry::STATE_ACTIVE,actionID,referenceTime_long,detectionTime_long);
-            m_receivingITSSTable[map_index]=entry;
+            DENMTableEntry_t &new_entry = m_DENMTable[key];
+            new_entry.receiving = true;
+            new_entry.receivingEntry = ITSSReceivingTableEntry(*packet,ITSSReceivingTableEntry::STATE_ACTIVE,actionID,referenceTime_long,detectionTime_long);
           }
       }
     else
       {
         /* b. If entry does exist in the receiving ITS-S message table, check if the received referenceTime is less than the entry referenceTime,
          * or the received detectionTime is less than the entry detectionTime */
-        long stored_reference_time = entry_rx_map_it->second.getReferenceTime ();
-        long stored_detection_time =  entry_rx_map_it->second.getDetectionTime ();
+        long stored_reference_time = table_entry->receivingEntry.getReferenceTime ();
+        long stored_detection_time =  table_entry->receivingEntry.getDetectionTime ();
 
         if (referenceTime_long < stored_reference_time || detectionTime_long < stored_detection_time)
           {
@@ -1025,8 +1046,8 @@ namespace ns3 {
             if(referenceTime_long == stored_reference_time &&
                detectionTime_long == stored_detection_time &&
                (
-                 (!termination_ok &&  !entry_rx_map_it->second.isTerminationSet()) ||
-                 (termination_ok && termination==entry_rx_map_it->second.getTermination ())
+                 (!termination_ok &&  !table_entry->receivingEntry.isTerminationSet()) ||
+                 (termination_ok && termination==table_entry->receivingEntry.getTermination ())
                ))
               {
                 /* 1. If yes, discard received DENM and omit execution of further steps. */
@@ -1038,18 +1059,14 @@ namespace ns3 {
                 /* 2. Otherwise, update the entry in receiving ITS-S message table, set entry state according
                  * to the termination value of the received DENM. (SSP is not yet implemented) */
                 ITSSReceivingTableEntry entry(*packet,ITSSReceivingTableEntry::STATE_ACTIVE,actionID,referenceTime_long,detectionTime_long,decoded_denm->denm.management.termination);
-                entry_rx_map_it->second=entry;
+                table_entry->receivingEntry=entry;
               }
           }
 
       }
 
     /* Start/restart T_R_Validity timer. */
-    if(m_T_R_Validity_Table.find(map_index) == m_T_R_Validity_Table.end()) {
-      m_T_R_Validity_Table[map_index] = Timer();
-    }
-
-    DENBasicService::setDENTimer(m_T_R_Validity_Table[map_index],Seconds((long)validityDuration),&DENBasicService::T_R_ValidityStop,actionID);
+    setDENTimer(key,T_R_VALIDITY_INDEX,Seconds((long)validityDuration));
 
     /* Fill den_data with the received information */
     bool location_ok,situation_ok,alacarte_ok;
@@ -1084,33 +1101,44 @@ namespace ns3 {
   DENBasicService::T_O_ValidityStop(DEN_ActionID_t entry_actionid)
   {
     T_Repetition_Mutex.lock ();
-    std::pair <unsigned long, long> map_index = std::make_pair((unsigned long)entry_actionid.originatingStationID,(long)entry_actionid.sequenceNumber);
+    uint64_t key = ActionIDTable<DENMTableEntry_t>::packActionID (entry_actionid);
 
-    std::get<T_REPETITION_INDEX>(m_originatingTimerTable[map_index]).Cancel();
-    std::get<T_REPETITION_DURATION_INDEX>(m_originatingTimerTable[map_index]).Cancel();
+    DENMTableEntry_t *table_entry = m_DENMTable.find (key);
+    if(table_entry!=nullptr)
+      {
+        // When an entry expires, discard also the information related to its (now stopped) timers
+        stopOriginatingTimers (key);
+        table_entry->originating = false;
+        table_entry->originatingEntry = ITSSOriginatingTableEntry();
 
-    // When an entry expires, discard also the information related to its (now stopped) timers
-    m_originatingTimerTable.erase (map_index);
-    m_originatingITSSTable.erase (map_index);
+        if(!table_entry->receiving)
+          {
+            m_DENMTable.erase (key);
+          }
+      }
     T_Repetition_Mutex.unlock ();
   }
 
   void
   DENBasicService::T_RepetitionDurationStop(DEN_ActionID_t entry_actionid)
   {
-    std::pair <unsigned long, long> map_index = std::make_pair((unsigned long)entry_actionid.originatingStationID,(long)entry_actionid.sequenceNumber);
-
-    std::get<T_REPETITION_INDEX>(m_originatingTimerTable[map_index]).Cancel();
+    m_timerQueue.cancel ((ActionIDTable<DENMTableEntry_t>::packActionID (entry_actionid) << 2) | T_REPETITION_INDEX);
   }
 
   void
   DENBasicService::T_RepetitionStop(DEN_ActionID_t entry_actionid)
   {
     T_Repetition_Mutex.lock();
-    std::pair <unsigned long, long> map_index = std::make_pair((unsigned long)entry_actionid.originatingStationID,(long)entry_actionid.sequenceNumber);
-    T_Repetition_Mutex.unlock ();
+    uint64_t key = ActionIDTable<DENMTableEntry_t>::packActionID (entry_actionid);
 
-    Ptr<Packet> packet = Create<Packet> (m_originatingITSSTable[map_index].getDENMPacket ());
+    DENMTableEntry_t *table_entry = m_DENMTable.find (key);
+    if(table_entry==nullptr || !table_entry->originating)
+      {
+        T_Repetition_Mutex.unlock ();
+        return;
+      }
+
+    Ptr<Packet> packet = Create<Packet> (table_entry->originatingEntry.getDENMPacket ());
     // We should never reach this point if m_socket_tx==NULL (i.e. the corresponding timer will never be started)
     // So, it should not be necessary to check that m_socket_tx!=NULL
 
@@ -1125,47 +1153,44 @@ namespace ns3 {
     dataRequest.GNRepInt = 0;
     dataRequest.GNMaxRepInt = 0;
     dataRequest.GNMaxLife = 60;
-    dataRequest.GNMaxHL = 1;
+    dataRequest.GNMaxHL = m_maxHopLimit;
     dataRequest.GNTraClass = 0x01; // Store carry foward: no - Channel offload: no - Traffic Class ID: 1
     dataRequest.lenght = packet->GetSize ();
     dataRequest.data = packet;
     m_btp->sendBTP(dataRequest);
 
     // Restart timer
-    std::get<T_REPETITION_INDEX>(m_originatingTimerTable[map_index]).Schedule();
+    setDENTimer(key,T_REPETITION_INDEX,table_entry->repetitionInterval);
+    T_Repetition_Mutex.unlock ();
   }
 
   void
   DENBasicService::T_R_ValidityStop(DEN_ActionID_t entry_actionid)
   {
     T_Repetition_Mutex.lock();
-    std::pair <unsigned long, long> map_index = std::make_pair((unsigned long)entry_actionid.originatingStationID,(long)entry_actionid.sequenceNumber);
+    uint64_t key = ActionIDTable<DENMTableEntry_t>::packActionID (entry_actionid);
 
-    // When an entry expires, discard also the information related to its (now stopped) timers
-    m_T_R_Validity_Table.erase (map_index);
-    m_receivingITSSTable.erase (map_index);
+    DENMTableEntry_t *table_entry = m_DENMTable.find (key);
+    if(table_entry!=nullptr)
+      {
+        // When an entry expires, discard also the information related to its (now stopped) timer
+        table_entry->receiving = false;
+        table_entry->receivingEntry = ITSSReceivingTableEntry();
+
+        if(!table_entry->originating)
+          {
+            m_DENMTable.erase (key);
+          }
+      }
     T_Repetition_Mutex.unlock ();
   }
 
-  /* This cleanup function will attemp to stop any possibly still-running timer */
+  /* This cleanup function will stop any possibly still-running timer */
   void
   DENBasicService::cleanup(void)
   {
-    for(std::map<std::pair<unsigned long,long>, std::tuple<Timer,Timer,Timer>>::iterator m_originatingTimerTable_it=m_originatingTimerTable.begin ();
-        m_originatingTimerTable_it!=m_originatingTimerTable.end ();
-        m_originatingTimerTable_it++)
-      {
-         std::get<V_O_VALIDITY_INDEX>(m_originatingTimerTable_it->second).Cancel();
-         std::get<T_REPETITION_INDEX>(m_originatingTimerTable_it->second).Cancel();
-         std::get<T_REPETITION_DURATION_INDEX>(m_originatingTimerTable_it->second).Cancel();
-      }
-
-    for(std::map<std::pair<unsigned long,long>, Timer>::iterator m_T_R_Validity_Table_it=m_T_R_Validity_Table.begin ();
-        m_T_R_Validity_Table_it!=m_T_R_Validity_Table.end ();
-        m_T_R_Validity_Table_it++)
-      {
-         m_T_R_Validity_Table_it->second.Cancel();
-      }
+    // All the DENM timers share a single simulator event, which is cancelled here
+    m_timerQueue.clear ();
 
     // Cleanup the BTP object (which will in turn perform the "cleanup" operation on the underlying GeoNet object)
     m_btp->cleanup();
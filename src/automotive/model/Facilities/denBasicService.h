@@ -5,11 +5,13 @@
 #include "denData.h"
 #include "ITSSOriginatingTableEntry.h"
 #include "ITSSReceivingTableEntry.h"
+#include "actionIDTable.h"
 #include "ns3/core-module.h"
 #include "ns3/socket.h"
 #include "ns3/btp.h"
 #include "ns3/btpHeader.h"
 #include "ns3/btpdatarequest.h"
+#include "ns3/gn-timer-queue.h"
 #include <functional>
 #include <mutex>
 #include <queue>
@@ -18,6 +20,7 @@
 #define V_O_VALIDITY_INDEX 0
 #define T_REPETITION_INDEX 1
 #define T_REPETITION_DURATION_INDEX 2
+#define T_R_VALIDITY_INDEX 3
 
 namespace ns3 {
 
@@ -178,6 +181,14 @@ namespace ns3 {
      * @param geoArea
      */
     void setGeoArea(GeoArea_t geoArea){m_geoArea = geoArea;}
+    /**
+     * @brief Set the maximum hop limit of the DENM messages (default: 1, i.e., no multi-hop forwarding)
+     *
+     * With a hop limit greater than 1, the DENMs are forwarded by GeoNetworking towards and inside the destination
+     * area, according to the forwarding algorithms set in the GeoNet object (e.g., GeoNet::setAreaForwardingAlgorithm()).
+     * @param hop_limit
+     */
+    void setMaxHopLimit(uint8_t hop_limit){m_maxHopLimit = hop_limit;}
 
     /**
      * @brief Use real time for timestamps
@@ -203,14 +214,26 @@ namespace ns3 {
     DENBasicService_error_t fillDENM(asn1cpp::Seq<DENM> &denm, denData &data, const DEN_ActionID_t actionID, long referenceTimeLong);
 
     /**
-     * @brief Set the timer for the T_O_Validity timer
-     * @tparam MEM_PTR
-     * @param timer
+     * @brief Entry of the DENM table, with the state of an ActionID in both the originating and the receiving ITS-S
+     * message tables. Its timers are kept in m_timerQueue, with handle (key << 2) | timer index
+     */
+    typedef struct _DENMTableEntry {
+      bool originating = false; //! The ActionID is in the originating ITS-S message table
+      bool receiving = false; //! The ActionID is in the receiving ITS-S message table
+      ITSSOriginatingTableEntry originatingEntry;
+      ITSSReceivingTableEntry receivingEntry;
+      Time repetitionInterval;
+    } DENMTableEntry_t;
+
+    /**
+     * @brief Start (or restart) a timer of the given DENM table entry
+     * @param key    Packed ActionID of the entry
+     * @param timer  Timer index (V_O_VALIDITY_INDEX, T_REPETITION_INDEX, T_REPETITION_DURATION_INDEX or T_R_VALIDITY_INDEX)
      * @param delay
-     * @param callback_fcn
-     * @param actionID
      */
-    template<typename MEM_PTR> void setDENTimer(Timer &timer,Time delay,MEM_PTR callback_fcn,DEN_ActionID_t actionID);
+    void setDENTimer(uint64_t key,uint8_t timer,Time delay);
+    void stopOriginatingTimers(uint64_t key);
+    void DENTimerExpired(uint64_t handle,Time deadline);
 
     void T_O_ValidityStop(DEN_ActionID_t entry_actionid);
     void T_RepetitionDurationStop(DEN_ActionID_t entry_actionid);
@@ -233,6 +256,8 @@ namespace ns3 {
 
 
     unsigned long m_station_id; //! Station ID of the ITS-S
+    std::string m_encodeBuffer; //! Buffer reused to encode every DENM, to avoid allocating a new one each time
+    std::vector<uint8_t> m_rxBuffer; //! Buffer reused to receive a DENM, when no view on the GeoNetworking receive buffer is available (see btp::getPayloadView())
 
     long m_stationtype; //! Station type of the ITS-S
 
@@ -243,19 +268,15 @@ namespace ns3 {
 
 
     GeoArea_t m_geoArea; //! GeoArea for which the DENM messages are intended
+    uint8_t m_maxHopLimit = 1; //! Maximum hop limit of the DENM messages
 
 
     Ptr<Socket> m_socket_tx; //! Socket used to send the DENM messages
 
 
-    std::map<std::pair<unsigned long,long>,ITSSOriginatingTableEntry> m_originatingITSSTable; //! Originating ITS-S table
-
-    std::map<std::pair<unsigned long,long>,ITSSReceivingTableEntry> m_receivingITSSTable; //! Receiving ITS-S table
-
-
-    std::map<std::pair<unsigned long,long>,std::tuple<Timer,Timer,Timer>> m_originatingTimerTable; //! Originating timer table
+    ActionIDTable<DENMTableEntry_t> m_DENMTable; //! Originating and receiving ITS-S message tables, with their timers
 
-    std::map<std::pair<unsigned long,long>,Timer> m_T_R_Validity_Table; //! Validity timer table
+    GNTimerQueue m_timerQueue; //! Deadline queue for all the timers of m_DENMTable
 
     /* den_data private fillers (ASN.1 types), used within "receiveDENM" */
     /**
@@ -290,7 +311,7 @@ namespace ns3 {
     void fillDenDataAlacarte(asn1cpp::Seq<AlacarteContainer> denm_alacarte_container, denData &denm_data);
 
     /*
-    * Mutex to protect m_originatingITSSTable when appDENM_update() and the callback for the expiration of the T_Repetion timer may try to
+    * Mutex to protect m_DENMTable when appDENM_update() and the callback for the expiration of the T_Repetion timer may try to
     * access the map concurrently, resulting in a thread-unsafe code.
     */
     std::mutex T_Repetition_Mutex;
@@ -5,11 +5,13 @@
 #include "denData.h"
 #include "ITSSOriginatingTableEntry.h"
 #include "ITSSReceivingTableEntry.h"
+#include "actionIDTable.h"
 #include "ns3/core-module.h"
 #include "ns3/socket.h"
 #include "ns3/btp.h"
 #include "ns3/btpHeader.h"
 #include "ns3/btpdatarequest.h"
+#include "ns3/gn-timer-queue.h"
 #include <functional>
 #include <mutex>
 #include <queue>
@@ -18,6 +20,7 @@
 #define V_O_VALIDITY_INDEX 0
 #define T_REPETITION_INDEX 1
 #define T_REPETITION_DURATION_INDEX 2
+#define T_R_VALIDITY_INDEX 3
 
 namespace ns3 {
 
@@ -63,6 +66,7 @@ namespace ns3 {
     void setSocketTx(Ptr<Socket> socket_tx);
     void setSocketRx(Ptr<Socket> socket_rx);
     void setGeoArea(GeoArea_t geoArea){m_geoArea = geoArea;}
+    void setMaxHopLimit(uint8_t hop_limit){m_maxHopLimit = hop_limit;}
 
     void setRealTime(bool real_time){m_real_time=real_time;}
 
@@ -74,7 +78,19 @@ namespace ns3 {
 
     DENBasicServiceV1_error_t fillDENM(asn1cpp::Seq<DENMV1> &denm, denData &data, const DEN_ActionID_t actionID, long referenceTimeLong);
 
-    template<typename MEM_PTR> void setDENTimer(Timer &timer,Time delay,MEM_PTR callback_fcn,DEN_ActionID_t actionID);
+    // Entry of the DENM table, with the state of an ActionID in both the originating and the receiving ITS-S message tables.
+    // Its timers are kept in m_timerQueue, with handle (key << 2) | timer index
+    typedef struct _DENMTableEntry {
+      bool originating = false;
+      bool receiving = false;
+      ITSSOriginatingTableEntry originatingEntry;
+      ITSSReceivingTableEntry receivingEntry;
+      Time repetitionInterval;
+    } DENMTableEntry_t;
+
+    void setDENTimer(uint64_t key,uint8_t timer,Time delay);
+    void stopOriginatingTimers(uint64_t key);
+    void DENTimerExpired(uint64_t handle,Time deadline);
 
     void T_O_ValidityStop(DEN_ActionID_t entry_actionid);
     void T_RepetitionDurationStop(DEN_ActionID_t entry_actionid);
@@ -92,20 +108,20 @@ namespace ns3 {
     std::string m_model;
 
     unsigned long m_station_id;
+    std::string m_encodeBuffer; //! Buffer reused to encode every DENM, to avoid allocating a new one each time
+    std::vector<uint8_t> m_rxBuffer; //! Buffer reused to receive a DENM, when no view on the GeoNetworking receive buffer is available (see btp::getPayloadView())
     long m_stationtype;
     uint16_t m_seq_number;
 
     Ptr<btp> m_btp;
 
     GeoArea_t m_geoArea;
+    uint8_t m_maxHopLimit = 1;
 
     Ptr<Socket> m_socket_tx; // Socket TX
 
-    std::map<std::pair<unsigned long,long>,ITSSOriginatingTableEntry> m_originatingITSSTable;
-    std::map<std::pair<unsigned long,long>,ITSSReceivingTableEntry> m_receivingITSSTable;
-
-    std::map<std::pair<unsigned long,long>,std::tuple<Timer,Timer,Timer>> m_originatingTimerTable;
-    std::map<std::pair<unsigned long,long>,Timer> m_T_R_Validity_Table;
+    ActionIDTable<DENMTableEntry_t> m_DENMTable; // Originating and receiving ITS-S message tables, with their timers
+    GNTimerQueue m_timerQueue; // Deadline queue for all the timers of m_DENMTable
 
     /* den_data private fillers (ASN.1 types), used within "receiveDENM" */
     void fillDenDataHeader(asn1cpp::Seq<ItsPduHeaderV1> denm_header, denData &denm_data);
@@ -115,7 +131,7 @@ namespace ns3 {
     void fillDenDataAlacarte(asn1cpp::Seq<AlacarteContainerV1> denm_alacarte_container, denData &denm_data);
 
     /*
-    * Mutex to protect m_originatingITSSTable when appDENM_update() and the callback for the expiration of the T_Repetion timer may try to
+    * Mutex to protect m_DENMTable when appDENM_update() and the callback for the expiration of the T_Repetion timer may try to
     * access the map concurrently, resulting in a thread-unsafe code.
     */
     std::mutex T_Repetition_Mutex;
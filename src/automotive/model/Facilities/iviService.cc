@@ -144,7 +144,7 @@ namespace ns3 {
             auto deltaSeq = asn1cpp::makeSeq(DeltaPosition);
             asn1cpp::setField(deltaSeq->deltaLatitude,deltaPos_it->deltaLat);
             asn1cpp::setField(deltaSeq->deltaLongitude,deltaPos_it->deltaLong);
-            asn1cpp::sequenceof::pushList(polyLine->choice.deltaPositions,deltaSeq);
+            asn1cpp::sequenceof::pushList(polyLine->choice.deltaPositions,std::move(deltaSeq));
           }
       }
     else if(line.deltaPositionsWA.isAvailable ())
@@ -157,7 +157,7 @@ namespace ns3 {
             asn1cpp::setField(deltaSeq->deltaLatitude,deltaPos_it->deltaLat);
             asn1cpp::setField(deltaSeq->deltaLongitude,deltaPos_it->deltaLong);
             asn1cpp::setField(deltaSeq->deltaAltitude,deltaPos_it->deltaAltitude);
-            asn1cpp::sequenceof::pushList(polyLine->choice.deltaPositionsWithAltitude,deltaSeq);
+            asn1cpp::sequenceof::pushList(polyLine->choice.deltaPositionsWithAltitude,std::move(deltaSeq));
           }
       }
     else if(line.absPositions.isAvailable ())
@@ -169,7 +169,7 @@ namespace ns3 {
             auto absSeq = asn1cpp::makeSeq(AbsolutePosition);
             asn1cpp::setField(absSeq->latitude,absPos_it->lat);
             asn1cpp::setField(absSeq->longitude,absPos_it->lon);
-            asn1cpp::sequenceof::pushList(polyLine->choice.absolutePositions,absSeq);
+            asn1cpp::sequenceof::pushList(polyLine->choice.absolutePositions,std::move(absSeq));
           }
       }
     else if(line.absPositionsWA.isAvailable ())
@@ -183,7 +183,7 @@ namespace ns3 {
             asn1cpp::setField(absSeq->longitude,absPos_it->lon);
             asn1cpp::setField(absSeq->altitude.altitudeValue,absPos_it->altitude);
             asn1cpp::setField(absSeq->altitude.altitudeConfidence,AltitudeConfidence_unavailable);
-            asn1cpp::sequenceof::pushList(polyLine->choice.absolutePositionsWithAltitude,absSeq);
+            asn1cpp::sequenceof::pushList(polyLine->choice.absolutePositionsWithAltitude,std::move(absSeq));
           }
       }
     else
@@ -263,7 +263,7 @@ namespace ns3 {
           auto heading = asn1cpp::makeSeq(Heading);
           asn1cpp::setField(heading->headingValue,glcData.referencePositionHeading.getData ().getValue ());
           asn1cpp::setField(heading->headingConfidence,glcData.referencePositionHeading.getData ().getConfidence ());
-          asn1cpp::setField(ivimGlc->referencePositionHeading,heading);
+          asn1cpp::setField(ivimGlc->referencePositionHeading,std::move(heading));
         }
 
       if(glcData.referencePositionHeading.isAvailable ())
@@ -271,7 +271,7 @@ namespace ns3 {
           auto speed = asn1cpp::makeSeq(Speed);
           asn1cpp::setField(speed->speedValue,glcData.referencePositionHeading.getData ().getValue ());
           asn1cpp::setField(speed->speedConfidence,glcData.referencePositionHeading.getData ().getConfidence ());
-          asn1cpp::setField(ivimGlc->referencePositionSpeed,speed);
+          asn1cpp::setField(ivimGlc->referencePositionSpeed,std::move(speed));
         }
 
       for(auto glcPart_it = glcData.GlcPart.begin (); glcPart_it != glcData.GlcPart.end (); glcPart_it++)
@@ -324,15 +324,15 @@ namespace ns3 {
                       asn1cpp::setField(offsetSeq->deltaLatitude,refPos.deltaLat);
                       asn1cpp::setField(offsetSeq->deltaLongitude,refPos.deltaLong);
                       asn1cpp::setField(offsetSeq->deltaAltitude,refPos.deltaAltitude);
-                      asn1cpp::setField(zone->choice.computedSegment.offsetPosition,offsetSeq);
+                      asn1cpp::setField(zone->choice.computedSegment.offsetPosition,std::move(offsetSeq));
                     }
                 }
-              asn1cpp::setField(glcPart->zone,zone);
+              asn1cpp::setField(glcPart->zone,std::move(zone));
             }
-          asn1cpp::sequenceof::pushList(ivimGlc->parts,glcPart);
+          asn1cpp::sequenceof::pushList(ivimGlc->parts,std::move(glcPart));
         }
-      asn1cpp::setField(iviCont->choice.glc,ivimGlc);
-      asn1cpp::sequenceof::pushList(ivim->ivi.optional, iviCont);
+      asn1cpp::setField(iviCont->choice.glc,std::move(ivimGlc));
+      asn1cpp::sequenceof::pushList(ivim->ivi.optional, std::move(iviCont));
     }
 
 
@@ -399,13 +399,13 @@ namespace ns3 {
                 asn1cpp::setField(at->choice.spe.unit,
                                   rsCode_it->RS_unit.getData());
 
-                asn1cpp::sequenceof::pushList(RS_0->code.choice.iso14823.attributes,at);
+                asn1cpp::sequenceof::pushList(RS_0->code.choice.iso14823.attributes,std::move(at));
               }
-            asn1cpp::sequenceof::pushList(gicPart->roadSignCodes,RS_0);
+            asn1cpp::sequenceof::pushList(gicPart->roadSignCodes,std::move(RS_0));
           }
-        asn1cpp::sequenceof::pushList(iviCont->choice.giv,gicPart);
+        asn1cpp::sequenceof::pushList(iviCont->choice.giv,std::move(gicPart));
       }
-    asn1cpp::sequenceof::pushList(ivim->ivi.optional, iviCont);
+    asn1cpp::sequenceof::pushList(ivim->ivi.optional, std::move(iviCont));
 }
 
     // Road Configuration Container
@@ -437,12 +437,12 @@ namespace ns3 {
              asn1cpp::setField(laneInfo->direction,laneinfo_it->direction);
              asn1cpp::setField(laneInfo->laneType,laneinfo_it->laneType);
              asn1cpp::setField(laneInfo->laneStatus,laneinfo_it->laneStatus);
-             asn1cpp::sequenceof::pushList(rccPart->laneConfiguration, laneInfo) ;
+             asn1cpp::sequenceof::pushList(rccPart->laneConfiguration, std::move(laneInfo)) ;
 
           }
-        asn1cpp::sequenceof::pushList(iviCont->choice.rcc,rccPart);
+        asn1cpp::sequenceof::pushList(iviCont->choice.rcc,std::move(rccPart));
       }
-    asn1cpp::sequenceof::pushList(ivim->ivi.optional, iviCont) ;
+    asn1cpp::sequenceof::pushList(ivim->ivi.optional, std::move(iviCont)) ;
 
     }
 
@@ -510,12 +510,12 @@ namespace ns3 {
                   asn1cpp::setField(tcText->layoutComponentId,text_it->layoutComponentId.getData ());
                 asn1cpp::bitstring::setBit(tcText->language,text_it->bitLanguage,0);
                 asn1cpp::setField(tcText->textContent,text_it->textCont);
-                asn1cpp::sequenceof::pushList(tcPart->text, tcText);
+                asn1cpp::sequenceof::pushList(tcPart->text, std::move(tcText));
               }
           }
-        asn1cpp::sequenceof::pushList(iviCont->choice.tc, tcPart) ;
+        asn1cpp::sequenceof::pushList(iviCont->choice.tc, std::move(tcPart)) ;
       }
-    asn1cpp::sequenceof::pushList(ivim->ivi.optional, iviCont) ;
+    asn1cpp::sequenceof::pushList(ivim->ivi.optional, std::move(iviCont)) ;
 
 }
     // Layout Container
@@ -546,10 +546,10 @@ namespace ns3 {
         asn1cpp::setField(lacComp->height,lacComp_it->height);
         asn1cpp::setField(lacComp->textScripting,lacComp_it->textScripting);
         asn1cpp::setField(lacComp->layoutComponentId,lacComp_it->layoutComponentId);
-        asn1cpp::sequenceof::pushList(ivimLac->layoutComponents,lacComp);
+        asn1cpp::sequenceof::pushList(ivimLac->layoutComponents,std::move(lacComp));
       }
-    asn1cpp::setField(iviCont->choice.lac, ivimLac) ;
-    asn1cpp::sequenceof::pushList(ivim->ivi.optional, iviCont) ;
+    asn1cpp::setField(iviCont->choice.lac, std::move(ivimLac)) ;
+    asn1cpp::sequenceof::pushList(ivim->ivi.optional, std::move(iviCont)) ;
 
     }
 
@@ -594,7 +594,8 @@ namespace ns3 {
     fillIVIM (ivim,Data,actionid);
 
 
-    std::string encode_result = asn1cpp::uper::encode(ivim);
+    std::string &encode_result = m_encodeBuffer;
+    asn1cpp::uper::encode(ivim, encode_result);
 
     Ptr<Packet> packet = Create<Packet> ((uint8_t*) encode_result.c_str(), encode_result.size());
     //free(encode_result.buffer);
@@ -649,7 +650,8 @@ namespace ns3 {
       fillIVIM (ivim,Data,actionid);
 
 
-      std::string encode_result = asn1cpp::uper::encode(ivim);
+      std::string &encode_result = m_encodeBuffer;
+      asn1cpp::uper::encode(ivim, encode_result);
 
       Ptr<Packet> packet = Create<Packet> ((uint8_t*) encode_result.c_str(), encode_result.size());
       //free(encode_result.buffer);
@@ -700,7 +702,8 @@ namespace ns3 {
       /* Encode */
 
 
-      std::string encode_result = asn1cpp::uper::encode(ivim);
+      std::string &encode_result = m_encodeBuffer;
+      asn1cpp::uper::encode(ivim, encode_result);
 
       Ptr<Packet> packet = Create<Packet> ((uint8_t*) encode_result.c_str(), encode_result.size());
       //free(encode_result.buffer);
@@ -758,7 +761,8 @@ namespace ns3 {
       fillIVIM (ivim,Data,actionID);
 
 
-      std::string encode_result = asn1cpp::uper::encode(ivim);
+      std::string &encode_result = m_encodeBuffer;
+      asn1cpp::uper::encode(ivim, encode_result);
 
       Ptr<Packet> packet = Create<Packet> ((uint8_t*) encode_result.c_str(), encode_result.size());
       //free(encode_result.buffer);
@@ -864,10 +868,8 @@ namespace ns3 {
 
       packet = dataIndication.data;
 
-      uint8_t *buffer; //= new uint8_t[packet->GetSize ()];
-      buffer=(uint8_t *)malloc((packet->GetSize ())*sizeof(uint8_t));
-      packet->CopyData (buffer, packet->GetSize ());
-      std::string packetContent((char *)buffer,(int) dataIndication.data->GetSize ());
+      const uint8_t *buffer = btp::getPayloadView (dataIndication, m_rxBuffer);
+      uint32_t bufferSize = dataIndication.data->GetSize ();
 
       RssiTag rssi;
       bool rssi_result = dataIndication.data->PeekPacketTag(rssi);
@@ -914,13 +916,11 @@ namespace ns3 {
        if (buffer[1]!=FIX_IVIMID) //FIX_IVIMID = 0x06;
          {
            NS_LOG_ERROR("Warning: received a message which has messageID '"<<buffer[1]<<"' but '6' was expected.");
-           free(buffer);
            return;
          }
 
        /** Decoding **/
-       free(buffer);
-       decoded_ivim = asn1cpp::uper::decodeASN(packetContent, IVIM);
+       decoded_ivim = asn1cpp::uper::decode<IVIM> (&asn_DEF_IVIM, buffer, bufferSize);
 
        iviData decodedData;
 
@@ -194,6 +194,8 @@ typedef enum {
 
 
     StationID_t m_station_id;
+    std::string m_encodeBuffer; //! Buffer reused to encode every IVIM, to avoid allocating a new one each time
+    std::vector<uint8_t> m_rxBuffer; //! Buffer reused to receive an IVIM, when no view on the GeoNetworking receive buffer is available (see btp::getPayloadView())
     StationType_t m_stationtype;
     uint16_t m_seq_number;
 
@@ -0,0 +1,265 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef TRIGGERCONDITIONSCHEDULER_H
+#define TRIGGERCONDITIONSCHEDULER_H
+
+#include <stdint.h>
+#include <cmath>
+#include <vector>
+
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+namespace ns3
+{
+  /**
+   * \brief Kinematic snapshot of all the stations registered in a TriggerConditionScheduler, stored as a structure of arrays.
+   *
+   * Each service fills its own element "i" (see fillConditionSnapshot()), and the scheduler then evaluates the triggering
+   * conditions of all the stations in a single pass over these arrays.
+   */
+  typedef struct _TriggerConditionSnapshot {
+    std::vector<double> heading; //! Current heading (degrees)
+    std::vector<double> prevHeading; //! Heading included in the last transmitted message (degrees)
+    std::vector<double> headingThreshold; //! Heading difference triggering a new message (degrees)
+    std::vector<double> posDiff; //! Distance from the position included in the last transmitted message (m)
+    std::vector<double> speed; //! Current speed (m/s)
+    std::vector<double> prevSpeed; //! Speed included in the last transmitted message (m/s)
+    std::vector<int64_t> lastGen; //! Timestamp of the last message generation (ms)
+    std::vector<int64_t> T_Gen; //! Current message generation interval (ms)
+    std::vector<int64_t> checkPeriod; //! Current condition check interval (ns)
+    std::vector<uint8_t> force; //! If 1, the conditions are always checked by the service itself
+
+    void resize(size_t size)
+    {
+      heading.resize (size); prevHeading.resize (size); headingThreshold.resize (size);
+      posDiff.resize (size); speed.resize (size); prevSpeed.resize (size);
+      lastGen.resize (size); T_Gen.resize (size); checkPeriod.resize (size); force.resize (size);
+    }
+  } TriggerConditionSnapshot_t;
+
+  /**
+   * \ingroup automotive
+   * \brief Simulation-wide scheduler of the CAM/VAM triggering condition checks.
+   *
+   * Normally, each station schedules its own condition check every T_CheckGen (e.g., 100 ms), even if most of the checks
+   * do not result in any transmission. When a service is registered here, the scheduler instead wakes up once per tick
+   * and, for all the stations whose next check falls within the tick, it takes a kinematic snapshot and evaluates the
+   * ETSI triggering conditions (heading, position, speed and elapsed time) in a single pass. Only the stations that
+   * may have to transmit get an event, which is scheduled at their own check time, so that the desynchronization
+   * among stations is preserved; the service then performs its usual complete check at that time. The checks of all the
+   * other stations are simply moved forward by one check interval.
+   *
+   * The time condition is evaluated exactly, at the check time of each station. The kinematic conditions are evaluated
+   * on a snapshot taken up to one tick before the check time: to compensate for this, the position condition is
+   * extrapolated with the current speed, while the heading and speed conditions are evaluated on the snapshot (i.e.,
+   * a change of heading or speed occurring within the last tick before a check may be detected one check later).
+   *
+   * The scheduler is a singleton for each service type, but its state is tied to the simulation run: it is reset by
+   * Simulator::Destroy(), so that a following run (e.g., in a test suite or a sweep executed by the same process) starts
+   * without any registered station. Only the tick period is kept.
+   *
+   * The service type S must provide:
+   *  - void fillConditionSnapshot(TriggerConditionSnapshot_t &snapshot, size_t i)
+   *  - void scheduleConditionCheck(Time delay)
+   */
+  template <typename S>
+  class TriggerConditionScheduler
+  {
+  public:
+    static TriggerConditionScheduler<S> &Get (void)
+    {
+      static TriggerConditionScheduler<S> scheduler;
+      return scheduler;
+    }
+
+    /**
+     * \brief Set the period of the scheduler ticks (default: 10 ms). It should not be greater than the smallest condition
+     * check interval of the registered stations.
+     */
+    void SetTickPeriod (Time period) {m_tickPeriod = period;}
+
+    /**
+     * \brief Register a service, whose first condition check is at the absolute time "first_check".
+     * \return The slot of the service, to be used in SetNextCheck() and RemoveStation().
+     */
+    uint32_t AddStation (S *service, Time first_check)
+    {
+      uint32_t slot;
+
+      if (!m_freeSlots.empty ())
+        {
+          slot = m_freeSlots.back ();
+          m_freeSlots.pop_back ();
+        }
+      else
+        {
+          slot = m_services.size ();
+          m_services.push_back (nullptr);
+          m_nextCheck.push_back (INT64_MAX);
+          m_snapshot.resize (m_services.size ());
+        }
+
+      m_services[slot] = service;
+      m_numStations++;
+
+      if (!m_destroyScheduled)
+        {
+          Simulator::ScheduleDestroy (&TriggerConditionScheduler<S>::Reset, this);
+          m_destroyScheduled = true;
+        }
+
+      if (!m_tickEvent.IsRunning ())
+        {
+          m_nextTick = Simulator::Now ();
+          m_tickEvent = Simulator::ScheduleNow (&TriggerConditionScheduler<S>::Tick, this);
+        }
+
+      SetNextCheck (slot, first_check);
+      return slot;
+    }
+
+    /**
+     * \brief Unregister a service. Nothing is done if the slot does not belong to the service (e.g., if the scheduler
+     * has been reset by Simulator::Destroy() in the meantime).
+     */
+    void RemoveStation (uint32_t slot, S *service)
+    {
+      if (slot >= m_services.size () || m_services[slot] != service)
+        {
+          return;
+        }
+
+      m_services[slot] = nullptr;
+      m_nextCheck[slot] = INT64_MAX;
+      m_freeSlots.push_back (slot);
+
+      if (--m_numStations == 0)
+        {
+          Simulator::Cancel (m_tickEvent);
+        }
+    }
+
+    /**
+     * \brief Set the absolute time of the next condition check of a station, after a check dispatched by the scheduler.
+     */
+    void SetNextCheck (uint32_t slot, Time next_check)
+    {
+      // Checks falling before the next tick would be missed by the tick: they are dispatched directly
+      if (next_check < m_nextTick)
+        {
+          m_nextCheck[slot] = INT64_MAX;
+          m_services[slot]->scheduleConditionCheck (next_check - Simulator::Now ());
+          return;
+        }
+
+      m_nextCheck[slot] = next_check.GetNanoSeconds ();
+    }
+
+  private:
+    TriggerConditionScheduler () = default;
+    TriggerConditionScheduler (const TriggerConditionScheduler &) = delete;
+    TriggerConditionScheduler &operator= (const TriggerConditionScheduler &) = delete;
+
+    void Reset (void)
+    {
+      Simulator::Cancel (m_tickEvent);
+      m_tickEvent = EventId ();
+
+      m_services.clear ();
+      m_nextCheck.clear ();
+      m_freeSlots.clear ();
+      m_snapshot.resize (0);
+      m_due.clear ();
+      m_mustCheck.clear ();
+
+      m_numStations = 0;
+      m_nextTick = Time ();
+      m_destroyScheduled = false;
+    }
+
+    void Tick (void)
+    {
+      int64_t now = Simulator::Now ().GetNanoSeconds ();
+      int64_t tick_end = now + m_tickPeriod.GetNanoSeconds ();
+
+      // 1. Gather the stations with a check within this tick, and take their kinematic snapshot
+      m_due.clear ();
+      for (size_t i = 0; i < m_services.size (); i++)
+        {
+          if (m_nextCheck[i] < tick_end)
+            {
+              m_due.push_back (i);
+              m_services[i]->fillConditionSnapshot (m_snapshot, i);
+            }
+        }
+
+      // 2. Evaluate the triggering conditions of all the due stations
+      m_mustCheck.assign (m_due.size (), 0);
+      for (size_t k = 0; k < m_due.size (); k++)
+        {
+          size_t i = m_due[k];
+          double lead_s = (m_nextCheck[i] - now) / 1e9;
+
+          double head_diff = m_snapshot.heading[i] - m_snapshot.prevHeading[i];
+          head_diff += (head_diff > 180.0) ? -360.0 : (head_diff < -180.0) ? 360.0 : 0.0;
+
+          m_mustCheck[k] = m_snapshot.force[i] ||
+                           std::abs (head_diff) > m_snapshot.headingThreshold[i] ||
+                           std::abs (m_snapshot.posDiff[i]) + std::abs (m_snapshot.speed[i]) * lead_s > 4.0 ||
+                           std::abs (m_snapshot.speed[i] - m_snapshot.prevSpeed[i]) > 0.5 ||
+                           m_nextCheck[i] / 1000000 - m_snapshot.lastGen[i] >= m_snapshot.T_Gen[i];
+        }
+
+      // 3. Dispatch the stations which may have to transmit, and move forward the checks of the other ones
+      for (size_t k = 0; k < m_due.size (); k++)
+        {
+          size_t i = m_due[k];
+          if (m_mustCheck[k])
+            {
+              int64_t check_time = m_nextCheck[i];
+              m_nextCheck[i] = INT64_MAX;
+              m_services[i]->scheduleConditionCheck (NanoSeconds (std::max (check_time - now, (int64_t) 0)));
+            }
+          else
+            {
+              m_nextCheck[i] += m_snapshot.checkPeriod[i];
+            }
+        }
+
+      m_nextTick = NanoSeconds (tick_end);
+      m_tickEvent = Simulator::Schedule (m_tickPeriod, &TriggerConditionScheduler<S>::Tick, this);
+    }
+
+    std::vector<S *> m_services; //! Registered services (nullptr for a free slot)
+    std::vector<int64_t> m_nextCheck; //! Time of the next check (ns), or INT64_MAX if already dispatched (or free slot)
+    std::vector<uint32_t> m_freeSlots;
+    TriggerConditionSnapshot_t m_snapshot;
+
+    std::vector<size_t> m_due;
+    std::vector<uint8_t> m_mustCheck;
+
+    uint32_t m_numStations = 0;
+    Time m_tickPeriod = MilliSeconds (10);
+    Time m_nextTick;
+    EventId m_tickEvent;
+    bool m_destroyScheduled = false; //! True if Reset() has been scheduled for the end of the current run
+  };
+}
+
+#endif // TRIGGERCONDITIONSCHEDULER_H
@@ -0,0 +1,99 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "triggerTrace.h"
+#include "ns3/log.h"
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE("TriggerTrace");
+
+  TriggerTrace::TriggerTrace(std::string filename,size_t buffer_size)
+  {
+    m_bufferSize = buffer_size;
+    m_buffer.reserve (m_bufferSize);
+
+    m_file.open (filename,std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!m_file.is_open ())
+      {
+        NS_LOG_ERROR("Cannot open the trace file " << filename << ". No trace will be written.");
+        return;
+      }
+
+    const char magic[6] = {'M','S','V','T','R','C'};
+    uint16_t version = 1;
+    m_file.write (magic,sizeof(magic));
+    m_file.write ((const char *) &version,sizeof(version));
+  }
+
+  TriggerTrace::~TriggerTrace()
+  {
+    flush ();
+  }
+
+  void
+  TriggerTrace::flush()
+  {
+    if(m_file.is_open () && !m_buffer.empty ())
+      {
+        m_file.write (m_buffer.data (),m_buffer.size ());
+        m_file.flush ();
+      }
+
+    m_buffer.clear ();
+  }
+
+  std::string
+  TriggerTrace::motivationString(uint8_t motivation)
+  {
+    static const struct {
+      uint8_t flag;
+      const char *name;
+      char initial;
+    } conditions[] = {
+      {TRIGGER_MOTIVATION_HEADING,"heading",'H'},
+      {TRIGGER_MOTIVATION_POSITION,"position",'P'},
+      {TRIGGER_MOTIVATION_SPEED,"speed",'S'},
+      {TRIGGER_MOTIVATION_SAFE_DISTANCES,"safe_distances",'D'},
+      {TRIGGER_MOTIVATION_TIME,"time",'T'}
+    };
+
+    std::string joint;
+    const char *name = "numPkt";
+
+    for(const auto &condition : conditions)
+      {
+        if(motivation & condition.flag)
+          {
+            joint += condition.initial;
+            name = condition.name;
+          }
+      }
+
+    if(joint.size () <= 1)
+      {
+        return name;
+      }
+
+    // When joint with a single other motivation, the time motivation should not be considered
+    if(joint.size () == 2 && (motivation & TRIGGER_MOTIVATION_TIME))
+      {
+        return motivationString (motivation & ~TRIGGER_MOTIVATION_TIME);
+      }
+
+    return "joint(" + joint + ")";
+  }
+}
@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef TRIGGERTRACE_H
+#define TRIGGERTRACE_H
+
+#include <stdint.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fstream>
+
+/*
+ * Trace points of the facilities layer (CAM and VAM triggering conditions).
+ * When MS_VAN3T_DISABLE_FACILITIES_TRACE is defined, FACILITIES_TRACE_ENABLED() is always false, and the compiler
+ * removes all the code filling the trace records. Otherwise, each trace point costs a single check of its condition
+ * (i.e., whether a TriggerTrace or the text log has been set on the Basic Service).
+ */
+#ifdef MS_VAN3T_DISABLE_FACILITIES_TRACE
+#define FACILITIES_TRACE_ENABLED(cond) (false)
+#else
+#define FACILITIES_TRACE_ENABLED(cond) (cond)
+#endif
+
+/* Triggering conditions of a CAM/VAM, stored in the "motivation" field of the trace records */
+#define TRIGGER_MOTIVATION_HEADING 0x01
+#define TRIGGER_MOTIVATION_POSITION 0x02
+#define TRIGGER_MOTIVATION_SPEED 0x04
+#define TRIGGER_MOTIVATION_SAFE_DISTANCES 0x08
+#define TRIGGER_MOTIVATION_TIME 0x10
+
+namespace ns3
+{
+  typedef enum {
+    TRIGGER_TRACE_CAM = 1,
+    TRIGGER_TRACE_VAM = 2
+  } triggerTraceRecordType_t;
+
+  /**
+   * @brief Trace record of a single check of the CAM triggering conditions (CABasicService::checkCamConditions())
+   */
+  typedef struct _CAMTriggerRecord {
+    int64_t simTime; //! Simulation time of the check (ms)
+    int64_t timestamp; //! Timestamp of the check, as used for the triggering conditions (ms)
+    uint32_t stationID;
+    uint8_t sent; //! 1 if a CAM has been generated
+    uint8_t motivation; //! TRIGGER_MOTIVATION_* flags of the verified conditions (only when sent is 1)
+    int16_t N_GenCam;
+    double headDiff;
+    double posDiff;
+    double speedDiff;
+    int32_t T_GenCam_ms; //! T_GenCam at the time of the check
+    double prevHeading;
+    double currHeading;
+    double prevLat;
+    double prevLon;
+    double currLat;
+    double currLon;
+    double prevSpeed;
+    double currSpeed;
+    int64_t lastCamGen;
+    int64_t timeDiff;
+    int16_t N_GenCamMax;
+  } CAMTriggerRecord_t;
+
+  /**
+   * @brief Trace record of a single check of the VAM triggering conditions (VRUBasicService::checkVamConditions())
+   */
+  typedef struct _VAMTriggerRecord {
+    int64_t simTime; //! Simulation time of the check (ms)
+    int64_t timestamp; //! Timestamp of the check, as used for the triggering conditions (ms)
+    uint32_t stationID;
+    uint8_t sent; //! 1 if a VAM has been generated
+    uint8_t redundancyMitigation; //! 1 if a VAM has been skipped because of redundancy mitigation
+    uint8_t motivation; //! TRIGGER_MOTIVATION_* flags of the verified conditions (only when sent is 1)
+    uint8_t minDistAvailable; //! 1 if the minimum distances from the other road users are available
+    double headDiff;
+    double posDiff;
+    double speedDiff;
+    int32_t T_GenVam_ms; //! T_GenVam at the time of the check
+    double prevHeading;
+    double currHeading;
+    double prevLat;
+    double prevLon;
+    double currLat;
+    double currLon;
+    double prevSpeed;
+    double currSpeed;
+    double safeDist[3]; //! Longitudinal, lateral and vertical safe distances
+    double minDistVeh[3]; //! Longitudinal, lateral and vertical minimum distances from the vehicles
+    double minDistPed[3]; //! Longitudinal, lateral and vertical minimum distances from the pedestrians
+    int64_t lastVamGen; //! Last VAM generation timestamp, before checking the time condition
+    int64_t lastVamGenEnd; //! Last VAM generation timestamp, at the end of the check
+    int64_t timeDiff;
+    int64_t numSent; //! Number of VAMs sent for the (last) verified condition, or -1 if not available
+    int16_t N_GenVam_red;
+    int16_t N_GenVam_max_red;
+  } VAMTriggerRecord_t;
+
+  /**
+   * \ingroup automotive
+   * \brief Binary trace of the facilities layer, shared by all the Basic Services of a simulation run
+   *
+   * The records are appended, as they are, to an in-memory buffer, which is written to the trace file only when it is full,
+   * when flush() is called or when the object is destroyed. No text formatting is ever performed while the simulation is running.
+   *
+   * File format: the 8-byte header "MSVTRC" followed by the version (uint16_t, currently 1), and then a sequence of records,
+   * each one made of its type (uint16_t, see triggerTraceRecordType_t), its size in bytes (uint16_t) and the raw content of the
+   * corresponding structure (CAMTriggerRecord_t or VAMTriggerRecord_t), in the native byte order and layout of the machine
+   * running the simulation.
+   */
+  class TriggerTrace
+  {
+  public:
+    TriggerTrace(std::string filename,size_t buffer_size=1<<20);
+    ~TriggerTrace();
+
+    bool isOpen() {return m_file.is_open ();}
+
+    void write(triggerTraceRecordType_t type,const CAMTriggerRecord_t &record) {append (type,&record,sizeof(record));}
+    void write(triggerTraceRecordType_t type,const VAMTriggerRecord_t &record) {append (type,&record,sizeof(record));}
+
+    /**
+     * @brief Write all the buffered records to the trace file.
+     */
+    void flush();
+
+    /**
+     * @brief Get a textual description of a set of TRIGGER_MOTIVATION_* flags, as used by the text logs of the Basic Services
+     *
+     * A single condition is reported with its name; more conditions are reported as "joint(<initials>)", except when
+     * the only other condition is the elapsed time, which is then ignored. No condition at all is reported as "numPkt".
+     */
+    static std::string motivationString(uint8_t motivation);
+
+  private:
+    void append(triggerTraceRecordType_t type,const void *record,uint16_t size)
+    {
+      if(m_buffer.size () + size + 2*sizeof(uint16_t) > m_bufferSize)
+        {
+          flush ();
+        }
+
+      size_t offset = m_buffer.size ();
+      uint16_t header[2] = {(uint16_t) type,size};
+      m_buffer.resize (offset + sizeof(header) + size);
+      std::memcpy (&m_buffer[offset],header,sizeof(header));
+      std::memcpy (&m_buffer[offset + sizeof(header)],record,size);
+    }
+
+    std::ofstream m_file;
+    std::vector<char> m_buffer;
+    size_t m_bufferSize;
+  };
+}
+
+#endif // TRIGGERTRACE_H
@@ -130,18 +130,24 @@ namespace ns3
       }
   }
 
+  libsumo::TraCIPosition
+  VDPTraCI::getSumoPosition()
+  {
+    if (m_isStatic)
+      return m_traci_client->TraCIAPI::poi.getPosition(m_id);
+
+    const TraciClient::StationKinematics_t *k = m_traci_client->GetStationKinematics (m_id);
+    return k != nullptr ? k->position : m_traci_client->TraCIAPI::vehicle.getPosition(m_id);
+  }
+
   VDP::VDP_position_latlon_t
   VDPTraCI::getPosition()
   {
     VDP_position_latlon_t vdppos;
 
-    libsumo::TraCIPosition pos;
-    if (!m_isStatic)
-      pos=m_traci_client->TraCIAPI::vehicle.getPosition(m_id);
-    else
-      pos = m_traci_client->TraCIAPI::poi.getPosition(m_id);
+    libsumo::TraCIPosition pos = getSumoPosition ();
 
-    pos=m_traci_client->TraCIAPI::simulation.convertXYtoLonLat (pos.x,pos.y);
+    pos=m_traci_client->ConvertXYtoLonLat (pos.x,pos.y);
 
     vdppos.lat=pos.y;
     vdppos.lon=pos.x;
@@ -155,11 +161,7 @@ namespace ns3
   {
     VDP_position_cartesian_t vdppos;
 
-    libsumo::TraCIPosition pos;
-    if (!m_isStatic)
-      pos=m_traci_client->TraCIAPI::vehicle.getPosition(m_id);
-    else
-      pos = m_traci_client->TraCIAPI::poi.getPosition(m_id);
+    libsumo::TraCIPosition pos = getSumoPosition ();
 
     vdppos.x=pos.x;
     vdppos.y=pos.y;
@@ -174,7 +176,7 @@ namespace ns3
     VDP_position_cartesian_t vdppos;
 
     libsumo::TraCIPosition pos;
-    pos=m_traci_client->TraCIAPI::simulation.convertLonLattoXY (lon,lat);
+    pos=m_traci_client->ConvertLonLattoXY (lon,lat);
 
     vdppos.x=pos.x;
     vdppos.y=pos.y;
@@ -187,8 +189,8 @@ namespace ns3
   VDPTraCI::getCartesianDist (double lon1, double lat1, double lon2, double lat2)
   {
     libsumo::TraCIPosition pos1,pos2;
-    pos1 = m_traci_client->TraCIAPI::simulation.convertLonLattoXY(lon1,lat1);
-    pos2 = m_traci_client->TraCIAPI::simulation.convertLonLattoXY(lon2,lat2);
+    pos1 = m_traci_client->ConvertLonLattoXY (lon1,lat1);
+    pos2 = m_traci_client->ConvertLonLattoXY (lon2,lat2);
     return sqrt((pow((pos1.x-pos2.x),2)+pow((pos1.y-pos2.y),2)));
   }
 
@@ -199,16 +201,12 @@ namespace ns3
 
     /* Speed [0.01 m/s] */
     if (!m_isStatic)
-      CAMdata.speed = VDPValueConfidence<> (m_traci_client->TraCIAPI::vehicle.getSpeed (m_id) * CENTI,
+      CAMdata.speed = VDPValueConfidence<> (getSpeedValue () * CENTI,
                                             SpeedConfidence_unavailable);
 
     /* Position */
-    libsumo::TraCIPosition pos;
-    if (!m_isStatic)
-      pos=m_traci_client->TraCIAPI::vehicle.getPosition(m_id);
-    else
-      pos = m_traci_client->TraCIAPI::poi.getPosition(m_id);
-    pos=m_traci_client->TraCIAPI::simulation.convertXYtoLonLat (pos.x,pos.y);
+    libsumo::TraCIPosition pos = getSumoPosition ();
+    pos=m_traci_client->ConvertXYtoLonLat (pos.x,pos.y);
 
     // longitude WGS84 [0,1 microdegree]
     CAMdata.longitude=(Longitude_t)(pos.x*DOT_ONE_MICRO);
@@ -226,12 +224,12 @@ namespace ns3
 
     /* Longitudinal acceleration [0.1 m/s^2] */
     if (!m_isStatic)
-      CAMdata.longAcceleration = VDPValueConfidence<>(m_traci_client->TraCIAPI::vehicle.getAcceleration (m_id) * DECI,
+      CAMdata.longAcceleration = VDPValueConfidence<>(getAccelerationValue () * DECI,
                                                   AccelerationConfidence_unavailable);
 
     /* Heading WGS84 north [0.1 degree] */
     if (!m_isStatic)
-      CAMdata.heading = VDPValueConfidence<>(m_traci_client->TraCIAPI::vehicle.getAngle (m_id) * DECI,
+      CAMdata.heading = VDPValueConfidence<>(getHeadingValue () * DECI,
                                          HeadingConfidence_unavailable);
 
     /* Drive direction (backward driving is not fully supported by SUMO, at the moment */
@@ -262,16 +260,12 @@ namespace ns3
 
     /* Speed [0.01 m/s] */
     if (!m_isStatic)
-      CPMdata.speed = VDPValueConfidence<> (m_traci_client->TraCIAPI::vehicle.getSpeed (m_id) * CENTI,
+      CPMdata.speed = VDPValueConfidence<> (getSpeedValue () * CENTI,
                                             SpeedConfidence_unavailable);
 
     /* Position */
-    libsumo::TraCIPosition pos;
-    if(!m_isStatic)
-      pos=m_traci_client->TraCIAPI::vehicle.getPosition(m_id);
-    else
-      pos = m_traci_client->TraCIAPI::poi.getPosition(m_id);
-    pos=m_traci_client->TraCIAPI::simulation.convertXYtoLonLat (pos.x,pos.y);
+    libsumo::TraCIPosition pos = getSumoPosition ();
+    pos=m_traci_client->ConvertXYtoLonLat (pos.x,pos.y);
 
     // longitude WGS84 [0,1 microdegree]
     CPMdata.longitude=(Longitude_t)(pos.x*DOT_ONE_MICRO);
@@ -289,12 +283,12 @@ namespace ns3
 
     /* Longitudinal acceleration [0.1 m/s^2] */
     if(!m_isStatic)
-      CPMdata.longAcceleration = VDPValueConfidence<>(m_traci_client->TraCIAPI::vehicle.getAcceleration (m_id) * DECI,
+      CPMdata.longAcceleration = VDPValueConfidence<>(getAccelerationValue () * DECI,
                                                   AccelerationConfidence_unavailable);
 
     /* Heading WGS84 north [0.1 degree] */
     if(!m_isStatic)
-      CPMdata.heading = VDPValueConfidence<>(m_traci_client->TraCIAPI::vehicle.getAngle (m_id) * DECI,
+      CPMdata.heading = VDPValueConfidence<>(getHeadingValue () * DECI,
                                          HeadingConfidence_unavailable);
 
     /* Drive direction (backward driving is not fully supported by SUMO, at the moment */
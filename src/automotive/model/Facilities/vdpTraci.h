@@ -65,21 +65,26 @@ namespace ns3 {
      */
     CPM_mandatory_data_t getCPMMandatoryData();
 
+    /*
+     * The kinematic values are taken from the variable subscription results received by the TraCI client with each
+     * SUMO simulation step (see TraciClient::GetStationKinematics()), and requested to SUMO only when not available.
+     */
+
     /**
      * @brief This functio returns the vehicle's speed.
      * @return
      */
-    double getSpeedValue() {return m_traci_client->TraCIAPI::vehicle.getSpeed (m_id);}
+    double getSpeedValue() {const TraciClient::StationKinematics_t *k = m_traci_client->GetStationKinematics (m_id); return k != nullptr ? k->speed : m_traci_client->TraCIAPI::vehicle.getSpeed (m_id);}
     /**
      * @brief This function returns the vehicle's travelled distance.
      * @return
      */
-    double getTravelledDistance() {return m_traci_client->TraCIAPI::vehicle.getDistance (m_id);}
+    double getTravelledDistance() {const TraciClient::StationKinematics_t *k = m_traci_client->GetStationKinematics (m_id); return k != nullptr ? k->distance : m_traci_client->TraCIAPI::vehicle.getDistance (m_id);}
     /**
      * @brief This function returns the vehicle's heading.
      * @return
      */
-    double getHeadingValue() {return m_traci_client->TraCIAPI::vehicle.getAngle (m_id);}
+    double getHeadingValue() {const TraciClient::StationKinematics_t *k = m_traci_client->GetStationKinematics (m_id); return k != nullptr ? k->angle : m_traci_client->TraCIAPI::vehicle.getAngle (m_id);}
 
     // Added for GeoNet functionalities
     /**
@@ -148,6 +153,10 @@ namespace ns3 {
     void setSafetyCarContainerData(VDP_SafetyCarContainerData_t data) {m_safetyCarContainerData = VDPDataItem<VDP_SafetyCarContainerData_t>(data);}
 
     private:
+      // SUMO position of the vehicle (or of the POI, for a static station)
+      libsumo::TraCIPosition getSumoPosition();
+      double getAccelerationValue() {const TraciClient::StationKinematics_t *k = m_traci_client->GetStationKinematics (m_id); return k != nullptr ? k->acceleration : m_traci_client->TraCIAPI::vehicle.getAcceleration (m_id);}
+
       std::string m_id;
       Ptr<TraciClient> m_traci_client;
       bool m_isStatic;
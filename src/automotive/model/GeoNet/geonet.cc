@@ -23,6 +23,8 @@
 #include "ns3/log.h"
 #include "ns3/network-module.h"
 #include "ns3/gn-utils.h"
+#include "ns3/gn-offset-header.h"
+#include "ns3/rx-allocation-counter.h"
 #include <cmath>
 #include "ns3/ipv4-header.h"
 #define SN_MAX 65536
@@ -58,8 +60,12 @@ namespace ns3 {
 
     m_RSU_epv_set=false;
     m_metric_supervisor_ptr = NULL;
+    m_vdp = nullptr;
+    m_vrudp = nullptr;
 
     m_PRRsupervisor_beacons = true;
+
+    m_timerQueue.setExpireCallback (std::bind(&GeoNet::timerExpired,this,std::placeholders::_1,std::placeholders::_2));
   }
 
   void
@@ -67,6 +73,12 @@ namespace ns3 {
   {
     Simulator::Cancel(m_event_EPVupdate);
     Simulator::Cancel(m_event_Beacon);
+    Simulator::Cancel(m_event_LocTSweep);
+    m_timerQueue.clear ();
+    m_CbfBuffer.clear ();
+    m_CbfIndex.clear ();
+    m_BcForwardingBuffer.clear ();
+    m_Repetition_packets.clear ();
     m_EPVupdate_running=false;
     m_socket_tx->ShutdownRecv ();
   }
@@ -261,12 +273,16 @@ namespace ns3 {
     {
        return MAX_LIFE_EXCEEDED;
     }
+    Ptr<Packet> sdu = nullptr;
     if(dataRequest.GNRepInt != 0)
     {
       if(dataRequest.GNRepInt < m_GNMinPacketRepetitionInterval)
       {
         return REP_INTERVAL_LOW;
       }
+      //Keep the SDU for the repetitions: the GN headers are added to a copy of it (copy-on-write, the payload is not duplicated)
+      sdu = dataRequest.data;
+      dataRequest.data = sdu->Copy ();
     }
 
     //Basic Header field setting according to ETSI EN 302 636-4-1 [10.3.2]
@@ -342,6 +358,13 @@ namespace ns3 {
       NS_LOG_ERROR("GeoNet packet not supported");
       dataConfirm = UNSPECIFIED_ERROR;
     }
+
+    //If the optional repetition interval parameter is set, save the packet for the repetitions (step 4 of [10.3.10.2], step 6 of [10.3.11.2])
+    if(sdu != nullptr && dataConfirm == ACCEPTED)
+    {
+      dataRequest.data = sdu;
+      saveRepPacket (dataRequest);
+    }
     return dataConfirm;
   }
 
@@ -361,18 +384,13 @@ namespace ns3 {
     //2)Security setting -not implemeted yet-
     //3)If not suitable neighbour exist in the LocT and the SCF for the traffic class is set:
 
-    if((dataRequest.GNTraClass > 128) && (!hasNeighbour ()))
+    if((dataRequest.GNTraClass & 0x80) && (!hasNeighbour ()))
     {
       //a)Buffer the SHB packet in the BC forwarding buffer and omit execution of further steps
-      return UNSUPPORTED_TRA_CLASS;//Not implemented yet
-    }
-    //4)If the optional repetition interval paramter in the GN-dataRequest parameter is set
-    if(dataRequest.GNRepInt != 0)
-    {
-      if(dataRequest.GNRepInt < m_GNMinPacketRepetitionInterval) return REP_INTERVAL_LOW;
-      //a)save the SHB packet
-      saveRepPacket (dataRequest);
+      bufferBC (dataRequest.data);
+      return ACCEPTED;
     }
+    //4)If the optional repetition interval paramter in the GN-dataRequest parameter is set, the packet is saved by sendGN()
     //5)Media dependent procedures -Omited-
     //6)Pass the GN-PDU to the LL protocol entity
     if(m_socket_tx==NULL)
@@ -425,25 +443,33 @@ namespace ns3 {
      * 2)If not suitable neighbour exist in the LocT and the SCF for the traffic class is set:
      * a)Buffer the SHB packet in the BC forwarding buffer and omit execution of further steps
     */
-    if((dataRequest.GNTraClass >= 128) && (!hasNeighbour ()))
-    {
-      return UNSUPPORTED_TRA_CLASS;//Not implemented yet
-    }
-    //!3)Execute forwarding algorithm selection procedure, not implemented because RSU in our case will always be inside the target area
-    //4) if packet is buffered in any of the forwarding packets, omit further steps
-    if(m_GNAreaForwardingAlgorithm == 2)
-    {
-      /* push packet into CBF buffer */
-      return UNSPECIFIED_ERROR;
+    if((dataRequest.GNTraClass & 0x80) && (!hasNeighbour ()))
+    {
+      bufferBC (dataRequest.data);
+      m_seqNumber = (m_seqNumber+1)% SN_MAX;
+      return ACCEPTED;
+    }
+    //3)Execute forwarding algorithm selection procedure [Annex D]
+    //Inside the area, or with CBF, the source always broadcasts the packet [Annex E.3]; outside the area, with
+    //greedy forwarding, the packet is sent to the neighbour with the most forward progress towards the area [Annex E.2].
+    //A packet which cannot be forwarded any further (RHL=1) is always broadcast, so that it reaches all the routers
+    //already inside the area, instead of a single next hop which would then discard it
+    Mac48Address nextHop;
+    bool unicast = false;
+    if((m_GNNonAreaForwardingAlgorithm == 0 || m_GNNonAreaForwardingAlgorithm == 1) && basicHeader.GetRemainingHL () > 1 && !isInsideGeoArea (dataRequest.GnAddress))
+    {
+      unicast = greedyNextHop (dataRequest.GnAddress,nextHop);
+      //4) if packet is buffered in any of the forwarding packets, omit further steps
+      if(!unicast && (dataRequest.GNTraClass & 0x80))
+      {
+        //Local optimum with store-carry-forward enabled
+        bufferBC (dataRequest.data);
+        m_seqNumber = (m_seqNumber+1)% SN_MAX;
+        return ACCEPTED;
+      }
     }
     //!5)Security profile settings not implemented
-    //6)If the optional repetition interval paramter in the GN-dataRequest parameter is set
-    if(dataRequest.GNRepInt != 0)
-    {
-      if(dataRequest.GNRepInt < m_GNMinPacketRepetitionInterval) return REP_INTERVAL_LOW;
-      //a)save the SHB packet
-      saveRepPacket(dataRequest);
-    }
+    //6)If the optional repetition interval paramter in the GN-dataRequest parameter is set, the packet is saved by sendGN()
     //!7)Media dependent procedures -Omited-
     //8)Pass the GN-PDU to the LL protocol entity
     if(m_socket_tx==NULL)
@@ -465,11 +491,15 @@ namespace ns3 {
       delete[] buffer;
     }
 
-    if(m_socket_tx->Send (dataRequest.data)==-1)
+    if(!transmitPDU (dataRequest.data,unicast ? &nextHop : nullptr))
     {
       NS_LOG_ERROR("Cannot send GBC packet ");
       return UNSPECIFIED_ERROR;
     }
+    if(unicast)
+    {
+      m_fwdStats.greedyUnicast++;
+    }
 
     //*reset beacon timer to prevent dissemination of unnecessary beacon packet
     m_event_Beacon.Cancel ();
@@ -533,6 +563,7 @@ namespace ns3 {
     double x,y,r,f,geoLon,geoLat;
     VDP::VDP_position_cartesian_t egoPos, geoPos;
     if((m_egoPV.POS_EPV.lat==0)||(m_egoPV.POS_EPV.lon==0))return false;//In case egoPV hasnt updated for the first time yet
+    if(m_vdp==nullptr && m_vrudp==nullptr)return true;//No way to project the positions (e.g., RSU without a VDP): assume to be inside the target area
 
     if(m_vdp!=nullptr) {
       egoPos = m_vdp->getXY(m_egoPV.POS_EPV.lon,m_egoPV.POS_EPV.lat); //Compute cartesian position of the vehicle
@@ -603,11 +634,12 @@ namespace ns3 {
   GeoNet::hasNeighbour ()
   {
     bool retval = false;
+    Time now = Simulator::Now ();
     m_LocT_Mutex.lock ();
     std::map<GNAddress,GNLocTE>::iterator locT_it = m_GNLocT.begin ();
     while(locT_it != m_GNLocT.end ())
     {
-      if(locT_it->second.IS_NEIGHBOUR)
+      if(locT_it->second.IS_NEIGHBOUR && locT_it->second.expiry > now)
       {
         retval = true;
         break;
@@ -621,42 +653,43 @@ namespace ns3 {
   void
   GeoNet::saveRepPacket (GNDataRequest_t dataRequest)
   {
-    std::map<GNDataRequest_t, std::pair<Timer,Timer>>::iterator it = m_Repetition_packets.find (dataRequest);
-    if(it == m_Repetition_packets.end ())
-    {
-      //Packet is not already stored
-      m_Repetition_packets.emplace(dataRequest,std::pair<Timer,Timer>());
-      //b)retransmit packet with a period as specified in the repetition interval parameter  until the maximim time of the packet is expired
-      GeoNet::setRepInt(std::get<0>(m_Repetition_packets[dataRequest]),MilliSeconds (dataRequest.GNRepInt),&GeoNet::sendGN,dataRequest);
-      GeoNet::setRepInt(std::get<1>(m_Repetition_packets[dataRequest]),MilliSeconds (dataRequest.GNMaxRepTime),&GeoNet::maxRepIntTimeout,dataRequest);
-    }
-    else
-    {
-      //Packet is already stored, reset repetition interval timer
-      GeoNet::setRepInt(std::get<0>(m_Repetition_packets[dataRequest]),MilliSeconds (dataRequest.GNRepInt),&GeoNet::sendGN,dataRequest);
-    }
-  }
+    //a)save the packet (i.e., its SDU, which is sent again with new GN headers, as the repetitions have a new sequence number and position vector)
+    GNRepEntry entry;
+    entry.dataRequest = dataRequest;
+    entry.dataRequest.GNRepInt = 0; //The repetitions are not saved again
+    entry.interval = MilliSeconds (dataRequest.GNRepInt);
+    entry.end = Simulator::Now () + MilliSeconds (dataRequest.GNMaxRepTime);
+    entry.deadline = Simulator::Now () + entry.interval;
 
-  template<typename MEM_PTR> void
-   GeoNet::setRepInt(Timer &timer,Time delay,MEM_PTR callback_fcn,GNDataRequest_t dataRequest) {
-    if(timer.IsRunning ())
+    //b)retransmit packet with a period as specified in the repetition interval parameter until the maximum repetition time of the packet is expired
+    if(entry.deadline >= entry.end)
     {
-       timer.Cancel();
+      return;
     }
-
-    timer.SetFunction(callback_fcn,this);
-    timer.SetArguments(dataRequest);
-    timer.SetDelay (delay);
-
-    timer.Schedule ();
+    uint64_t handle = ++m_timerHandle;
+    m_timerQueue.schedule (handle,entry.deadline);
+    m_Repetition_packets.emplace (handle,entry);
   }
 
   void
-  GeoNet::maxRepIntTimeout(GNDataRequest_t dataRequest)
+  GeoNet::repeatPacket (std::unordered_map<uint64_t,GNRepEntry>::iterator rep_it)
   {
-    //When the maximum repetition time expires the saved packet is erased and the repetition interval timer is canceled
-    std::get<0>(m_Repetition_packets[dataRequest]).Cancel();
-    m_Repetition_packets.erase (dataRequest);
+    GNRepEntry &entry = rep_it->second;
+    GNDataRequest_t dataRequest = entry.dataRequest;
+    dataRequest.data = entry.dataRequest.data->Copy ();
+
+    //Schedule the next repetition (the same entry and handle are reused), or erase the packet when the maximum repetition time expires
+    entry.deadline = entry.deadline + entry.interval;
+    if(entry.deadline < entry.end)
+    {
+      m_timerQueue.schedule (rep_it->first,entry.deadline);
+    }
+    else
+    {
+      m_Repetition_packets.erase (rep_it);
+    }
+
+    sendGN (dataRequest);
   }
 
   void
@@ -673,19 +706,12 @@ namespace ns3 {
     }
 
     dataIndication.data = socket->RecvFrom (from);
+    uint32_t dataSize = dataIndication.data->GetSize ();
+    m_rxSize = 0;
 
-    uint8_t *buffer;
-    uint32_t dataSize;
-    if(m_metric_supervisor_ptr!=nullptr)
-    {
-      buffer = new uint8_t[dataIndication.data->GetSize ()];
-
-      dataSize = dataIndication.data->GetSize ();
-
-      dataIndication.data->CopyData (buffer,dataSize);
-    }
-
-    dataIndication.data->RemoveHeader (basicHeader, 4);
+    // The headers are peeked at their offset (see GNOffsetHeader), and the packet is left untouched until the payload
+    // is passed to the upper layers
+    dataIndication.data->PeekHeader (basicHeader);
     dataIndication.GNRemainingLife = basicHeader.GetLifeTime ();
     dataIndication.GNRemainingHL = basicHeader.GetRemainingHL ();
 
@@ -703,7 +729,8 @@ namespace ns3 {
     dataIndication.GNRemainingLife = decodeLT(basicHeader.GetLifeTime ());
 
     // Common Header Processing according to ETSI EN 302 636-4-1 [10.3.5]
-    dataIndication.data->RemoveHeader (commonHeader, 8);
+    GNOffsetHeader commonOffsetHeader (commonHeader, basicHeader.GetSerializedSize ());
+    dataIndication.data->PeekHeader (commonOffsetHeader);
     dataIndication.upperProtocol = commonHeader.GetNextHeader (); //!Information needed for step 7
     dataIndication.GNTraClass = commonHeader.GetTrafficClass (); //!Information needed for step 7
 
@@ -713,7 +740,7 @@ namespace ns3 {
       NS_LOG_ERROR("Max hop limit greater than remaining hop limit"); //a) if MHL<RHL discard packet and omit execution of further steps
       return;
     }
-    // 2) process the BC forwarding buffer, for now not implemented (SCF in traffic class disabled)
+    // 2) the BC forwarding buffer is flushed in processSHB(), when a new neighbour is detected
     // 3) check HT field
     dataIndication.GNType = commonHeader.GetHeaderType();
     dataIndication.lenght = commonHeader.GetPayload ();
@@ -723,10 +750,10 @@ namespace ns3 {
         if(dataIndication.GNType!=BEACON || m_PRRsupervisor_beacons==true)
         {
           m_metric_supervisor_ptr->updateBytesReceived(dataSize);
-            m_metric_supervisor_ptr->signalReceivedPacket(MetricSupervisor::bufToString (buffer,dataSize),m_station_id);
+          // The supervisor needs the whole PDU: copy it into the receive buffer, which is then also used as a view on the payload
+          copyToRxBuffer (dataIndication.data);
+          m_metric_supervisor_ptr->signalReceivedPacket(MetricSupervisor::bufToString (m_rxBuffer.data (),dataSize),m_station_id);
         }
-
-        delete[] buffer;
     }
 
     switch(dataIndication.GNType)
@@ -735,7 +762,7 @@ namespace ns3 {
         if(commonHeader.GetHeaderSubType ()==0) processSHB (dataIndication,from);
         break;
       case GBC:
-          processGBC (dataIndication,from,commonHeader.GetHeaderSubType ());
+          processGBC (dataIndication,from,basicHeader,commonHeader);
         break;
       case TSB:
             if((commonHeader.GetHeaderSubType ()==0)) processSHB (dataIndication,from);
@@ -746,39 +773,48 @@ namespace ns3 {
   }
 
   void
-  GeoNet::processGBC (GNDataIndication_t dataIndication,Address from, uint8_t shape)
+  GeoNet::copyToRxBuffer (Ptr<Packet> packet)
+  {
+    // The buffer is reused for every packet: it is allocated again only when a larger PDU is received
+    uint32_t size = packet->GetSize ();
+    if(m_rxBuffer.size () < size)
+    {
+      m_rxBuffer.resize (size);
+      RxAllocationCounter::Notify ();
+    }
+    packet->CopyData (m_rxBuffer.data (),size);
+    m_rxSize = size;
+  }
+
+  void
+  GeoNet::processGBC (GNDataIndication_t dataIndication,Address from,GNBasicHeader basicHeader,GNCommonHeader commonHeader)
   {
     // GBC Processing according to ETSI EN 302 636-4-1 [10.3.11.3] 1 and 2 already done in receiveGN method
     GBCheader header;
-    dataIndication.data->RemoveHeader (header,56);
+    GNOffsetHeader gbcOffsetHeader (header,basicHeader.GetSerializedSize () + commonHeader.GetSerializedSize ());
+    uint32_t headersSize = dataIndication.data->PeekHeader (gbcOffsetHeader);
     dataIndication.SourcePV = header.GetLongPositionV ();
     dataIndication.GnAddressDest = header.GetGeoArea ();
-    dataIndication.GnAddressDest.shape = shape;
+    dataIndication.GnAddressDest.shape = commonHeader.GetHeaderSubType ();
+
+    //3)Determine function F as specified in ETSI EN 302 931 (computed only once, as it is needed again in step 7)
+    bool inside = isInsideGeoArea (dataIndication.GnAddressDest);
+    uint16_t algorithm = inside ? m_GNAreaForwardingAlgorithm : m_GNNonAreaForwardingAlgorithm;
+    bool duplicate = false;
 
-    //3)Determine function F as specified in ETSI EN 302 931
     m_LocT_Mutex.lock ();
-    std::map<GNAddress, GNLocTE>::iterator entry_map_it = m_GNLocT.find(dataIndication.SourcePV.GnAddress);
+    std::map<GNAddress, GNLocTE>::iterator entry_map_it = findLocTE(dataIndication.SourcePV.GnAddress);
     if(entry_map_it != m_GNLocT.end())
     {
-      //a)
-      if((!isInsideGeoArea (dataIndication.GnAddressDest)) && ((m_GNNonAreaForwardingAlgorithm==0)||(m_GNNonAreaForwardingAlgorithm==1)))
+      //a) and b) execute DPD as specified in A.2
+      //With CBF, the duplicates are not discarded here, as they are needed to suppress the buffered copy [Annex E.3]
+      duplicate = DPD(header.GetSeqNumber (),entry_map_it->second);
+      if(duplicate && algorithm != 2)
       {
-        //execute DPD as specified in A.2
-        if(DPD(header.GetSeqNumber (),dataIndication.SourcePV.GnAddress))
-        {
-          NS_LOG_ERROR("Duplicate received");
-          return;
-        }
-      }
-      //b)
-      if((isInsideGeoArea (dataIndication.GnAddressDest)) && ((m_GNAreaForwardingAlgorithm==0)||(m_GNAreaForwardingAlgorithm==1)))
-      {
-        //execute DPD as specified in A.2
-        if(DPD(header.GetSeqNumber (),dataIndication.SourcePV.GnAddress))
-        {
-          NS_LOG_ERROR("Duplicate received");
-          return;
-        }
+        NS_LOG_INFO("Duplicate received");
+        m_fwdStats.duplicatesDiscarded++;
+        m_LocT_Mutex.unlock ();
+        return;
       }
     }
     //4) DAD
@@ -789,12 +825,21 @@ namespace ns3 {
          NS_LOG_ERROR("Duplicate address detected");
       }
     }
+    else if(dataIndication.SourcePV.GnAddress == m_GNAddress)
+    {
+      //Packet originated by the local router and forwarded back by a neighbour
+      m_LocT_Mutex.unlock ();
+      return;
+    }
     //Check for LocTE existence
     if (entry_map_it == m_GNLocT.end())
     {
       //5) If LocTE doesn't exist
       newLocTE (dataIndication.SourcePV);//a) create PV with the SO PV in the extended header
-      m_GNLocT[dataIndication.SourcePV.GnAddress].IS_NEIGHBOUR = false;//b) Set the IS_NEIGHBOUR flag to FALSE
+      GNLocTE &entry = m_GNLocT[dataIndication.SourcePV.GnAddress];
+      entry.IS_NEIGHBOUR = false;//b) Set the IS_NEIGHBOUR flag to FALSE
+      //Store the sequence number, so that the copies forwarded by the other routers are detected as duplicates
+      DPD(header.GetSeqNumber (),entry);
       //c) PDR not implemented yet
     }
     else
@@ -803,20 +848,310 @@ namespace ns3 {
       LocTUpdate (dataIndication.SourcePV,entry_map_it);
     }
     m_LocT_Mutex.unlock ();
+
+    //The GN headers are removed before passing the payload to the upper layers: keep a copy of the whole PDU (copy-on-write) if it can be forwarded
+    Ptr<Packet> pdu;
+    if(basicHeader.GetRemainingHL () > 1)
+    {
+      pdu = dataIndication.data->Copy ();
+    }
+
     //7)Determine function F(x,y) as specified in ETSI EN 302 931
-    if(isInsideGeoArea (dataIndication.GnAddressDest))
+    if(inside && !duplicate)
     {
       //a) Pass the payload to the upper protocol entity
       dataIndication.GNType = GBC;
+      dataIndication.data->RemoveAtStart (headersSize);
       dataIndication.lenght = dataIndication.data->GetSize ();
+      dataIndication.payload = rxPayloadView (dataIndication.data);
       m_ReceiveCallback(dataIndication,from);
     }
-    else
+    else if(!inside)
+    {
+      NS_LOG_INFO("GBC packet not passed to the upper layers, as the router is outside the destination area");
+    }
+
+    if(algorithm == 2)
+    {
+      //CBF [Annex E.3]: a copy of a buffered packet has been received from another forwarder, which has won the contention
+      std::map<std::pair<GNAddress,uint16_t>,uint64_t>::iterator index_it = m_CbfIndex.find (std::make_pair (dataIndication.SourcePV.GnAddress,header.GetSeqNumber ()));
+      if(index_it != m_CbfIndex.end ())
+      {
+        std::map<uint64_t,GNCbfEntry>::iterator cbf_it = m_CbfBuffer.find (index_it->second);
+        m_CbfBufferBytes -= cbf_it->second.pdu->GetSize ();
+        m_timerQueue.cancel (cbf_it->first);
+        m_CbfBuffer.erase (cbf_it);
+        m_CbfIndex.erase (index_it);
+        m_fwdStats.cbfSuppressed++;
+        return;
+      }
+      //Already forwarded or suppressed
+      if(duplicate)
+      {
+        return;
+      }
+    }
+
+    //8)Decrement the RHL value, and discard the packet if RHL=0
+    if(basicHeader.GetRemainingHL () <= 1)
+    {
+      return;
+    }
+    basicHeader.SetRemainingHL (basicHeader.GetRemainingHL () - 1);
+
+    //Replace the Basic Header of the GN-PDU to be forwarded, with the decremented RHL
+    GNBasicHeader receivedBasicHeader;
+    pdu->RemoveHeader (receivedBasicHeader, 4);
+    pdu->AddHeader (basicHeader);
+
+    //9)Execute the forwarding algorithm [Annex D]
+    if(algorithm == 2)
+    {
+      //Contention timeout, decreasing with the distance from the sender: the farthest routers forward first
+      double lat,lon;
+      double timeout = m_GNCbfMaxTime;
+      if(senderPosition (from,dataIndication.SourcePV,lat,lon))
+      {
+        double dist = haversineDist (lat,lon,m_egoPV.POS_EPV.lat,m_egoPV.POS_EPV.lon);
+        if(dist <= m_GnDefaultMaxCommunicationRange)
+        {
+          timeout = m_GNCbfMaxTime + ((double) m_GNCbfMinTime - m_GNCbfMaxTime) / m_GnDefaultMaxCommunicationRange * dist;
+        }
+        else
+        {
+          timeout = m_GNCbfMinTime;
+        }
+      }
+      bufferCBF (pdu,dataIndication.SourcePV.GnAddress,header.GetSeqNumber (),MicroSeconds ((int64_t) (timeout*1000)));
+      return;
+    }
+
+    Mac48Address nextHop;
+    bool unicast = false;
+    //As at the source, a packet which cannot be forwarded any further (RHL=1) is broadcast, to reach all the routers
+    //already inside the area
+    if(!inside && basicHeader.GetRemainingHL () > 1 && (algorithm == 0 || algorithm == 1))
+    {
+      //Greedy forwarding [Annex E.2]
+      unicast = greedyNextHop (dataIndication.GnAddressDest,nextHop);
+      if(!unicast && (dataIndication.GNTraClass & 0x80))
+      {
+        bufferBC (pdu);
+        return;
+      }
+    }
+    //Simple forwarding inside the area, or greedy forwarding at a local optimum: broadcast the packet
+    if(transmitPDU (pdu,unicast ? &nextHop : nullptr))
+    {
+      m_fwdStats.gbcForwarded++;
+      if(unicast)
+      {
+        m_fwdStats.greedyUnicast++;
+      }
+    }
+  }
+
+  bool
+  GeoNet::greedyNextHop (GeoArea_t geoArea,Mac48Address &nextHop)
+  {
+    //Most Forward within Radius (MFR) policy [Annex E.2]
+    double destLat = ((double) geoArea.posLat)/DOT_ONE_MICRO;
+    double destLon = ((double) geoArea.posLong)/DOT_ONE_MICRO;
+    double mfr = haversineDist (m_egoPV.POS_EPV.lat,m_egoPV.POS_EPV.lon,destLat,destLon);
+    bool found = false;
+    Time now = Simulator::Now ();
+
+    m_LocT_Mutex.lock ();
+    for(std::map<GNAddress,GNLocTE>::iterator it = m_GNLocT.begin (); it != m_GNLocT.end (); it++)
+    {
+      if(!it->second.IS_NEIGHBOUR || it->second.expiry <= now)
+      {
+        continue;
+      }
+      double dist = haversineDist (((double) it->second.lpv.latitude)/DOT_ONE_MICRO,((double) it->second.lpv.longitude)/DOT_ONE_MICRO,destLat,destLon);
+      if(dist < mfr)
+      {
+        mfr = dist;
+        nextHop = it->second.LL_ADDR;
+        found = true;
+      }
+    }
+    m_LocT_Mutex.unlock ();
+
+    //No neighbour with a positive progress: the local router is a local optimum
+    return found;
+  }
+
+  bool
+  GeoNet::senderPosition (Address from,GNlpv_t sourcePV,double &lat,double &lon)
+  {
+    if(!PacketSocketAddress::IsMatchingType (from))
+    {
+      return false;
+    }
+    Mac48Address sender = getGNMac48 (PacketSocketAddress::ConvertFrom (from).GetPhysicalAddress ());
+
+    //The packet has been received directly from the source
+    if(sender == sourcePV.GnAddress.GetLLAddress ())
     {
-      NS_LOG_INFO("GBC packet discarded because GeoNetworking reported it as out-of-range");
+      lat = ((double) sourcePV.latitude)/DOT_ONE_MICRO;
+      lon = ((double) sourcePV.longitude)/DOT_ONE_MICRO;
+      return true;
+    }
+
+    //Otherwise, look for the position of the forwarder, which is a neighbour, in the Location Table
+    bool found = false;
+    Time now = Simulator::Now ();
+    m_LocT_Mutex.lock ();
+    for(std::map<GNAddress,GNLocTE>::iterator it = m_GNLocT.begin (); it != m_GNLocT.end (); it++)
+    {
+      if(it->second.LL_ADDR == sender && it->second.expiry > now)
+      {
+        lat = ((double) it->second.lpv.latitude)/DOT_ONE_MICRO;
+        lon = ((double) it->second.lpv.longitude)/DOT_ONE_MICRO;
+        found = true;
+        break;
+      }
+    }
+    m_LocT_Mutex.unlock ();
+    return found;
+  }
+
+  void
+  GeoNet::bufferCBF (Ptr<Packet> pdu,const GNAddress &source,uint16_t seqNumber,Time timeout)
+  {
+    //Head drop, when the buffer is full [Annex E.3]
+    while(!m_CbfBuffer.empty () && m_CbfBufferBytes + pdu->GetSize () > (uint32_t) m_FnCbfPacketBufferSize*1024)
+    {
+      std::map<uint64_t,GNCbfEntry>::iterator oldest = m_CbfBuffer.begin ();
+      m_CbfBufferBytes -= oldest->second.pdu->GetSize ();
+      m_CbfIndex.erase (oldest->second.key);
+      m_timerQueue.cancel (oldest->first);
+      m_CbfBuffer.erase (oldest);
+      m_fwdStats.cbfDropped++;
+    }
+
+    GNCbfEntry entry;
+    entry.pdu = pdu;
+    entry.key = std::make_pair (source,seqNumber);
+    entry.bufferedAt = Simulator::Now ();
+    entry.deadline = entry.bufferedAt + timeout;
+
+    uint64_t handle = ++m_timerHandle;
+    m_CbfIndex[entry.key] = handle;
+    m_CbfBufferBytes += pdu->GetSize ();
+    m_timerQueue.schedule (handle,entry.deadline);
+    m_CbfBuffer.emplace (handle,entry);
+    m_fwdStats.cbfBuffered++;
+  }
+
+  void
+  GeoNet::timerExpired (uint64_t handle,Time deadline)
+  {
+    std::unordered_map<uint64_t,GNRepEntry>::iterator rep_it = m_Repetition_packets.find (handle);
+    if(rep_it != m_Repetition_packets.end ())
+    {
+      if(rep_it->second.deadline == deadline)
+      {
+        repeatPacket (rep_it);
+      }
+      return;
+    }
+
+    std::map<uint64_t,GNCbfEntry>::iterator cbf_it = m_CbfBuffer.find (handle);
+    if(cbf_it == m_CbfBuffer.end () || cbf_it->second.deadline != deadline)
+    {
+      //The packet has been suppressed or dropped in the meantime
+      return;
+    }
+
+    //CBF timer expired: no other router has forwarded the packet, so it is re-broadcast [Annex E.3]
+    Ptr<Packet> pdu = cbf_it->second.pdu;
+    Time bufferedAt = cbf_it->second.bufferedAt;
+    m_CbfBufferBytes -= pdu->GetSize ();
+    m_CbfIndex.erase (cbf_it->second.key);
+    m_CbfBuffer.erase (cbf_it);
+
+    if(!refreshLifetime (pdu,bufferedAt))
+    {
+      m_fwdStats.cbfDropped++;
+      return;
+    }
+    if(transmitPDU (pdu,nullptr))
+    {
+      m_fwdStats.gbcForwarded++;
+    }
+  }
+
+  void
+  GeoNet::bufferBC (Ptr<Packet> pdu)
+  {
+    //Head drop, when the buffer is full [7.5.3]
+    while(!m_BcForwardingBuffer.empty () && m_BcBufferBytes + pdu->GetSize () > (uint32_t) m_GnBcForwardingPacketBufferSize*1024)
+    {
+      m_BcBufferBytes -= m_BcForwardingBuffer.front ().pdu->GetSize ();
+      m_BcForwardingBuffer.pop_front ();
+    }
+
+    m_BcForwardingBuffer.push_back ({pdu,Simulator::Now ()});
+    m_BcBufferBytes += pdu->GetSize ();
+    m_fwdStats.scfBuffered++;
+  }
+
+  void
+  GeoNet::flushBC ()
+  {
+    //A new neighbour is available: send all the packets in the BC forwarding buffer, whose lifetime has not expired yet [7.5.3]
+    std::deque<GNBcEntry> buffer;
+    buffer.swap (m_BcForwardingBuffer);
+    m_BcBufferBytes = 0;
+
+    for(GNBcEntry &entry : buffer)
+    {
+      if(refreshLifetime (entry.pdu,entry.bufferedAt))
+      {
+        transmitPDU (entry.pdu,nullptr);
+      }
     }
   }
 
+  bool
+  GeoNet::refreshLifetime (Ptr<Packet> pdu,Time bufferedAt)
+  {
+    //Reduce the LT field of the Basic Header by the time spent in the buffer, and discard the packet if its lifetime expired
+    GNBasicHeader basicHeader;
+    pdu->RemoveHeader (basicHeader);
+
+    double remaining = decodeLT (basicHeader.GetLifeTime ()) - (Simulator::Now () - bufferedAt).GetSeconds ();
+    if(remaining <= 0)
+    {
+      return false;
+    }
+
+    basicHeader.SetLifeTime (encodeLT (remaining));
+    pdu->AddHeader (basicHeader);
+    return true;
+  }
+
+  bool
+  GeoNet::transmitPDU (Ptr<Packet> pdu,const Mac48Address *nextHop)
+  {
+    if(m_socket_tx==NULL)
+    {
+      NS_LOG_ERROR("GeoNet: SOCKET NOT FOUND ");
+      return false;
+    }
+
+    Ptr<NetDevice> device = m_socket_tx->GetNode ()->GetDevice (0);
+    //A next hop can be addressed only if the LL address in the Location Table is the actual address of the device (e.g., 802.11p)
+    if(nextHop != nullptr && Mac48Address::IsMatchingType (device->GetAddress ()))
+    {
+      return m_socket_tx->SendTo (pdu,0,getGNAddress (device->GetIfIndex (),*nextHop)) != -1;
+    }
+
+    return m_socket_tx->Send (pdu) != -1;
+  }
+
   bool
   GeoNet::DAD(GNAddress address)
   {
@@ -834,19 +1169,69 @@ namespace ns3 {
   }
 
   bool
-  GeoNet::DPD(uint16_t seqNumber,GNAddress address)
+  GeoNet::DPD(uint16_t seqNumber,GNLocTE &entry)
   {
-    std::set<uint16_t>::iterator it = m_GNLocT[address].DPL.find(seqNumber);
-    if(it == m_GNLocT[address].DPL.end ())
+    GNDuplicatePacketList &dpl = entry.DPL;
+    const unsigned int words = GNDuplicatePacketList::DPL_WINDOW/64;
+
+    if(!dpl.initialized)
     {
-      //If entry doesnt exist, the packet is not a duplicate and should be added to the list
-      m_GNLocT[address].DPL.insert (seqNumber);
+      dpl.initialized = true;
+      dpl.lastSN = seqNumber;
+      std::fill (dpl.bitmap, dpl.bitmap + words, 0);
+      dpl.bitmap[0] = 1;
       return false;
     }
-    else
+
+    // Distance from the most recent sequence number, modulo 2^16 (half of the space is considered "newer")
+    uint16_t ahead = seqNumber - dpl.lastSN;
+
+    if(ahead != 0 && ahead < 0x8000)
+    {
+      //Newer packet: slide the window forward, so that bit 0 corresponds to the new sequence number
+      if(ahead >= GNDuplicatePacketList::DPL_WINDOW)
+      {
+        std::fill (dpl.bitmap, dpl.bitmap + words, 0);
+      }
+      else
+      {
+        unsigned int word_shift = ahead / 64;
+        unsigned int bit_shift = ahead % 64;
+        for(int i = words - 1; i >= 0; i--)
+        {
+          uint64_t value = 0;
+          if(i - (int) word_shift >= 0)
+          {
+            value = dpl.bitmap[i - word_shift] << bit_shift;
+            if(bit_shift != 0 && i - (int) word_shift - 1 >= 0)
+            {
+              value |= dpl.bitmap[i - word_shift - 1] >> (64 - bit_shift);
+            }
+          }
+          dpl.bitmap[i] = value;
+        }
+      }
+      dpl.lastSN = seqNumber;
+      dpl.bitmap[0] |= 1;
+      return false;
+    }
+
+    uint16_t age = dpl.lastSN - seqNumber;
+    if(age >= GNDuplicatePacketList::DPL_WINDOW)
+    {
+      //Too old to be tracked anymore: consider it a duplicate
+      return true;
+    }
+
+    uint64_t mask = UINT64_C(1) << (age % 64);
+    if(dpl.bitmap[age / 64] & mask)
     {
       return true;//Packet is a duplicate
     }
+
+    //The packet is not a duplicate and should be added to the list
+    dpl.bitmap[age / 64] |= mask;
+    return false;
   }
 
   void
@@ -854,14 +1239,18 @@ namespace ns3 {
   {
     SHBheader shbHeader;
     BeaconHeader beaconHeader;
+    //The extended header follows the Basic Header (4 bytes) and the Common Header (8 bytes)
+    uint32_t headersSize;
     if(dataIndication.GNType == BEACON)
     {
-      dataIndication.data->RemoveHeader (beaconHeader, 24);
+      GNOffsetHeader beaconOffsetHeader (beaconHeader, 12);
+      headersSize = dataIndication.data->PeekHeader (beaconOffsetHeader);
       dataIndication.SourcePV = beaconHeader.GetLongPositionV ();
     }
     else
     {
-      dataIndication.data->RemoveHeader (shbHeader, 28);
+      GNOffsetHeader shbOffsetHeader (shbHeader, 12);
+      headersSize = dataIndication.data->PeekHeader (shbOffsetHeader);
       dataIndication.SourcePV = shbHeader.GetLongPositionV ();
     }
     // SHB Processing according to ETSI EN 302 636-4-1 [10.3.10.3] or Beacon processing according to [10.3.6.3]
@@ -875,9 +1264,10 @@ namespace ns3 {
     }
     //4)update PV in the SO LocTE with the SO PV fields of the SHB extended header
     m_LocT_Mutex.lock ();
-    std::map<GNAddress, GNLocTE>::iterator entry_map_it = m_GNLocT.find(dataIndication.SourcePV.GnAddress);
+    std::map<GNAddress, GNLocTE>::iterator entry_map_it = findLocTE(dataIndication.SourcePV.GnAddress);
 
     //Not specified in the protocol but first check if LocTE exist in the LocTable
+    bool newNeighbour = true;
     if (entry_map_it == m_GNLocT.end())
     {
       newLocTE (dataIndication.SourcePV);
@@ -887,12 +1277,20 @@ namespace ns3 {
       //Update LongPV
       LocTUpdate (dataIndication.SourcePV,entry_map_it);
       //6)Set IS_NEIGHBOUR flag to true
+      newNeighbour = !entry_map_it->second.IS_NEIGHBOUR;
       entry_map_it->second.IS_NEIGHBOUR = true;
     }
     m_LocT_Mutex.unlock ();
+    //5)Flush the packets waiting for a neighbour in the BC forwarding buffer
+    if(newNeighbour && !m_BcForwardingBuffer.empty ())
+    {
+      flushBC ();
+    }
     //7) Pass the payload to the upper protocol entity if it's not a beacon packet
     if(dataIndication.GNType != BEACON)
     {
+      dataIndication.data->RemoveAtStart (headersSize);
+      dataIndication.payload = rxPayloadView (dataIndication.data);
       m_ReceiveCallback(dataIndication,from);
     }
   }
@@ -913,27 +1311,32 @@ namespace ns3 {
     new_entry.PDR = 0; //!Packet data rate, yet to be implemented
 
     //Before storing the new entry, start the T(LocTE) as specified in [8.1.3]
-    m_GNLocTTimer.emplace(lpv.GnAddress, Timer());
-    GeoNet::setTLocT(m_GNLocTTimer[lpv.GnAddress],Seconds(m_GnLifeTimeLocTE),&GeoNet::LocTE_timeout,lpv.GnAddress);
+    new_entry.expiry = Simulator::Now () + Seconds(m_GnLifeTimeLocTE);
     //!LS_PENDING timer [8.1.3] not implemented yet
 
-    //Store new entry
-    m_GNLocT.emplace(lpv.GnAddress,new_entry);
+    //Store new entry (replacing any expired entry with the same address)
+    m_GNLocT[lpv.GnAddress] = new_entry;
+
+    //The expired entries which are not accessed anymore are periodically removed
+    if(!m_event_LocTSweep.IsRunning ())
+    {
+      m_event_LocTSweep = Simulator::Schedule (Seconds(m_GnLifeTimeLocTE),&GeoNet::LocTSweep,this);
+    }
   }
 
-  template<typename MEM_PTR> void
-  GeoNet::setTLocT(Timer &timer,Time delay,MEM_PTR callback_fcn,GNAddress address)
+  std::map<GNAddress,GNLocTE>::iterator
+  GeoNet::findLocTE (const GNAddress &address)
   {
-    if(timer.IsRunning ())
+    std::map<GNAddress,GNLocTE>::iterator it = m_GNLocT.find (address);
+
+    //T(LocTE) expired: remove the entry [8.1.3]
+    if(it != m_GNLocT.end () && it->second.expiry <= Simulator::Now ())
     {
-       timer.Cancel();
+      m_GNLocT.erase (it);
+      return m_GNLocT.end ();
     }
 
-    timer.SetFunction(callback_fcn,this);
-    timer.SetArguments(address);
-    timer.SetDelay (delay);
-
-    timer.Schedule ();
+    return it;
   }
 
   void
@@ -946,11 +1349,8 @@ namespace ns3 {
        ((TSTpv_locT>TSTpv_rp) && ((TSTpv_locT-TSTpv_rp)>TS_MAX/2)))
     {
       //TSTpv_rp greater than TSTpv_locT
-      //Cancel T(LocTE) from previous entry even if this is done by setTLocT
-      m_GNLocTTimer[lpv.GnAddress].Cancel();
-      //Before updating entry, start the T(LocTE) as specified in [8.1.3]
-      m_GNLocTTimer.emplace(lpv.GnAddress, Timer ());
-      GeoNet::setTLocT(m_GNLocTTimer[lpv.GnAddress],Seconds(m_GnLifeTimeLocTE),&GeoNet::LocTE_timeout,lpv.GnAddress);
+      //Before updating entry, restart the T(LocTE) as specified in [8.1.3]
+      locte_it->second.expiry = Simulator::Now () + Seconds(m_GnLifeTimeLocTE);
       //PVlocT <- PVrp
       locte_it->second.lpv = lpv;
     }
@@ -961,12 +1361,30 @@ namespace ns3 {
   }
 
   void
-  GeoNet::LocTE_timeout (GNAddress entry_address)
+  GeoNet::LocTSweep ()
   {
+      Time now = Simulator::Now ();
+
       m_LocT_Mutex.lock ();
-      m_GNLocTTimer.erase(entry_address);
-      m_GNLocT.erase(entry_address);
+      for(std::map<GNAddress,GNLocTE>::iterator it = m_GNLocT.begin (); it != m_GNLocT.end ();)
+      {
+        if(it->second.expiry <= now)
+        {
+          it = m_GNLocT.erase (it);
+        }
+        else
+        {
+          it++;
+        }
+      }
+      bool empty = m_GNLocT.empty ();
       m_LocT_Mutex.unlock ();
+
+      //No need to keep sweeping an empty table: the sweep is restarted by newLocTE()
+      if(!empty)
+      {
+        m_event_LocTSweep = Simulator::Schedule (Seconds(m_GnLifeTimeLocTE),&GeoNet::LocTSweep,this);
+      }
   }
 
   Ptr<Socket>
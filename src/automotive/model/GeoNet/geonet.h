@@ -6,6 +6,10 @@
 #include <string>
 #include <map>
 #include <set>
+#include <deque>
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
 #include <mutex>
 #include "ns3/vdpTraci.h"
 #include "ns3/asn_utils.h"
@@ -24,6 +28,7 @@
 #include "ns3/longpositionvector.h"
 #include "ns3/btpdatarequest.h"
 #include "ns3/VRUdp.h"
+#include "ns3/gn-timer-queue.h"
 
 extern "C" {
   #include "ns3/CAM.h"
@@ -44,6 +49,20 @@ namespace ns3
   {
     public:
 
+      /**
+      *   ETSI EN 302 636-4-1 [A.2]: Duplicate Packet List, implemented as a sliding window over the 16-bit sequence
+      *   number space. Only the last DPL_WINDOW sequence numbers are tracked, in a bitmap, so its size is constant.
+      */
+      typedef struct _DuplicatePacketList {
+        static const uint16_t DPL_WINDOW = 256;
+
+        bool initialized = false;
+        uint16_t lastSN = 0; //! Most recent sequence number received from the source
+        uint64_t bitmap[DPL_WINDOW/64] = {}; //! Bit i is set if the sequence number lastSN-i has been received
+
+        void clear() {initialized = false; lastSN = 0; std::fill (bitmap, bitmap + DPL_WINDOW/64, 0);}
+      } GNDuplicatePacketList;
+
       typedef struct _LocTableEntry {
         /**
         *   ETSI EN 302 636-4-1 [8.1.2]
@@ -55,11 +74,22 @@ namespace ns3
         GNlpv_t lpv; //! long position vector
         bool LS_PENDING;
         bool IS_NEIGHBOUR;
-        std::set<uint16_t> DPL; //! Duplicate packet list
+        GNDuplicatePacketList DPL; //! Duplicate packet list
         long timestamp;
         uint32_t PDR;
+        Time expiry; //! Expiration time of the entry, i.e., of T(LocTE) [8.1.3]
       } GNLocTE;
 
+      typedef struct _forwardingStats {
+        uint64_t gbcForwarded = 0; //! GBC packets received and (re)transmitted by this router, as a forwarder
+        uint64_t greedyUnicast = 0; //! GBC packets sent or forwarded to a greedy next hop, instead of being broadcast
+        uint64_t duplicatesDiscarded = 0; //! Packets discarded by the Duplicate Packet Detection
+        uint64_t cbfBuffered = 0; //! GBC packets stored in the CBF buffer, waiting for their contention timer
+        uint64_t cbfSuppressed = 0; //! Buffered GBC packets removed without being forwarded, because a duplicate has been received
+        uint64_t cbfDropped = 0; //! Buffered GBC packets removed because of a buffer overflow or because their lifetime expired
+        uint64_t scfBuffered = 0; //! Packets stored in the BC forwarding buffer, waiting for a neighbour (store-carry-forward)
+      } GNForwardingStats_t;
+
       typedef struct _egoPositionVector {
         /**
         *   ETSI EN 302 636-4-1 [8.2.2]
@@ -147,12 +177,33 @@ namespace ns3
       // It requires as input a pointer to the node to which the socket should be bound
       static Ptr<Socket> createGNPacketSocket(Ptr<Node> node_ptr);
 
+      /**
+       * @brief Set the forwarding algorithm used when the router is inside the destination area of a GBC packet.
+       *
+       * ETSI EN 302 636-4-1 [Annex H]: 0 (UNSPECIFIED) and 1 (SIMPLE) immediately re-broadcast each new packet, 2 (CBF)
+       * enables Contention-Based Forwarding [Annex E.3]: the packet is buffered with a timeout which decreases with the
+       * distance from the sender, and it is re-broadcast only if no duplicate is received before the timeout expires.
+       */
+      void setAreaForwardingAlgorithm(uint16_t algorithm) {m_GNAreaForwardingAlgorithm=algorithm;}
+      /**
+       * @brief Set the forwarding algorithm used when the router is outside the destination area of a GBC packet.
+       *
+       * ETSI EN 302 636-4-1 [Annex H]: 0 (UNSPECIFIED) and 1 (GREEDY) send the packet to the neighbour in the Location
+       * Table with the most forward progress towards the destination area [Annex E.2], 2 (CBF) uses Contention-Based Forwarding.
+       */
+      void setNonAreaForwardingAlgorithm(uint16_t algorithm) {m_GNNonAreaForwardingAlgorithm=algorithm;}
+      /**
+       * @brief Get the number of packets forwarded, buffered and suppressed by this router, to evaluate the redundant rebroadcasts.
+       */
+      const GNForwardingStats_t &getForwardingStats() const {return m_fwdStats;}
+
   private:
-      void LocTE_timeout(GNAddress entry_address);
+      void LocTSweep();
+      std::map<GNAddress,GNLocTE>::iterator findLocTE(const GNAddress &address);
       void newLocTE(GNlpv_t longPositionVector);
       void LocTUpdate(GNlpv_t lpv,std::map<GNAddress,GNLocTE>::iterator locte_it);
       void processSHB(GNDataIndication_t dataIndication,Address address);
-      void processGBC(GNDataIndication_t dataIndication,Address address,uint8_t shape);
+      void processGBC(GNDataIndication_t dataIndication,Address address,GNBasicHeader basicHeader,GNCommonHeader commonHeader);
       uint8_t encodeLT(double seconds);
       double decodeLT(uint8_t lifeTime);
       bool hasNeighbour();
@@ -160,20 +211,62 @@ namespace ns3
       GNDataConfirm_t sendGBC(GNDataRequest_t dataRequest,GNCommonHeader commonHeader,GNBasicHeader basicHeader,GNlpv_t longPV);
       GNDataConfirm_t sendBeacon(GNDataRequest_t dataRequest,GNCommonHeader commonHeader,GNBasicHeader basicHeader,GNlpv_t longPV);
       bool isInsideGeoArea(GeoArea_t geoArea);
-      bool DPD(uint16_t seqNumber,GNAddress address);
+      bool DPD(uint16_t seqNumber,GNLocTE &entry);
       bool DAD(GNAddress address);
+      bool greedyNextHop(GeoArea_t geoArea,Mac48Address &nextHop);
+      bool senderPosition(Address from,GNlpv_t sourcePV,double &lat,double &lon);
+      void bufferCBF(Ptr<Packet> pdu,const GNAddress &source,uint16_t seqNumber,Time timeout);
+      void bufferBC(Ptr<Packet> pdu);
+      void flushBC();
+      bool refreshLifetime(Ptr<Packet> pdu,Time bufferedAt);
+      bool transmitPDU(Ptr<Packet> pdu,const Mac48Address *nextHop);
+      void timerExpired(uint64_t handle,Time deadline);
       void setBeacon();
       void saveRepPacket(GNDataRequest_t dataRequest);
-      void maxRepIntTimeout(GNDataRequest_t dataRequest);
       int get_messageID_from_BTP_port(int16_t port);
 
 
+      // The entries of the Location Table expire lazily: an expired entry is ignored (and removed) as soon as it is accessed,
+      // and a single periodic sweep removes the expired entries which are not accessed anymore, instead of having one T(LocTE)
+      // timer for each entry, rescheduled every time the entry is updated
       std::map<GNAddress,GNLocTE> m_GNLocT;///! ETSI EN 302 636-4-1 [8.1]
-      std::map<GNAddress,Timer> m_GNLocTTimer; ///! Timer for every new entry in th Location Table
-      template<typename MEM_PTR> void setTLocT(Timer &timer,Time delay,MEM_PTR callback_fcn,GNAddress address);
+      EventId m_event_LocTSweep; ///! Periodic removal of the expired Location Table entries
+
+      typedef struct _repetitionEntry {
+        GNDataRequest_t dataRequest; //! Request with the SDU, without GN headers
+        Time interval; //! Repetition interval
+        Time end; //! Expiration of the maximum repetition time
+        Time deadline; //! Time of the next repetition
+      } GNRepEntry;
+
+      typedef struct _CBFBufferEntry {
+        Ptr<Packet> pdu; //! Complete GN-PDU, with the remaining hop limit already decremented
+        std::pair<GNAddress,uint16_t> key; //! Source address and sequence number of the packet
+        Time bufferedAt;
+        Time deadline; //! Expiration of the CBF timer
+      } GNCbfEntry;
 
-      std::map<GNDataRequest_t,std::pair<Timer,Timer>> m_Repetition_packets;///! Timers for packets with repetition interval enabled
-      template<typename MEM_PTR> void setRepInt(Timer &timer,Time delay,MEM_PTR callback_fcn,GNDataRequest_t dataRequest);
+      typedef struct _BCBufferEntry {
+        Ptr<Packet> pdu; //! Complete GN-PDU
+        Time bufferedAt;
+      } GNBcEntry;
+
+      // ETSI EN 302 636-4-1 [Annex E.3]: the CBF packet buffer is keyed by the handle of the CBF timer (i.e., in order of
+      // insertion), and indexed by source address and sequence number to suppress the buffered packets when a duplicate is received
+      std::map<uint64_t,GNCbfEntry> m_CbfBuffer;
+      std::map<std::pair<GNAddress,uint16_t>,uint64_t> m_CbfIndex;
+      uint32_t m_CbfBufferBytes = 0;
+      std::deque<GNBcEntry> m_BcForwardingBuffer; ///! ETSI EN 302 636-4-1 [7.5.3] (store-carry-forward)
+      uint32_t m_BcBufferBytes = 0;
+
+      GNTimerQueue m_timerQueue; ///! Single queue for all the timers of the buffered and repeated packets
+      uint64_t m_timerHandle = 0; ///! Last handle assigned to a timer in m_timerQueue
+      GNForwardingStats_t m_fwdStats;
+
+      // Packets with the repetition interval enabled, identified by the handle of their timer in m_timerQueue, which is
+      // reused for all the repetitions of the same packet
+      std::unordered_map<uint64_t,GNRepEntry> m_Repetition_packets;
+      void repeatPacket(std::unordered_map<uint64_t,GNRepEntry>::iterator rep_it);
 
       std::mutex m_LocT_Mutex;
 
@@ -188,6 +281,13 @@ namespace ns3
 
       std::function<void(GNDataIndication_t,Address)> m_ReceiveCallback;
 
+      void copyToRxBuffer(Ptr<Packet> packet);
+      // View on the payload of the packet being received (after the GN headers), or NULL if the PDU was not copied into m_rxBuffer
+      const uint8_t *rxPayloadView(Ptr<Packet> packet) const {return m_rxSize > 0 ? m_rxBuffer.data () + (m_rxSize - packet->GetSize ()) : NULL;}
+
+      std::vector<uint8_t> m_rxBuffer; //! Buffer reused to copy the whole GeoNetworking PDU, only when a MetricSupervisor needs it
+      uint32_t m_rxSize = 0; //! Size of the PDU currently stored in m_rxBuffer (0 if the packet being received was not copied)
+
 
       VDP* m_vdp; //! Pointer to the VDP object
       VRUdp* m_vrudp; //! Pointer to the VRUdp object
@@ -224,14 +324,14 @@ namespace ns3
       uint16_t m_GNMaxGeoAreaSize = 10;
       uint16_t m_GNMinPacketRepetitionInterval = 100;
       uint16_t m_GNNonAreaForwardingAlgorithm = 1; //! GREEDY
-      uint16_t m_GNAreaForwardingAlgorithm = 1;
-      uint16_t m_GNCbfMinTime = 1;
-      uint16_t m_GNCbfMaxTime = 100;
+      uint16_t m_GNAreaForwardingAlgorithm = 1; //! SIMPLE
+      uint16_t m_GNCbfMinTime = 1; ///! ms
+      uint16_t m_GNCbfMaxTime = 100; ///! ms
       uint16_t m_GnDefaultMaxCommunicationRange = 1000;
       uint16_t m_GnBroadcastCBFDefSectorAngle = 30;
       uint16_t m_GnUcForwardingPacketBufferSize = 256;
-      uint16_t m_GnBcForwardingPacketBufferSize = 1024;
-      uint16_t m_FnCbfPacketBufferSize = 256;
+      uint16_t m_GnBcForwardingPacketBufferSize = 1024; ///! kbytes
+      uint16_t m_FnCbfPacketBufferSize = 256; ///! kbytes
       uint16_t m_GnDefaultTrafficClass = 0;
       bool m_RSU_epv_set = false;
 
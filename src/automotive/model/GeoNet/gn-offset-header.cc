@@ -0,0 +1,64 @@
+#include "gn-offset-header.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE ("GNOffsetHeader");
+
+  GNOffsetHeader::GNOffsetHeader(Header &header, uint32_t offset) :
+    m_header (header),
+    m_offset (offset)
+  {
+    NS_LOG_FUNCTION (this);
+  }
+
+  GNOffsetHeader::~GNOffsetHeader()
+  {
+    NS_LOG_FUNCTION (this);
+  }
+
+  TypeId
+  GNOffsetHeader::GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::GNOffsetHeader")
+      .SetParent<Header> ()
+      .SetGroupName ("Automotive");
+    return tid;
+  }
+
+  TypeId
+  GNOffsetHeader::GetInstanceTypeId (void) const
+  {
+    return GetTypeId ();
+  }
+
+  uint32_t
+  GNOffsetHeader::GetSerializedSize (void) const
+  {
+    return m_offset + m_header.GetSerializedSize ();
+  }
+
+  void
+  GNOffsetHeader::Print (std::ostream &os) const
+  {
+    os << "offset=" << m_offset << " ";
+    m_header.Print (os);
+  }
+
+  void
+  GNOffsetHeader::Serialize (Buffer::Iterator start) const
+  {
+    NS_FATAL_ERROR ("GNOffsetHeader can only be used to peek a header");
+  }
+
+  uint32_t
+  GNOffsetHeader::Deserialize (Buffer::Iterator start)
+  {
+    Buffer::Iterator i = start;
+    i.Next (m_offset);
+
+    return m_offset + m_header.Deserialize (i);
+  }
+
+}
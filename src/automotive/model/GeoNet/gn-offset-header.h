@@ -0,0 +1,34 @@
+#ifndef GN_OFFSET_HEADER_H
+#define GN_OFFSET_HEADER_H
+#include <stdint.h>
+#include "ns3/header.h"
+
+namespace ns3 {
+
+  /**
+   * Adapter to peek a header located at a given offset of a packet, with Packet::PeekHeader().
+   *
+   * GeoNetworking uses it to read the Common Header and the extended headers of a received GN-PDU, without removing
+   * the headers in front of them: the PDU is left untouched (so that it can be forwarded as it is) and the headers
+   * are stripped at once, with Packet::RemoveAtStart(), only if the payload is passed to the upper layers.
+   * The wrapped header is only referenced: it must outlive the adapter. The adapter cannot be serialized.
+   */
+  class GNOffsetHeader : public Header
+  {
+    public:
+      GNOffsetHeader(Header &header, uint32_t offset);
+      ~GNOffsetHeader();
+      static TypeId GetTypeId (void);
+      virtual TypeId GetInstanceTypeId (void) const;
+      virtual void Print (std::ostream &os) const;
+      virtual uint32_t GetSerializedSize (void) const;
+      virtual void Serialize (Buffer::Iterator start) const;
+      virtual uint32_t Deserialize (Buffer::Iterator start);
+
+    private:
+      Header &m_header;
+      uint32_t m_offset;
+  };
+
+}
+#endif // GN_OFFSET_HEADER_H
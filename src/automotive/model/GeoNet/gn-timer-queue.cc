@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "gn-timer-queue.h"
+#include "ns3/simulator.h"
+#include <algorithm>
+
+namespace ns3
+{
+  GNTimerQueue::~GNTimerQueue ()
+  {
+    clear ();
+  }
+
+  void
+  GNTimerQueue::schedule (uint64_t handle,Time deadline)
+  {
+    // The new item supersedes the previous one of the same timer, if any, which becomes stale
+    m_generations[handle] = ++m_lastGeneration;
+    m_heap.push_back ({deadline,handle,m_lastGeneration});
+    std::push_heap (m_heap.begin (),m_heap.end (),later);
+
+    if(!m_expiring && m_heap.size () > 2 * m_generations.size () + PURGE_THRESHOLD)
+    {
+      purge ();
+      scheduleEvent ();
+    }
+    // The simulator event is moved only when the new timer becomes the earliest one
+    else if(!m_expiring && (!m_event.IsRunning () || deadline < m_eventTime))
+    {
+      scheduleEvent ();
+    }
+  }
+
+  void
+  GNTimerQueue::cancel (uint64_t handle)
+  {
+    // The item stays in the heap, as a stale item, until it expires or it is purged
+    m_generations.erase (handle);
+  }
+
+  void
+  GNTimerQueue::clear ()
+  {
+    Simulator::Cancel (m_event);
+    m_heap.clear ();
+    m_generations.clear ();
+  }
+
+  void
+  GNTimerQueue::purge ()
+  {
+    m_heap.erase (std::remove_if (m_heap.begin (),m_heap.end (),[this](const GNTimerQueueItem &item) {
+      std::unordered_map<uint64_t,uint64_t>::const_iterator it = m_generations.find (item.handle);
+      return it == m_generations.end () || it->second != item.generation;
+    }),m_heap.end ());
+    std::make_heap (m_heap.begin (),m_heap.end (),later);
+  }
+
+  void
+  GNTimerQueue::scheduleEvent ()
+  {
+    Simulator::Cancel (m_event);
+    if(m_heap.empty ())
+    {
+      return;
+    }
+
+    Time now = Simulator::Now ();
+    m_eventTime = std::max (m_heap.front ().deadline,now);
+    m_event = Simulator::Schedule (m_eventTime - now,&GNTimerQueue::expire,this);
+  }
+
+  void
+  GNTimerQueue::expire ()
+  {
+    Time now = Simulator::Now ();
+
+    // The callback may schedule new timers: they are pushed into the heap, and the event is scheduled once at the end
+    m_expiring = true;
+    while(!m_heap.empty () && m_heap.front ().deadline <= now)
+    {
+      GNTimerQueueItem item = m_heap.front ();
+      std::pop_heap (m_heap.begin (),m_heap.end (),later);
+      m_heap.pop_back ();
+
+      // Skip the items of the timers which have been rescheduled or cancelled
+      std::unordered_map<uint64_t,uint64_t>::iterator it = m_generations.find (item.handle);
+      if(it == m_generations.end () || it->second != item.generation)
+      {
+        continue;
+      }
+      m_generations.erase (it);
+
+      if(m_expireCallback)
+      {
+        m_expireCallback (item.handle,item.deadline);
+      }
+    }
+    m_expiring = false;
+
+    scheduleEvent ();
+  }
+}
@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef GN_TIMER_QUEUE_H
+#define GN_TIMER_QUEUE_H
+
+#include <stdint.h>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+namespace ns3
+{
+  /**
+   * \ingroup automotive
+   * \brief Per-node queue of GeoNetworking timers, backed by a single ns-3 event
+   *
+   * Instead of scheduling (and cancelling) one simulator event for each buffered or repeated packet, GeoNet keeps all its timers
+   * in this binary heap, and only the earliest deadline is scheduled in the simulator.
+   *
+   * Each timer is identified by a handle chosen by the owner. Rescheduling a timer simply means calling schedule() again
+   * with the same handle: the heap items are never moved, but each of them carries a generation number, and only the
+   * item with the latest generation of its handle is live. The stale items (rescheduled or cancelled timers) are skipped
+   * when they reach the top of the heap, and they are purged once they outnumber the live timers, so that a timer which
+   * is restarted often (e.g., the DENM T_R_Validity timer) does not make the heap grow.
+   */
+  class GNTimerQueue
+  {
+  public:
+    GNTimerQueue() = default;
+    ~GNTimerQueue();
+
+    /**
+     * @brief Set the function called when a timer expires, with the handle and the deadline of the timer.
+     */
+    void setExpireCallback(std::function<void(uint64_t,Time)> expire_callback) {m_expireCallback=expire_callback;}
+    /**
+     * @brief Schedule (or reschedule) the timer identified by "handle" at the absolute simulation time "deadline".
+     */
+    void schedule(uint64_t handle,Time deadline);
+    /**
+     * @brief Stop the timer identified by "handle", if it is running.
+     */
+    void cancel(uint64_t handle);
+    /**
+     * @brief Check if the timer identified by "handle" is running.
+     */
+    bool isRunning(uint64_t handle) const {return m_generations.count (handle) > 0;}
+    /**
+     * @brief Remove all the timers and cancel the simulator event.
+     */
+    void clear();
+    /**
+     * @brief Get the number of running timers.
+     */
+    size_t getSize() const {return m_generations.size ();}
+    /**
+     * @brief Get the number of items in the heap, including the stale ones which have not been purged yet.
+     */
+    size_t getHeapSize() const {return m_heap.size ();}
+
+  private:
+    typedef struct _timerQueueItem {
+      Time deadline;
+      uint64_t handle;
+      uint64_t generation;
+    } GNTimerQueueItem;
+
+    static bool later(const GNTimerQueueItem &a,const GNTimerQueueItem &b) {return a.deadline > b.deadline;}
+
+    void expire();
+    void scheduleEvent();
+    void purge();
+
+    // Minimum number of stale items before the heap is purged
+    static const size_t PURGE_THRESHOLD = 64;
+
+    std::vector<GNTimerQueueItem> m_heap; //! Min-heap of the deadlines
+    std::unordered_map<uint64_t,uint64_t> m_generations; //! Generation of the live item of each running timer
+    uint64_t m_lastGeneration = 0;
+    std::function<void(uint64_t,Time)> m_expireCallback;
+    EventId m_event; //! Simulator event for the earliest deadline
+    Time m_eventTime; //! Time at which m_event is scheduled
+    bool m_expiring = false; //! True while the expired timers are being processed
+  };
+}
+
+#endif // GN_TIMER_QUEUE_H
@@ -68,16 +68,17 @@ MetricSupervisor::~MetricSupervisor ()
 std::string
 MetricSupervisor::bufToString(uint8_t *buf, uint32_t bufsize)
 {
-  std::stringstream bufss;
-
-  bufss << std::hex << std::setfill('0');
+  static const char hexdigits[] = "0123456789abcdef";
+  std::string bufstr(bufsize*2,'0');
 
+  // This function is called for every sent and received packet: avoid going through a stringstream
   for(size_t i=0;i<bufsize;++i)
     {
-      bufss << std::setw(2) << static_cast<unsigned>(buf[i]);
+      bufstr[2*i] = hexdigits[buf[i] >> 4];
+      bufstr[2*i+1] = hexdigits[buf[i] & 0x0F];
     }
 
-  return bufss.str();
+  return bufstr;
 }
 
 void
@@ -95,43 +96,44 @@ MetricSupervisor::signalSentPacket(std::string buf, double lat, double lon, uint
           return;
         }
 
-      //std::vector<std::string> ids = m_traci_ptr->TraCIAPI::vehicle.getIDList ();
-      std::map<std::string, std::pair<StationType_t, Ptr<Node>>> node_map =
-          m_traci_ptr->get_NodeMap ();
+      // In partitioned mode, each packet is measured only by the process owning its sender: packets sent by ghost
+      // nodes are measured by the process of the neighbouring tile, and they are ignored here
+      bool senderOwned = true;
 
-      for (std::map<std::string, std::pair<StationType_t, Ptr<Node>>>::iterator it =
-               node_map.begin ();
-           it != node_map.end (); ++it)
+      // Iterate directly over the TraCI client node registry (no copies, station IDs already parsed)
+      for (const TraciClient::NodeEntry_t &entry : m_traci_ptr->GetNodeEntries ())
         {
-          StationType_t station_type = it->second.first;
+          StationType_t station_type = entry.stationType;
           uint64_t stationID;
           if (station_type == StationType_roadSideUnit)
             {
-              uint64_t id = std::stoi (it->first.substr (it->first.find ("_") + 1));
-              stationID = m_stationId_baseline + id;
+              stationID = m_stationId_baseline + entry.stationId;
             }
           else
             {
-              stationID = std::stol (it->first.substr (3));
+              stationID = entry.stationId;
             }
 
           libsumo::TraCIPosition pos;
           if (station_type == StationType_pedestrian)
             {
-              pos = m_traci_ptr->TraCIAPI::person.getPosition (it->first);
+              pos = m_traci_ptr->TraCIAPI::person.getPosition (entry.sumoId);
             }
           else if (station_type == StationType_roadSideUnit)
             {
-              pos = m_traci_ptr->TraCIAPI::poi.getPosition (it->first);
+              pos = m_traci_ptr->TraCIAPI::poi.getPosition (entry.sumoId);
             }
           else
             {
-              pos = m_traci_ptr->TraCIAPI::vehicle.getPosition (it->first);
+              pos = m_traci_ptr->TraCIAPI::vehicle.getPosition (entry.sumoId);
             }
           pos = m_traci_ptr->TraCIAPI::simulation.convertXYtoLonLat (pos.x, pos.y);
 
           if (stationID == nodeID)
-            m_stationtype_map[buf] = station_type;
+            {
+              m_stationtype_map[buf] = station_type;
+              senderOwned = m_traci_ptr->IsOwned (entry.node);
+            }
 
           if (m_excluded_vehID_enabled == false ||
               (m_excluded_vehID_list.find (stationID) == m_excluded_vehID_list.end ()))
@@ -142,6 +144,13 @@ MetricSupervisor::signalSentPacket(std::string buf, double lat, double lon, uint
                 }
             }
         }
+
+      if (senderOwned == false)
+        {
+          m_packetbuff_map.erase (buf);
+          m_stationtype_map.erase (buf);
+          return;
+        }
     }
   else if(m_carla_ptr != nullptr)
     {
@@ -215,6 +224,12 @@ MetricSupervisor::signalReceivedPacket(std::string buf, uint64_t nodeID)
       return;
     }
 
+  // In partitioned mode, ignore the packets sent by ghost nodes, as they are measured by the process owning the sender
+  if(m_traci_ptr != nullptr && m_traci_ptr->GetPartition () != nullptr && m_id_map.count(buf)==0)
+    {
+      return;
+    }
+
   // If the packet was sent by an excluded vehicle due to a problem in the configuration of the simulation, it will be automatically
   // ignored as it will not be in the m_packetbuff_map and m_packetbuff_map.count(buf)==0
   if(m_packetbuff_map.count(buf)>0)
@@ -512,13 +527,11 @@ MetricSupervisor::checkCBR ()
   std::unordered_map<std::string, Time> nextTimeToAddNr;
   if(m_traci_ptr != nullptr)
     {
-      std::map<std::basic_string<char>, std::pair<StationType_t, Ptr<Node>>> nodes = m_traci_ptr->get_NodeMap ();
-
-      for (auto it = nodes.begin (); it != nodes.end (); ++it)
+      for (const TraciClient::NodeEntry_t &entry : m_traci_ptr->GetNodeEntries ())
         {
-          std::string item = it->first;
+          const std::string &item = entry.sumoId;
 
-          std::basic_string<char> node_id = std::to_string (it->second.second->GetId ());
+          std::basic_string<char> node_id = std::to_string (entry.node->GetId ());
 
           if (currentBusyCBR.find (node_id) == currentBusyCBR.end ())
             {
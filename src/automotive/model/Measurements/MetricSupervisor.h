@@ -169,6 +169,18 @@ public:
    * @return  The total number of packets received.
    */
   uint64_t getNumberRx_overall(void) {return m_total_rx;}
+  /**
+   * @brief Get the number of packets for which a PRR value has been computed, i.e., the weight of getAveragePRR_overall().
+   *
+   * This is useful to combine the average PRR of several simulations, e.g., of the processes of a partitioned simulation.
+   * @return  The number of PRR samples.
+   */
+  uint64_t getNumberPRRSamples_overall(void) {return m_count;}
+  /**
+   * @brief Get the number of latency samples, i.e., the weight of getAverageLatency_overall().
+   * @return  The number of latency samples.
+   */
+  uint64_t getNumberLatencySamples_overall(void) {return m_count_latency;}
   /**
    * @brief Get the average number of received packets over all road users.
    * @return  The average number of received packets.
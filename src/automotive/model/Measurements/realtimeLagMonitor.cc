@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "realtimeLagMonitor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/string.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE("RealtimeLagMonitor");
+
+NS_OBJECT_ENSURE_REGISTERED(RealtimeLagMonitor);
+
+TypeId
+RealtimeLagMonitor::GetTypeId ()
+{
+  static TypeId tid = TypeId("ns3::RealtimeLagMonitor")
+      .SetParent <Object>()
+      .AddConstructor <RealtimeLagMonitor>()
+      .AddAttribute ("ProbeInterval",
+          "Interval between two probe events measuring the scheduler lateness.",
+          TimeValue (MilliSeconds (1)),
+          MakeTimeAccessor (&RealtimeLagMonitor::m_probeInterval),
+          MakeTimeChecker ())
+      .AddAttribute ("ReportInterval",
+          "Interval between two reports (the histograms are reset after each report).",
+          TimeValue (Seconds (1)),
+          MakeTimeAccessor (&RealtimeLagMonitor::m_reportInterval),
+          MakeTimeChecker ())
+      .AddAttribute ("LateThreshold",
+          "Lag above which a sample is counted as late; a warning is printed on the standard error for each report with late samples.",
+          TimeValue (MilliSeconds (10)),
+          MakeTimeAccessor (&RealtimeLagMonitor::m_lateThreshold),
+          MakeTimeChecker ())
+      .AddAttribute ("OutputFile",
+          "CSV file where the reports are written. If empty, the reports are printed on the standard output.",
+          StringValue (""),
+          MakeStringAccessor (&RealtimeLagMonitor::m_outputFile),
+          MakeStringChecker ());
+  return tid;
+}
+
+RealtimeLagMonitor::RealtimeLagMonitor ()
+{
+  m_probeInterval = MilliSeconds (1);
+  m_reportInterval = Seconds (1);
+  m_lateThreshold = MilliSeconds (10);
+  m_outputFile = "";
+
+  m_running = false;
+  m_originNs = 0;
+
+  m_sched.reset ();
+  m_wire.reset ();
+}
+
+RealtimeLagMonitor::~RealtimeLagMonitor ()
+{
+}
+
+void
+RealtimeLagMonitor::DoDispose ()
+{
+  Stop ();
+  Object::DoDispose ();
+}
+
+int64_t
+RealtimeLagMonitor::wallClockNs () const
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+}
+
+void
+RealtimeLagMonitor::Start ()
+{
+  if (m_running)
+    {
+      return;
+    }
+
+  StringValue simImpl;
+  GlobalValue::GetValueByName ("SimulatorImplementationType", simImpl);
+  if (simImpl.Get ().find ("Realtime") == std::string::npos)
+    {
+      std::cerr << "RealtimeLagMonitor: the simulator is not real-time (" << simImpl.Get () << "): the measured lag is meaningless." << std::endl;
+    }
+
+  if (!m_outputFile.empty ())
+    {
+      m_file.open (m_outputFile, std::ios::out | std::ios::trunc);
+      if (!m_file.is_open ())
+        {
+          std::cerr << "RealtimeLagMonitor: cannot open " << m_outputFile << ". The reports will be printed on the standard output." << std::endl;
+        }
+      else
+        {
+          m_file << "time_s,metric,count,late,mean_us,p50_us,p99_us,max_us";
+          for (int i = 0; i < numBins; i++)
+            {
+              m_file << ",bin" << i;
+            }
+          m_file << std::endl;
+        }
+    }
+
+  m_running = true;
+  m_originNs = wallClockNs () - Simulator::Now ().GetNanoSeconds ();
+  m_sched.reset ();
+  m_wire.reset ();
+
+  m_probeEvent = Simulator::Schedule (m_probeInterval, &RealtimeLagMonitor::Probe, this);
+  m_reportEvent = Simulator::Schedule (m_reportInterval, &RealtimeLagMonitor::Report, this);
+}
+
+void
+RealtimeLagMonitor::Stop ()
+{
+  if (!m_running)
+    {
+      return;
+    }
+
+  Simulator::Cancel (m_probeEvent);
+  Simulator::Cancel (m_reportEvent);
+
+  // Last (partial) report
+  Report ();
+  Simulator::Cancel (m_reportEvent);
+
+  m_running = false;
+  if (m_file.is_open ())
+    {
+      m_file.close ();
+    }
+}
+
+void
+RealtimeLagMonitor::MonitorDevice (Ptr<BatchedFdNetDevice> dev)
+{
+  dev->TraceConnectWithoutContext ("WireTx", MakeCallback (&RealtimeLagMonitor::WireTx, this));
+}
+
+void
+RealtimeLagMonitor::addSample (lagHistogram_t &hist, int64_t lag_ns)
+{
+  // The clock of the real-time synchronizer and the steady_clock may differ by a few microseconds
+  double lag_us = lag_ns > 0 ? lag_ns / 1000.0 : 0.0;
+
+  int bin = lag_us < 1.0 ? 0 : 1 + (int) std::log2 (lag_us);
+  hist.bins[std::min (bin, numBins - 1)]++;
+
+  hist.count++;
+  hist.sum_us += lag_us;
+  hist.max_us = std::max (hist.max_us, lag_us);
+  if (lag_ns > m_lateThreshold.GetNanoSeconds ())
+    {
+      hist.late++;
+    }
+}
+
+double
+RealtimeLagMonitor::percentile (const lagHistogram_t &hist, double p) const
+{
+  // Upper edge of the bin containing the p-th percentile (capped to the maximum)
+  uint64_t target = (uint64_t) std::ceil (p * hist.count);
+  uint64_t cumulative = 0;
+
+  for (int i = 0; i < numBins; i++)
+    {
+      cumulative += hist.bins[i];
+      if (cumulative >= target && cumulative > 0)
+        {
+          return std::min (std::ldexp (1.0, i), hist.max_us);
+        }
+    }
+
+  return hist.max_us;
+}
+
+void
+RealtimeLagMonitor::Probe ()
+{
+  int64_t expected_ns = m_originNs + Simulator::Now ().GetNanoSeconds ();
+  addSample (m_sched, wallClockNs () - expected_ns);
+
+  m_probeEvent = Simulator::Schedule (m_probeInterval, &RealtimeLagMonitor::Probe, this);
+}
+
+void
+RealtimeLagMonitor::WireTx (Time simTime, int64_t wallClockNs)
+{
+  if (m_running)
+    {
+      addSample (m_wire, wallClockNs - (m_originNs + simTime.GetNanoSeconds ()));
+    }
+}
+
+void
+RealtimeLagMonitor::writeHistogram (const std::string &metric, const lagHistogram_t &hist)
+{
+  double mean_us = hist.count > 0 ? hist.sum_us / hist.count : 0.0;
+
+  if (m_file.is_open ())
+    {
+      m_file << std::fixed << std::setprecision (3) << Simulator::Now ().GetSeconds () << "," << metric << ","
+             << hist.count << "," << hist.late << "," << mean_us << "," << percentile (hist, 0.5) << ","
+             << percentile (hist, 0.99) << "," << hist.max_us;
+      for (int i = 0; i < numBins; i++)
+        {
+          m_file << "," << hist.bins[i];
+        }
+      m_file << std::endl;
+    }
+  else
+    {
+      // Formatted separately, not to change the flags of std::cout
+      std::ostringstream line;
+      line << std::fixed << std::setprecision (1) << "[" << Simulator::Now ().GetSeconds () << " s] " << metric
+           << " lag: " << hist.count << " samples, mean " << mean_us << " us, p50 " << percentile (hist, 0.5)
+           << " us, p99 " << percentile (hist, 0.99) << " us, max " << hist.max_us << " us, "
+           << hist.late << " late";
+      std::cout << line.str () << std::endl;
+    }
+}
+
+void
+RealtimeLagMonitor::reportLate (const std::string &what, const lagHistogram_t &hist)
+{
+  if (hist.late == 0)
+    {
+      return;
+    }
+
+  std::ostringstream line;
+  line << std::fixed << std::setprecision (3) << "[" << Simulator::Now ().GetSeconds ()
+       << " s] RealtimeLagMonitor: the emulation is lagging behind the wall-clock time: " << hist.late << " " << what
+       << " out of " << hist.count << " were more than " << m_lateThreshold.GetMilliSeconds () << " ms late (max: "
+       << hist.max_us / 1000.0 << " ms).";
+  std::cerr << line.str () << std::endl;
+}
+
+void
+RealtimeLagMonitor::Report ()
+{
+  writeHistogram ("sched", m_sched);
+  if (m_wire.count > 0)
+    {
+      writeHistogram ("wire", m_wire);
+    }
+
+  // Printed regardless of the logging configuration (NS_LOG is compiled out in optimized builds)
+  reportLate ("probe events", m_sched);
+  reportLate ("frames", m_wire);
+
+  m_sched.reset ();
+  m_wire.reset ();
+
+  m_reportEvent = Simulator::Schedule (m_reportInterval, &RealtimeLagMonitor::Report, this);
+}
+
+}
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef REALTIMELAGMONITOR_H
+#define REALTIMELAGMONITOR_H
+
+#include <stdint.h>
+#include <array>
+#include <fstream>
+#include <string>
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/batchedFdNetDevice.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup automotive
+ *
+ * \brief Monitor of the lag of the real-time emulation with respect to the wall-clock time.
+ *
+ * When the host cannot keep up with the emulated stations, the RealtimeSimulatorImpl (in best effort mode) simply
+ * executes the events later than their nominal time. This class measures such lag, with two metrics:
+ * - "sched": scheduler lateness, i.e., the wall-clock delay with which a probe event, scheduled every "ProbeInterval",
+ *   is actually executed;
+ * - "wire": host-to-wire latency of the frames sent by the monitored BatchedFdNetDevices, i.e., the wall-clock delay
+ *   between the nominal time at which a frame was sent by the emulated station and the return of sendmmsg().
+ *
+ * The wall-clock time corresponding to each simulation time is computed from the time at which Start() is called
+ * (i.e., the lag at that time is assumed to be zero). Every "ReportInterval", a histogram of each metric, with
+ * logarithmic bins (bin 0: < 1 us, bin i: [2^(i-1), 2^i) us), is appended to "OutputFile" in CSV format, or printed
+ * on the standard output if no file is specified. The reports with samples above "LateThreshold" are also signalled on
+ * the standard error, independently of the logging configuration.
+ */
+class RealtimeLagMonitor : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  RealtimeLagMonitor ();
+  virtual ~RealtimeLagMonitor ();
+
+  void Start (void);
+  void Stop (void);
+
+  // Record the host-to-wire latency of the frames sent by "dev"
+  void MonitorDevice (Ptr<BatchedFdNetDevice> dev);
+
+  static const int numBins = 24;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  typedef struct lagHistogram {
+    std::array<uint64_t,numBins> bins;
+    uint64_t count;
+    uint64_t late; // samples above the "LateThreshold"
+    double sum_us;
+    double max_us;
+
+    void reset (void) {bins.fill (0); count = 0; late = 0; sum_us = 0; max_us = 0;}
+  } lagHistogram_t;
+
+  int64_t wallClockNs (void) const;
+  void addSample (lagHistogram_t &hist, int64_t lag_ns);
+  double percentile (const lagHistogram_t &hist, double p) const;
+
+  void Probe (void);
+  void Report (void);
+  void writeHistogram (const std::string &metric, const lagHistogram_t &hist);
+  void reportLate (const std::string &what, const lagHistogram_t &hist);
+  void WireTx (Time simTime, int64_t wallClockNs);
+
+  Time m_probeInterval;
+  Time m_reportInterval;
+  Time m_lateThreshold;
+  std::string m_outputFile;
+
+  bool m_running;
+  int64_t m_originNs; // wall-clock time (steady_clock, ns) corresponding to the simulation time 0
+  EventId m_probeEvent;
+  EventId m_reportEvent;
+
+  lagHistogram_t m_sched;
+  lagHistogram_t m_wire;
+
+  std::ofstream m_file;
+};
+
+}
+
+#endif // REALTIMELAGMONITOR_H
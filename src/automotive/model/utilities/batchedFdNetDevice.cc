@@ -0,0 +1,474 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#include "batchedFdNetDevice.h"
+
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <net/ethernet.h>
+#include <linux/if_packet.h>
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/mac48-address.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE("BatchedFdNetDevice");
+
+  NS_OBJECT_ENSURE_REGISTERED(BatchedFdNetDevice);
+
+  std::map<int,BatchedFdNetDeviceTxQueue *> BatchedFdNetDeviceTxQueue::m_sharedQueues;
+  uint64_t BatchedFdNetDeviceTxQueue::m_totalBatches = 0;
+
+  BatchedFdNetDeviceFdReader::BatchedFdNetDeviceFdReader(uint32_t buffer_size, uint32_t batch_size, Callback<void, uint8_t *, ssize_t> batch_cb, const uint8_t own_mac[6])
+  {
+    m_bufferSize = buffer_size;
+    m_batchCallback = batch_cb;
+    memcpy (m_ownMac,own_mac,6);
+    m_dropOwnFrames = false;
+
+    m_buffers.assign (batch_size,nullptr);
+    m_msgs.resize (batch_size);
+    m_iovecs.resize (batch_size);
+  }
+
+  BatchedFdNetDeviceFdReader::~BatchedFdNetDeviceFdReader()
+  {
+    for(uint8_t *buf : m_buffers)
+      {
+        free (buf);
+      }
+  }
+
+  FdReader::Data
+  BatchedFdNetDeviceFdReader::DoRead()
+  {
+    size_t batch_size = m_buffers.size ();
+
+    for(size_t i=0;i<batch_size;i++)
+      {
+        if(m_buffers[i] == nullptr)
+          {
+            m_buffers[i] = (uint8_t *) malloc (m_bufferSize);
+            NS_ABORT_MSG_IF (m_buffers[i] == nullptr, "malloc() failed");
+          }
+
+        m_iovecs[i].iov_base = m_buffers[i];
+        m_iovecs[i].iov_len = m_bufferSize;
+        memset (&m_msgs[i],0,sizeof(struct mmsghdr));
+        m_msgs[i].msg_hdr.msg_iov = &m_iovecs[i];
+        m_msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+    // The FdReader thread calls DoRead() only when m_fd is readable: MSG_DONTWAIT just collects what is already queued
+    int received = recvmmsg (m_fd,m_msgs.data (),batch_size,MSG_DONTWAIT,NULL);
+    if(received <= 0)
+      {
+        if(received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+          {
+            NS_LOG_ERROR("recvmmsg() failed: " << strerror (errno));
+          }
+        // A negative length is ignored by the FdReader, while a zero length would stop it
+        return FdReader::Data (nullptr,-1);
+      }
+
+    // The ownership of the received buffers is passed to the device, which frees them after forwarding the frames up;
+    // the discarded frames keep their buffer, which is reused at the next read
+    bool drop_own = m_dropOwnFrames;
+    int last = -1;
+    for(int i=0;i<received;i++)
+      {
+        if(drop_own && m_msgs[i].msg_len >= 12 && memcmp (m_buffers[i]+6,m_ownMac,6) == 0)
+          {
+            continue;
+          }
+
+        if(last >= 0)
+          {
+            m_batchCallback (m_buffers[last],m_msgs[last].msg_len);
+            m_buffers[last] = nullptr;
+          }
+        last = i;
+      }
+
+    if(last < 0)
+      {
+        return FdReader::Data (nullptr,-1);
+      }
+
+    uint8_t *last_buf = m_buffers[last];
+    m_buffers[last] = nullptr;
+
+    return FdReader::Data (last_buf,m_msgs[last].msg_len);
+  }
+
+  BatchedFdNetDeviceTxQueue::BatchedFdNetDeviceTxQueue(int fd, bool owns_fd, int ifindex)
+  {
+    m_fd = fd;
+    m_ownsFd = owns_fd;
+    m_ifindex = ifindex;
+    m_pending = 0;
+  }
+
+  BatchedFdNetDeviceTxQueue::~BatchedFdNetDeviceTxQueue()
+  {
+    // The devices flush the queue before releasing it: no frame is pending here
+    Simulator::Cancel (m_flushEvent);
+
+    if(m_ifindex >= 0)
+      {
+        m_sharedQueues.erase (m_ifindex);
+      }
+
+    if(m_ownsFd)
+      {
+        close (m_fd);
+      }
+  }
+
+  Ptr<BatchedFdNetDeviceTxQueue>
+  BatchedFdNetDeviceTxQueue::GetShared(int ifindex)
+  {
+    auto it = m_sharedQueues.find (ifindex);
+    if(it != m_sharedQueues.end ())
+      {
+        return Ptr<BatchedFdNetDeviceTxQueue> (it->second);
+      }
+
+    // Protocol 0: the socket is only used to send, and the kernel never queues any received frame on it
+    int fd = socket (AF_PACKET,SOCK_RAW,0);
+    if(fd < 0)
+      {
+        NS_LOG_WARN("Cannot create the shared transmission socket: " << strerror (errno) << ". Each device will send on its own socket.");
+        return nullptr;
+      }
+
+    struct sockaddr_ll ll;
+    memset (&ll,0,sizeof(ll));
+    ll.sll_family = AF_PACKET;
+    ll.sll_ifindex = ifindex;
+    ll.sll_protocol = 0;
+    if(bind (fd,(struct sockaddr *) &ll,sizeof(ll)) < 0)
+      {
+        NS_LOG_WARN("Cannot bind the shared transmission socket: " << strerror (errno) << ". Each device will send on its own socket.");
+        close (fd);
+        return nullptr;
+      }
+
+    Ptr<BatchedFdNetDeviceTxQueue> queue = Create<BatchedFdNetDeviceTxQueue> (fd,true,ifindex);
+    m_sharedQueues[ifindex] = PeekPointer (queue);
+
+    return queue;
+  }
+
+  void
+  BatchedFdNetDeviceTxQueue::Enqueue(BatchedFdNetDevice *dev, const uint8_t *buffer, size_t length, uint32_t batch_size, Time flush_delay)
+  {
+    if(m_pending == m_buffers.size ())
+      {
+        m_buffers.emplace_back ();
+        m_simTime.emplace_back ();
+        m_owners.emplace_back ();
+      }
+
+    m_buffers[m_pending].assign (buffer,buffer+length);
+    m_simTime[m_pending] = Simulator::Now ();
+    m_owners[m_pending] = dev;
+    m_pending++;
+
+    if(m_pending >= batch_size)
+      {
+        Simulator::Cancel (m_flushEvent);
+        Flush ();
+      }
+    else if(!m_flushEvent.IsRunning ())
+      {
+        m_flushEvent = Simulator::Schedule (flush_delay,&BatchedFdNetDeviceTxQueue::Flush,this);
+      }
+  }
+
+  void
+  BatchedFdNetDeviceTxQueue::Drop(BatchedFdNetDevice *dev)
+  {
+    uint32_t kept = 0;
+    for(uint32_t i=0;i<m_pending;i++)
+      {
+        if(m_owners[i] == dev)
+          {
+            dev->NotifyFrameSent (m_simTime[i],-1,0);
+            continue;
+          }
+
+        if(kept != i)
+          {
+            std::swap (m_buffers[kept],m_buffers[i]);
+            m_simTime[kept] = m_simTime[i];
+            m_owners[kept] = m_owners[i];
+          }
+        kept++;
+      }
+    m_pending = kept;
+
+    if(m_pending == 0)
+      {
+        Simulator::Cancel (m_flushEvent);
+      }
+  }
+
+  void
+  BatchedFdNetDeviceTxQueue::Flush()
+  {
+    uint32_t pending = m_pending;
+    m_pending = 0;
+
+    if(pending == 0)
+      {
+        return;
+      }
+
+    uint64_t batch = ++m_totalBatches;
+
+    m_msgs.resize (pending);
+    m_iovecs.resize (pending);
+    for(uint32_t i=0;i<pending;i++)
+      {
+        m_iovecs[i].iov_base = m_buffers[i].data ();
+        m_iovecs[i].iov_len = m_buffers[i].size ();
+        memset (&m_msgs[i],0,sizeof(struct mmsghdr));
+        m_msgs[i].msg_hdr.msg_iov = &m_iovecs[i];
+        m_msgs[i].msg_hdr.msg_iovlen = 1;
+      }
+
+    // sendmmsg() may send only part of the batch (e.g., when interrupted): go on from the first frame not sent, and give
+    // up at the first error, as done by FdNetDevice for a failed write()
+    uint32_t sent = 0;
+    while(sent < pending)
+      {
+        int retval = sendmmsg (m_fd,m_msgs.data ()+sent,pending-sent,0);
+        if(retval < 0)
+          {
+            if(errno == EINTR)
+              {
+                continue;
+              }
+
+            NS_LOG_WARN("sendmmsg() failed: " << strerror (errno) << ". Dropping " << pending-sent << " frames.");
+            break;
+          }
+
+        int64_t wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+        for(int i=0;i<retval;i++)
+          {
+            m_owners[sent+i]->NotifyFrameSent (m_simTime[sent+i],wall_ns,batch);
+          }
+        sent += retval;
+      }
+
+    for(uint32_t i=sent;i<pending;i++)
+      {
+        m_owners[i]->NotifyFrameSent (m_simTime[i],-1,batch);
+      }
+
+  }
+
+  TypeId
+  BatchedFdNetDevice::GetTypeId()
+  {
+    static TypeId tid = TypeId("ns3::BatchedFdNetDevice")
+        .SetParent<FdNetDevice> ()
+        .SetGroupName ("automotive")
+        .AddConstructor<BatchedFdNetDevice> ()
+        .AddAttribute ("TxBatchSize",
+            "Maximum number of frames sent with a single sendmmsg() call.",
+            UintegerValue (32),
+            MakeUintegerAccessor (&BatchedFdNetDevice::m_txBatchSize),
+            MakeUintegerChecker<uint32_t> (1,1024))
+        .AddAttribute ("RxBatchSize",
+            "Maximum number of frames received with a single recvmmsg() call.",
+            UintegerValue (32),
+            MakeUintegerAccessor (&BatchedFdNetDevice::m_rxBatchSize),
+            MakeUintegerChecker<uint32_t> (1,1024))
+        .AddAttribute ("TxFlushDelay",
+            "Maximum time a frame waits in the transmission batch. If zero, the batch is sent at the end of the "
+            "current simulation time, i.e., after all the events scheduled at the same time as the first frame.",
+            TimeValue (Seconds (0)),
+            MakeTimeAccessor (&BatchedFdNetDevice::m_txFlushDelay),
+            MakeTimeChecker ())
+        .AddAttribute ("SharedTxSocket",
+            "If true, the frames of all the devices emulated on the same interface are batched together and sent on "
+            "a socket shared by them; if false (or if such socket cannot be created), each device batches only its "
+            "own frames, and sends them on its own socket.",
+            BooleanValue (true),
+            MakeBooleanAccessor (&BatchedFdNetDevice::m_sharedTxSocket),
+            MakeBooleanChecker ())
+        .AddTraceSource ("WireTx",
+            "A frame has been sent on the socket.",
+            MakeTraceSourceAccessor (&BatchedFdNetDevice::m_wireTxTrace),
+            "ns3::BatchedFdNetDevice::WireTxTracedCallback");
+    return tid;
+  }
+
+  BatchedFdNetDevice::BatchedFdNetDevice()
+  {
+    m_txBatchSize = 32;
+    m_rxBatchSize = 32;
+    m_txFlushDelay = Seconds (0);
+    m_sharedTxSocket = true;
+
+    m_batchedReader = nullptr;
+    m_txQueue = nullptr;
+
+    m_txBatches = 0;
+    m_lastTxBatch = 0;
+    m_txFrames = 0;
+    m_txDrops = 0;
+  }
+
+  BatchedFdNetDevice::~BatchedFdNetDevice()
+  {
+  }
+
+  void
+  BatchedFdNetDevice::DoDispose()
+  {
+    ReleaseTxQueue (true);
+
+    m_batchedReader = nullptr;
+    FdNetDevice::DoDispose ();
+  }
+
+  Ptr<FdReader>
+  BatchedFdNetDevice::DoCreateFdReader()
+  {
+    uint8_t own_mac[6];
+    Mac48Address::ConvertFrom (GetAddress ()).CopyTo (own_mac);
+
+    // Same buffer size as the one of the FdNetDeviceFdReader, i.e., MTU + Ethernet/LLC header and trailer
+    m_batchedReader = Create<BatchedFdNetDeviceFdReader> (GetMtu () + 22,m_rxBatchSize,
+                                                          MakeCallback (&BatchedFdNetDevice::ReceiveBatchFrame,this),
+                                                          own_mac);
+    return m_batchedReader;
+  }
+
+  void
+  BatchedFdNetDevice::DoFinishStoppingDevice()
+  {
+    // The device socket is being closed: the frames still in a private batch are dropped, while a shared batch, whose
+    // socket stays open, is sent. The frames written from now on are dropped.
+    ReleaseTxQueue (IsTxSocketShared ());
+    m_batchedReader = nullptr;
+  }
+
+  void
+  BatchedFdNetDevice::ReleaseTxQueue(bool flush)
+  {
+    if(m_txQueue == nullptr)
+      {
+        return;
+      }
+
+    if(flush)
+      {
+        m_txQueue->Flush ();
+      }
+    else
+      {
+        m_txQueue->Drop (this);
+      }
+
+    m_txQueue = nullptr;
+  }
+
+  void
+  BatchedFdNetDevice::FlushTxBatch()
+  {
+    if(m_txQueue != nullptr)
+      {
+        m_txQueue->Flush ();
+      }
+  }
+
+  void
+  BatchedFdNetDevice::ReceiveBatchFrame(uint8_t *buf, ssize_t len)
+  {
+    // Called by the FdReader thread, as the FdReader callback set by FdNetDevice
+    FdNetDevice::ReceiveCallback (buf,len);
+  }
+
+  void
+  BatchedFdNetDevice::NotifyFrameSent(Time simTime, int64_t wall_ns, uint64_t batch)
+  {
+    if(wall_ns < 0)
+      {
+        m_txDrops++;
+        return;
+      }
+
+    // Count each batch containing frames of this device only once
+    if(batch != m_lastTxBatch)
+      {
+        m_lastTxBatch = batch;
+        m_txBatches++;
+      }
+
+    m_txFrames++;
+    m_wireTxTrace (simTime,wall_ns);
+  }
+
+  ssize_t
+  BatchedFdNetDevice::Write(uint8_t *buffer, size_t length)
+  {
+    int fd = m_batchedReader != nullptr ? m_batchedReader->getFd () : -1;
+    if(fd < 0)
+      {
+        NS_LOG_WARN("Device not started or already stopped: dropping the frame.");
+        m_txDrops++;
+        return length;
+      }
+
+    if(m_txQueue == nullptr)
+      {
+        // The interface of the device socket (created by the helper) is known only once the device has been started
+        struct sockaddr_ll ll;
+        socklen_t ll_len = sizeof(ll);
+        if(m_sharedTxSocket && getsockname (fd,(struct sockaddr *) &ll,&ll_len) == 0 && ll.sll_family == AF_PACKET)
+          {
+            m_txQueue = BatchedFdNetDeviceTxQueue::GetShared (ll.sll_ifindex);
+          }
+
+        if(m_txQueue != nullptr)
+          {
+            m_batchedReader->setDropOwnFrames (true);
+          }
+        else
+          {
+            m_txQueue = Create<BatchedFdNetDeviceTxQueue> (fd,false,-1);
+          }
+      }
+
+    // The buffer belongs to the caller (FdNetDevice::SendFrom()): the frame is copied by the queue
+    m_txQueue->Enqueue (this,buffer,length,m_txBatchSize,m_txFlushDelay);
+
+    return length;
+  }
+}
@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+*/
+
+#ifndef BATCHEDFDNETDEVICE_H
+#define BATCHEDFDNETDEVICE_H
+
+#include <stdint.h>
+#include <atomic>
+#include <map>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "ns3/fd-net-device.h"
+#include "ns3/callback.h"
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/traced-callback.h"
+
+namespace ns3
+{
+  /**
+   * \ingroup automotive
+   * \brief FdReader receiving up to "batch_size" frames with a single recvmmsg() call
+   *
+   * The FdReader thread calls DoRead() once every time the file descriptor becomes readable: all the frames returned by
+   * recvmmsg(), but the last one, are passed to the "batch" callback, and the last one is returned to the FdReader,
+   * so that the device receives them in the same order as they were read from the socket.
+   */
+  class BatchedFdNetDeviceFdReader : public FdReader
+  {
+  public:
+    BatchedFdNetDeviceFdReader (uint32_t buffer_size, uint32_t batch_size, Callback<void, uint8_t *, ssize_t> batch_cb, const uint8_t own_mac[6]);
+    ~BatchedFdNetDeviceFdReader ();
+
+    int getFd (void) const {return m_fd;}
+
+    // Discard the frames sent by the device itself, which are looped back once they are sent on a shared socket
+    void setDropOwnFrames (bool drop) {m_dropOwnFrames = drop;}
+
+  private:
+    FdReader::Data DoRead (void);
+
+    uint32_t m_bufferSize;
+    Callback<void, uint8_t *, ssize_t> m_batchCallback;
+    uint8_t m_ownMac[6];
+    std::atomic<bool> m_dropOwnFrames;
+
+    // Receive buffers (malloc()-ed, as expected by FdNetDevice); the ones passed to the device are replaced at the next read
+    std::vector<uint8_t *> m_buffers;
+    std::vector<struct mmsghdr> m_msgs;
+    std::vector<struct iovec> m_iovecs;
+  };
+
+  class BatchedFdNetDevice;
+
+  /**
+   * \ingroup automotive
+   * \brief Transmission batch of one or more BatchedFdNetDevices, sent with sendmmsg() on a single socket
+   *
+   * The shared queue of an interface owns a raw socket bound to it (with protocol 0, so that it never receives any
+   * frame), on which the frames written by all the devices emulated on that interface are sent together. When such
+   * socket cannot be created (e.g., without CAP_NET_RAW, as the device sockets are created by the set-uid helper of
+   * the fd-net-device module), each device falls back to a private queue sending on its own socket.
+   */
+  class BatchedFdNetDeviceTxQueue : public SimpleRefCount<BatchedFdNetDeviceTxQueue>
+  {
+  public:
+    BatchedFdNetDeviceTxQueue (int fd, bool owns_fd, int ifindex);
+    ~BatchedFdNetDeviceTxQueue ();
+
+    // Shared queue of the interface "ifindex", created on first use; nullptr if its socket cannot be created
+    static Ptr<BatchedFdNetDeviceTxQueue> GetShared (int ifindex);
+
+    void Enqueue (BatchedFdNetDevice *dev, const uint8_t *buffer, size_t length, uint32_t batch_size, Time flush_delay);
+    void Flush (void);
+    // Drop the pending frames of "dev" (called when its socket is being closed)
+    void Drop (BatchedFdNetDevice *dev);
+
+    bool IsShared (void) const {return m_ifindex >= 0;}
+
+    // Number of sendmmsg() batches sent by all the queues of the process
+    static uint64_t GetTotalBatches (void) {return m_totalBatches;}
+
+  private:
+    int m_fd;
+    bool m_ownsFd;
+    int m_ifindex; // -1 for a private queue
+
+    // Pending frames: m_buffers is never shrunk, only the first m_pending entries are valid
+    std::vector<std::vector<uint8_t>> m_buffers;
+    std::vector<Time> m_simTime;
+    std::vector<BatchedFdNetDevice *> m_owners;
+    uint32_t m_pending;
+    EventId m_flushEvent;
+
+    std::vector<struct mmsghdr> m_msgs;
+    std::vector<struct iovec> m_iovecs;
+
+    static std::map<int,BatchedFdNetDeviceTxQueue *> m_sharedQueues;
+    static uint64_t m_totalBatches;
+  };
+
+  /**
+   * \ingroup automotive
+   * \brief FdNetDevice which sends and receives the frames in batches, with sendmmsg() and recvmmsg()
+   *
+   * With the plain FdNetDevice, each frame sent by an emulated station costs a write() on its raw socket, and each
+   * received frame costs a select() and a read(). This device instead copies the frames passed to Write() in a
+   * transmission batch, which is sent with a single sendmmsg() at the end of the current simulation time (or after
+   * "TxFlushDelay"), or as soon as it contains "TxBatchSize" frames. With "SharedTxSocket" (default), the batch is
+   * shared by all the devices emulated on the same interface and sent on a socket of its own (see
+   * BatchedFdNetDeviceTxQueue), so that the frames of all the stations sending at the same time cost a single system
+   * call; the frames looped back to the socket of the device which sent them are discarded on reception, as done by
+   * the kernel for the frames sent on the device socket. On the receiving side, up to "RxBatchSize" frames are read
+   * with a single recvmmsg().
+   *
+   * It can be installed instead of the FdNetDevice with EmuFdNetDeviceHelper::SetTypeId ("ns3::BatchedFdNetDevice").
+   * As the actual transmission is deferred, a frame which cannot be sent is not reported by SendFrom(): it is logged and
+   * counted in GetTxDrops().
+   */
+  class BatchedFdNetDevice : public FdNetDevice
+  {
+  public:
+    /**
+     * TracedCallback signature for the frames actually sent on the socket.
+     * \param [in] simTime Simulation time at which the frame was passed to the device
+     * \param [in] wallClockNs std::chrono::steady_clock time (ns) at which sendmmsg() returned
+     */
+    typedef void (* WireTxTracedCallback)(Time simTime, int64_t wallClockNs);
+
+    static TypeId GetTypeId (void);
+
+    BatchedFdNetDevice ();
+    virtual ~BatchedFdNetDevice ();
+
+    virtual ssize_t Write (uint8_t *buffer, size_t length);
+
+    // Send the pending frames now, e.g., before reading the counters at the end of the emulation
+    void FlushTxBatch (void);
+
+    uint64_t GetTxBatches (void) const {return m_txBatches;}
+    uint64_t GetTxFrames (void) const {return m_txFrames;}
+    uint64_t GetTxDrops (void) const {return m_txDrops;}
+    // Whether the frames are sent on the socket shared by the devices of the same interface
+    bool IsTxSocketShared (void) const {return m_txQueue != nullptr && m_txQueue->IsShared ();}
+
+    // Called by the BatchedFdNetDeviceTxQueue for each frame of the device in the batch "batch" (wall_ns < 0: dropped)
+    void NotifyFrameSent (Time simTime, int64_t wall_ns, uint64_t batch);
+
+  protected:
+    virtual void DoDispose (void);
+
+  private:
+    virtual Ptr<FdReader> DoCreateFdReader (void);
+    virtual void DoFinishStoppingDevice (void);
+
+    void ReceiveBatchFrame (uint8_t *buf, ssize_t len);
+    void ReleaseTxQueue (bool flush);
+
+    uint32_t m_txBatchSize;
+    uint32_t m_rxBatchSize;
+    Time m_txFlushDelay;
+    bool m_sharedTxSocket;
+
+    Ptr<BatchedFdNetDeviceFdReader> m_batchedReader;
+    // Set at the first Write() after the device has been started, when the socket of the device is known
+    Ptr<BatchedFdNetDeviceTxQueue> m_txQueue;
+
+    uint64_t m_txBatches; // batches containing at least one frame of this device
+    uint64_t m_lastTxBatch;
+    uint64_t m_txFrames;
+    uint64_t m_txDrops;
+
+    TracedCallback<Time, int64_t> m_wireTxTrace;
+  };
+}
+
+#endif // BATCHEDFDNETDEVICE_H
@@ -204,11 +204,13 @@ namespace ns3 {
               }
           }
 
-        carla::Objects objects = m_opencda_client->getDetectedObjects(m_id);
+        // Objects with geographic coordinates and GT accuracy already included, to avoid two RPCs per object
+        carla::CAVObjects objects = m_opencda_client->getDetectedObjectsGeo(m_id);
         // Once all entries from V2X messages are inserted and matched in OpenCDA's LDM, we sync both LDMs
         for (int i=0;i<objects.objects_size ();i++)
            {
-             carla::Object obj = objects.objects (i);
+             const carla::DetectedObject &detObj = objects.objects (i);
+             const carla::Object &obj = detObj.object ();
              carla_ids.push_back ((uint64_t) obj.id());
              LDM::returnedVehicleData_t retveh = {0};
              LDM::LDM_error_t retval = m_LDM->lookup(obj.id (),retveh);
@@ -244,9 +246,8 @@ namespace ns3 {
 
                   objectData.x = obj.transform ().location ().x ();
                   objectData.y = obj.transform ().location ().y ();
-                  carla::Vector objPos = m_opencda_client->getGeo (obj.transform ().location ().x (), obj.transform ().location ().y ());
-                  objectData.lat = objPos.x ();
-                  objectData.lon = objPos.y ();
+                  objectData.lat = detObj.latitude ();
+                  objectData.lon = detObj.longitude ();
 
                   objectData.xSpeed = OptionalDataItem <long>((long) (obj.speed ().x () - egoVehicle.speed ().x ())*CENTI);
                   objectData.ySpeed = OptionalDataItem <long>((long) (obj.speed ().y () - egoVehicle.speed ().y ())*CENTI);
@@ -275,7 +276,7 @@ namespace ns3 {
                   if(retveh.vehData.associatedCVs.isAvailable ())
                     objectData.associatedCVs = OptionalDataItem<std::vector<long>>(retveh.vehData.associatedCVs.getData ());
 
-                  objectData.GTaccuracy = OptionalDataItem<double> (m_opencda_client->getGTaccuracy(obj.transform ().location ().x (),obj.transform ().location ().y (),obj.length (), obj.width (), obj.yaw (), obj.id ()));
+                  objectData.GTaccuracy = OptionalDataItem<double> (detObj.gtaccuracy ());
 
                   retval = m_LDM->insert(objectData);
 
@@ -0,0 +1,28 @@
+#ifndef RX_ALLOCATION_COUNTER_H
+#define RX_ALLOCATION_COUNTER_H
+
+#include <stdint.h>
+
+namespace ns3 {
+  /**
+   * \brief Simulation-wide counter of the buffers allocated (or grown) on the receive path of the ITS stack.
+   *
+   * GeoNetworking, BTP and the Facilities layer (including the decoded message caches) notify every allocation
+   * they perform while receiving a packet. The receive buffers are reused for all the packets: once they have grown
+   * to the size of the largest received packet, the counter should only increase when a new message is decoded.
+   *
+   * This header has no dependency on the rest of the stack, so that it can be included by any layer.
+   */
+  class RxAllocationCounter
+  {
+    public:
+      static uint64_t Get (void) {return m_allocations;}
+      static void Notify (void) {m_allocations++;}
+      static void Reset (void) {m_allocations = 0;}
+
+    private:
+      static inline uint64_t m_allocations = 0;
+  };
+}
+
+#endif // RX_ALLOCATION_COUNTER_H
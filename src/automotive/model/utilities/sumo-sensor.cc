@@ -51,7 +51,7 @@ namespace ns3 {
   {
     using namespace boost::geometry::strategy::transform;
     libsumo::TraCIPosition egoPosXY=m_client->TraCIAPI::vehicle.getPosition(m_id);
-    libsumo::TraCIPosition egoPos = m_client->TraCIAPI::simulation.convertXYtoLonLat (egoPosXY.x,egoPosXY.y);
+    libsumo::TraCIPosition egoPos = m_client->ConvertXYtoLonLat (egoPosXY.x,egoPosXY.y);
     std::vector<std::string> allIDs;
     std::vector<std::pair<std::string,double>> rangeIDs,sensedIDs;
     // Get all IDs in the simulation
@@ -65,7 +65,7 @@ namespace ns3 {
             //Compute the vehicle distance from the egoVehicle's front bumper
             double f;
             libsumo::TraCIPosition geoPos=m_client->TraCIAPI::vehicle.getPosition(allIDs[i]);
-            geoPos=m_client->TraCIAPI::simulation.convertXYtoLonLat (geoPos.x,geoPos.y);
+            geoPos=m_client->ConvertXYtoLonLat (geoPos.x,geoPos.y);
             f = compute_sensordist (egoPos.y,egoPos.x,geoPos.y,geoPos.x);
             if (f<=m_sensorRange)
               {
@@ -131,7 +131,7 @@ namespace ns3 {
      for (size_t i=0;i<sensedIDs.size();i++)
        {
          LDM::returnedVehicleData_t retveh = {0};
-         LDM::LDM_error_t retval = m_LDM->lookup(std::stol(sensedIDs[i].first.substr (3)),retveh);
+         LDM::LDM_error_t retval = m_LDM->lookup(m_client->GetStationNumericId (sensedIDs[i].first),retveh);
          std::normal_distribution<double> dist_distance(m_mean,m_stddev_distance);
          std::normal_distribution<double> dist_angle(m_mean,m_stddev_angle);
          std::normal_distribution<double> dist_speed(m_mean,m_stddev_speed);
@@ -148,7 +148,7 @@ namespace ns3 {
               else
                 objectData.detected = true;
               objectData.ID = sensedIDs[i].first;
-              objectData.stationID = std::stol(objectData.ID.substr(3));
+              objectData.stationID = m_client->GetStationNumericId (objectData.ID);
 
               //Get position with noise
               libsumo::TraCIPosition objectPosition = m_client->TraCIAPI::vehicle.getPosition(objectData.ID);
@@ -156,10 +156,9 @@ namespace ns3 {
               objectPosition.y += (dist_distance(m_generator)*dist_factor);            
 
 
-              objectData.lon = m_client->TraCIAPI::simulation.convertXYtoLonLat (objectPosition.x
-                                                                                 ,objectPosition.y).x;
-              objectData.lat = m_client->TraCIAPI::simulation.convertXYtoLonLat (objectPosition.x
-                                                                                 ,objectPosition.y).y;
+              libsumo::TraCIPosition objectGeoPosition = m_client->ConvertXYtoLonLat (objectPosition.x,objectPosition.y);
+              objectData.lon = objectGeoPosition.x;
+              objectData.lat = objectGeoPosition.y;
               objectData.elevation = AltitudeValue_unavailable;
               objectData.heading = m_client->vehicle.getAngle (objectData.ID)+(dist_angle(m_generator)*dist_factor);
               objectData.speed_ms = m_client->vehicle.getSpeed (objectData.ID)+(dist_speed(m_generator)*dist_factor);
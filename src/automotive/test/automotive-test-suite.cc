@@ -1,49 +1,1203 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 
 // Include a header file from your module to test.
-#include "ns3/automotive.h"
+#include "ns3/camFastCodec.h"
+#include "ns3/decodedMessageCache.h"
+#include "ns3/rx-allocation-counter.h"
+#include "ns3/btp.h"
+#include "ns3/triggerConditionScheduler.h"
+#include "ns3/LDM.h"
+#include "ns3/cpBasicService.h"
+#include "ns3/geonet.h"
+#include "ns3/network-module.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/packet-socket-helper.h"
+#include "ns3/Seq.hpp"
+#include "ns3/Setter.hpp"
+#include "ns3/Getter.hpp"
+#include "ns3/BitString.hpp"
+#include "ns3/SequenceOf.hpp"
+#include "ns3/Encoding.hpp"
+
+extern "C" {
+  #include "ns3/DENM.h"
+  #include "ns3/CollectivePerceptionMessage.h"
+  #include "ns3/VAM.h"
+}
 
 // An essential include is test.h
 #include "ns3/test.h"
 
+#include <cmath>
+#include <map>
+#include <random>
+#include <set>
+
 // Do not put your test classes in namespace ns3.  You may find it useful
 // to use the using directive to access the ns3 namespace directly
 using namespace ns3;
 
-// This is an example TestCase.
-class AutomotiveTestCase1 : public TestCase
+namespace
+{
+  std::string
+  ToHex (const std::string &buffer)
+  {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex;
+
+    for (unsigned char c : buffer)
+      {
+        hex.push_back (digits[c >> 4]);
+        hex.push_back (digits[c & 0x0F]);
+      }
+
+    return hex;
+  }
+
+  // The reference encodings below were produced by the asn1c UPER encoder of the ASN.1 definitions shipped with the
+  // module (model/ASN1/full-v1-v2): any change in the encoded bytes of these messages breaks the interoperability
+  // with the other ITS stacks
+  const std::string camMinimalHex = "02020012d687a12a005a101cdd0dfb4fb600f00a07083c8c0c00708122b68402c08a501b05e20250c0";
+  const std::string camFullHex =
+    "02020012d687a12a405a101cdd0dfb4fb600f00a07083c8c0c7e708122b68402c08a501b05e20250d01bb8054e113c05"
+    "82103bff0f002f31a600049ff0f802f58d2dfe97804718d2000740";
+  const std::string camExtensionHex =
+    "02020012d687a12a405a101cdd0dfb4fb600f00a07083c8c0c7e708122b68402c08a501b05e20250d01bb8054e113c05"
+    "82103bff0f002f31a6818088b81ff0f802f58d2dfe97804718d2000740";
+  const std::string denmMinimalHex = "02010012d6870000096b43801514345f328f650d17ccae45080e6e86fda7db00780503841e460605";
+  const std::string denmFullHex =
+    "02010012d687ef80096b43801514345f328f650d17ccae42840737437ed3ed803c0281c20f23032400f003182a65e020"
+    "100280000003804adfe65633903011170d513720";
+  const std::string cpmHex =
+    "020e0012d68702868be65722840737437ed3ed803c0281c20f230310018384091050020260c80967fe20328217008040"
+    "00203d02717ffbfd59ffef1c8001dfb0fe70013c114404f444bfcffc3f4a5cca0cc5467e11f98feee00b6400";
+  const std::string vamMinimalHex = "03100074cbb1a12a0006840737437ed3ed803c0281c20f23030001c21302304a8f30";
+  const std::string vamFullHex =
+    "03100074cbb1a12a4806840737437ed3ed803c0281c20f23033889c21302304a8f3477e1feba1180502ffffbfffec672"
+    "060222e180061ffd763380063c0062ffd7b19c0063e004a7fe1d8ce004af0031bfebec670031f801f1ff37633801f3c0"
+    "12aff87b19c012be00ae7fb9d8ce00aef0063bfd7ec670063f80381fe9763380383c01f2ff37b19c01f3e01127f91d8c"
+    "e0112f0095bfc3ec670095f80511fdf763380513c02bafee7b19c02bbe01767f69d8ce0176f00c7bfafec6700c7f806a"
+    "1fd57633806a3c0382fe97b19c0383e01da7f41d8ce01daf00f9bf9bec6700f9f80831fcb763380833c044afe47b19c0"
+    "44be023e7f19d8ce023ef012bbf87ec67012bf809c1fc17633809c3c0512fdf7b19c0513e02a27ef1d8ce02a2f015dbf"
+    "73ec67015df80b51fb7763380b53c05dafda7b19c05dbe03067ec9d8ce0306f018fbf5fec67018ff80ce1fad763380ce"
+    "3c06a2fd57b19c06a3e036a7ea1d8ce036af01c1bf4bec6701c1f80e71fa3763380e73c076afd07b19c076be03ce7e79"
+    "d8ce03cec0";
+
+  // Station registered in a TriggerConditionScheduler, standing still, whose heading can be changed. A check generates
+  // a message when the heading changed by more than 4 degrees or when T_Gen elapsed, as in the CA Basic Service.
+  class SchedulerTestStation
+  {
+  public:
+    SchedulerTestStation (Time first_check, int64_t last_gen_ms)
+      : m_lastGen (last_gen_ms)
+    {
+      m_slot = TriggerConditionScheduler<SchedulerTestStation>::Get ().AddStation (this, first_check);
+    }
+
+    void SetHeading (double heading) {m_heading = heading;}
+    const std::vector<int64_t> &GetChecks (void) const {return m_checks;}
+    uint32_t GetSlot (void) const {return m_slot;}
+
+    void fillConditionSnapshot (TriggerConditionSnapshot_t &snapshot, size_t i)
+    {
+      snapshot.heading[i] = m_heading;
+      snapshot.prevHeading[i] = m_prevHeading;
+      snapshot.headingThreshold[i] = 4.0;
+      snapshot.posDiff[i] = 0.0;
+      snapshot.speed[i] = 0.0;
+      snapshot.prevSpeed[i] = 0.0;
+      snapshot.lastGen[i] = m_lastGen;
+      snapshot.T_Gen[i] = T_GEN_MS;
+      snapshot.checkPeriod[i] = MilliSeconds (T_CHECK_MS).GetNanoSeconds ();
+      snapshot.force[i] = 0;
+    }
+
+    void scheduleConditionCheck (Time delay)
+    {
+      Simulator::Schedule (delay, &SchedulerTestStation::Check, this);
+    }
+
+  private:
+    void Check (void)
+    {
+      int64_t now = Simulator::Now ().GetMilliSeconds ();
+      m_checks.push_back (now);
+
+      if (std::abs (m_heading - m_prevHeading) > 4.0 || now - m_lastGen >= T_GEN_MS)
+        {
+          m_prevHeading = m_heading;
+          m_lastGen = now;
+        }
+
+      TriggerConditionScheduler<SchedulerTestStation>::Get ().SetNextCheck (m_slot, Simulator::Now () + MilliSeconds (T_CHECK_MS));
+    }
+
+    static const int64_t T_GEN_MS = 1000;
+    static const int64_t T_CHECK_MS = 100;
+
+    double m_heading = 0.0;
+    double m_prevHeading = 0.0;
+    int64_t m_lastGen;
+    uint32_t m_slot;
+    std::vector<int64_t> m_checks;
+  };
+
+  // Vehicle Data Provider of a station standing still, with valid values for the mandatory CPM containers
+  class StillVDP : public VDP
+  {
+  public:
+    CAM_mandatory_data_t getCAMMandatoryData () {return CAM_mandatory_data_t ();}
+    CPM_mandatory_data_t getCPMMandatoryData ()
+    {
+      CPM_mandatory_data_t data = {};
+      data.latitude = (long) (LAT * DOT_ONE_MICRO);
+      data.longitude = (long) (LON * DOT_ONE_MICRO);
+      data.altitude = VDPValueConfidence<> (24000, AltitudeConfidence_alt_001_00);
+      data.posConfidenceEllipse = {120, 80, 900};
+      data.heading = VDPValueConfidence<> (900, 10);
+      return data;
+    }
+    double getSpeedValue () {return 0;}
+    double getTravelledDistance () {return 0;}
+    double getHeadingValue () {return 90;}
+    VDP_position_latlon_t getPosition () {return {LAT, LON, DBL_MAX};}
+    VDP_position_cartesian_t getPositionXY () {return {0, 0, DBL_MAX};}
+    VDP_position_cartesian_t getXY (double lon, double lat)
+    {
+      return {(lon - LON) * METERS_PER_DEGREE * std::cos (LAT * M_PI / 180.0), (lat - LAT) * METERS_PER_DEGREE, DBL_MAX};
+    }
+    double getCartesianDist (double lon1, double lat1, double lon2, double lat2) {return haversineDist (lat1, lon1, lat2, lon2);}
+    VDPDataItem<int> getLanePosition () {return VDPDataItem<int> (false);}
+    VDPDataItem<uint8_t> getExteriorLights () {return VDPDataItem<uint8_t> (false);}
+
+    static constexpr double LAT = 45.0625;
+    static constexpr double LON = 7.659;
+    static constexpr double METERS_PER_DEGREE = 111194.93;
+  };
+
+  // Object perceived by the station "perceivedBy", "north_m" meters north of StillVDP, updated now
+  vehicleData_t
+  MakePerceivedObject (uint64_t id, long perceivedBy, double north_m, double speed_ms, double heading)
+  {
+    vehicleData_t data {};
+
+    data.detected = true;
+    data.stationID = id;
+    data.lat = StillVDP::LAT + north_m / StillVDP::METERS_PER_DEGREE;
+    data.lon = StillVDP::LON;
+    data.speed_ms = speed_ms;
+    data.heading = heading;
+    data.timestamp_us = Simulator::Now ().GetMicroSeconds ();
+    data.perceivedBy = OptionalDataItem<long> (perceivedBy);
+    data.vehicleLength = OptionalDataItem<long> (45L);
+    data.vehicleWidth = OptionalDataItem<long> (18L);
+    data.xDistAbs = OptionalDataItem<long> (0L);
+    data.yDistAbs = OptionalDataItem<long> ((long) (north_m * 100));
+    data.xSpeedAbs = OptionalDataItem<long> (0L);
+    data.ySpeedAbs = OptionalDataItem<long> ((long) (speed_ms * 100));
+    data.xAccAbs = OptionalDataItem<long> (0L);
+    data.yAccAbs = OptionalDataItem<long> (0L);
+
+    return data;
+  }
+}
+
+/**
+ * Build a vehicle CAM. With "optional", all the optional fields supported by CAMFastCodec are filled, together with
+ * a low frequency container with a path history.
+ */
+static asn1cpp::Seq<CAM>
+BuildCam (bool optional)
+{
+  auto cam = asn1cpp::makeSeq (CAM);
+
+  asn1cpp::setField (cam->header.messageId, MessageId_cam);
+  asn1cpp::setField (cam->header.protocolVersion, 2);
+  asn1cpp::setField (cam->header.stationId, 1234567);
+  asn1cpp::setField (cam->cam.generationDeltaTime, 41258);
+
+  asn1cpp::setField (cam->cam.camParameters.basicContainer.stationType, StationType_passengerCar);
+  asn1cpp::setField (cam->cam.camParameters.basicContainer.referencePosition.latitude, 450625000);
+  asn1cpp::setField (cam->cam.camParameters.basicContainer.referencePosition.longitude, 76590000);
+  asn1cpp::setField (cam->cam.camParameters.basicContainer.referencePosition.positionConfidenceEllipse.semiMajorAxisLength, 120);
+  asn1cpp::setField (cam->cam.camParameters.basicContainer.referencePosition.positionConfidenceEllipse.semiMinorAxisLength, 80);
+  asn1cpp::setField (cam->cam.camParameters.basicContainer.referencePosition.positionConfidenceEllipse.semiMajorAxisOrientation, 900);
+  asn1cpp::setField (cam->cam.camParameters.basicContainer.referencePosition.altitude.altitudeValue, 24000);
+  asn1cpp::setField (cam->cam.camParameters.basicContainer.referencePosition.altitude.altitudeConfidence, AltitudeConfidence_alt_001_00);
+
+  asn1cpp::setField (cam->cam.camParameters.highFrequencyContainer.present, HighFrequencyContainer_PR_basicVehicleContainerHighFrequency);
+  auto &hf = cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency;
+  asn1cpp::setField (hf.heading.headingValue, 1800);
+  asn1cpp::setField (hf.heading.headingConfidence, 10);
+  asn1cpp::setField (hf.speed.speedValue, 1389);
+  asn1cpp::setField (hf.speed.speedConfidence, 5);
+  asn1cpp::setField (hf.driveDirection, DriveDirection_forward);
+  asn1cpp::setField (hf.vehicleLength.vehicleLengthValue, 45);
+  asn1cpp::setField (hf.vehicleLength.vehicleLengthConfidenceIndication, VehicleLengthConfidenceIndication_noTrailerPresent);
+  asn1cpp::setField (hf.vehicleWidth, 18);
+  asn1cpp::setField (hf.longitudinalAcceleration.value, -12);
+  asn1cpp::setField (hf.longitudinalAcceleration.confidence, 3);
+  asn1cpp::setField (hf.curvature.curvatureValue, -250);
+  asn1cpp::setField (hf.curvature.curvatureConfidence, CurvatureConfidence_unavailable);
+  asn1cpp::setField (hf.curvatureCalculationMode, CurvatureCalculationMode_yawRateUsed);
+  asn1cpp::setField (hf.yawRate.yawRateValue, 150);
+  asn1cpp::setField (hf.yawRate.yawRateConfidence, YawRateConfidence_degSec_001_00);
+
+  if (optional)
+    {
+      asn1cpp::bitstring::setBit (hf.accelerationControl, 0x40, 0);
+      // AccelerationControl is a BIT STRING (SIZE(7)), while setBit() always creates a whole octet
+      hf.accelerationControl->bits_unused = 1;
+      asn1cpp::setField (hf.lanePosition, 2);
+
+      auto swa = asn1cpp::makeSeq (SteeringWheelAngle);
+      asn1cpp::setField (swa->steeringWheelAngleValue, -35);
+      asn1cpp::setField (swa->steeringWheelAngleConfidence, 2);
+      asn1cpp::setField (hf.steeringWheelAngle, std::move (swa));
+
+      auto latacc = asn1cpp::makeSeq (AccelerationComponent);
+      asn1cpp::setField (latacc->value, 7);
+      asn1cpp::setField (latacc->confidence, 4);
+      asn1cpp::setField (hf.lateralAcceleration, std::move (latacc));
+
+      auto vertacc = asn1cpp::makeSeq (AccelerationComponent);
+      asn1cpp::setField (vertacc->value, -2);
+      asn1cpp::setField (vertacc->confidence, 1);
+      asn1cpp::setField (hf.verticalAcceleration, std::move (vertacc));
+
+      asn1cpp::setField (hf.performanceClass, 3);
+
+      auto lowFreqContainer = asn1cpp::makeSeq (LowFrequencyContainer);
+      asn1cpp::setField (lowFreqContainer->present, LowFrequencyContainer_PR_basicVehicleContainerLowFrequency);
+      asn1cpp::setField (lowFreqContainer->choice.basicVehicleContainerLowFrequency.vehicleRole, VehicleRole_default);
+      asn1cpp::bitstring::setBit (lowFreqContainer->choice.basicVehicleContainerLowFrequency.exteriorLights, 0x84, 0);
+
+      for (int i = 0; i < 3; i++)
+        {
+          auto pathPoint = asn1cpp::makeSeq (PathPoint);
+          asn1cpp::setField (pathPoint->pathPosition.deltaLatitude, -120 * (i + 1));
+          asn1cpp::setField (pathPoint->pathPosition.deltaLongitude, 95 * (i + 1));
+          asn1cpp::setField (pathPoint->pathPosition.deltaAltitude, 10 - i);
+          if (i != 1)
+            {
+              asn1cpp::setField (pathPoint->pathDeltaTime, 10 * (i + 1));
+            }
+          asn1cpp::sequenceof::pushList (lowFreqContainer->choice.basicVehicleContainerLowFrequency.pathHistory, std::move (pathPoint));
+        }
+
+      asn1cpp::setField (cam->cam.camParameters.lowFrequencyContainer, std::move (lowFreqContainer));
+    }
+
+  return cam;
+}
+
+/**
+ * Build a DENM. With "optional", the optional fields of the management container and the situation, location and
+ * "a la carte" containers are filled as well.
+ */
+static asn1cpp::Seq<DENM>
+BuildDenm (bool optional)
+{
+  auto denm = asn1cpp::makeSeq (DENM);
+
+  asn1cpp::setField (denm->header.messageId, MessageId_denm);
+  asn1cpp::setField (denm->header.protocolVersion, 2);
+  asn1cpp::setField (denm->header.stationId, 1234567);
+
+  asn1cpp::setField (denm->denm.management.actionID.originatingStationId, 1234567);
+  asn1cpp::setField (denm->denm.management.actionID.sequenceNumber, 42);
+  asn1cpp::setField (denm->denm.management.detectionTime, 694224000123);
+  asn1cpp::setField (denm->denm.management.referenceTime, 694224000456);
+  asn1cpp::setField (denm->denm.management.eventPosition.latitude, 450625000);
+  asn1cpp::setField (denm->denm.management.eventPosition.longitude, 76590000);
+  asn1cpp::setField (denm->denm.management.eventPosition.positionConfidenceEllipse.semiMajorConfidence, 120);
+  asn1cpp::setField (denm->denm.management.eventPosition.positionConfidenceEllipse.semiMinorConfidence, 80);
+  asn1cpp::setField (denm->denm.management.eventPosition.positionConfidenceEllipse.semiMajorOrientation, 900);
+  asn1cpp::setField (denm->denm.management.eventPosition.altitude.altitudeValue, 24000);
+  asn1cpp::setField (denm->denm.management.eventPosition.altitude.altitudeConfidence, AltitudeConfidence_alt_001_00);
+  asn1cpp::setField (denm->denm.management.stationType, StationType_passengerCar);
+
+  if (optional)
+    {
+      asn1cpp::setField (denm->denm.management.termination, Termination_isCancellation);
+      asn1cpp::setField (denm->denm.management.relevanceDistance, RelevanceDistance_lessThan200m);
+      asn1cpp::setField (denm->denm.management.relevanceTrafficDirection, RelevanceTrafficDirection_upstreamTraffic);
+      asn1cpp::setField (denm->denm.management.validityDuration, 120);
+      asn1cpp::setField (denm->denm.management.transmissionInterval, 100);
+
+      auto situation = asn1cpp::makeSeq (SituationContainer);
+      asn1cpp::setField (situation->informationQuality, 3);
+      asn1cpp::setField (situation->eventType.causeCode, CauseCodeType_stationaryVehicle);
+      asn1cpp::setField (situation->eventType.subCauseCode, 2);
+      auto linkedCause = asn1cpp::makeSeq (CauseCode);
+      asn1cpp::setField (linkedCause->causeCode, CauseCodeType_accident);
+      asn1cpp::setField (linkedCause->subCauseCode, 0);
+      asn1cpp::setField (situation->linkedCause, std::move (linkedCause));
+      asn1cpp::setField (denm->denm.situation, std::move (situation));
+
+      auto location = asn1cpp::makeSeq (LocationContainer);
+      auto eventSpeed = asn1cpp::makeSeq (Speed);
+      asn1cpp::setField (eventSpeed->speedValue, 0);
+      asn1cpp::setField (eventSpeed->speedConfidence, 1);
+      asn1cpp::setField (location->eventSpeed, std::move (eventSpeed));
+      auto path = asn1cpp::makeSeq (Path);
+      auto pathPoint = asn1cpp::makeSeq (PathPoint);
+      asn1cpp::setField (pathPoint->pathPosition.deltaLatitude, 300);
+      asn1cpp::setField (pathPoint->pathPosition.deltaLongitude, -410);
+      asn1cpp::setField (pathPoint->pathPosition.deltaAltitude, 0);
+      // value in the extension range of PathDeltaTime (1..65535, ...)
+      asn1cpp::setField (pathPoint->pathDeltaTime, 70000);
+      asn1cpp::sequenceof::pushList (*path, std::move (pathPoint));
+      asn1cpp::sequenceof::pushList (location->traces, std::move (path));
+      asn1cpp::setField (location->roadType, RoadType_nonUrban_WithStructuralSeparationToOppositeLanes);
+      asn1cpp::setField (denm->denm.location, std::move (location));
+
+      auto alacarte = asn1cpp::makeSeq (AlacarteContainer);
+      asn1cpp::setField (alacarte->lanePosition, 1);
+      asn1cpp::setField (alacarte->externalTemperature, -5);
+      asn1cpp::setField (alacarte->positioningSolution, PositioningSolutionType_dGNSS);
+      asn1cpp::setField (denm->denm.alacarte, std::move (alacarte));
+    }
+
+  return denm;
+}
+
+/**
+ * Build a CPM with the originating vehicle container, a sensor information container and two perceived objects
+ * (the second one with all the optional fields filled by the CP Basic Service).
+ */
+static asn1cpp::Seq<CollectivePerceptionMessage>
+BuildCpm (void)
+{
+  auto cpm = asn1cpp::makeSeq (CollectivePerceptionMessage);
+
+  asn1cpp::setField (cpm->header.messageId, MessageId_cpm);
+  asn1cpp::setField (cpm->header.protocolVersion, 2);
+  asn1cpp::setField (cpm->header.stationId, 1234567);
+
+  asn1cpp::setField (cpm->payload.managementContainer.referenceTime, 694224000456);
+  asn1cpp::setField (cpm->payload.managementContainer.referencePosition.latitude, 450625000);
+  asn1cpp::setField (cpm->payload.managementContainer.referencePosition.longitude, 76590000);
+  asn1cpp::setField (cpm->payload.managementContainer.referencePosition.positionConfidenceEllipse.semiMajorConfidence, 120);
+  asn1cpp::setField (cpm->payload.managementContainer.referencePosition.positionConfidenceEllipse.semiMinorConfidence, 80);
+  asn1cpp::setField (cpm->payload.managementContainer.referencePosition.positionConfidenceEllipse.semiMajorOrientation, 900);
+  asn1cpp::setField (cpm->payload.managementContainer.referencePosition.altitude.altitudeValue, 24000);
+  asn1cpp::setField (cpm->payload.managementContainer.referencePosition.altitude.altitudeConfidence, AltitudeConfidence_alt_001_00);
+
+  auto originatingContainer = asn1cpp::makeSeq (WrappedCpmContainer);
+  asn1cpp::setField (originatingContainer->containerId, 1);
+  auto originatingVehicleContainer = asn1cpp::makeSeq (OriginatingVehicleContainer);
+  asn1cpp::setField (originatingVehicleContainer->orientationAngle.value, 1800);
+  asn1cpp::setField (originatingVehicleContainer->orientationAngle.confidence, 10);
+  asn1cpp::setField (originatingContainer->containerData.present, WrappedCpmContainer__containerData_PR_OriginatingVehicleContainer);
+  asn1cpp::setField (originatingContainer->containerData.choice.OriginatingVehicleContainer, std::move (originatingVehicleContainer));
+  asn1cpp::sequenceof::pushList (cpm->payload.cpmContainers, std::move (originatingContainer));
+
+  auto sensorContainer = asn1cpp::makeSeq (WrappedCpmContainer);
+  asn1cpp::setField (sensorContainer->containerId, 3);
+  auto sensorInfoContainer = asn1cpp::makeSeq (SensorInformationContainer);
+  auto sensorInfo = asn1cpp::makeSeq (SensorInformation);
+  asn1cpp::setField (sensorInfo->sensorId, 2);
+  asn1cpp::setField (sensorInfo->sensorType, SensorType_localAggregation);
+  asn1cpp::setField (sensorInfo->shadowingApplies, true);
+  auto detectionArea = asn1cpp::makeSeq (Shape);
+  asn1cpp::setField (detectionArea->present, Shape_PR_circular);
+  auto circularArea = asn1cpp::makeSeq (CircularShape);
+  auto refPos = asn1cpp::makeSeq (CartesianPosition3d);
+  asn1cpp::setField (refPos->xCoordinate, 150);
+  asn1cpp::setField (refPos->yCoordinate, -30);
+  asn1cpp::setField (circularArea->shapeReferencePoint, std::move (refPos));
+  asn1cpp::setField (circularArea->radius, 50);
+  asn1cpp::setField (detectionArea->choice.circular, std::move (circularArea));
+  asn1cpp::setField (sensorInfo->perceptionRegionShape, std::move (detectionArea));
+  asn1cpp::sequenceof::pushList (*sensorInfoContainer, std::move (sensorInfo));
+  asn1cpp::setField (sensorContainer->containerData.present, WrappedCpmContainer__containerData_PR_SensorInformationContainer);
+  asn1cpp::setField (sensorContainer->containerData.choice.SensorInformationContainer, std::move (sensorInfoContainer));
+  asn1cpp::sequenceof::pushList (cpm->payload.cpmContainers, std::move (sensorContainer));
+
+  auto objectsContainer = asn1cpp::makeSeq (WrappedCpmContainer);
+  asn1cpp::setField (objectsContainer->containerId, 5);
+  auto perceivedObjectContainer = asn1cpp::makeSeq (PerceivedObjectContainer);
+  auto perceivedObjects = asn1cpp::makeSeq (PerceivedObjects);
+
+  auto minimalObject = asn1cpp::makeSeq (PerceivedObject);
+  asn1cpp::setField (minimalObject->measurementDeltaTime, 15);
+  asn1cpp::setField (minimalObject->position.xCoordinate.value, 1250);
+  asn1cpp::setField (minimalObject->position.xCoordinate.confidence, CoordinateConfidence_unavailable);
+  asn1cpp::setField (minimalObject->position.yCoordinate.value, -340);
+  asn1cpp::setField (minimalObject->position.yCoordinate.confidence, CoordinateConfidence_unavailable);
+  asn1cpp::sequenceof::pushList (*perceivedObjects, std::move (minimalObject));
+
+  auto fullObject = asn1cpp::makeSeq (PerceivedObject);
+  asn1cpp::setField (fullObject->objectId, 7);
+  asn1cpp::setField (fullObject->measurementDeltaTime, -20);
+  asn1cpp::setField (fullObject->position.xCoordinate.value, -800);
+  asn1cpp::setField (fullObject->position.xCoordinate.confidence, 40);
+  asn1cpp::setField (fullObject->position.yCoordinate.value, 2210);
+  asn1cpp::setField (fullObject->position.yCoordinate.confidence, 40);
+  auto velocity = asn1cpp::makeSeq (Velocity3dWithConfidence);
+  asn1cpp::setField (velocity->present, Velocity3dWithConfidence_PR_cartesianVelocity);
+  asn1cpp::setField (velocity->choice.cartesianVelocity.xVelocity.value, 1100);
+  asn1cpp::setField (velocity->choice.cartesianVelocity.xVelocity.confidence, SpeedConfidence_unavailable);
+  asn1cpp::setField (velocity->choice.cartesianVelocity.yVelocity.value, -15);
+  asn1cpp::setField (velocity->choice.cartesianVelocity.yVelocity.confidence, SpeedConfidence_unavailable);
+  asn1cpp::setField (fullObject->velocity, std::move (velocity));
+  auto acceleration = asn1cpp::makeSeq (Acceleration3dWithConfidence);
+  asn1cpp::setField (acceleration->present, Acceleration3dWithConfidence_PR_cartesianAcceleration);
+  asn1cpp::setField (acceleration->choice.cartesianAcceleration.xAcceleration.value, 5);
+  asn1cpp::setField (acceleration->choice.cartesianAcceleration.xAcceleration.confidence, AccelerationConfidence_unavailable);
+  asn1cpp::setField (acceleration->choice.cartesianAcceleration.yAcceleration.value, 0);
+  asn1cpp::setField (acceleration->choice.cartesianAcceleration.yAcceleration.confidence, AccelerationConfidence_unavailable);
+  asn1cpp::setField (fullObject->acceleration, std::move (acceleration));
+  auto angles = asn1cpp::makeSeq (EulerAnglesWithConfidence);
+  asn1cpp::setField (angles->zAngle.value, 2700);
+  asn1cpp::setField (angles->zAngle.confidence, AngleConfidence_unavailable);
+  asn1cpp::setField (fullObject->angles, std::move (angles));
+  auto dimensionX = asn1cpp::makeSeq (ObjectDimension);
+  asn1cpp::setField (dimensionX->value, 50);
+  asn1cpp::setField (dimensionX->confidence, ObjectDimensionConfidence_unavailable);
+  asn1cpp::setField (fullObject->objectDimensionX, std::move (dimensionX));
+  auto dimensionY = asn1cpp::makeSeq (ObjectDimension);
+  asn1cpp::setField (dimensionY->value, 18);
+  asn1cpp::setField (dimensionY->confidence, ObjectDimensionConfidence_unavailable);
+  asn1cpp::setField (fullObject->objectDimensionY, std::move (dimensionY));
+  asn1cpp::setField (fullObject->objectAge, 1500);
+  auto classification = asn1cpp::makeSeq (ObjectClassDescription);
+  auto objectClass = asn1cpp::makeSeq (ObjectClassWithConfidence);
+  asn1cpp::setField (objectClass->objectClass.present, ObjectClass_PR_vehicleSubClass);
+  asn1cpp::setField (objectClass->objectClass.choice.vehicleSubClass, TrafficParticipantType_passengerCar);
+  asn1cpp::setField (objectClass->confidence, 90);
+  asn1cpp::sequenceof::pushList (*classification, std::move (objectClass));
+  asn1cpp::setField (fullObject->classification, std::move (classification));
+  asn1cpp::sequenceof::pushList (*perceivedObjects, std::move (fullObject));
+
+  asn1cpp::setField (perceivedObjectContainer->numberOfPerceivedObjects, 2);
+  asn1cpp::setField (perceivedObjectContainer->perceivedObjects, std::move (perceivedObjects));
+  asn1cpp::setField (objectsContainer->containerData.present, WrappedCpmContainer__containerData_PR_PerceivedObjectContainer);
+  asn1cpp::setField (objectsContainer->containerData.choice.PerceivedObjectContainer, std::move (perceivedObjectContainer));
+  asn1cpp::sequenceof::pushList (cpm->payload.cpmContainers, std::move (objectsContainer));
+
+  return cpm;
+}
+
+/**
+ * Build a pedestrian VAM. With "optional", the optional fields of the high frequency container, the low frequency
+ * container and a motion prediction container (with a path delta time in the extension range) are filled.
+ */
+static asn1cpp::Seq<VAM>
+BuildVam (bool optional)
+{
+  auto vam = asn1cpp::makeSeq (VAM);
+
+  asn1cpp::setField (vam->header.messageId, MessageId_vam);
+  asn1cpp::setField (vam->header.protocolVersion, 3);
+  asn1cpp::setField (vam->header.stationId, 7654321);
+  asn1cpp::setField (vam->vam.generationDeltaTime, 41258);
+
+  asn1cpp::setField (vam->vam.vamParameters.basicContainer.stationType, StationType_pedestrian);
+  asn1cpp::setField (vam->vam.vamParameters.basicContainer.referencePosition.latitude, 450625000);
+  asn1cpp::setField (vam->vam.vamParameters.basicContainer.referencePosition.longitude, 76590000);
+  asn1cpp::setField (vam->vam.vamParameters.basicContainer.referencePosition.positionConfidenceEllipse.semiMajorAxisLength, 120);
+  asn1cpp::setField (vam->vam.vamParameters.basicContainer.referencePosition.positionConfidenceEllipse.semiMinorAxisLength, 80);
+  asn1cpp::setField (vam->vam.vamParameters.basicContainer.referencePosition.positionConfidenceEllipse.semiMajorAxisOrientation, 900);
+  asn1cpp::setField (vam->vam.vamParameters.basicContainer.referencePosition.altitude.altitudeValue, 24000);
+  asn1cpp::setField (vam->vam.vamParameters.basicContainer.referencePosition.altitude.altitudeConfidence, AltitudeConfidence_alt_001_00);
+
+  auto &hf = vam->vam.vamParameters.vruHighFrequencyContainer;
+  asn1cpp::setField (hf.heading.value, 900);
+  asn1cpp::setField (hf.heading.confidence, 20);
+  asn1cpp::setField (hf.speed.speedValue, 140);
+  asn1cpp::setField (hf.speed.speedConfidence, 10);
+  asn1cpp::setField (hf.longitudinalAcceleration.longitudinalAccelerationValue, 3);
+  asn1cpp::setField (hf.longitudinalAcceleration.longitudinalAccelerationConfidence, AccelerationConfidence_unavailable);
+
+  if (optional)
+    {
+      auto curvature = asn1cpp::makeSeq (Curvature);
+      asn1cpp::setField (curvature->curvatureValue, 120);
+      asn1cpp::setField (curvature->curvatureConfidence, CurvatureConfidence_unavailable);
+      asn1cpp::setField (hf.curvature, std::move (curvature));
+      asn1cpp::setField (hf.curvatureCalculationMode, CurvatureCalculationMode_yawRateUsed);
+      auto yawRate = asn1cpp::makeSeq (YawRate);
+      asn1cpp::setField (yawRate->yawRateValue, -80);
+      asn1cpp::setField (yawRate->yawRateConfidence, YawRateConfidence_unavailable);
+      asn1cpp::setField (hf.yawRate, std::move (yawRate));
+      asn1cpp::setField (hf.environment, VruEnvironment_zebraCrossing);
+      asn1cpp::setField (hf.deviceUsage, VruDeviceUsage_listeningToAudio);
+
+      auto lowFreqContainer = asn1cpp::makeSeq (VruLowFrequencyContainer);
+      asn1cpp::setField (lowFreqContainer->profileAndSubprofile.present, VruProfileAndSubprofile_PR_pedestrian);
+      asn1cpp::setField (lowFreqContainer->profileAndSubprofile.choice.pedestrian, VruSubProfilePedestrian_ordinary_pedestrian);
+      asn1cpp::setField (vam->vam.vamParameters.vruLowFrequencyContainer, std::move (lowFreqContainer));
+
+      auto motionPrediction = asn1cpp::makeSeq (VruMotionPredictionContainer);
+      // PathHistory is a SEQUENCE (SIZE(40)) OF PathPoint in the VAM definitions
+      auto pathHistory = asn1cpp::makeSeq (PathHistory);
+      for (int i = 0; i < 40; i++)
+        {
+          auto pathPoint = asn1cpp::makeSeq (PathPoint);
+          asn1cpp::setField (pathPoint->pathPosition.deltaLatitude, 25 * i);
+          asn1cpp::setField (pathPoint->pathPosition.deltaLongitude, -40 * i);
+          asn1cpp::setField (pathPoint->pathPosition.deltaAltitude, 0);
+          // the first point has a value in the extension range of PathDeltaTime (1..65535, ...)
+          asn1cpp::setField (pathPoint->pathDeltaTime, i == 0 ? 70000 : 100 * i);
+          asn1cpp::sequenceof::pushList (*pathHistory, std::move (pathPoint));
+        }
+      asn1cpp::setField (motionPrediction->pathHistory, std::move (pathHistory));
+      asn1cpp::setField (vam->vam.vamParameters.vruMotionPredictionContainer, std::move (motionPrediction));
+    }
+
+  return vam;
+}
+
+/**
+ * Base class of the codec test cases
+ */
+class AsnCodecTestCase : public TestCase
 {
 public:
-  AutomotiveTestCase1 ();
-  virtual ~AutomotiveTestCase1 ();
+  AsnCodecTestCase (std::string name) : TestCase (name) {}
+
+protected:
+  /**
+   * Check that a message is encoded into the reference bytes, and that decoding and re-encoding it gives back the
+   * same message and the same bytes
+   */
+  template <typename T>
+  void CheckRoundTrip (const asn1cpp::Seq<T> &message, asn_TYPE_descriptor_t *def,
+                       const std::string &referenceHex, const std::string &description)
+  {
+    std::string encoded = asn1cpp::uper::encode (message);
+    NS_TEST_ASSERT_MSG_EQ (encoded.empty (), false, description << ": the asn1c encoder failed");
+    NS_TEST_EXPECT_MSG_EQ (ToHex (encoded), referenceHex, description << ": the encoded bytes changed");
+
+    asn1cpp::Seq<T> decoded = asn1cpp::uper::decode<T> (def, encoded);
+    NS_TEST_ASSERT_MSG_EQ (bool (decoded), true, description << ": the encoded message cannot be decoded");
+    NS_TEST_EXPECT_MSG_EQ ((decoded == message), true, description << ": the decoded message differs from the original one");
+    NS_TEST_EXPECT_MSG_EQ (ToHex (asn1cpp::uper::encode (decoded)), referenceHex, description << ": the re-encoded bytes differ");
+  }
+};
+
+// Round trip and byte equality of the CAMs, with the generic asn1c codec and with CAMFastCodec
+class CamCodecTestCase : public AsnCodecTestCase
+{
+public:
+  CamCodecTestCase ();
+  virtual ~CamCodecTestCase ();
 
 private:
   virtual void DoRun (void);
+  void CheckFastCodec (const asn1cpp::Seq<CAM> &cam, const std::string &description);
 };
 
-// Add some help text to this case to describe what it is intended to test
-AutomotiveTestCase1::AutomotiveTestCase1 ()
-  : TestCase ("Automotive test case (does nothing)")
+CamCodecTestCase::CamCodecTestCase ()
+  : AsnCodecTestCase ("CAM UPER round trip and CAMFastCodec byte equality with asn1c")
 {
 }
 
-// This destructor does nothing but we include it as a reminder that
-// the test case should clean up after itself
-AutomotiveTestCase1::~AutomotiveTestCase1 ()
+CamCodecTestCase::~CamCodecTestCase ()
 {
 }
 
-//
-// This method is the pure virtual method from class TestCase that every
-// TestCase must implement
-//
 void
-AutomotiveTestCase1::DoRun (void)
+CamCodecTestCase::CheckFastCodec (const asn1cpp::Seq<CAM> &cam, const std::string &description)
+{
+  std::string generic = asn1cpp::uper::encode (cam);
+  std::string fast;
+
+  NS_TEST_ASSERT_MSG_EQ (CAMFastCodec::encode (*cam, fast), (ssize_t) generic.size (), description << ": CAMFastCodec rejected a supported CAM");
+  NS_TEST_ASSERT_MSG_EQ (ToHex (fast), ToHex (generic), description << ": CAMFastCodec differs from asn1c");
+
+  CAMFastCodec::LDMFields_t fields;
+  NS_TEST_ASSERT_MSG_EQ (CAMFastCodec::decodeLDMFields ((const uint8_t *) generic.data (), generic.size (), fields), true,
+                         description << ": CAMFastCodec cannot decode the asn1c encoding");
+
+  const auto &hf = cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency;
+  const auto &refPos = cam->cam.camParameters.basicContainer.referencePosition;
+  NS_TEST_EXPECT_MSG_EQ (fields.stationId, cam->header.stationId, description << ": wrong station ID");
+  NS_TEST_EXPECT_MSG_EQ (fields.stationType, cam->cam.camParameters.basicContainer.stationType, description << ": wrong station type");
+  NS_TEST_EXPECT_MSG_EQ (fields.latitude, refPos.latitude, description << ": wrong latitude");
+  NS_TEST_EXPECT_MSG_EQ (fields.longitude, refPos.longitude, description << ": wrong longitude");
+  NS_TEST_EXPECT_MSG_EQ (fields.altitudeValue, refPos.altitude.altitudeValue, description << ": wrong altitude");
+  NS_TEST_EXPECT_MSG_EQ (fields.headingValue, hf.heading.headingValue, description << ": wrong heading");
+  NS_TEST_EXPECT_MSG_EQ (fields.speedValue, hf.speed.speedValue, description << ": wrong speed");
+  NS_TEST_EXPECT_MSG_EQ (fields.generationDeltaTime, cam->cam.generationDeltaTime, description << ": wrong generation delta time");
+  NS_TEST_EXPECT_MSG_EQ (fields.vehicleLengthValue, hf.vehicleLength.vehicleLengthValue, description << ": wrong vehicle length");
+  NS_TEST_EXPECT_MSG_EQ (fields.vehicleWidth, hf.vehicleWidth, description << ": wrong vehicle width");
+  NS_TEST_EXPECT_MSG_EQ (fields.lowFrequencyContainerPresent, cam->cam.camParameters.lowFrequencyContainer != nullptr,
+                         description << ": wrong low frequency container presence");
+  if (fields.lowFrequencyContainerPresent)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((int) fields.exteriorLights,
+                             (int) cam->cam.camParameters.lowFrequencyContainer->choice.basicVehicleContainerLowFrequency.exteriorLights.buf[0],
+                             description << ": wrong exterior lights");
+    }
+}
+
+void
+CamCodecTestCase::DoRun (void)
+{
+  asn1cpp::Seq<CAM> minimal = BuildCam (false);
+  CheckRoundTrip (minimal, &asn_DEF_CAM, camMinimalHex, "Minimal CAM");
+  CheckFastCodec (minimal, "Minimal CAM");
+
+  asn1cpp::Seq<CAM> full = BuildCam (true);
+  CheckRoundTrip (full, &asn_DEF_CAM, camFullHex, "CAM with optional fields");
+  CheckFastCodec (full, "CAM with optional fields");
+
+  // A path delta time in the extension range of PathDeltaTime (1..65535, ...) sets the extension bit of the value:
+  // the CAM is still encoded by asn1c, but it is outside the layout supported by CAMFastCodec, which must reject it
+  // on both the encoding and the decoding side, so that the caller falls back to asn1c
+  asn1cpp::Seq<CAM> extension = BuildCam (true);
+  asn1cpp::setField (extension->cam.camParameters.lowFrequencyContainer->choice.basicVehicleContainerLowFrequency.pathHistory.list.array[0]->pathDeltaTime, 70000);
+  CheckRoundTrip (extension, &asn_DEF_CAM, camExtensionHex, "CAM with an extension value");
+
+  std::string fast;
+  NS_TEST_EXPECT_MSG_EQ (CAMFastCodec::encode (*extension, fast), -1, "CAMFastCodec must not encode an extension value");
+  std::string generic = asn1cpp::uper::encode (extension);
+  CAMFastCodec::LDMFields_t fields;
+  NS_TEST_EXPECT_MSG_EQ (CAMFastCodec::decodeLDMFields ((const uint8_t *) generic.data (), generic.size (), fields), false,
+                         "CAMFastCodec must not decode an extension value");
+
+  // Truncated buffers must be rejected
+  std::string encoded = asn1cpp::uper::encode (full);
+  for (size_t size = 0; size < encoded.size (); size++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (CAMFastCodec::decodeLDMFields ((const uint8_t *) encoded.data (), size, fields), false,
+                             "CAMFastCodec accepted a CAM truncated to " << size << " bytes");
+    }
+
+  // Randomized CAMs, covering all the combinations of the optional fields and the whole range of each field
+  std::mt19937 rng (42);
+  auto random = [&rng] (long min, long max) { return std::uniform_int_distribution<long> (min, max) (rng); };
+
+  for (int i = 0; i < 1000; i++)
+    {
+      asn1cpp::Seq<CAM> cam = BuildCam (random (0, 1));
+      auto &hf = cam->cam.camParameters.highFrequencyContainer.choice.basicVehicleContainerHighFrequency;
+
+      asn1cpp::setField (cam->header.stationId, random (0, 4294967295L));
+      asn1cpp::setField (cam->cam.generationDeltaTime, random (0, 65535));
+      asn1cpp::setField (cam->cam.camParameters.basicContainer.stationType, random (0, 255));
+      asn1cpp::setField (cam->cam.camParameters.basicContainer.referencePosition.latitude, random (-900000000, 900000001));
+      asn1cpp::setField (cam->cam.camParameters.basicContainer.referencePosition.longitude, random (-1800000000, 1800000001));
+      asn1cpp::setField (cam->cam.camParameters.basicContainer.referencePosition.altitude.altitudeValue, random (-100000, 800001));
+      asn1cpp::setField (hf.heading.headingValue, random (0, 3601));
+      asn1cpp::setField (hf.speed.speedValue, random (0, 16383));
+      asn1cpp::setField (hf.vehicleLength.vehicleLengthValue, random (1, 1023));
+      asn1cpp::setField (hf.vehicleWidth, random (1, 62));
+      asn1cpp::setField (hf.curvature.curvatureValue, random (-1023, 1023));
+      asn1cpp::setField (hf.yawRate.yawRateValue, random (-32766, 32767));
+
+      std::ostringstream description;
+      description << "Random CAM " << i;
+      CheckFastCodec (cam, description.str ());
+
+      asn1cpp::Seq<CAM> decoded = asn1cpp::uper::decodeASN (asn1cpp::uper::encode (cam), CAM);
+      NS_TEST_ASSERT_MSG_EQ ((decoded == cam), true, description.str () << ": the decoded CAM differs from the original one");
+    }
+}
+
+// Round trip and byte equality of the DENMs
+class DenmCodecTestCase : public AsnCodecTestCase
+{
+public:
+  DenmCodecTestCase ();
+  virtual ~DenmCodecTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+DenmCodecTestCase::DenmCodecTestCase ()
+  : AsnCodecTestCase ("DENM UPER round trip and byte equality with asn1c")
+{
+}
+
+DenmCodecTestCase::~DenmCodecTestCase ()
+{
+}
+
+void
+DenmCodecTestCase::DoRun (void)
+{
+  CheckRoundTrip (BuildDenm (false), &asn_DEF_DENM, denmMinimalHex, "Minimal DENM");
+
+  // The full DENM also carries a path delta time in the extension range of the constraint
+  asn1cpp::Seq<DENM> full = BuildDenm (true);
+  CheckRoundTrip (full, &asn_DEF_DENM, denmFullHex, "DENM with optional fields and an extension value");
+
+  asn1cpp::Seq<DENM> decoded = asn1cpp::uper::decodeASN (asn1cpp::uper::encode (full), DENM);
+  NS_TEST_ASSERT_MSG_EQ (bool (decoded), true, "The full DENM cannot be decoded");
+  NS_TEST_EXPECT_MSG_EQ (*decoded->denm.location->traces.list.array[0]->list.array[0]->pathDeltaTime, 70000, "Wrong extension value");
+  NS_TEST_EXPECT_MSG_EQ (asn1cpp::getField (decoded->denm.management.actionID.sequenceNumber, long), 42, "Wrong sequence number");
+}
+
+// Round trip and byte equality of the CPMs, with containers wrapped in open types
+class CpmCodecTestCase : public AsnCodecTestCase
+{
+public:
+  CpmCodecTestCase ();
+  virtual ~CpmCodecTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+CpmCodecTestCase::CpmCodecTestCase ()
+  : AsnCodecTestCase ("CPM UPER round trip and byte equality with asn1c")
+{
+}
+
+CpmCodecTestCase::~CpmCodecTestCase ()
+{
+}
+
+void
+CpmCodecTestCase::DoRun (void)
+{
+  asn1cpp::Seq<CollectivePerceptionMessage> cpm = BuildCpm ();
+  CheckRoundTrip (cpm, &asn_DEF_CollectivePerceptionMessage, cpmHex, "CPM");
+
+  asn1cpp::Seq<CollectivePerceptionMessage> decoded = asn1cpp::uper::decodeASN (asn1cpp::uper::encode (cpm), CollectivePerceptionMessage);
+  NS_TEST_ASSERT_MSG_EQ (bool (decoded), true, "The CPM cannot be decoded");
+  NS_TEST_ASSERT_MSG_EQ (decoded->payload.cpmContainers.list.count, 3, "Wrong number of containers");
+
+  const WrappedCpmContainer_t *objectsContainer = decoded->payload.cpmContainers.list.array[2];
+  NS_TEST_ASSERT_MSG_EQ (objectsContainer->containerData.present, WrappedCpmContainer__containerData_PR_PerceivedObjectContainer,
+                         "Wrong type of the perceived object container");
+  const PerceivedObjects_t &objects = objectsContainer->containerData.choice.PerceivedObjectContainer.perceivedObjects;
+  NS_TEST_ASSERT_MSG_EQ (objects.list.count, 2, "Wrong number of perceived objects");
+  NS_TEST_EXPECT_MSG_EQ ((objects.list.array[0]->velocity == nullptr), true, "Unexpected optional field in the minimal object");
+  NS_TEST_ASSERT_MSG_EQ ((objects.list.array[1]->objectId != nullptr), true, "Missing object ID");
+  NS_TEST_EXPECT_MSG_EQ (*objects.list.array[1]->objectId, 7, "Wrong object ID");
+}
+
+// Round trip and byte equality of the VAMs
+class VamCodecTestCase : public AsnCodecTestCase
+{
+public:
+  VamCodecTestCase ();
+  virtual ~VamCodecTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+VamCodecTestCase::VamCodecTestCase ()
+  : AsnCodecTestCase ("VAM UPER round trip and byte equality with asn1c")
+{
+}
+
+VamCodecTestCase::~VamCodecTestCase ()
+{
+}
+
+void
+VamCodecTestCase::DoRun (void)
+{
+  CheckRoundTrip (BuildVam (false), &asn_DEF_VAM, vamMinimalHex, "Minimal VAM");
+  CheckRoundTrip (BuildVam (true), &asn_DEF_VAM, vamFullHex, "VAM with optional fields and an extension value");
+
+  asn1cpp::Seq<VAM> decoded = asn1cpp::uper::decodeASN (asn1cpp::uper::encode (BuildVam (true)), VAM);
+  NS_TEST_ASSERT_MSG_EQ (bool (decoded), true, "The full VAM cannot be decoded");
+  NS_TEST_ASSERT_MSG_EQ ((decoded->vam.vamParameters.vruMotionPredictionContainer != nullptr), true, "Missing motion prediction container");
+  NS_TEST_EXPECT_MSG_EQ (*decoded->vam.vamParameters.vruMotionPredictionContainer->pathHistory->list.array[0]->pathDeltaTime, 70000,
+                         "Wrong extension value");
+}
+
+// Allocations on the receive path: the buffers are reused for every packet, and only new messages are decoded
+class RxAllocationTestCase : public TestCase
+{
+public:
+  RxAllocationTestCase ();
+  virtual ~RxAllocationTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+RxAllocationTestCase::RxAllocationTestCase ()
+  : TestCase ("Receive buffers reuse and decoded message cache allocations")
+{
+}
+
+RxAllocationTestCase::~RxAllocationTestCase ()
+{
+}
+
+void
+RxAllocationTestCase::DoRun (void)
+{
+  std::string fullCam = asn1cpp::uper::encode (BuildCam (true));
+  std::string minimalCam = asn1cpp::uper::encode (BuildCam (false));
+  DecodedMessageCache<CAM> &cache = DecodedMessageCache<CAM>::Get ();
+  cache.SetEnabled (true);
+
+  // Warm up: the lookup key, reused for every message, grows to the size of the largest CAM (Clear() keeps it)
+  cache.Decode ((const uint8_t *) fullCam.data (), fullCam.size (), &asn_DEF_CAM);
+  cache.Clear ();
+  uint64_t hits = cache.GetHits ();
+  uint64_t misses = cache.GetMisses ();
+
+  // The first reception of a message allocates only the decoded message
+  uint64_t allocations = RxAllocationCounter::Get ();
+  DecodedMessageCache<CAM>::DecodedPtr_t first = cache.Decode ((const uint8_t *) fullCam.data (), fullCam.size (), &asn_DEF_CAM);
+  NS_TEST_ASSERT_MSG_EQ ((first != nullptr), true, "The CAM cannot be decoded");
+  NS_TEST_EXPECT_MSG_EQ (RxAllocationCounter::Get () - allocations, 1, "The cache miss was not counted");
+
+  // The other receivers of the same message share the decoded copy, without any allocation
+  allocations = RxAllocationCounter::Get ();
+  for (int i = 0; i < 10; i++)
+    {
+      DecodedMessageCache<CAM>::DecodedPtr_t hit = cache.Decode ((const uint8_t *) fullCam.data (), fullCam.size (), &asn_DEF_CAM);
+      NS_TEST_EXPECT_MSG_EQ ((hit == first), true, "The cached copy of the CAM was not returned");
+    }
+  NS_TEST_EXPECT_MSG_EQ (RxAllocationCounter::Get () - allocations, 0, "A cache hit allocated memory");
+
+  // A smaller message is decoded, reusing the lookup key
+  allocations = RxAllocationCounter::Get ();
+  DecodedMessageCache<CAM>::DecodedPtr_t miss = cache.Decode ((const uint8_t *) minimalCam.data (), minimalCam.size (), &asn_DEF_CAM);
+  NS_TEST_ASSERT_MSG_EQ ((miss != nullptr && miss != first), true, "The second CAM was not decoded");
+  NS_TEST_EXPECT_MSG_EQ (RxAllocationCounter::Get () - allocations, 1, "The cache miss was not counted");
+  NS_TEST_EXPECT_MSG_EQ (cache.GetHits () - hits, 10, "Wrong number of cache hits");
+  NS_TEST_EXPECT_MSG_EQ (cache.GetMisses () - misses, 2, "Wrong number of cache misses");
+  cache.Clear ();
+
+  // Without a view on the GeoNetworking receive buffer, the payload is copied into a buffer which grows only once
+  BTPDataIndication_t dataIndication = {};
+  std::vector<uint8_t> buffer;
+  allocations = RxAllocationCounter::Get ();
+  for (int i = 0; i < 10; i++)
+    {
+      const std::string &content = (i % 2) ? minimalCam : fullCam;
+      dataIndication.data = Create<Packet> ((const uint8_t *) content.data (), content.size ());
+      const uint8_t *payload = btp::getPayloadView (dataIndication, buffer);
+      NS_TEST_EXPECT_MSG_EQ (std::string ((const char *) payload, content.size ()), content, "Wrong payload");
+    }
+  NS_TEST_EXPECT_MSG_EQ (RxAllocationCounter::Get () - allocations, 1, "The payload buffer was not reused");
+
+  // A view, when available, is returned without any copy
+  dataIndication.payload = (const uint8_t *) fullCam.data ();
+  NS_TEST_EXPECT_MSG_EQ ((btp::getPayloadView (dataIndication, buffer) == dataIndication.payload), true, "The view was not used");
+  NS_TEST_EXPECT_MSG_EQ (RxAllocationCounter::Get () - allocations, 1, "A payload view allocated memory");
+}
+
+// Central check of the triggering conditions: only the stations which have to transmit are checked, at their own
+// (desynchronized) check times, and the scheduler does not survive the end of a simulation run
+class TriggerConditionSchedulerTestCase : public TestCase
+{
+public:
+  TriggerConditionSchedulerTestCase ();
+  virtual ~TriggerConditionSchedulerTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TriggerConditionSchedulerTestCase::TriggerConditionSchedulerTestCase ()
+  : TestCase ("Central scheduler of the CAM/VAM triggering condition checks")
+{
+}
+
+TriggerConditionSchedulerTestCase::~TriggerConditionSchedulerTestCase ()
+{
+}
+
+void
+TriggerConditionSchedulerTestCase::DoRun (void)
+{
+  // First run: "a" is only triggered by the elapsed time, "b" turns at 500 ms and is then triggered by the time as well
+  SchedulerTestStation a (MilliSeconds (30), 0);
+  SchedulerTestStation b (MilliSeconds (75), 0);
+  Simulator::Schedule (MilliSeconds (500), &SchedulerTestStation::SetHeading, &b, 30.0);
+  Simulator::Stop (MilliSeconds (2500));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ ((a.GetChecks () == std::vector<int64_t> {1030, 2030}), true, "Wrong checks of the first station");
+  NS_TEST_EXPECT_MSG_EQ ((b.GetChecks () == std::vector<int64_t> {575, 1575}), true, "Wrong checks of the second station");
+
+  // Second run: the scheduler starts again from scratch, and the slots of the first run are no longer valid
+  SchedulerTestStation c (MilliSeconds (50), -1000);
+  NS_TEST_EXPECT_MSG_EQ (c.GetSlot (), 0, "The stations of the previous run are still registered");
+  TriggerConditionScheduler<SchedulerTestStation>::Get ().RemoveStation (a.GetSlot (), &a);
+  Simulator::Stop (MilliSeconds (500));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ ((c.GetChecks () == std::vector<int64_t> {50}), true, "The scheduler did not run after Simulator::Destroy()");
+}
+
+// Index of the objects perceived by each station, kept by the LDM to select the objects to include in its CPMs
+// (ETSI TS 103 324, Section 6.1.2.3)
+class LdmOwnPOsTestCase : public TestCase
+{
+public:
+  LdmOwnPOsTestCase ();
+  virtual ~LdmOwnPOsTestCase ();
+
+private:
+  virtual void DoRun (void);
+  // IDs of the objects perceived by "perceivedBy" to be included in a CPM generated at "now" (ms)
+  std::set<uint64_t> Due (Ptr<LDM> ldm, long perceivedBy, uint64_t now, bool all = false);
+
+  static const uint64_t T_GEN_CPM_MAX_MS = 1000;
+};
+
+LdmOwnPOsTestCase::LdmOwnPOsTestCase ()
+  : TestCase ("LDM index of the objects to include in the CPMs of the perceiving station")
+{
+}
+
+LdmOwnPOsTestCase::~LdmOwnPOsTestCase ()
+{
+}
+
+std::set<uint64_t>
+LdmOwnPOsTestCase::Due (Ptr<LDM> ldm, long perceivedBy, uint64_t now, bool all)
+{
+  std::vector<vehicleData_t *> selected;
+  std::set<uint64_t> ids;
+
+  ldm->getOwnPOsForCPM (perceivedBy, now, T_GEN_CPM_MAX_MS, all, selected);
+  for (vehicleData_t *data : selected)
+    {
+      ids.insert (data->stationID);
+    }
+
+  return ids;
+}
+
+void
+LdmOwnPOsTestCase::DoRun (void)
+{
+  const std::set<uint64_t> none;
+  Ptr<LDM> ldm = CreateObject<LDM> ();
+
+  // 1.a A new object is due, only for the station which perceived it
+  ldm->insert (MakePerceivedObject (1, 10, 0.0, 10.0, 90.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 100) == std::set<uint64_t> {1}), true, "A new object is not due");
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 11, 100) == none), true, "An object perceived by another station is due");
+  ldm->updateCPMincluded (1, 100);
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 200) == none), true, "The object is still due after its inclusion");
+
+  // 1.b Position: more than 4 m from the last inclusion, which is the new reference
+  ldm->insert (MakePerceivedObject (1, 10, 3.0, 10.0, 90.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 200) == none), true, "The object is due after moving by 3 m");
+  ldm->insert (MakePerceivedObject (1, 10, 4.5, 10.0, 90.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 200) == std::set<uint64_t> {1}), true, "The object is not due after moving by 4.5 m");
+  ldm->updateCPMincluded (1, 200);
+  ldm->insert (MakePerceivedObject (1, 10, 7.5, 10.0, 90.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 300) == none), true, "The reference position was not reset by the inclusion");
+
+  // 1.c Speed: more than 0.5 m/s
+  ldm->insert (MakePerceivedObject (1, 10, 7.5, 10.4, 90.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 300) == none), true, "The object is due after a speed change of 0.4 m/s");
+  ldm->insert (MakePerceivedObject (1, 10, 7.5, 10.6, 90.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 300) == std::set<uint64_t> {1}), true, "The object is not due after a speed change of 0.6 m/s");
+  ldm->updateCPMincluded (1, 300);
+  ldm->insert (MakePerceivedObject (1, 10, 7.5, 11.0, 90.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 400) == none), true, "The reference speed was not reset by the inclusion");
+
+  // 1.d Heading: more than 4 degrees, also across north
+  ldm->insert (MakePerceivedObject (1, 10, 7.5, 11.0, 93.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 400) == none), true, "The object is due after turning by 3 degrees");
+  ldm->insert (MakePerceivedObject (1, 10, 7.5, 11.0, 358.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 400) == std::set<uint64_t> {1}), true, "The object is not due after turning by 92 degrees");
+  ldm->updateCPMincluded (1, 400);
+  ldm->insert (MakePerceivedObject (1, 10, 7.5, 11.0, 1.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 500) == none), true, "The object is due after turning by 3 degrees across north");
+
+  // 1.e More than T_GenCpmMax since the last inclusion
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 400 + T_GEN_CPM_MAX_MS) == none), true, "The object is due before T_GenCpmMax");
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 401 + T_GEN_CPM_MAX_MS) == std::set<uint64_t> {1}), true, "The object is not due after T_GenCpmMax");
+
+  // Without redundancy mitigation, all the objects of the station are included
+  ldm->insert (MakePerceivedObject (2, 10, 50.0, 5.0, 0.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 500) == std::set<uint64_t> {2}), true, "Only the new object should be due");
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 500, true) == std::set<uint64_t> {1, 2}), true, "Not all the objects were selected");
+
+  // An object now perceived by another station moves to the index of that station, where it is new
+  ldm->insert (MakePerceivedObject (1, 11, 7.5, 11.0, 1.0));
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 500, true) == std::set<uint64_t> {2}), true, "The object is still indexed for the previous station");
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 11, 500) == std::set<uint64_t> {1}), true, "The object is not due for the new station");
+
+  // The objects removed by the periodic deleteOlderThan() (at 1.5 s for object 2, refreshed last at 0 s) leave the index
+  Simulator::Schedule (MilliSeconds (1200), [ldm] () {ldm->insert (MakePerceivedObject (1, 11, 7.5, 11.0, 1.0));});
+  Simulator::Stop (MilliSeconds (1600));
+  Simulator::Run ();
+
+  LDM::returnedVehicleData_t entry;
+  NS_TEST_EXPECT_MSG_EQ (ldm->lookup (2, entry), LDM::LDM_ITEM_NOT_FOUND, "The old object was not deleted");
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 10, 2000, true) == none), true, "The deleted object is still indexed");
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 11, 2000, true) == std::set<uint64_t> {1}), true, "The refreshed object is no longer indexed");
+  ldm->remove (1);
+  NS_TEST_EXPECT_MSG_EQ ((Due (ldm, 11, 2000, true) == none), true, "The removed object is still indexed");
+
+  // The LDM cancels its events when destroyed
+  ldm = nullptr;
+  Simulator::Destroy ();
+}
+
+// The CPMs generated on consecutive cycles reuse the same PerceivedObject structures (CPBasicService::getPooledPO()),
+// while the number of objects changes at each cycle: every CPM must be decoded with the objects of its own cycle
+class CpmPoolTestCase : public TestCase
+{
+public:
+  CpmPoolTestCase ();
+  virtual ~CpmPoolTestCase ();
+
+private:
+  virtual void DoRun (void);
+  // Insert in the LDM of the sender the objects of the current cycle, removing the other ones
+  void UpdateObjects (void);
+  // Keep the objects in the LDM, which deletes the entries older than 1 s
+  void RefreshObjects (void);
+  void ReceiveCpm (asn1cpp::Seq<CollectivePerceptionMessage> cpm, Address from);
+
+  static const long SENDER_ID = 1;
+  static const uint64_t MAX_OBJECTS = 5;
+
+  Ptr<LDM> m_ldm;
+  int m_cycle = 0;
+  // Object ID -> (x, y) of the position [cm] expected in the CPM of the current cycle
+  std::map<uint64_t,std::pair<long,long>> m_expected;
+};
+
+CpmPoolTestCase::CpmPoolTestCase ()
+  : TestCase ("CPMs generated on consecutive cycles with the pooled perceived objects")
+{
+}
+
+CpmPoolTestCase::~CpmPoolTestCase ()
+{
+}
+
+void
+CpmPoolTestCase::UpdateObjects (void)
+{
+  // 1, 3, 5, 2, 4, 1, ... objects
+  uint64_t count = 1 + (2 * m_cycle) % MAX_OBJECTS;
+
+  m_expected.clear ();
+  for (uint64_t id = 1; id <= MAX_OBJECTS; id++)
+    {
+      if (id > count)
+        {
+          m_ldm->remove (id);
+          continue;
+        }
+
+      double north_m = 10.0 * m_cycle + id;
+      vehicleData_t data = MakePerceivedObject (id, SENDER_ID, north_m, 10.0, 0.0);
+      data.xDistAbs = OptionalDataItem<long> ((long) (100 * id));
+      m_ldm->insert (data);
+      m_expected[id] = std::make_pair (data.xDistAbs.getData (), data.yDistAbs.getData ());
+    }
+}
+
+void
+CpmPoolTestCase::RefreshObjects (void)
+{
+  for (const auto &object : m_expected)
+    {
+      LDM::returnedVehicleData_t entry;
+      if (m_ldm->lookup (object.first, entry) == LDM::LDM_OK)
+        {
+          entry.vehData.timestamp_us = Simulator::Now ().GetMicroSeconds ();
+          m_ldm->insert (entry.vehData);
+        }
+    }
+
+  Simulator::Schedule (MilliSeconds (250), &CpmPoolTestCase::RefreshObjects, this);
+}
+
+void
+CpmPoolTestCase::ReceiveCpm (asn1cpp::Seq<CollectivePerceptionMessage> cpm, Address from)
 {
-  // A wide variety of test macros are available in src/core/test.h
-  NS_TEST_ASSERT_MSG_EQ (true, true, "true doesn't equal true for some reason");
-  // Use this one for floating point comparisons
-  NS_TEST_ASSERT_MSG_EQ_TOL (0.01, 0.01, 0.001, "Numbers are not equal within tolerance");
+  std::map<uint64_t,std::pair<long,long>> objects;
+
+  for (int i = 0; i < cpm->payload.cpmContainers.list.count; i++)
+    {
+      const WrappedCpmContainer_t *container = cpm->payload.cpmContainers.list.array[i];
+      if (container->containerData.present != WrappedCpmContainer__containerData_PR_PerceivedObjectContainer)
+        {
+          continue;
+        }
+
+      const PerceivedObjectContainer_t &poContainer = container->containerData.choice.PerceivedObjectContainer;
+      NS_TEST_EXPECT_MSG_EQ (poContainer.numberOfPerceivedObjects, poContainer.perceivedObjects.list.count,
+                             "Wrong number of perceived objects in cycle " << m_cycle);
+      for (int j = 0; j < poContainer.perceivedObjects.list.count; j++)
+        {
+          const PerceivedObject_t *po = poContainer.perceivedObjects.list.array[j];
+          NS_TEST_ASSERT_MSG_EQ ((po->objectId != nullptr), true, "Missing object ID in cycle " << m_cycle);
+          objects[*po->objectId] = std::make_pair (po->position.xCoordinate.value, po->position.yCoordinate.value);
+        }
+    }
+
+  NS_TEST_EXPECT_MSG_EQ ((objects == m_expected), true, "The CPM of cycle " << m_cycle << " does not carry the objects of its cycle");
+
+  // The objects of the next cycle
+  m_cycle++;
+  UpdateObjects ();
+}
+
+void
+CpmPoolTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  SimpleNetDeviceHelper simple;
+  simple.Install (nodes);
+  PacketSocketHelper packetSocket;
+  packetSocket.Install (nodes);
+
+  StillVDP vdp;
+  std::vector<Ptr<btp>> btps;
+  std::vector<Ptr<CPBasicService>> services;
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<btp> btpObject = CreateObject<btp> ();
+      btpObject->setGeoNet (CreateObject<GeoNet> ());
+      Ptr<Socket> socket = GeoNet::createGNPacketSocket (nodes.Get (i));
+
+      Ptr<CPBasicService> cpService = CreateObject<CPBasicService> ();
+      cpService->setBTP (btpObject);
+      cpService->setSocketTx (socket);
+      cpService->setSocketRx (socket);
+      cpService->setStationProperties (SENDER_ID + i, StationType_passengerCar);
+      btpObject->setVDP (&vdp);
+      cpService->setVDP (&vdp);
+
+      btps.push_back (btpObject);
+      services.push_back (cpService);
+    }
+
+  // The sender includes all its objects in every CPM
+  m_ldm = CreateObject<LDM> ();
+  m_cycle = 0;
+  UpdateObjects ();
+  RefreshObjects ();
+  services[0]->setLDM (m_ldm);
+  services[0]->setRedundancyMitigation (false);
+  services[0]->startCpmDissemination ();
+  services[1]->addCPRxCallback (std::bind (&CpmPoolTestCase::ReceiveCpm, this, std::placeholders::_1, std::placeholders::_2));
+
+  // The first CPM is generated within 2 s, then one every 100 ms
+  Simulator::Stop (Seconds (4));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_GT (m_cycle, 10, "Too few CPMs were received");
+  NS_TEST_EXPECT_MSG_EQ (services[0]->terminateDissemination (), (uint64_t) m_cycle, "Some CPMs were not received");
+
+  for (Ptr<btp> btpObject : btps)
+    {
+      btpObject->cleanup ();
+    }
+  m_ldm = nullptr;
+  Simulator::Destroy ();
 }
 
 // The TestSuite class names the TestSuite, identifies what type of TestSuite,
@@ -60,9 +1214,15 @@ AutomotiveTestSuite::AutomotiveTestSuite ()
   : TestSuite ("automotive", UNIT)
 {
   // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
-  AddTestCase (new AutomotiveTestCase1, TestCase::QUICK);
+  AddTestCase (new CamCodecTestCase, TestCase::QUICK);
+  AddTestCase (new DenmCodecTestCase, TestCase::QUICK);
+  AddTestCase (new CpmCodecTestCase, TestCase::QUICK);
+  AddTestCase (new VamCodecTestCase, TestCase::QUICK);
+  AddTestCase (new RxAllocationTestCase, TestCase::QUICK);
+  AddTestCase (new TriggerConditionSchedulerTestCase, TestCase::QUICK);
+  AddTestCase (new LdmOwnPOsTestCase, TestCase::QUICK);
+  AddTestCase (new CpmPoolTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
 static AutomotiveTestSuite automotiveTestSuite;
-
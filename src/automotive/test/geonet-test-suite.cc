@@ -0,0 +1,264 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/geonet.h"
+#include "ns3/gn-timer-queue.h"
+#include "ns3/vdp.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/packet-socket-helper.h"
+
+#include "ns3/test.h"
+
+#include <cmath>
+
+using namespace ns3;
+
+namespace
+{
+  // Vehicle Data Provider of a station standing still at a fixed position, with an equirectangular projection
+  class FixedPositionVDP : public VDP
+  {
+  public:
+    FixedPositionVDP (double lat, double lon) : m_lat (lat), m_lon (lon) {}
+
+    CAM_mandatory_data_t getCAMMandatoryData () {return CAM_mandatory_data_t ();}
+    CPM_mandatory_data_t getCPMMandatoryData () {return CPM_mandatory_data_t ();}
+    double getSpeedValue () {return 0;}
+    double getTravelledDistance () {return 0;}
+    double getHeadingValue () {return 0;}
+    VDP_position_latlon_t getPosition () {return {m_lat, m_lon, DBL_MAX};}
+    VDP_position_cartesian_t getPositionXY () {return getXY (m_lon, m_lat);}
+    VDP_position_cartesian_t getXY (double lon, double lat)
+    {
+      return {lon * M_PI / 180.0 * EARTH_RADIUS * std::cos (45.0 * M_PI / 180.0), lat * M_PI / 180.0 * EARTH_RADIUS, DBL_MAX};
+    }
+    double getCartesianDist (double lon1, double lat1, double lon2, double lat2)
+    {
+      VDP_position_cartesian_t a = getXY (lon1, lat1), b = getXY (lon2, lat2);
+      return std::sqrt ((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+    }
+    VDPDataItem<int> getLanePosition () {return VDPDataItem<int> (false);}
+    VDPDataItem<uint8_t> getExteriorLights () {return VDPDataItem<uint8_t> (false);}
+
+  private:
+    static constexpr double EARTH_RADIUS = 6371000.0;
+    double m_lat;
+    double m_lon;
+  };
+}
+
+// A GBC which cannot be forwarded any further (RHL=1 at the source, or after the decrement at a forwarder), sent from
+// outside the destination area, is broadcast (not greedy-unicast) to all the routers in the area
+class GbcSingleHopTestCase : public TestCase
+{
+public:
+  GbcSingleHopTestCase ();
+  virtual ~GbcSingleHopTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void SendGbc (Ptr<GeoNet> source, uint8_t maxHL);
+  // Send a GBC with hop limit "maxHL" from the first station, with the links between the "blocked" pairs of stations
+  // disabled; "received" is the number of GBCs passed to the upper layer by each station
+  void RunScenario (std::vector<FixedPositionVDP> vdps, uint8_t maxHL, const std::vector<std::pair<uint32_t,uint32_t>> &blocked,
+                    std::vector<int> &received, std::vector<GeoNet::GNForwardingStats_t> &stats);
+
+  static constexpr double AREA_LAT = 45.0;
+  static constexpr double AREA_LON = 7.0;
+};
+
+GbcSingleHopTestCase::GbcSingleHopTestCase ()
+  : TestCase ("GBC which cannot be forwarded further, sent from outside the area, reaches all the routers inside the area")
+{
+}
+
+GbcSingleHopTestCase::~GbcSingleHopTestCase ()
+{
+}
+
+void
+GbcSingleHopTestCase::SendGbc (Ptr<GeoNet> source, uint8_t maxHL)
+{
+  GNDataRequest_t dataRequest = {};
+  dataRequest.upperProtocol = BTP_B;
+  dataRequest.GNType = GBC;
+  dataRequest.GnAddress.posLat = (int32_t) (AREA_LAT * DOT_ONE_MICRO);
+  dataRequest.GnAddress.posLong = (int32_t) (AREA_LON * DOT_ONE_MICRO);
+  dataRequest.GnAddress.distA = 100;
+  dataRequest.GnAddress.shape = 0;
+  dataRequest.GNCommProfile = UNSPECIFIED;
+  dataRequest.GNMaxLife = 1;
+  dataRequest.GNMaxHL = maxHL;
+  dataRequest.GNTraClass = 0x02; // No store-carry-forward
+  dataRequest.data = Create<Packet> (20);
+  dataRequest.lenght = dataRequest.data->GetSize ();
+
+  NS_TEST_EXPECT_MSG_EQ (source->sendGN (dataRequest), ACCEPTED, "The GBC was not sent");
+}
+
+void
+GbcSingleHopTestCase::RunScenario (std::vector<FixedPositionVDP> vdps, uint8_t maxHL, const std::vector<std::pair<uint32_t,uint32_t>> &blocked,
+                                   std::vector<int> &received, std::vector<GeoNet::GNForwardingStats_t> &stats)
+{
+  NodeContainer nodes;
+  nodes.Create (vdps.size ());
+  SimpleNetDeviceHelper simple;
+  NetDeviceContainer devices = simple.Install (nodes);
+  PacketSocketHelper packetSocket;
+  packetSocket.Install (nodes);
+
+  Ptr<SimpleChannel> channel = DynamicCast<SimpleChannel> (devices.Get (0)->GetChannel ());
+  for (const std::pair<uint32_t,uint32_t> &link : blocked)
+    {
+      Ptr<SimpleNetDevice> a = DynamicCast<SimpleNetDevice> (devices.Get (link.first));
+      Ptr<SimpleNetDevice> b = DynamicCast<SimpleNetDevice> (devices.Get (link.second));
+      channel->BlackList (a, b);
+      channel->BlackList (b, a);
+    }
+
+  std::vector<Ptr<GeoNet>> routers;
+  received.assign (nodes.GetN (), 0);
+  for (uint32_t i = 0; i < nodes.GetN (); i++)
+    {
+      Ptr<GeoNet> geoNet = CreateObject<GeoNet> ();
+      Ptr<Socket> socket = GeoNet::createGNPacketSocket (nodes.Get (i));
+      geoNet->setSocketTx (socket);
+      geoNet->setStationProperties (i + 1, StationType_passengerCar);
+      geoNet->setVDP (&vdps[i]);
+      socket->SetRecvCallback (MakeCallback (&GeoNet::receiveGN, geoNet));
+      geoNet->addRxCallback ([&received, i] (GNDataIndication_t dataIndication, Address from) {
+        if (dataIndication.GNType == GBC)
+          {
+            received[i]++;
+          }
+      });
+      routers.push_back (geoNet);
+    }
+
+  // Send the GBC once the beacons have filled the location tables
+  Simulator::Schedule (MilliSeconds (500), &GbcSingleHopTestCase::SendGbc, this, routers[0], maxHL);
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+
+  stats.clear ();
+  for (Ptr<GeoNet> geoNet : routers)
+    {
+      stats.push_back (geoNet->getForwardingStats ());
+      geoNet->cleanup ();
+    }
+  Simulator::Destroy ();
+}
+
+void
+GbcSingleHopTestCase::DoRun (void)
+{
+  std::vector<int> received;
+  std::vector<GeoNet::GNForwardingStats_t> stats;
+
+  // Single hop: the source is ~220 m north of a circular area of 100 m radius, and the two receivers are inside it:
+  // all the stations are neighbours, so greedy forwarding would select only the receiver closest to the center
+  RunScenario ({FixedPositionVDP (AREA_LAT + 0.002, AREA_LON),
+                FixedPositionVDP (AREA_LAT, AREA_LON),
+                FixedPositionVDP (AREA_LAT + 0.0003, AREA_LON)},
+               1, {}, received, stats);
+
+  NS_TEST_EXPECT_MSG_EQ (received[0], 0, "The source received its own GBC");
+  NS_TEST_EXPECT_MSG_EQ (received[1], 1, "The GBC did not reach the router at the center of the area");
+  NS_TEST_EXPECT_MSG_EQ (received[2], 1, "The GBC did not reach the other router inside the area");
+  NS_TEST_EXPECT_MSG_EQ (stats[0].greedyUnicast, 0, "The GBC was sent to a greedy next hop");
+
+  // Two hops: the source (~440 m north of the area) only reaches a forwarder outside the area (~220 m north), which
+  // reaches the two receivers inside it. With RHL=2, the source greedy-unicasts the GBC to the forwarder, which, with
+  // RHL=1 after the decrement, must broadcast it instead of sending it to the receiver closest to the center only
+  RunScenario ({FixedPositionVDP (AREA_LAT + 0.004, AREA_LON),
+                FixedPositionVDP (AREA_LAT + 0.002, AREA_LON),
+                FixedPositionVDP (AREA_LAT, AREA_LON),
+                FixedPositionVDP (AREA_LAT + 0.0003, AREA_LON)},
+               2, {{0, 2}, {0, 3}}, received, stats);
+
+  NS_TEST_EXPECT_MSG_EQ (received[0], 0, "The source received its own GBC");
+  NS_TEST_EXPECT_MSG_EQ (received[1], 0, "The forwarder outside the area passed the GBC to the upper layer");
+  NS_TEST_EXPECT_MSG_EQ (received[2], 1, "The GBC did not reach the router at the center of the area");
+  NS_TEST_EXPECT_MSG_EQ (received[3], 1, "The GBC did not reach the other router inside the area");
+  NS_TEST_EXPECT_MSG_EQ (stats[0].greedyUnicast, 1, "The source did not send the GBC to the forwarder");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].gbcForwarded, 1, "The forwarder did not forward the GBC");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].greedyUnicast, 0, "The forwarder sent the GBC with RHL=1 to a greedy next hop");
+}
+
+// A timer which is restarted many times (as the DENM T_R_Validity timer) expires only once, at its last deadline,
+// without making the heap grow, and a cancelled timer never expires
+class TimerQueueRestartTestCase : public TestCase
+{
+public:
+  TimerQueueRestartTestCase ();
+  virtual ~TimerQueueRestartTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TimerQueueRestartTestCase::TimerQueueRestartTestCase ()
+  : TestCase ("Restarted and cancelled timers of the GNTimerQueue")
+{
+}
+
+TimerQueueRestartTestCase::~TimerQueueRestartTestCase ()
+{
+}
+
+void
+TimerQueueRestartTestCase::DoRun (void)
+{
+  GNTimerQueue queue;
+  std::vector<std::pair<uint64_t,Time>> expired;
+  queue.setExpireCallback ([&expired] (uint64_t handle, Time deadline) {
+    expired.push_back (std::make_pair (handle, deadline));
+  });
+
+  // Timer 1 is restarted every 10 ms with a validity of 600 s, timer 2 is cancelled, timer 3 expires normally
+  const int restarts = 1000;
+  for (int i = 0; i < restarts; i++)
+    {
+      Simulator::Schedule (MilliSeconds (10 * i), [&queue] () {queue.schedule (1, Simulator::Now () + Seconds (600));});
+    }
+  Simulator::Schedule (MilliSeconds (5), [&queue] () {queue.schedule (2, Seconds (1));});
+  Simulator::Schedule (MilliSeconds (500), [&queue] () {queue.cancel (2);});
+  Simulator::Schedule (MilliSeconds (5), [&queue] () {queue.schedule (3, Seconds (2));});
+
+  size_t heapSize = 0;
+  bool running = false;
+  Simulator::Schedule (MilliSeconds (10 * restarts), [&queue, &heapSize, &running] () {
+    heapSize = queue.getHeapSize ();
+    running = queue.isRunning (1) && !queue.isRunning (2) && !queue.isRunning (3);
+  });
+  Simulator::Stop (Seconds (700));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (running, true, "Wrong state of the timers");
+  NS_TEST_EXPECT_MSG_LT (heapSize, 100, "The stale items of the restarted timer were not purged");
+  NS_TEST_ASSERT_MSG_EQ (expired.size (), 2, "Wrong number of expired timers");
+  NS_TEST_EXPECT_MSG_EQ (expired[0].first, 3, "Timer 3 did not expire first");
+  NS_TEST_EXPECT_MSG_EQ (expired[0].second, Seconds (2), "Wrong deadline of timer 3");
+  NS_TEST_EXPECT_MSG_EQ (expired[1].first, 1, "The restarted timer did not expire");
+  NS_TEST_EXPECT_MSG_EQ (expired[1].second, MilliSeconds (10 * (restarts - 1)) + Seconds (600), "The restarted timer did not expire at its last deadline");
+  NS_TEST_EXPECT_MSG_EQ (queue.getSize (), 0, "Some timers are still running");
+}
+
+class GeoNetTestSuite : public TestSuite
+{
+public:
+  GeoNetTestSuite ();
+};
+
+GeoNetTestSuite::GeoNetTestSuite ()
+  : TestSuite ("automotive-geonet", UNIT)
+{
+  AddTestCase (new GbcSingleHopTestCase, TestCase::QUICK);
+  AddTestCase (new TimerQueueRestartTestCase, TestCase::QUICK);
+}
+
+static GeoNetTestSuite geoNetTestSuite;
@@ -0,0 +1,63 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+// MPI smoke test of the v2v-tiled-sweep-cam-exchange-80211p example: two tiles are launched with mpiexec, and the
+// test checks that both the runs terminate and that rank 0 prints the combined metrics.
+// The example (and thus this test) requires SUMO to be installed.
+
+#include "ns3/example-as-test.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+using namespace ns3;
+
+class TiledSweepMpiTestCase : public ExampleAsTestCase
+{
+public:
+  TiledSweepMpiTestCase (const std::string name, const std::string program, const std::string dataDir,
+                         const int ranks, const std::string args = "");
+
+  std::string GetCommandTemplate (void) const override;
+  std::string GetPostProcessingCommand (void) const override;
+
+private:
+  int m_ranks;
+};
+
+TiledSweepMpiTestCase::TiledSweepMpiTestCase (const std::string name, const std::string program,
+                                              const std::string dataDir, const int ranks, const std::string args)
+  : ExampleAsTestCase (name, program, dataDir, args),
+    m_ranks (ranks)
+{
+}
+
+std::string
+TiledSweepMpiTestCase::GetCommandTemplate (void) const
+{
+  std::stringstream ss;
+  ss << "mpiexec -n " << m_ranks << " %s " << m_args;
+  return ss.str ();
+}
+
+std::string
+TiledSweepMpiTestCase::GetPostProcessingCommand (void) const
+{
+  // the per-tile counters depend on the SUMO version: keep only the termination of each rank, in a stable order
+  return "| sed -n -e 's/^\\(Tile [0-9]*\\) terminated.*/\\1 terminated/p' -e '/^Run terminated/p' | sort";
+}
+
+class TiledSweepMpiTestSuite : public TestSuite
+{
+public:
+  TiledSweepMpiTestSuite ();
+};
+
+TiledSweepMpiTestSuite::TiledSweepMpiTestSuite ()
+  : TestSuite ("v2v-tiled-sweep-mpi", EXAMPLE)
+{
+  AddTestCase (new TiledSweepMpiTestCase ("v2v-tiled-sweep-mpi-2", "v2v-tiled-sweep-cam-exchange-80211p",
+                                          NS_TEST_SOURCEDIR, 2, "--tiles-x=2 --tiles-y=1 --sim-time=5"),
+               TestCase::EXTENSIVE);
+}
+
+static TiledSweepMpiTestSuite tiledSweepMpiTestSuite;
@@ -20,6 +20,7 @@
 #include <fcntl.h>
 #include <libssh/libssh.h>
 #include <cstdlib>
+#include <chrono>
 
 #include "../proto/carla.pb.h"
 #include "../proto/carla.pb.h"
@@ -140,7 +141,22 @@ namespace ns3
                     "OpenCDA GPU",
                     UintegerValue(0),
                     MakeUintegerAccessor(&OpenCDAClient::m_openCDA_gpu),
-                    MakeUintegerChecker<uint32_t>());
+                    MakeUintegerChecker<uint32_t>())
+      .AddAttribute("BatchedTimeStep",
+                    "Retrieve the state of all the actors and the objects detected by the CAVs with a single ExecuteOneTimeStepBatch RPC per step. "
+                    "It is automatically disabled if the OpenCDA Control Interface does not implement it.",
+                    BooleanValue(true),
+                    MakeBooleanAccessor(&OpenCDAClient::m_batched_step),
+                    MakeBooleanChecker())
+      .AddAttribute("AsyncTimeStep",
+                    "Request the next CARLA/OpenCDA step asynchronously, as soon as the current one has been applied, so that "
+                    "the ns-3 events until the next synchronization point are executed while CARLA computes it. "
+                    "The controls (SetControl) and the objects inserted into the OpenCDA LDMs (InsertObject, InsertObjects, InsertCV) in the meantime "
+                    "are applied to the step following the one being computed, and the queries are answered from the result of the last step. "
+                    "It requires the batched time step: if BatchedTimeStep is false, or ExecuteOneTimeStepBatch is not implemented, it is disabled with a warning.",
+                    BooleanValue(false),
+                    MakeBooleanAccessor(&OpenCDAClient::m_async_step),
+                    MakeBooleanChecker());
 
   ;
     return tid;
@@ -160,6 +176,10 @@ namespace ns3
       m_openCDA_gpu = 0;
       m_opencda_manual = false;
       m_carla_manual = false;
+      m_carla_pid = 0;
+      m_opencda_pid = 0;
+      m_batched_step = true;
+      m_async_step = false;
       m_randVar = CreateObject<UniformRandomVariable>();
       m_randVar->SetAttribute("Min", DoubleValue(0.0));
       m_randVar->SetAttribute("Max", DoubleValue(1.0));
@@ -167,6 +187,15 @@ namespace ns3
 
   OpenCDAClient::~OpenCDAClient(void)
   {
+      if (m_step_in_flight && !m_step_joined) {
+          m_pending_ctx->TryCancel();
+          waitPendingStep();
+      }
+      m_cq.Shutdown();
+      void *tag;
+      bool ok;
+      while (m_cq.Next(&tag, &ok));
+
       this->stopSimulation ();
       std::cout<<"OpenCDAClient object destroyed." << std::endl;
       NS_LOG_INFO("OpenCDAClient object destroyed.");
@@ -175,8 +204,11 @@ namespace ns3
   void
   OpenCDAClient::stopSimulation ()
   {
+      // The processes started manually (CARLAManual, OpenCDAManual) have no PID here: kill(0) would kill ns-3 itself
       if (m_opencda_host == "localhost") {
-          kill(-m_opencda_pid, SIGKILL);
+          if (m_opencda_pid > 0) {
+              kill(-m_opencda_pid, SIGKILL);
+          }
       }
       else {
           std::string kill_cmd = "ssh " + m_opencda_user + "@" + m_opencda_host + " 'kill -9 " +
@@ -184,7 +216,9 @@ namespace ns3
           system(kill_cmd.c_str());
       }
       if (m_carla_host == "localhost") {
-          kill(-m_carla_pid, SIGKILL);
+          if (m_carla_pid > 0) {
+              kill(-m_carla_pid, SIGKILL);
+          }
       }
       else {
           std::string kill_cmd = "ssh " + m_carla_user + "@" + m_carla_host + " 'kill -9 " +
@@ -277,10 +311,10 @@ namespace ns3
                       exit(1);
                   }
               }
+              // Give CARLA the time to start
+              usleep(10000000);
           }
 
-          usleep(10000000);
-
           if (!m_opencda_manual) {
               m_opencda_pid = fork();
 
@@ -349,11 +383,13 @@ namespace ns3
   OpenCDAClient::startSimulation()
   {
       std::cout <<"OpenCDAClient::startSimulation()" << std::endl;
-      usleep(10000000);
       bool server_ready = false;
       if (m_opencda_manual) {
           server_ready = true;
       }
+      else {
+          usleep(10000000);
+      }
       while (!server_ready) {
           // read /tmp/opencda_output.txt to see OpenCDA logs and check if there's a "Server ready" message
           std::string file_name = "/tmp/opencda_output_" + std::to_string(m_opencda_port) + ".txt";
@@ -420,22 +456,7 @@ namespace ns3
 
       while (state != GRPC_CHANNEL_READY) {
           if (!m_channel->WaitForStateChange(state, std::chrono::system_clock::now() + std::chrono::seconds(150))) {
-              if (m_opencda_host == "localhost") {
-                  kill(-m_opencda_pid, SIGKILL);
-              }
-              else {
-                  std::string kill_cmd = "ssh " + m_opencda_user + "@" + m_opencda_host + " 'kill -9 " +
-                      std::to_string(m_opencda_pid) + "'";
-                  system(kill_cmd.c_str());
-              }
-              if (m_carla_host == "localhost") {
-                  kill(-m_carla_pid, SIGKILL);
-              }
-              else {
-                  std::string kill_cmd = "ssh " + m_carla_user + "@" + m_carla_host + " 'kill -9 " +
-                      std::to_string(m_carla_pid) + "'";
-                  system(kill_cmd.c_str());
-              }
+              stopSimulation();
               NS_FATAL_ERROR("Could not connect to gRPC");
           }
           state = m_channel->GetState(true);
@@ -567,11 +588,19 @@ namespace ns3
   carla::Vehicle
   OpenCDAClient::GetManagedActorById(int actorId)
   {
+      if (m_step_cache_valid) {
+          auto it = m_step_actor_idx.find(actorId);
+          if (it != m_step_actor_idx.end()) {
+              return m_step_cache.actors(it->second);
+          }
+      }
+
       carla::Vehicle vehicle;
       carla::Number vehicleId;
       grpc::ClientContext clientContext;
       vehicleId.set_num(actorId);
 
+      joinPendingStep();
       grpc::Status status = m_stub->GetManagedActorById(&clientContext, vehicleId, &vehicle);
       if (status.ok()) {
           return vehicle;
@@ -587,6 +616,7 @@ namespace ns3
       carla::Number vehicleId;
       grpc::ClientContext clientContext;
       std::cout << "Inserting vehicle at location: " << request.location().x() << "/" << request.location().y() << "/" << request.location().z() << std::endl;
+      joinPendingStep();
       grpc::Status status = m_stub->InsertVehicle(&clientContext, request, &vehicleId);
       if (status.ok()) {
           std::cout << "New vehicle inserted succesfully" << std::endl;
@@ -613,6 +643,7 @@ namespace ns3
       google::protobuf::Empty request;
       carla::Transform response;
       grpc::ClientContext clientContext;
+      joinPendingStep();
       grpc::Status status = m_stub->GetRandomSpawnPoint(&clientContext, request, &response);
       if (status.ok()) {
           std::cout << "getRandomSpawnPoint:" << response.location().x() << "/" << response.location().y() << "/" << response.location().z() << std::endl;
@@ -628,61 +659,48 @@ namespace ns3
   OpenCDAClient::executeOneTimestep()
   {
       //std::cout << Simulator::Now().GetSeconds () << ": executeOneTimestep()" << std::endl;
-      google::protobuf::Empty responseEmpty;
-      carla::Boolean retval;
+      bool running;
       google::protobuf::Empty empty;
-      grpc::ClientContext clientContext;
-      grpc::Status status = m_stub->ExecuteOneTimeStep(&clientContext, empty, &retval);
-
-      //if (status.ok())
-      if(!status.ok())
-        {
-          NS_FATAL_ERROR((std::string("OpenCDAClient::executeOneTimestep() failed with error: " + std::string(status.error_message())).c_str()));
-        }
-      if (retval.value ()) {
 
-          carla::ActorIds actors = GetManagedHostIds();
-          for (int i = 0; i < actors.actorid_size(); i++) {
-              auto actorId = actors.actorid(i);
-              carla::Vehicle v = GetManagedActorById(actorId);
-              Vector location;
-              location.x = v.location().x();
-              location.y = v.location().y();
-              location.z = v.location().z();
-              double speed = std::sqrt (
-                  std::pow(v.speed().x(), 2) + std::pow(v.speed().y(), 2) + std::pow(v.speed().z(), 2)
-                  ); // speed and angle not considered by current ms-van3t channel models
-              double angle = v.heading();
-              processVehicleSubscription(v.id(), location, speed, angle);
-              if (m_sionna == true)
-                {
-                  Vector pos_for_sionna = Vector(location.x, location.y, location.z);
-                  double angle_for_sionna = angle;
-                  Vector vel_for_sionna = Vector(speed * cos(angle_for_sionna), speed * sin(angle_for_sionna), 0.0);
-                  updateLocationInSionna(std::to_string (actorId), pos_for_sionna, angle_for_sionna, vel_for_sionna);
-                }
+      if (m_batched_step) {
+          carla::TimeStepResult result;
+          grpc::Status status;
+          if (m_step_in_flight) {
+              // Step requested at the previous synchronization point: join it here
+              waitPendingStep();
+              status = m_pending_status;
+              result.Swap(&m_pending_batch);
+              m_step_in_flight = false;
           }
+          else {
+              grpc::ClientContext clientContext;
+              status = m_stub->ExecuteOneTimeStepBatch(&clientContext, empty, &result);
+          }
+          running = applyTimestepBatch(status, result);
+      }
+      else {
+          carla::Boolean retval;
+          grpc::ClientContext clientContext;
+          grpc::Status status = m_stub->ExecuteOneTimeStep(&clientContext, empty, &retval);
+          running = applyTimestepLegacy(status, retval);
+      }
+
+      if (running) {
           UpdateVehicleFileMap();
           m_executeOneTimestepTrigger = Simulator::Schedule(Seconds(m_updateInterval), &OpenCDAClient::executeOneTimestep, this);
+          if (m_async_step && !m_batched_step) {
+              // Without the batched step, the actors and the LDMs are read with one RPC each, which would have to wait for
+              // the step being computed, and would return its state instead of the one of the last step
+              std::cerr << "OpenCDAClient: AsyncTimeStep requires the batched time step (ExecuteOneTimeStepBatch): disabling it." << std::endl;
+              m_async_step = false;
+          }
+          if (m_async_step) {
+              startNextTimestep();
+          }
 
       }
       else {
-          if (m_opencda_host == "localhost") {
-              kill(-m_opencda_pid, SIGKILL);
-          }
-          else {
-              std::string kill_cmd = "ssh " + m_opencda_user + "@" + m_opencda_host + " 'kill -9 " +
-                  std::to_string(m_opencda_pid) + "'";
-              system(kill_cmd.c_str());
-          }
-          if (m_carla_host == "localhost") {
-              kill(-m_carla_pid, SIGKILL);
-          }
-          else {
-              std::string kill_cmd = "ssh " + m_carla_user + "@" + m_carla_host + " 'kill -9 " +
-                  std::to_string(m_carla_pid) + "'";
-              system(kill_cmd.c_str());
-          }
+          stopSimulation();
           Simulator::Stop ();
 
           std::string file_name = "/tmp/opencda_output_" + std::to_string(m_opencda_port) + ".txt";
@@ -690,6 +708,143 @@ namespace ns3
         }
   }
 
+  void
+  OpenCDAClient::startNextTimestep()
+  {
+      // Controls received while the previous step was being computed
+      for (const carla::Control &control : m_pending_controls) {
+          sendControl(control);
+      }
+      m_pending_controls.clear();
+      // Objects inserted into the OpenCDA LDMs while the previous step was being computed
+      for (const std::function<void()> &insert : m_pending_inserts) {
+          insert();
+      }
+      m_pending_inserts.clear();
+
+      // Only with the batched step (see executeOneTimestep())
+      m_pending_ctx.reset(new grpc::ClientContext);
+      m_pending_batch_rpc = m_stub->PrepareAsyncExecuteOneTimeStepBatch(m_pending_ctx.get(), m_empty, &m_cq);
+      m_pending_batch_rpc->StartCall();
+      m_pending_batch_rpc->Finish(&m_pending_batch, &m_pending_status, this);
+      m_step_in_flight = true;
+      m_step_joined = false;
+  }
+
+  void
+  OpenCDAClient::joinPendingStep()
+  {
+      if (!m_step_in_flight || m_step_joined) {
+          return;
+      }
+
+      m_early_joins++;
+      waitPendingStep();
+  }
+
+  void
+  OpenCDAClient::waitPendingStep()
+  {
+      if (m_step_joined) {
+          return;
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      void *tag;
+      bool ok = false;
+      if (!m_cq.Next(&tag, &ok) || !ok) {
+          NS_FATAL_ERROR("OpenCDAClient::joinPendingStep() failed: the completion queue has been shut down");
+      }
+      m_step_joined = true;
+      NS_LOG_DEBUG("Waited " << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count()
+                   << " ms for the CARLA/OpenCDA step");
+  }
+
+  bool
+  OpenCDAClient::applyTimestepBatch(const grpc::Status &status, carla::TimeStepResult &result)
+  {
+      if (status.error_code() == grpc::StatusCode::UNIMPLEMENTED)
+        {
+          // Older OpenCDA Control Interface: the step has not been executed, fall back to one RPC per actor
+          NS_LOG_WARN("ExecuteOneTimeStepBatch is not implemented by the OpenCDA Control Interface. Falling back to ExecuteOneTimeStep.");
+          m_batched_step = false;
+
+          carla::Boolean retval;
+          google::protobuf::Empty empty;
+          grpc::ClientContext clientContext;
+          grpc::Status legacyStatus = m_stub->ExecuteOneTimeStep(&clientContext, empty, &retval);
+          return applyTimestepLegacy(legacyStatus, retval);
+        }
+      if(!status.ok())
+        {
+          NS_FATAL_ERROR((std::string("OpenCDAClient::executeOneTimestepBatch() failed with error: " + std::string(status.error_message())).c_str()));
+        }
+
+      m_step_cache.Swap(&result);
+      m_step_actor_idx.clear();
+      m_step_cav_idx.clear();
+      m_step_dirty_cavs.clear();
+      m_step_cache_valid = m_step_cache.value();
+
+      if (!m_step_cache.value()) {
+          return false;
+      }
+
+      for (int i = 0; i < m_step_cache.actors_size(); i++) {
+          m_step_actor_idx[m_step_cache.actors(i).id()] = i;
+      }
+      for (int i = 0; i < m_step_cache.cavobjects_size(); i++) {
+          m_step_cav_idx[m_step_cache.cavobjects(i).egoid()] = i;
+      }
+
+      // The cache is already valid here, so that new vehicles are added without any further RPC
+      for (int i = 0; i < m_step_cache.actors_size(); i++) {
+          applyVehicleState(m_step_cache.actors(i));
+      }
+      return true;
+  }
+
+  bool
+  OpenCDAClient::applyTimestepLegacy(const grpc::Status &status, const carla::Boolean &retval)
+  {
+      m_step_cache_valid = false;
+
+      if(!status.ok())
+        {
+          NS_FATAL_ERROR((std::string("OpenCDAClient::executeOneTimestep() failed with error: " + std::string(status.error_message())).c_str()));
+        }
+      if (!retval.value ()) {
+          return false;
+      }
+
+      carla::ActorIds actors = GetManagedHostIds();
+      for (int i = 0; i < actors.actorid_size(); i++) {
+          applyVehicleState(GetManagedActorById(actors.actorid(i)));
+      }
+      return true;
+  }
+
+  void
+  OpenCDAClient::applyVehicleState(const carla::Vehicle &v)
+  {
+      Vector location;
+      location.x = v.location().x();
+      location.y = v.location().y();
+      location.z = v.location().z();
+      double speed = std::sqrt (
+          std::pow(v.speed().x(), 2) + std::pow(v.speed().y(), 2) + std::pow(v.speed().z(), 2)
+          ); // speed and angle not considered by current ms-van3t channel models
+      double angle = v.heading();
+      processVehicleSubscription(v.id(), location, speed, angle);
+      if (m_sionna == true)
+        {
+          Vector pos_for_sionna = Vector(location.x, location.y, location.z);
+          double angle_for_sionna = angle;
+          Vector vel_for_sionna = Vector(speed * cos(angle_for_sionna), speed * sin(angle_for_sionna), 0.0);
+          updateLocationInSionna(std::to_string (v.id()), pos_for_sionna, angle_for_sionna, vel_for_sionna);
+        }
+  }
+
   void
   OpenCDAClient::processVehicleSubscription(int actorId, Vector location, double speed, double angle)
   {
@@ -733,8 +888,16 @@ namespace ns3
   OpenCDAClient::GetManagedHostIds()
   {
       carla::ActorIds actorIds;
+      if (m_step_cache_valid) {
+          for (int i = 0; i < m_step_cache.actors_size(); i++) {
+              actorIds.add_actorid(m_step_cache.actors(i).id());
+          }
+          return actorIds;
+      }
+
       google::protobuf::Empty empty;
       grpc::ClientContext clientContext;
+      joinPendingStep();
       grpc::Status status = m_stub->GetManagedActorsIds(&clientContext, empty, &actorIds);
 
       if (!status.ok()) {
@@ -837,11 +1000,17 @@ OpenCDAClient::getNextWaypoint(Vector location) {
   bool
   OpenCDAClient::hasCARLALDM (int id)
   {
+    if (m_step_cache_valid)
+      {
+        return m_step_cav_idx.find (id) != m_step_cav_idx.end ();
+      }
+
     carla::Boolean retval;
     carla::Number vehicleId;
     vehicleId.set_num (id);
     grpc::ClientContext clientContext;
 
+    joinPendingStep();
     grpc::Status status = m_stub->hasLDM (&clientContext, vehicleId, &retval);
 
     return retval.value ();
@@ -851,15 +1020,78 @@ OpenCDAClient::getNextWaypoint(Vector location) {
   OpenCDAClient::getDetectedObjects (int id)
   {
     carla::Objects retObjects;
+    if (m_step_cache_valid && m_step_dirty_cavs.find (id) == m_step_dirty_cavs.end ())
+      {
+        auto it = m_step_cav_idx.find (id);
+        if (it != m_step_cav_idx.end ())
+          {
+            const carla::CAVObjects &cav = m_step_cache.cavobjects (it->second);
+            for (int i = 0; i < cav.objects_size (); i++)
+              {
+                *retObjects.add_objects () = cav.objects (i).object ();
+              }
+            return retObjects;
+          }
+      }
+
     carla::Number vehicleId;
     vehicleId.set_num (id);
     grpc::ClientContext clientContext;
 
+    joinPendingStep();
     grpc::Status status = m_stub->GetActorLDM (&clientContext, vehicleId, &retObjects);
 
     return retObjects;
   }
 
+  carla::CAVObjects
+  OpenCDAClient::getDetectedObjectsGeo (int id)
+  {
+    carla::CAVObjects retObjects;
+    if (m_step_cache_valid && m_step_dirty_cavs.find (id) == m_step_dirty_cavs.end ())
+      {
+        auto it = m_step_cav_idx.find (id);
+        if (it != m_step_cav_idx.end ())
+          {
+            return m_step_cache.cavobjects (it->second);
+          }
+      }
+
+    if (m_batched_step)
+      {
+        carla::Number vehicleId;
+        vehicleId.set_num (id);
+        grpc::ClientContext clientContext;
+
+        joinPendingStep();
+        grpc::Status status = m_stub->GetActorLDMGeo (&clientContext, vehicleId, &retObjects);
+        if (status.ok ())
+          {
+            return retObjects;
+          }
+        else if (status.error_code () != grpc::StatusCode::UNIMPLEMENTED)
+          {
+            NS_FATAL_ERROR((std::string("OpenCDAClient::getDetectedObjectsGeo() failed with error: " + std::string(status.error_message())).c_str()));
+          }
+        retObjects.Clear ();
+      }
+
+    // Legacy OpenCDA Control Interface: one GetGeo and one GetGTaccuracy RPC for each object
+    carla::Objects objects = getDetectedObjects (id);
+    retObjects.set_egoid (id);
+    for (int i = 0; i < objects.objects_size (); i++)
+      {
+        const carla::Object &obj = objects.objects (i);
+        carla::DetectedObject *detObj = retObjects.add_objects ();
+        *detObj->mutable_object () = obj;
+        carla::Vector objPos = getGeo (obj.transform ().location ().x (), obj.transform ().location ().y ());
+        detObj->set_latitude (objPos.x ());
+        detObj->set_longitude (objPos.y ());
+        detObj->set_gtaccuracy (getGTaccuracy (obj.transform ().location ().x (), obj.transform ().location ().y (), obj.length (), obj.width (), obj.yaw (), obj.id ()));
+      }
+    return retObjects;
+  }
+
     double
     OpenCDAClient::getGTaccuracy(double x, double y, double length, double width, double yaw, int id) {
       carla::ObjectMinimal object;
@@ -879,6 +1111,7 @@ OpenCDAClient::getNextWaypoint(Vector location) {
       object.set_length(length);
       object.set_width(width);
 
+      joinPendingStep();
       grpc::Status status = m_stub->GetGTaccuracy(&clientContext, object, &accuracy);
 
       if (!status.ok()) {
@@ -906,6 +1139,20 @@ OpenCDAClient::getNextWaypoint(Vector location) {
 
   bool
   OpenCDAClient::InsertObject (carla::ObjectIn object)
+  {
+    if (m_step_in_flight)
+      {
+        // As for setControl(), the LDM of the CAV is updated right before requesting the next step, without waiting for
+        // the step being computed: the objects are visible to getDetectedObjectsGeo() from the result of the next step
+        m_pending_inserts.push_back ([this, object] () {sendInsertObject (object);});
+        return true;
+      }
+    m_step_dirty_cavs.insert (object.egoid ());
+    return sendInsertObject (object);
+  }
+
+  bool
+  OpenCDAClient::sendInsertObject (const carla::ObjectIn &object)
   {
     grpc::ClientContext clientContext;
     carla::Number ret;
@@ -922,6 +1169,17 @@ OpenCDAClient::getNextWaypoint(Vector location) {
 
     double
   OpenCDAClient::InsertCV(carla::ObjectIn object)
+  {
+      if (m_step_in_flight) {
+          m_pending_inserts.push_back([this, object] () {sendInsertCV(object);});
+          return 0.0;
+      }
+      m_step_dirty_cavs.insert (object.egoid ());
+      return sendInsertCV(object);
+  }
+
+  double
+  OpenCDAClient::sendInsertCV(const carla::ObjectIn &object)
   {
       grpc::ClientContext clientContext;
       carla::DoubleValue ret;
@@ -934,6 +1192,17 @@ OpenCDAClient::getNextWaypoint(Vector location) {
   }
     double
   OpenCDAClient::InsertObjects (carla::ObjectsIn objects)
+  {
+      if (m_step_in_flight) {
+          m_pending_inserts.push_back([this, objects] () {sendInsertObjects(objects);});
+          return 0.0;
+      }
+      m_step_dirty_cavs.insert (objects.egoid ());
+      return sendInsertObjects(objects);
+  }
+
+  double
+  OpenCDAClient::sendInsertObjects(const carla::ObjectsIn &objects)
   {
       grpc::ClientContext clientContext;
       carla::DoubleValue ret;
@@ -948,7 +1217,6 @@ OpenCDAClient::getNextWaypoint(Vector location) {
 
     void
     OpenCDAClient::setControl(int id, double speed, Vector position, double acceleration) {
-      grpc::ClientContext clientContext;
       carla::Control control;
       carla::Vector* pos = control.mutable_waypoint();
 
@@ -960,6 +1228,19 @@ OpenCDAClient::getNextWaypoint(Vector location) {
       control.set_speed(speed);
       control.set_acceleration(acceleration);
 
+      if (m_step_in_flight) {
+          // Sent right before requesting the next step: it is applied to the step following the one being computed,
+          // whatever the timing of the OpenCDA Control Interface
+          m_pending_controls.push_back(control);
+          return;
+      }
+      sendControl(control);
+  }
+
+  void
+  OpenCDAClient::sendControl(const carla::Control &control)
+  {
+      grpc::ClientContext clientContext;
       google::protobuf::Empty responseEmpty;
       grpc::Status status = m_stub->SetControl(&clientContext, control, &responseEmpty);
 
@@ -973,8 +1254,18 @@ OpenCDAClient::getNextWaypoint(Vector location) {
   OpenCDAClient::GetManagedCAVsIds()
   {
     carla::ActorIds actorIds;
+    if (m_step_cache_valid)
+      {
+        for (int i = 0; i < m_step_cache.cavobjects_size (); i++)
+          {
+            actorIds.add_actorid (m_step_cache.cavobjects (i).egoid ());
+          }
+        return actorIds;
+      }
+
     google::protobuf::Empty empty;
     grpc::ClientContext clientContext;
+    joinPendingStep();
     grpc::Status status = m_stub->GetManagedCAVsIds (&clientContext, empty, &actorIds);
 
     if (!status.ok()) {
@@ -27,6 +27,8 @@
 #include "grpcpp/grpcpp.h"
 #include <signal.h>
 #include <unistd.h>
+#include <set>
+#include <unordered_map>
 #include "ns3/sionna-connection-handler.h"
 
 
@@ -59,10 +61,25 @@ namespace ns3
       double getHeading(int id);
       bool hasCARLALDM(int id);
       carla::Objects getDetectedObjects(int id);
+      /**
+       * @brief Get the objects detected by a CAV, together with their geographic coordinates and GT accuracy.
+       *
+       * When the batched time step is active, the objects are taken from the result of the last step, unless the
+       * LDM of the CAV has been modified in the meantime (InsertObject(), InsertObjects(), InsertCV()): in this case,
+       * a single GetActorLDMGeo RPC is performed, instead of a GetGeo and a GetGTaccuracy RPC for each object.
+       */
+      carla::CAVObjects getDetectedObjectsGeo(int id);
       void setControl(int id, double speed, Vector position, double acceleration);
       carla::Waypoint getWaypoint(Vector location);
       carla::Waypoint getNextWaypoint(Vector location);
       carla::ActorIds GetManagedCAVsIds();
+      /**
+       * @brief Insert objects received through V2X into the OpenCDA LDM of a CAV (InsertObject(), InsertCV() as well).
+       *
+       * With AsyncTimeStep, while a step is being computed the objects are queued and sent right before requesting
+       * the next step, as the controls of setControl(), and the value returned by the OpenCDA Control Interface is not
+       * available (0, or true for InsertObject()).
+       */
       double InsertObjects (carla::ObjectsIn object);
       double InsertCV(carla::ObjectIn object);
 
@@ -76,8 +93,45 @@ namespace ns3
 
       void SetSionnaUp() {m_sionna = true;};
 
+      /**
+       * @brief Number of times an RPC had to wait for the step requested asynchronously before the next
+       * synchronization point (AsyncTimeStep), losing the overlap between ns-3 and CARLA/OpenCDA.
+       */
+      uint64_t getEarlyStepJoins() const {return m_early_joins;};
+      /**
+       * @brief True if the next steps are requested asynchronously, i.e., if AsyncTimeStep is set and it has not been
+       * disabled because the batched time step is not available.
+       */
+      bool isAsyncTimeStep() const {return m_async_step;};
+
     private:
       void executeOneTimestep();
+      bool applyTimestepBatch(const grpc::Status &status, carla::TimeStepResult &result);
+      bool applyTimestepLegacy(const grpc::Status &status, const carla::Boolean &retval);
+      void sendControl(const carla::Control &control);
+      bool sendInsertObject(const carla::ObjectIn &object);
+      double sendInsertCV(const carla::ObjectIn &object);
+      double sendInsertObjects(const carla::ObjectsIn &objects);
+
+      /**
+       * @brief Request the next step with an asynchronous RPC (AsyncTimeStep attribute).
+       *
+       * The result is joined at the next synchronization point (executeOneTimestep()), or earlier if an RPC which
+       * depends on the state of the CARLA/OpenCDA simulation has to be performed in the meantime (see joinPendingStep()).
+       */
+      void startNextTimestep();
+      /**
+       * @brief Wait for the completion of the step requested by startNextTimestep(), if any.
+       *
+       * Its result is not applied here, but only at the next synchronization point. It is called before any RPC,
+       * except SetControl and the Insert* RPCs (whose requests are sent just before the next step) and the map queries
+       * (GetGeo, GetCartesian, GetCarlaWaypoint, GetNextCarlaWaypoint), which do not depend on the step. The queries
+       * which can be answered from the result of the last step (GetManagedActorById, GetManagedActorsIds,
+       * GetManagedCAVsIds, hasLDM, GetActorLDMGeo) do not call it when the batched time step is active.
+       */
+      void joinPendingStep();
+      void waitPendingStep();
+      void applyVehicleState(const carla::Vehicle &v);
       void insertVehicle(carla::Vehicle request);
       void printVehicle(carla::Vehicle vehicle);
       void processVehicleSubscription(int actorId, Vector location, double speed, double angle);
@@ -135,6 +189,26 @@ namespace ns3
 
       bool m_sionna = false;
 
+      bool m_batched_step; //!< Use a single ExecuteOneTimeStepBatch RPC per step, instead of one RPC per actor
+      bool m_step_cache_valid = false; //!< True if m_step_cache contains the result of the current step
+      carla::TimeStepResult m_step_cache; //!< Result of the last ExecuteOneTimeStepBatch RPC
+      std::unordered_map<int,int> m_step_actor_idx; //!< Actor ID -> index in m_step_cache.actors()
+      std::unordered_map<int,int> m_step_cav_idx; //!< CAV ID -> index in m_step_cache.cavobjects()
+      std::set<int> m_step_dirty_cavs; //!< CAVs whose OpenCDA LDM has been modified after the last step
+
+      bool m_async_step; //!< Request the next step asynchronously, as soon as the current one has been applied (batched step only)
+      grpc::CompletionQueue m_cq; //!< Completion queue of the asynchronous step RPC
+      google::protobuf::Empty m_empty;
+      std::unique_ptr<grpc::ClientContext> m_pending_ctx; //!< Context of the asynchronous step RPC
+      std::unique_ptr<grpc::ClientAsyncResponseReader<carla::TimeStepResult>> m_pending_batch_rpc;
+      carla::TimeStepResult m_pending_batch; //!< Result of the asynchronous ExecuteOneTimeStepBatch RPC
+      grpc::Status m_pending_status;
+      bool m_step_in_flight = false; //!< True if a step has been requested and not yet applied
+      bool m_step_joined = false; //!< True if the requested step has been completed, but not yet applied
+      std::vector<carla::Control> m_pending_controls; //!< Controls to be sent before requesting the next step
+      std::vector<std::function<void()>> m_pending_inserts; //!< Insert* RPCs to be sent before requesting the next step
+      uint64_t m_early_joins = 0; //!< Steps joined before the next synchronization point (see getEarlyStepJoins())
+
     };
 
 }
@@ -40,6 +40,8 @@ static const char* CarlaAdapter_method_names[] = {
   "/carla.CarlaAdapter/GetCarlaWaypoint",
   "/carla.CarlaAdapter/GetNextCarlaWaypoint",
   "/carla.CarlaAdapter/GetGTaccuracy",
+  "/carla.CarlaAdapter/ExecuteOneTimeStepBatch",
+  "/carla.CarlaAdapter/GetActorLDMGeo",
 };
 
 std::unique_ptr< CarlaAdapter::Stub> CarlaAdapter::NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options) {
@@ -67,6 +69,8 @@ CarlaAdapter::Stub::Stub(const std::shared_ptr< ::grpc::ChannelInterface>& chann
   , rpcmethod_GetCarlaWaypoint_(CarlaAdapter_method_names[15], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_GetNextCarlaWaypoint_(CarlaAdapter_method_names[16], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   , rpcmethod_GetGTaccuracy_(CarlaAdapter_method_names[17], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
+  , rpcmethod_ExecuteOneTimeStepBatch_(CarlaAdapter_method_names[18], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
+  , rpcmethod_GetActorLDMGeo_(CarlaAdapter_method_names[19], options.suffix_for_stats(),::grpc::internal::RpcMethod::NORMAL_RPC, channel)
   {}
 
 ::grpc::Status CarlaAdapter::Stub::ExecuteOneTimeStep(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::carla::Boolean* response) {
@@ -483,6 +487,52 @@ void CarlaAdapter::Stub::async::GetGTaccuracy(::grpc::ClientContext* context, co
   return result;
 }
 
+::grpc::Status CarlaAdapter::Stub::ExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::carla::TimeStepResult* response) {
+  return ::grpc::internal::BlockingUnaryCall< ::google::protobuf::Empty, ::carla::TimeStepResult, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(channel_.get(), rpcmethod_ExecuteOneTimeStepBatch_, context, request, response);
+}
+
+void CarlaAdapter::Stub::async::ExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty* request, ::carla::TimeStepResult* response, std::function<void(::grpc::Status)> f) {
+  ::grpc::internal::CallbackUnaryCall< ::google::protobuf::Empty, ::carla::TimeStepResult, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(stub_->channel_.get(), stub_->rpcmethod_ExecuteOneTimeStepBatch_, context, request, response, std::move(f));
+}
+
+void CarlaAdapter::Stub::async::ExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty* request, ::carla::TimeStepResult* response, ::grpc::ClientUnaryReactor* reactor) {
+  ::grpc::internal::ClientCallbackUnaryFactory::Create< ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(stub_->channel_.get(), stub_->rpcmethod_ExecuteOneTimeStepBatch_, context, request, response, reactor);
+}
+
+::grpc::ClientAsyncResponseReader< ::carla::TimeStepResult>* CarlaAdapter::Stub::PrepareAsyncExecuteOneTimeStepBatchRaw(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncResponseReaderHelper::Create< ::carla::TimeStepResult, ::google::protobuf::Empty, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(channel_.get(), cq, rpcmethod_ExecuteOneTimeStepBatch_, context, request);
+}
+
+::grpc::ClientAsyncResponseReader< ::carla::TimeStepResult>* CarlaAdapter::Stub::AsyncExecuteOneTimeStepBatchRaw(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::grpc::CompletionQueue* cq) {
+  auto* result =
+    this->PrepareAsyncExecuteOneTimeStepBatchRaw(context, request, cq);
+  result->StartCall();
+  return result;
+}
+
+::grpc::Status CarlaAdapter::Stub::GetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number& request, ::carla::CAVObjects* response) {
+  return ::grpc::internal::BlockingUnaryCall< ::carla::Number, ::carla::CAVObjects, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(channel_.get(), rpcmethod_GetActorLDMGeo_, context, request, response);
+}
+
+void CarlaAdapter::Stub::async::GetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number* request, ::carla::CAVObjects* response, std::function<void(::grpc::Status)> f) {
+  ::grpc::internal::CallbackUnaryCall< ::carla::Number, ::carla::CAVObjects, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(stub_->channel_.get(), stub_->rpcmethod_GetActorLDMGeo_, context, request, response, std::move(f));
+}
+
+void CarlaAdapter::Stub::async::GetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number* request, ::carla::CAVObjects* response, ::grpc::ClientUnaryReactor* reactor) {
+  ::grpc::internal::ClientCallbackUnaryFactory::Create< ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(stub_->channel_.get(), stub_->rpcmethod_GetActorLDMGeo_, context, request, response, reactor);
+}
+
+::grpc::ClientAsyncResponseReader< ::carla::CAVObjects>* CarlaAdapter::Stub::PrepareAsyncGetActorLDMGeoRaw(::grpc::ClientContext* context, const ::carla::Number& request, ::grpc::CompletionQueue* cq) {
+  return ::grpc::internal::ClientAsyncResponseReaderHelper::Create< ::carla::CAVObjects, ::carla::Number, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(channel_.get(), cq, rpcmethod_GetActorLDMGeo_, context, request);
+}
+
+::grpc::ClientAsyncResponseReader< ::carla::CAVObjects>* CarlaAdapter::Stub::AsyncGetActorLDMGeoRaw(::grpc::ClientContext* context, const ::carla::Number& request, ::grpc::CompletionQueue* cq) {
+  auto* result =
+    this->PrepareAsyncGetActorLDMGeoRaw(context, request, cq);
+  result->StartCall();
+  return result;
+}
+
 CarlaAdapter::Service::Service() {
   AddMethod(new ::grpc::internal::RpcServiceMethod(
       CarlaAdapter_method_names[0],
@@ -664,6 +714,26 @@ CarlaAdapter::Service::Service() {
              ::carla::DoubleValue* resp) {
                return service->GetGTaccuracy(ctx, req, resp);
              }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      CarlaAdapter_method_names[18],
+      ::grpc::internal::RpcMethod::NORMAL_RPC,
+      new ::grpc::internal::RpcMethodHandler< CarlaAdapter::Service, ::google::protobuf::Empty, ::carla::TimeStepResult, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(
+          [](CarlaAdapter::Service* service,
+             ::grpc::ServerContext* ctx,
+             const ::google::protobuf::Empty* req,
+             ::carla::TimeStepResult* resp) {
+               return service->ExecuteOneTimeStepBatch(ctx, req, resp);
+             }, this)));
+  AddMethod(new ::grpc::internal::RpcServiceMethod(
+      CarlaAdapter_method_names[19],
+      ::grpc::internal::RpcMethod::NORMAL_RPC,
+      new ::grpc::internal::RpcMethodHandler< CarlaAdapter::Service, ::carla::Number, ::carla::CAVObjects, ::grpc::protobuf::MessageLite, ::grpc::protobuf::MessageLite>(
+          [](CarlaAdapter::Service* service,
+             ::grpc::ServerContext* ctx,
+             const ::carla::Number* req,
+             ::carla::CAVObjects* resp) {
+               return service->GetActorLDMGeo(ctx, req, resp);
+             }, this)));
 }
 
 CarlaAdapter::Service::~Service() {
@@ -795,6 +865,20 @@ CarlaAdapter::Service::~Service() {
   return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
 }
 
+::grpc::Status CarlaAdapter::Service::ExecuteOneTimeStepBatch(::grpc::ServerContext* context, const ::google::protobuf::Empty* request, ::carla::TimeStepResult* response) {
+  (void) context;
+  (void) request;
+  (void) response;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
+::grpc::Status CarlaAdapter::Service::GetActorLDMGeo(::grpc::ServerContext* context, const ::carla::Number* request, ::carla::CAVObjects* response) {
+  (void) context;
+  (void) request;
+  (void) response;
+  return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+}
+
 
 }  // namespace carla
 
@@ -183,6 +183,20 @@ class CarlaAdapter final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::carla::DoubleValue>> PrepareAsyncGetGTaccuracy(::grpc::ClientContext* context, const ::carla::ObjectMinimal& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::carla::DoubleValue>>(PrepareAsyncGetGTaccuracyRaw(context, request, cq));
     }
+    virtual ::grpc::Status ExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::carla::TimeStepResult* response) = 0;
+    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::carla::TimeStepResult>> AsyncExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::carla::TimeStepResult>>(AsyncExecuteOneTimeStepBatchRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::carla::TimeStepResult>> PrepareAsyncExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::carla::TimeStepResult>>(PrepareAsyncExecuteOneTimeStepBatchRaw(context, request, cq));
+    }
+    virtual ::grpc::Status GetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number& request, ::carla::CAVObjects* response) = 0;
+    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::carla::CAVObjects>> AsyncGetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::carla::CAVObjects>>(AsyncGetActorLDMGeoRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::carla::CAVObjects>> PrepareAsyncGetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReaderInterface< ::carla::CAVObjects>>(PrepareAsyncGetActorLDMGeoRaw(context, request, cq));
+    }
     class async_interface {
      public:
       virtual ~async_interface() {}
@@ -222,6 +236,10 @@ class CarlaAdapter final {
       virtual void GetNextCarlaWaypoint(::grpc::ClientContext* context, const ::carla::Vector* request, ::carla::Waypoint* response, ::grpc::ClientUnaryReactor* reactor) = 0;
       virtual void GetGTaccuracy(::grpc::ClientContext* context, const ::carla::ObjectMinimal* request, ::carla::DoubleValue* response, std::function<void(::grpc::Status)>) = 0;
       virtual void GetGTaccuracy(::grpc::ClientContext* context, const ::carla::ObjectMinimal* request, ::carla::DoubleValue* response, ::grpc::ClientUnaryReactor* reactor) = 0;
+      virtual void ExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty* request, ::carla::TimeStepResult* response, std::function<void(::grpc::Status)>) = 0;
+      virtual void ExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty* request, ::carla::TimeStepResult* response, ::grpc::ClientUnaryReactor* reactor) = 0;
+      virtual void GetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number* request, ::carla::CAVObjects* response, std::function<void(::grpc::Status)>) = 0;
+      virtual void GetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number* request, ::carla::CAVObjects* response, ::grpc::ClientUnaryReactor* reactor) = 0;
     };
     typedef class async_interface experimental_async_interface;
     virtual class async_interface* async() { return nullptr; }
@@ -263,6 +281,10 @@ class CarlaAdapter final {
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::carla::Waypoint>* PrepareAsyncGetNextCarlaWaypointRaw(::grpc::ClientContext* context, const ::carla::Vector& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::carla::DoubleValue>* AsyncGetGTaccuracyRaw(::grpc::ClientContext* context, const ::carla::ObjectMinimal& request, ::grpc::CompletionQueue* cq) = 0;
     virtual ::grpc::ClientAsyncResponseReaderInterface< ::carla::DoubleValue>* PrepareAsyncGetGTaccuracyRaw(::grpc::ClientContext* context, const ::carla::ObjectMinimal& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientAsyncResponseReaderInterface< ::carla::TimeStepResult>* AsyncExecuteOneTimeStepBatchRaw(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientAsyncResponseReaderInterface< ::carla::TimeStepResult>* PrepareAsyncExecuteOneTimeStepBatchRaw(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientAsyncResponseReaderInterface< ::carla::CAVObjects>* AsyncGetActorLDMGeoRaw(::grpc::ClientContext* context, const ::carla::Number& request, ::grpc::CompletionQueue* cq) = 0;
+    virtual ::grpc::ClientAsyncResponseReaderInterface< ::carla::CAVObjects>* PrepareAsyncGetActorLDMGeoRaw(::grpc::ClientContext* context, const ::carla::Number& request, ::grpc::CompletionQueue* cq) = 0;
   };
   class Stub final : public StubInterface {
    public:
@@ -393,6 +415,20 @@ class CarlaAdapter final {
     std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::carla::DoubleValue>> PrepareAsyncGetGTaccuracy(::grpc::ClientContext* context, const ::carla::ObjectMinimal& request, ::grpc::CompletionQueue* cq) {
       return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::carla::DoubleValue>>(PrepareAsyncGetGTaccuracyRaw(context, request, cq));
     }
+    ::grpc::Status ExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::carla::TimeStepResult* response) override;
+    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::carla::TimeStepResult>> AsyncExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::carla::TimeStepResult>>(AsyncExecuteOneTimeStepBatchRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::carla::TimeStepResult>> PrepareAsyncExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::carla::TimeStepResult>>(PrepareAsyncExecuteOneTimeStepBatchRaw(context, request, cq));
+    }
+    ::grpc::Status GetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number& request, ::carla::CAVObjects* response) override;
+    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::carla::CAVObjects>> AsyncGetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::carla::CAVObjects>>(AsyncGetActorLDMGeoRaw(context, request, cq));
+    }
+    std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::carla::CAVObjects>> PrepareAsyncGetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number& request, ::grpc::CompletionQueue* cq) {
+      return std::unique_ptr< ::grpc::ClientAsyncResponseReader< ::carla::CAVObjects>>(PrepareAsyncGetActorLDMGeoRaw(context, request, cq));
+    }
     class async final :
       public StubInterface::async_interface {
      public:
@@ -432,6 +468,10 @@ class CarlaAdapter final {
       void GetNextCarlaWaypoint(::grpc::ClientContext* context, const ::carla::Vector* request, ::carla::Waypoint* response, ::grpc::ClientUnaryReactor* reactor) override;
       void GetGTaccuracy(::grpc::ClientContext* context, const ::carla::ObjectMinimal* request, ::carla::DoubleValue* response, std::function<void(::grpc::Status)>) override;
       void GetGTaccuracy(::grpc::ClientContext* context, const ::carla::ObjectMinimal* request, ::carla::DoubleValue* response, ::grpc::ClientUnaryReactor* reactor) override;
+      void ExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty* request, ::carla::TimeStepResult* response, std::function<void(::grpc::Status)>) override;
+      void ExecuteOneTimeStepBatch(::grpc::ClientContext* context, const ::google::protobuf::Empty* request, ::carla::TimeStepResult* response, ::grpc::ClientUnaryReactor* reactor) override;
+      void GetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number* request, ::carla::CAVObjects* response, std::function<void(::grpc::Status)>) override;
+      void GetActorLDMGeo(::grpc::ClientContext* context, const ::carla::Number* request, ::carla::CAVObjects* response, ::grpc::ClientUnaryReactor* reactor) override;
      private:
       friend class Stub;
       explicit async(Stub* stub): stub_(stub) { }
@@ -479,6 +519,10 @@ class CarlaAdapter final {
     ::grpc::ClientAsyncResponseReader< ::carla::Waypoint>* PrepareAsyncGetNextCarlaWaypointRaw(::grpc::ClientContext* context, const ::carla::Vector& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::carla::DoubleValue>* AsyncGetGTaccuracyRaw(::grpc::ClientContext* context, const ::carla::ObjectMinimal& request, ::grpc::CompletionQueue* cq) override;
     ::grpc::ClientAsyncResponseReader< ::carla::DoubleValue>* PrepareAsyncGetGTaccuracyRaw(::grpc::ClientContext* context, const ::carla::ObjectMinimal& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientAsyncResponseReader< ::carla::TimeStepResult>* AsyncExecuteOneTimeStepBatchRaw(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientAsyncResponseReader< ::carla::TimeStepResult>* PrepareAsyncExecuteOneTimeStepBatchRaw(::grpc::ClientContext* context, const ::google::protobuf::Empty& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientAsyncResponseReader< ::carla::CAVObjects>* AsyncGetActorLDMGeoRaw(::grpc::ClientContext* context, const ::carla::Number& request, ::grpc::CompletionQueue* cq) override;
+    ::grpc::ClientAsyncResponseReader< ::carla::CAVObjects>* PrepareAsyncGetActorLDMGeoRaw(::grpc::ClientContext* context, const ::carla::Number& request, ::grpc::CompletionQueue* cq) override;
     const ::grpc::internal::RpcMethod rpcmethod_ExecuteOneTimeStep_;
     const ::grpc::internal::RpcMethod rpcmethod_Finish_;
     const ::grpc::internal::RpcMethod rpcmethod_GetManagedActorsIds_;
@@ -497,6 +541,8 @@ class CarlaAdapter final {
     const ::grpc::internal::RpcMethod rpcmethod_GetCarlaWaypoint_;
     const ::grpc::internal::RpcMethod rpcmethod_GetNextCarlaWaypoint_;
     const ::grpc::internal::RpcMethod rpcmethod_GetGTaccuracy_;
+    const ::grpc::internal::RpcMethod rpcmethod_ExecuteOneTimeStepBatch_;
+    const ::grpc::internal::RpcMethod rpcmethod_GetActorLDMGeo_;
   };
   static std::unique_ptr<Stub> NewStub(const std::shared_ptr< ::grpc::ChannelInterface>& channel, const ::grpc::StubOptions& options = ::grpc::StubOptions());
 
@@ -522,6 +568,8 @@ class CarlaAdapter final {
     virtual ::grpc::Status GetCarlaWaypoint(::grpc::ServerContext* context, const ::carla::Vector* request, ::carla::Waypoint* response);
     virtual ::grpc::Status GetNextCarlaWaypoint(::grpc::ServerContext* context, const ::carla::Vector* request, ::carla::Waypoint* response);
     virtual ::grpc::Status GetGTaccuracy(::grpc::ServerContext* context, const ::carla::ObjectMinimal* request, ::carla::DoubleValue* response);
+    virtual ::grpc::Status ExecuteOneTimeStepBatch(::grpc::ServerContext* context, const ::google::protobuf::Empty* request, ::carla::TimeStepResult* response);
+    virtual ::grpc::Status GetActorLDMGeo(::grpc::ServerContext* context, const ::carla::Number* request, ::carla::CAVObjects* response);
   };
   template <class BaseClass>
   class WithAsyncMethod_ExecuteOneTimeStep : public BaseClass {
@@ -883,7 +931,47 @@ class CarlaAdapter final {
       ::grpc::Service::RequestAsyncUnary(17, context, request, response, new_call_cq, notification_cq, tag);
     }
   };
-  typedef WithAsyncMethod_ExecuteOneTimeStep<WithAsyncMethod_Finish<WithAsyncMethod_GetManagedActorsIds<WithAsyncMethod_GetManagedCAVsIds<WithAsyncMethod_GetManagedActorById<WithAsyncMethod_InsertVehicle<WithAsyncMethod_GetRandomSpawnPoint<WithAsyncMethod_GetActorLDM<WithAsyncMethod_InsertObject<WithAsyncMethod_InsertObjects<WithAsyncMethod_InsertCV<WithAsyncMethod_GetCartesian<WithAsyncMethod_GetGeo<WithAsyncMethod_hasLDM<WithAsyncMethod_SetControl<WithAsyncMethod_GetCarlaWaypoint<WithAsyncMethod_GetNextCarlaWaypoint<WithAsyncMethod_GetGTaccuracy<Service > > > > > > > > > > > > > > > > > > AsyncService;
+  template <class BaseClass>
+  class WithAsyncMethod_ExecuteOneTimeStepBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_ExecuteOneTimeStepBatch() {
+      ::grpc::Service::MarkMethodAsync(18);
+    }
+    ~WithAsyncMethod_ExecuteOneTimeStepBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status ExecuteOneTimeStepBatch(::grpc::ServerContext* /*context*/, const ::google::protobuf::Empty* /*request*/, ::carla::TimeStepResult* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestExecuteOneTimeStepBatch(::grpc::ServerContext* context, ::google::protobuf::Empty* request, ::grpc::ServerAsyncResponseWriter< ::carla::TimeStepResult>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncUnary(18, context, request, response, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithAsyncMethod_GetActorLDMGeo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithAsyncMethod_GetActorLDMGeo() {
+      ::grpc::Service::MarkMethodAsync(19);
+    }
+    ~WithAsyncMethod_GetActorLDMGeo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status GetActorLDMGeo(::grpc::ServerContext* /*context*/, const ::carla::Number* /*request*/, ::carla::CAVObjects* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestGetActorLDMGeo(::grpc::ServerContext* context, ::carla::Number* request, ::grpc::ServerAsyncResponseWriter< ::carla::CAVObjects>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncUnary(19, context, request, response, new_call_cq, notification_cq, tag);
+    }
+  };
+  typedef WithAsyncMethod_ExecuteOneTimeStep<WithAsyncMethod_Finish<WithAsyncMethod_GetManagedActorsIds<WithAsyncMethod_GetManagedCAVsIds<WithAsyncMethod_GetManagedActorById<WithAsyncMethod_InsertVehicle<WithAsyncMethod_GetRandomSpawnPoint<WithAsyncMethod_GetActorLDM<WithAsyncMethod_InsertObject<WithAsyncMethod_InsertObjects<WithAsyncMethod_InsertCV<WithAsyncMethod_GetCartesian<WithAsyncMethod_GetGeo<WithAsyncMethod_hasLDM<WithAsyncMethod_SetControl<WithAsyncMethod_GetCarlaWaypoint<WithAsyncMethod_GetNextCarlaWaypoint<WithAsyncMethod_GetGTaccuracy<WithAsyncMethod_ExecuteOneTimeStepBatch<WithAsyncMethod_GetActorLDMGeo<Service > > > > > > > > > > > > > > > > > > > > AsyncService;
   template <class BaseClass>
   class WithCallbackMethod_ExecuteOneTimeStep : public BaseClass {
    private:
@@ -1370,7 +1458,61 @@ class CarlaAdapter final {
     virtual ::grpc::ServerUnaryReactor* GetGTaccuracy(
       ::grpc::CallbackServerContext* /*context*/, const ::carla::ObjectMinimal* /*request*/, ::carla::DoubleValue* /*response*/)  { return nullptr; }
   };
-  typedef WithCallbackMethod_ExecuteOneTimeStep<WithCallbackMethod_Finish<WithCallbackMethod_GetManagedActorsIds<WithCallbackMethod_GetManagedCAVsIds<WithCallbackMethod_GetManagedActorById<WithCallbackMethod_InsertVehicle<WithCallbackMethod_GetRandomSpawnPoint<WithCallbackMethod_GetActorLDM<WithCallbackMethod_InsertObject<WithCallbackMethod_InsertObjects<WithCallbackMethod_InsertCV<WithCallbackMethod_GetCartesian<WithCallbackMethod_GetGeo<WithCallbackMethod_hasLDM<WithCallbackMethod_SetControl<WithCallbackMethod_GetCarlaWaypoint<WithCallbackMethod_GetNextCarlaWaypoint<WithCallbackMethod_GetGTaccuracy<Service > > > > > > > > > > > > > > > > > > CallbackService;
+  template <class BaseClass>
+  class WithCallbackMethod_ExecuteOneTimeStepBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithCallbackMethod_ExecuteOneTimeStepBatch() {
+      ::grpc::Service::MarkMethodCallback(18,
+          new ::grpc::internal::CallbackUnaryHandler< ::google::protobuf::Empty, ::carla::TimeStepResult>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::google::protobuf::Empty* request, ::carla::TimeStepResult* response) { return this->ExecuteOneTimeStepBatch(context, request, response); }));}
+    void SetMessageAllocatorFor_ExecuteOneTimeStepBatch(
+        ::grpc::MessageAllocator< ::google::protobuf::Empty, ::carla::TimeStepResult>* allocator) {
+      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::GetHandler(18);
+      static_cast<::grpc::internal::CallbackUnaryHandler< ::google::protobuf::Empty, ::carla::TimeStepResult>*>(handler)
+              ->SetMessageAllocator(allocator);
+    }
+    ~WithCallbackMethod_ExecuteOneTimeStepBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status ExecuteOneTimeStepBatch(::grpc::ServerContext* /*context*/, const ::google::protobuf::Empty* /*request*/, ::carla::TimeStepResult* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerUnaryReactor* ExecuteOneTimeStepBatch(
+      ::grpc::CallbackServerContext* /*context*/, const ::google::protobuf::Empty* /*request*/, ::carla::TimeStepResult* /*response*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithCallbackMethod_GetActorLDMGeo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithCallbackMethod_GetActorLDMGeo() {
+      ::grpc::Service::MarkMethodCallback(19,
+          new ::grpc::internal::CallbackUnaryHandler< ::carla::Number, ::carla::CAVObjects>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::carla::Number* request, ::carla::CAVObjects* response) { return this->GetActorLDMGeo(context, request, response); }));}
+    void SetMessageAllocatorFor_GetActorLDMGeo(
+        ::grpc::MessageAllocator< ::carla::Number, ::carla::CAVObjects>* allocator) {
+      ::grpc::internal::MethodHandler* const handler = ::grpc::Service::GetHandler(19);
+      static_cast<::grpc::internal::CallbackUnaryHandler< ::carla::Number, ::carla::CAVObjects>*>(handler)
+              ->SetMessageAllocator(allocator);
+    }
+    ~WithCallbackMethod_GetActorLDMGeo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status GetActorLDMGeo(::grpc::ServerContext* /*context*/, const ::carla::Number* /*request*/, ::carla::CAVObjects* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerUnaryReactor* GetActorLDMGeo(
+      ::grpc::CallbackServerContext* /*context*/, const ::carla::Number* /*request*/, ::carla::CAVObjects* /*response*/)  { return nullptr; }
+  };
+  typedef WithCallbackMethod_ExecuteOneTimeStep<WithCallbackMethod_Finish<WithCallbackMethod_GetManagedActorsIds<WithCallbackMethod_GetManagedCAVsIds<WithCallbackMethod_GetManagedActorById<WithCallbackMethod_InsertVehicle<WithCallbackMethod_GetRandomSpawnPoint<WithCallbackMethod_GetActorLDM<WithCallbackMethod_InsertObject<WithCallbackMethod_InsertObjects<WithCallbackMethod_InsertCV<WithCallbackMethod_GetCartesian<WithCallbackMethod_GetGeo<WithCallbackMethod_hasLDM<WithCallbackMethod_SetControl<WithCallbackMethod_GetCarlaWaypoint<WithCallbackMethod_GetNextCarlaWaypoint<WithCallbackMethod_GetGTaccuracy<WithCallbackMethod_ExecuteOneTimeStepBatch<WithCallbackMethod_GetActorLDMGeo<Service > > > > > > > > > > > > > > > > > > > > CallbackService;
   typedef CallbackService ExperimentalCallbackService;
   template <class BaseClass>
   class WithGenericMethod_ExecuteOneTimeStep : public BaseClass {
@@ -1679,6 +1821,40 @@ class CarlaAdapter final {
     }
   };
   template <class BaseClass>
+  class WithGenericMethod_ExecuteOneTimeStepBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_ExecuteOneTimeStepBatch() {
+      ::grpc::Service::MarkMethodGeneric(18);
+    }
+    ~WithGenericMethod_ExecuteOneTimeStepBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status ExecuteOneTimeStepBatch(::grpc::ServerContext* /*context*/, const ::google::protobuf::Empty* /*request*/, ::carla::TimeStepResult* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
+  class WithGenericMethod_GetActorLDMGeo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithGenericMethod_GetActorLDMGeo() {
+      ::grpc::Service::MarkMethodGeneric(19);
+    }
+    ~WithGenericMethod_GetActorLDMGeo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status GetActorLDMGeo(::grpc::ServerContext* /*context*/, const ::carla::Number* /*request*/, ::carla::CAVObjects* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+  };
+  template <class BaseClass>
   class WithRawMethod_ExecuteOneTimeStep : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -2039,6 +2215,46 @@ class CarlaAdapter final {
     }
   };
   template <class BaseClass>
+  class WithRawMethod_ExecuteOneTimeStepBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_ExecuteOneTimeStepBatch() {
+      ::grpc::Service::MarkMethodRaw(18);
+    }
+    ~WithRawMethod_ExecuteOneTimeStepBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status ExecuteOneTimeStepBatch(::grpc::ServerContext* /*context*/, const ::google::protobuf::Empty* /*request*/, ::carla::TimeStepResult* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestExecuteOneTimeStepBatch(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncResponseWriter< ::grpc::ByteBuffer>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncUnary(18, context, request, response, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
+  class WithRawMethod_GetActorLDMGeo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawMethod_GetActorLDMGeo() {
+      ::grpc::Service::MarkMethodRaw(19);
+    }
+    ~WithRawMethod_GetActorLDMGeo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status GetActorLDMGeo(::grpc::ServerContext* /*context*/, const ::carla::Number* /*request*/, ::carla::CAVObjects* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    void RequestGetActorLDMGeo(::grpc::ServerContext* context, ::grpc::ByteBuffer* request, ::grpc::ServerAsyncResponseWriter< ::grpc::ByteBuffer>* response, ::grpc::CompletionQueue* new_call_cq, ::grpc::ServerCompletionQueue* notification_cq, void *tag) {
+      ::grpc::Service::RequestAsyncUnary(19, context, request, response, new_call_cq, notification_cq, tag);
+    }
+  };
+  template <class BaseClass>
   class WithRawCallbackMethod_ExecuteOneTimeStep : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -2435,6 +2651,50 @@ class CarlaAdapter final {
       ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
   };
   template <class BaseClass>
+  class WithRawCallbackMethod_ExecuteOneTimeStepBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_ExecuteOneTimeStepBatch() {
+      ::grpc::Service::MarkMethodRawCallback(18,
+          new ::grpc::internal::CallbackUnaryHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response) { return this->ExecuteOneTimeStepBatch(context, request, response); }));
+    }
+    ~WithRawCallbackMethod_ExecuteOneTimeStepBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status ExecuteOneTimeStepBatch(::grpc::ServerContext* /*context*/, const ::google::protobuf::Empty* /*request*/, ::carla::TimeStepResult* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerUnaryReactor* ExecuteOneTimeStepBatch(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
+  };
+  template <class BaseClass>
+  class WithRawCallbackMethod_GetActorLDMGeo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithRawCallbackMethod_GetActorLDMGeo() {
+      ::grpc::Service::MarkMethodRawCallback(19,
+          new ::grpc::internal::CallbackUnaryHandler< ::grpc::ByteBuffer, ::grpc::ByteBuffer>(
+            [this](
+                   ::grpc::CallbackServerContext* context, const ::grpc::ByteBuffer* request, ::grpc::ByteBuffer* response) { return this->GetActorLDMGeo(context, request, response); }));
+    }
+    ~WithRawCallbackMethod_GetActorLDMGeo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable synchronous version of this method
+    ::grpc::Status GetActorLDMGeo(::grpc::ServerContext* /*context*/, const ::carla::Number* /*request*/, ::carla::CAVObjects* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    virtual ::grpc::ServerUnaryReactor* GetActorLDMGeo(
+      ::grpc::CallbackServerContext* /*context*/, const ::grpc::ByteBuffer* /*request*/, ::grpc::ByteBuffer* /*response*/)  { return nullptr; }
+  };
+  template <class BaseClass>
   class WithStreamedUnaryMethod_ExecuteOneTimeStep : public BaseClass {
    private:
     void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
@@ -2920,9 +3180,63 @@ class CarlaAdapter final {
     // replace default version of method with streamed unary
     virtual ::grpc::Status StreamedGetGTaccuracy(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::carla::ObjectMinimal,::carla::DoubleValue>* server_unary_streamer) = 0;
   };
-  typedef WithStreamedUnaryMethod_ExecuteOneTimeStep<WithStreamedUnaryMethod_Finish<WithStreamedUnaryMethod_GetManagedActorsIds<WithStreamedUnaryMethod_GetManagedCAVsIds<WithStreamedUnaryMethod_GetManagedActorById<WithStreamedUnaryMethod_InsertVehicle<WithStreamedUnaryMethod_GetRandomSpawnPoint<WithStreamedUnaryMethod_GetActorLDM<WithStreamedUnaryMethod_InsertObject<WithStreamedUnaryMethod_InsertObjects<WithStreamedUnaryMethod_InsertCV<WithStreamedUnaryMethod_GetCartesian<WithStreamedUnaryMethod_GetGeo<WithStreamedUnaryMethod_hasLDM<WithStreamedUnaryMethod_SetControl<WithStreamedUnaryMethod_GetCarlaWaypoint<WithStreamedUnaryMethod_GetNextCarlaWaypoint<WithStreamedUnaryMethod_GetGTaccuracy<Service > > > > > > > > > > > > > > > > > > StreamedUnaryService;
+  template <class BaseClass>
+  class WithStreamedUnaryMethod_ExecuteOneTimeStepBatch : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithStreamedUnaryMethod_ExecuteOneTimeStepBatch() {
+      ::grpc::Service::MarkMethodStreamed(18,
+        new ::grpc::internal::StreamedUnaryHandler<
+          ::google::protobuf::Empty, ::carla::TimeStepResult>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerUnaryStreamer<
+                     ::google::protobuf::Empty, ::carla::TimeStepResult>* streamer) {
+                       return this->StreamedExecuteOneTimeStepBatch(context,
+                         streamer);
+                  }));
+    }
+    ~WithStreamedUnaryMethod_ExecuteOneTimeStepBatch() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status ExecuteOneTimeStepBatch(::grpc::ServerContext* /*context*/, const ::google::protobuf::Empty* /*request*/, ::carla::TimeStepResult* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with streamed unary
+    virtual ::grpc::Status StreamedExecuteOneTimeStepBatch(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::google::protobuf::Empty,::carla::TimeStepResult>* server_unary_streamer) = 0;
+  };
+  template <class BaseClass>
+  class WithStreamedUnaryMethod_GetActorLDMGeo : public BaseClass {
+   private:
+    void BaseClassMustBeDerivedFromService(const Service* /*service*/) {}
+   public:
+    WithStreamedUnaryMethod_GetActorLDMGeo() {
+      ::grpc::Service::MarkMethodStreamed(19,
+        new ::grpc::internal::StreamedUnaryHandler<
+          ::carla::Number, ::carla::CAVObjects>(
+            [this](::grpc::ServerContext* context,
+                   ::grpc::ServerUnaryStreamer<
+                     ::carla::Number, ::carla::CAVObjects>* streamer) {
+                       return this->StreamedGetActorLDMGeo(context,
+                         streamer);
+                  }));
+    }
+    ~WithStreamedUnaryMethod_GetActorLDMGeo() override {
+      BaseClassMustBeDerivedFromService(this);
+    }
+    // disable regular version of this method
+    ::grpc::Status GetActorLDMGeo(::grpc::ServerContext* /*context*/, const ::carla::Number* /*request*/, ::carla::CAVObjects* /*response*/) override {
+      abort();
+      return ::grpc::Status(::grpc::StatusCode::UNIMPLEMENTED, "");
+    }
+    // replace default version of method with streamed unary
+    virtual ::grpc::Status StreamedGetActorLDMGeo(::grpc::ServerContext* context, ::grpc::ServerUnaryStreamer< ::carla::Number,::carla::CAVObjects>* server_unary_streamer) = 0;
+  };
+  typedef WithStreamedUnaryMethod_ExecuteOneTimeStep<WithStreamedUnaryMethod_Finish<WithStreamedUnaryMethod_GetManagedActorsIds<WithStreamedUnaryMethod_GetManagedCAVsIds<WithStreamedUnaryMethod_GetManagedActorById<WithStreamedUnaryMethod_InsertVehicle<WithStreamedUnaryMethod_GetRandomSpawnPoint<WithStreamedUnaryMethod_GetActorLDM<WithStreamedUnaryMethod_InsertObject<WithStreamedUnaryMethod_InsertObjects<WithStreamedUnaryMethod_InsertCV<WithStreamedUnaryMethod_GetCartesian<WithStreamedUnaryMethod_GetGeo<WithStreamedUnaryMethod_hasLDM<WithStreamedUnaryMethod_SetControl<WithStreamedUnaryMethod_GetCarlaWaypoint<WithStreamedUnaryMethod_GetNextCarlaWaypoint<WithStreamedUnaryMethod_GetGTaccuracy<WithStreamedUnaryMethod_ExecuteOneTimeStepBatch<WithStreamedUnaryMethod_GetActorLDMGeo<Service > > > > > > > > > > > > > > > > > > > > StreamedUnaryService;
   typedef Service SplitStreamedService;
-  typedef WithStreamedUnaryMethod_ExecuteOneTimeStep<WithStreamedUnaryMethod_Finish<WithStreamedUnaryMethod_GetManagedActorsIds<WithStreamedUnaryMethod_GetManagedCAVsIds<WithStreamedUnaryMethod_GetManagedActorById<WithStreamedUnaryMethod_InsertVehicle<WithStreamedUnaryMethod_GetRandomSpawnPoint<WithStreamedUnaryMethod_GetActorLDM<WithStreamedUnaryMethod_InsertObject<WithStreamedUnaryMethod_InsertObjects<WithStreamedUnaryMethod_InsertCV<WithStreamedUnaryMethod_GetCartesian<WithStreamedUnaryMethod_GetGeo<WithStreamedUnaryMethod_hasLDM<WithStreamedUnaryMethod_SetControl<WithStreamedUnaryMethod_GetCarlaWaypoint<WithStreamedUnaryMethod_GetNextCarlaWaypoint<WithStreamedUnaryMethod_GetGTaccuracy<Service > > > > > > > > > > > > > > > > > > StreamedService;
+  typedef WithStreamedUnaryMethod_ExecuteOneTimeStep<WithStreamedUnaryMethod_Finish<WithStreamedUnaryMethod_GetManagedActorsIds<WithStreamedUnaryMethod_GetManagedCAVsIds<WithStreamedUnaryMethod_GetManagedActorById<WithStreamedUnaryMethod_InsertVehicle<WithStreamedUnaryMethod_GetRandomSpawnPoint<WithStreamedUnaryMethod_GetActorLDM<WithStreamedUnaryMethod_InsertObject<WithStreamedUnaryMethod_InsertObjects<WithStreamedUnaryMethod_InsertCV<WithStreamedUnaryMethod_GetCartesian<WithStreamedUnaryMethod_GetGeo<WithStreamedUnaryMethod_hasLDM<WithStreamedUnaryMethod_SetControl<WithStreamedUnaryMethod_GetCarlaWaypoint<WithStreamedUnaryMethod_GetNextCarlaWaypoint<WithStreamedUnaryMethod_GetGTaccuracy<WithStreamedUnaryMethod_ExecuteOneTimeStepBatch<WithStreamedUnaryMethod_GetActorLDMGeo<Service > > > > > > > > > > > > > > > > > > > > StreamedService;
 };
 
 }  // namespace carla
@@ -354,8 +354,71 @@ struct ObjectInDefaultTypeInternal {
 
 PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
     PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 ObjectInDefaultTypeInternal _ObjectIn_default_instance_;
+
+inline constexpr DetectedObject::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : _cached_size_{0},
+        object_{nullptr},
+        latitude_{0},
+        longitude_{0},
+        gtaccuracy_{0} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR DetectedObject::DetectedObject(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct DetectedObjectDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR DetectedObjectDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~DetectedObjectDefaultTypeInternal() {}
+  union {
+    DetectedObject _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 DetectedObjectDefaultTypeInternal _DetectedObject_default_instance_;
+
+inline constexpr CAVObjects::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : objects_{},
+        egoid_{0},
+        _cached_size_{0} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR CAVObjects::CAVObjects(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct CAVObjectsDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR CAVObjectsDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~CAVObjectsDefaultTypeInternal() {}
+  union {
+    CAVObjects _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 CAVObjectsDefaultTypeInternal _CAVObjects_default_instance_;
+
+inline constexpr TimeStepResult::Impl_::Impl_(
+    ::_pbi::ConstantInitialized) noexcept
+      : actors_{},
+        cavobjects_{},
+        value_{false},
+        _cached_size_{0} {}
+
+template <typename>
+PROTOBUF_CONSTEXPR TimeStepResult::TimeStepResult(::_pbi::ConstantInitialized)
+    : _impl_(::_pbi::ConstantInitialized()) {}
+struct TimeStepResultDefaultTypeInternal {
+  PROTOBUF_CONSTEXPR TimeStepResultDefaultTypeInternal() : _instance(::_pbi::ConstantInitialized{}) {}
+  ~TimeStepResultDefaultTypeInternal() {}
+  union {
+    TimeStepResult _instance;
+  };
+};
+
+PROTOBUF_ATTRIBUTE_NO_DESTROY PROTOBUF_CONSTINIT
+    PROTOBUF_ATTRIBUTE_INIT_PRIORITY1 TimeStepResultDefaultTypeInternal _TimeStepResult_default_instance_;
 }  // namespace carla
-static ::_pb::Metadata file_level_metadata_carla_2eproto[15];
+static ::_pb::Metadata file_level_metadata_carla_2eproto[18];
 static constexpr const ::_pb::EnumDescriptor**
     file_level_enum_descriptors_carla_2eproto = nullptr;
 static constexpr const ::_pb::ServiceDescriptor**
@@ -592,6 +655,43 @@ const ::uint32_t TableStruct_carla_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(
     ~0u,  // no _split_
     ~0u,  // no sizeof(Split)
     PROTOBUF_FIELD_OFFSET(::carla::DoubleValue, _impl_.value_),
+    PROTOBUF_FIELD_OFFSET(::carla::DetectedObject, _impl_._has_bits_),
+    PROTOBUF_FIELD_OFFSET(::carla::DetectedObject, _internal_metadata_),
+    ~0u,  // no _extensions_
+    ~0u,  // no _oneof_case_
+    ~0u,  // no _weak_field_map_
+    ~0u,  // no _inlined_string_donated_
+    ~0u,  // no _split_
+    ~0u,  // no sizeof(Split)
+    PROTOBUF_FIELD_OFFSET(::carla::DetectedObject, _impl_.object_),
+    PROTOBUF_FIELD_OFFSET(::carla::DetectedObject, _impl_.latitude_),
+    PROTOBUF_FIELD_OFFSET(::carla::DetectedObject, _impl_.longitude_),
+    PROTOBUF_FIELD_OFFSET(::carla::DetectedObject, _impl_.gtaccuracy_),
+    0,
+    ~0u,
+    ~0u,
+    ~0u,
+    ~0u,  // no _has_bits_
+    PROTOBUF_FIELD_OFFSET(::carla::CAVObjects, _internal_metadata_),
+    ~0u,  // no _extensions_
+    ~0u,  // no _oneof_case_
+    ~0u,  // no _weak_field_map_
+    ~0u,  // no _inlined_string_donated_
+    ~0u,  // no _split_
+    ~0u,  // no sizeof(Split)
+    PROTOBUF_FIELD_OFFSET(::carla::CAVObjects, _impl_.egoid_),
+    PROTOBUF_FIELD_OFFSET(::carla::CAVObjects, _impl_.objects_),
+    ~0u,  // no _has_bits_
+    PROTOBUF_FIELD_OFFSET(::carla::TimeStepResult, _internal_metadata_),
+    ~0u,  // no _extensions_
+    ~0u,  // no _oneof_case_
+    ~0u,  // no _weak_field_map_
+    ~0u,  // no _inlined_string_donated_
+    ~0u,  // no _split_
+    ~0u,  // no sizeof(Split)
+    PROTOBUF_FIELD_OFFSET(::carla::TimeStepResult, _impl_.value_),
+    PROTOBUF_FIELD_OFFSET(::carla::TimeStepResult, _impl_.actors_),
+    PROTOBUF_FIELD_OFFSET(::carla::TimeStepResult, _impl_.cavobjects_),
 };
 
 static const ::_pbi::MigrationSchema
@@ -611,6 +711,9 @@ static const ::_pbi::MigrationSchema
         {179, 196, -1, sizeof(::carla::Waypoint)},
         {205, 217, -1, sizeof(::carla::ObjectMinimal)},
         {221, -1, -1, sizeof(::carla::DoubleValue)},
+        {230, 242, -1, sizeof(::carla::DetectedObject)},
+        {246, -1, -1, sizeof(::carla::CAVObjects)},
+        {256, -1, -1, sizeof(::carla::TimeStepResult)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
@@ -629,6 +732,9 @@ static const ::_pb::Message* const file_default_instances[] = {
     &::carla::_Waypoint_default_instance_._instance,
     &::carla::_ObjectMinimal_default_instance_._instance,
     &::carla::_DoubleValue_default_instance_._instance,
+    &::carla::_DetectedObject_default_instance_._instance,
+    &::carla::_CAVObjects_default_instance_._instance,
+    &::carla::_TimeStepResult_default_instance_._instance,
 };
 const char descriptor_table_protodef_carla_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
     "\n\013carla.proto\022\005carla\032\033google/protobuf/em"
@@ -668,32 +774,42 @@ const char descriptor_table_protodef_carla_2eproto[] PROTOBUF_SECTION_VARIABLE(p
     "\n\013lane_change\030\n \001(\005\"_\n\rObjectMinimal\022\n\n\002"
     "id\030\001 \001(\005\022#\n\ttransform\030\002 \001(\0132\020.carla.Tran"
     "sform\022\016\n\006length\030\003 \001(\001\022\r\n\005width\030\004 \001(\001\"\034\n\013"
-    "DoubleValue\022\r\n\005value\030\001 \001(\0012\315\007\n\014CarlaAdap"
-    "ter\022<\n\022ExecuteOneTimeStep\022\026.google.proto"
-    "buf.Empty\032\016.carla.Boolean\0228\n\006Finish\022\026.go"
-    "ogle.protobuf.Empty\032\026.google.protobuf.Em"
-    "pty\022>\n\023GetManagedActorsIds\022\026.google.prot"
-    "obuf.Empty\032\017.carla.ActorIds\022<\n\021GetManage"
-    "dCAVsIds\022\026.google.protobuf.Empty\032\017.carla"
-    ".ActorIds\0224\n\023GetManagedActorById\022\r.carla"
-    ".Number\032\016.carla.Vehicle\022.\n\rInsertVehicle"
-    "\022\016.carla.Vehicle\032\r.carla.Number\022\?\n\023GetRa"
-    "ndomSpawnPoint\022\026.google.protobuf.Empty\032\020"
-    ".carla.Transform\022,\n\013GetActorLDM\022\r.carla."
-    "Number\032\016.carla.Objects\022.\n\014InsertObject\022\017"
-    ".carla.ObjectIn\032\r.carla.Number\0225\n\rInsert"
-    "Objects\022\020.carla.ObjectsIn\032\022.carla.Double"
-    "Value\022/\n\010InsertCV\022\017.carla.ObjectIn\032\022.car"
-    "la.DoubleValue\022,\n\014GetCartesian\022\r.carla.V"
-    "ector\032\r.carla.Vector\022&\n\006GetGeo\022\r.carla.V"
-    "ector\032\r.carla.Vector\022\'\n\006hasLDM\022\r.carla.N"
-    "umber\032\016.carla.Boolean\0224\n\nSetControl\022\016.ca"
-    "rla.Control\032\026.google.protobuf.Empty\0222\n\020G"
-    "etCarlaWaypoint\022\r.carla.Vector\032\017.carla.W"
-    "aypoint\0226\n\024GetNextCarlaWaypoint\022\r.carla."
-    "Vector\032\017.carla.Waypoint\0229\n\rGetGTaccuracy"
-    "\022\024.carla.ObjectMinimal\032\022.carla.DoubleVal"
-    "ueb\006proto3"
+    "DoubleValue\022\r\n\005value\030\001 \001(\001\"h\n\016DetectedOb"
+    "ject\022\035\n\006object\030\001 \001(\0132\r.carla.Object\022\020\n\010l"
+    "atitude\030\002 \001(\001\022\021\n\tlongitude\030\003 \001(\001\022\022\n\nGTac"
+    "curacy\030\004 \001(\001\"C\n\nCAVObjects\022\r\n\005egoId\030\001 \001("
+    "\005\022&\n\007objects\030\002 \003(\0132\025.carla.DetectedObjec"
+    "t\"f\n\016TimeStepResult\022\r\n\005value\030\001 \001(\010\022\036\n\006ac"
+    "tors\030\002 \003(\0132\016.carla.Vehicle\022%\n\ncavObjects"
+    "\030\003 \003(\0132\021.carla.CAVObjects2\313\010\n\014CarlaAdapt"
+    "er\022<\n\022ExecuteOneTimeStep\022\026.google.protob"
+    "uf.Empty\032\016.carla.Boolean\0228\n\006Finish\022\026.goo"
+    "gle.protobuf.Empty\032\026.google.protobuf.Emp"
+    "ty\022>\n\023GetManagedActorsIds\022\026.google.proto"
+    "buf.Empty\032\017.carla.ActorIds\022<\n\021GetManaged"
+    "CAVsIds\022\026.google.protobuf.Empty\032\017.carla."
+    "ActorIds\0224\n\023GetManagedActorById\022\r.carla."
+    "Number\032\016.carla.Vehicle\022.\n\rInsertVehicle\022"
+    "\016.carla.Vehicle\032\r.carla.Number\022\?\n\023GetRan"
+    "domSpawnPoint\022\026.google.protobuf.Empty\032\020."
+    "carla.Transform\022,\n\013GetActorLDM\022\r.carla.N"
+    "umber\032\016.carla.Objects\022.\n\014InsertObject\022\017."
+    "carla.ObjectIn\032\r.carla.Number\0225\n\rInsertO"
+    "bjects\022\020.carla.ObjectsIn\032\022.carla.DoubleV"
+    "alue\022/\n\010InsertCV\022\017.carla.ObjectIn\032\022.carl"
+    "a.DoubleValue\022,\n\014GetCartesian\022\r.carla.Ve"
+    "ctor\032\r.carla.Vector\022&\n\006GetGeo\022\r.carla.Ve"
+    "ctor\032\r.carla.Vector\022\'\n\006hasLDM\022\r.carla.Nu"
+    "mber\032\016.carla.Boolean\0224\n\nSetControl\022\016.car"
+    "la.Control\032\026.google.protobuf.Empty\0222\n\020Ge"
+    "tCarlaWaypoint\022\r.carla.Vector\032\017.carla.Wa"
+    "ypoint\0226\n\024GetNextCarlaWaypoint\022\r.carla.V"
+    "ector\032\017.carla.Waypoint\0229\n\rGetGTaccuracy\022"
+    "\024.carla.ObjectMinimal\032\022.carla.DoubleValu"
+    "e\022H\n\027ExecuteOneTimeStepBatch\022\026.google.pr"
+    "otobuf.Empty\032\025.carla.TimeStepResult\0222\n\016G"
+    "etActorLDMGeo\022\r.carla.Number\032\021.carla.CAV"
+    "Objectsb\006proto3"
 };
 static const ::_pbi::DescriptorTable* const descriptor_table_carla_2eproto_deps[1] =
     {
@@ -703,13 +819,13 @@ static ::absl::once_flag descriptor_table_carla_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_carla_2eproto = {
     false,
     false,
-    2490,
+    2895,
     descriptor_table_protodef_carla_2eproto,
     "carla.proto",
     &descriptor_table_carla_2eproto_once,
     descriptor_table_carla_2eproto_deps,
     1,
-    15,
+    18,
     schemas,
     file_default_instances,
     TableStruct_carla_2eproto::offsets,
@@ -5284,6 +5400,786 @@ void DoubleValue::InternalSwap(DoubleValue* PROTOBUF_RESTRICT other) {
       &descriptor_table_carla_2eproto_getter, &descriptor_table_carla_2eproto_once,
       file_level_metadata_carla_2eproto[14]);
 }
+// ===================================================================
+
+class DetectedObject::_Internal {
+ public:
+  using HasBits = decltype(std::declval<DetectedObject>()._impl_._has_bits_);
+  static constexpr ::int32_t kHasBitsOffset =
+    8 * PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_._has_bits_);
+  static const ::carla::Object& object(const DetectedObject* msg);
+  static void set_has_object(HasBits* has_bits) {
+    (*has_bits)[0] |= 1u;
+  }
+};
+
+const ::carla::Object& DetectedObject::_Internal::object(const DetectedObject* msg) {
+  return *msg->_impl_.object_;
+}
+DetectedObject::DetectedObject(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:carla.DetectedObject)
+}
+inline PROTOBUF_NDEBUG_INLINE DetectedObject::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from)
+      : _has_bits_{from._has_bits_},
+        _cached_size_{0} {}
+
+DetectedObject::DetectedObject(
+    ::google::protobuf::Arena* arena,
+    const DetectedObject& from)
+    : ::google::protobuf::Message(arena) {
+  DetectedObject* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_);
+  ::uint32_t cached_has_bits = _impl_._has_bits_[0];
+  _impl_.object_ = (cached_has_bits & 0x00000001u)
+                ? CreateMaybeMessage<::carla::Object>(arena, *from._impl_.object_)
+                : nullptr;
+  ::memcpy(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, latitude_),
+           reinterpret_cast<const char *>(&from._impl_) +
+               offsetof(Impl_, latitude_),
+           offsetof(Impl_, gtaccuracy_) -
+               offsetof(Impl_, latitude_) +
+               sizeof(Impl_::gtaccuracy_));
+
+  // @@protoc_insertion_point(copy_constructor:carla.DetectedObject)
+}
+inline PROTOBUF_NDEBUG_INLINE DetectedObject::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : _cached_size_{0} {}
+
+inline void DetectedObject::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+  ::memset(reinterpret_cast<char *>(&_impl_) +
+               offsetof(Impl_, object_),
+           0,
+           offsetof(Impl_, gtaccuracy_) -
+               offsetof(Impl_, object_) +
+               sizeof(Impl_::gtaccuracy_));
+}
+DetectedObject::~DetectedObject() {
+  // @@protoc_insertion_point(destructor:carla.DetectedObject)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void DetectedObject::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  delete _impl_.object_;
+  _impl_.~Impl_();
+}
+
+PROTOBUF_NOINLINE void DetectedObject::Clear() {
+// @@protoc_insertion_point(message_clear_start:carla.DetectedObject)
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    ABSL_DCHECK(_impl_.object_ != nullptr);
+    _impl_.object_->Clear();
+  }
+  ::memset(&_impl_.latitude_, 0, static_cast<::size_t>(
+      reinterpret_cast<char*>(&_impl_.gtaccuracy_) -
+      reinterpret_cast<char*>(&_impl_.latitude_)) + sizeof(_impl_.gtaccuracy_));
+  _impl_._has_bits_.Clear();
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+const char* DetectedObject::_InternalParse(
+    const char* ptr, ::_pbi::ParseContext* ctx) {
+  ptr = ::_pbi::TcParser::ParseLoop(this, ptr, ctx, &_table_.header);
+  return ptr;
+}
+
+
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<2, 4, 1, 0, 2> DetectedObject::_table_ = {
+  {
+    PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_._has_bits_),
+    0, // no _extensions_
+    4, 24,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967280,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    4,  // num_field_entries
+    1,  // num_aux_entries
+    offsetof(decltype(_table_), aux_entries),
+    &_DetectedObject_default_instance_._instance,
+    ::_pbi::TcParser::GenericFallback,  // fallback
+  }, {{
+    // double GTaccuracy = 4;
+    {::_pbi::TcParser::FastF64S1,
+     {33, 63, 0, PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_.gtaccuracy_)}},
+    // .carla.Object object = 1;
+    {::_pbi::TcParser::FastMtS1,
+     {10, 0, 0, PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_.object_)}},
+    // double latitude = 2;
+    {::_pbi::TcParser::FastF64S1,
+     {17, 63, 0, PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_.latitude_)}},
+    // double longitude = 3;
+    {::_pbi::TcParser::FastF64S1,
+     {25, 63, 0, PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_.longitude_)}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // .carla.Object object = 1;
+    {PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_.object_), _Internal::kHasBitsOffset + 0, 0,
+    (0 | ::_fl::kFcOptional | ::_fl::kMessage | ::_fl::kTvTable)},
+    // double latitude = 2;
+    {PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_.latitude_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kDouble)},
+    // double longitude = 3;
+    {PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_.longitude_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kDouble)},
+    // double GTaccuracy = 4;
+    {PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_.gtaccuracy_), -1, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kDouble)},
+  }}, {{
+    {::_pbi::TcParser::GetTable<::carla::Object>()},
+  }}, {{
+  }},
+};
+
+::uint8_t* DetectedObject::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:carla.DetectedObject)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  cached_has_bits = _impl_._has_bits_[0];
+  // .carla.Object object = 1;
+  if (cached_has_bits & 0x00000001u) {
+    target = ::google::protobuf::internal::WireFormatLite::InternalWriteMessage(
+        1, _Internal::object(this),
+        _Internal::object(this).GetCachedSize(), target, stream);
+  }
+
+  // double latitude = 2;
+  static_assert(sizeof(::uint64_t) == sizeof(double),
+                "Code assumes ::uint64_t and double are the same size.");
+  double tmp_latitude = this->_internal_latitude();
+  ::uint64_t raw_latitude;
+  memcpy(&raw_latitude, &tmp_latitude, sizeof(tmp_latitude));
+  if (raw_latitude != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(
+        2, this->_internal_latitude(), target);
+  }
+
+  // double longitude = 3;
+  static_assert(sizeof(::uint64_t) == sizeof(double),
+                "Code assumes ::uint64_t and double are the same size.");
+  double tmp_longitude = this->_internal_longitude();
+  ::uint64_t raw_longitude;
+  memcpy(&raw_longitude, &tmp_longitude, sizeof(tmp_longitude));
+  if (raw_longitude != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(
+        3, this->_internal_longitude(), target);
+  }
+
+  // double GTaccuracy = 4;
+  static_assert(sizeof(::uint64_t) == sizeof(double),
+                "Code assumes ::uint64_t and double are the same size.");
+  double tmp_gtaccuracy = this->_internal_gtaccuracy();
+  ::uint64_t raw_gtaccuracy;
+  memcpy(&raw_gtaccuracy, &tmp_gtaccuracy, sizeof(tmp_gtaccuracy));
+  if (raw_gtaccuracy != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteDoubleToArray(
+        4, this->_internal_gtaccuracy(), target);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:carla.DetectedObject)
+  return target;
+}
+
+::size_t DetectedObject::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:carla.DetectedObject)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // .carla.Object object = 1;
+  cached_has_bits = _impl_._has_bits_[0];
+  if (cached_has_bits & 0x00000001u) {
+    total_size +=
+        1 + ::google::protobuf::internal::WireFormatLite::MessageSize(*_impl_.object_);
+  }
+
+  // double latitude = 2;
+  static_assert(sizeof(::uint64_t) == sizeof(double),
+                "Code assumes ::uint64_t and double are the same size.");
+  double tmp_latitude = this->_internal_latitude();
+  ::uint64_t raw_latitude;
+  memcpy(&raw_latitude, &tmp_latitude, sizeof(tmp_latitude));
+  if (raw_latitude != 0) {
+    total_size += 9;
+  }
+
+  // double longitude = 3;
+  static_assert(sizeof(::uint64_t) == sizeof(double),
+                "Code assumes ::uint64_t and double are the same size.");
+  double tmp_longitude = this->_internal_longitude();
+  ::uint64_t raw_longitude;
+  memcpy(&raw_longitude, &tmp_longitude, sizeof(tmp_longitude));
+  if (raw_longitude != 0) {
+    total_size += 9;
+  }
+
+  // double GTaccuracy = 4;
+  static_assert(sizeof(::uint64_t) == sizeof(double),
+                "Code assumes ::uint64_t and double are the same size.");
+  double tmp_gtaccuracy = this->_internal_gtaccuracy();
+  ::uint64_t raw_gtaccuracy;
+  memcpy(&raw_gtaccuracy, &tmp_gtaccuracy, sizeof(tmp_gtaccuracy));
+  if (raw_gtaccuracy != 0) {
+    total_size += 9;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::google::protobuf::Message::ClassData DetectedObject::_class_data_ = {
+    DetectedObject::MergeImpl,
+    nullptr,  // OnDemandRegisterArenaDtor
+};
+const ::google::protobuf::Message::ClassData* DetectedObject::GetClassData() const {
+  return &_class_data_;
+}
+
+void DetectedObject::MergeImpl(::google::protobuf::Message& to_msg, const ::google::protobuf::Message& from_msg) {
+  auto* const _this = static_cast<DetectedObject*>(&to_msg);
+  auto& from = static_cast<const DetectedObject&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:carla.DetectedObject)
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  if ((from._impl_._has_bits_[0] & 0x00000001u) != 0) {
+    _this->_internal_mutable_object()->::carla::Object::MergeFrom(
+        from._internal_object());
+  }
+  static_assert(sizeof(::uint64_t) == sizeof(double),
+                "Code assumes ::uint64_t and double are the same size.");
+  double tmp_latitude = from._internal_latitude();
+  ::uint64_t raw_latitude;
+  memcpy(&raw_latitude, &tmp_latitude, sizeof(tmp_latitude));
+  if (raw_latitude != 0) {
+    _this->_internal_set_latitude(from._internal_latitude());
+  }
+  static_assert(sizeof(::uint64_t) == sizeof(double),
+                "Code assumes ::uint64_t and double are the same size.");
+  double tmp_longitude = from._internal_longitude();
+  ::uint64_t raw_longitude;
+  memcpy(&raw_longitude, &tmp_longitude, sizeof(tmp_longitude));
+  if (raw_longitude != 0) {
+    _this->_internal_set_longitude(from._internal_longitude());
+  }
+  static_assert(sizeof(::uint64_t) == sizeof(double),
+                "Code assumes ::uint64_t and double are the same size.");
+  double tmp_gtaccuracy = from._internal_gtaccuracy();
+  ::uint64_t raw_gtaccuracy;
+  memcpy(&raw_gtaccuracy, &tmp_gtaccuracy, sizeof(tmp_gtaccuracy));
+  if (raw_gtaccuracy != 0) {
+    _this->_internal_set_gtaccuracy(from._internal_gtaccuracy());
+  }
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void DetectedObject::CopyFrom(const DetectedObject& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:carla.DetectedObject)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+PROTOBUF_NOINLINE bool DetectedObject::IsInitialized() const {
+  return true;
+}
+
+::_pbi::CachedSize* DetectedObject::AccessCachedSize() const {
+  return &_impl_._cached_size_;
+}
+void DetectedObject::InternalSwap(DetectedObject* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  swap(_impl_._has_bits_[0], other->_impl_._has_bits_[0]);
+  ::google::protobuf::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_.gtaccuracy_)
+      + sizeof(DetectedObject::_impl_.gtaccuracy_)
+      - PROTOBUF_FIELD_OFFSET(DetectedObject, _impl_.object_)>(
+          reinterpret_cast<char*>(&_impl_.object_),
+          reinterpret_cast<char*>(&other->_impl_.object_));
+}
+
+::google::protobuf::Metadata DetectedObject::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_carla_2eproto_getter, &descriptor_table_carla_2eproto_once,
+      file_level_metadata_carla_2eproto[15]);
+}
+// ===================================================================
+
+class CAVObjects::_Internal {
+ public:
+};
+
+CAVObjects::CAVObjects(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:carla.CAVObjects)
+}
+inline PROTOBUF_NDEBUG_INLINE CAVObjects::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from)
+      : objects_{visibility, arena, from.objects_},
+        _cached_size_{0} {}
+
+CAVObjects::CAVObjects(
+    ::google::protobuf::Arena* arena,
+    const CAVObjects& from)
+    : ::google::protobuf::Message(arena) {
+  CAVObjects* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_);
+  _impl_.egoid_ = from._impl_.egoid_;
+
+  // @@protoc_insertion_point(copy_constructor:carla.CAVObjects)
+}
+inline PROTOBUF_NDEBUG_INLINE CAVObjects::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : objects_{visibility, arena},
+        _cached_size_{0} {}
+
+inline void CAVObjects::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+  _impl_.egoid_ = {};
+}
+CAVObjects::~CAVObjects() {
+  // @@protoc_insertion_point(destructor:carla.CAVObjects)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void CAVObjects::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  _impl_.~Impl_();
+}
+
+PROTOBUF_NOINLINE void CAVObjects::Clear() {
+// @@protoc_insertion_point(message_clear_start:carla.CAVObjects)
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.objects_.Clear();
+  _impl_.egoid_ = 0;
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+const char* CAVObjects::_InternalParse(
+    const char* ptr, ::_pbi::ParseContext* ctx) {
+  ptr = ::_pbi::TcParser::ParseLoop(this, ptr, ctx, &_table_.header);
+  return ptr;
+}
+
+
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<1, 2, 1, 0, 2> CAVObjects::_table_ = {
+  {
+    0,  // no _has_bits_
+    0, // no _extensions_
+    2, 8,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967292,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    2,  // num_field_entries
+    1,  // num_aux_entries
+    offsetof(decltype(_table_), aux_entries),
+    &_CAVObjects_default_instance_._instance,
+    ::_pbi::TcParser::GenericFallback,  // fallback
+  }, {{
+    // repeated .carla.DetectedObject objects = 2;
+    {::_pbi::TcParser::FastMtR1,
+     {18, 63, 0, PROTOBUF_FIELD_OFFSET(CAVObjects, _impl_.objects_)}},
+    // int32 egoId = 1;
+    {::_pbi::TcParser::SingularVarintNoZag1<::uint32_t, offsetof(CAVObjects, _impl_.egoid_), 63>(),
+     {8, 63, 0, PROTOBUF_FIELD_OFFSET(CAVObjects, _impl_.egoid_)}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // int32 egoId = 1;
+    {PROTOBUF_FIELD_OFFSET(CAVObjects, _impl_.egoid_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kInt32)},
+    // repeated .carla.DetectedObject objects = 2;
+    {PROTOBUF_FIELD_OFFSET(CAVObjects, _impl_.objects_), 0, 0,
+    (0 | ::_fl::kFcRepeated | ::_fl::kMessage | ::_fl::kTvTable)},
+  }}, {{
+    {::_pbi::TcParser::GetTable<::carla::DetectedObject>()},
+  }}, {{
+  }},
+};
+
+::uint8_t* CAVObjects::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:carla.CAVObjects)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  // int32 egoId = 1;
+  if (this->_internal_egoid() != 0) {
+    target = ::google::protobuf::internal::WireFormatLite::
+        WriteInt32ToArrayWithField<1>(
+            stream, this->_internal_egoid(), target);
+  }
+
+  // repeated .carla.DetectedObject objects = 2;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_objects_size()); i < n; i++) {
+    const auto& repfield = this->_internal_objects().Get(i);
+    target = ::google::protobuf::internal::WireFormatLite::
+        InternalWriteMessage(2, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:carla.CAVObjects)
+  return target;
+}
+
+::size_t CAVObjects::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:carla.CAVObjects)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .carla.DetectedObject objects = 2;
+  total_size += 1UL * this->_internal_objects_size();
+  for (const auto& msg : this->_internal_objects()) {
+    total_size +=
+      ::google::protobuf::internal::WireFormatLite::MessageSize(msg);
+  }
+  // int32 egoId = 1;
+  if (this->_internal_egoid() != 0) {
+    total_size += ::_pbi::WireFormatLite::Int32SizePlusOne(
+        this->_internal_egoid());
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::google::protobuf::Message::ClassData CAVObjects::_class_data_ = {
+    CAVObjects::MergeImpl,
+    nullptr,  // OnDemandRegisterArenaDtor
+};
+const ::google::protobuf::Message::ClassData* CAVObjects::GetClassData() const {
+  return &_class_data_;
+}
+
+void CAVObjects::MergeImpl(::google::protobuf::Message& to_msg, const ::google::protobuf::Message& from_msg) {
+  auto* const _this = static_cast<CAVObjects*>(&to_msg);
+  auto& from = static_cast<const CAVObjects&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:carla.CAVObjects)
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_internal_mutable_objects()->MergeFrom(
+      from._internal_objects());
+  if (from._internal_egoid() != 0) {
+    _this->_internal_set_egoid(from._internal_egoid());
+  }
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void CAVObjects::CopyFrom(const CAVObjects& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:carla.CAVObjects)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+PROTOBUF_NOINLINE bool CAVObjects::IsInitialized() const {
+  return true;
+}
+
+::_pbi::CachedSize* CAVObjects::AccessCachedSize() const {
+  return &_impl_._cached_size_;
+}
+void CAVObjects::InternalSwap(CAVObjects* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.objects_.InternalSwap(&other->_impl_.objects_);
+        swap(_impl_.egoid_, other->_impl_.egoid_);
+}
+
+::google::protobuf::Metadata CAVObjects::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_carla_2eproto_getter, &descriptor_table_carla_2eproto_once,
+      file_level_metadata_carla_2eproto[16]);
+}
+// ===================================================================
+
+class TimeStepResult::_Internal {
+ public:
+};
+
+TimeStepResult::TimeStepResult(::google::protobuf::Arena* arena)
+    : ::google::protobuf::Message(arena) {
+  SharedCtor(arena);
+  // @@protoc_insertion_point(arena_constructor:carla.TimeStepResult)
+}
+inline PROTOBUF_NDEBUG_INLINE TimeStepResult::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility, ::google::protobuf::Arena* arena,
+    const Impl_& from)
+      : actors_{visibility, arena, from.actors_},
+        cavobjects_{visibility, arena, from.cavobjects_},
+        _cached_size_{0} {}
+
+TimeStepResult::TimeStepResult(
+    ::google::protobuf::Arena* arena,
+    const TimeStepResult& from)
+    : ::google::protobuf::Message(arena) {
+  TimeStepResult* const _this = this;
+  (void)_this;
+  _internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(
+      from._internal_metadata_);
+  new (&_impl_) Impl_(internal_visibility(), arena, from._impl_);
+  _impl_.value_ = from._impl_.value_;
+
+  // @@protoc_insertion_point(copy_constructor:carla.TimeStepResult)
+}
+inline PROTOBUF_NDEBUG_INLINE TimeStepResult::Impl_::Impl_(
+    ::google::protobuf::internal::InternalVisibility visibility,
+    ::google::protobuf::Arena* arena)
+      : actors_{visibility, arena},
+        cavobjects_{visibility, arena},
+        _cached_size_{0} {}
+
+inline void TimeStepResult::SharedCtor(::_pb::Arena* arena) {
+  new (&_impl_) Impl_(internal_visibility(), arena);
+  _impl_.value_ = {};
+}
+TimeStepResult::~TimeStepResult() {
+  // @@protoc_insertion_point(destructor:carla.TimeStepResult)
+  _internal_metadata_.Delete<::google::protobuf::UnknownFieldSet>();
+  SharedDtor();
+}
+inline void TimeStepResult::SharedDtor() {
+  ABSL_DCHECK(GetArena() == nullptr);
+  _impl_.~Impl_();
+}
+
+PROTOBUF_NOINLINE void TimeStepResult::Clear() {
+// @@protoc_insertion_point(message_clear_start:carla.TimeStepResult)
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  _impl_.actors_.Clear();
+  _impl_.cavobjects_.Clear();
+  _impl_.value_ = false;
+  _internal_metadata_.Clear<::google::protobuf::UnknownFieldSet>();
+}
+
+const char* TimeStepResult::_InternalParse(
+    const char* ptr, ::_pbi::ParseContext* ctx) {
+  ptr = ::_pbi::TcParser::ParseLoop(this, ptr, ctx, &_table_.header);
+  return ptr;
+}
+
+
+PROTOBUF_CONSTINIT PROTOBUF_ATTRIBUTE_INIT_PRIORITY1
+const ::_pbi::TcParseTable<2, 3, 2, 0, 2> TimeStepResult::_table_ = {
+  {
+    0,  // no _has_bits_
+    0, // no _extensions_
+    3, 24,  // max_field_number, fast_idx_mask
+    offsetof(decltype(_table_), field_lookup_table),
+    4294967288,  // skipmap
+    offsetof(decltype(_table_), field_entries),
+    3,  // num_field_entries
+    2,  // num_aux_entries
+    offsetof(decltype(_table_), aux_entries),
+    &_TimeStepResult_default_instance_._instance,
+    ::_pbi::TcParser::GenericFallback,  // fallback
+  }, {{
+    {::_pbi::TcParser::MiniParse, {}},
+    // bool value = 1;
+    {::_pbi::TcParser::SingularVarintNoZag1<bool, offsetof(TimeStepResult, _impl_.value_), 63>(),
+     {8, 63, 0, PROTOBUF_FIELD_OFFSET(TimeStepResult, _impl_.value_)}},
+    // repeated .carla.Vehicle actors = 2;
+    {::_pbi::TcParser::FastMtR1,
+     {18, 63, 0, PROTOBUF_FIELD_OFFSET(TimeStepResult, _impl_.actors_)}},
+    // repeated .carla.CAVObjects cavObjects = 3;
+    {::_pbi::TcParser::FastMtR1,
+     {26, 63, 1, PROTOBUF_FIELD_OFFSET(TimeStepResult, _impl_.cavobjects_)}},
+  }}, {{
+    65535, 65535
+  }}, {{
+    // bool value = 1;
+    {PROTOBUF_FIELD_OFFSET(TimeStepResult, _impl_.value_), 0, 0,
+    (0 | ::_fl::kFcSingular | ::_fl::kBool)},
+    // repeated .carla.Vehicle actors = 2;
+    {PROTOBUF_FIELD_OFFSET(TimeStepResult, _impl_.actors_), 0, 0,
+    (0 | ::_fl::kFcRepeated | ::_fl::kMessage | ::_fl::kTvTable)},
+    // repeated .carla.CAVObjects cavObjects = 3;
+    {PROTOBUF_FIELD_OFFSET(TimeStepResult, _impl_.cavobjects_), 0, 1,
+    (0 | ::_fl::kFcRepeated | ::_fl::kMessage | ::_fl::kTvTable)},
+  }}, {{
+    {::_pbi::TcParser::GetTable<::carla::Vehicle>()},
+    {::_pbi::TcParser::GetTable<::carla::CAVObjects>()},
+  }}, {{
+  }},
+};
+
+::uint8_t* TimeStepResult::_InternalSerialize(
+    ::uint8_t* target,
+    ::google::protobuf::io::EpsCopyOutputStream* stream) const {
+  // @@protoc_insertion_point(serialize_to_array_start:carla.TimeStepResult)
+  ::uint32_t cached_has_bits = 0;
+  (void)cached_has_bits;
+
+  // bool value = 1;
+  if (this->_internal_value() != 0) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteBoolToArray(
+        1, this->_internal_value(), target);
+  }
+
+  // repeated .carla.Vehicle actors = 2;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_actors_size()); i < n; i++) {
+    const auto& repfield = this->_internal_actors().Get(i);
+    target = ::google::protobuf::internal::WireFormatLite::
+        InternalWriteMessage(2, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  // repeated .carla.CAVObjects cavObjects = 3;
+  for (unsigned i = 0,
+      n = static_cast<unsigned>(this->_internal_cavobjects_size()); i < n; i++) {
+    const auto& repfield = this->_internal_cavobjects().Get(i);
+    target = ::google::protobuf::internal::WireFormatLite::
+        InternalWriteMessage(3, repfield, repfield.GetCachedSize(), target, stream);
+  }
+
+  if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
+    target =
+        ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
+            _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance), target, stream);
+  }
+  // @@protoc_insertion_point(serialize_to_array_end:carla.TimeStepResult)
+  return target;
+}
+
+::size_t TimeStepResult::ByteSizeLong() const {
+// @@protoc_insertion_point(message_byte_size_start:carla.TimeStepResult)
+  ::size_t total_size = 0;
+
+  ::uint32_t cached_has_bits = 0;
+  // Prevent compiler warnings about cached_has_bits being unused
+  (void) cached_has_bits;
+
+  // repeated .carla.Vehicle actors = 2;
+  total_size += 1UL * this->_internal_actors_size();
+  for (const auto& msg : this->_internal_actors()) {
+    total_size +=
+      ::google::protobuf::internal::WireFormatLite::MessageSize(msg);
+  }
+  // repeated .carla.CAVObjects cavObjects = 3;
+  total_size += 1UL * this->_internal_cavobjects_size();
+  for (const auto& msg : this->_internal_cavobjects()) {
+    total_size +=
+      ::google::protobuf::internal::WireFormatLite::MessageSize(msg);
+  }
+  // bool value = 1;
+  if (this->_internal_value() != 0) {
+    total_size += 2;
+  }
+
+  return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
+}
+
+const ::google::protobuf::Message::ClassData TimeStepResult::_class_data_ = {
+    TimeStepResult::MergeImpl,
+    nullptr,  // OnDemandRegisterArenaDtor
+};
+const ::google::protobuf::Message::ClassData* TimeStepResult::GetClassData() const {
+  return &_class_data_;
+}
+
+void TimeStepResult::MergeImpl(::google::protobuf::Message& to_msg, const ::google::protobuf::Message& from_msg) {
+  auto* const _this = static_cast<TimeStepResult*>(&to_msg);
+  auto& from = static_cast<const TimeStepResult&>(from_msg);
+  // @@protoc_insertion_point(class_specific_merge_from_start:carla.TimeStepResult)
+  ABSL_DCHECK_NE(&from, _this);
+  ::uint32_t cached_has_bits = 0;
+  (void) cached_has_bits;
+
+  _this->_internal_mutable_actors()->MergeFrom(
+      from._internal_actors());
+  _this->_internal_mutable_cavobjects()->MergeFrom(
+      from._internal_cavobjects());
+  if (from._internal_value() != 0) {
+    _this->_internal_set_value(from._internal_value());
+  }
+  _this->_internal_metadata_.MergeFrom<::google::protobuf::UnknownFieldSet>(from._internal_metadata_);
+}
+
+void TimeStepResult::CopyFrom(const TimeStepResult& from) {
+// @@protoc_insertion_point(class_specific_copy_from_start:carla.TimeStepResult)
+  if (&from == this) return;
+  Clear();
+  MergeFrom(from);
+}
+
+PROTOBUF_NOINLINE bool TimeStepResult::IsInitialized() const {
+  return true;
+}
+
+::_pbi::CachedSize* TimeStepResult::AccessCachedSize() const {
+  return &_impl_._cached_size_;
+}
+void TimeStepResult::InternalSwap(TimeStepResult* PROTOBUF_RESTRICT other) {
+  using std::swap;
+  _internal_metadata_.InternalSwap(&other->_internal_metadata_);
+  _impl_.actors_.InternalSwap(&other->_impl_.actors_);
+  _impl_.cavobjects_.InternalSwap(&other->_impl_.cavobjects_);
+        swap(_impl_.value_, other->_impl_.value_);
+}
+
+::google::protobuf::Metadata TimeStepResult::GetMetadata() const {
+  return ::_pbi::AssignDescriptors(
+      &descriptor_table_carla_2eproto_getter, &descriptor_table_carla_2eproto_once,
+      file_level_metadata_carla_2eproto[17]);
+}
 // @@protoc_insertion_point(namespace_scope)
 }  // namespace carla
 namespace google {
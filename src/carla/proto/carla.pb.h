@@ -63,9 +63,15 @@ extern ActorIdsDefaultTypeInternal _ActorIds_default_instance_;
 class Boolean;
 struct BooleanDefaultTypeInternal;
 extern BooleanDefaultTypeInternal _Boolean_default_instance_;
+class CAVObjects;
+struct CAVObjectsDefaultTypeInternal;
+extern CAVObjectsDefaultTypeInternal _CAVObjects_default_instance_;
 class Control;
 struct ControlDefaultTypeInternal;
 extern ControlDefaultTypeInternal _Control_default_instance_;
+class DetectedObject;
+struct DetectedObjectDefaultTypeInternal;
+extern DetectedObjectDefaultTypeInternal _DetectedObject_default_instance_;
 class DoubleValue;
 struct DoubleValueDefaultTypeInternal;
 extern DoubleValueDefaultTypeInternal _DoubleValue_default_instance_;
@@ -90,6 +96,9 @@ extern ObjectsInDefaultTypeInternal _ObjectsIn_default_instance_;
 class Rotation;
 struct RotationDefaultTypeInternal;
 extern RotationDefaultTypeInternal _Rotation_default_instance_;
+class TimeStepResult;
+struct TimeStepResultDefaultTypeInternal;
+extern TimeStepResultDefaultTypeInternal _TimeStepResult_default_instance_;
 class Transform;
 struct TransformDefaultTypeInternal;
 extern TransformDefaultTypeInternal _Transform_default_instance_;
@@ -3404,6 +3413,633 @@ class ObjectIn final :
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_carla_2eproto;
+};// -------------------------------------------------------------------
+
+class DetectedObject final :
+    public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:carla.DetectedObject) */ {
+ public:
+  inline DetectedObject() : DetectedObject(nullptr) {}
+  ~DetectedObject() override;
+  template<typename = void>
+  explicit PROTOBUF_CONSTEXPR DetectedObject(::google::protobuf::internal::ConstantInitialized);
+
+  inline DetectedObject(const DetectedObject& from)
+      : DetectedObject(nullptr, from) {}
+  DetectedObject(DetectedObject&& from) noexcept
+    : DetectedObject() {
+    *this = ::std::move(from);
+  }
+
+  inline DetectedObject& operator=(const DetectedObject& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline DetectedObject& operator=(DetectedObject&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const DetectedObject& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const DetectedObject* internal_default_instance() {
+    return reinterpret_cast<const DetectedObject*>(
+               &_DetectedObject_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    15;
+
+  friend void swap(DetectedObject& a, DetectedObject& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(DetectedObject* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr &&
+        GetArena() == other->GetArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(DetectedObject* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  DetectedObject* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<DetectedObject>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const DetectedObject& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom( const DetectedObject& from) {
+    DetectedObject::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::google::protobuf::Message& to_msg, const ::google::protobuf::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  ::size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::google::protobuf::internal::ParseContext* ctx) final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target, ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
+
+  private:
+  ::google::protobuf::internal::CachedSize* AccessCachedSize() const final;
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(DetectedObject* other);
+
+  private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() {
+    return "carla.DetectedObject";
+  }
+  protected:
+  explicit DetectedObject(::google::protobuf::Arena* arena);
+  DetectedObject(::google::protobuf::Arena* arena, const DetectedObject& from);
+  public:
+
+  static const ClassData _class_data_;
+  const ::google::protobuf::Message::ClassData*GetClassData() const final;
+
+  ::google::protobuf::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kObjectFieldNumber = 1,
+    kLatitudeFieldNumber = 2,
+    kLongitudeFieldNumber = 3,
+    kGTaccuracyFieldNumber = 4,
+  };
+  // .carla.Object object = 1;
+  bool has_object() const;
+  void clear_object() ;
+  const ::carla::Object& object() const;
+  PROTOBUF_NODISCARD ::carla::Object* release_object();
+  ::carla::Object* mutable_object();
+  void set_allocated_object(::carla::Object* value);
+  void unsafe_arena_set_allocated_object(::carla::Object* value);
+  ::carla::Object* unsafe_arena_release_object();
+
+  private:
+  const ::carla::Object& _internal_object() const;
+  ::carla::Object* _internal_mutable_object();
+
+  public:
+  // double latitude = 2;
+  void clear_latitude() ;
+  double latitude() const;
+  void set_latitude(double value);
+
+  private:
+  double _internal_latitude() const;
+  void _internal_set_latitude(double value);
+
+  public:
+  // double longitude = 3;
+  void clear_longitude() ;
+  double longitude() const;
+  void set_longitude(double value);
+
+  private:
+  double _internal_longitude() const;
+  void _internal_set_longitude(double value);
+
+  public:
+  // double GTaccuracy = 4;
+  void clear_gtaccuracy() ;
+  double gtaccuracy() const;
+  void set_gtaccuracy(double value);
+
+  private:
+  double _internal_gtaccuracy() const;
+  void _internal_set_gtaccuracy(double value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:carla.DetectedObject)
+ private:
+  class _Internal;
+
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      2, 4, 1,
+      0, 2>
+      _table_;
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+
+        inline explicit constexpr Impl_(
+            ::google::protobuf::internal::ConstantInitialized) noexcept;
+        inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                              ::google::protobuf::Arena* arena);
+        inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                              ::google::protobuf::Arena* arena, const Impl_& from);
+    ::google::protobuf::internal::HasBits<1> _has_bits_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    ::carla::Object* object_;
+    double latitude_;
+    double longitude_;
+    double gtaccuracy_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_carla_2eproto;
+};// -------------------------------------------------------------------
+
+class CAVObjects final :
+    public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:carla.CAVObjects) */ {
+ public:
+  inline CAVObjects() : CAVObjects(nullptr) {}
+  ~CAVObjects() override;
+  template<typename = void>
+  explicit PROTOBUF_CONSTEXPR CAVObjects(::google::protobuf::internal::ConstantInitialized);
+
+  inline CAVObjects(const CAVObjects& from)
+      : CAVObjects(nullptr, from) {}
+  CAVObjects(CAVObjects&& from) noexcept
+    : CAVObjects() {
+    *this = ::std::move(from);
+  }
+
+  inline CAVObjects& operator=(const CAVObjects& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline CAVObjects& operator=(CAVObjects&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const CAVObjects& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const CAVObjects* internal_default_instance() {
+    return reinterpret_cast<const CAVObjects*>(
+               &_CAVObjects_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    16;
+
+  friend void swap(CAVObjects& a, CAVObjects& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(CAVObjects* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr &&
+        GetArena() == other->GetArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(CAVObjects* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  CAVObjects* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<CAVObjects>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const CAVObjects& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom( const CAVObjects& from) {
+    CAVObjects::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::google::protobuf::Message& to_msg, const ::google::protobuf::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  ::size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::google::protobuf::internal::ParseContext* ctx) final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target, ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
+
+  private:
+  ::google::protobuf::internal::CachedSize* AccessCachedSize() const final;
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(CAVObjects* other);
+
+  private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() {
+    return "carla.CAVObjects";
+  }
+  protected:
+  explicit CAVObjects(::google::protobuf::Arena* arena);
+  CAVObjects(::google::protobuf::Arena* arena, const CAVObjects& from);
+  public:
+
+  static const ClassData _class_data_;
+  const ::google::protobuf::Message::ClassData*GetClassData() const final;
+
+  ::google::protobuf::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kObjectsFieldNumber = 2,
+    kEgoIdFieldNumber = 1,
+  };
+  // repeated .carla.DetectedObject objects = 2;
+  int objects_size() const;
+  private:
+  int _internal_objects_size() const;
+
+  public:
+  void clear_objects() ;
+  ::carla::DetectedObject* mutable_objects(int index);
+  ::google::protobuf::RepeatedPtrField< ::carla::DetectedObject >*
+      mutable_objects();
+  private:
+  const ::google::protobuf::RepeatedPtrField<::carla::DetectedObject>& _internal_objects() const;
+  ::google::protobuf::RepeatedPtrField<::carla::DetectedObject>* _internal_mutable_objects();
+  public:
+  const ::carla::DetectedObject& objects(int index) const;
+  ::carla::DetectedObject* add_objects();
+  const ::google::protobuf::RepeatedPtrField< ::carla::DetectedObject >&
+      objects() const;
+  // int32 egoId = 1;
+  void clear_egoid() ;
+  ::int32_t egoid() const;
+  void set_egoid(::int32_t value);
+
+  private:
+  ::int32_t _internal_egoid() const;
+  void _internal_set_egoid(::int32_t value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:carla.CAVObjects)
+ private:
+  class _Internal;
+
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      1, 2, 1,
+      0, 2>
+      _table_;
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+
+        inline explicit constexpr Impl_(
+            ::google::protobuf::internal::ConstantInitialized) noexcept;
+        inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                              ::google::protobuf::Arena* arena);
+        inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                              ::google::protobuf::Arena* arena, const Impl_& from);
+    ::google::protobuf::RepeatedPtrField< ::carla::DetectedObject > objects_;
+    ::int32_t egoid_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_carla_2eproto;
+};// -------------------------------------------------------------------
+
+class TimeStepResult final :
+    public ::google::protobuf::Message /* @@protoc_insertion_point(class_definition:carla.TimeStepResult) */ {
+ public:
+  inline TimeStepResult() : TimeStepResult(nullptr) {}
+  ~TimeStepResult() override;
+  template<typename = void>
+  explicit PROTOBUF_CONSTEXPR TimeStepResult(::google::protobuf::internal::ConstantInitialized);
+
+  inline TimeStepResult(const TimeStepResult& from)
+      : TimeStepResult(nullptr, from) {}
+  TimeStepResult(TimeStepResult&& from) noexcept
+    : TimeStepResult() {
+    *this = ::std::move(from);
+  }
+
+  inline TimeStepResult& operator=(const TimeStepResult& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline TimeStepResult& operator=(TimeStepResult&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetArena() == from.GetArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  inline const ::google::protobuf::UnknownFieldSet& unknown_fields() const
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.unknown_fields<::google::protobuf::UnknownFieldSet>(::google::protobuf::UnknownFieldSet::default_instance);
+  }
+  inline ::google::protobuf::UnknownFieldSet* mutable_unknown_fields()
+      ABSL_ATTRIBUTE_LIFETIME_BOUND {
+    return _internal_metadata_.mutable_unknown_fields<::google::protobuf::UnknownFieldSet>();
+  }
+
+  static const ::google::protobuf::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::google::protobuf::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::google::protobuf::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const TimeStepResult& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const TimeStepResult* internal_default_instance() {
+    return reinterpret_cast<const TimeStepResult*>(
+               &_TimeStepResult_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    17;
+
+  friend void swap(TimeStepResult& a, TimeStepResult& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(TimeStepResult* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() != nullptr &&
+        GetArena() == other->GetArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetArena() == other->GetArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::google::protobuf::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(TimeStepResult* other) {
+    if (other == this) return;
+    ABSL_DCHECK(GetArena() == other->GetArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  TimeStepResult* New(::google::protobuf::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<TimeStepResult>(arena);
+  }
+  using ::google::protobuf::Message::CopyFrom;
+  void CopyFrom(const TimeStepResult& from);
+  using ::google::protobuf::Message::MergeFrom;
+  void MergeFrom( const TimeStepResult& from) {
+    TimeStepResult::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::google::protobuf::Message& to_msg, const ::google::protobuf::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  ::size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::google::protobuf::internal::ParseContext* ctx) final;
+  ::uint8_t* _InternalSerialize(
+      ::uint8_t* target, ::google::protobuf::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const { return _impl_._cached_size_.Get(); }
+
+  private:
+  ::google::protobuf::internal::CachedSize* AccessCachedSize() const final;
+  void SharedCtor(::google::protobuf::Arena* arena);
+  void SharedDtor();
+  void InternalSwap(TimeStepResult* other);
+
+  private:
+  friend class ::google::protobuf::internal::AnyMetadata;
+  static ::absl::string_view FullMessageName() {
+    return "carla.TimeStepResult";
+  }
+  protected:
+  explicit TimeStepResult(::google::protobuf::Arena* arena);
+  TimeStepResult(::google::protobuf::Arena* arena, const TimeStepResult& from);
+  public:
+
+  static const ClassData _class_data_;
+  const ::google::protobuf::Message::ClassData*GetClassData() const final;
+
+  ::google::protobuf::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kActorsFieldNumber = 2,
+    kCavObjectsFieldNumber = 3,
+    kValueFieldNumber = 1,
+  };
+  // repeated .carla.Vehicle actors = 2;
+  int actors_size() const;
+  private:
+  int _internal_actors_size() const;
+
+  public:
+  void clear_actors() ;
+  ::carla::Vehicle* mutable_actors(int index);
+  ::google::protobuf::RepeatedPtrField< ::carla::Vehicle >*
+      mutable_actors();
+  private:
+  const ::google::protobuf::RepeatedPtrField<::carla::Vehicle>& _internal_actors() const;
+  ::google::protobuf::RepeatedPtrField<::carla::Vehicle>* _internal_mutable_actors();
+  public:
+  const ::carla::Vehicle& actors(int index) const;
+  ::carla::Vehicle* add_actors();
+  const ::google::protobuf::RepeatedPtrField< ::carla::Vehicle >&
+      actors() const;
+  // repeated .carla.CAVObjects cavObjects = 3;
+  int cavobjects_size() const;
+  private:
+  int _internal_cavobjects_size() const;
+
+  public:
+  void clear_cavobjects() ;
+  ::carla::CAVObjects* mutable_cavobjects(int index);
+  ::google::protobuf::RepeatedPtrField< ::carla::CAVObjects >*
+      mutable_cavobjects();
+  private:
+  const ::google::protobuf::RepeatedPtrField<::carla::CAVObjects>& _internal_cavobjects() const;
+  ::google::protobuf::RepeatedPtrField<::carla::CAVObjects>* _internal_mutable_cavobjects();
+  public:
+  const ::carla::CAVObjects& cavobjects(int index) const;
+  ::carla::CAVObjects* add_cavobjects();
+  const ::google::protobuf::RepeatedPtrField< ::carla::CAVObjects >&
+      cavobjects() const;
+  // bool value = 1;
+  void clear_value() ;
+  bool value() const;
+  void set_value(bool value);
+
+  private:
+  bool _internal_value() const;
+  void _internal_set_value(bool value);
+
+  public:
+  // @@protoc_insertion_point(class_scope:carla.TimeStepResult)
+ private:
+  class _Internal;
+
+  friend class ::google::protobuf::internal::TcParser;
+  static const ::google::protobuf::internal::TcParseTable<
+      2, 3, 2,
+      0, 2>
+      _table_;
+  friend class ::google::protobuf::MessageLite;
+  friend class ::google::protobuf::Arena;
+  template <typename T>
+  friend class ::google::protobuf::Arena::InternalHelper;
+  using InternalArenaConstructable_ = void;
+  using DestructorSkippable_ = void;
+  struct Impl_ {
+
+        inline explicit constexpr Impl_(
+            ::google::protobuf::internal::ConstantInitialized) noexcept;
+        inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                              ::google::protobuf::Arena* arena);
+        inline explicit Impl_(::google::protobuf::internal::InternalVisibility visibility,
+                              ::google::protobuf::Arena* arena, const Impl_& from);
+    ::google::protobuf::RepeatedPtrField< ::carla::Vehicle > actors_;
+    ::google::protobuf::RepeatedPtrField< ::carla::CAVObjects > cavobjects_;
+    bool value_;
+    mutable ::google::protobuf::internal::CachedSize _cached_size_;
+    PROTOBUF_TSAN_DECLARE_MEMBER
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_carla_2eproto;
 };
 
 // ===================================================================
@@ -6000,6 +6636,376 @@ inline void DoubleValue::_internal_set_value(double value) {
   _impl_.value_ = value;
 }
 
+// -------------------------------------------------------------------
+
+// DetectedObject
+
+// .carla.Object object = 1;
+inline bool DetectedObject::has_object() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.object_ != nullptr);
+  return value;
+}
+inline void DetectedObject::clear_object() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  if (_impl_.object_ != nullptr) _impl_.object_->Clear();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const ::carla::Object& DetectedObject::_internal_object() const {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  const ::carla::Object* p = _impl_.object_;
+  return p != nullptr ? *p : reinterpret_cast<const ::carla::Object&>(::carla::_Object_default_instance_);
+}
+inline const ::carla::Object& DetectedObject::object() const ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:carla.DetectedObject.object)
+  return _internal_object();
+}
+inline void DetectedObject::unsafe_arena_set_allocated_object(::carla::Object* value) {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  if (GetArena() == nullptr) {
+    delete reinterpret_cast<::google::protobuf::MessageLite*>(_impl_.object_);
+  }
+  _impl_.object_ = reinterpret_cast<::carla::Object*>(value);
+  if (value != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:carla.DetectedObject.object)
+}
+inline ::carla::Object* DetectedObject::release_object() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::carla::Object* released = _impl_.object_;
+  _impl_.object_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old = reinterpret_cast<::google::protobuf::MessageLite*>(released);
+  released = ::google::protobuf::internal::DuplicateIfNonNull(released);
+  if (GetArena() == nullptr) {
+    delete old;
+  }
+#else   // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArena() != nullptr) {
+    released = ::google::protobuf::internal::DuplicateIfNonNull(released);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return released;
+}
+inline ::carla::Object* DetectedObject::unsafe_arena_release_object() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  // @@protoc_insertion_point(field_release:carla.DetectedObject.object)
+
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  ::carla::Object* temp = _impl_.object_;
+  _impl_.object_ = nullptr;
+  return temp;
+}
+inline ::carla::Object* DetectedObject::_internal_mutable_object() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  _impl_._has_bits_[0] |= 0x00000001u;
+  if (_impl_.object_ == nullptr) {
+    auto* p = CreateMaybeMessage<::carla::Object>(GetArena());
+    _impl_.object_ = reinterpret_cast<::carla::Object*>(p);
+  }
+  return _impl_.object_;
+}
+inline ::carla::Object* DetectedObject::mutable_object() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  ::carla::Object* _msg = _internal_mutable_object();
+  // @@protoc_insertion_point(field_mutable:carla.DetectedObject.object)
+  return _msg;
+}
+inline void DetectedObject::set_allocated_object(::carla::Object* value) {
+  ::google::protobuf::Arena* message_arena = GetArena();
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  if (message_arena == nullptr) {
+    delete reinterpret_cast<::carla::Object*>(_impl_.object_);
+  }
+
+  if (value != nullptr) {
+    ::google::protobuf::Arena* submessage_arena = reinterpret_cast<::carla::Object*>(value)->GetArena();
+    if (message_arena != submessage_arena) {
+      value = ::google::protobuf::internal::GetOwnedMessage(message_arena, value, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+
+  _impl_.object_ = reinterpret_cast<::carla::Object*>(value);
+  // @@protoc_insertion_point(field_set_allocated:carla.DetectedObject.object)
+}
+
+// double latitude = 2;
+inline void DetectedObject::clear_latitude() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  _impl_.latitude_ = 0;
+}
+inline double DetectedObject::latitude() const {
+  // @@protoc_insertion_point(field_get:carla.DetectedObject.latitude)
+  return _internal_latitude();
+}
+inline void DetectedObject::set_latitude(double value) {
+  _internal_set_latitude(value);
+  // @@protoc_insertion_point(field_set:carla.DetectedObject.latitude)
+}
+inline double DetectedObject::_internal_latitude() const {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return _impl_.latitude_;
+}
+inline void DetectedObject::_internal_set_latitude(double value) {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ;
+  _impl_.latitude_ = value;
+}
+
+// double longitude = 3;
+inline void DetectedObject::clear_longitude() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  _impl_.longitude_ = 0;
+}
+inline double DetectedObject::longitude() const {
+  // @@protoc_insertion_point(field_get:carla.DetectedObject.longitude)
+  return _internal_longitude();
+}
+inline void DetectedObject::set_longitude(double value) {
+  _internal_set_longitude(value);
+  // @@protoc_insertion_point(field_set:carla.DetectedObject.longitude)
+}
+inline double DetectedObject::_internal_longitude() const {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return _impl_.longitude_;
+}
+inline void DetectedObject::_internal_set_longitude(double value) {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ;
+  _impl_.longitude_ = value;
+}
+
+// double GTaccuracy = 4;
+inline void DetectedObject::clear_gtaccuracy() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  _impl_.gtaccuracy_ = 0;
+}
+inline double DetectedObject::gtaccuracy() const {
+  // @@protoc_insertion_point(field_get:carla.DetectedObject.GTaccuracy)
+  return _internal_gtaccuracy();
+}
+inline void DetectedObject::set_gtaccuracy(double value) {
+  _internal_set_gtaccuracy(value);
+  // @@protoc_insertion_point(field_set:carla.DetectedObject.GTaccuracy)
+}
+inline double DetectedObject::_internal_gtaccuracy() const {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return _impl_.gtaccuracy_;
+}
+inline void DetectedObject::_internal_set_gtaccuracy(double value) {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ;
+  _impl_.gtaccuracy_ = value;
+}
+
+// -------------------------------------------------------------------
+
+// CAVObjects
+
+// int32 egoId = 1;
+inline void CAVObjects::clear_egoid() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  _impl_.egoid_ = 0;
+}
+inline ::int32_t CAVObjects::egoid() const {
+  // @@protoc_insertion_point(field_get:carla.CAVObjects.egoId)
+  return _internal_egoid();
+}
+inline void CAVObjects::set_egoid(::int32_t value) {
+  _internal_set_egoid(value);
+  // @@protoc_insertion_point(field_set:carla.CAVObjects.egoId)
+}
+inline ::int32_t CAVObjects::_internal_egoid() const {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return _impl_.egoid_;
+}
+inline void CAVObjects::_internal_set_egoid(::int32_t value) {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ;
+  _impl_.egoid_ = value;
+}
+
+// repeated .carla.DetectedObject objects = 2;
+inline int CAVObjects::_internal_objects_size() const {
+  return _internal_objects().size();
+}
+inline int CAVObjects::objects_size() const {
+  return _internal_objects_size();
+}
+inline void CAVObjects::clear_objects() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  _impl_.objects_.Clear();
+}
+inline ::carla::DetectedObject* CAVObjects::mutable_objects(int index)
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable:carla.CAVObjects.objects)
+  return _internal_mutable_objects()->Mutable(index);
+}
+inline ::google::protobuf::RepeatedPtrField<::carla::DetectedObject>* CAVObjects::mutable_objects()
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable_list:carla.CAVObjects.objects)
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  return _internal_mutable_objects();
+}
+inline const ::carla::DetectedObject& CAVObjects::objects(int index) const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:carla.CAVObjects.objects)
+  return _internal_objects().Get(index);
+}
+inline ::carla::DetectedObject* CAVObjects::add_objects() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ::carla::DetectedObject* _add = _internal_mutable_objects()->Add();
+  // @@protoc_insertion_point(field_add:carla.CAVObjects.objects)
+  return _add;
+}
+inline const ::google::protobuf::RepeatedPtrField<::carla::DetectedObject>& CAVObjects::objects() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_list:carla.CAVObjects.objects)
+  return _internal_objects();
+}
+inline const ::google::protobuf::RepeatedPtrField<::carla::DetectedObject>&
+CAVObjects::_internal_objects() const {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return _impl_.objects_;
+}
+inline ::google::protobuf::RepeatedPtrField<::carla::DetectedObject>*
+CAVObjects::_internal_mutable_objects() {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return &_impl_.objects_;
+}
+
+// -------------------------------------------------------------------
+
+// TimeStepResult
+
+// bool value = 1;
+inline void TimeStepResult::clear_value() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  _impl_.value_ = false;
+}
+inline bool TimeStepResult::value() const {
+  // @@protoc_insertion_point(field_get:carla.TimeStepResult.value)
+  return _internal_value();
+}
+inline void TimeStepResult::set_value(bool value) {
+  _internal_set_value(value);
+  // @@protoc_insertion_point(field_set:carla.TimeStepResult.value)
+}
+inline bool TimeStepResult::_internal_value() const {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return _impl_.value_;
+}
+inline void TimeStepResult::_internal_set_value(bool value) {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ;
+  _impl_.value_ = value;
+}
+
+// repeated .carla.Vehicle actors = 2;
+inline int TimeStepResult::_internal_actors_size() const {
+  return _internal_actors().size();
+}
+inline int TimeStepResult::actors_size() const {
+  return _internal_actors_size();
+}
+inline void TimeStepResult::clear_actors() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  _impl_.actors_.Clear();
+}
+inline ::carla::Vehicle* TimeStepResult::mutable_actors(int index)
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable:carla.TimeStepResult.actors)
+  return _internal_mutable_actors()->Mutable(index);
+}
+inline ::google::protobuf::RepeatedPtrField<::carla::Vehicle>* TimeStepResult::mutable_actors()
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable_list:carla.TimeStepResult.actors)
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  return _internal_mutable_actors();
+}
+inline const ::carla::Vehicle& TimeStepResult::actors(int index) const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:carla.TimeStepResult.actors)
+  return _internal_actors().Get(index);
+}
+inline ::carla::Vehicle* TimeStepResult::add_actors() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ::carla::Vehicle* _add = _internal_mutable_actors()->Add();
+  // @@protoc_insertion_point(field_add:carla.TimeStepResult.actors)
+  return _add;
+}
+inline const ::google::protobuf::RepeatedPtrField<::carla::Vehicle>& TimeStepResult::actors() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_list:carla.TimeStepResult.actors)
+  return _internal_actors();
+}
+inline const ::google::protobuf::RepeatedPtrField<::carla::Vehicle>&
+TimeStepResult::_internal_actors() const {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return _impl_.actors_;
+}
+inline ::google::protobuf::RepeatedPtrField<::carla::Vehicle>*
+TimeStepResult::_internal_mutable_actors() {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return &_impl_.actors_;
+}
+
+// repeated .carla.CAVObjects cavObjects = 3;
+inline int TimeStepResult::_internal_cavobjects_size() const {
+  return _internal_cavobjects().size();
+}
+inline int TimeStepResult::cavobjects_size() const {
+  return _internal_cavobjects_size();
+}
+inline void TimeStepResult::clear_cavobjects() {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  _impl_.cavobjects_.Clear();
+}
+inline ::carla::CAVObjects* TimeStepResult::mutable_cavobjects(int index)
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable:carla.TimeStepResult.cavObjects)
+  return _internal_mutable_cavobjects()->Mutable(index);
+}
+inline ::google::protobuf::RepeatedPtrField<::carla::CAVObjects>* TimeStepResult::mutable_cavobjects()
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_mutable_list:carla.TimeStepResult.cavObjects)
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  return _internal_mutable_cavobjects();
+}
+inline const ::carla::CAVObjects& TimeStepResult::cavobjects(int index) const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_get:carla.TimeStepResult.cavObjects)
+  return _internal_cavobjects().Get(index);
+}
+inline ::carla::CAVObjects* TimeStepResult::add_cavobjects() ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  PROTOBUF_TSAN_WRITE(&_impl_._tsan_detect_race);
+  ::carla::CAVObjects* _add = _internal_mutable_cavobjects()->Add();
+  // @@protoc_insertion_point(field_add:carla.TimeStepResult.cavObjects)
+  return _add;
+}
+inline const ::google::protobuf::RepeatedPtrField<::carla::CAVObjects>& TimeStepResult::cavobjects() const
+    ABSL_ATTRIBUTE_LIFETIME_BOUND {
+  // @@protoc_insertion_point(field_list:carla.TimeStepResult.cavObjects)
+  return _internal_cavobjects();
+}
+inline const ::google::protobuf::RepeatedPtrField<::carla::CAVObjects>&
+TimeStepResult::_internal_cavobjects() const {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return _impl_.cavobjects_;
+}
+inline ::google::protobuf::RepeatedPtrField<::carla::CAVObjects>*
+TimeStepResult::_internal_mutable_cavobjects() {
+  PROTOBUF_TSAN_READ(&_impl_._tsan_detect_race);
+  return &_impl_.cavobjects_;
+}
+
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
 #endif  // __GNUC__
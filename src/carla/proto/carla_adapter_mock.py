@@ -0,0 +1,313 @@
+#!/usr/bin/env python3
+#
+# SPDX-License-Identifier: GPL-2.0-or-later
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#
+"""
+Minimal mock of the OpenCDA Control Interface (CarlaAdapter gRPC service), to test the ns-3 OpenCDAClient
+without CARLA and OpenCDA.
+
+A set of synthetic vehicles moves along parallel straight lanes; the first --cavs vehicles are CAVs with an LDM,
+which detect all the other vehicles within --range meters. Start it with:
+
+    python3 carla_adapter_mock.py --port 1337
+
+and run the ns-3 example with the OpenCDAClient "CARLAManual" and "OpenCDAManual" attributes set to true.
+The carla-opencda-client test suite (test/carla-test-suite.cc) starts it automatically.
+With --no-batch, ExecuteOneTimeStepBatch and GetActorLDMGeo return UNIMPLEMENTED, as an older OpenCDA Control
+Interface would do, to test the fallback of the client to one RPC per actor.
+"""
+
+import argparse
+import math
+import threading
+import time
+from concurrent import futures
+
+import grpc
+from google.protobuf import empty_pb2
+
+import carla_pb2
+import carla_pb2_grpc
+
+ORIGIN_LAT = 45.0
+ORIGIN_LON = 7.0
+EARTH_RADIUS = 6378137.0
+
+
+class MockVehicle:
+    def __init__(self, actor_id, x, y, speed):
+        self.id = actor_id
+        self.x = x
+        self.y = y
+        self.speed = speed
+        self.length = 4.5
+        self.width = 1.8
+
+
+class CarlaAdapterMock(carla_pb2_grpc.CarlaAdapterServicer):
+
+    def __init__(self, args):
+        self.args = args
+        self.lock = threading.Lock()
+        self.step = 0
+        self.timestamp_ms = 0
+        self.vehicles = {}
+        self.inserted = {}  # egoId -> {id: Object} inserted by ns-3 (InsertObject/InsertObjects/InsertCV)
+        self.rpc_count = {}
+        for i in range(args.vehicles):
+            lane = i % 3
+            self.vehicles[i + 1] = MockVehicle(i + 1, 10.0 * (i // 3), 3.5 * lane, 8.0 + lane * 2.0)
+
+    def count(self, name):
+        self.rpc_count[name] = self.rpc_count.get(name, 0) + 1
+
+    # Helpers
+
+    @staticmethod
+    def to_geo(x, y):
+        lat = ORIGIN_LAT + math.degrees(y / EARTH_RADIUS)
+        lon = ORIGIN_LON + math.degrees(x / (EARTH_RADIUS * math.cos(math.radians(ORIGIN_LAT))))
+        return lat, lon
+
+    @staticmethod
+    def to_cartesian(lat, lon):
+        y = math.radians(lat - ORIGIN_LAT) * EARTH_RADIUS
+        x = math.radians(lon - ORIGIN_LON) * EARTH_RADIUS * math.cos(math.radians(ORIGIN_LAT))
+        return x, y
+
+    def is_cav(self, actor_id):
+        return actor_id in self.vehicles and actor_id <= self.args.cavs
+
+    def fill_vehicle(self, v, msg):
+        msg.id = v.id
+        msg.speed.x = v.speed
+        msg.location.x = v.x
+        msg.location.y = v.y
+        msg.location.z = 0.0
+        msg.latitude, msg.longitude = self.to_geo(v.x, v.y)
+        msg.length = v.length
+        msg.width = v.width
+        msg.heading = 0.0
+        msg.transform.location.CopyFrom(msg.location)
+        return msg
+
+    def detected_objects(self, ego_id):
+        ego = self.vehicles[ego_id]
+        inserted = self.inserted.get(ego_id, {})
+        objects = list(inserted.values())
+        for v in self.vehicles.values():
+            if v.id == ego_id or v.id in inserted or math.hypot(v.x - ego.x, v.y - ego.y) > self.args.range:
+                continue
+            obj = carla_pb2.Object()
+            obj.id = v.id
+            obj.dx = v.x - ego.x
+            obj.dy = v.y - ego.y
+            obj.speed.x = v.speed
+            obj.length = v.length
+            obj.width = v.width
+            obj.onSight = True
+            obj.tracked = True
+            obj.timestamp = self.timestamp_ms
+            obj.confidence = 1.0
+            obj.transform.location.x = v.x
+            obj.transform.location.y = v.y
+            obj.detected = True
+            obj.perceivedBy = ego_id
+            objects.append(obj)
+        return objects
+
+    def cav_objects(self, ego_id):
+        cav = carla_pb2.CAVObjects(egoId=ego_id)
+        for obj in self.detected_objects(ego_id):
+            det = cav.objects.add()
+            det.object.CopyFrom(obj)
+            det.latitude, det.longitude = self.to_geo(obj.transform.location.x, obj.transform.location.y)
+            det.GTaccuracy = 1.0
+        return cav
+
+    def advance(self):
+        self.step += 1
+        self.timestamp_ms += int(self.args.step_length * 1000)
+        for v in self.vehicles.values():
+            v.x += v.speed * self.args.step_length
+        self.inserted.clear()
+        return self.args.steps <= 0 or self.step <= self.args.steps
+
+    # CarlaAdapter service
+
+    def ExecuteOneTimeStep(self, request, context):
+        with self.lock:
+            self.count('ExecuteOneTimeStep')
+            return carla_pb2.Boolean(value=self.advance())
+
+    def ExecuteOneTimeStepBatch(self, request, context):
+        with self.lock:
+            self.count('ExecuteOneTimeStepBatch')
+            if self.args.no_batch:
+                context.abort(grpc.StatusCode.UNIMPLEMENTED, 'Method not implemented!')
+            result = carla_pb2.TimeStepResult(value=self.advance())
+            if result.value:
+                for v in self.vehicles.values():
+                    self.fill_vehicle(v, result.actors.add())
+                    if self.is_cav(v.id):
+                        result.cavObjects.add().CopyFrom(self.cav_objects(v.id))
+            return result
+
+    def Finish(self, request, context):
+        self.count('Finish')
+        return empty_pb2.Empty()
+
+    def GetManagedActorsIds(self, request, context):
+        with self.lock:
+            self.count('GetManagedActorsIds')
+            return carla_pb2.ActorIds(actorId=list(self.vehicles.keys()))
+
+    def GetManagedCAVsIds(self, request, context):
+        with self.lock:
+            self.count('GetManagedCAVsIds')
+            return carla_pb2.ActorIds(actorId=[i for i in self.vehicles if self.is_cav(i)])
+
+    def GetManagedActorById(self, request, context):
+        with self.lock:
+            self.count('GetManagedActorById')
+            if request.num not in self.vehicles:
+                context.abort(grpc.StatusCode.NOT_FOUND, 'Unknown actor %d' % request.num)
+            return self.fill_vehicle(self.vehicles[request.num], carla_pb2.Vehicle())
+
+    def InsertVehicle(self, request, context):
+        with self.lock:
+            self.count('InsertVehicle')
+            actor_id = max(self.vehicles.keys(), default=0) + 1
+            self.vehicles[actor_id] = MockVehicle(actor_id, request.location.x, request.location.y, 0.0)
+            return carla_pb2.Number(num=actor_id)
+
+    def GetRandomSpawnPoint(self, request, context):
+        self.count('GetRandomSpawnPoint')
+        return carla_pb2.Transform()
+
+    def GetActorLDM(self, request, context):
+        with self.lock:
+            self.count('GetActorLDM')
+            return carla_pb2.Objects(objects=self.detected_objects(request.num) if self.is_cav(request.num) else [])
+
+    def GetActorLDMGeo(self, request, context):
+        with self.lock:
+            self.count('GetActorLDMGeo')
+            if self.args.no_batch:
+                context.abort(grpc.StatusCode.UNIMPLEMENTED, 'Method not implemented!')
+            if not self.is_cav(request.num):
+                return carla_pb2.CAVObjects(egoId=request.num)
+            return self.cav_objects(request.num)
+
+    def insert(self, ego_id, obj):
+        # Objects received through V2X replace the detected ones in the LDM of the CAV, until the next step
+        if obj.id not in self.vehicles or obj.id == ego_id:
+            return
+        stored = carla_pb2.Object()
+        stored.CopyFrom(obj)
+        stored.detected = False
+        self.inserted.setdefault(ego_id, {})[obj.id] = stored
+
+    def InsertObject(self, request, context):
+        with self.lock:
+            self.count('InsertObject')
+            self.insert(request.egoId, request.object)
+            return carla_pb2.Number(num=1)
+
+    def InsertObjects(self, request, context):
+        with self.lock:
+            self.count('InsertObjects')
+            for obj in request.cpmObjects:
+                self.insert(request.egoId, obj)
+            return carla_pb2.DoubleValue(value=0.0)
+
+    def InsertCV(self, request, context):
+        with self.lock:
+            self.count('InsertCV')
+            self.insert(request.egoId, request.object)
+            return carla_pb2.DoubleValue(value=0.0)
+
+    def GetCartesian(self, request, context):
+        self.count('GetCartesian')
+        x, y = self.to_cartesian(request.x, request.y)
+        return carla_pb2.Vector(x=x, y=y)
+
+    def GetGeo(self, request, context):
+        self.count('GetGeo')
+        lat, lon = self.to_geo(request.x, request.y)
+        return carla_pb2.Vector(x=lat, y=lon)
+
+    def hasLDM(self, request, context):
+        with self.lock:
+            self.count('hasLDM')
+            return carla_pb2.Boolean(value=self.is_cav(request.num))
+
+    def SetControl(self, request, context):
+        with self.lock:
+            self.count('SetControl')
+            if request.id in self.vehicles:
+                self.vehicles[request.id].speed = request.speed
+            return empty_pb2.Empty()
+
+    def GetCarlaWaypoint(self, request, context):
+        self.count('GetCarlaWaypoint')
+        return carla_pb2.Waypoint(location=request, lane_width=3.5)
+
+    def GetNextCarlaWaypoint(self, request, context):
+        self.count('GetNextCarlaWaypoint')
+        return carla_pb2.Waypoint(location=carla_pb2.Vector(x=request.x + 2.0, y=request.y, z=request.z),
+                                  lane_width=3.5)
+
+    def GetGTaccuracy(self, request, context):
+        self.count('GetGTaccuracy')
+        return carla_pb2.DoubleValue(value=1.0)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Mock of the OpenCDA Control Interface (CarlaAdapter gRPC service)')
+    parser.add_argument('--port', type=int, default=1337)
+    parser.add_argument('--vehicles', type=int, default=10, help='Number of synthetic vehicles')
+    parser.add_argument('--cavs', type=int, default=3, help='Number of CAVs (with an LDM) among the vehicles')
+    parser.add_argument('--range', type=float, default=50.0, help='Detection range of the CAVs (m)')
+    parser.add_argument('--step-length', type=float, default=0.05, help='Length of a time step (s)')
+    parser.add_argument('--steps', type=int, default=0, help='Number of steps before ending the simulation (0: never)')
+    parser.add_argument('--no-batch', action='store_true',
+                        help='Do not implement ExecuteOneTimeStepBatch and GetActorLDMGeo')
+    args = parser.parse_args()
+
+    servicer = CarlaAdapterMock(args)
+    server = grpc.server(futures.ThreadPoolExecutor(max_workers=4))
+    carla_pb2_grpc.add_CarlaAdapterServicer_to_server(servicer, server)
+    server.add_insecure_port('[::]:%d' % args.port)
+    server.start()
+    # Same message checked by OpenCDAClient::startSimulation() when OpenCDA is not started manually
+    with open('/tmp/opencda_output_%d.txt' % args.port, 'w') as f:
+        f.write('Server ready\n')
+    print('Server ready', flush=True)
+
+    try:
+        while True:
+            time.sleep(1)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.stop(0)
+        print('RPC calls: ' + ', '.join('%s=%d' % kv for kv in sorted(servicer.rpc_count.items())))
+
+
+if __name__ == '__main__':
+    main()
@@ -105,6 +105,16 @@ class CarlaAdapterStub(object):
                 request_serializer=carla__pb2.ObjectMinimal.SerializeToString,
                 response_deserializer=carla__pb2.DoubleValue.FromString,
                 )
+        self.ExecuteOneTimeStepBatch = channel.unary_unary(
+                '/carla.CarlaAdapter/ExecuteOneTimeStepBatch',
+                request_serializer=google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+                response_deserializer=carla__pb2.TimeStepResult.FromString,
+                )
+        self.GetActorLDMGeo = channel.unary_unary(
+                '/carla.CarlaAdapter/GetActorLDMGeo',
+                request_serializer=carla__pb2.Number.SerializeToString,
+                response_deserializer=carla__pb2.CAVObjects.FromString,
+                )
 
 
 class CarlaAdapterServicer(object):
@@ -218,6 +228,18 @@ class CarlaAdapterServicer(object):
         context.set_details('Method not implemented!')
         raise NotImplementedError('Method not implemented!')
 
+    def ExecuteOneTimeStepBatch(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
+    def GetActorLDMGeo(self, request, context):
+        """Missing associated documentation comment in .proto file."""
+        context.set_code(grpc.StatusCode.UNIMPLEMENTED)
+        context.set_details('Method not implemented!')
+        raise NotImplementedError('Method not implemented!')
+
 
 def add_CarlaAdapterServicer_to_server(servicer, server):
     rpc_method_handlers = {
@@ -311,6 +333,16 @@ def add_CarlaAdapterServicer_to_server(servicer, server):
                     request_deserializer=carla__pb2.ObjectMinimal.FromString,
                     response_serializer=carla__pb2.DoubleValue.SerializeToString,
             ),
+            'ExecuteOneTimeStepBatch': grpc.unary_unary_rpc_method_handler(
+                    servicer.ExecuteOneTimeStepBatch,
+                    request_deserializer=google_dot_protobuf_dot_empty__pb2.Empty.FromString,
+                    response_serializer=carla__pb2.TimeStepResult.SerializeToString,
+            ),
+            'GetActorLDMGeo': grpc.unary_unary_rpc_method_handler(
+                    servicer.GetActorLDMGeo,
+                    request_deserializer=carla__pb2.Number.FromString,
+                    response_serializer=carla__pb2.CAVObjects.SerializeToString,
+            ),
     }
     generic_handler = grpc.method_handlers_generic_handler(
             'carla.CarlaAdapter', rpc_method_handlers)
@@ -626,3 +658,37 @@ class CarlaAdapter(object):
             carla__pb2.DoubleValue.FromString,
             options, channel_credentials,
             insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def ExecuteOneTimeStepBatch(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/carla.CarlaAdapter/ExecuteOneTimeStepBatch',
+            google_dot_protobuf_dot_empty__pb2.Empty.SerializeToString,
+            carla__pb2.TimeStepResult.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
+
+    @staticmethod
+    def GetActorLDMGeo(request,
+            target,
+            options=(),
+            channel_credentials=None,
+            call_credentials=None,
+            insecure=False,
+            compression=None,
+            wait_for_ready=None,
+            timeout=None,
+            metadata=None):
+        return grpc.experimental.unary_unary(request, target, '/carla.CarlaAdapter/GetActorLDMGeo',
+            carla__pb2.Number.SerializeToString,
+            carla__pb2.CAVObjects.FromString,
+            options, channel_credentials,
+            insecure, call_credentials, compression, wait_for_ready, timeout, metadata)
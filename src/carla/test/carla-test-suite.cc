@@ -0,0 +1,425 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+// Tests of the OpenCDAClient against the mock of the OpenCDA Control Interface (proto/carla_adapter_mock.py), which
+// replaces CARLA and OpenCDA. The mock requires python3 with the grpcio and protobuf packages: when they are not
+// installed, the test cases are skipped.
+
+#include "ns3/OpenCDAClient.h"
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+
+#include "ns3/test.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+namespace
+{
+  // CarlaAdapter mock, started in its own process group and stopped with SIGINT, so that it prints its RPC counters
+  class CarlaAdapterMockProcess
+  {
+  public:
+    CarlaAdapterMockProcess () : m_pid (-1), m_port (0) {}
+    ~CarlaAdapterMockProcess () {Stop ();}
+
+    static bool IsAvailable ()
+    {
+      return std::system ("python3 -c 'import grpc, google.protobuf' > /dev/null 2>&1") == 0;
+    }
+
+    bool Start (bool batch)
+    {
+      m_port = GetFreePort ();
+      std::string readyFile = "/tmp/opencda_output_" + std::to_string (m_port) + ".txt";
+      std::string logFile = GetLogFile ();
+      std::string script = std::string (NS_TEST_SOURCEDIR) + "/../proto/carla_adapter_mock.py";
+      std::string port = std::to_string (m_port);
+      std::remove (readyFile.c_str ());
+
+      m_pid = fork ();
+      if (m_pid == 0)
+        {
+          setpgid (0, 0);
+          if (freopen (logFile.c_str (), "w", stdout) == nullptr || dup2 (fileno (stdout), STDERR_FILENO) < 0)
+            {
+              _exit (1);
+            }
+          if (batch)
+            {
+              execlp ("python3", "python3", "-u", script.c_str (), "--port", port.c_str (), (char *) nullptr);
+            }
+          else
+            {
+              execlp ("python3", "python3", "-u", script.c_str (), "--port", port.c_str (), "--no-batch", (char *) nullptr);
+            }
+          _exit (127);
+        }
+      if (m_pid < 0)
+        {
+          return false;
+        }
+
+      // Same readiness check of OpenCDAClient::startSimulation(), with a timeout
+      for (int i = 0; i < 200; i++)
+        {
+          std::ifstream ready (readyFile);
+          std::string line;
+          if (std::getline (ready, line) && line.find ("Server ready") != std::string::npos)
+            {
+              return true;
+            }
+          if (waitpid (m_pid, nullptr, WNOHANG) == m_pid)
+            {
+              m_pid = -1;
+              return false;
+            }
+          usleep (50000);
+        }
+      Stop ();
+      return false;
+    }
+
+    // Stop the mock and return its RPC counters
+    std::map<std::string,int> Stop ()
+    {
+      std::map<std::string,int> counters;
+      if (m_pid <= 0)
+        {
+          return counters;
+        }
+      kill (-m_pid, SIGINT);
+      waitpid (m_pid, nullptr, 0);
+      m_pid = -1;
+
+      // "RPC calls: ExecuteOneTimeStep=21, GetActorLDM=3, ..."
+      std::ifstream log (GetLogFile ());
+      std::string line;
+      while (std::getline (log, line))
+        {
+          if (line.compare (0, 11, "RPC calls: ") != 0)
+            {
+              continue;
+            }
+          std::stringstream ss (line.substr (11));
+          std::string item;
+          while (std::getline (ss, item, ','))
+            {
+              item.erase (0, item.find_first_not_of (' '));
+              size_t eq = item.find ('=');
+              if (eq != std::string::npos)
+                {
+                  counters[item.substr (0, eq)] = std::stoi (item.substr (eq + 1));
+                }
+            }
+        }
+      std::remove (GetLogFile ().c_str ());
+      std::remove (("/tmp/opencda_output_" + std::to_string (m_port) + ".txt").c_str ());
+      return counters;
+    }
+
+    uint16_t GetPort () const {return m_port;}
+
+  private:
+    static uint16_t GetFreePort ()
+    {
+      int fd = socket (AF_INET, SOCK_STREAM, 0);
+      struct sockaddr_in addr = {};
+      socklen_t len = sizeof (addr);
+      addr.sin_family = AF_INET;
+      addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+      addr.sin_port = 0;
+      if (fd < 0 || bind (fd, (struct sockaddr *) &addr, sizeof (addr)) < 0
+          || getsockname (fd, (struct sockaddr *) &addr, &len) < 0)
+        {
+          NS_FATAL_ERROR ("Cannot find a free TCP port for the CarlaAdapter mock");
+        }
+      close (fd);
+      return ntohs (addr.sin_port);
+    }
+
+    std::string GetLogFile () const {return "/tmp/carla_adapter_mock_" + std::to_string (m_port) + ".log";}
+
+    pid_t m_pid;
+    uint16_t m_port;
+  };
+
+  // State seen by ns-3 at a given time of a run against the mock
+  struct MockRunResult
+  {
+    std::map<int,Vector> positions; //!< Actor ID -> position of its ns-3 node
+    std::map<int,std::map<int,std::pair<double,double>>> detected; //!< CAV ID -> detected object ID -> (lat, lon)
+    std::map<std::string,int> rpcCount; //!< RPCs served by the mock
+    std::vector<std::string> sensorLog; //!< What SensorLikeUpdate() saw at each call
+    uint64_t earlyJoins = 0; //!< OpenCDAClient::getEarlyStepJoins() at the sampling time
+    bool asyncStep = false; //!< OpenCDAClient::isAsyncTimeStep() at the sampling time
+  };
+
+  // Same sequence of RPCs of OpenCDASensor::updateDetectedObjects() for CAV 1: read the ego vehicle and its LDM, then
+  // insert the objects received through V2X (here, the same objects, as if received from vehicle 2)
+  void
+  SensorLikeUpdate (Ptr<OpenCDAClient> client, MockRunResult &result)
+  {
+    const int egoId = 1;
+    carla::Vehicle ego = client->GetManagedActorById (egoId);
+    carla::CAVObjects objects = client->getDetectedObjectsGeo (egoId);
+
+    std::stringstream ss;
+    ss << Simulator::Now ().GetMilliSeconds () << " ms: x = " << ego.location ().x () << ", objects:";
+    carla::ObjectsIn objectsIn;
+    for (int i = 0; i < objects.objects_size (); i++)
+      {
+        const carla::Object &object = objects.objects (i).object ();
+        ss << " " << object.id () << (object.detected () ? "" : " (inserted)") << " at " << object.transform ().location ().x ();
+        *objectsIn.add_cpmobjects () = object;
+      }
+    objectsIn.set_egoid (egoId);
+    objectsIn.set_fromid (2);
+    client->InsertObjects (objectsIn);
+    result.sensorLog.push_back (ss.str ());
+  }
+
+  // Run the OpenCDAClient against the mock until sampleTime, with the given client attributes. If sensorLike is true,
+  // SensorLikeUpdate() is called in the middle of each step, as an OpenCDASensor would do
+  bool
+  RunAgainstMock (bool mockBatch, bool batchedStep, bool asyncStep, bool sensorLike, Time sampleTime, MockRunResult &result)
+  {
+    CarlaAdapterMockProcess mock;
+    if (!mock.Start (mockBatch))
+      {
+        return false;
+      }
+
+    std::map<std::string,Ptr<Node>> nodes;
+    Ptr<OpenCDAClient> client = CreateObjectWithAttributes<OpenCDAClient> (
+      "CARLAManual", BooleanValue (true),
+      "OpenCDAManual", BooleanValue (true),
+      "OpenCDACIPort", UintegerValue (mock.GetPort ()),
+      "UpdateInterval", DoubleValue (0.05),
+      "BatchedTimeStep", BooleanValue (batchedStep),
+      "AsyncTimeStep", BooleanValue (asyncStep));
+
+    client->startCarlaAdapter ([&nodes] (std::string id) {
+      Ptr<Node> node = CreateObject<Node> ();
+      node->AggregateObject (CreateObject<ConstantPositionMobilityModel> ());
+      nodes[id] = node;
+      return node;
+    }, [] (Ptr<Node> node, std::string id) {});
+
+    if (sensorLike)
+      {
+        for (Time t = MilliSeconds (125); t < sampleTime - MilliSeconds (50); t += MilliSeconds (50))
+          {
+            Simulator::Schedule (t, [client, &result] () {SensorLikeUpdate (client, result);});
+          }
+      }
+
+    Simulator::Schedule (sampleTime, [&nodes, &client, &result] () {
+      result.earlyJoins = client->getEarlyStepJoins ();
+      result.asyncStep = client->isAsyncTimeStep ();
+      for (auto &entry : nodes)
+        {
+          result.positions[std::stoi (entry.first)] = entry.second->GetObject<MobilityModel> ()->GetPosition ();
+        }
+      carla::ActorIds cavs = client->GetManagedCAVsIds ();
+      for (int i = 0; i < cavs.actorid_size (); i++)
+        {
+          carla::CAVObjects objects = client->getDetectedObjectsGeo (cavs.actorid (i));
+          auto &detected = result.detected[cavs.actorid (i)];
+          for (int j = 0; j < objects.objects_size (); j++)
+            {
+              detected[objects.objects (j).object ().id ()] = std::make_pair (objects.objects (j).latitude (), objects.objects (j).longitude ());
+            }
+        }
+    });
+    Simulator::Stop (sampleTime + MilliSeconds (1));
+    Simulator::Run ();
+    Simulator::Destroy ();
+    client = nullptr;
+
+    result.rpcCount = mock.Stop ();
+    return true;
+  }
+}
+
+// The batched time step (ExecuteOneTimeStepBatch) and the fallback to one RPC per actor, used when the OpenCDA Control
+// Interface does not implement it, give the same positions and detected objects
+class OpenCDAClientFallbackTestCase : public TestCase
+{
+public:
+  OpenCDAClientFallbackTestCase ();
+  virtual ~OpenCDAClientFallbackTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+OpenCDAClientFallbackTestCase::OpenCDAClientFallbackTestCase ()
+  : TestCase ("OpenCDAClient batched time step and fallback to the per-actor RPCs against the CarlaAdapter mock")
+{
+}
+
+OpenCDAClientFallbackTestCase::~OpenCDAClientFallbackTestCase ()
+{
+}
+
+void
+OpenCDAClientFallbackTestCase::DoRun (void)
+{
+  if (!CarlaAdapterMockProcess::IsAvailable ())
+    {
+      std::cout << "python3 with grpcio and protobuf is not available: skipping " << GetName () << std::endl;
+      return;
+    }
+
+  // The first step is executed at 50 ms, then one step every 50 ms: 20 steps are applied at the sampling time
+  const Time sampleTime = MilliSeconds (1025);
+  const int steps = 20;
+  MockRunResult batched, fallback;
+  NS_TEST_ASSERT_MSG_EQ (RunAgainstMock (true, true, false, false, sampleTime, batched), true, "Cannot start the CarlaAdapter mock");
+  NS_TEST_ASSERT_MSG_EQ (RunAgainstMock (false, true, false, false, sampleTime, fallback), true, "Cannot start the CarlaAdapter mock");
+
+  // Each path has really been taken
+  NS_TEST_EXPECT_MSG_EQ (batched.rpcCount["ExecuteOneTimeStepBatch"], steps, "Wrong number of batched steps");
+  NS_TEST_EXPECT_MSG_EQ (batched.rpcCount["ExecuteOneTimeStep"], 0, "The batched run used the per-actor RPCs");
+  NS_TEST_EXPECT_MSG_EQ (batched.rpcCount["GetGeo"], 0, "The batched run converted the detected objects one by one");
+  NS_TEST_EXPECT_MSG_EQ (fallback.rpcCount["ExecuteOneTimeStepBatch"], 1, "The client did not fall back after UNIMPLEMENTED");
+  NS_TEST_EXPECT_MSG_EQ (fallback.rpcCount["ExecuteOneTimeStep"], steps, "Wrong number of steps after the fallback");
+  NS_TEST_EXPECT_MSG_GT (fallback.rpcCount["GetActorLDM"], 0, "The fallback run did not read the LDMs");
+
+  // Mock vehicle i (ID i + 1) starts at x = 10 * (i / 3) on lane i % 3, with a speed of 8 + 2 * (i % 3) m/s
+  NS_TEST_ASSERT_MSG_EQ (batched.positions.size (), 10, "Wrong number of vehicles in the batched run");
+  NS_TEST_ASSERT_MSG_EQ (fallback.positions.size (), 10, "Wrong number of vehicles in the fallback run");
+  for (auto &entry : batched.positions)
+    {
+      int i = entry.first - 1;
+      double x = 10.0 * (i / 3) + (8.0 + 2.0 * (i % 3)) * 0.05 * steps;
+      NS_TEST_EXPECT_MSG_EQ_TOL (entry.second.x, x, 1e-6, "Wrong position of vehicle " << entry.first << " in the batched run");
+      NS_TEST_EXPECT_MSG_EQ_TOL (entry.second.y, 3.5 * (i % 3), 1e-6, "Wrong lane of vehicle " << entry.first << " in the batched run");
+      NS_TEST_EXPECT_MSG_EQ_TOL (fallback.positions[entry.first].x, x, 1e-6, "Wrong position of vehicle " << entry.first << " in the fallback run");
+      NS_TEST_EXPECT_MSG_EQ_TOL (fallback.positions[entry.first].y, 3.5 * (i % 3), 1e-6, "Wrong lane of vehicle " << entry.first << " in the fallback run");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (batched.detected.size (), 3, "Wrong number of CAVs");
+  for (auto &cav : batched.detected)
+    {
+      auto &other = fallback.detected[cav.first];
+      NS_TEST_EXPECT_MSG_GT (cav.second.size (), 0, "CAV " << cav.first << " did not detect any object");
+      NS_TEST_ASSERT_MSG_EQ (other.size (), cav.second.size (), "Different objects detected by CAV " << cav.first);
+      for (auto &object : cav.second)
+        {
+          NS_TEST_ASSERT_MSG_EQ (other.count (object.first), 1, "Object " << object.first << " not detected by CAV " << cav.first << " in the fallback run");
+          NS_TEST_EXPECT_MSG_EQ_TOL (other[object.first].first, object.second.first, 1e-9, "Different latitude of object " << object.first);
+          NS_TEST_EXPECT_MSG_EQ_TOL (other[object.first].second, object.second.second, 1e-9, "Different longitude of object " << object.first);
+        }
+    }
+}
+
+// With the asynchronous time step, the queries and the LDM updates of an OpenCDASensor, performed while the next step is
+// being computed, give the same results of the synchronous time step, without waiting for that step
+class OpenCDAClientAsyncTestCase : public TestCase
+{
+public:
+  OpenCDAClientAsyncTestCase ();
+  virtual ~OpenCDAClientAsyncTestCase ();
+
+private:
+  virtual void DoRun (void);
+  // The asynchronous run saw exactly what the synchronous one saw
+  void CheckSameResults (MockRunResult &sync, MockRunResult &async, const std::string &mode);
+};
+
+OpenCDAClientAsyncTestCase::OpenCDAClientAsyncTestCase ()
+  : TestCase ("OpenCDAClient asynchronous and synchronous time steps against the CarlaAdapter mock")
+{
+}
+
+OpenCDAClientAsyncTestCase::~OpenCDAClientAsyncTestCase ()
+{
+}
+
+void
+OpenCDAClientAsyncTestCase::CheckSameResults (MockRunResult &sync, MockRunResult &async, const std::string &mode)
+{
+  NS_TEST_EXPECT_MSG_EQ (async.earlyJoins, 0, "The sensor queries waited for the step being computed (" << mode << ")");
+  NS_TEST_EXPECT_MSG_EQ (async.rpcCount["GetManagedActorById"], sync.rpcCount["GetManagedActorById"], "Different reads of the ego vehicle (" << mode << ")");
+  // The last objects are queued at 925 ms and sent at the 950 ms step
+  NS_TEST_EXPECT_MSG_EQ (async.rpcCount["InsertObjects"], sync.rpcCount["InsertObjects"], "Some inserted objects were lost (" << mode << ")");
+
+  NS_TEST_ASSERT_MSG_EQ (async.sensorLog.size (), sync.sensorLog.size (), "Wrong number of sensor updates (" << mode << ")");
+  for (size_t i = 0; i < sync.sensorLog.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (async.sensorLog[i], sync.sensorLog[i], "Different results of the sensor update " << i << " (" << mode << ")");
+    }
+  NS_TEST_ASSERT_MSG_EQ (async.positions.size (), sync.positions.size (), "Different number of vehicles (" << mode << ")");
+  for (auto &entry : sync.positions)
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (async.positions[entry.first].x, entry.second.x, 1e-6, "Different position of vehicle " << entry.first << " (" << mode << ")");
+    }
+  NS_TEST_EXPECT_MSG_EQ ((async.detected == sync.detected), true, "Different objects detected at the sampling time (" << mode << ")");
+}
+
+void
+OpenCDAClientAsyncTestCase::DoRun (void)
+{
+  if (!CarlaAdapterMockProcess::IsAvailable ())
+    {
+      std::cout << "python3 with grpcio and protobuf is not available: skipping " << GetName () << std::endl;
+      return;
+    }
+
+  const Time sampleTime = MilliSeconds (1025);
+  const int steps = 20;
+
+  // Batched step: the queries are answered from the result of the last step, while the next one is being computed
+  MockRunResult sync, async;
+  NS_TEST_ASSERT_MSG_EQ (RunAgainstMock (true, true, false, true, sampleTime, sync), true, "Cannot start the CarlaAdapter mock");
+  NS_TEST_ASSERT_MSG_EQ (RunAgainstMock (true, true, true, true, sampleTime, async), true, "Cannot start the CarlaAdapter mock");
+
+  NS_TEST_EXPECT_MSG_EQ (async.asyncStep, true, "The asynchronous step was disabled with the batched step");
+  NS_TEST_EXPECT_MSG_EQ (async.rpcCount["GetActorLDMGeo"], 0, "The LDM was not read from the last step");
+  CheckSameResults (sync, async, "batched step");
+
+  // Mock without ExecuteOneTimeStepBatch (--no-batch), with the automatic fallback and with BatchedTimeStep=false: the
+  // per-actor queries cannot be answered from the last step, so the asynchronous step is disabled, and the results are
+  // the synchronous ones
+  MockRunResult legacySync, legacyFallback, legacyAsync;
+  NS_TEST_ASSERT_MSG_EQ (RunAgainstMock (false, true, false, true, sampleTime, legacySync), true, "Cannot start the CarlaAdapter mock");
+  NS_TEST_ASSERT_MSG_EQ (RunAgainstMock (false, true, true, true, sampleTime, legacyFallback), true, "Cannot start the CarlaAdapter mock");
+  NS_TEST_ASSERT_MSG_EQ (RunAgainstMock (false, false, true, true, sampleTime, legacyAsync), true, "Cannot start the CarlaAdapter mock");
+
+  NS_TEST_EXPECT_MSG_EQ (legacyFallback.asyncStep, false, "The asynchronous step was not disabled after the fallback");
+  NS_TEST_EXPECT_MSG_EQ (legacyAsync.asyncStep, false, "The asynchronous step was not disabled without the batched step");
+  NS_TEST_EXPECT_MSG_EQ (legacyFallback.rpcCount["ExecuteOneTimeStepBatch"], 1, "The client did not fall back after UNIMPLEMENTED");
+  NS_TEST_EXPECT_MSG_EQ (legacyFallback.rpcCount["ExecuteOneTimeStep"], steps, "Wrong number of steps after the fallback");
+  NS_TEST_EXPECT_MSG_EQ (legacyAsync.rpcCount["ExecuteOneTimeStepBatch"], 0, "The batched step was used with BatchedTimeStep=false");
+  NS_TEST_EXPECT_MSG_EQ (legacyAsync.rpcCount["ExecuteOneTimeStep"], steps, "Wrong number of steps without the batched step");
+  CheckSameResults (legacySync, legacyFallback, "fallback");
+  CheckSameResults (legacySync, legacyAsync, "BatchedTimeStep=false");
+}
+
+class CarlaTestSuite : public TestSuite
+{
+public:
+  CarlaTestSuite ();
+};
+
+CarlaTestSuite::CarlaTestSuite ()
+  : TestSuite ("carla-opencda-client", UNIT)
+{
+  AddTestCase (new OpenCDAClientFallbackTestCase, TestCase::QUICK);
+  AddTestCase (new OpenCDAClientAsyncTestCase, TestCase::QUICK);
+}
+
+static CarlaTestSuite carlaTestSuite;
@@ -22,33 +22,212 @@
 #include "gps-tc-helper.h"
 #include <iomanip>
 #include <climits>
-
-extern "C" {
-    #include "ns3/utmups.h"
-}
+#include <cfloat>
+#include <cstring>
+#include <charconv>
+#include <string_view>
+#include <unordered_map>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <ctime>
+#include <cstdlib>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "ns3/tm-projection.h"
 
 #define UNAVAIL_IDX_ACCEL -INT_MAX
 
+// Size of the chunks in which the CSV file is split to be parsed (possibly by multiple threads)
+// It does not depend on the number of threads, so that the result is always the same
+#define GPS_TC_CHUNK_SIZE (16*1024*1024)
+
+// The cached points depend on the Transverse Mercator implementation: change the version when it changes
+#define GPS_TC_CACHE_VERSION 2
+
+// Number of points projected together by TMProjection
+#define GPS_TC_PROJECTION_BATCH 256
+
 namespace {
-    std::vector<std::string> getNextLineAndSplitIntoTokens(std::string row)
+    // Read-only memory mapping of a whole file
+    class MappedFile
+    {
+      public:
+        ~MappedFile()
+        {
+          if(m_data!=nullptr && m_data!=MAP_FAILED)
+          {
+            munmap(m_data,m_size);
+          }
+          if(m_fd>=0)
+          {
+            close(m_fd);
+          }
+        }
+
+        bool open(const std::string &filepath)
+        {
+          m_fd=::open(filepath.c_str(),O_RDONLY);
+          if(m_fd<0 || fstat(m_fd,&m_stat)<0)
+          {
+            return false;
+          }
+
+          m_size=m_stat.st_size;
+          if(m_size==0)
+          {
+            return true;
+          }
+
+          m_data=mmap(nullptr,m_size,PROT_READ,MAP_PRIVATE,m_fd,0);
+          if(m_data==MAP_FAILED)
+          {
+            return false;
+          }
+          madvise(m_data,m_size,MADV_SEQUENTIAL);
+          return true;
+        }
+
+        const char *data() const {return m_size==0 ? "" : static_cast<const char *>(m_data);}
+        size_t size() const {return m_size;}
+        int64_t mtime() const {return (int64_t) m_stat.st_mtim.tv_sec*1000000000LL + m_stat.st_mtim.tv_nsec;}
+
+      private:
+        int m_fd=-1;
+        void *m_data=nullptr;
+        size_t m_size=0;
+        struct stat m_stat={};
+    };
+
+    // Split a CSV line into its fields, without any copy
+    // As before, a trailing comma with no data after it results in an additional empty field
+    void splitFields(std::string_view line, std::vector<std::string_view> &fields)
+    {
+        fields.clear();
+
+        size_t start=0;
+        for(size_t comma=line.find(','); comma!=std::string_view::npos; comma=line.find(',',start))
+        {
+            fields.push_back(line.substr(start,comma-start));
+            start=comma+1;
+        }
+        fields.push_back(line.substr(start));
+    }
+
+    // Get the next line in [p,end), without the line terminator, and move p after it
+    std::string_view nextLine(const char *&p, const char *end)
     {
-        std::vector<std::string>   result;
+        const char *nl=static_cast<const char *>(memchr(p,'\n',end-p));
+        const char *le=nl!=nullptr ? nl : end;
+        std::string_view line(p,le-p);
+
+        p=nl!=nullptr ? nl+1 : end;
+
+        if(!line.empty() && line.back()=='\r')
+        {
+            line.remove_suffix(1);
+        }
+        return line;
+    }
 
-        std::stringstream          lineStream(row);
-        std::string                cell;
+    // Convert a numeric field with std::from_chars(), accepting (as std::stod() did) leading spaces and an explicit '+' sign
+    bool parseDouble(std::string_view field, double &value)
+    {
+        const char *first=field.data();
+        const char *last=field.data()+field.size();
 
-        while(std::getline(lineStream,cell, ','))
+        while(first<last && isspace(static_cast<unsigned char>(*first)))
+        {
+            first++;
+        }
+        if(first<last && *first=='+')
         {
-            result.push_back(cell);
+            first++;
         }
-        // This checks for a trailing comma with no data after it
-        if (!lineStream && cell.empty())
+
+        return std::from_chars(first,last,value).ec==std::errc();
+    }
+
+    // Run fcn(i), for i in [0,n), on up to num_threads threads
+    template<typename F>
+    void runParallel(size_t n, unsigned int num_threads, F fcn)
+    {
+        if(num_threads<=1 || n<=1)
         {
-            // If there was a trailing comma then add an empty element
-            result.push_back("");
+            for(size_t i=0;i<n;i++)
+            {
+                fcn(i);
+            }
+            return;
         }
 
-        return result;
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> threads;
+        for(unsigned int t=0;t<std::min<size_t>(num_threads,n);t++)
+        {
+            threads.emplace_back([&next,n,&fcn]() {
+                for(size_t i=next++;i<n;i=next++)
+                {
+                    fcn(i);
+                }
+            });
+        }
+        for(auto &thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    // Portion of the CSV file, made of complete lines
+    typedef struct _trace_chunk {
+        const char *begin;
+        const char *end;
+
+        // Vehicles appearing in this chunk, in order of first appearance
+        std::vector<std::string_view> veh_ids;
+        std::vector<std::string_view> veh_types;
+        std::vector<uint64_t> veh_counts;
+        // Index (in veh_ids) of the vehicle of each data line
+        std::vector<uint32_t> line_veh;
+
+        double sum_lat;
+        double sum_lon;
+
+        // Index of each vehicle of this chunk in trace_data_t::vehicles, and position of its first point of this chunk
+        std::vector<uint32_t> global_idx;
+        std::vector<uint64_t> offsets;
+    } trace_chunk_t;
+
+    template<typename T>
+    void writeBin(std::ofstream &out, const T &value)
+    {
+        out.write(reinterpret_cast<const char *>(&value),sizeof(T));
+    }
+
+    void writeBinString(std::ofstream &out, const std::string &str)
+    {
+        writeBin<uint32_t>(out,str.size());
+        out.write(str.data(),str.size());
+    }
+
+    template<typename T>
+    bool readBin(std::ifstream &in, T &value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char *>(&value),sizeof(T)));
+    }
+
+    bool readBinString(std::ifstream &in, std::string &str)
+    {
+        uint32_t size;
+        if(!readBin(in,size))
+        {
+            return false;
+        }
+        str.resize(size);
+        return static_cast<bool>(in.read(&str[0],size));
     }
 }
 namespace ns3 {
@@ -73,84 +252,101 @@ namespace ns3 {
         m_heading_180 = false;
         m_start_date = {.tm_year=2004,.tm_mon=1,.tm_mday=1};
         m_interpolate = false;
+        m_use_cache = false;
+        m_cache_dir = ".";
+        m_loader_threads = 1;
+        m_streaming = false;
+        m_stream_window_points = 4096;
     }
 
-    std::tuple<double,double> GPSTraceClientHelper::getAverageLatLon(std::ifstream &inFileStream)
+    void GPSTraceClientHelper::traceFormatError(const std::string &msg)
     {
-        std::string line;
-        std::vector<std::string> result;
-
-        int idx_lat = -1;
-        int idx_lon = -1;
+        if(m_vehicle_vis_ptr!=nullptr)
+        {
+          m_vehicle_vis_ptr->terminateServer ();
+        }
 
-        double lat0=0;
-        double lon0=0;
+        NS_FATAL_ERROR (msg);
+    }
 
-        // Get the lat and lon indeces from the header
-        std::getline(inFileStream, line);
-        std::istringstream header_iss(line);
-        result = getNextLineAndSplitIntoTokens(line);
+    double GPSTraceClientHelper::dateToTimestamp(std::string date) const
+    {
+        int millisec = 0;
+        double tstamp_dbl;
 
-        for(unsigned int i=0;i<result.size ();i++)
+        // Look if milliseconds are specified (%MSEC can be specified only at the end of the string)
+        std::size_t found = m_date_format.find("%MSEC");
+        if(found != std::string::npos)
         {
-            if(result[i] == m_col_name_lat)
-            {
-                idx_lat = i;
-            }
-            else if(result[i] == m_col_name_lon)
+            // %MSEC can only be specified at the end of the date format string
+            if(m_date_format.size () -1 > found + 4)
             {
-                idx_lon = i;
+                NS_FATAL_ERROR("Error. Wrong timestamp string format. %MSEC can only be specified at the end of the format string.");
             }
-        }
 
-        if(idx_lat == -1 ||
-           idx_lon == -1)
-          {
-            if(m_vehicle_vis_ptr!=nullptr)
+            // Only milliseconds are specified -> just convert them directly from the value read from the CSV file in the timestamps column
+            if(found == 0)
             {
-              m_vehicle_vis_ptr->terminateServer ();
+                millisec = std::stoi(date);
             }
+            // milliseconds are specified with something else -> extract the milliseconds from the string read from the CSV file
+            else
+            {
+              // Get the separator separating the milliseconds from the rest of the time/date
+              char separator = m_date_format.c_str ()[found - 1];
 
-            NS_FATAL_ERROR ("Error while reading the GPS Trace file. Some columns appear to be missing. Please check the file format.");
-          }
+              // Find the position og the separator at the end of the timestamp string read from the CSV file
+              std::size_t msec_pos = date.find_last_of (separator);
+
+              if(msec_pos == std::string::npos)
+              {
+                  NS_FATAL_ERROR("Error. Wrong timestamp string format. Cannot match date format with CSV file data.");
+              }
 
+              // Extract and convert the milliseconds value from the string read from the CSV file
+              std::string msec_str = date.substr (msec_pos+1,date.size()-msec_pos-1);
+              millisec = std::stoi(msec_str);
 
-        // Compute the reference longitude (lon0) to center the Transverse Mercator projection on
-        // It is computed as the average between all the longitude values in the trace file, in order
-        // to try to minimize the overall average error due to the projection
-        int linecount=0;
-        while (std::getline(inFileStream, line))
+              // As we have read the milliseconds value, modify the string read from the CSV file by removing the milliseconds value (+ its separator)
+              date.erase(msec_pos,date.size()-msec_pos);
+            }
+        }
+
+        // If milliseconds are not specified alone (or are not specified at all), convert the date/time value into a timestamp
+        if(found != 0)
         {
-            std::istringstream iss(line);
-            result = getNextLineAndSplitIntoTokens(line);
+          std::tm tm = {};
+          std::istringstream timess(date);
+          timess >> std::get_time(&tm,m_date_format.c_str ());
 
-            double curr_lat=std::stod(result[idx_lat]);
-            double curr_lon=std::stod(result[idx_lon]);
+          if(timess.fail())
+          {
+              NS_FATAL_ERROR ("Cannot convert a date in the CSV file to a timestamp format. Issue occurred with date: " << date);
+          }
 
-            linecount++;
+          if(tm.tm_year==0)
+          {
+              // Convert the values from the "human-readable" dateyear_t structure (i.e. years from 0, months 1-12, days 1-31)
+              // to the std::tm data format (i.e. years relative with respect to 1900, months 0-11, days 1-31)
+              tm.tm_year = m_start_date.tm_year-1900;
+              tm.tm_mon = m_start_date.tm_mon-1;
+              tm.tm_mday = m_start_date.tm_mday;
+          }
 
-            // Computing the "running" average as we get samples, instead of summing up a very large value and then dividing by linecount
-            lat0+=(curr_lat-lat0)/linecount;
-            lon0+=(curr_lon-lon0)/linecount;
+          tstamp_dbl = ((double) mktime(&tm)) + ((double) millisec)/1000.0;
+        }
+        else
+        {
+          tstamp_dbl = ((double) millisec)/1000.0;
         }
 
-        // "Rewind" the file, in order to read it if needed
-        inFileStream.clear();
-        inFileStream.seekg(0);
-
-        return std::tuple<double,double>(lat0,lon0);
+        return tstamp_dbl;
     }
 
-    std::map<std::string,GPSTraceClient*> GPSTraceClientHelper::createTraceClientsFromCSV(std::string filepath)
+    void GPSTraceClientHelper::parseCSV(const char *data, size_t size, trace_data_t &trace)
     {
-      // Variables to read the file
-      std::ifstream              inFile;
-      std::string                line;
-      std::vector<std::string>   result;
-
-      // Variables to scan each row of the file
-      std::string currentVehId;
-      std::map<std::string,GPSTraceClient*> m_GPSTraceClient;
+      const char *p = data;
+      const char *end = data + size;
 
       // Field indeces
       int m_idx_vehid = -1;
@@ -162,24 +358,10 @@ namespace ns3 {
       int m_idx_heading_deg = -1;
       int m_idx_accel = -1;
 
-      // GeographicLib (C adaptation) pre-initialized Transverse Mercator structure
-      transverse_mercator_t tmerc=UTMUPS_init_UTM_TransverseMercator ();
-
-      inFile.open(filepath);
-      if (!inFile) {
-          NS_FATAL_ERROR("Unable to open the file: "<<filepath);
-      }
-
-      std::tuple<double,double> latlon0 = getAverageLatLon (inFile);
-
-      double lat0 = std::get<0>(latlon0);
-      double lon0 = std::get<1>(latlon0);
-
       // Get the indeces of the different fields from the CSV header, i.e. find out
       // in which columns the needed data is saved inside the CSV file
-      std::getline(inFile, line);
-      std::istringstream header_iss(line);
-      result = getNextLineAndSplitIntoTokens(line);
+      std::vector<std::string_view> result;
+      splitFields(nextLine(p,end),result);
 
       for(unsigned int i=0;i<result.size ();i++)
       {
@@ -233,198 +415,458 @@ namespace ns3 {
          m_idx_heading_deg == -1 ||
          m_idx_accel == -1)
         {
-          if(m_vehicle_vis_ptr!=nullptr)
-          {
-            m_vehicle_vis_ptr->terminateServer ();
-          }
-
-          NS_FATAL_ERROR ("Error while reading the GPS Trace file. Some columns appear to be missing. Please check the file format.");
+          traceFormatError ("Error while reading the GPS Trace file. Some columns appear to be missing. Please check the file format.");
         }
 
-      double min_tm_x=DBL_MAX;
-      double min_tm_y=DBL_MAX;
+      size_t min_fields = std::max({m_idx_vehid,m_idx_type,m_idx_tstamp,m_idx_lat,m_idx_lon,m_idx_speed,m_idx_heading_deg,m_idx_accel}) + 1;
+      trace.accel_available = m_idx_accel != UNAVAIL_IDX_ACCEL;
 
-      // Read the file line by line and, for each line, gather the values stored inside each column (stored inside "result")
-      while (std::getline(inFile, line))
+      // Split the rest of the file into chunks of complete lines
+      std::vector<trace_chunk_t> chunks;
+      while(p < end)
       {
-          std::istringstream iss(line);
-          result = getNextLineAndSplitIntoTokens(line);
-
-          // Get the vehicle id
-          currentVehId = result[m_idx_vehid];
-          // Check if the element is present in the map m_GPSTraceClient
-          if ( m_GPSTraceClient.find(currentVehId) == m_GPSTraceClient.end() ) {
-            // Not found - need to create the entry for such a vector
-            std::string type = result[m_idx_type];
-            if (type != "car" && type != "vru")
-              {
-                NS_FATAL_ERROR ("Only car and vru types are supported. Please check the file format.");
-              }
-            GPSTraceClient* gpsclient = new GPSTraceClient(currentVehId, type);
-            gpsclient->setLat0 (lat0);
-            gpsclient->setLon0 (lon0);
-            if(m_vehicle_vis_ptr!=nullptr && m_vehicle_vis_ptr->isConnected())
-            {
-              gpsclient->setVehicleVisualizer (m_vehicle_vis_ptr);
-            }
-            m_GPSTraceClient.insert(std::make_pair(currentVehId, gpsclient));
+          trace_chunk_t chunk = {};
+          chunk.begin = p;
+          if((size_t) (end - p) <= GPS_TC_CHUNK_SIZE)
+          {
+              p = end;
+          }
+          else
+          {
+              const char *nl = static_cast<const char *>(memchr(p + GPS_TC_CHUNK_SIZE,'\n',end - p - GPS_TC_CHUNK_SIZE));
+              p = nl != nullptr ? nl + 1 : end;
           }
+          chunk.end = p;
+          chunks.push_back(std::move(chunk));
+      }
 
-          for (auto it = m_GPSTraceClient.begin(); it != m_GPSTraceClient.end(); ++it)
-            {
-              it->second->SetInputMicroseconds(m_use_microseconds);
-            }
+      // First pass: count the points of each vehicle and compute the average latitude and longitude
+      runParallel(chunks.size(),m_loader_threads,[&](size_t c) {
+          trace_chunk_t &chunk = chunks[c];
+          std::unordered_map<std::string_view,uint32_t> local_ids;
+          std::vector<std::string_view> fields;
+          const char *q = chunk.begin;
 
-          double lat=std::stod(result[m_idx_lat]);
-          double lon=std::stod(result[m_idx_lon]);
-          double tm_x,tm_y,tm_gamma,tm_kappa;
+          while(q < chunk.end)
+          {
+              std::string_view line = nextLine(q,chunk.end);
+              if(line.empty())
+              {
+                  continue;
+              }
 
-          // Project lat and lon to a Cartesian Plane using Transverse Mercator
-          TransverseMercator_Forward (&tmerc,lon0,lat,lon,&tm_x,&tm_y,&tm_gamma,&tm_kappa);
+              splitFields(line,fields);
+              if(fields.size() < min_fields)
+              {
+                  NS_FATAL_ERROR ("Error while reading the GPS Trace file. Malformed line: " << line);
+              }
 
-          m_GPSTraceClient[currentVehId]->setLon0(lon0); // To allow later on to perform TransverseMercator_forward
+              auto id_it = local_ids.find(fields[m_idx_vehid]);
+              if(id_it == local_ids.end())
+              {
+                  id_it = local_ids.emplace(fields[m_idx_vehid],chunk.veh_ids.size()).first;
+                  chunk.veh_ids.push_back(fields[m_idx_vehid]);
+                  chunk.veh_types.push_back(fields[m_idx_type]);
+                  chunk.veh_counts.push_back(0);
+              }
+              chunk.veh_counts[id_it->second]++;
+              chunk.line_veh.push_back(id_it->second);
+
+              double curr_lat,curr_lon;
+              if(!parseDouble(fields[m_idx_lat],curr_lat) || !parseDouble(fields[m_idx_lon],curr_lon))
+              {
+                  NS_FATAL_ERROR ("Error while reading the GPS Trace file. Invalid latitude or longitude in line: " << line);
+              }
+              chunk.sum_lat += curr_lat;
+              chunk.sum_lon += curr_lon;
+          }
+      });
 
-          //std::cout<<"Converted ("<<lat<<","<<lon<<") into ("<<tm_x<<","<<tm_y<<") [reflon:"<<lon0<<"]"<<std::endl;
+      // Merge the vehicles of all the chunks, in order, and reserve the exact space for their points
+      std::unordered_map<std::string_view,uint32_t> global_ids;
+      std::vector<uint64_t> global_counts;
+      uint64_t linecount = 0;
+      double sum_lat = 0;
+      double sum_lon = 0;
 
-          /* Save the info of this line of CSV */
-          // String which contains a POSIX timestamp, in seconds since epoch (floating point to include also milli or microseconds)
-          std::string tstamp;
+      for(trace_chunk_t &chunk : chunks)
+      {
+          chunk.global_idx.resize(chunk.veh_ids.size());
+          chunk.offsets.resize(chunk.veh_ids.size());
 
-          // Convert a date format into a timestamp format, if needed
-          if(m_tstamp_is_date == true)
+          for(size_t v=0;v<chunk.veh_ids.size();v++)
           {
-              int millisec = 0;
-              double tstamp_dbl;
-
-              // Look if milliseconds are specified (%MSEC can be specified only at the end of the string)
-              std::size_t found = m_date_format.find("%MSEC");
-              if(found != std::string::npos)
+              auto id_it = global_ids.find(chunk.veh_ids[v]);
+              if(id_it == global_ids.end())
               {
-                  // %MSEC can only be specified at the end of the date format string
-                  if(m_date_format.size () -1 > found + 4)
+                  if(chunk.veh_types[v] != "car" && chunk.veh_types[v] != "vru")
                   {
-                      NS_FATAL_ERROR("Error. Wrong timestamp string format. %MSEC can only be specified at the end of the format string.");
+                      traceFormatError ("Only car and vru types are supported. Please check the file format.");
                   }
 
-                  // Only milliseconds are specified -> just convert them directly from the value read from the CSV file in the timestamps column
-                  if(found == 0)
-                  {
-                      millisec = std::stoi(result[m_idx_tstamp]);
-                  }
-                  // milliseconds are specified with something else -> extract the milliseconds from the string read from the CSV file
-                  else
-                  {
-                    // Get the separator separating the milliseconds from the rest of the time/date
-                    char separator = m_date_format.c_str ()[found - 1];
+                  id_it = global_ids.emplace(chunk.veh_ids[v],trace.vehicles.size()).first;
+                  trace.vehicles.push_back({std::string(chunk.veh_ids[v]),std::string(chunk.veh_types[v]),{}});
+                  global_counts.push_back(0);
+              }
 
-                    // Find the position og the separator at the end of the timestamp string read from the CSV file
-                    std::size_t msec_pos = result[m_idx_tstamp].find_last_of (separator);
+              chunk.global_idx[v] = id_it->second;
+              chunk.offsets[v] = global_counts[id_it->second];
+              global_counts[id_it->second] += chunk.veh_counts[v];
+          }
 
-                    if(msec_pos == std::string::npos)
-                    {
-                        NS_FATAL_ERROR("Error. Wrong timestamp string format. Cannot match date format with CSV file data.");
-                    }
+          linecount += chunk.line_veh.size();
+          sum_lat += chunk.sum_lat;
+          sum_lon += chunk.sum_lon;
+      }
 
-                    // Extract and convert the milliseconds value from the string read from the CSV file
-                    std::string msec_str = result[m_idx_tstamp].substr (msec_pos+1,result[m_idx_tstamp].size()-msec_pos-1);
-                    millisec = std::stoi(msec_str);
+      for(size_t v=0;v<trace.vehicles.size();v++)
+      {
+          trace.vehicles[v].data.resize(global_counts[v]);
+      }
 
-                    // As we have read the milliseconds value, modify the string read from the CSV file by removing the milliseconds value (+ its separator)
-                    result[m_idx_tstamp].erase(msec_pos,result[m_idx_tstamp].size()-msec_pos);
-                  }
-              }
+      // Compute the reference longitude (lon0) to center the Transverse Mercator projection on
+      // It is computed as the average between all the longitude values in the trace file, in order
+      // to try to minimize the overall average error due to the projection
+      trace.lat0 = linecount > 0 ? sum_lat/linecount : 0;
+      trace.lon0 = linecount > 0 ? sum_lon/linecount : 0;
 
-              // If milliseconds are not specified alone (or are not specified at all), convert the date/time value into a timestamp
-              if(found != 0)
+      // Second pass: parse all the fields, and write each point directly in its final position
+      runParallel(chunks.size(),m_loader_threads,[&](size_t c) {
+          trace_chunk_t &chunk = chunks[c];
+          std::vector<std::string_view> fields;
+          const char *q = chunk.begin;
+          size_t l = 0;
+
+          while(q < chunk.end)
+          {
+              std::string_view line = nextLine(q,chunk.end);
+              if(line.empty())
               {
-                std::tm tm = {};
-                std::istringstream timess(result[m_idx_tstamp]);
-                timess >> std::get_time(&tm,m_date_format.c_str ());
+                  continue;
+              }
 
-                if(timess.fail())
-                {
-                    NS_FATAL_ERROR ("Cannot convert a date in the CSV file to a timestamp format. Issue occurred with date: " << result[m_idx_tstamp]);
-                }
+              splitFields(line,fields);
 
-                if(tm.tm_year==0)
-                {
-                    // Convert the values from the "human-readable" dateyear_t structure (i.e. years from 0, months 1-12, days 1-31)
-                    // to the std::tm data format (i.e. years relative with respect to 1900, months 0-11, days 1-31)
-                    tm.tm_year = m_start_date.tm_year-1900;
-                    tm.tm_mon = m_start_date.tm_mon-1;
-                    tm.tm_mday = m_start_date.tm_mday;
-                }
+              uint32_t local_idx = chunk.line_veh[l++];
+              GPSTraceClient::positioning_data_t &point = trace.vehicles[chunk.global_idx[local_idx]].data[chunk.offsets[local_idx]++];
+              point = {};
 
-                tstamp_dbl = ((double) mktime(&tm)) + ((double) millisec)/1000.0;
+              double tstamp_dbl;
+              if(m_tstamp_is_date == true)
+              {
+                  // Convert a date format into a timestamp format
+                  tstamp_dbl = dateToTimestamp(std::string(fields[m_idx_tstamp]));
               }
-              else
+              else if(!parseDouble(fields[m_idx_tstamp],tstamp_dbl))
               {
-                tstamp_dbl = ((double) millisec)/1000.0;
+                  NS_FATAL_ERROR ("Error while reading the GPS Trace file. Invalid timestamp in line: " << line);
+              }
+              // Convert from sec to us, if needed
+              point.utc_time = (long int) (m_use_microseconds ? tstamp_dbl : tstamp_dbl * 1000000);
+
+              bool ok = parseDouble(fields[m_idx_lat],point.lat) &&
+                        parseDouble(fields[m_idx_lon],point.lon) &&
+                        parseDouble(fields[m_idx_speed],point.speedms) &&
+                        parseDouble(fields[m_idx_heading_deg],point.heading);
+              if(ok && m_idx_accel != UNAVAIL_IDX_ACCEL)
+              {
+                  ok = parseDouble(fields[m_idx_accel],point.accelmsq);
+              }
+              if(!ok)
+              {
+                  NS_FATAL_ERROR ("Error while reading the GPS Trace file. Invalid numeric value in line: " << line);
               }
 
-              tstamp = std::to_string (tstamp_dbl);
-
-              NS_LOG_INFO("Converted date " << result[m_idx_tstamp] << " to timestamp " << tstamp);
+              // Only degrees between 0 and 360 degrees should be used for the heading in gps-tc
+              // If the user specified that the format used in the CSV file implies heading values between -180 and 180 degees
+              // perform the conversion to the range [0,360)
+              if(m_heading_180 == true)
+              {
+                  point.heading += 180.0;
+              }
           }
-          // If the timestamps are already provided as actual timestamps, in the CSV file, just set the "tstamp" string to the value
-          // read from the CSV file
-          else
+      });
+
+      // Project lat and lon of each vehicle to a Cartesian Plane using Transverse Mercator, in batches of points,
+      // find the minimum x and y values, and sort the points according to the timestamp
+      TMProjection tmerc(trace.lon0);
+      std::vector<double> veh_min_tm_x(trace.vehicles.size(),DBL_MAX);
+      std::vector<double> veh_min_tm_y(trace.vehicles.size(),DBL_MAX);
+
+      runParallel(trace.vehicles.size(),m_loader_threads,[&](size_t v) {
+          std::vector<GPSTraceClient::positioning_data_t> &data = trace.vehicles[v].data;
+          double lat[GPS_TC_PROJECTION_BATCH],lon[GPS_TC_PROJECTION_BATCH];
+          double tm_x[GPS_TC_PROJECTION_BATCH],tm_y[GPS_TC_PROJECTION_BATCH];
+
+          for(size_t start=0;start<data.size();start+=GPS_TC_PROJECTION_BATCH)
           {
-              tstamp = result[m_idx_tstamp];
+              size_t len = std::min<size_t>(GPS_TC_PROJECTION_BATCH,data.size()-start);
+
+              for(size_t i=0;i<len;i++)
+              {
+                  lat[i] = data[start+i].lat;
+                  lon[i] = data[start+i].lon;
+              }
+
+              tmerc.LonLatToXY(len,lon,lat,tm_x,tm_y);
+
+              for(size_t i=0;i<len;i++)
+              {
+                  data[start+i].tm_x = tm_x[i];
+                  data[start+i].tm_y = tm_y[i];
+                  veh_min_tm_x[v] = std::min(veh_min_tm_x[v],tm_x[i]);
+                  veh_min_tm_y[v] = std::min(veh_min_tm_y[v],tm_y[i]);
+              }
           }
 
-          m_GPSTraceClient[currentVehId]->setTimestamp(tstamp);
+          std::sort(data.begin(),data.end());
+      });
+
+      trace.min_tm_x = DBL_MAX;
+      trace.min_tm_y = DBL_MAX;
+      for(size_t v=0;v<trace.vehicles.size();v++)
+      {
+          trace.min_tm_x = std::min(trace.min_tm_x,veh_min_tm_x[v]);
+          trace.min_tm_y = std::min(trace.min_tm_y,veh_min_tm_y[v]);
+      }
+    }
+
+    std::string GPSTraceClientHelper::getCacheKey() const
+    {
+        // Everything affecting how the CSV file is parsed
+        std::ostringstream key;
+        key << m_col_name_vehid << ',' << m_col_type_agent << ',' << m_col_name_tstamp << ',' << m_col_name_lat << ','
+            << m_col_name_lon << ',' << m_col_name_speed << ',' << m_col_name_heading_deg << ',' << m_col_name_accel << ','
+            << m_tstamp_is_date << ',' << m_date_format << ',' << m_start_date.tm_year << '-' << m_start_date.tm_mon << '-'
+            << m_start_date.tm_mday << ',' << m_heading_180 << ',' << m_use_microseconds << ',' << sizeof(GPSTraceClient::positioning_data_t);
+
+        if(m_tstamp_is_date)
+        {
+            // The dates are converted with mktime(), i.e., in the local time zone
+            tzset();
+            const char *tz = getenv("TZ");
+            key << ',' << (tz!=nullptr ? tz : "") << ',' << tzname[0] << ',' << tzname[1] << ',' << timezone;
+        }
+        return key.str();
+    }
+
+    std::string GPSTraceClientHelper::getTraceCachePath(const std::string &filepath) const
+    {
+        // CSV files with the same name in different folders must not share the same cache file
+        char *abspath = realpath(filepath.c_str(),nullptr);
+        std::string path = abspath!=nullptr ? abspath : filepath;
+        free(abspath);
+
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ULL;
+        for(unsigned char c : path)
+        {
+            hash ^= c;
+            hash *= 1099511628211ULL;
+        }
+
+        std::ostringstream cachepath;
+        cachepath << m_cache_dir << '/' << path.substr(path.find_last_of('/')+1) << '-'
+                  << std::hex << std::setw(16) << std::setfill('0') << hash << ".gpstc";
+        return cachepath.str();
+    }
+
+    bool GPSTraceClientHelper::readTraceCache(const std::string &cachepath, uint64_t csv_size, int64_t csv_mtime, trace_data_t &trace, bool index_only)
+    {
+        std::ifstream in(cachepath,std::ios::in | std::ios::binary | std::ios::ate);
+        if(!in.is_open())
+        {
+            return false;
+        }
+        uint64_t cache_size = in.tellg();
+        in.seekg(0);
+
+        char magic[6];
+        uint16_t version;
+        uint64_t cached_size;
+        int64_t cached_mtime;
+        std::string key;
+        uint8_t accel_available;
+        uint32_t num_vehicles;
+
+        if(!in.read(magic,sizeof(magic)) || memcmp(magic,"MSVGTC",sizeof(magic))!=0 ||
+           !readBin(in,version) || version!=GPS_TC_CACHE_VERSION ||
+           !readBin(in,cached_size) || cached_size!=csv_size ||
+           !readBin(in,cached_mtime) || cached_mtime!=csv_mtime ||
+           !readBinString(in,key) || key!=getCacheKey())
+        {
+            NS_LOG_INFO("Outdated GPS trace cache file " << cachepath << ". The CSV file will be parsed again.");
+            return false;
+        }
 
-          m_GPSTraceClient[currentVehId]->setLat(result[m_idx_lat]);
-          m_GPSTraceClient[currentVehId]->setLon(result[m_idx_lon]);
+        if(!readBin(in,trace.lat0) || !readBin(in,trace.lon0) || !readBin(in,trace.min_tm_x) || !readBin(in,trace.min_tm_y) ||
+           !readBin(in,accel_available) || !readBin(in,num_vehicles))
+        {
+            return false;
+        }
+        trace.accel_available = accel_available;
 
-          m_GPSTraceClient[currentVehId]->setX(tm_x);
-          m_GPSTraceClient[currentVehId]->setY(tm_y);
+        trace.vehicles.resize(num_vehicles);
+        for(trace_vehicle_t &vehicle : trace.vehicles)
+        {
+            uint64_t num_points;
+            if(!readBinString(in,vehicle.id) || !readBinString(in,vehicle.type) || !readBin(in,num_points))
+            {
+                return false;
+            }
 
-          m_GPSTraceClient[currentVehId]->setSpeedms(result[m_idx_speed]);
+            vehicle.file_offset = in.tellg();
+            vehicle.num_points = num_points;
 
-          // Only degrees between 0 and 360 degrees should be used for the heading in gps-tc
-          std::string heading_str;
+            if(index_only)
+            {
+                // Skip the points, which will be read by the clients during playback
+                if(vehicle.file_offset+num_points*sizeof(GPSTraceClient::positioning_data_t)>cache_size)
+                {
+                    return false;
+                }
+                in.seekg(num_points*sizeof(GPSTraceClient::positioning_data_t),std::ios::cur);
+                continue;
+            }
 
-          // If the user specified that the format used in the CSV file implies heading values between -180 and 180 degees
-          // perform the conversion to the range [0,360) before setting the values inside the GPS Trace Client object
-          if(m_heading_180 == true)
+            vehicle.data.resize(num_points);
+            if(!in.read(reinterpret_cast<char *>(vehicle.data.data()),num_points*sizeof(GPSTraceClient::positioning_data_t)))
+            {
+                return false;
+            }
+        }
+
+        trace.index_only = index_only;
+        return true;
+    }
+
+    void GPSTraceClientHelper::writeTraceCache(const std::string &cachepath, uint64_t csv_size, int64_t csv_mtime, const trace_data_t &trace)
+    {
+        // The cache file is written with a temporary name and then renamed, so that a partially written cache is never used
+        std::string tmppath = cachepath + ".tmp" + std::to_string(getpid());
+        std::ofstream out(tmppath,std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!out.is_open())
+        {
+            NS_LOG_WARN("Cannot write the GPS trace cache file " << cachepath << ". The CSV file will be parsed again at the next run.");
+            return;
+        }
+
+        out.write("MSVGTC",6);
+        writeBin<uint16_t>(out,GPS_TC_CACHE_VERSION);
+        writeBin<uint64_t>(out,csv_size);
+        writeBin<int64_t>(out,csv_mtime);
+        writeBinString(out,getCacheKey());
+        writeBin(out,trace.lat0);
+        writeBin(out,trace.lon0);
+        writeBin(out,trace.min_tm_x);
+        writeBin(out,trace.min_tm_y);
+        writeBin<uint8_t>(out,trace.accel_available);
+        writeBin<uint32_t>(out,trace.vehicles.size());
+
+        for(const trace_vehicle_t &vehicle : trace.vehicles)
+        {
+            writeBinString(out,vehicle.id);
+            writeBinString(out,vehicle.type);
+            writeBin<uint64_t>(out,vehicle.data.size());
+            out.write(reinterpret_cast<const char *>(vehicle.data.data()),vehicle.data.size()*sizeof(GPSTraceClient::positioning_data_t));
+        }
+
+        out.close();
+        if(!out || rename(tmppath.c_str(),cachepath.c_str())!=0)
+        {
+            NS_LOG_WARN("Cannot write the GPS trace cache file " << cachepath << ". The CSV file will be parsed again at the next run.");
+            unlink(tmppath.c_str());
+        }
+    }
+
+    std::map<std::string,GPSTraceClient*> GPSTraceClientHelper::createTraceClientsFromCSV(std::string filepath)
+    {
+      std::map<std::string,GPSTraceClient*> m_GPSTraceClient;
+      trace_data_t trace;
+
+      MappedFile csvFile;
+      if (!csvFile.open(filepath)) {
+          NS_FATAL_ERROR("Unable to open the file: "<<filepath);
+      }
+
+      bool use_cache = m_use_cache || m_streaming;
+      std::string cachepath = getTraceCachePath(filepath);
+      if(use_cache)
+      {
+          // The cache folder may not exist yet (e.g., first run)
+          mkdir(m_cache_dir.c_str(),0755);
+      }
+      if(!use_cache || !readTraceCache(cachepath,csvFile.size(),csvFile.mtime(),trace,m_streaming))
+      {
+          parseCSV(csvFile.data(),csvFile.size(),trace);
+
+          if(use_cache)
           {
-              double heading_dbl = std::stod(result[m_idx_heading_deg]);
-              heading_str = std::to_string(heading_dbl+180.0);
+              writeTraceCache(cachepath,csvFile.size(),csvFile.mtime(),trace);
           }
-          else
+
+          // In streaming mode, release the parsed points and use the cache file which has just been written
+          if(m_streaming)
           {
-              heading_str = result[m_idx_heading_deg];
+              trace_data_t index;
+              if(readTraceCache(cachepath,csvFile.size(),csvFile.mtime(),index,true))
+              {
+                  trace = std::move(index);
+              }
+              else
+              {
+                  NS_LOG_WARN("Cannot use the GPS trace cache file " << cachepath << " for the streaming playback. The whole trace will be kept in memory.");
+              }
           }
+      }
+      else
+      {
+          NS_LOG_INFO("GPS trace loaded from the cache file " << cachepath);
+      }
 
-          m_GPSTraceClient[currentVehId]->setheading(heading_str);
+      double lat0 = trace.lat0;
+      double lon0 = trace.lon0;
+      double min_tm_x = trace.min_tm_x;
+      double min_tm_y = trace.min_tm_y;
 
-          if(m_idx_accel != UNAVAIL_IDX_ACCEL)
+      std::shared_ptr<GPSTraceStream> stream;
+      if(trace.index_only)
+      {
+          stream = std::make_shared<GPSTraceStream>(cachepath);
+          if(!stream->isOpen())
           {
-            m_GPSTraceClient[currentVehId]->setAccelmsq(result[m_idx_accel]);
+              NS_FATAL_ERROR("Unable to open the GPS trace cache file: "<<cachepath);
           }
+      }
 
-          // Find the minimum x and y values
-          if(tm_x<min_tm_x)
+      for(trace_vehicle_t &vehicle : trace.vehicles)
+      {
+          GPSTraceClient* gpsclient = new GPSTraceClient(vehicle.id, vehicle.type);
+          gpsclient->setLat0 (lat0);
+          // To allow later on to perform TransverseMercator_forward
+          gpsclient->setLon0 (lon0);
+          if(m_vehicle_vis_ptr!=nullptr && m_vehicle_vis_ptr->isConnected())
           {
-              min_tm_x=tm_x;
+            gpsclient->setVehicleVisualizer (m_vehicle_vis_ptr);
           }
-
-          if(tm_y<min_tm_y)
+          gpsclient->SetInputMicroseconds(m_use_microseconds);
+          if(trace.index_only)
           {
-              min_tm_y=tm_y;
+              gpsclient->setStreamingSource(stream, vehicle.file_offset, vehicle.num_points, m_stream_window_points, trace.accel_available);
           }
+          else
+          {
+              gpsclient->setVehiclesdata(std::move(vehicle.data), trace.accel_available);
+          }
+          m_GPSTraceClient.insert(std::make_pair(vehicle.id, gpsclient));
       }
 
-      // Sort for each object the vector "vehiclesdata" according to the timestamp
-      // Shift also the x,y coordinate in order to have the origin (0,0) at the minimum y and minimum y point
+      // The vector "vehiclesdata" of each object is already sorted according to the timestamp
+      // Shift the x,y coordinate in order to have the origin (0,0) at the minimum y and minimum y point
       for(std::map<std::string,GPSTraceClient*>::iterator it=m_GPSTraceClient.begin(); it!=m_GPSTraceClient.end(); ++it) {
-          it->second->sortVehiclesdata();
-
           // If no acceleration is available in the CSV file, make gps-tc compute the acceleration values between each
           // couple of points, considering a constant acceleration (and computing it as delta(v)/delta(t))
-          if(m_idx_accel == UNAVAIL_IDX_ACCEL)
+          if(!trace.accel_available)
           {
             it->second->generateAccelerationValues ();
           }
@@ -86,8 +86,58 @@ class GPSTraceClientHelper
 
       void SetInputMicroseconds(bool use_microseconds) {m_use_microseconds = use_microseconds;};
 
+      // Enable or disable the binary cache of the parsed trace (default: disabled)
+      // When enabled, after a CSV trace file has been parsed, its content is saved to a binary file in "cache_dir" (default: the
+      // current working directory, where the other output files of the simulation are written), which is then loaded instead
+      // of the CSV file by the next runs, as long as the CSV file (size and modification time), the configuration of this
+      // helper (column names, timestamp format) and, for dates, the time zone (TZ) do not change
+      // The name of the cache file is returned by getTraceCachePath()
+      // If the cache file cannot be written (e.g., read-only directory), the CSV file is simply parsed again at each run
+      void setTraceCache(bool use_cache, std::string cache_dir = ".") {m_use_cache = use_cache; m_cache_dir = cache_dir;}
+
+      // Get the path of the cache file of a CSV trace file: <cache_dir>/<CSV file name>-<hash of its absolute path>.gpstc
+      std::string getTraceCachePath(const std::string &filepath) const;
+
+      // Set the number of threads used to parse the CSV trace file (default: 1)
+      // The result does not depend on the number of threads
+      void setLoaderThreads(unsigned int num_threads) {m_loader_threads = num_threads > 0 ? num_threads : 1;}
+
+      // Enable or disable the streaming playback of the traces (default: disabled)
+      // When enabled, the GPSTraceClient objects do not keep their whole trace in memory: the points are read from the binary
+      // cache file (see setTraceCache(), which is always used in this mode, in its "cache_dir"), where they are already sorted by timestamp,
+      // and each client keeps in memory only a sliding window of "window_points" points
+      // The acceleration values, the interpolated points (see setInterpolation()) and the shift of the origin are computed
+      // on the fly, and the vehicles move exactly as when the whole trace is loaded in memory
+      // When the cache file does not exist yet, the CSV file is parsed in memory once, to write the cache file
+      void setStreamingPlayback(bool streaming, uint32_t window_points = 4096) {m_streaming = streaming; m_stream_window_points = window_points;}
+
     private:
-      std::tuple<double,double> getAverageLatLon(std::ifstream &inFileStream);
+      // Content of a trace file, before the creation of the GPSTraceClient objects
+      typedef struct _trace_vehicle {
+          std::string id;
+          std::string type;
+          std::vector<GPSTraceClient::positioning_data_t> data; // Sorted by timestamp
+          uint64_t file_offset; // Offset of the points in the cache file (only when reading the index of the cache)
+          uint64_t num_points;
+      } trace_vehicle_t;
+
+      typedef struct _trace_data {
+          double lat0;
+          double lon0;
+          double min_tm_x;
+          double min_tm_y;
+          bool accel_available;
+          bool index_only = false; // true if "data" is not filled in, and the points must be read from the cache file
+          std::vector<trace_vehicle_t> vehicles; // In order of first appearance in the trace file
+      } trace_data_t;
+
+      void parseCSV(const char *data, size_t size, trace_data_t &trace);
+      double dateToTimestamp(std::string date) const;
+      std::string getCacheKey() const;
+      bool readTraceCache(const std::string &cachepath, uint64_t csv_size, int64_t csv_mtime, trace_data_t &trace, bool index_only);
+      void writeTraceCache(const std::string &cachepath, uint64_t csv_size, int64_t csv_mtime, const trace_data_t &trace);
+      [[noreturn]] void traceFormatError(const std::string &msg);
+
       bool m_verbose;
 
       Ptr<vehicleVisualizer> m_vehicle_vis_ptr;
@@ -109,6 +159,13 @@ class GPSTraceClientHelper
 
       bool m_use_microseconds = false;
 
+      bool m_use_cache;
+      std::string m_cache_dir;
+      unsigned int m_loader_threads;
+
+      bool m_streaming;
+      uint32_t m_stream_window_points;
+
 };
 
 }
@@ -22,6 +22,8 @@
 #include "gps-tc.h"
 #include "ns3/geographic-positions.h"
 #include <cmath>
+#include <fcntl.h>
+#include <unistd.h>
 
 extern "C" {
   #include "ns3/utmups.h"
@@ -32,6 +34,39 @@ namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE("GPSTraceClient");
 
+  GPSTraceStream::GPSTraceStream(std::string filepath)
+  {
+      m_fd=open(filepath.c_str(),O_RDONLY);
+  }
+
+  GPSTraceStream::~GPSTraceStream()
+  {
+      if(m_fd>=0)
+      {
+          close(m_fd);
+      }
+  }
+
+  bool
+  GPSTraceStream::read(uint64_t offset, void *buffer, size_t size)
+  {
+      char *buf=static_cast<char *>(buffer);
+
+      // pread() does not use the file position, so the same file descriptor can be shared by all the clients
+      while(size>0)
+      {
+          ssize_t rval=pread(m_fd,buf,size,offset);
+          if(rval<=0)
+          {
+              return false;
+          }
+          buf+=rval;
+          offset+=rval;
+          size-=rval;
+      }
+      return true;
+  }
+
   GPSTraceClient::GPSTraceClient(std::string vehID, std::string vehType)
   {
       //ctor
@@ -111,6 +146,164 @@ namespace ns3
   {
       // The difference between lon and lon0, is that lon0 is the reference longitude used to compute the Transverse Mercator Forward (from lon_lat to x_y)
       m_lon0 = lon0;
+      m_tmerc = TMProjection(lon0);
+  }
+
+  void
+  GPSTraceClient::setVehiclesdata(std::vector<positioning_data_t> &&data, bool acceleration_set)
+  {
+      vehiclesdata = std::move(data);
+      m_accelerationset = acceleration_set;
+  }
+
+  void
+  GPSTraceClient::setStreamingSource(std::shared_ptr<GPSTraceStream> stream, uint64_t offset, uint64_t num_points, uint32_t window_points, bool acceleration_set)
+  {
+      if(num_points==0)
+      {
+          NS_FATAL_ERROR("Error. Attempted to stream an empty trace for vehicle: "<<m_vehID);
+      }
+
+      vehiclesdata.clear();
+      m_stream=stream;
+      m_stream_offset=offset;
+      m_stream_count=num_points;
+      m_window_points=std::max<uint32_t>(window_points,2);
+      m_window.clear();
+      m_accelerationset=acceleration_set;
+
+      resetStreamPlayback();
+  }
+
+  const GPSTraceClient::positioning_data_t &
+  GPSTraceClient::getStreamPoint(uint64_t idx)
+  {
+      if(idx<m_window_start || idx>=m_window_start+m_window.size())
+      {
+          // Page in the window starting at idx, reading one more point if the acceleration values have to be computed
+          uint64_t num=std::min<uint64_t>(m_window_points+(m_stream_generate_accel ? 1 : 0),m_stream_count-idx);
+
+          m_window.resize(num);
+          if(!m_stream->read(m_stream_offset+idx*sizeof(positioning_data_t),m_window.data(),num*sizeof(positioning_data_t)))
+          {
+              NS_FATAL_ERROR("Error. Cannot read the trace points of vehicle "<<m_vehID<<" from the trace file.");
+          }
+          m_window_start=idx;
+
+          if(m_stream_generate_accel)
+          {
+              for(uint64_t i=0;i+1<num;i++)
+              {
+                  m_window[i].accelmsq = (m_window[i+1].speedms-m_window[i].speedms)/((m_window[i+1].utc_time-m_window[i].utc_time)/1e6);
+              }
+
+              // The last point of the trace has no acceleration, otherwise the additional point is used only for the acceleration
+              if(idx+num==m_stream_count)
+              {
+                  m_window[num-1].accelmsq = 0.0;
+              }
+              else
+              {
+                  m_window.pop_back();
+              }
+          }
+      }
+
+      return m_window[idx-m_window_start];
+  }
+
+  GPSTraceClient::positioning_data_t
+  GPSTraceClient::computeStreamPoint(uint64_t seg_idx, int seg_p)
+  {
+      positioning_data_t point;
+
+      if(seg_p==0)
+      {
+          point=getStreamPoint(seg_idx);
+      }
+      else
+      {
+          // Copies, as reading the second point may move the window
+          positioning_data_t a=getStreamPoint(seg_idx);
+          positioning_data_t b=getStreamPoint(seg_idx+1);
+          point=interpolatePoint(a,b,seg_p,getInterpolationSteps(a,b,m_stream_interval_ms));
+      }
+
+      point.tm_x-=m_origin_x;
+      point.tm_y-=m_origin_y;
+      return point;
+  }
+
+  int
+  GPSTraceClient::getStreamSegmentSteps(uint64_t seg_idx)
+  {
+      if(m_stream_interval_ms<=0)
+      {
+          return 1;
+      }
+
+      positioning_data_t a=getStreamPoint(seg_idx);
+      positioning_data_t b=getStreamPoint(seg_idx+1);
+      return std::max(getInterpolationSteps(a,b,m_stream_interval_ms),1);
+  }
+
+  void
+  GPSTraceClient::resetStreamPlayback()
+  {
+      m_lastvehicledataidx=0;
+      m_seg_idx=0;
+      m_seg_p=0;
+      m_seg_numpoints=1;
+
+      m_current=computeStreamPoint(0,0);
+      if(m_stream_count>1)
+      {
+          m_seg_numpoints=getStreamSegmentSteps(0);
+          m_next=computeStreamPoint(m_seg_numpoints>1 ? 0 : 1,m_seg_numpoints>1 ? 1 : 0);
+      }
+  }
+
+  const GPSTraceClient::positioning_data_t &
+  GPSTraceClient::currentPoint()
+  {
+      return m_stream!=nullptr ? m_current : vehiclesdata[m_lastvehicledataidx];
+  }
+
+  bool
+  GPSTraceClient::hasNextPoint()
+  {
+      return m_stream!=nullptr ? m_seg_idx+1<m_stream_count : m_lastvehicledataidx+1<vehiclesdata.size();
+  }
+
+  long int
+  GPSTraceClient::nextPointTimestamp()
+  {
+      return m_stream!=nullptr ? m_next.utc_time : vehiclesdata[m_lastvehicledataidx+1].utc_time;
+  }
+
+  void
+  GPSTraceClient::advancePoint()
+  {
+      m_lastvehicledataidx++;
+
+      if(m_stream==nullptr)
+      {
+          return;
+      }
+
+      m_current=m_next;
+
+      if(++m_seg_p>=m_seg_numpoints)
+      {
+          m_seg_idx++;
+          m_seg_p=0;
+          m_seg_numpoints=m_seg_idx+1<m_stream_count ? getStreamSegmentSteps(m_seg_idx) : 1;
+      }
+
+      if(m_seg_idx+1<m_stream_count)
+      {
+          m_next=m_seg_p+1<m_seg_numpoints ? computeStreamPoint(m_seg_idx,m_seg_p+1) : computeStreamPoint(m_seg_idx+1,0);
+      }
   }
 
   void
@@ -151,19 +344,19 @@ namespace ns3
   long int
   GPSTraceClient::getTimestamp()
   {
-      return vehiclesdata[m_lastvehicledataidx].utc_time;
+      return currentPoint().utc_time;
   }
 
   double
   GPSTraceClient::getLat()
   {
-      return vehiclesdata[m_lastvehicledataidx].lat;
+      return currentPoint().lat;
   }
 
   double
   GPSTraceClient::getLon()
   {
-      return vehiclesdata[m_lastvehicledataidx].lon;
+      return currentPoint().lon;
   }
 
   double
@@ -181,31 +374,31 @@ namespace ns3
   double
   GPSTraceClient::getX()
   {
-      return vehiclesdata[m_lastvehicledataidx].tm_x;
+      return currentPoint().tm_x;
   }
 
   double
   GPSTraceClient::getY()
   {
-      return vehiclesdata[m_lastvehicledataidx].tm_y;
+      return currentPoint().tm_y;
   }
 
   double
   GPSTraceClient::getSpeedms()
   {
-      return vehiclesdata[m_lastvehicledataidx].speedms;
+      return currentPoint().speedms;
   }
 
   double
   GPSTraceClient::getHeadingdeg()
   {
-      return vehiclesdata[m_lastvehicledataidx].heading;
+      return currentPoint().heading;
   }
 
   double
   GPSTraceClient::getAccelmsq()
   {
-      return vehiclesdata[m_lastvehicledataidx].accelmsq;
+      return currentPoint().accelmsq;
   }
 
   uint64_t
@@ -228,6 +421,14 @@ namespace ns3
   void
   GPSTraceClient::shiftOrigin(double tm_x_origin,double tm_y_origin)
   {
+      if(m_stream!=nullptr)
+      {
+          m_origin_x+=tm_x_origin;
+          m_origin_y+=tm_y_origin;
+          resetStreamPlayback();
+          return;
+      }
+
       for(std::vector<int>::size_type i = 0; i != vehiclesdata.size(); i++) {
           vehiclesdata[i].tm_x-=tm_x_origin;
           vehiclesdata[i].tm_y-=tm_y_origin;
@@ -237,6 +438,20 @@ namespace ns3
   void
   GPSTraceClient::printVehiclesdata()
   {
+      if(m_stream!=nullptr)
+      {
+          // Only the real points are printed, as the interpolated ones are computed during playback
+          std::cout << "Number of positions: " << m_stream_count << " (streaming mode)" << std::endl;
+          for (uint64_t i=0; i<m_stream_count; i++) {
+              const positioning_data_t &point = getStreamPoint(i);
+              std::cout << "time: " << std::setprecision(12) << point.utc_time << "; lat: " << std::setprecision(12) << point.lat
+                        << "; lon: " << std::setprecision(12) << point.lon << "; speed[m/s]: " << std::setprecision(12) << point.speedms
+                        << "; heading[rad]: " << std::setprecision(16) << point.heading << "; accel[m/s2]: "
+                        << std::setprecision(12) << point.accelmsq << std::endl;
+          }
+          return;
+      }
+
       std::cout << "Number of positions: " << vehiclesdata.size() << std::endl;
       for (unsigned int i=0; i<vehiclesdata.size(); i++) {
           std::cout << "time: " << std::setprecision(12) << vehiclesdata[i].utc_time << "; lat: " << std::setprecision(12) << vehiclesdata[i].lat
@@ -271,6 +486,10 @@ namespace ns3
 
       // First position update
       m_lastvehicledataidx=0;
+      if(m_stream!=nullptr)
+      {
+          resetStreamPlayback();
+      }
 
       UpdatePositions();
   }
@@ -292,11 +511,13 @@ namespace ns3
 
     if(m_updatefirstiter==false)
       {
-          m_lastvehicledataidx++;
-          m_travelled_distance+=UTMUPS_Math_haversineDist(vehiclesdata[m_lastvehicledataidx].lat,
-                                    vehiclesdata[m_lastvehicledataidx].lon,
-                                    vehiclesdata[m_lastvehicledataidx-1].lat,
-                                    vehiclesdata[m_lastvehicledataidx-1].lon);
+          double prev_lat=currentPoint().lat;
+          double prev_lon=currentPoint().lon;
+          advancePoint();
+          m_travelled_distance+=UTMUPS_Math_haversineDist(currentPoint().lat,
+                                    currentPoint().lon,
+                                    prev_lat,
+                                    prev_lon);
       }
     else
       {
@@ -304,18 +525,18 @@ namespace ns3
           m_travelled_distance=0;
       }
 
-    mob->SetPosition(Vector(vehiclesdata[m_lastvehicledataidx].tm_x,vehiclesdata[m_lastvehicledataidx].tm_y,1.5));
+    const positioning_data_t &point=currentPoint();
+    mob->SetPosition(Vector(point.tm_x,point.tm_y,1.5));
 
     if (m_vehicle_visualizer!=nullptr && m_vehicle_visualizer->isConnected())
     {
-        int rval = m_vehicle_visualizer->sendObjectUpdate (m_vehID,vehiclesdata[m_lastvehicledataidx].lat,vehiclesdata[m_lastvehicledataidx].lon,vehiclesdata[m_lastvehicledataidx].heading);
-        if (rval<0)
-        {
-            NS_FATAL_ERROR("Error: cannot send the object update to the vehicle visualizer for vehicle: "<<m_vehID);
-        }
+        // The updates of all the GPS trace clients are coalesced and sent as a single frame, once all the clients have been
+        // updated for the current time step (and at most at the visualizer frame rate)
+        m_vehicle_visualizer->addObjectToFrame (m_vehID,point.lat,point.lon,point.heading);
+        m_vehicle_visualizer->scheduleFrameFlush ();
     }
 
-    if(m_lastvehicledataidx+1==vehiclesdata.size())
+    if(!hasNextPoint())
       {
         m_excludeNode(m_vehNode,m_vehID);
         m_vehNode=nullptr;
@@ -324,7 +545,7 @@ namespace ns3
 
         return;
       }
-    m_event_updatepos=Simulator::Schedule(MicroSeconds (vehiclesdata[m_lastvehicledataidx+1].utc_time-vehiclesdata[m_lastvehicledataidx].utc_time), &GPSTraceClient::UpdatePositions, this);
+    m_event_updatepos=Simulator::Schedule(MicroSeconds (nextPointTimestamp()-point.utc_time), &GPSTraceClient::UpdatePositions, this);
   }
 
   void
@@ -341,6 +562,16 @@ namespace ns3
       NS_FATAL_ERROR ("Error. gps-tc generateAccelerationValues() can only be used when no acceleration values are set so far.");
     }
 
+    if(m_stream!=nullptr)
+    {
+        // Computed when the points are read
+        m_stream_generate_accel = true;
+        m_accelerationset = true;
+        m_window.clear();
+        resetStreamPlayback();
+        return;
+    }
+
     for(unsigned long int i=0;i<vehiclesdata.size()-1;i++)
     {
         vehiclesdata[i].accelmsq = (vehiclesdata[i+1].speedms-vehiclesdata[i].speedms)/((vehiclesdata[i+1].utc_time-vehiclesdata[i].utc_time)/1e6);
@@ -353,106 +584,112 @@ namespace ns3
     }
   }
 
+  int
+  GPSTraceClient::getInterpolationSteps(const positioning_data_t &a, const positioning_data_t &b, int interval_ms)
+  {
+      // If two points are "far enough" in time (i.e. their timestamp difference is greater than interval_ms milliseconds), a certain number of in-between linearly interpolated points is needed
+      if(b.utc_time-a.utc_time > interval_ms*1000.0)
+      {
+          // Find the number of points needed to have new data every around interval_ms
+          // floor() is used, i.e. we try to keep the number of added points as low as possible (we will have updated every interval_ms ms or something a bit more than interval_ms ms)
+          // ceil() could also be used here; the usage of floor() is just an initial choice and may change in the future versions
+          // This is actually providing the number of points + 1 (including also in the count the final real point, corresponding to b), thus numpoints - 1 points are added
+          return floor(((b.utc_time-a.utc_time)/1000.0)/interval_ms);
+      }
+
+      return 1;
+  }
+
+  GPSTraceClient::positioning_data_t
+  GPSTraceClient::interpolatePoint(const positioning_data_t &a, const positioning_data_t &b, int p, int numpoints)
+  {
+      positioning_data_t nextpoint;
+
+      // Compute the heading difference between the two successive points
+      // The heading difference is computed taking into account angles between 0 and 360 degrees and the smallest angle between two heading values
+      double head_diff = fabs(fmod((b.heading - a.heading),360.0));
+      if(head_diff > 180)
+      {
+          head_diff = 360 - head_diff;
+      }
+
+      // The computed heading difference is signed in order to correctly interpolate depending on the initial and final heading values, coming from the two real points
+      if((b.heading - a.heading > -180 && b.heading - a.heading < 0) ||
+         b.heading - a.heading > 180)
+      {
+          head_diff *= -1;
+      }
+
+      double head_val = a.heading + head_diff*p/numpoints;
+
+      if(head_val < 0)
+      {
+          head_val += 360.0;
+      }
+      else if(head_val >= 360)
+      {
+          head_val = fmod(head_val,360.0);
+      }
+
+      // Linearly interpolated heading
+      nextpoint.heading = head_val;
+      // Linearly interpolated speed
+      nextpoint.speedms = a.speedms + (b.speedms - a.speedms)*p/numpoints;
+
+      // Constant acceleration
+      // Linear would be: nextpoint.accelmsq = a.accelmsq + (b.accelmsq - a.accelmsq)*p/numpoints;
+      nextpoint.accelmsq = a.accelmsq;
+      // Linearly interpolated time
+      nextpoint.utc_time = a.utc_time + (b.utc_time - a.utc_time)*p/numpoints;
+
+      // Interpolate linearly also the position (in terms of x,y, which are then converted back to lat,lon)
+      nextpoint.tm_x = a.tm_x + (b.tm_x - a.tm_x)*p/numpoints;
+      nextpoint.tm_y = a.tm_y + (b.tm_y - a.tm_y)*p/numpoints;
+      if(!m_tmerc.IsValid())
+      {
+          NS_FATAL_ERROR ("Error while interpolating. Cannot perform reverse Transverse Mercator projection from (x,y) to (lat,lon), as lon0 has not been set");
+      }
+      m_tmerc.XYToLonLat(nextpoint.tm_x,nextpoint.tm_y,nextpoint.lon,nextpoint.lat);
+
+      return nextpoint;
+  }
+
   void
   GPSTraceClient::setInterpolationPoints(int interval_ms)
   {
-      std::vector<positioning_data_t> nextpts;
-      transverse_mercator_t tmerc=UTMUPS_init_UTM_TransverseMercator ();
+      std::vector<positioning_data_t> interpolated;
 
       if(m_accelerationset == false)
       {
         NS_FATAL_ERROR ("Error. Attempted to call setInterpolationPoints() on a GPS Trace Client with undefined acceleration values.");
       }
 
+      if(m_stream!=nullptr)
+      {
+          // In streaming mode, the interpolated points are computed on the fly, during the playback
+          m_stream_interval_ms = interval_ms;
+          resetStreamPlayback();
+          return;
+      }
+
       // Process each couple of real points in the vehiclesdata structure (which should be already being completely filled in, via the setter methods)
+      // The in-between linearly interpolated points are added after each real point, building a new vector which will be used to "play" the trace
+      interpolated.reserve (vehiclesdata.size());
       for(unsigned long int i=0;i<vehiclesdata.size()-1;i++)
       {
-          // If two points are "far enough" in time (i.e. their timestamp difference is greater than interval_ms milliseconds), create a certain number of in-between linearly interpolated points
-          if(vehiclesdata[i+1].utc_time-vehiclesdata[i].utc_time > interval_ms*1000.0)
-          {
-              // Find the number of points needed to have new data every around interval_ms
-              // floor() is used, i.e. we try to keep the number of added points as low as possible (we will have updated every interval_ms ms or something a bit more than interval_ms ms)
-              // ceil() could also be used here; the usage of floor() is just an initial choice and may change in the future versions
-              // This is actually providing the number of points + 1 (including also in the count the final real point, corresponding to vehiclesdata[i+1]), thus we will need to use numpoints - 1 later on
-              int numpoints = floor(((vehiclesdata[i+1].utc_time-vehiclesdata[i].utc_time)/1000.0)/interval_ms);
-
-              // Compute the heading difference between the two successive points
-              // The heading difference is computed taking into account angles between 0 and 360 degrees and the smallest angle between two heading values
-              double head_diff = fabs(fmod((vehiclesdata[i+1].heading - vehiclesdata[i].heading),360.0));
-              if(head_diff > 180)
-              {
-                  head_diff = 360 - head_diff;
-              }
+          int numpoints = getInterpolationSteps (vehiclesdata[i],vehiclesdata[i+1],interval_ms);
 
-              // The computed heading difference is signed in order to correctly interpolate depending on the initial and final heading values, coming from the two real points
-              if((vehiclesdata[i+1].heading - vehiclesdata[i].heading > -180 && vehiclesdata[i+1].heading - vehiclesdata[i].heading < 0) ||
-                 vehiclesdata[i+1].heading - vehiclesdata[i].heading > 180)
-              {
-                  head_diff *= -1;
-              }
+          interpolated.push_back (vehiclesdata[i]);
 
-              // Prepare an empty std::vector to accumulate the points to be added
-              nextpts.clear ();
-
-              // Add numpoints-1 total points by linearly interpolating the different variables
-              for(int p=1;p<numpoints;p++)
-              {
-                positioning_data_t nextpoint;
-                double head_val = vehiclesdata[i].heading + head_diff*p/numpoints;
-
-                if(head_val < 0)
-                {
-                    head_val += 360.0;
-                }
-                else if(head_val >= 360)
-                {
-                    head_val = fmod(head_val,360.0);
-                }
-
-                // Linearly interpolated heading
-                nextpoint.heading = head_val;
-                // Linearly interpolated speed
-                nextpoint.speedms = vehiclesdata[i].speedms + (vehiclesdata[i+1].speedms - vehiclesdata[i].speedms)*p/numpoints;
-
-                // Constant acceleration
-                // Linear would be: nextpoint.accelmsq = vehiclesdata[i].accelmsq + (vehiclesdata[i+1].accelmsq - vehiclesdata[i].accelmsq)*p/numpoints;
-                nextpoint.accelmsq = vehiclesdata[i].accelmsq;
-                // Linearly interpolated time
-                nextpoint.utc_time = vehiclesdata[i].utc_time + (vehiclesdata[i+1].utc_time - vehiclesdata[i].utc_time)*p/numpoints;
-
-                // Interpolate linearly also the position (in terms of x,y, which are then converted back to lat,lon)
-                double lat,lon,tm_gamma,tm_kappa;
-                nextpoint.tm_x = vehiclesdata[i].tm_x + (vehiclesdata[i+1].tm_x - vehiclesdata[i].tm_x)*p/numpoints;
-                nextpoint.tm_y = vehiclesdata[i].tm_y + (vehiclesdata[i+1].tm_y - vehiclesdata[i].tm_y)*p/numpoints;
-                if(TransverseMercator_Reverse (&tmerc,m_lon0,nextpoint.tm_x,nextpoint.tm_y,&lat,&lon,&tm_gamma,&tm_kappa)!= UTMUPS_OK)
-                {
-                    NS_FATAL_ERROR ("Error while interpolating. Cannot perform reverse Transverse Mercator projection from (x,y) to (lat,lon)");
-                }
-                nextpoint.lat = lat;
-                nextpoint.lon = lon;
-
-                // Accumulate the new points inside a std::vector
-                nextpts.push_back (nextpoint);
-              }
-
-//              // Leftover code (commented out) just for debug purposes
-//              std::cout << "--------- X -----------" << std::endl;
-//              std::cout << "Initial X: " << vehiclesdata[i].tm_x << std::endl;
-//              for(unsigned int ll=0;ll<nextpts.size ();ll++) {
-//                  std::cout << "Interpolated X: "<< nextpts[ll].tm_x << std::endl;
-//              }
-//              std::cout << "Final X: " << vehiclesdata[i+1].tm_x << std::endl;
-//              std::cout << "-----------------------" << std::endl;
-
-              // Insert the std::vector with the new point in between the two real points, inside the main "vehiclesdata" vector,
-              // which is the one which will be used to "play" the trace
-              vehiclesdata.insert (vehiclesdata.begin() + i + 1,nextpts.begin(),nextpts.end());
-
-              // For the next iteration, start from the next couple of real points
-              // The element at [i+1], after the insertion of nextpts (of size nextpts.size()), will be now accessible at [i+1+nextpts.size()]
-              i += nextpts.size();
+          // Add numpoints-1 total points by linearly interpolating the different variables
+          for(int p=1;p<numpoints;p++)
+          {
+              interpolated.push_back (interpolatePoint (vehiclesdata[i],vehiclesdata[i+1],p,numpoints));
           }
       }
+      interpolated.push_back (vehiclesdata.back());
+
+      vehiclesdata = std::move(interpolated);
   }
 }
 
@@ -8,12 +8,14 @@
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "ns3/core-module.h"
 #include "ns3/mobility-module.h"
 #include "ns3/traci-module.h"
+#include "ns3/tm-projection.h"
 #include "ns3/sionna-connection-handler.h"
 
 #include "ns3/vehicle-visualizer.h"
@@ -25,9 +27,43 @@
 
 namespace ns3 {
 
+  // Read-only access to a file containing the pre-sorted trace points of one or more GPS Trace Clients (e.g., the binary
+  // cache written by the GPS Trace Client Helper), shared by all the clients playing their trace in streaming mode
+  class GPSTraceStream
+  {
+      public:
+          GPSTraceStream(std::string filepath);
+          ~GPSTraceStream();
+
+          bool isOpen() {return m_fd>=0;}
+          // Read "size" bytes at offset "offset" of the file
+          bool read(uint64_t offset, void *buffer, size_t size);
+
+      private:
+          int m_fd;
+  };
+
   class GPSTraceClient : public Object
   {
       public:
+          typedef struct _positioning_data {
+              double lat;
+              double lon;
+              double tm_x;
+              double tm_y;
+              double speedms;
+              double accelmsq;
+              double heading;
+              long int utc_time; // UTC time as Unix timestamp since the epoch, in microseconds
+
+              // To order the vector according to "utc_time"
+              bool operator < (const _positioning_data& str) const
+              {
+                  return (utc_time < str.utc_time);
+              }
+
+          } positioning_data_t;
+
           GPSTraceClient(std::string vehID, std::string vehType);
           virtual ~GPSTraceClient();
           void sortVehiclesdata();
@@ -70,6 +106,16 @@ namespace ns3 {
           void setAccelmsq(std::string);
           void setLat0(double);
           void setLon0(double);
+          // Set all the trace points at once, instead of one point at a time with the setters above (used by the
+          // GPS Trace Client Helper when loading a trace); "acceleration_set" tells if the points contain valid acceleration values
+          void setVehiclesdata(std::vector<positioning_data_t> &&data, bool acceleration_set);
+
+          // Play the trace in streaming mode: instead of keeping all the points in memory, they are read from "stream",
+          // where "num_points" points (sorted by timestamp) are stored starting at "offset", and only a sliding window of
+          // "window_points" points around the current one is kept in memory
+          // In this mode, generateAccelerationValues(), setInterpolationPoints() and shiftOrigin() do not modify any stored point:
+          // the acceleration values, the interpolated points and the shifted coordinates are computed on the fly during playback
+          void setStreamingSource(std::shared_ptr<GPSTraceStream> stream, uint64_t offset, uint64_t num_points, uint32_t window_points, bool acceleration_set);
 
           // Getter
           std::string getVehId() {return m_vehID;};
@@ -87,6 +133,8 @@ namespace ns3 {
           uint64_t getLastIndex();
           double getLat0();
           double getLon0();
+          // Get all the points of the trace (always empty in streaming mode)
+          const std::vector<positioning_data_t> &getVehiclesdata() {return vehiclesdata;};
 
           // Start "playing" the trace
           void playTrace(Time const &delay);
@@ -101,26 +149,10 @@ namespace ns3 {
           void SetInputMicroseconds(bool use_microseconds) {m_input_microseconds = use_microseconds;};
 
       private:
-          typedef struct _positioning_data {
-              double lat;
-              double lon;
-              double tm_x;
-              double tm_y;
-              double speedms;
-              double accelmsq;
-              double heading;
-              long int utc_time; // UTC time as Unix timestamp since the epoch, in microseconds
-
-              // To order the vector according to "utc_time"
-              bool operator < (const _positioning_data& str) const
-              {
-                  return (utc_time < str.utc_time);
-              }
-
-          } positioning_data_t;
-
           double m_lat0;
           double m_lon0;
+          // Transverse Mercator projection centered on m_lon0
+          TMProjection m_tmerc;
 
           std::vector<positioning_data_t> vehiclesdata;
           long unsigned int m_lastvehicledataidx;
@@ -141,6 +173,38 @@ namespace ns3 {
           void CreateNode(void);
           void UpdatePositions(void);
 
+          // Access to the point being played and to the next one, both in normal and in streaming mode
+          const positioning_data_t &currentPoint();
+          bool hasNextPoint();
+          long int nextPointTimestamp();
+          void advancePoint();
+
+          static int getInterpolationSteps(const positioning_data_t &a, const positioning_data_t &b, int interval_ms);
+          positioning_data_t interpolatePoint(const positioning_data_t &a, const positioning_data_t &b, int p, int numpoints);
+
+          // Streaming mode
+          const positioning_data_t &getStreamPoint(uint64_t idx);
+          positioning_data_t computeStreamPoint(uint64_t seg_idx, int seg_p);
+          int getStreamSegmentSteps(uint64_t seg_idx);
+          void resetStreamPlayback();
+
+          std::shared_ptr<GPSTraceStream> m_stream; // nullptr when not in streaming mode
+          uint64_t m_stream_offset = 0;
+          uint64_t m_stream_count = 0;
+          std::vector<positioning_data_t> m_window; // Points [m_window_start, m_window_start+m_window.size()) of the trace
+          uint64_t m_window_start = 0;
+          uint32_t m_window_points = 0;
+          bool m_stream_generate_accel = false; // Compute the acceleration values when reading the points
+          int m_stream_interval_ms = 0; // Interpolation interval (0: no interpolation)
+          double m_origin_x = 0;
+          double m_origin_y = 0;
+          // Position of the current point: segment between the real points m_seg_idx and m_seg_idx+1, divided into m_seg_numpoints steps
+          uint64_t m_seg_idx = 0;
+          int m_seg_p = 0;
+          int m_seg_numpoints = 1;
+          positioning_data_t m_current = {};
+          positioning_data_t m_next = {};
+
           Ptr<vehicleVisualizer> m_vehicle_visualizer;
 
           bool m_input_microseconds = false;
@@ -1,55 +1,276 @@
 /* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
 
-// Include a header file from your module to test.
 #include "ns3/gps-tc.h"
+#include "ns3/gps-tc-helper.h"
+#include "ns3/tm-projection.h"
 
-// An essential include is test.h
 #include "ns3/test.h"
 
-// Do not put your test classes in namespace ns3.  You may find it useful
-// to use the using directive to access the ns3 namespace directly
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern "C" {
+  #include "ns3/utmups.h"
+}
+
 using namespace ns3;
 
-// This is an example TestCase.
-class GpsTcTestCase1 : public TestCase
+namespace
+{
+  // Trace points of all the vehicles, by vehicle ID
+  typedef std::map<std::string,std::vector<GPSTraceClient::positioning_data_t>> TracePoints;
+
+  TracePoints
+  LoadTrace (GPSTraceClientHelper &helper, const std::string &csvPath)
+  {
+    TracePoints points;
+    std::map<std::string,GPSTraceClient*> clients = helper.createTraceClientsFromCSV (csvPath);
+    for (auto &client : clients)
+      {
+        points[client.first] = client.second->getVehiclesdata ();
+        delete client.second;
+      }
+    return points;
+  }
+
+  // Inode of a file (0 if it does not exist): the cache file is replaced by a new one (with a new inode) when it is written
+  ino_t
+  GetInode (const std::string &path)
+  {
+    struct stat st;
+    return stat (path.c_str (), &st) == 0 ? st.st_ino : 0;
+  }
+
+  void
+  WriteFile (const std::string &path, const std::string &content)
+  {
+    std::ofstream out (path, std::ios::out | std::ios::trunc);
+    out << content;
+  }
+
+  void
+  RemoveFile (const std::string &path)
+  {
+    unlink (path.c_str ());
+  }
+
+  const char *TRACE_CSV =
+    "agent_id,agent_type,timeStamp_posix,latitude_deg,longitude_deg,speed_ms,heading_deg,accel_ms2\n"
+    "1,car,1597257836.0,45.567915,8.051233,10.0,90.0,0.0\n"
+    "2,car,1597257836.0,45.568000,8.051000,5.0,180.0,0.0\n"
+    "1,car,1597257836.1,45.567915,8.051246,10.0,90.0,0.0\n"
+    "2,car,1597257836.1,45.567995,8.051000,5.0,180.0,0.0\n";
+
+  const char *DATE_TRACE_CSV =
+    "agent_id,agent_type,date,latitude_deg,longitude_deg,speed_ms,heading_deg,accel_ms2\n"
+    "1,car,2020-08-12 18:43:56,45.567915,8.051233,10.0,90.0,0.0\n"
+    "1,car,2020-08-12 18:43:57,45.567915,8.051246,10.0,90.0,0.0\n";
+}
+
+// The binary cache of the parsed traces is written only when enabled, in the cache folder, it is used as long as the CSV
+// file, the configuration of the helper and the time zone do not change, and it gives the same points of the CSV file
+class GpsTcTraceCacheTestCase : public TestCase
+{
+public:
+  GpsTcTraceCacheTestCase ();
+  virtual ~GpsTcTraceCacheTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+GpsTcTraceCacheTestCase::GpsTcTraceCacheTestCase ()
+  : TestCase ("GPS trace cache hit, miss and invalidation")
+{
+}
+
+GpsTcTraceCacheTestCase::~GpsTcTraceCacheTestCase ()
+{
+}
+
+void
+GpsTcTraceCacheTestCase::DoRun (void)
+{
+  char dirTemplate[] = "/tmp/gps-tc-test-XXXXXX";
+  bool created = mkdtemp (dirTemplate) != nullptr;
+  NS_TEST_ASSERT_MSG_EQ (created, true, "Cannot create a temporary folder");
+  const std::string dir = dirTemplate;
+  const std::string cacheDir = dir + "/cache";
+  const std::string csvPath = dir + "/trace.csv";
+  WriteFile (csvPath, TRACE_CSV);
+
+  // Parsed without any cache
+  GPSTraceClientHelper uncached;
+  TracePoints reference = LoadTrace (uncached, csvPath);
+  NS_TEST_ASSERT_MSG_EQ (reference.size (), 2, "Wrong number of vehicles");
+  NS_TEST_ASSERT_MSG_EQ (reference["1"].size (), 2, "Wrong number of points");
+  NS_TEST_EXPECT_MSG_EQ (GetInode (uncached.getTraceCachePath (csvPath)), 0, "The cache was written although it is disabled");
+  NS_TEST_EXPECT_MSG_EQ (GetInode (csvPath + ".gpstc"), 0, "A cache file was written next to the CSV file");
+
+  // Miss: the cache is written in the cache folder
+  GPSTraceClientHelper helper;
+  helper.setTraceCache (true, cacheDir);
+  const std::string cachePath = helper.getTraceCachePath (csvPath);
+  NS_TEST_EXPECT_MSG_EQ (cachePath.compare (0, cacheDir.size (), cacheDir), 0, "The cache file is not in the cache folder");
+  TracePoints points = LoadTrace (helper, csvPath);
+  ino_t inode = GetInode (cachePath);
+  NS_TEST_ASSERT_MSG_NE (inode, 0, "The cache file was not written");
+
+  // Hit: the cache is read, and it is not written again
+  GPSTraceClientHelper helper2;
+  helper2.setTraceCache (true, cacheDir);
+  TracePoints cached = LoadTrace (helper2, csvPath);
+  NS_TEST_EXPECT_MSG_EQ (GetInode (cachePath), inode, "The cache file was written again");
+  for (auto &vehicle : reference)
+    {
+      NS_TEST_ASSERT_MSG_EQ (cached[vehicle.first].size (), vehicle.second.size (), "Wrong number of cached points of vehicle " << vehicle.first);
+      for (size_t i = 0; i < vehicle.second.size (); i++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (cached[vehicle.first][i].utc_time, vehicle.second[i].utc_time, "Wrong cached timestamp");
+          NS_TEST_EXPECT_MSG_EQ (cached[vehicle.first][i].tm_x, vehicle.second[i].tm_x, "Wrong cached x");
+          NS_TEST_EXPECT_MSG_EQ (cached[vehicle.first][i].tm_y, vehicle.second[i].tm_y, "Wrong cached y");
+          NS_TEST_EXPECT_MSG_EQ (cached[vehicle.first][i].heading, vehicle.second[i].heading, "Wrong cached heading");
+          NS_TEST_EXPECT_MSG_EQ (points[vehicle.first][i].tm_x, vehicle.second[i].tm_x, "Wrong x when writing the cache");
+        }
+    }
+
+  // Invalidation by a different configuration of the helper (heading in [-180,180])
+  GPSTraceClientHelper helper180;
+  helper180.setTraceCache (true, cacheDir);
+  helper180.setHeadingColumnName ("heading_deg", true);
+  TracePoints heading180 = LoadTrace (helper180, csvPath);
+  NS_TEST_EXPECT_MSG_NE (GetInode (cachePath), inode, "The cache was not invalidated by a different configuration");
+  NS_TEST_EXPECT_MSG_EQ_TOL (heading180["1"][0].heading, reference["1"][0].heading + 180.0, 1e-9, "An outdated cache was used");
+  inode = GetInode (cachePath);
+
+  // Invalidation by a modified CSV file (first point of vehicle 2 removed)
+  std::string modified = TRACE_CSV;
+  modified.erase (modified.find ("2,car"), modified.find ('\n', modified.find ("2,car")) - modified.find ("2,car") + 1);
+  WriteFile (csvPath, modified);
+  TracePoints reduced = LoadTrace (helper180, csvPath);
+  NS_TEST_EXPECT_MSG_NE (GetInode (cachePath), inode, "The cache was not invalidated by a modified CSV file");
+  NS_TEST_EXPECT_MSG_EQ (reduced["2"].size (), 1, "An outdated cache was used after the CSV file was modified");
+
+  // Invalidation by a different time zone, when the timestamps are dates converted in local time
+  const char *tz = getenv ("TZ");
+  bool hadTz = tz != nullptr;
+  std::string savedTz = hadTz ? tz : "";
+  const std::string datePath = dir + "/dates.csv";
+  WriteFile (datePath, DATE_TRACE_CSV);
+  GPSTraceClientHelper dateHelper;
+  dateHelper.setTraceCache (true, cacheDir);
+  dateHelper.setTimestampColumnName ("date", true, "%Y-%m-%d %H:%M:%S");
+  const std::string dateCachePath = dateHelper.getTraceCachePath (datePath);
+
+  setenv ("TZ", "UTC0", 1);
+  TracePoints utc = LoadTrace (dateHelper, datePath);
+  ino_t dateInode = GetInode (dateCachePath);
+  TracePoints utcCached = LoadTrace (dateHelper, datePath);
+  NS_TEST_EXPECT_MSG_EQ (GetInode (dateCachePath), dateInode, "The cache was not used with the same time zone");
+  NS_TEST_EXPECT_MSG_EQ (utcCached["1"][0].utc_time, utc["1"][0].utc_time, "Wrong cached timestamp");
+
+  setenv ("TZ", "CET-1", 1);
+  TracePoints cet = LoadTrace (dateHelper, datePath);
+  NS_TEST_EXPECT_MSG_NE (GetInode (dateCachePath), dateInode, "The cache was not invalidated by a different time zone");
+  NS_TEST_EXPECT_MSG_EQ (utc["1"][0].utc_time - cet["1"][0].utc_time, 3600 * 1000000L, "An outdated cache was used with a different time zone");
+
+  if (hadTz)
+    {
+      setenv ("TZ", savedTz.c_str (), 1);
+    }
+  else
+    {
+      unsetenv ("TZ");
+    }
+  tzset ();
+
+  RemoveFile (cachePath);
+  RemoveFile (dateCachePath);
+  RemoveFile (csvPath);
+  RemoveFile (datePath);
+  rmdir (cacheDir.c_str ());
+  rmdir (dir.c_str ());
+}
+
+// The local Transverse Mercator projection used for the GPS traces and the SUMO coordinates (TMProjection) gives the same
+// results of the GeographicLib TransverseMercator class, within a few nanometers
+class GpsTcProjectionAccuracyTestCase : public TestCase
 {
 public:
-  GpsTcTestCase1 ();
-  virtual ~GpsTcTestCase1 ();
+  GpsTcProjectionAccuracyTestCase ();
+  virtual ~GpsTcProjectionAccuracyTestCase ();
 
 private:
   virtual void DoRun (void);
 };
 
-// Add some help text to this case to describe what it is intended to test
-GpsTcTestCase1::GpsTcTestCase1 ()
-  : TestCase ("GpsTc test case (does nothing)")
+GpsTcProjectionAccuracyTestCase::GpsTcProjectionAccuracyTestCase ()
+  : TestCase ("TMProjection accuracy with respect to GeographicLib")
 {
 }
 
-// This destructor does nothing but we include it as a reminder that
-// the test case should clean up after itself
-GpsTcTestCase1::~GpsTcTestCase1 ()
+GpsTcProjectionAccuracyTestCase::~GpsTcProjectionAccuracyTestCase ()
 {
 }
 
-//
-// This method is the pure virtual method from class TestCase that every
-// TestCase must implement
-//
 void
-GpsTcTestCase1::DoRun (void)
+GpsTcProjectionAccuracyTestCase::DoRun (void)
 {
-  // A wide variety of test macros are available in src/core/test.h
-  NS_TEST_ASSERT_MSG_EQ (true, true, "true doesn't equal true for some reason");
-  // Use this one for floating point comparisons
-  NS_TEST_ASSERT_MSG_EQ_TOL (0.01, 0.01, 0.001, "Numbers are not equal within tolerance");
+  const int numPoints = 200000;
+  const size_t batchSize = 256;
+  const double lon0 = 9.0;
+  // Offset of the (x,y) coordinates, as for a SUMO network
+  const double xOffset = -421000.0;
+  const double yOffset = -5042000.0;
+
+  transverse_mercator_t geographicLib = UTMUPS_init_UTM_TransverseMercator ();
+  TMProjection projection (lon0, 0.9996, xOffset, yOffset);
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+
+  std::vector<double> lon (batchSize), lat (batchSize), x (batchSize), y (batchSize);
+  std::vector<double> xRef (batchSize), yRef (batchSize), lonRev (batchSize), latRev (batchSize);
+  double maxForwardError = 0, maxReverseError = 0, maxBatchError = 0;
+
+  for (int start = 0; start < numPoints; start += batchSize)
+    {
+      // Points within 10 degrees of the central meridian, outside the polar regions
+      for (size_t i = 0; i < batchSize; i++)
+        {
+          lon[i] = rand->GetValue (lon0 - 10.0, lon0 + 10.0);
+          lat[i] = rand->GetValue (-80.0, 84.0);
+          double gamma, k;
+          NS_TEST_ASSERT_MSG_EQ (TransverseMercator_Forward (&geographicLib, lon0, lat[i], lon[i], &xRef[i], &yRef[i], &gamma, &k), UTMUPS_OK, "GeographicLib forward projection failed");
+          xRef[i] += xOffset;
+          yRef[i] += yOffset;
+        }
+
+      projection.LonLatToXY (batchSize, lon.data (), lat.data (), x.data (), y.data ());
+      projection.XYToLonLat (batchSize, xRef.data (), yRef.data (), lonRev.data (), latRev.data ());
+
+      for (size_t i = 0; i < batchSize; i++)
+        {
+          maxForwardError = std::max ({maxForwardError, std::abs (x[i] - xRef[i]), std::abs (y[i] - yRef[i])});
+
+          double latRef, lonRef, gamma, k;
+          TransverseMercator_Reverse (&geographicLib, lon0, xRef[i] - xOffset, yRef[i] - yOffset, &latRef, &lonRef, &gamma, &k);
+          maxReverseError = std::max ({maxReverseError, std::abs (latRev[i] - latRef), std::abs (lonRev[i] - lonRef)});
+
+          // The batched conversion gives the same result of the single point one
+          double xSingle, ySingle;
+          projection.LonLatToXY (lon[i], lat[i], xSingle, ySingle);
+          maxBatchError = std::max ({maxBatchError, std::abs (x[i] - xSingle), std::abs (y[i] - ySingle)});
+        }
+    }
+
+  NS_TEST_EXPECT_MSG_LT (maxForwardError, 1e-7, "Forward projection error too large (m)");
+  NS_TEST_EXPECT_MSG_LT (maxReverseError, 1e-12, "Reverse projection error too large (degrees)");
+  NS_TEST_EXPECT_MSG_LT (maxBatchError, 1e-9, "The batched projection differs from the single point one (m)");
 }
 
-// The TestSuite class names the TestSuite, identifies what type of TestSuite,
-// and enables the TestCases to be run.  Typically, only the constructor for
-// this class must be defined
-//
 class GpsTcTestSuite : public TestSuite
 {
 public:
@@ -59,10 +280,9 @@ public:
 GpsTcTestSuite::GpsTcTestSuite ()
   : TestSuite ("gps-tc", UNIT)
 {
-  // TestDuration for TestCase can be QUICK, EXTENSIVE or TAKES_FOREVER
-  AddTestCase (new GpsTcTestCase1, TestCase::QUICK);
+  AddTestCase (new GpsTcTraceCacheTestCase, TestCase::QUICK);
+  AddTestCase (new GpsTcProjectionAccuracyTestCase, TestCase::QUICK);
 }
 
 // Do not forget to allocate an instance of this TestSuite
-static GpsTcTestSuite sgpsTcTestSuite;
-
+static GpsTcTestSuite gpsTcTestSuite;
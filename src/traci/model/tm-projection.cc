@@ -0,0 +1,273 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "tm-projection.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3 {
+
+namespace {
+
+// WGS84 ellipsoid
+const double WGS84_A = 6378137.0;
+const double WGS84_F = 1.0 / 298.257223563;
+
+const double DEG = M_PI / 180.0;
+
+// number of points converted together: each step of the conversion is applied to a whole block, in a separate loop
+const size_t TM_BLOCK_SIZE = 64;
+
+// number of Newton iterations in Tauf(); starting from taup/(1-e^2), two iterations already reach double precision
+const int TM_TAUF_ITERATIONS = 2;
+
+// Coefficients of the 6th order series, from GeographicLib (TransverseMercator.cpp)
+const double b1coeff[] = {
+  // b1*(n+1), polynomial in n2 of order 3
+  1, 4, 64, 256, 256,
+};
+
+const double alpcoeff[] = {
+  // alp[1]/n^1, polynomial in n of order 5
+  31564, -66675, 34440, 47250, -100800, 75600, 151200,
+  // alp[2]/n^2, polynomial in n of order 4
+  -1983433, 863232, 748608, -1161216, 524160, 1935360,
+  // alp[3]/n^3, polynomial in n of order 3
+  670412, 406647, -533952, 184464, 725760,
+  // alp[4]/n^4, polynomial in n of order 2
+  6601661, -7732800, 2230245, 7257600,
+  // alp[5]/n^5, polynomial in n of order 1
+  -13675556, 3438171, 7983360,
+  // alp[6]/n^6, polynomial in n of order 0
+  212378941, 319334400,
+};
+
+const double betcoeff[] = {
+  // bet[1]/n^1, polynomial in n of order 5
+  384796, -382725, -6720, 932400, -1612800, 1209600, 2419200,
+  // bet[2]/n^2, polynomial in n of order 4
+  -1118711, 1695744, -1174656, 258048, 80640, 3870720,
+  // bet[3]/n^3, polynomial in n of order 3
+  22276, -16929, -15984, 12852, 362880,
+  // bet[4]/n^4, polynomial in n of order 2
+  -830251, -158400, 197865, 7257600,
+  // bet[5]/n^5, polynomial in n of order 1
+  -435388, 453717, 15966720,
+  // bet[6]/n^6, polynomial in n of order 0
+  20648693, 638668800,
+};
+
+// Evaluate a polynomial of order "order", with the coefficients "p" starting from the highest order one
+double
+Polyval (int order, const double *p, double x)
+{
+  double y = *p++;
+  while (--order >= 0)
+    {
+      y = y * x + *p++;
+    }
+  return y;
+}
+
+// Normalize an angle (degrees) to [-180,180]
+inline double
+AngNormalize (double angle)
+{
+  return angle - 360.0 * std::nearbyint (angle / 360.0);
+}
+
+} // namespace
+
+TMProjection::TMProjection ()
+  : m_valid (false),
+    m_lon0 (0.0),
+    m_xOffset (0.0),
+    m_yOffset (0.0),
+    m_es (0.0),
+    m_e2m (1.0),
+    m_scale (1.0),
+    m_alp (),
+    m_bet (),
+    m_eatanhe1 (0.0)
+{
+}
+
+TMProjection::TMProjection (double lon0, double k0, double xOffset, double yOffset)
+  : m_valid (true),
+    m_lon0 (lon0),
+    m_xOffset (xOffset),
+    m_yOffset (yOffset)
+{
+  double e2 = WGS84_F * (2 - WGS84_F);
+  double n = WGS84_F / (2 - WGS84_F);
+
+  m_es = std::sqrt (e2);
+  m_e2m = 1 - e2;
+  m_eatanhe1 = m_es * std::atanh (m_es);
+
+  int m = maxpow / 2;
+  double b1 = Polyval (m, b1coeff, n * n) / (b1coeff[m + 1] * (1 + n));
+  m_scale = b1 * WGS84_A * k0;
+
+  m_alp[0] = m_bet[0] = 0.0;
+  int o = 0;
+  double d = n;
+  for (int l = 1; l <= maxpow; l++)
+    {
+      m = maxpow - l;
+      m_alp[l] = d * Polyval (m, alpcoeff + o, n) / alpcoeff[o + m + 1];
+      m_bet[l] = d * Polyval (m, betcoeff + o, n) / betcoeff[o + m + 1];
+      o += m + 2;
+      d *= n;
+    }
+}
+
+double
+TMProjection::Taupf (double tau) const
+{
+  // tan of the conformal latitude, from tau = tan of the latitude
+  double tau1 = std::hypot (1.0, tau);
+  double sig = std::sinh (m_es * std::atanh (m_es * tau / tau1));
+  return std::hypot (1.0, sig) * tau - sig * tau1;
+}
+
+double
+TMProjection::Tauf (double taup) const
+{
+  // inverse of Taupf(), with a fixed number of Newton iterations
+  double tau = std::fabs (taup) > 70 ? taup * std::exp (m_eatanhe1) : taup / m_e2m;
+  double tau0 = tau;
+
+  for (int i = 0; i < TM_TAUF_ITERATIONS; i++)
+    {
+      double taupa = Taupf (tau);
+      tau += (taup - taupa) * (1 + m_e2m * tau * tau) /
+             (m_e2m * std::hypot (1.0, tau) * std::hypot (1.0, taupa));
+    }
+
+  // close to the poles, the initial approximation is already exact (and the iterations may overflow)
+  return std::fabs (tau0) < 1e8 ? tau : tau0;
+}
+
+void
+TMProjection::LonLatToXY (size_t n, const double *lon, const double *lat, double *x, double *y) const
+{
+  double xip[TM_BLOCK_SIZE], etap[TM_BLOCK_SIZE];
+
+  for (size_t start = 0; start < n; start += TM_BLOCK_SIZE)
+    {
+      size_t len = std::min (TM_BLOCK_SIZE, n - start);
+      const double *blon = lon + start;
+      const double *blat = lat + start;
+
+      // 1. Gauss-Schreiber transverse Mercator coordinates (xi', eta')
+      for (size_t i = 0; i < len; i++)
+        {
+          double lam = AngNormalize (blon[i] - m_lon0) * DEG;
+          double phi = blat[i] * DEG;
+          double slam = std::sin (lam), clam = std::cos (lam);
+          double taup = Taupf (std::tan (phi));
+
+          xip[i] = std::atan2 (taup, clam);
+          etap[i] = std::asinh (slam / std::hypot (taup, clam));
+        }
+
+      // 2. Gauss-Krueger transverse Mercator coordinates (xi, eta), with the Clenshaw summation of the series
+      for (size_t i = 0; i < len; i++)
+        {
+          double c0 = std::cos (2 * xip[i]), s0 = std::sin (2 * xip[i]);
+          double e = std::exp (2 * etap[i]);
+          double ch0 = (e + 1 / e) / 2, sh0 = (e - 1 / e) / 2;
+
+          // a = 2 * cos(2*zeta')
+          double ar = 2 * c0 * ch0, ai = -2 * s0 * sh0;
+          double y0r = 0, y0i = 0, y1r = 0, y1i = 0;
+          for (int k = maxpow; k > 0; k -= 2)
+            {
+              double tr = ar * y0r - ai * y0i - y1r + m_alp[k];
+              double ti = ar * y0i + ai * y0r - y1i;
+              y1r = tr; y1i = ti;
+              tr = ar * y1r - ai * y1i - y0r + m_alp[k - 1];
+              ti = ar * y1i + ai * y1r - y0i;
+              y0r = tr; y0i = ti;
+            }
+
+          // zeta = zeta' + sin(2*zeta') * y0
+          double sr = s0 * ch0, si = c0 * sh0;
+          double xi = xip[i] + sr * y0r - si * y0i;
+          double eta = etap[i] + sr * y0i + si * y0r;
+
+          x[start + i] = m_scale * eta + m_xOffset;
+          y[start + i] = m_scale * xi + m_yOffset;
+        }
+    }
+}
+
+void
+TMProjection::XYToLonLat (size_t n, const double *x, const double *y, double *lon, double *lat) const
+{
+  double xip[TM_BLOCK_SIZE], etap[TM_BLOCK_SIZE];
+
+  for (size_t start = 0; start < n; start += TM_BLOCK_SIZE)
+    {
+      size_t len = std::min (TM_BLOCK_SIZE, n - start);
+      const double *bx = x + start;
+      const double *by = y + start;
+
+      // 1. Gauss-Schreiber transverse Mercator coordinates (xi', eta'), with the Clenshaw summation of the series
+      for (size_t i = 0; i < len; i++)
+        {
+          double xi = (by[i] - m_yOffset) / m_scale;
+          double eta = (bx[i] - m_xOffset) / m_scale;
+          double c0 = std::cos (2 * xi), s0 = std::sin (2 * xi);
+          double e = std::exp (2 * eta);
+          double ch0 = (e + 1 / e) / 2, sh0 = (e - 1 / e) / 2;
+
+          // a = 2 * cos(2*zeta)
+          double ar = 2 * c0 * ch0, ai = -2 * s0 * sh0;
+          double y0r = 0, y0i = 0, y1r = 0, y1i = 0;
+          for (int k = maxpow; k > 0; k -= 2)
+            {
+              double tr = ar * y0r - ai * y0i - y1r - m_bet[k];
+              double ti = ar * y0i + ai * y0r - y1i;
+              y1r = tr; y1i = ti;
+              tr = ar * y1r - ai * y1i - y0r - m_bet[k - 1];
+              ti = ar * y1i + ai * y1r - y0i;
+              y0r = tr; y0i = ti;
+            }
+
+          // zeta' = zeta + sin(2*zeta) * y0
+          double sr = s0 * ch0, si = c0 * sh0;
+          xip[i] = xi + sr * y0r - si * y0i;
+          etap[i] = eta + sr * y0i + si * y0r;
+        }
+
+      // 2. Geographic coordinates
+      for (size_t i = 0; i < len; i++)
+        {
+          double s = std::sinh (etap[i]);
+          double c = std::max (0.0, std::cos (xip[i]));
+          double r = std::hypot (s, c);
+          double tau = Tauf (std::sin (xip[i]) / r);
+
+          lon[start + i] = AngNormalize (m_lon0 + std::atan2 (s, c) / DEG);
+          lat[start + i] = std::atan (tau) / DEG;
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TM_PROJECTION_H
+#define TM_PROJECTION_H
+
+#include <cstddef>
+
+namespace ns3 {
+
+/**
+ * \ingroup traci
+ *
+ * \brief Transverse Mercator projection (WGS84 ellipsoid) of batches of points, computed locally.
+ *
+ * The projection uses the 6th order Krueger series, with the same coefficients of the TransverseMercator
+ * class of GeographicLib (C. F. F. Karney, "Transverse Mercator with an accuracy of a few nanometers",
+ * J. Geodesy 85(8), 475-485, 2011), and it is accurate to a few nanometers within 3900 km of the central meridian.
+ * The (x,y) coordinates are shifted by a constant offset, which can be used to obtain UTM coordinates
+ * (false easting/northing) or the Cartesian coordinates of a SUMO network (false easting/northing plus the
+ * network offset).
+ *
+ * The conversion functions work on arrays of coordinates: each point is processed with the same sequence of
+ * operations, without any data-dependent branch, so that the loops can be vectorized by the compiler.
+ * Points which are more than 90 degrees away from the central meridian, and the poles, are not supported.
+ */
+class TMProjection
+{
+public:
+  // invalid projection (IsValid() returns false)
+  TMProjection ();
+  // projection with central meridian lon0 (degrees), scale factor k0 on the central meridian, and (x,y) offset
+  TMProjection (double lon0, double k0 = 0.9996, double xOffset = 0.0, double yOffset = 0.0);
+
+  bool IsValid () const {return m_valid;}
+
+  double GetLon0 () const {return m_lon0;}
+  void SetOffset (double xOffset, double yOffset) {m_xOffset = xOffset; m_yOffset = yOffset;}
+  double GetXOffset () const {return m_xOffset;}
+  double GetYOffset () const {return m_yOffset;}
+
+  // (lon,lat) in degrees -> (x,y) in meters, for n points (the output arrays can be the same as the input ones)
+  void LonLatToXY (size_t n, const double *lon, const double *lat, double *x, double *y) const;
+  // (x,y) in meters -> (lon,lat) in degrees, for n points (the output arrays can be the same as the input ones)
+  void XYToLonLat (size_t n, const double *x, const double *y, double *lon, double *lat) const;
+
+  // single point versions
+  void LonLatToXY (double lon, double lat, double &x, double &y) const {LonLatToXY (1, &lon, &lat, &x, &y);}
+  void XYToLonLat (double x, double y, double &lon, double &lat) const {XYToLonLat (1, &x, &y, &lon, &lat);}
+
+  // UTM central meridian of a zone (1-60), in degrees
+  static double UTMCentralMeridian (int zone) {return 6.0 * zone - 183.0;}
+
+private:
+  static const int maxpow = 6;
+
+  double Taupf (double tau) const;
+  double Tauf (double taup) const;
+
+  bool m_valid;
+  double m_lon0;
+  double m_xOffset;
+  double m_yOffset;
+
+  double m_es; // eccentricity
+  double m_e2m; // 1 - e^2
+  double m_scale; // a1 * k0
+  double m_alp[maxpow + 1]; // forward series coefficients (m_alp[0] is unused)
+  double m_bet[maxpow + 1]; // reverse series coefficients (m_bet[0] is unused)
+  double m_eatanhe1; // es * atanh (es)
+};
+
+} // namespace ns3
+
+#endif /* TM_PROJECTION_H */
@@ -26,9 +26,13 @@
 #include <iostream>
 #include <fstream>
 #include <regex>
+#include <unordered_set>
 #include <string>
 #include <sys/socket.h>
+#include <sys/file.h>
+#include <fcntl.h>
 #include <netinet/in.h>
+#include <cmath>
 
 #include "traci-client.h"
 
@@ -36,6 +40,10 @@ namespace ns3
 {
   NS_LOG_COMPONENT_DEFINE("TraciClient");
 
+  // variables subscribed to for each vehicle/pedestrian, and received together with every simulation step
+  static const std::vector<int> vehicleKinematicVars = {VAR_POSITION, VAR_SPEED, VAR_ANGLE, VAR_DISTANCE, VAR_ACCELERATION};
+  static const std::vector<int> personKinematicVars = {VAR_POSITION, VAR_SPEED, VAR_ANGLE};
+
   TypeId
   TraciClient::GetTypeId(void)
   {
@@ -114,7 +122,22 @@ namespace ns3
                   "Name of the network namespace to be used to launch SUMO",
                    StringValue (""),
                    MakeStringAccessor (&TraciClient::m_netns_name),
-                   MakeStringChecker ());
+                   MakeStringChecker ())
+    .AddAttribute ("Partition",
+                  "Spatial partition of the map: if set, only the nodes inside the local tile and its ghost ring are simulated.",
+                  PointerValue (0),
+                  MakePointerAccessor (&TraciClient::m_partition),
+                  MakePointerChecker<TraciPartition> ())
+    .AddAttribute ("LocalProjection",
+                  "If true, the conversions between (x,y) and (lon,lat) coordinates are computed by ns-3 whenever the projection of the SUMO network can be reproduced locally, instead of being requested to SUMO.",
+                  BooleanValue (true),
+                  MakeBooleanAccessor (&TraciClient::m_useLocalProjection),
+                  MakeBooleanChecker ())
+    .AddAttribute ("LocalProjectionTolerance",
+                  "Maximum difference (in meters) between the conversions computed by ns-3 and the ones computed by SUMO, for the local projection to be used.",
+                  DoubleValue (0.005),
+                  MakeDoubleAccessor (&TraciClient::m_localProjectionTolerance),
+                  MakeDoubleChecker<double> (0.0));
   ;
     return tid;
   }
@@ -133,6 +156,9 @@ namespace ns3
     m_sumoWaitForSocket = ns3::Seconds(1.0);
     m_vehicle_visualizer = nullptr;
     m_netns_name = "";
+    m_partition = nullptr;
+    m_useLocalProjection = true;
+    m_localProjectionTolerance = 0.005;
   }
 
   TraciClient::~TraciClient(void)
@@ -146,6 +172,13 @@ namespace ns3
   {
     NS_LOG_FUNCTION(this);
 
+    // release the SUMO port reservation
+    if (m_sumoPortLockFd >= 0)
+      {
+        ::close(m_sumoPortLockFd);
+        m_sumoPortLockFd = -1;
+      }
+
     try
       {
         this->TraCIAPI::close();
@@ -162,19 +195,168 @@ namespace ns3
   {
     NS_LOG_FUNCTION(this);
 
-    std::string foundNode("");
+    NodeHandle_t handle = GetNodeHandle(node);
+
+    if (handle == InvalidNodeHandle)
+      {
+        return std::string("");
+      }
+
+    return m_nodeEntries[handle].sumoId;
+  }
+
+  TraciClient::NodeHandle_t
+  TraciClient::GetNodeHandle(const std::string &id) const
+  {
+    auto it = m_sumoIdToHandle.find(id);
+
+    return it != m_sumoIdToHandle.end() ? it->second : InvalidNodeHandle;
+  }
+
+  TraciClient::NodeHandle_t
+  TraciClient::GetNodeHandle(Ptr<Node> node) const
+  {
+    if (node == nullptr)
+      {
+        return InvalidNodeHandle;
+      }
+
+    auto it = m_nodeIdToHandle.find(node->GetId());
+
+    // the ns3 node ID is unique, but check the pointer as well in case the same ID is reused by a different node
+    if (it == m_nodeIdToHandle.end() || m_nodeEntries[it->second].node != node)
+      {
+        return InvalidNodeHandle;
+      }
+
+    return it->second;
+  }
+
+  Ptr<Node>
+  TraciClient::GetNode(const std::string &id) const
+  {
+    NodeHandle_t handle = GetNodeHandle(id);
+
+    return handle != InvalidNodeHandle ? m_nodeEntries[handle].node : nullptr;
+  }
+
+  const TraciClient::StationKinematics_t *
+  TraciClient::GetStationKinematics(const std::string &id) const
+  {
+    NodeHandle_t handle = GetNodeHandle(id);
+
+    if (handle == InvalidNodeHandle || !m_nodeEntries[handle].hasKinematics)
+      {
+        return nullptr;
+      }
+
+    return &m_nodeEntries[handle].kinematics;
+  }
+
+  uint64_t
+  TraciClient::GetStationNumericId(const std::string &id) const
+  {
+    NodeHandle_t handle = GetNodeHandle(id);
+
+    if (handle != InvalidNodeHandle)
+      {
+        return m_nodeEntries[handle].stationId;
+      }
+
+    return ParseStationId(id, StationType_unknown);
+  }
+
+  uint64_t
+  TraciClient::GetStationNumericId(Ptr<Node> node) const
+  {
+    NodeHandle_t handle = GetNodeHandle(node);
+
+    NS_ASSERT_MSG(handle != InvalidNodeHandle, "Node is not registered in the TraCI client node map");
 
-    // search map for corresponding node
-    for (std::map<std::string, std::pair< StationType_t, Ptr<Node> > >::iterator it = m_NodeMap.begin(); it != m_NodeMap.end(); ++it)
+    return m_nodeEntries[handle].stationId;
+  }
+
+  uint64_t
+  TraciClient::ParseStationId(const std::string &id, StationType_t stationType)
+  {
+    const char *numericPart = nullptr;
+
+    if (stationType == StationType_roadSideUnit)
       {
-        if (it->second.second == node)
+        // RSU IDs are in the form "<prefix>_N"
+        size_t underscorePos = id.find('_');
+        if (underscorePos != std::string::npos)
           {
-            foundNode = it->first;
-            break;
+            numericPart = id.c_str() + underscorePos + 1;
           }
       }
+    else if (id.size() > 3)
+      {
+        // vehicles and pedestrians IDs are in the form "vehN"/"pedN"
+        numericPart = id.c_str() + 3;
+      }
+
+    if (numericPart == nullptr)
+      {
+        return 0;
+      }
+
+    return std::strtoull(numericPart, nullptr, 10);
+  }
+
+  TraciClient::NodeHandle_t
+  TraciClient::RegisterNode(const std::string &id, StationType_t stationType, Ptr<Node> node)
+  {
+    NodeHandle_t handle = static_cast<NodeHandle_t>(m_nodeEntries.size());
+
+    m_nodeEntries.push_back({id, stationType, node, ParseStationId(id, stationType)});
+    m_sumoIdToHandle[id] = handle;
+    if (node != nullptr)
+      {
+        m_nodeIdToHandle[node->GetId()] = handle;
+      }
+
+    return handle;
+  }
+
+  void
+  TraciClient::UnregisterNode(NodeHandle_t handle)
+  {
+    NS_ASSERT(handle < m_nodeEntries.size());
+
+    NodeEntry_t &removed = m_nodeEntries[handle];
+    m_sumoIdToHandle.erase(removed.sumoId);
+    if (removed.node != nullptr)
+      {
+        m_nodeIdToHandle.erase(removed.node->GetId());
+      }
+
+    // move the last entry into the freed slot, so that the array stays dense
+    NodeHandle_t last = static_cast<NodeHandle_t>(m_nodeEntries.size() - 1);
+    if (handle != last)
+      {
+        removed = std::move(m_nodeEntries[last]);
+        m_sumoIdToHandle[removed.sumoId] = handle;
+        if (removed.node != nullptr)
+          {
+            m_nodeIdToHandle[removed.node->GetId()] = handle;
+          }
+      }
+
+    m_nodeEntries.pop_back();
+  }
+
+  std::map< std::string, std::pair< StationType_t, Ptr<Node> > >
+  TraciClient::get_NodeMap()
+  {
+    std::map< std::string, std::pair< StationType_t, Ptr<Node> > > nodeMap;
+
+    for (const NodeEntry_t &entry : m_nodeEntries)
+      {
+        nodeMap.emplace(entry.sumoId, std::make_pair(entry.stationType, entry.node));
+      }
 
-    return foundNode;
+    return nodeMap;
   }
 
   std::string
@@ -245,7 +427,7 @@ namespace ns3
   {
     NS_LOG_FUNCTION(this);
 
-    m_sumoPort = GetFreePort(m_sumoPort);
+    m_sumoPort = GetFreePort(m_sumoPort, &m_sumoPortLockFd);
 
     m_includeNode = includeNode;
     m_excludeNode = excludeNode;
@@ -284,6 +466,8 @@ namespace ns3
         NS_FATAL_ERROR("Can not connect to sumo via traci: " << e.what());
       }
 
+    InitLocalProjection();
+
     if (m_vehicle_visualizer!=nullptr && m_vehicle_visualizer->isConnected())
     {
         /* Compute central position of the map to be sent to the web visualizer */
@@ -293,8 +477,8 @@ namespace ns3
         double lon,lat;
         /* Convert (x,y) to (long,lat) */
         // Long = x, Lat = y
-        pos1 = this->TraCIAPI::simulation.convertXYtoLonLat (net_boundaries[0].x,net_boundaries[0].y);
-        pos2 = this->TraCIAPI::simulation.convertXYtoLonLat (net_boundaries[1].x,net_boundaries[1].y);
+        pos1 = ConvertXYtoLonLat (net_boundaries[0].x,net_boundaries[0].y);
+        pos2 = ConvertXYtoLonLat (net_boundaries[1].x,net_boundaries[1].y);
         /* Check the center of the map */
         lon = (pos1.x + pos2.x)/2;
         lat = (pos1.y + pos2.y)/2;
@@ -306,6 +490,16 @@ namespace ns3
     }
 
 
+    // split the network boundary into the tiles of the partition
+    if (m_partition != nullptr)
+      {
+        libsumo::TraCIPositionVector net_boundaries = this->TraCIAPI::simulation.getNetBoundary ();
+        m_partition->SetBoundary (net_boundaries[0].x, net_boundaries[0].y, net_boundaries[1].x, net_boundaries[1].y);
+      }
+
+    // receive the departed/arrived vehicles together with each simulation step, instead of polling for them
+    SubscribeDepartedArrived();
+
     // start sumo and simulate until the specified time
     this->TraCIAPI::simulationStep(m_startTime.GetSeconds());
 
@@ -355,45 +549,57 @@ namespace ns3
 
     try
       {
-        // iterate over all nodes in the map
-        for (std::map<std::string, std::pair< StationType_t, Ptr<Node> > >::iterator it = m_NodeMap.begin(); it != m_NodeMap.end(); ++it)
+        // the vehicle visualizer updates are computed only when a new frame can be sent (the frame rate is decoupled from the mobility step)
+        bool visFrameDue = m_vehicle_visualizer!=nullptr && m_vehicle_visualizer->isConnected() && m_vehicle_visualizer->isFrameDue();
+
+        // the kinematic state of all the vehicles/pedestrians has been received together with the simulation step
+        const libsumo::SubscriptionResults &vehicleResults = this->TraCIAPI::vehicle.getModifiableSubscriptionResults();
+        const libsumo::SubscriptionResults &personResults = this->TraCIAPI::person.getModifiableSubscriptionResults();
+
+        // iterate over all nodes in the registry
+        for (NodeEntry_t &entry : m_nodeEntries)
           {
-            // get current vehicle/pedestrian from the map
-            std::string node_ID(it->first);
-
-            // get vehicle/pedestrian position from sumo
-            libsumo::TraCIPosition pos;
-            if(it->second.first == StationType_pedestrian)
-               pos = this->TraCIAPI::person.getPosition(node_ID);
-            else if (it->second.first == StationType_roadSideUnit)
+            // get current vehicle/pedestrian from the registry
+            const std::string &node_ID = entry.sumoId;
+
+            if (entry.stationType == StationType_roadSideUnit)
               continue;
-            else
-               pos = this->TraCIAPI::vehicle.getPosition(node_ID);
 
-            // get corresponding ns3 node from map
-            Ptr<MobilityModel> mob = m_NodeMap.at(node_ID).second->GetObject<MobilityModel>();
+            // store the kinematic state of this step in the registry, and ask sumo only if it is not available
+            ReadKinematics(entry, vehicleResults, personResults);
+            if (!entry.hasKinematics)
+              {
+                entry.kinematics.position = entry.stationType == StationType_pedestrian ? this->TraCIAPI::person.getPosition(node_ID)
+                                                                                        : this->TraCIAPI::vehicle.getPosition(node_ID);
+              }
+            const libsumo::TraCIPosition &pos = entry.kinematics.position;
+
+            // get corresponding ns3 node from the registry
+            Ptr<MobilityModel> mob = entry.node->GetObject<MobilityModel>();
             // set ns3 node position with user defined altitude
             mob->SetPosition(Vector(pos.x, pos.y, m_altitude));
 
             if (m_sionna == true)
             {
               Vector pos_for_sionna = Vector(pos.x, pos.y, m_altitude);
-              double angle_for_sionna = this->TraCIAPI::vehicle.getAngle(node_ID);
-              double speed = this->TraCIAPI::vehicle.getSpeed(node_ID);
+              double angle_for_sionna = entry.hasKinematics ? entry.kinematics.angle : this->TraCIAPI::vehicle.getAngle(node_ID);
+              double speed = entry.hasKinematics ? entry.kinematics.speed : this->TraCIAPI::vehicle.getSpeed(node_ID);
               Vector vel_for_sionna = Vector(speed * cos(angle_for_sionna), speed * sin(angle_for_sionna), 0.0);
               updateLocationInSionna(node_ID, pos_for_sionna, angle_for_sionna, vel_for_sionna);
             }
             
-            if (m_vehicle_visualizer!=nullptr && m_vehicle_visualizer->isConnected() && it->second.first != StationType_pedestrian)
+            if (visFrameDue && entry.stationType != StationType_pedestrian)
             {
-                libsumo::TraCIPosition lonlat = this->TraCIAPI::simulation.convertXYtoLonLat (pos.x,pos.y);
-                int rval = m_vehicle_visualizer->sendObjectUpdate (node_ID,lonlat.y,lonlat.x,this->TraCIAPI::vehicle.getAngle (node_ID));
-                if (rval<0)
-                {
-                    NS_FATAL_ERROR("Error: cannot send the object update to the vehicle visualizer for vehicle: "<<node_ID);
-                }
+                libsumo::TraCIPosition lonlat = ConvertXYtoLonLat (pos.x,pos.y);
+                m_vehicle_visualizer->addObjectToFrame (node_ID,lonlat.y,lonlat.x,entry.hasKinematics ? entry.kinematics.angle : this->TraCIAPI::vehicle.getAngle (node_ID));
             }
           }
+
+        // send all the object updates of this step in a single frame
+        if (visFrameDue && m_vehicle_visualizer->flushFrame (true)<0)
+          {
+            NS_FATAL_ERROR("Error: cannot send the object updates frame to the vehicle visualizer.");
+          }
       }
     catch (std::exception& e)
       {
@@ -415,25 +621,25 @@ namespace ns3
 
     try
       {
-        // ask sumo for all (new) departed vehicles SINCE last simulation step (=one synch interval)
-        std::vector<std::string> departedVehicles = this->TraCIAPI::simulation.getDepartedIDList();
+        // get all (new) departed vehicles SINCE last simulation step (=one synch interval)
+        std::vector<std::string> departedVehicles = GetDepartedArrivedIdList(VAR_DEPARTED_VEHICLES_IDS);
 
-        // ask sumo for all (new) arrived vehicles SINCE last simulation step (=one synch interval)
-        std::vector<std::string> arrivedVehicles = this->TraCIAPI::simulation.getArrivedIDList();
+        // get all (new) arrived vehicles SINCE last simulation step (=one synch interval)
+        std::vector<std::string> arrivedVehicles = GetDepartedArrivedIdList(VAR_ARRIVED_VEHICLES_IDS);
+
+        // hash set of the arrived vehicles, to match them against the departed ones in O(1)
+        std::unordered_set<std::string> arrivedSet(arrivedVehicles.begin(), arrivedVehicles.end());
 
         // iterate over departed vehicles
         for (std::vector<std::string>::iterator it = departedVehicles.begin(); it != departedVehicles.end(); ++it)
           {
             // get departed vehicle
-            std::string veh(*it);
-
-            // search for same vehicle in arrived vehicles
-            std::vector<std::string>::iterator pos = std::find(arrivedVehicles.begin(), arrivedVehicles.end(), veh);
+            const std::string &veh(*it);
 
             // if vehicle is found in both lists, ignore it; all others are considered as relevant vehicles for simulation
-            if (pos != arrivedVehicles.end())
+            if (arrivedSet.erase(veh) != 0)
               {
-                arrivedVehicles.erase(pos);
+                continue;
               }
             else
               {
@@ -449,13 +655,16 @@ namespace ns3
         for (std::vector<std::string>::iterator it = arrivedVehicles.begin(); it != arrivedVehicles.end(); ++it)
           {
             // get arrived vehicle
-            std::string veh(*it);
+            const std::string &veh(*it);
 
-            // search for arrived vehicle in vehicleNodeMap
-            std::map<std::string, std::pair< StationType_t, Ptr<Node> > >::iterator pos = m_NodeMap.find(veh);
+            // skip the vehicles which departed and arrived during the same simulation step
+            if (arrivedSet.count(veh) == 0)
+              {
+                continue;
+              }
 
-            // if node is in map, exclude it, otherwise is was not simulated in ns3 because of the penetration rate
-            if (pos != m_NodeMap.end())
+            // if node is in the registry, exclude it, otherwise is was not simulated in ns3 because of the penetration rate
+            if (m_sumoIdToHandle.count(veh) != 0)
               {
                 sumoVehicles.push_back (veh);
               }
@@ -475,40 +684,35 @@ namespace ns3
 
     try
       {
-        // get departed and arrived sumo vehicles since last simulation step
-        std::vector<std::string> sumoVehicles;
-        GetSumoVehicles(sumoVehicles);
-
-        // iterate over all sumo vehicles with changes; include departed vehicles, exclude arrived vehicles
-        for (std::vector<std::string>::iterator it = sumoVehicles.begin(); it != sumoVehicles.end(); ++it)
+        if (m_partition != nullptr)
           {
-            // get current vehicle
-            std::string veh(*it);
-
-            // search for vehicle in vehicleNodeMap
-            std::map<std::string,std::pair< StationType_t, Ptr<Node> >>::iterator pos = m_NodeMap.find(veh);
+            // include/exclude the vehicles entering/leaving the local tile and its ghost ring
+            SynchronisePartitionedVehicles();
+          }
+        else
+          {
+            // get departed and arrived sumo vehicles since last simulation step
+            std::vector<std::string> sumoVehicles;
+            GetSumoVehicles(sumoVehicles);
 
-            // if it is already in the map, remove it and exclude node
-            if (pos != m_NodeMap.end())
+            // iterate over all sumo vehicles with changes; include departed vehicles, exclude arrived vehicles
+            for (std::vector<std::string>::iterator it = sumoVehicles.begin(); it != sumoVehicles.end(); ++it)
               {
-                // get corresponding ns3 node
-                Ptr<ns3::Node> exNode = m_NodeMap.at(veh).second;
+                // get current vehicle
+                const std::string &veh(*it);
 
-                // call exclude function for this node
-                m_excludeNode(exNode,veh);
-
-                // unregister in map
-                m_NodeMap.erase(veh);
-              }
-            else // if it is not in the map, create a new ns3 node for it
-              {
-                // create new node by calling the include function
-                std::pair<StationType_t, Ptr<ns3::Node>> inNode;
-                inNode.first = StationType_passengerCar;
-                inNode.second = m_includeNode(veh,StationTypeTraci_vehicle);
+                // search for vehicle in the node registry
+                NodeHandle_t handle = GetNodeHandle(veh);
 
-                // register in the map (link vehicle to node!)
-                m_NodeMap.insert(std::pair<std::string, std::pair<StationType_t, Ptr<ns3::Node>>>(veh, inNode));
+                // if it is already in the registry, exclude the node, otherwise create a new ns3 node for it
+                if (handle != InvalidNodeHandle)
+                  {
+                    ExcludeStation(handle);
+                  }
+                else
+                  {
+                    IncludeStation(veh, StationTypeTraci_vehicle);
+                  }
               }
           }
 
@@ -519,51 +723,58 @@ namespace ns3
           }
 
         if(!m_pedlist_empty){
+            // Hash set of the pedestrians currently present in the simulation
+            std::unordered_set<std::string> sumoPedSet(sumoPed.begin(), sumoPed.end());
+
             // Iterate over all pedestrians present in the simulation
             for (std::vector<std::string>::iterator it = sumoPed.begin(); it != sumoPed.end(); ++it){
                 // Get current pedestrian
-                std::string ped(*it);
-
-                // Search for pedestrian in the node map
-                std::map<std::string, std::pair< StationType_t, Ptr<Node> > >::iterator pos = m_NodeMap.find(ped);
-
-                // If the pedestrian is not present in the node map yet, include it
-                if (pos == m_NodeMap.end()){
-                    // Create the new node by calling the include function
-                    std::pair<StationType_t, Ptr<ns3::Node>> inNode_ped;
-                    inNode_ped.first = StationType_pedestrian;
-                    inNode_ped.second = m_includeNode(ped,StationTypeTraci_pedestrian);
+                const std::string &ped(*it);
+
+                // If the pedestrian is not present in the node registry yet, include it
+                // (in partitioned mode, only if it is inside the local tile or its ghost ring)
+                if (m_pedestrianIds.count(ped) == 0){
+                    if (m_partition != nullptr){
+                        libsumo::TraCIPosition pos = this->TraCIAPI::person.getPosition(ped);
+                        if (!m_partition->ShouldInclude(pos.x, pos.y)){
+                            continue;
+                          }
+                      }
 
-                    // Register the new node in the map
-                    m_NodeMap.insert(std::pair<std::string, std::pair<StationType_t, Ptr<ns3::Node>>>(ped, inNode_ped));
+                    // Create the new node by calling the include function and register it in the registry
+                    IncludeStation(ped, StationTypeTraci_pedestrian);
+                    m_pedestrianIds.insert(ped);
                   }
               }
 
-            // Iterate over all nodes present in the node map
-            for (auto it = m_NodeMap.begin(); it != m_NodeMap.end(); /* no increment here */){
-                std::string node_ID = it->first;
-
-                // Check if the extracted node corresponds to a pedestrian
-                if(it->second.first == StationType_pedestrian){
-                    // Search for the given node among the pedestrians present in the simulation
-                    auto iter = std::find(sumoPed.begin(), sumoPed.end(), node_ID);
+            // Look for the registered pedestrians which are no more present in the simulation
+            // (only the pedestrians are checked, not the whole node registry)
+            // In partitioned mode, the pedestrians which left the ghost ring are excluded as well
+            std::vector<std::string> leftPed;
+            for (const std::string &ped : m_pedestrianIds){
+                if (sumoPedSet.count(ped) == 0){
+                    leftPed.push_back(ped);
+                  }
+                else if (m_partition != nullptr){
+                    Vector pos = m_nodeEntries[GetNodeHandle(ped)].node->GetObject<MobilityModel>()->GetPosition();
+                    if (m_partition->ShouldExclude(pos.x, pos.y)){
+                        leftPed.push_back(ped);
+                      }
+                  }
+              }
 
-                    // If the node is not currently present in the simulation, remove it
-                    if(iter == sumoPed.end()){
-                        // get corresponding ns3 node
-                        Ptr<ns3::Node> exNode_ped = it->second.second;
+            // Exclude the nodes in a deterministic order, independent of the hash set iteration order
+            std::sort(leftPed.begin(), leftPed.end());
 
-                        // Call exclude function for this node
-                        m_excludeNode(exNode_ped,node_ID);
+            for (const std::string &node_ID : leftPed){
+                NodeHandle_t handle = GetNodeHandle(node_ID);
 
-                        // Unregister in map and update iterator
-                        it = m_NodeMap.erase(it);
-                      } else {
-                        ++it;
-                      }
-                  } else {
-                    ++it;
+                if (handle != InvalidNodeHandle){
+                    // Call exclude function for this node and unregister it
+                    ExcludeStation(handle);
                   }
+
+                m_pedestrianIds.erase(node_ID);
               }
           }
       }
@@ -574,10 +785,387 @@ namespace ns3
       }
   }
 
+void
+TraciClient::IncludeStation(const std::string &id, StationTypeTraCI_t stationType)
+{
+  // create new node by calling the include function
+  Ptr<ns3::Node> inNode = m_includeNode(id, stationType);
+
+  // register in the registry (link vehicle/pedestrian to node!)
+  NodeHandle_t handle = RegisterNode(id, stationType == StationTypeTraci_pedestrian ? StationType_pedestrian : StationType_passengerCar, inNode);
+
+  // the kinematic variables are received with each simulation step from now on (in partitioned mode, the vehicles are
+  // already subscribed to since their departure), and their current values are returned by the subscription itself
+  if (m_partition == nullptr || stationType == StationTypeTraci_pedestrian)
+    {
+      SubscribeKinematics(id, stationType);
+    }
+  ReadKinematics(m_nodeEntries[handle], this->TraCIAPI::vehicle.getModifiableSubscriptionResults(),
+                 this->TraCIAPI::person.getModifiableSubscriptionResults());
+}
+
+void
+TraciClient::SubscribeKinematics(const std::string &id, StationTypeTraCI_t stationType)
+{
+  if (stationType == StationTypeTraci_pedestrian)
+    {
+      this->TraCIAPI::person.subscribe(id, personKinematicVars, INVALID_DOUBLE_VALUE, INVALID_DOUBLE_VALUE);
+    }
+  else
+    {
+      this->TraCIAPI::vehicle.subscribe(id, vehicleKinematicVars, INVALID_DOUBLE_VALUE, INVALID_DOUBLE_VALUE);
+    }
+}
+
+void
+TraciClient::ReadKinematics(NodeEntry_t &entry, const libsumo::SubscriptionResults &vehicleResults,
+                            const libsumo::SubscriptionResults &personResults)
+{
+  const libsumo::SubscriptionResults &results = entry.stationType == StationType_pedestrian ? personResults : vehicleResults;
+  auto it = results.find(entry.sumoId);
+
+  entry.hasKinematics = false;
+  if (it == results.end())
+    {
+      return;
+    }
+
+  auto posIt = it->second.find(VAR_POSITION);
+  auto speedIt = it->second.find(VAR_SPEED);
+  auto angleIt = it->second.find(VAR_ANGLE);
+  if (posIt == it->second.end() || speedIt == it->second.end() || angleIt == it->second.end())
+    {
+      return;
+    }
+
+  entry.kinematics.position = *std::static_pointer_cast<libsumo::TraCIPosition>(posIt->second);
+  entry.kinematics.speed = std::static_pointer_cast<libsumo::TraCIDouble>(speedIt->second)->value;
+  entry.kinematics.angle = std::static_pointer_cast<libsumo::TraCIDouble>(angleIt->second)->value;
+
+  auto distanceIt = it->second.find(VAR_DISTANCE);
+  entry.kinematics.distance = distanceIt != it->second.end() ? std::static_pointer_cast<libsumo::TraCIDouble>(distanceIt->second)->value : 0.0;
+  auto accelerationIt = it->second.find(VAR_ACCELERATION);
+  entry.kinematics.acceleration = accelerationIt != it->second.end() ? std::static_pointer_cast<libsumo::TraCIDouble>(accelerationIt->second)->value : 0.0;
+
+  entry.hasKinematics = true;
+}
+
+void
+TraciClient::ExcludeStation(NodeHandle_t handle)
+{
+  // copy the ID, as the entry is moved when the node is unregistered
+  std::string id = m_nodeEntries[handle].sumoId;
+  bool isPedestrian = m_nodeEntries[handle].stationType == StationType_pedestrian;
+
+  // call exclude function for this node
+  m_excludeNode(m_nodeEntries[handle].node, id);
+
+  // remove the vehicle from the map of the vehicle visualizer
+  if (!isPedestrian && m_vehicle_visualizer!=nullptr && m_vehicle_visualizer->isConnected())
+    {
+      m_vehicle_visualizer->removeObjectFromFrame(id);
+    }
+
+  // unregister in the registry (the exclude function may have changed the registry, so look up the handle again)
+  UnregisterNode(GetNodeHandle(id));
+}
+
+bool
+TraciClient::IsEquippedVehicle(const std::string &id) const
+{
+  if (m_penetrationRate >= 1.0)
+    {
+      return true;
+    }
+
+  // FNV-1a hash of the sumo ID, mixed with the sumo seed, mapped to [0,1)
+  uint64_t hash = 14695981039346656037ULL ^ static_cast<uint64_t>(m_sumoSeed);
+  for (char c : id)
+    {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 1099511628211ULL;
+    }
+
+  return static_cast<double>(hash >> 11) / static_cast<double>(1ULL << 53) < m_penetrationRate;
+}
+
+void
+TraciClient::SynchronisePartitionedVehicles()
+{
+  NS_LOG_FUNCTION(this);
+
+  // the position (and the other kinematic variables) of every equipped vehicle in the whole scenario is subscribed to, so
+  // that sumo sends all the positions in the response to each simulation step (a single round trip, independently of
+  // the number of vehicles)
+  std::vector<std::string> departedVehicles = GetDepartedArrivedIdList(VAR_DEPARTED_VEHICLES_IDS);
+  std::vector<std::string> arrivedVehicles = GetDepartedArrivedIdList(VAR_ARRIVED_VEHICLES_IDS);
+
+  for (const std::string &veh : departedVehicles)
+    {
+      if (IsEquippedVehicle(veh))
+        {
+          m_partitionVehicles.insert(veh);
+          this->TraCIAPI::vehicle.subscribe(veh, vehicleKinematicVars, INVALID_DOUBLE_VALUE, INVALID_DOUBLE_VALUE);
+        }
+    }
+
+  // exclude the arrived vehicles; the departed vehicles are not included here, as their position is received only
+  // after the next simulation step
+  for (const std::string &veh : arrivedVehicles)
+    {
+      m_partitionVehicles.erase(veh);
+
+      NodeHandle_t handle = GetNodeHandle(veh);
+      if (handle != InvalidNodeHandle)
+        {
+          ExcludeStation(handle);
+        }
+    }
+
+  // include the vehicles entering the ghost ring and exclude (i.e., migrate to the neighbouring process) the vehicles
+  // leaving it; the results are sorted by vehicle ID, so the nodes are included/excluded in a deterministic order
+  const libsumo::SubscriptionResults results = this->TraCIAPI::vehicle.getAllSubscriptionResults();
+  for (const auto &result : results)
+    {
+      const std::string &veh = result.first;
+
+      if (m_partitionVehicles.count(veh) == 0)
+        {
+          continue;
+        }
+
+      auto posIt = result.second.find(VAR_POSITION);
+      if (posIt == result.second.end())
+        {
+          continue;
+        }
+
+      std::shared_ptr<libsumo::TraCIPosition> pos = std::dynamic_pointer_cast<libsumo::TraCIPosition>(posIt->second);
+      if (pos == nullptr)
+        {
+          continue;
+        }
+
+      NodeHandle_t handle = GetNodeHandle(veh);
+      if (handle == InvalidNodeHandle)
+        {
+          if (m_partition->ShouldInclude(pos->x, pos->y))
+            {
+              IncludeStation(veh, StationTypeTraci_vehicle);
+            }
+        }
+      else if (m_partition->ShouldExclude(pos->x, pos->y))
+        {
+          ExcludeStation(handle);
+        }
+    }
+}
+
+bool
+TraciClient::IsOwned(Ptr<Node> node) const
+{
+  if (m_partition == nullptr)
+    {
+      return true;
+    }
+
+  Vector pos = node->GetObject<MobilityModel>()->GetPosition();
+
+  return m_partition->IsOwned(pos.x, pos.y);
+}
+
+void
+TraciClient::InitLocalProjection()
+{
+  NS_LOG_FUNCTION(this);
+
+  m_localProjection = TMProjection();
+
+  if (!m_useLocalProjection)
+    {
+      return;
+    }
+
+  // reference points: the center and the corners of the network, and two points 1 km away from the center
+  std::vector<std::pair<double, double>> xy;
+  std::vector<libsumo::TraCIPosition> lonlat;
+  try
+    {
+      libsumo::TraCIPositionVector net_boundaries = this->TraCIAPI::simulation.getNetBoundary();
+      if (net_boundaries.size() < 2)
+        {
+          return;
+        }
+
+      double xMin = net_boundaries[0].x, yMin = net_boundaries[0].y;
+      double xMax = net_boundaries[1].x, yMax = net_boundaries[1].y;
+      double cx = (xMin + xMax) / 2, cy = (yMin + yMax) / 2;
+      xy = {{cx, cy}, {xMin, yMin}, {xMax, yMax}, {xMin, yMax}, {xMax, yMin}, {cx + 1000.0, cy + 1000.0}, {cx - 1000.0, cy - 1000.0}};
+
+      for (const auto &point : xy)
+        {
+          lonlat.push_back(this->TraCIAPI::simulation.convertXYtoLonLat(point.first, point.second));
+        }
+    }
+  catch (std::exception& e)
+    {
+      NS_LOG_WARN("Cannot retrieve the projection of the SUMO network (" << e.what() << "): all the coordinate conversions will be requested to SUMO.");
+      return;
+    }
+
+  const libsumo::TraCIPosition &center = lonlat[0];
+  if (!(std::fabs(center.y) < 84.0 && std::fabs(center.x) <= 180.0))
+    {
+      NS_LOG_WARN("The SUMO network has no geographic coordinates: all the coordinate conversions will be requested to SUMO.");
+      return;
+    }
+
+  // sumo normally uses the UTM zone of the network: try it first, and then the two neighbouring ones
+  int zone = (int) std::floor((center.x + 180.0) / 6.0) + 1;
+  for (int delta : {0, -1, 1})
+    {
+      int candidate = (zone + delta + 59) % 60 + 1;
+      TMProjection projection(TMProjection::UTMCentralMeridian(candidate));
+
+      // the offset includes both the false easting/northing of UTM and the network offset of sumo
+      double x0, y0;
+      projection.LonLatToXY(center.x, center.y, x0, y0);
+      projection.SetOffset(xy[0].first - x0, xy[0].second - y0);
+
+      double maxError = 0.0;
+      for (size_t i = 1; i < xy.size(); i++)
+        {
+          double x, y;
+          projection.LonLatToXY(lonlat[i].x, lonlat[i].y, x, y);
+          maxError = std::max(maxError, std::hypot(x - xy[i].first, y - xy[i].second));
+        }
+
+      if (maxError <= m_localProjectionTolerance)
+        {
+          NS_LOG_INFO("SUMO network projection: UTM zone " << candidate << ", offset (" << projection.GetXOffset() << ","
+                      << projection.GetYOffset() << "), maximum error " << maxError << " m.");
+          m_localProjection = projection;
+          return;
+        }
+    }
+
+  NS_LOG_WARN("The projection of the SUMO network cannot be reproduced locally: all the coordinate conversions will be requested to SUMO.");
+}
+
+libsumo::TraCIPosition
+TraciClient::ConvertXYtoLonLat(double x, double y)
+{
+  if (!m_localProjection.IsValid())
+    {
+      return this->TraCIAPI::simulation.convertXYtoLonLat(x, y);
+    }
+
+  libsumo::TraCIPosition pos;
+  m_localProjection.XYToLonLat(x, y, pos.x, pos.y);
+  pos.z = 0;
+  return pos;
+}
+
+libsumo::TraCIPosition
+TraciClient::ConvertLonLattoXY(double lon, double lat)
+{
+  if (!m_localProjection.IsValid())
+    {
+      return this->TraCIAPI::simulation.convertLonLattoXY(lon, lat);
+    }
+
+  libsumo::TraCIPosition pos;
+  m_localProjection.LonLatToXY(lon, lat, pos.x, pos.y);
+  pos.z = 0;
+  return pos;
+}
+
+void
+TraciClient::ConvertXYtoLonLat(size_t n, const double *x, const double *y, double *lon, double *lat)
+{
+  if (m_localProjection.IsValid())
+    {
+      m_localProjection.XYToLonLat(n, x, y, lon, lat);
+      return;
+    }
+
+  for (size_t i = 0; i < n; i++)
+    {
+      libsumo::TraCIPosition pos = this->TraCIAPI::simulation.convertXYtoLonLat(x[i], y[i]);
+      lon[i] = pos.x;
+      lat[i] = pos.y;
+    }
+}
+
+void
+TraciClient::ConvertLonLattoXY(size_t n, const double *lon, const double *lat, double *x, double *y)
+{
+  if (m_localProjection.IsValid())
+    {
+      m_localProjection.LonLatToXY(n, lon, lat, x, y);
+      return;
+    }
+
+  for (size_t i = 0; i < n; i++)
+    {
+      libsumo::TraCIPosition pos = this->TraCIAPI::simulation.convertLonLattoXY(lon[i], lat[i]);
+      x[i] = pos.x;
+      y[i] = pos.y;
+    }
+}
+
+void
+TraciClient::SubscribeDepartedArrived()
+{
+  NS_LOG_FUNCTION(this);
+
+  try
+    {
+      std::vector<int> vars = {VAR_DEPARTED_VEHICLES_IDS, VAR_ARRIVED_VEHICLES_IDS};
+      this->TraCIAPI::simulation.subscribe("", vars, INVALID_DOUBLE_VALUE, INVALID_DOUBLE_VALUE);
+      m_departedArrivedSubscribed = true;
+    }
+  catch (std::exception& e)
+    {
+      // fall back to polling sumo for the departed/arrived vehicles at every step
+      NS_LOG_WARN("Cannot subscribe to the departed/arrived vehicles lists, polling them instead: " << e.what());
+      m_departedArrivedSubscribed = false;
+    }
+}
+
+std::vector<std::string>
+TraciClient::GetDepartedArrivedIdList(int variable)
+{
+  if (m_departedArrivedSubscribed)
+    {
+      const libsumo::TraCIResults results = this->TraCIAPI::simulation.getSubscriptionResults("");
+      auto it = results.find(variable);
+
+      if (it != results.end())
+        {
+          std::shared_ptr<libsumo::TraCIStringList> idList = std::dynamic_pointer_cast<libsumo::TraCIStringList>(it->second);
+          if (idList != nullptr)
+            {
+              return idList->value;
+            }
+        }
+
+      // no result for this step: sumo did not report any change
+      return std::vector<std::string>();
+    }
+
+  if (variable == VAR_DEPARTED_VEHICLES_IDS)
+    {
+      return this->TraCIAPI::simulation.getDepartedIDList();
+    }
+
+  return this->TraCIAPI::simulation.getArrivedIDList();
+}
+
 uint32_t
 TraciClient::GetVehicleMapSize()
 {
-return m_NodeMap.size();
+return m_nodeEntries.size();
 }
 
 void
@@ -610,6 +1198,7 @@ TraciClient::PortFreeCheck (uint32_t portNum)
     if (bind(socketFd, (struct sockaddr *)&address, sizeof(address))<0)
     {
       // port not available
+      ::close(socketFd);
       return false;
     }
     else
@@ -621,37 +1210,66 @@ TraciClient::PortFreeCheck (uint32_t portNum)
 }
 
 uint32_t
-TraciClient::GetFreePort (uint32_t portNum)
+TraciClient::GetFreePort (uint32_t portNum, int *lockFd)
 {
     uint32_t port = portNum;
-    while (!PortFreeCheck(port))
+
+    while (true)
     {
+      int fd = -1;
+
+      // reserve the port with an exclusive lock on a per-port lock file: another simulation running in parallel may
+      // have already selected the same port, without having started SUMO yet (i.e. the port still looks free)
+      if (lockFd != nullptr)
+        {
+          std::string lockPath = "/tmp/ms-van3t-sumo-port-" + std::to_string(port) + ".lock";
+          fd = open(lockPath.c_str(), O_RDONLY | O_CREAT | O_CLOEXEC, 0666);
+
+          if (fd >= 0 && flock(fd, LOCK_EX | LOCK_NB) != 0)
+            {
+              // port reserved by another process
+              ::close(fd);
+              ++port;
+              continue;
+            }
+        }
+
+      if (PortFreeCheck(port))
+        {
+          if (lockFd != nullptr)
+            {
+              *lockFd = fd;
+            }
+          return port;
+        }
+
+      if (fd >= 0)
+        {
+          ::close(fd);
+        }
       ++port;
     }
-
-return port;
 }
 
 std::vector<std::string>
 TraciClient::getVehicleNodeMapIds()
 {
     std::vector<std::string> ids;
-    for (auto & it : m_NodeMap)
+    ids.reserve(m_nodeEntries.size());
+    for (const NodeEntry_t &entry : m_nodeEntries)
     {
-      ids.push_back(it.first);
+      ids.push_back(entry.sumoId);
     }
     return ids;
 }
 
 void TraciClient::AddStation(std::string id, float x, float y, float z, Ptr<Node> node)
 {
-  // Add RSU to the map
-  std::pair<StationType_t, Ptr<ns3::Node>> inNode;
-  inNode.first = StationType_roadSideUnit;
-  inNode.second = node;
-
-  // register in the map (link vehicle to node!)
-  m_NodeMap.insert(std::pair<std::string, std::pair<StationType_t, Ptr<ns3::Node>>>(id, inNode));
+  // Add RSU to the registry (link station to node!), if not already present
+  if (m_sumoIdToHandle.count(id) == 0)
+    {
+      RegisterNode(id, StationType_roadSideUnit, node);
+    }
 
   // Set the position of the Station
   Ptr<MobilityModel> mob = node->GetObject<MobilityModel>();
@@ -662,19 +1280,14 @@ std::string TraciClient::GetStationId(Ptr<Node> node)
 {
   NS_LOG_FUNCTION (this);
 
-  std::string foundNode ("");
+  NodeHandle_t handle = GetNodeHandle (node);
 
-  // search map for corresponding node
-  for (auto it = m_NodeMap.begin (); it != m_NodeMap.end (); ++it)
+  if (handle == InvalidNodeHandle)
     {
-      if (it->second.second == node)
-        {
-          foundNode = it->first;
-          break;
-        }
+      return std::string ("");
     }
 
-  return foundNode;
+  return m_nodeEntries[handle].sumoId;
 }
 
 } // namespace ns3
\ No newline at end of file
@@ -24,9 +24,12 @@
 #define TRACI_H
 
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <string>
 #include <functional>
+#include <limits>
 
 #include <signal.h>
 #include <stdlib.h>
@@ -37,6 +40,8 @@
 
 #include "sumo-TraCIAPI.h"
 #include "sumo-TraCIDefs.h"
+#include "traci-partition.h"
+#include "tm-projection.h"
 
 #include "ns3/vehicle-visualizer.h"
 
@@ -60,6 +65,31 @@ public:
     StationTypeTraci_unspecified
   } StationTypeTraCI_t;
 
+  // dense integer handle of a node in the node registry; handles are indices into GetNodeEntries() and
+  // remain valid until the next node is removed from the registry (removal moves the last entry into the freed slot)
+  typedef uint32_t NodeHandle_t;
+  static constexpr NodeHandle_t InvalidNodeHandle = std::numeric_limits<NodeHandle_t>::max ();
+
+  // kinematic state of a sumo vehicle/pedestrian, received through a variable subscription together with each
+  // simulation step (distance and acceleration are available only for vehicles)
+  typedef struct StationKinematics {
+    libsumo::TraCIPosition position;
+    double speed = 0.0;         // m/s
+    double angle = 0.0;         // degrees, as returned by TraCIAPI::vehicle.getAngle()
+    double distance = 0.0;      // travelled distance (m)
+    double acceleration = 0.0;  // m/s^2
+  } StationKinematics_t;
+
+  // entry of the node registry, linking a sumo vehicle/pedestrian (or a RSU) to a ns3 node
+  typedef struct NodeEntry {
+    std::string sumoId;         // sumo (or RSU) identifier, e.g. "veh12"
+    StationType_t stationType;
+    Ptr<Node> node;
+    uint64_t stationId;         // numeric station ID, parsed once from sumoId when the entry is inserted
+    StationKinematics_t kinematics; // kinematic state at the current simulation step (valid if hasKinematics is true)
+    bool hasKinematics = false;
+  } NodeEntry_t;
+
   // register this type with the TypeId system.
   static TypeId GetTypeId (void);
 
@@ -72,21 +102,70 @@ public:
 
   void SumoStop();
 
-  // get associated sumo vehicle for ns3 node
+  // get associated sumo vehicle for ns3 node (O(1), empty string if the node is not registered)
   std::string GetVehicleId(Ptr<Node> node);
 
   uint32_t GetVehicleMapSize(); // size of vehicle map
 
   std::vector<std::string> getVehicleNodeMapIds(); // get all vehicle node ids
 
-  std::map< std::string, std::pair< StationType_t, Ptr<Node> > > get_NodeMap() {return m_NodeMap;};
+  // build a copy of the node map as a std::map; kept for backward compatibility only, prefer GetNodeEntries()
+  std::map< std::string, std::pair< StationType_t, Ptr<Node> > > get_NodeMap();
+
+  // contiguous array with all the registered nodes, to be used for iterating over the nodes without copies
+  const std::vector<NodeEntry_t> &GetNodeEntries() const {return m_nodeEntries;};
+
+  // O(1) lookup of a registered node handle, by sumo ID or by ns3 node; InvalidNodeHandle if not registered
+  NodeHandle_t GetNodeHandle(const std::string &id) const;
+  NodeHandle_t GetNodeHandle(Ptr<Node> node) const;
+
+  const NodeEntry_t &GetNodeEntry(NodeHandle_t handle) const {return m_nodeEntries.at(handle);};
+
+  // kinematic state of a registered sumo vehicle/pedestrian at the current simulation step, taken from the variable
+  // subscription results received with the step (i.e., without any request to sumo); nullptr if not available, e.g.
+  // for RSUs and unregistered IDs, and in this case the values must be requested to sumo
+  const StationKinematics_t *GetStationKinematics(const std::string &id) const;
+
+  // get the ns3 node associated to a sumo ID (nullptr if the sumo ID is not registered)
+  Ptr<Node> GetNode(const std::string &id) const;
+
+  // get the numeric station ID of a sumo ID; registered IDs are not parsed again, unregistered IDs
+  // (e.g. untracked vehicles, because of a penetration rate < 1.0) are parsed on the fly
+  uint64_t GetStationNumericId(const std::string &id) const;
+  uint64_t GetStationNumericId(Ptr<Node> node) const;
+
+  // parse the numeric part of a station ID: "vehN"/"pedN" -> N, "<prefix>_N" -> N for RSUs
+  static uint64_t ParseStationId(const std::string &id, StationType_t stationType);
 
   void AddStation(std::string id, float x, float y, float z, Ptr<Node> node);
 
+  // get associated station (vehicle, pedestrian or RSU) ID for ns3 node (O(1))
   std::string GetStationId(Ptr<Node> node);
 
   void SetSionnaUp() {m_sionna = true;};
 
+  // spatial partition of the map (nullptr if the whole scenario is simulated by this process)
+  Ptr<TraciPartition> GetPartition() const {return m_partition;};
+
+  // true if the node is owned by this process, i.e., it is inside the local tile of the partition
+  // (always true when no partition is set; false for ghost nodes, which are owned by a neighbouring process)
+  bool IsOwned(Ptr<Node> node) const;
+
+  // conversion between sumo (x,y) and geographic (lon,lat) coordinates, as TraCIAPI::simulation.convertXYtoLonLat() and
+  // TraCIAPI::simulation.convertLonLattoXY(); when the projection of the sumo network can be reproduced locally (see
+  // GetLocalProjection()), the conversion is computed by ns-3, without any request to sumo
+  libsumo::TraCIPosition ConvertXYtoLonLat(double x, double y);
+  libsumo::TraCIPosition ConvertLonLattoXY(double lon, double lat);
+
+  // batched versions of the conversions above, for n points (the output arrays can be the same as the input ones)
+  void ConvertXYtoLonLat(size_t n, const double *x, const double *y, double *lon, double *lat);
+  void ConvertLonLattoXY(size_t n, const double *lon, const double *lat, double *x, double *y);
+
+  // local projection of the sumo network: a UTM projection, with the offset of the network, which reproduces the
+  // conversions of sumo within LocalProjectionTolerance meters; invalid if the network uses any other projection
+  // (or if the LocalProjection attribute is false), and in this case all the conversions are requested to sumo
+  const TMProjection &GetLocalProjection() const {return m_localProjection;};
+
 
 private:
   // perform sumo simulation for a certain time step
@@ -101,11 +180,58 @@ private:
   // synchronise ns3 nodes with sumo vehicles
   void SynchroniseNodeMap(void);
 
+  // partitioned mode: include/exclude the vehicles depending on their position with respect to the local tile
+  void SynchronisePartitionedVehicles(void);
+
+  // partitioned mode: equipped vehicles are selected with a hash of the sumo ID (instead of a random variable),
+  // so that all the processes take the same decision for the same vehicle
+  bool IsEquippedVehicle(const std::string &id) const;
+
+  // include a new ns3 node for a sumo object / exclude the ns3 node of a registered sumo object
+  void IncludeStation(const std::string &id, StationTypeTraCI_t stationType);
+  void ExcludeStation(NodeHandle_t handle);
+
+  // subscribe to the departed/arrived vehicles lists, so that they are sent by sumo after every simulation step
+  void SubscribeDepartedArrived(void);
+
+  // subscribe to the kinematic variables of a sumo vehicle/pedestrian, so that they are sent by sumo after every simulation step
+  void SubscribeKinematics(const std::string &id, StationTypeTraCI_t stationType);
+
+  // copy the kinematic state of a registry entry from the subscription results of the current step
+  void ReadKinematics(NodeEntry_t &entry, const libsumo::SubscriptionResults &vehicleResults,
+                      const libsumo::SubscriptionResults &personResults);
+
+  // get a departed/arrived vehicles list, from the subscription results if available, otherwise by polling sumo
+  std::vector<std::string> GetDepartedArrivedIdList(int variable);
+
+  // retrieve the projection of the sumo network, by comparing a few conversions performed by sumo with a local UTM projection
+  void InitLocalProjection(void);
+
   // build command line string for sumo start up
   std::string GetSumoCmdString (void);
 
-  // map every sumo vehicle/pedestrian to a ns3 node
-  std::map< std::string, std::pair< StationType_t, Ptr<Node> > > m_NodeMap;
+  // insert a new node in the registry and return its handle
+  NodeHandle_t RegisterNode(const std::string &id, StationType_t stationType, Ptr<Node> node);
+
+  // remove a node from the registry (swap-and-pop: the last entry takes the handle of the removed one)
+  void UnregisterNode(NodeHandle_t handle);
+
+  // node registry: every sumo vehicle/pedestrian (and every RSU) is mapped to a ns3 node
+  // the entries are stored in a contiguous array and indexed in both directions by hash maps
+  std::vector<NodeEntry_t> m_nodeEntries;
+  std::unordered_map<std::string, NodeHandle_t> m_sumoIdToHandle;
+  std::unordered_map<uint32_t, NodeHandle_t> m_nodeIdToHandle; // key: ns3 node ID (Node::GetId())
+
+  // sumo IDs of the pedestrians currently registered in the node registry
+  std::unordered_set<std::string> m_pedestrianIds;
+
+  // true if the departed/arrived vehicles lists are received through a simulation variable subscription
+  bool m_departedArrivedSubscribed = false;
+
+  // partitioned mode: equipped vehicles currently in the sumo simulation, whose position is subscribed to
+  // (only the ones inside the local tile or ghost ring are registered in the node registry)
+  Ptr<TraciPartition> m_partition;
+  std::unordered_set<std::string> m_partitionVehicles;
 
   // a vehicle is untracked if it is simulated in sumo but not linked to a ns3 node because of an penetration rate < 1.0
   std::vector<std::string> m_untrackedVehicles;
@@ -115,8 +241,10 @@ private:
   SHUTDOWN_FCN m_excludeNode;
 
   // port handling functionality for multiple parallel simulations
+  // if lockFd is not null, the returned port is also reserved across processes with a lock file, which is kept
+  // until the file descriptor stored in *lockFd is closed (this avoids port collisions between parallel runs)
   static bool PortFreeCheck (uint32_t portNum);
-  static uint32_t GetFreePort (uint32_t portNum=10000);
+  static uint32_t GetFreePort (uint32_t portNum=10000, int *lockFd=nullptr);
 
   // simulation specific data members
   std::string m_sumoAddCmdOpt;
@@ -124,6 +252,7 @@ private:
   std::string m_sumoConfigPath;
   std::string m_sumoBinaryPath;
   uint16_t m_sumoPort;
+  int m_sumoPortLockFd = -1;
   bool m_sumoGUI;
 
   double m_penetrationRate;
@@ -145,6 +274,10 @@ private:
 
   bool m_sionna = false;
 
+  bool m_useLocalProjection;
+  double m_localProjectionTolerance;
+  TMProjection m_localProjection;
+
 };
 
 } // end namespace ns3
@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "traci-partition.h"
+
+namespace ns3
+{
+  NS_LOG_COMPONENT_DEFINE("TraciPartition");
+
+  NS_OBJECT_ENSURE_REGISTERED(TraciPartition);
+
+  TypeId
+  TraciPartition::GetTypeId(void)
+  {
+    static TypeId tid =
+        TypeId("ns3::TraciPartition").SetParent<Object>()
+    .SetGroupName ("TraciClient")
+    .AddConstructor<TraciPartition> ()
+    .AddAttribute ("NumTilesX",
+                  "Number of tiles along the x axis of the SUMO network.",
+                  UintegerValue (1),
+                  MakeUintegerAccessor (&TraciPartition::m_numTilesX),
+                  MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("NumTilesY",
+                  "Number of tiles along the y axis of the SUMO network.",
+                  UintegerValue (1),
+                  MakeUintegerAccessor (&TraciPartition::m_numTilesY),
+                  MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("Tile",
+                  "Index (row-major) of the tile simulated by this process, usually equal to the MPI rank.",
+                  UintegerValue (0),
+                  MakeUintegerAccessor (&TraciPartition::m_tile),
+                  MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("GhostMargin",
+                  "Width [m] of the ghost ring simulated around the local tile.",
+                  DoubleValue (1000.0),
+                  MakeDoubleAccessor (&TraciPartition::m_ghostMargin),
+                  MakeDoubleChecker<double> (0.0))
+    .AddAttribute ("MigrationHysteresis",
+                  "Additional distance [m] outside the ghost ring after which a node is excluded.",
+                  DoubleValue (20.0),
+                  MakeDoubleAccessor (&TraciPartition::m_hysteresis),
+                  MakeDoubleChecker<double> (0.0));
+    return tid;
+  }
+
+  TraciPartition::TraciPartition()
+  {
+    NS_LOG_FUNCTION(this);
+
+    m_numTilesX = 1;
+    m_numTilesY = 1;
+    m_tile = 0;
+    m_ghostMargin = 1000.0;
+    m_hysteresis = 20.0;
+  }
+
+  TraciPartition::~TraciPartition()
+  {
+    NS_LOG_FUNCTION(this);
+  }
+
+  void
+  TraciPartition::SetBoundary(double xMin, double yMin, double xMax, double yMax)
+  {
+    NS_LOG_FUNCTION(this << xMin << yMin << xMax << yMax);
+
+    if (xMax <= xMin || yMax <= yMin)
+      {
+        NS_FATAL_ERROR("Error: invalid network boundary for the TraCI partition.");
+      }
+
+    if (m_tile >= GetNumTiles())
+      {
+        NS_FATAL_ERROR("Error: tile " << m_tile << " does not exist in a " << m_numTilesX << "x" << m_numTilesY << " partition.");
+      }
+
+    m_xMin = xMin;
+    m_yMin = yMin;
+    m_xMax = xMax;
+    m_yMax = yMax;
+    m_boundarySet = true;
+
+    UpdateTileBounds();
+  }
+
+  void
+  TraciPartition::UpdateTileBounds(void)
+  {
+    double tileWidth = (m_xMax - m_xMin) / m_numTilesX;
+    double tileHeight = (m_yMax - m_yMin) / m_numTilesY;
+    uint32_t col = m_tile % m_numTilesX;
+    uint32_t row = m_tile / m_numTilesX;
+
+    // the tiles on the borders of the grid are unbounded towards the outside of the network, so that every
+    // position (including the ones slightly outside the network boundary) is owned by exactly one tile
+    m_tileXMin = col == 0 ? -std::numeric_limits<double>::infinity() : m_xMin + col * tileWidth;
+    m_tileXMax = col == m_numTilesX - 1 ? std::numeric_limits<double>::infinity() : m_xMin + (col + 1) * tileWidth;
+    m_tileYMin = row == 0 ? -std::numeric_limits<double>::infinity() : m_yMin + row * tileHeight;
+    m_tileYMax = row == m_numTilesY - 1 ? std::numeric_limits<double>::infinity() : m_yMin + (row + 1) * tileHeight;
+
+    NS_LOG_INFO("Tile " << m_tile << ": x in [" << m_tileXMin << "," << m_tileXMax << "), y in ["
+                << m_tileYMin << "," << m_tileYMax << "), ghost margin " << m_ghostMargin << " m");
+  }
+
+  uint32_t
+  TraciPartition::GetTileIndex(double x, double y) const
+  {
+    NS_ASSERT_MSG(m_boundarySet, "The network boundary of the TraCI partition has not been set");
+
+    double tileWidth = (m_xMax - m_xMin) / m_numTilesX;
+    double tileHeight = (m_yMax - m_yMin) / m_numTilesY;
+
+    int64_t col = static_cast<int64_t>(std::floor((x - m_xMin) / tileWidth));
+    int64_t row = static_cast<int64_t>(std::floor((y - m_yMin) / tileHeight));
+
+    col = std::min<int64_t>(std::max<int64_t>(col, 0), m_numTilesX - 1);
+    row = std::min<int64_t>(std::max<int64_t>(row, 0), m_numTilesY - 1);
+
+    return static_cast<uint32_t>(row * m_numTilesX + col);
+  }
+
+  bool
+  TraciPartition::IsOwned(double x, double y) const
+  {
+    return !IsParked(x, y) && GetTileIndex(x, y) == m_tile;
+  }
+
+  Vector
+  TraciPartition::GetParkingPosition(void) const
+  {
+    NS_ASSERT_MSG(m_boundarySet, "The network boundary of the TraCI partition has not been set");
+
+    return Vector(m_xMin - PARKING_DISTANCE, m_yMin - PARKING_DISTANCE, 0.0);
+  }
+
+  bool
+  TraciPartition::IsParked(double x, double y) const
+  {
+    NS_ASSERT_MSG(m_boundarySet, "The network boundary of the TraCI partition has not been set");
+
+    // distance from the network bounding box (0 inside the network)
+    double dx = std::max({m_xMin - x, 0.0, x - m_xMax});
+    double dy = std::max({m_yMin - y, 0.0, y - m_yMax});
+
+    return std::max(dx, dy) > PARKING_DISTANCE / 2;
+  }
+
+  bool
+  TraciPartition::IsInRegion(double x, double y, double extra) const
+  {
+    NS_ASSERT_MSG(m_boundarySet, "The network boundary of the TraCI partition has not been set");
+
+    if (IsParked(x, y))
+      {
+        return false;
+      }
+
+    // distance from the local tile (0 inside the tile)
+    double dx = std::max({m_tileXMin - x, 0.0, x - m_tileXMax});
+    double dy = std::max({m_tileYMin - y, 0.0, y - m_tileYMax});
+    double margin = m_ghostMargin + extra;
+
+    return dx * dx + dy * dy <= margin * margin;
+  }
+
+  double
+  TraciPartition::ComputeGhostMargin(double baseline_m, double interferenceRange_m, double maxSpeed_mps, Time synchInterval)
+  {
+    return baseline_m + interferenceRange_m + maxSpeed_mps * synchInterval.GetSeconds();
+  }
+}
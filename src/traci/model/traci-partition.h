@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TRACI_PARTITION_H
+#define TRACI_PARTITION_H
+
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup traci
+ *
+ * \brief Spatial partition of a SUMO map, used to split a large scenario over several ns-3 processes (e.g. MPI ranks).
+ *
+ * The bounding box of the SUMO network is divided into a grid of NumTilesX x NumTilesY rectangular tiles, and each
+ * process is assigned a single tile (the tile with index "Tile", in row-major order).
+ * When a TraciClient is given a partition, it only creates ns-3 nodes for the SUMO objects which are located inside
+ * the local tile extended by a ghost margin:
+ * - the nodes inside the local tile are "owned" by the process: their transmissions and receptions are the ones
+ *   counted in the metrics of the process;
+ * - the nodes inside the ghost ring around the tile are "ghost" nodes: they are fully simulated, so that the
+ *   owned nodes near the tile borders see the same channel (receptions, interference, congestion) they would see
+ *   in the full scenario, but they are owned (and measured) by the process of the neighbouring tile.
+ * Nodes migrate between processes as the vehicles cross the tile borders: a vehicle becomes a ghost node when it
+ * enters the ghost ring, it becomes owned when it enters the tile, and it is excluded when it leaves the ghost ring
+ * (plus a small hysteresis, to avoid excluding and including the same vehicle at every step).
+ *
+ * As every process simulates its own ghost ring, no event is ever exchanged between processes during the simulation
+ * and each process can advance without any synchronization; the ghost margin should be large enough to include
+ * all the transmitters which can affect an owned transmission (see ComputeGhostMargin()). The processes are thus
+ * independent simulations of overlapping regions, whose metrics can be summed up at the end of the run.
+ *
+ * The nodes of the excluded vehicles should be moved to GetParkingPosition(), which is far away from the network
+ * and is never owned by (nor included in the region of) any tile.
+ */
+class TraciPartition : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  TraciPartition ();
+  virtual ~TraciPartition ();
+
+  /**
+   * \brief Set the bounding box of the whole SUMO network, which is split into tiles.
+   *
+   * This function is called by the TraciClient, with the network boundary retrieved from SUMO.
+   */
+  void SetBoundary (double xMin, double yMin, double xMax, double yMax);
+
+  /**
+   * \brief Get the index (row-major) of the tile containing the given SUMO (x,y) position.
+   *
+   * Positions outside the network boundary are assigned to the closest tile.
+   */
+  uint32_t GetTileIndex (double x, double y) const;
+
+  /**
+   * \brief Check if a SUMO (x,y) position is inside the local tile, i.e., if a node in that position is owned.
+   *
+   * Parked positions (see IsParked()) are never owned.
+   */
+  bool IsOwned (double x, double y) const;
+
+  /**
+   * \brief Check if a SUMO (x,y) position is inside the local tile extended by the ghost margin plus "extra" meters.
+   */
+  bool IsInRegion (double x, double y, double extra = 0.0) const;
+
+  /**
+   * \brief Get a position, outside every tile and ghost ring, where the nodes of the excluded vehicles can be parked.
+   */
+  Vector GetParkingPosition (void) const;
+
+  /**
+   * \brief Check if a position is in the parking area, i.e., more than PARKING_DISTANCE/2 meters outside the network.
+   *
+   * The border tiles are unbounded, so that the vehicles slightly outside the network boundary are still owned by
+   * the closest tile; the parking area is the only region which does not belong to any tile.
+   */
+  bool IsParked (double x, double y) const;
+
+  /**
+   * \brief Check if a node should be included in the local process (inside the tile or the ghost ring).
+   */
+  bool ShouldInclude (double x, double y) const {return IsInRegion (x, y);}
+
+  /**
+   * \brief Check if an already included node should be excluded, as it left the ghost ring (plus the hysteresis).
+   */
+  bool ShouldExclude (double x, double y) const {return !IsInRegion (x, y, m_hysteresis);}
+
+  /**
+   * \brief Compute the minimum ghost margin which keeps the owned transmissions exact.
+   *
+   * All the receivers within the PRR baseline of an owned transmitter must be simulated, together with all the
+   * transmitters which can interfere with them; in addition, as the partition is updated once per synch interval,
+   * a vehicle can move up to maxSpeed*synchInterval before being included.
+   *
+   * @param baseline_m         PRR baseline (maximum distance of the receivers considered in the metrics) [m]
+   * @param interferenceRange_m maximum distance at which a transmission can still be sensed by a receiver [m]
+   * @param maxSpeed_mps       maximum speed of the vehicles in the scenario [m/s]
+   * @param synchInterval      synch interval between ns-3 and SUMO
+   */
+  static double ComputeGhostMargin (double baseline_m, double interferenceRange_m, double maxSpeed_mps, Time synchInterval);
+
+  uint32_t GetNumTiles (void) const {return m_numTilesX * m_numTilesY;}
+  uint32_t GetTile (void) const {return m_tile;}
+  double GetGhostMargin (void) const {return m_ghostMargin;}
+
+  // distance [m] of the parking position from the network boundary, along each axis
+  static constexpr double PARKING_DISTANCE = 100000.0;
+
+private:
+  void UpdateTileBounds (void);
+
+  uint32_t m_numTilesX;
+  uint32_t m_numTilesY;
+  uint32_t m_tile;
+  double m_ghostMargin;
+  double m_hysteresis;
+
+  // bounding box of the whole network
+  double m_xMin = 0.0;
+  double m_yMin = 0.0;
+  double m_xMax = 0.0;
+  double m_yMax = 0.0;
+  bool m_boundarySet = false;
+
+  // bounding box of the local tile
+  double m_tileXMin = 0.0;
+  double m_tileYMin = 0.0;
+  double m_tileXMax = 0.0;
+  double m_tileYMax = 0.0;
+};
+
+} // namespace ns3
+
+#endif /* TRACI_PARTITION_H */
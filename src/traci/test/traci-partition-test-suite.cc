@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+
+#include "ns3/traci-partition.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+static Ptr<TraciPartition>
+CreatePartition (uint32_t tilesX, uint32_t tilesY, uint32_t tile)
+{
+  Ptr<TraciPartition> partition = CreateObject<TraciPartition> ();
+  partition->SetAttribute ("NumTilesX", UintegerValue (tilesX));
+  partition->SetAttribute ("NumTilesY", UintegerValue (tilesY));
+  partition->SetAttribute ("Tile", UintegerValue (tile));
+  partition->SetAttribute ("GhostMargin", DoubleValue (100.0));
+  partition->SetAttribute ("MigrationHysteresis", DoubleValue (20.0));
+  partition->SetBoundary (0.0, 0.0, 2000.0, 1000.0);
+
+  return partition;
+}
+
+// Every position of the map (and slightly outside it) must be owned by exactly one tile
+class TraciPartitionOwnershipTestCase : public TestCase
+{
+public:
+  TraciPartitionOwnershipTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TraciPartitionOwnershipTestCase::TraciPartitionOwnershipTestCase ()
+  : TestCase ("Each position is owned by exactly one tile")
+{
+}
+
+void
+TraciPartitionOwnershipTestCase::DoRun (void)
+{
+  std::vector<Ptr<TraciPartition>> tiles;
+  for (uint32_t tile = 0; tile < 4; tile++)
+    {
+      tiles.push_back (CreatePartition (2, 2, tile));
+    }
+
+  for (double x = -500.0; x <= 2500.0; x += 50.0)
+    {
+      for (double y = -500.0; y <= 1500.0; y += 50.0)
+        {
+          uint32_t owners = 0;
+          for (uint32_t tile = 0; tile < 4; tile++)
+            {
+              if (tiles[tile]->IsOwned (x, y))
+                {
+                  owners++;
+                  NS_TEST_ASSERT_MSG_EQ (tiles[tile]->IsInRegion (x, y), true, "An owned position must be inside the region of its tile");
+                  NS_TEST_ASSERT_MSG_EQ (tiles[tile]->GetTileIndex (x, y), tile, "The owner must match the tile index");
+                }
+            }
+          NS_TEST_ASSERT_MSG_EQ (owners, 1u, "Position (" << x << "," << y << ") is not owned by exactly one tile");
+        }
+    }
+
+  // ghost ring: a position 50 m beyond the border of tile 0 is included, but not owned, by tile 0
+  NS_TEST_ASSERT_MSG_EQ (tiles[0]->IsInRegion (1050.0, 200.0), true, "The ghost ring must be included");
+  NS_TEST_ASSERT_MSG_EQ (tiles[0]->IsOwned (1050.0, 200.0), false, "The ghost ring must not be owned");
+  NS_TEST_ASSERT_MSG_EQ (tiles[0]->ShouldExclude (1110.0, 200.0), false, "The hysteresis must delay the exclusion");
+  NS_TEST_ASSERT_MSG_EQ (tiles[0]->ShouldExclude (1130.0, 200.0), true, "A node beyond the hysteresis must be excluded");
+}
+
+// The parking position of the excluded nodes must not belong to any tile
+class TraciPartitionParkingTestCase : public TestCase
+{
+public:
+  TraciPartitionParkingTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TraciPartitionParkingTestCase::TraciPartitionParkingTestCase ()
+  : TestCase ("The parking position is outside every tile")
+{
+}
+
+void
+TraciPartitionParkingTestCase::DoRun (void)
+{
+  for (uint32_t tile = 0; tile < 4; tile++)
+    {
+      Ptr<TraciPartition> partition = CreatePartition (2, 2, tile);
+      Vector parking = partition->GetParkingPosition ();
+
+      NS_TEST_ASSERT_MSG_EQ (partition->IsParked (parking.x, parking.y), true, "The parking position must be parked");
+      NS_TEST_ASSERT_MSG_EQ (partition->IsOwned (parking.x, parking.y), false, "Tile " << tile << " must not own the parking position");
+      NS_TEST_ASSERT_MSG_EQ (partition->IsInRegion (parking.x, parking.y), false, "Tile " << tile << " must not include the parking position");
+      NS_TEST_ASSERT_MSG_EQ (partition->ShouldExclude (parking.x, parking.y), true, "A parked node must be excluded by tile " << tile);
+
+      // the old hard-coded parking position of the examples is inside the region of the border tiles
+      NS_TEST_ASSERT_MSG_EQ (partition->IsParked (-1000.0, 320.0), false, "A position close to the map must not be parked");
+    }
+}
+
+class TraciPartitionTestSuite : public TestSuite
+{
+public:
+  TraciPartitionTestSuite ();
+};
+
+TraciPartitionTestSuite::TraciPartitionTestSuite ()
+  : TestSuite ("traci-partition", UNIT)
+{
+  AddTestCase (new TraciPartitionOwnershipTestCase, TestCase::QUICK);
+  AddTestCase (new TraciPartitionParkingTestCase, TestCase::QUICK);
+}
+
+static TraciPartitionTestSuite traciPartitionTestSuite;
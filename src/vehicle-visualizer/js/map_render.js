@@ -99,6 +99,33 @@ socket.on('message', (msg) => {
 	}
 });
 
+// Receive the coalesced object updates ("frame" messages) from the server
+// Each frame contains the latest state of all the objects changed since the previous one:
+// {updates: [[<unique object ID>, <lat>, <lon>, <heading>], ...], removed: [<unique object ID>, ...]}
+socket.on('frame', (frame) => {
+	if (map_rx === false || frame == null) {
+		return;
+	}
+
+	for (const upd of frame.updates) {
+		update_marker(leafletmap,upd[0],upd[1],upd[2],upd[3]);
+	}
+
+	for (const id of frame.removed) {
+		remove_marker(leafletmap,id);
+	}
+});
+
+// This function is used to remove a marker/moving object from the map
+function remove_marker(mapref,id)
+{
+	if(mapref != null && (id in markers)) {
+		mapref.removeLayer(markers[id]);
+		delete markers[id];
+		delete markersicons[id];
+	}
+}
+
 // This function is used to update the position (and heading/rotation) of a marker/moving object on the map
 function update_marker(mapref,id,lat,lon,heading)
 {
@@ -29,13 +29,24 @@ fs.readFile(filepath, 'utf8', function (err,data) {
 // Read the server port as a command line option
 var server_argv = process.argv.slice(2);
 
-if(server_argv.length!=1) {
-    console.error("VehicleVisualizer: Error. One argument is expected and " + server_argv.length.toString() + " were specified.");
+if(server_argv.length!=1 && server_argv.length!=2) {
+    console.error("VehicleVisualizer: Error. One or two arguments are expected and " + server_argv.length.toString() + " were specified.");
     process.exit(1);
 } else {
     console.log("VehicleVisualizer: HTTP server listening on port: " + server_argv[0]);
 }
 
+// Maximum rate (in updates per second) at which the coalesced object updates are pushed to the clients
+// It can be specified as second (optional) command line option; a value of 0 means "as soon as a frame is received"
+var push_rate = 10;
+if(server_argv.length==2) {
+    push_rate = parseFloat(server_argv[1]);
+    if(isNaN(push_rate) || push_rate < 0) {
+        console.error("VehicleVisualizer: Error. Invalid push rate specified: " + server_argv[1]);
+        process.exit(1);
+    }
+}
+
 // Create a new HTTP server with express.static
 const express = require('express');
 const app = express();
@@ -46,7 +57,8 @@ const http = require('http').Server(app);
 // Create a UDP socket to receive the data from ms-van3t
 // As port, 48110 is used
 const dgram = require('dgram');
-const udpSocket = dgram.createSocket('udp4');
+// A large receive buffer is used, as a single frame may be split into several back-to-back datagrams
+const udpSocket = dgram.createSocket({type: 'udp4', recvBufferSize: 4*1024*1024});
 
 // Bind the socket to the loopback address/interface
 udpSocket.bind({
@@ -69,11 +81,216 @@ udpSocket.on('listening', () => {
 // This message should indeed be received by the client before attempting to render any other moving object
 var mapmsg = null;
 
+// Binary frame protocol constants (see vehicle-visualizer.h)
+const VIS_FRAME_MAGIC_0 = 0x56; // 'V'
+const VIS_FRAME_MAGIC_1 = 0x46; // 'F'
+const VIS_FRAME_VERSION = 2;
+const VIS_FRAME_HEADER_SIZE = 12;
+const VIS_FRAME_FLAG_LAST_CHUNK = 0x01;
+const VIS_FRAME_FLAG_KEYFRAME = 0x02;
+const VIS_FRAME_RECORD_NEW = 0x01;
+const VIS_FRAME_RECORD_FULL = 0x02;
+const VIS_FRAME_RECORD_DELTA = 0x03;
+const VIS_FRAME_RECORD_REMOVE = 0x04;
+
+// Server-side object table: every update received from ms-van3t (binary frames or legacy "object" messages) is coalesced
+// here, and only the latest state of the objects changed since the last push is sent to the clients
+// objects: object ID -> [lat, lon, heading]
+var objects = new Map();
+// frame_index: object index (binary frames) -> {id, lat_e7, lon_e7}
+var frame_index = new Map();
+var dirty_objects = new Set();
+var removed_objects = new Set();
+
+// Frame sequence tracking: the frames are sent over UDP, so some of them may be lost. A lost frame is detected from the
+// sequence numbers (or from the chunk indexes), and the object table is brought back in sync by the next key frame
+var last_frame_seq = null;
+var next_chunk_idx = 0;
+var lost_frames = 0;
+// Object indexes received in the key frame currently being decoded (null if no key frame is being decoded, or if one of
+// its chunks was lost)
+var keyframe_indexes = null;
+
+function set_object(id, lat, lon, heading) {
+    let obj = objects.get(id);
+    // Key frames repeat the state of all the objects: only the actual changes are pushed to the clients
+    if(obj !== undefined && obj[0] === lat && obj[1] === lon && obj[2] === heading && !removed_objects.has(id)) {
+        return;
+    }
+    objects.set(id, [lat, lon, heading]);
+    dirty_objects.add(id);
+    removed_objects.delete(id);
+}
+
+function remove_object(id) {
+    objects.delete(id);
+    dirty_objects.delete(id);
+    removed_objects.add(id);
+}
+
+// Decode a binary frame (or a chunk of a frame) and update the object table
+function decode_frame(buf) {
+    if(buf.length < VIS_FRAME_HEADER_SIZE || buf[2] !== VIS_FRAME_VERSION) {
+        console.error("VehicleVisualizer: Error: received a corrupted or unsupported frame from ms-van3t.");
+        return;
+    }
+
+    let flags = buf[3];
+    let seq = buf.readUInt32LE(4);
+    let chunk_idx = buf.readUInt16LE(8);
+    let nrecords = buf.readUInt16LE(10);
+    let offset = VIS_FRAME_HEADER_SIZE;
+
+    if(chunk_idx === 0) {
+        // First chunk of a new frame
+        if(last_frame_seq !== null && seq !== ((last_frame_seq + 1) >>> 0)) {
+            lost_frames += (seq - last_frame_seq - 1) >>> 0;
+            console.warn("VehicleVisualizer: Warning: lost " + lost_frames.toString() + " frame(s) so far; the map will be resynchronized by the next key frame.");
+        }
+        last_frame_seq = seq;
+        next_chunk_idx = 0;
+        keyframe_indexes = (flags & VIS_FRAME_FLAG_KEYFRAME) ? new Set() : null;
+    }
+
+    if(seq !== last_frame_seq || chunk_idx !== next_chunk_idx) {
+        // A chunk of this frame was lost: its records are applied anyway, but a partial key frame cannot be used to
+        // remove the stale objects
+        console.warn("VehicleVisualizer: Warning: lost a chunk of frame " + seq.toString() + "; the map will be resynchronized by the next key frame.");
+        keyframe_indexes = null;
+        last_frame_seq = seq;
+    }
+    next_chunk_idx = chunk_idx + 1;
+
+    try {
+        for(let i = 0; i < nrecords; i++) {
+            let type = buf.readUInt8(offset);
+            let idx = buf.readUInt32LE(offset + 1);
+            offset += 5;
+
+            switch(type) {
+                case VIS_FRAME_RECORD_NEW: {
+                    let idlen = buf.readUInt8(offset);
+                    let id = buf.toString('utf8', offset + 1, offset + 1 + idlen);
+                    offset += 1 + idlen;
+                    let entry = {id: id, lat_e7: buf.readInt32LE(offset), lon_e7: buf.readInt32LE(offset + 4)};
+                    let heading = buf.readUInt16LE(offset + 8) / 10;
+                    offset += 10;
+                    let old_entry = frame_index.get(idx);
+                    if(old_entry !== undefined && old_entry.id !== entry.id) {
+                        remove_object(old_entry.id);
+                    }
+                    frame_index.set(idx, entry);
+                    set_object(entry.id, entry.lat_e7 / 1e7, entry.lon_e7 / 1e7, heading);
+                    if(keyframe_indexes !== null) {
+                        keyframe_indexes.add(idx);
+                    }
+                    break;
+                }
+                case VIS_FRAME_RECORD_FULL:
+                case VIS_FRAME_RECORD_DELTA: {
+                    let entry = frame_index.get(idx);
+                    let heading;
+                    if(type === VIS_FRAME_RECORD_FULL) {
+                        if(entry !== undefined) {
+                            entry.lat_e7 = buf.readInt32LE(offset);
+                            entry.lon_e7 = buf.readInt32LE(offset + 4);
+                        }
+                        heading = buf.readUInt16LE(offset + 8) / 10;
+                        offset += 10;
+                    } else {
+                        if(entry !== undefined) {
+                            entry.lat_e7 += buf.readInt16LE(offset);
+                            entry.lon_e7 += buf.readInt16LE(offset + 2);
+                        }
+                        heading = buf.readUInt16LE(offset + 4) / 10;
+                        offset += 6;
+                    }
+                    if(entry === undefined) {
+                        console.warn("VehicleVisualizer: Warning: received an update for an unknown object index: " + idx.toString());
+                    } else {
+                        set_object(entry.id, entry.lat_e7 / 1e7, entry.lon_e7 / 1e7, heading);
+                    }
+                    break;
+                }
+                case VIS_FRAME_RECORD_REMOVE: {
+                    let entry = frame_index.get(idx);
+                    if(entry !== undefined) {
+                        remove_object(entry.id);
+                        frame_index.delete(idx);
+                    }
+                    break;
+                }
+                default:
+                    console.error("VehicleVisualizer: Error: unknown record type in frame: " + type.toString());
+                    return;
+            }
+        }
+    } catch(err) {
+        // A RangeError is thrown when a record is truncated
+        console.error("VehicleVisualizer: Error: received a truncated frame from ms-van3t.");
+        keyframe_indexes = null;
+        return;
+    }
+
+    // Complete key frame: any object which is not part of it was removed in a lost frame
+    if((flags & VIS_FRAME_FLAG_LAST_CHUNK) && keyframe_indexes !== null) {
+        for(const [idx, entry] of frame_index) {
+            if(!keyframe_indexes.has(idx)) {
+                remove_object(entry.id);
+                frame_index.delete(idx);
+            }
+        }
+        keyframe_indexes = null;
+    }
+}
+
+// Push all the changes accumulated since the last push to the clients, with a single socket.io message
+function push_updates() {
+    if(dirty_objects.size === 0 && removed_objects.size === 0) {
+        return;
+    }
+
+    let updates = [];
+    for(const id of dirty_objects) {
+        let obj = objects.get(id);
+        updates.push([id, obj[0], obj[1], obj[2]]);
+    }
+
+    io.sockets.emit('frame', {updates: updates, removed: Array.from(removed_objects)});
+
+    dirty_objects.clear();
+    removed_objects.clear();
+}
+
+var push_timer = null;
+
+function set_push_rate(rate) {
+    push_rate = rate;
+    if(push_timer !== null) {
+        clearInterval(push_timer);
+        push_timer = null;
+    }
+    if(push_rate > 0) {
+        push_timer = setInterval(push_updates, 1000 / push_rate);
+    }
+}
+
+set_push_rate(push_rate);
+
 // This callback is the most important one, as it is called every time a new UDP packet is received from ms-van3t
 // As a new packet is received, its content is forwarded to the client (i.e. the browser) via socket.io
 udpSocket.on('message', (msg,rinfo) => {
     // console.log('I have received from %s:%s the message: %s',rinfo.address,rinfo.port,msg);
 
+    // Binary frame
+    if(msg.length >= 2 && msg[0] === VIS_FRAME_MAGIC_0 && msg[1] === VIS_FRAME_MAGIC_1) {
+        decode_frame(msg);
+        if(push_rate === 0) {
+            push_updates();
+        }
+        return;
+    }
+
     let msg_fields = msg.toString().split(",");
 
     // If a "map" initial message is received, and the content appears to be correct, save it inside "mapmsg"
@@ -93,6 +310,25 @@ udpSocket.on('message', (msg,rinfo) => {
         // This message is sent to terminate the Node.js server
         console.log("VehicleVisualizer: The server received a terminate message. The execution will be terminated.");
         process.exit(0);
+    } else if(msg_fields[0] === "rate") {
+        // New maximum frame rate set in ms-van3t after the server was started: "rate,<frames per second>\0"
+        let rate = parseFloat(msg_fields[1]);
+        if(msg_fields.length === 2 && !isNaN(rate) && rate >= 0) {
+            console.log("VehicleVisualizer: Update push rate set to " + rate.toString() + " updates per second.");
+            set_push_rate(rate);
+        } else {
+            console.error("VehicleVisualizer: Error: received a corrupted rate message from ms-van3t.");
+        }
+    } else if(msg_fields[0] === "object") {
+        // Legacy (text) object update message: "object,<unique object ID>,<lat>,<lon>,<heading>\0"
+        if(msg_fields.length === 5) {
+            set_object(msg_fields[1], parseFloat(msg_fields[2]), parseFloat(msg_fields[3]), parseFloat(msg_fields[4]));
+            if(push_rate === 0) {
+                push_updates();
+            }
+        } else {
+            console.error("VehicleVisualizer: Error: received a corrupted object update message from ms-van3t.");
+        }
     } else {
     // Otherwise, forward all the other messages to the client via socket.io
         io.sockets.send(msg.toString());
@@ -109,6 +345,15 @@ io.on('connection', (socket) => {
     // As soon as a client connects, send the "map" message, in order to make it correctly render the base map
     io.sockets.send(mapmsg);
 
+    // Then, send to the new client a snapshot with the current state of all the objects
+    if(mapmsg != null && objects.size > 0) {
+        let updates = [];
+        for(const [id, obj] of objects) {
+            updates.push([id, obj[0], obj[1], obj[2]]);
+        }
+        socket.emit('frame', {updates: updates, removed: []});
+    }
+
     // socket.io message callback (called every time a client sends something to the server - it should
     // never be called in this web application)
     socket.on('message', (msg) => {
@@ -5,11 +5,42 @@
 #include <netinet/udp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
+#include <cmath>
 #include "vehicle-visualizer.h"
 
 namespace ns3 {
   NS_LOG_COMPONENT_DEFINE("vehicleVisualizer");
 
+  // Little endian serialization helpers for the binary frame protocol
+  static void
+  visPutU8(std::vector<uint8_t> &buf, uint8_t val)
+  {
+      buf.push_back(val);
+  }
+
+  static void
+  visPutU16(std::vector<uint8_t> &buf, uint16_t val)
+  {
+      buf.push_back(val & 0xFF);
+      buf.push_back((val >> 8) & 0xFF);
+  }
+
+  static void
+  visPutU32(std::vector<uint8_t> &buf, uint32_t val)
+  {
+      for(int i=0;i<4;i++)
+      {
+          buf.push_back((val >> (8*i)) & 0xFF);
+      }
+  }
+
+  static void
+  visSetU16(std::vector<uint8_t> &buf, size_t offset, uint16_t val)
+  {
+      buf[offset]=val & 0xFF;
+      buf[offset+1]=(val >> 8) & 0xFF;
+  }
+
   vehicleVisualizer::vehicleVisualizer()
   {
       // Set default ip and port
@@ -70,6 +101,8 @@ namespace ns3 {
 
   vehicleVisualizer::~vehicleVisualizer()
   {
+      m_frame_flush_event.Cancel ();
+
       // The destructor will attempt to send a termination message to the Node.js server only if a server
       // was successfully started with startServer()
       if(m_is_server_active)
@@ -154,6 +187,345 @@ namespace ns3 {
       return sendObjectUpdate (objID,lat,lon,VIS_HEADING_INVALID);
   }
 
+  void
+  vehicleVisualizer::setMaxFrameRate(double fps)
+  {
+      if(fps<0)
+      {
+          NS_LOG_ERROR("Error: called setMaxFrameRate for vehicleVisualizer with a negative frame rate. Using the default one.");
+          m_max_frame_rate=VIS_DEFAULT_MAX_FRAME_RATE;
+      }
+      else
+      {
+          m_max_frame_rate=fps;
+      }
+
+      // The server pushes the updates to the browsers at the same rate: tell it about the new one
+      if(m_is_connected==true)
+      {
+          std::string msg_string = "rate," + std::to_string(m_max_frame_rate);
+
+          if(send(m_sockfd,msg_string.c_str(),msg_string.length()+1,0)<0)
+          {
+              NS_LOG_ERROR("Error: cannot send the new frame rate to the vehicle visualizer server.");
+          }
+      }
+  }
+
+  void
+  vehicleVisualizer::scheduleFrameFlush()
+  {
+      if(m_frame_flush_event.IsRunning ())
+      {
+          return;
+      }
+
+      // ScheduleNow() events are executed after all the events already scheduled for the current time step
+      m_frame_flush_event=Simulator::ScheduleNow (&vehicleVisualizer::flushScheduledFrame,this);
+  }
+
+  void
+  vehicleVisualizer::flushScheduledFrame()
+  {
+      if(m_is_connected==true && flushFrame()<0)
+      {
+          NS_FATAL_ERROR("Error: cannot send the object updates frame to the vehicle visualizer.");
+      }
+  }
+
+  bool
+  vehicleVisualizer::isKeyframeDue()
+  {
+      if(m_frame_obj_ids.empty())
+      {
+          return false;
+      }
+
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_last_keyframe_time;
+
+      return m_frame_sent_once==false || elapsed.count() >= VIS_FRAME_KEYFRAME_PERIOD;
+  }
+
+  bool
+  vehicleVisualizer::isFrameDue()
+  {
+      if(m_max_frame_rate==0 || m_frame_sent_once==false)
+      {
+          return true;
+      }
+
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_last_frame_time;
+
+      return elapsed.count() >= 1.0/m_max_frame_rate;
+  }
+
+  uint32_t
+  vehicleVisualizer::getFrameObjectIndex(const std::string &objID)
+  {
+      auto it = m_frame_obj_idx.find(objID);
+
+      if(it != m_frame_obj_idx.end())
+      {
+          return it->second;
+      }
+
+      uint32_t idx = static_cast<uint32_t>(m_frame_obj_ids.size());
+      m_frame_obj_idx[objID]=idx;
+      m_frame_obj_ids.push_back(objID);
+      m_frame_last_sent.push_back({0,0,0});
+      m_frame_obj_known.push_back(false);
+
+      return idx;
+  }
+
+  void
+  vehicleVisualizer::addObjectToFrame(const std::string &objID, double lat, double lon, double heading)
+  {
+      visObjectState_t state;
+
+      if(heading<0)
+      {
+          heading+=360.0;
+      }
+      if(heading>VIS_HEADING_INVALID || std::isnan(heading))
+      {
+          heading=VIS_HEADING_INVALID;
+      }
+
+      state.lat_e7=static_cast<int32_t>(std::lround(lat*1e7));
+      state.lon_e7=static_cast<int32_t>(std::lround(lon*1e7));
+      state.heading_d10=static_cast<uint16_t>(std::lround(heading*10.0));
+
+      // Only the latest state of each object is kept until the next frame is sent
+      m_frame_pending[getFrameObjectIndex(objID)]=state;
+  }
+
+  void
+  vehicleVisualizer::removeObjectFromFrame(const std::string &objID)
+  {
+      auto it = m_frame_obj_idx.find(objID);
+
+      if(it == m_frame_obj_idx.end())
+      {
+          return;
+      }
+
+      m_frame_pending.erase(it->second);
+      if(m_frame_obj_known[it->second]==true)
+      {
+          m_frame_pending_removals.push_back(it->second);
+      }
+
+      // The index is not reused: a new object with the same ID will be announced again with a new index
+      m_frame_obj_idx.erase(it);
+  }
+
+  int
+  vehicleVisualizer::sendFrameChunk(std::vector<uint8_t> &chunk, uint16_t nrecords, bool last)
+  {
+      visSetU16(chunk,10,nrecords);
+      if(last)
+      {
+          chunk[3]|=VIS_FRAME_FLAG_LAST_CHUNK;
+      }
+
+      return send(m_sockfd,chunk.data(),chunk.size(),0);
+  }
+
+  int
+  vehicleVisualizer::flushFrame(bool force)
+  {
+      if(m_is_connected==false)
+      {
+          NS_FATAL_ERROR("Error: attempted to use a non-connected vehicle visualizer client.");
+      }
+
+      if(m_is_map_sent==false)
+      {
+          NS_FATAL_ERROR("Error in vehicle visualizer client: attempted to send a frame before sending the map draw message.");
+      }
+
+      if(!force && !isFrameDue())
+      {
+          return 0;
+      }
+
+      bool keyframe=isKeyframeDue();
+
+      if(m_frame_pending.empty() && m_frame_pending_removals.empty() && !keyframe)
+      {
+          return 0;
+      }
+
+      std::vector<uint8_t> chunk;
+      uint16_t nrecords=0;
+      uint16_t chunk_idx=0;
+      int sent_bytes=0;
+
+      chunk.reserve(VIS_FRAME_MAX_DATAGRAM_SIZE);
+
+      auto startChunk = [&] () {
+        chunk.clear();
+        visPutU8(chunk,VIS_FRAME_MAGIC_0);
+        visPutU8(chunk,VIS_FRAME_MAGIC_1);
+        visPutU8(chunk,VIS_FRAME_VERSION);
+        visPutU8(chunk,keyframe ? VIS_FRAME_FLAG_KEYFRAME : 0);
+        visPutU32(chunk,m_frame_seq);
+        visPutU16(chunk,chunk_idx);
+        visPutU16(chunk,0);
+        nrecords=0;
+      };
+
+      // Send the current chunk and start a new one when the next record would not fit in the current one
+      auto reserveRecord = [&] (size_t record_size) -> int {
+        if(chunk.size()+record_size>VIS_FRAME_MAX_DATAGRAM_SIZE || nrecords==UINT16_MAX)
+        {
+          int rval=sendFrameChunk(chunk,nrecords,false);
+          if(rval<0)
+          {
+            return rval;
+          }
+          sent_bytes+=rval;
+          chunk_idx++;
+          startChunk();
+        }
+        nrecords++;
+        return 0;
+      };
+
+      // Announce an object with its string ID and its absolute position
+      auto putNewRecord = [&] (uint32_t idx, const visObjectState_t &state) -> int {
+        const std::string &objID=m_frame_obj_ids[idx];
+        uint8_t idlen=static_cast<uint8_t>(std::min<size_t>(objID.size(),UINT8_MAX));
+
+        if(reserveRecord(1+4+1+idlen+4+4+2)<0)
+        {
+            return -1;
+        }
+        visPutU8(chunk,VIS_FRAME_RECORD_NEW);
+        visPutU32(chunk,idx);
+        visPutU8(chunk,idlen);
+        chunk.insert(chunk.end(),objID.begin(),objID.begin()+idlen);
+        visPutU32(chunk,static_cast<uint32_t>(state.lat_e7));
+        visPutU32(chunk,static_cast<uint32_t>(state.lon_e7));
+        visPutU16(chunk,state.heading_d10);
+        m_frame_obj_known[idx]=true;
+        m_frame_last_sent[idx]=state;
+        return 0;
+      };
+
+      startChunk();
+
+      for(uint32_t idx : m_frame_pending_removals)
+      {
+          if(reserveRecord(5)<0)
+          {
+              return -1;
+          }
+          visPutU8(chunk,VIS_FRAME_RECORD_REMOVE);
+          visPutU32(chunk,idx);
+      }
+      m_frame_pending_removals.clear();
+
+      if(keyframe)
+      {
+          // Key frame: the absolute state of all the objects currently on the map, changed or not
+          for(auto &obj : m_frame_obj_idx)
+          {
+              uint32_t idx=obj.second;
+              auto pending=m_frame_pending.find(idx);
+
+              if(pending==m_frame_pending.end() && m_frame_obj_known[idx]==false)
+              {
+                  continue;
+              }
+
+              if(putNewRecord(idx,pending!=m_frame_pending.end() ? pending->second : m_frame_last_sent[idx])<0)
+              {
+                  return -1;
+              }
+          }
+          m_frame_pending.clear();
+      }
+
+      for(auto &pending : m_frame_pending)
+      {
+          uint32_t idx=pending.first;
+          const visObjectState_t &state=pending.second;
+          visObjectState_t &last=m_frame_last_sent[idx];
+
+          if(m_frame_obj_known[idx]==false)
+          {
+              // New object: announce its string ID once, together with its absolute position
+              if(putNewRecord(idx,state)<0)
+              {
+                  return -1;
+              }
+              continue;
+          }
+
+          int64_t dlat=static_cast<int64_t>(state.lat_e7)-last.lat_e7;
+          int64_t dlon=static_cast<int64_t>(state.lon_e7)-last.lon_e7;
+
+          // Unchanged objects are not sent at all
+          if(dlat==0 && dlon==0 && state.heading_d10==last.heading_d10)
+          {
+              continue;
+          }
+
+          if(dlat>=INT16_MIN && dlat<=INT16_MAX && dlon>=INT16_MIN && dlon<=INT16_MAX)
+          {
+              if(reserveRecord(1+4+2+2+2)<0)
+              {
+                  return -1;
+              }
+              visPutU8(chunk,VIS_FRAME_RECORD_DELTA);
+              visPutU32(chunk,idx);
+              visPutU16(chunk,static_cast<uint16_t>(static_cast<int16_t>(dlat)));
+              visPutU16(chunk,static_cast<uint16_t>(static_cast<int16_t>(dlon)));
+              visPutU16(chunk,state.heading_d10);
+          }
+          else
+          {
+              if(reserveRecord(1+4+4+4+2)<0)
+              {
+                  return -1;
+              }
+              visPutU8(chunk,VIS_FRAME_RECORD_FULL);
+              visPutU32(chunk,idx);
+              visPutU32(chunk,static_cast<uint32_t>(state.lat_e7));
+              visPutU32(chunk,static_cast<uint32_t>(state.lon_e7));
+              visPutU16(chunk,state.heading_d10);
+          }
+
+          last=state;
+      }
+      m_frame_pending.clear();
+
+      // Nothing changed since the last frame (an empty key frame is still sent, as it removes any stale object from the map)
+      if(nrecords==0 && sent_bytes==0 && !keyframe)
+      {
+          return 0;
+      }
+
+      int rval=sendFrameChunk(chunk,nrecords,true);
+      if(rval<0)
+      {
+          return rval;
+      }
+      sent_bytes+=rval;
+
+      m_frame_seq++;
+      m_last_frame_time=std::chrono::steady_clock::now();
+      if(keyframe)
+      {
+          m_last_keyframe_time=m_last_frame_time;
+      }
+      m_frame_sent_once=true;
+
+      return sent_bytes;
+  }
+
   int
   vehicleVisualizer::startServer()
   {
@@ -166,7 +538,7 @@ namespace ns3 {
         NS_FATAL_ERROR("Error. Node.js does not seem to be installed. Please install it before using the ms-van3t vehicle visualizer.");
       }
 
-      servercmd = "node " + m_serverpath + " " + std::to_string(m_httpport) + " &";
+      servercmd = "node " + m_serverpath + " " + std::to_string(m_httpport) + " " + std::to_string(m_max_frame_rate) + " &";
       int startCmdRval = std::system(servercmd.c_str());
 
       // If the result is 0, system() was able to successfully launch the command (which may fail afterwards, though)
@@ -194,6 +566,12 @@ namespace ns3 {
           NS_FATAL_ERROR("Error: attempted to use a non-connected vehicle visualizer client.");
       }
 
+      // Send the last pending updates, if any
+      if(m_is_map_sent==true)
+      {
+          flushFrame(true);
+      }
+
       // Just send a message with the "terminate" string
       char terminatebuf[10]="terminate";
 
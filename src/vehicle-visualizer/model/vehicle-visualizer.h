@@ -3,9 +3,42 @@
 #define VEHICLE_VISUALIZER_H
 
 #include "ns3/core-module.h"
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <vector>
 #define VIS_HEADING_INVALID 361
 #define DEFAULT_NODEJS_SERVER_PATH "./src/vehicle-visualizer/js/server.js"
 
+// Default maximum number of frames sent per second (wall-clock) to the Node.js server
+#define VIS_DEFAULT_MAX_FRAME_RATE 10.0
+
+// Binary frame protocol: a frame is sent as one or more datagrams, each one made of a header followed by a set of records
+// Header: 'V' 'F' <version, uint8> <flags, uint8> <frame sequence number, uint32> <chunk index, uint16> <number of records, uint16>
+// All the multi-byte fields are encoded as little endian
+#define VIS_FRAME_MAGIC_0 'V'
+#define VIS_FRAME_MAGIC_1 'F'
+#define VIS_FRAME_VERSION 2
+#define VIS_FRAME_HEADER_SIZE 12
+#define VIS_FRAME_FLAG_LAST_CHUNK 0x01
+// Key frame: it contains a NEW record for every object on the map, so that the server can recover from lost datagrams
+// (objects missing from a complete key frame are removed from the map)
+#define VIS_FRAME_FLAG_KEYFRAME 0x02
+// Minimum interval (wall-clock, in seconds) between two key frames
+#define VIS_FRAME_KEYFRAME_PERIOD 2.0
+// Maximum size of a single frame datagram: larger frames are split into several self-contained chunks
+#define VIS_FRAME_MAX_DATAGRAM_SIZE 8192
+
+// Record types
+// NEW:    <type> <object index, uint32> <ID length, uint8> <ID> <lat*1e7, int32> <lon*1e7, int32> <heading*10, uint16>
+// FULL:   <type> <object index, uint32> <lat*1e7, int32> <lon*1e7, int32> <heading*10, uint16>
+// DELTA:  <type> <object index, uint32> <delta lat*1e7, int16> <delta lon*1e7, int16> <heading*10, uint16>
+// REMOVE: <type> <object index, uint32>
+#define VIS_FRAME_RECORD_NEW 0x01
+#define VIS_FRAME_RECORD_FULL 0x02
+#define VIS_FRAME_RECORD_DELTA 0x03
+#define VIS_FRAME_RECORD_REMOVE 0x04
+
 namespace ns3 {
   class vehicleVisualizer : public Object
   {
@@ -51,6 +84,34 @@ namespace ns3 {
       int sendObjectUpdate(std::string objID, double lat, double lon);
       int sendObjectUpdate(std::string objID, double lat, double lon, double heading);
 
+      // Frame-based interface, sending, in a single step, all the objects updated since the last frame
+      // The objects added with addObjectToFrame() are coalesced (only the latest position of each object is kept) until
+      // flushFrame() is called and at least 1/maxFrameRate seconds (wall-clock) have passed since the last frame was sent
+      // Only the objects which changed since the last frame are sent, using a compact binary, delta-encoded format
+
+      // Set the maximum frame rate (frames per second, wall-clock time); 0 means that a frame is sent every time flushFrame() is called
+      // If the server is already running, the new rate is sent to it as well (it is used to push the updates to the browsers)
+      void setMaxFrameRate(double fps);
+
+      // Returns true if a new frame can be sent now; mobility clients can use it to skip the computation of the object updates
+      // (e.g. the coordinate conversions) when they would be discarded anyway
+      bool isFrameDue();
+
+      // Add (or update) an object in the next frame
+      void addObjectToFrame(const std::string &objID, double lat, double lon, double heading=VIS_HEADING_INVALID);
+
+      // Remove an object from the map with the next frame
+      void removeObjectFromFrame(const std::string &objID);
+
+      // Send the pending updates, if a frame is due (or if force is true)
+      // Returns the number of bytes sent, 0 if no frame was sent, or a negative value in case of error
+      int flushFrame(bool force=false);
+
+      // Schedule a single flushFrame() at the end of the current simulation time step, i.e. after all the mobility clients
+      // updating their objects at the same time have called addObjectToFrame() (further calls in the same time step have no effect)
+      // This avoids sending partial frames mixing positions of different time steps, when each object is updated by a separate event
+      void scheduleFrameFlush();
+
       // This function should be called to terminate the execution of the Node.js server
       // Normally, the user should not call it, as it is automatically called by the destructor of the vehicleVisualizer object
       int terminateServer();
@@ -71,8 +132,38 @@ namespace ns3 {
       bool m_is_server_active;
       std::string m_serverpath;
 
+      // Quantized state of an object, as sent inside a frame
+      typedef struct visObjectState {
+        int32_t lat_e7;
+        int32_t lon_e7;
+        uint16_t heading_d10;
+      } visObjectState_t;
+
+      // Frame protocol state
+      double m_max_frame_rate = VIS_DEFAULT_MAX_FRAME_RATE;
+      std::chrono::steady_clock::time_point m_last_frame_time;
+      std::chrono::steady_clock::time_point m_last_keyframe_time;
+      bool m_frame_sent_once = false;
+      EventId m_frame_flush_event;
+      uint32_t m_frame_seq = 0;
+      // Object ID -> object index (the index is used on the wire in place of the string ID)
+      std::unordered_map<std::string,uint32_t> m_frame_obj_idx;
+      std::vector<std::string> m_frame_obj_ids;
+      // Last state sent for each object index (m_frame_obj_known is false until the object is announced with a NEW record)
+      std::vector<visObjectState_t> m_frame_last_sent;
+      std::vector<bool> m_frame_obj_known;
+      // Pending (coalesced) updates and removals, ordered by object index
+      std::map<uint32_t,visObjectState_t> m_frame_pending;
+      std::vector<uint32_t> m_frame_pending_removals;
+
       // Internal (private) function to open the UDP socket for the communication with the Node.js server
       int socketOpen(void);
+
+      // Internal (private) functions to get the index of an object and to send a (chunk of a) frame
+      uint32_t getFrameObjectIndex(const std::string &objID);
+      int sendFrameChunk(std::vector<uint8_t> &chunk, uint16_t nrecords, bool last);
+      bool isKeyframeDue();
+      void flushScheduledFrame();
   };
 }
 
@@ -0,0 +1,440 @@
+#!/usr/bin/env python3
+"""
+Parallel parameter sweep runner for the VaN3Twin/ms-van3t examples.
+
+This script takes a parameter grid (e.g. seeds x penetration rates x tx power x technology/example) and runs all the
+combinations as independent ns-3 + SUMO instances, in parallel, on all the available cores.
+
+- Each run is executed in its own working directory (<output dir>/runs/<run id>), containing a symbolic link to the
+  ns-3 "src" folder, so that the relative paths used by the examples (e.g. the SUMO configuration files) still work,
+  while the files written by each run (e.g. cbr_values.txt) do not collide.
+- The SUMO port of each run is automatically selected by the TraCI client (TraciClient::GetFreePort), which reserves it
+  across processes, so that parallel runs never collide on the same port.
+- Each run (together with the SUMO instance it launches) is pinned to a single core.
+- The metrics printed by the Metric Supervisor (PRR, latency, ...) are extracted from the output of each run and
+  collected into a single CSV table (<output dir>/results.csv).
+- The completed runs are recorded in <output dir>/state.jsonl: when a sweep is interrupted and launched again with
+  the same output directory, only the missing runs are executed.
+
+The grid is described by a JSON file, for instance:
+
+    {
+      "example": ["v2v-congestion-80211p", "v2v-congestion-nrv2x"],
+      "params": {
+        "RngRun": [1, 2, 3],
+        "penetration-rate": [0.5, 1.0],
+        "tx-power": [23, 33]
+      },
+      "fixed": {"sim-time": 20},
+      "metrics": {"prr": "Average PRR: ([-+0-9.eE]+)"},
+      "metric_files": []
+    }
+
+"example" can be a single example or a list of examples (i.e. an additional grid dimension). "params" are the grid
+dimensions, passed to the examples as --<name>=<value>. "fixed" are passed to every run. "metrics" (optional) are the
+regular expressions used to extract the metrics from the run output (the first group is taken); when a metric
+appears more than once, the additional values are stored as <metric>_2, <metric>_3 and so on. "metric_files"
+(optional) are additional files, relative to the run directory, scanned for the metrics.
+
+The examples writing their statistics to a file selected by a command line option (e.g. --output-file of
+v2v-coexistence-80211p-nrv2x, see OUTPUT_FILE_OPTIONS) automatically get a path inside their run directory, unless the
+option is part of the grid, and that file is scanned for the metrics as well.
+
+The grid can also be specified directly on the command line, e.g.:
+
+    ./sweep_runner.py --example v2v-congestion-80211p --param RngRun=1,2,3 --param tx-power=23,33 --fixed sim-time=20
+
+This script must be launched from the ns-3 root folder (i.e. ns-3-dev), after building the examples.
+"""
+
+import argparse
+import csv
+import glob
+import hashlib
+import itertools
+import json
+import os
+import queue
+import re
+import signal
+import subprocess
+import sys
+import threading
+import time
+
+DEFAULT_METRICS = {
+    "prr": r"Average PRR: ([-+0-9.eE]+|nan|-?inf)",
+    "latency_ms": r"Average latency \(ms\): ([-+0-9.eE]+|nan|-?inf)",
+}
+
+# Examples writing their statistics to a file set with a command line option: option name -> file name inside the run
+# directory
+OUTPUT_FILE_OPTIONS = {
+    "v2v-coexistence-80211p-nrv2x": {"output-file": "output.txt"},
+}
+
+STATE_FILE = "state.jsonl"
+RESULTS_FILE = "results.csv"
+
+
+def parse_value_list(spec):
+    """Parse a "name=v1,v2,..." command line grid specification."""
+    if "=" not in spec:
+        raise argparse.ArgumentTypeError("Invalid specification (expected name=value[,value...]): " + spec)
+    name, values = spec.split("=", 1)
+    return name, [v for v in values.split(",") if v != ""]
+
+
+def load_grid(args):
+    """Build the grid description from the JSON file and/or from the command line options."""
+    grid = {"example": [], "params": {}, "fixed": {}, "metrics": dict(DEFAULT_METRICS), "metric_files": []}
+
+    if args.grid is not None:
+        with open(args.grid) as f:
+            filegrid = json.load(f)
+        examples = filegrid.get("example", [])
+        grid["example"] = examples if isinstance(examples, list) else [examples]
+        grid["params"].update(filegrid.get("params", {}))
+        grid["fixed"].update(filegrid.get("fixed", {}))
+        grid["metrics"].update(filegrid.get("metrics", {}))
+        grid["metric_files"] = filegrid.get("metric_files", [])
+
+    if args.example:
+        grid["example"] = args.example
+    for name, values in args.param:
+        grid["params"][name] = values
+    for name, values in args.fixed:
+        grid["fixed"][name] = ",".join(values)
+
+    if not grid["example"]:
+        sys.exit("Error: no example specified (use a grid file or --example).")
+
+    for name, values in grid["params"].items():
+        if not isinstance(values, list) or len(values) == 0:
+            sys.exit("Error: the values of parameter '" + name + "' must be a non-empty list.")
+
+    return grid
+
+
+def expand_grid(grid):
+    """Return the list of runs, each one as a dict {"example": ..., "args": {name: value}}."""
+    names = sorted(grid["params"].keys())
+    runs = []
+
+    for example in grid["example"]:
+        for combination in itertools.product(*[grid["params"][n] for n in names]):
+            runargs = {k: str(v) for k, v in grid["fixed"].items()}
+            runargs.update({n: str(v) for n, v in zip(names, combination)})
+            runs.append({"example": example, "args": runargs})
+
+    return runs
+
+
+def run_id(run):
+    """Stable identifier of a run, used to resume interrupted sweeps."""
+    key = json.dumps({"example": run["example"], "args": run["args"]}, sort_keys=True)
+    return hashlib.sha1(key.encode()).hexdigest()[:12]
+
+
+def find_executable(ns3_dir, example):
+    """Look for the executable of an example inside the ns-3 build folder."""
+    candidates = [p for p in glob.glob(os.path.join(ns3_dir, "build", "**", "ns3*-" + example + "-*"), recursive=True)
+                  if os.path.isfile(p) and os.access(p, os.X_OK) and not p.endswith(".so")]
+
+    # Discard the examples whose name only starts with the requested one (e.g. "<example>-extended")
+    exact = re.compile(r"ns3[^/]*-" + re.escape(example) + r"-[^-/]+$")
+    candidates = [p for p in candidates if exact.search(p)]
+
+    if not candidates:
+        return None
+
+    # Prefer the most recently built executable
+    return max(candidates, key=os.path.getmtime)
+
+
+def extract_metrics(texts, metrics):
+    """Extract the metrics from the output of a run."""
+    values = {}
+
+    for name, regex in metrics.items():
+        matches = []
+        for text in texts:
+            matches += re.findall(regex, text)
+        for i, match in enumerate(matches):
+            if isinstance(match, tuple):
+                match = match[0]
+            values[name if i == 0 else name + "_" + str(i + 1)] = match
+
+    return values
+
+
+class SweepRunner:
+    def __init__(self, args, grid):
+        self.args = args
+        self.grid = grid
+        self.ns3_dir = os.path.abspath(args.ns3_dir)
+        self.output_dir = os.path.abspath(args.output_dir)
+        self.state_path = os.path.join(self.output_dir, STATE_FILE)
+        self.lock = threading.Lock()
+        self.stopping = threading.Event()
+        self.processes = {}
+        self.completed = {}
+        self.executables = {}
+
+    def load_state(self):
+        if not os.path.exists(self.state_path):
+            return
+        with open(self.state_path) as f:
+            for line in f:
+                line = line.strip()
+                if not line:
+                    continue
+                try:
+                    entry = json.loads(line)
+                except json.JSONDecodeError:
+                    # A truncated line may be left by an interrupted sweep
+                    continue
+                self.completed[entry["id"]] = entry
+
+    def record(self, entry):
+        with self.lock:
+            self.completed[entry["id"]] = entry
+            with open(self.state_path, "a") as f:
+                f.write(json.dumps(entry, sort_keys=True) + "\n")
+                f.flush()
+                os.fsync(f.fileno())
+            self.write_results()
+
+    def write_results(self):
+        """Write the results table with all the completed runs (last entry for each run)."""
+        entries = list(self.completed.values())
+        param_names = sorted({k for e in entries for k in e["args"].keys()})
+        metric_names = sorted({k for e in entries for k in e.get("metrics", {}).keys()})
+
+        tmp_path = os.path.join(self.output_dir, RESULTS_FILE + ".tmp")
+        with open(tmp_path, "w", newline="") as f:
+            writer = csv.writer(f)
+            writer.writerow(["id", "example"] + param_names + ["status", "duration_s"] + metric_names)
+            for e in sorted(entries, key=lambda e: (e["example"], [e["args"].get(p, "") for p in param_names])):
+                writer.writerow([e["id"], e["example"]] + [e["args"].get(p, "") for p in param_names] +
+                                [e["status"], "%.1f" % e["duration_s"]] +
+                                [e.get("metrics", {}).get(m, "") for m in metric_names])
+        os.replace(tmp_path, os.path.join(self.output_dir, RESULTS_FILE))
+
+    def run_dir(self, rid):
+        return os.path.join(self.output_dir, "runs", rid)
+
+    def output_files(self, rid, run):
+        """Per-run output files of the example (option name -> absolute path), except the ones set by the grid."""
+        return {option: os.path.join(self.run_dir(rid), name)
+                for option, name in OUTPUT_FILE_OPTIONS.get(run["example"], {}).items() if option not in run["args"]}
+
+    def command(self, rid, run):
+        runargs = dict(run["args"])
+        # Absolute paths, as the runs launched with --use-ns3-run are all executed from the ns-3 root folder
+        runargs.update(self.output_files(rid, run))
+        cmdargs = ["--" + k + "=" + v for k, v in sorted(runargs.items())]
+
+        if self.args.use_ns3_run:
+            return [os.path.join(self.ns3_dir, "ns3"), "run", "--no-build", " ".join([run["example"]] + cmdargs)]
+
+        return [self.executables[run["example"]]] + cmdargs
+
+    def prepare_run_dir(self, rid, run):
+        run_dir = self.run_dir(rid)
+        os.makedirs(run_dir, exist_ok=True)
+
+        # The examples use paths relative to the ns-3 root folder (e.g. src/automotive/examples/...)
+        src_link = os.path.join(run_dir, "src")
+        if not os.path.lexists(src_link):
+            os.symlink(os.path.join(self.ns3_dir, "src"), src_link)
+
+        with open(os.path.join(run_dir, "params.json"), "w") as f:
+            json.dump(run, f, indent=2, sort_keys=True)
+
+        return run_dir
+
+    def execute(self, rid, run, core):
+        run_dir = self.prepare_run_dir(rid, run)
+        cmd = self.command(rid, run)
+        log_path = os.path.join(run_dir, "stdout.log")
+
+        def preexec():
+            # Pin the run (and the SUMO instance it launches, which inherits the affinity) to a single core
+            if core is not None:
+                os.sched_setaffinity(0, {core})
+
+        start = time.time()
+        status = "ok"
+        returncode = None
+
+        with open(log_path, "w") as log:
+            log.write("# " + " ".join(cmd) + "\n")
+            log.flush()
+            proc = subprocess.Popen(cmd, cwd=self.ns3_dir if self.args.use_ns3_run else run_dir,
+                                    stdout=log, stderr=subprocess.STDOUT, preexec_fn=preexec,
+                                    start_new_session=True)
+            with self.lock:
+                self.processes[rid] = proc
+            try:
+                returncode = proc.wait(timeout=self.args.timeout)
+                if returncode != 0:
+                    status = "failed"
+            except subprocess.TimeoutExpired:
+                status = "timeout"
+                self.kill(proc)
+                proc.wait()
+            finally:
+                with self.lock:
+                    self.processes.pop(rid, None)
+
+        if self.stopping.is_set() and status != "ok":
+            # Interrupted by the user: do not record the run, so that it is executed again when resuming
+            return None
+
+        texts = []
+        metric_paths = [os.path.join(run_dir, p) for p in self.grid["metric_files"]]
+        metric_paths += [p for p in self.output_files(rid, run).values() if p not in metric_paths]
+        for path in [log_path] + metric_paths:
+            if os.path.exists(path):
+                with open(path, errors="replace") as f:
+                    texts.append(f.read())
+
+        return {"id": rid, "example": run["example"], "args": run["args"], "status": status,
+                "returncode": returncode, "core": core, "duration_s": time.time() - start,
+                "metrics": extract_metrics(texts, self.grid["metrics"])}
+
+    @staticmethod
+    def kill(proc):
+        # Kill the whole process group, including the SUMO instance launched by the run
+        try:
+            os.killpg(proc.pid, signal.SIGKILL)
+        except ProcessLookupError:
+            pass
+
+    def worker(self, runs, cores, total):
+        core = cores.get()
+        try:
+            while not self.stopping.is_set():
+                try:
+                    rid, run = runs.get_nowait()
+                except queue.Empty:
+                    return
+                entry = self.execute(rid, run, core)
+                if entry is None:
+                    return
+                self.record(entry)
+                with self.lock:
+                    done = sum(1 for _ in self.completed)
+                print("[%d/%d] %s %s %s (%.1f s) %s" % (done, total, entry["status"].upper(), run["example"],
+                      " ".join("--%s=%s" % kv for kv in sorted(run["args"].items())), entry["duration_s"],
+                      " ".join("%s=%s" % kv for kv in sorted(entry["metrics"].items()))), flush=True)
+        finally:
+            cores.put(core)
+
+    def run(self):
+        os.makedirs(self.output_dir, exist_ok=True)
+        self.load_state()
+
+        runs = expand_grid(self.grid)
+        pending = []
+        for run in runs:
+            rid = run_id(run)
+            entry = self.completed.get(rid)
+            if entry is not None and (entry["status"] == "ok" or not self.args.retry_failed):
+                continue
+            pending.append((rid, run))
+
+        print("Sweep: %d runs, %d already completed, %d to be executed." % (len(runs), len(runs) - len(pending),
+              len(pending)))
+
+        if self.args.dry_run:
+            for rid, run in pending:
+                if not self.args.use_ns3_run:
+                    self.executables.setdefault(run["example"], run["example"])
+                print(rid, " ".join(self.command(rid, run)))
+            return 0
+
+        if not pending:
+            self.write_results()
+            return 0
+
+        if not self.args.use_ns3_run:
+            for example in sorted({run["example"] for _, run in pending}):
+                executable = find_executable(self.ns3_dir, example)
+                if executable is None:
+                    sys.exit("Error: cannot find the executable of '" + example + "' in " +
+                             os.path.join(self.ns3_dir, "build") + ". Build the examples first, or use --use-ns3-run.")
+                self.executables[example] = executable
+
+        available_cores = sorted(os.sched_getaffinity(0))
+        jobs = min(self.args.jobs or len(available_cores), len(pending))
+
+        cores = queue.Queue()
+        for i in range(jobs):
+            cores.put(None if self.args.no_pin else available_cores[i % len(available_cores)])
+
+        runqueue = queue.Queue()
+        for item in pending:
+            runqueue.put(item)
+
+        threads = [threading.Thread(target=self.worker, args=(runqueue, cores, len(runs)), daemon=True)
+                   for _ in range(jobs)]
+        for t in threads:
+            t.start()
+
+        try:
+            while any(t.is_alive() for t in threads):
+                for t in threads:
+                    t.join(timeout=0.5)
+        except KeyboardInterrupt:
+            print("\nSweep interrupted: terminating the running simulations. Launch the same command again to resume.")
+            self.stopping.set()
+            with self.lock:
+                procs = list(self.processes.values())
+            for proc in procs:
+                self.kill(proc)
+            for t in threads:
+                t.join()
+            return 1
+
+        failed = [e for e in self.completed.values() if e["status"] != "ok"]
+        print("Sweep completed. Results written to: " + os.path.join(self.output_dir, RESULTS_FILE))
+        if failed:
+            print("Warning: %d runs failed (see the stdout.log file in each run directory)." % len(failed))
+            return 1
+
+        return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Parallel parameter sweep runner for the VaN3Twin examples.",
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("grid", nargs="?", default=None, help="JSON file describing the parameter grid")
+    parser.add_argument("--example", action="append", default=[],
+                        help="Example to be run (can be specified multiple times)")
+    parser.add_argument("--param", action="append", default=[], type=parse_value_list,
+                        help="Grid dimension, as name=value1,value2,... (can be specified multiple times)")
+    parser.add_argument("--fixed", action="append", default=[], type=parse_value_list,
+                        help="Option passed to all the runs, as name=value (can be specified multiple times)")
+    parser.add_argument("-j", "--jobs", type=int, default=0,
+                        help="Number of parallel runs (default: number of available cores)")
+    parser.add_argument("-o", "--output-dir", default="sweep-results",
+                        help="Output directory; an interrupted sweep is resumed when the same directory is used again")
+    parser.add_argument("--ns3-dir", default=".", help="ns-3 root folder (default: current directory)")
+    parser.add_argument("--timeout", type=float, default=None, help="Maximum duration of each run [s]")
+    parser.add_argument("--no-pin", action="store_true", help="Do not pin each run to a core")
+    parser.add_argument("--retry-failed", action="store_true", help="Execute again the failed runs when resuming")
+    parser.add_argument("--use-ns3-run", action="store_true",
+                        help="Launch the runs with './ns3 run --no-build' from the ns-3 root folder, instead of running the "
+                             "executables directly (the runs will share the same working directory)")
+    parser.add_argument("--dry-run", action="store_true", help="Only print the commands which would be executed")
+    args = parser.parse_args()
+
+    grid = load_grid(args)
+
+    return SweepRunner(args, grid).run()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""
+Decoder for the binary traces of the CAM/VAM triggering conditions (see TriggerTrace, in
+src/automotive/model/Facilities/triggerTrace.h).
+
+The trace file is made of the 8-byte header "MSVTRC" + version (uint16_t), followed by a sequence of records, each one
+made of its type (uint16_t, 1 = CAM, 2 = VAM), its size in bytes (uint16_t) and the raw content of the corresponding
+structure (CAMTriggerRecord_t or VAMTriggerRecord_t). The records are stored in the native byte order and layout of the
+machine running the simulation, so the trace must be decoded on a machine with the same architecture.
+
+The records of each type are written to a CSV file (<trace name>-cam.csv and <trace name>-vam.csv, in the same folder
+of the trace, unless --output-dir is specified), with one column for each field of the structure, plus the textual
+description of the triggering conditions, as reported by the text logs of the Basic Services. A summary of the number
+of checks and of the messages generated for each triggering condition is printed at the end.
+
+Example (trace written by v2v-80211p-gps-tc-example with --trigger-trace=trigger-trace.bin):
+
+    ./trigger_trace_decoder.py trigger-trace.bin
+"""
+
+import argparse
+import collections
+import csv
+import os
+import struct
+import sys
+
+MAGIC = b"MSVTRC"
+SUPPORTED_VERSION = 1
+
+TRIGGER_TRACE_CAM = 1
+TRIGGER_TRACE_VAM = 2
+
+# Same order and names of the TRIGGER_MOTIVATION_* flags and of TriggerTrace::motivationString()
+MOTIVATIONS = [
+    (0x01, "heading", "H"),
+    (0x02, "position", "P"),
+    (0x04, "speed", "S"),
+    (0x08, "safe_distances", "D"),
+    (0x10, "time", "T"),
+]
+
+# Fields of CAMTriggerRecord_t and VAMTriggerRecord_t, in the same order of the C++ structures. The format uses the
+# native alignment ("@"), as the structures are written as they are; the trailing padding is skipped using the record
+# size stored in the trace.
+RECORD_LAYOUTS = {
+    TRIGGER_TRACE_CAM: ("cam", [
+        ("simTime", "q"), ("timestamp", "q"), ("stationID", "I"), ("sent", "B"), ("motivation", "B"),
+        ("N_GenCam", "h"), ("headDiff", "d"), ("posDiff", "d"), ("speedDiff", "d"), ("T_GenCam_ms", "i"),
+        ("prevHeading", "d"), ("currHeading", "d"), ("prevLat", "d"), ("prevLon", "d"), ("currLat", "d"),
+        ("currLon", "d"), ("prevSpeed", "d"), ("currSpeed", "d"), ("lastCamGen", "q"), ("timeDiff", "q"),
+        ("N_GenCamMax", "h"),
+    ]),
+    TRIGGER_TRACE_VAM: ("vam", [
+        ("simTime", "q"), ("timestamp", "q"), ("stationID", "I"), ("sent", "B"), ("redundancyMitigation", "B"),
+        ("motivation", "B"), ("minDistAvailable", "B"), ("headDiff", "d"), ("posDiff", "d"), ("speedDiff", "d"),
+        ("T_GenVam_ms", "i"), ("prevHeading", "d"), ("currHeading", "d"), ("prevLat", "d"), ("prevLon", "d"),
+        ("currLat", "d"), ("currLon", "d"), ("prevSpeed", "d"), ("currSpeed", "d"),
+        ("safeDistLong", "d"), ("safeDistLat", "d"), ("safeDistVert", "d"),
+        ("minDistVehLong", "d"), ("minDistVehLat", "d"), ("minDistVehVert", "d"),
+        ("minDistPedLong", "d"), ("minDistPedLat", "d"), ("minDistPedVert", "d"),
+        ("lastVamGen", "q"), ("lastVamGenEnd", "q"), ("timeDiff", "q"), ("numSent", "q"),
+        ("N_GenVam_red", "h"), ("N_GenVam_max_red", "h"),
+    ]),
+}
+
+
+def motivation_string(motivation):
+    """Python version of TriggerTrace::motivationString()"""
+    joint = ""
+    name = "numPkt"
+
+    for flag, condition, initial in MOTIVATIONS:
+        if motivation & flag:
+            joint += initial
+            name = condition
+
+    if len(joint) <= 1:
+        return name
+
+    # When joint with a single other motivation, the time motivation should not be considered
+    if len(joint) == 2 and motivation & 0x10:
+        return motivation_string(motivation & ~0x10)
+
+    return "joint(" + joint + ")"
+
+
+def read_records(path):
+    """Generator of (record type, dictionary of the record fields) for all the records of a trace file"""
+    structs = {record_type: (struct.Struct("@" + "".join(fmt for _, fmt in fields)), [name for name, _ in fields])
+               for record_type, (_, fields) in RECORD_LAYOUTS.items()}
+    record_header = struct.Struct("@HH")
+
+    with open(path, "rb") as trace:
+        data = trace.read()
+
+    if len(data) < 8 or data[:6] != MAGIC:
+        raise ValueError("{} is not a trigger trace (wrong header)".format(path))
+
+    version, = struct.unpack_from("@H", data, 6)
+    if version != SUPPORTED_VERSION:
+        raise ValueError("Unsupported trigger trace version {} (expected {})".format(version, SUPPORTED_VERSION))
+
+    offset = 8
+    while offset + record_header.size <= len(data):
+        record_type, size = record_header.unpack_from(data, offset)
+        offset += record_header.size
+
+        if offset + size > len(data):
+            print("Warning: truncated record at offset {}, ignoring the rest of the trace".format(offset),
+                  file=sys.stderr)
+            break
+
+        if record_type in structs:
+            record_struct, names = structs[record_type]
+            if size < record_struct.size:
+                raise ValueError("Record of type {} at offset {} is too short ({} bytes instead of at least {}): "
+                                 "was the trace written on a different architecture?"
+                                 .format(record_type, offset, size, record_struct.size))
+            yield record_type, dict(zip(names, record_struct.unpack_from(data, offset)))
+        else:
+            print("Warning: skipping record of unknown type {} at offset {}".format(record_type, offset),
+                  file=sys.stderr)
+
+        offset += size
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode a binary trace of the CAM/VAM triggering conditions into CSV "
+                                                 "files")
+    parser.add_argument("trace", help="Trace file written by TriggerTrace")
+    parser.add_argument("-o", "--output-dir", default=None,
+                        help="Folder where the CSV files are written (default: the folder of the trace)")
+    args = parser.parse_args()
+
+    output_dir = args.output_dir if args.output_dir is not None else os.path.dirname(os.path.abspath(args.trace))
+    os.makedirs(output_dir, exist_ok=True)
+    basename = os.path.splitext(os.path.basename(args.trace))[0]
+
+    writers = {}
+    files = []
+    checks = collections.Counter()
+    sent = collections.defaultdict(collections.Counter)
+
+    try:
+        for record_type, record in read_records(args.trace):
+            kind, fields = RECORD_LAYOUTS[record_type]
+            record["motivationString"] = motivation_string(record["motivation"]) if record["sent"] else "none"
+
+            if record_type not in writers:
+                csv_path = os.path.join(output_dir, "{}-{}.csv".format(basename, kind))
+                csv_file = open(csv_path, "w", newline="")
+                files.append(csv_file)
+                writers[record_type] = csv.DictWriter(csv_file, fieldnames=list(record.keys()))
+                writers[record_type].writeheader()
+                print("Writing the {} records to {}".format(kind.upper(), csv_path))
+
+            writers[record_type].writerow(record)
+
+            checks[kind] += 1
+            if record["sent"]:
+                sent[kind][record["motivationString"]] += 1
+    except ValueError as error:
+        print("Error: {}".format(error), file=sys.stderr)
+        return 1
+    finally:
+        for csv_file in files:
+            csv_file.close()
+
+    for kind in sorted(checks):
+        total_sent = sum(sent[kind].values())
+        print("{}: {} checks, {} messages generated".format(kind.upper(), checks[kind], total_sent))
+        for motivation, count in sent[kind].most_common():
+            print("  {}: {}".format(motivation, count))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())